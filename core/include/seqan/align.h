@@ -152,6 +152,12 @@
 #include <seqan/align/dp_traceback_impl.h>
 #include <seqan/align/dp_algorithm_impl.h>
 
+// Inter-sequence SIMD kernel for aligning batches of sequence pairs.
+#include <seqan/align/dp_batch_simd.h>
+
+// Striped SIMD kernel for the Smith-Waterman algorithm.
+#include <seqan/align/dp_striped_simd.h>
+
 //################################################################################
 // Old module
 //################################################################################
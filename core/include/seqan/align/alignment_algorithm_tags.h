@@ -150,6 +150,7 @@ typedef Tag<MyersHirschberg_> MyersHirschberg;
 ..tag
 ...SmithWaterman:Smith-Waterman algorithm for local alignments.
 ...WatermanEggert:Smith-Waterman algorithm with declumping to identify suboptimal local alignments.
+...SmithWatermanStriped:Smith-Waterman algorithm using a striped SIMD query profile (Farrar).
 ..see:Function.localAlignment
 ..see:Class.LocalAlignmentEnumerator
 ..include:seqan/align.h
@@ -179,6 +180,24 @@ typedef Tag<SmithWaterman_> SmithWaterman;
 struct WatermanEggert_;
 typedef Tag<WatermanEggert_> WatermanEggert;
 
+/*!
+ * @tag PairwiseLocalAlignmentAlgorithms#SmithWatermanStriped
+ * @headerfile <seqan/align.h>
+ * @brief Tag for selecting the striped SIMD implementation of the Smith-Waterman algorithm.
+ *
+ * @signature struct SmithWatermanStriped_;
+ * @signature typedef Tag<SmithWatermanStriped_> SmithWatermanStriped;
+ *
+ * The scores of a column are computed with a striped query profile of the vertical sequence using saturated 8 bit
+ * lanes, which are promoted to 16 bit lanes if the score might overflow.  Only the traceback of the optimal region is
+ * computed with the scalar DP.  Integral scoring schemes with non-positive gap scores are supported, e.g. @link
+ * ScoreMatrix @endlink and @link SimpleScore @endlink.  Other scoring schemes use the standard Smith-Waterman
+ * algorithm.
+ */
+
+struct SmithWatermanStriped_;
+typedef Tag<SmithWatermanStriped_> SmithWatermanStriped;
+
 // ============================================================================
 // Metafunctions
 // ============================================================================
@@ -0,0 +1,973 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Author: agent <agent@local>
+// ==========================================================================
+// Inter-sequence vectorized DP kernel used by the batch interfaces of
+// globalAlignment() and localAlignment().  Each SIMD lane computes the DP
+// matrix of a different pair of sequences, so 16 (SSE) or 32 (AVX2) pairs
+// are aligned at once with saturated 8 bit scores and 8 or 16 pairs with
+// saturated 16 bit scores.  The kernel supports the Simple scoring scheme
+// with linear and affine gap costs, free end gaps and an optional traceback.
+// ==========================================================================
+
+#ifndef SEQAN_CORE_INCLUDE_SEQAN_ALIGN_DP_BATCH_SIMD_H_
+#define SEQAN_CORE_INCLUDE_SEQAN_ALIGN_DP_BATCH_SIMD_H_
+
+#include <algorithm>
+#include <cstdlib>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SEQAN_DP_BATCH_SIMD 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+#define SEQAN_DP_BATCH_SIMD 1
+#else
+#define SEQAN_DP_BATCH_SIMD 0
+#endif
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Class DPBatchConfig_
+// ----------------------------------------------------------------------------
+
+// Run-time parameters of a batch alignment.  The scores are narrowed to the
+// lane type of a chunk after it was verified that no DP value can leave the
+// value range of the lanes.
+
+struct DPBatchConfig_
+{
+    int match;
+    int mismatch;
+    int gapOpen;
+    int gapExtend;
+    bool isLocal;
+    bool freeTop;
+    bool freeLeft;
+    bool searchRight;
+    bool searchBottom;
+
+    DPBatchConfig_() :
+        match(0), mismatch(0), gapOpen(0), gapExtend(0), isLocal(false),
+        freeTop(false), freeLeft(false), searchRight(false), searchBottom(false)
+    {}
+};
+
+// ----------------------------------------------------------------------------
+// Class DPBatchSimdTraits_
+// ----------------------------------------------------------------------------
+
+// Thin wrapper around the intrinsics for one lane type.  Only the operations
+// needed by the kernel are provided.  The vectors are always loaded and stored
+// unaligned, the buffers are plain Strings of lane values.
+
+#if SEQAN_DP_BATCH_SIMD
+
+template <typename TLane>
+struct DPBatchSimdTraits_;
+
+#if defined(__AVX2__)
+
+struct DPBatchSimdBase_
+{
+    typedef __m256i TVector;
+
+    static inline TVector load(void const * ptr)
+    {
+        return _mm256_loadu_si256(reinterpret_cast<TVector const *>(ptr));
+    }
+
+    static inline void store(void * ptr, TVector const & vec)
+    {
+        _mm256_storeu_si256(reinterpret_cast<TVector *>(ptr), vec);
+    }
+
+    static inline TVector bitAnd(TVector const & a, TVector const & b)
+    {
+        return _mm256_and_si256(a, b);
+    }
+
+    static inline TVector bitOr(TVector const & a, TVector const & b)
+    {
+        return _mm256_or_si256(a, b);
+    }
+
+    // Returns a where mask is set and b otherwise.
+    static inline TVector blend(TVector const & mask, TVector const & a, TVector const & b)
+    {
+        return _mm256_blendv_epi8(b, a, mask);
+    }
+};
+
+template <>
+struct DPBatchSimdTraits_<signed char> : DPBatchSimdBase_
+{
+    enum { LANES = 32 };
+
+    static inline TVector set1(signed char x) { return _mm256_set1_epi8(x); }
+    static inline TVector adds(TVector const & a, TVector const & b) { return _mm256_adds_epi8(a, b); }
+    static inline TVector max(TVector const & a, TVector const & b) { return _mm256_max_epi8(a, b); }
+    static inline TVector cmpeq(TVector const & a, TVector const & b) { return _mm256_cmpeq_epi8(a, b); }
+};
+
+template <>
+struct DPBatchSimdTraits_<short> : DPBatchSimdBase_
+{
+    enum { LANES = 16 };
+
+    static inline TVector set1(short x) { return _mm256_set1_epi16(x); }
+    static inline TVector adds(TVector const & a, TVector const & b) { return _mm256_adds_epi16(a, b); }
+    static inline TVector max(TVector const & a, TVector const & b) { return _mm256_max_epi16(a, b); }
+    static inline TVector cmpeq(TVector const & a, TVector const & b) { return _mm256_cmpeq_epi16(a, b); }
+};
+
+#else  // #if defined(__AVX2__)
+
+struct DPBatchSimdBase_
+{
+    typedef __m128i TVector;
+
+    static inline TVector load(void const * ptr)
+    {
+        return _mm_loadu_si128(reinterpret_cast<TVector const *>(ptr));
+    }
+
+    static inline void store(void * ptr, TVector const & vec)
+    {
+        _mm_storeu_si128(reinterpret_cast<TVector *>(ptr), vec);
+    }
+
+    static inline TVector bitAnd(TVector const & a, TVector const & b)
+    {
+        return _mm_and_si128(a, b);
+    }
+
+    static inline TVector bitOr(TVector const & a, TVector const & b)
+    {
+        return _mm_or_si128(a, b);
+    }
+
+    // Returns a where mask is set and b otherwise.
+    static inline TVector blend(TVector const & mask, TVector const & a, TVector const & b)
+    {
+#if defined(__SSE4_1__)
+        return _mm_blendv_epi8(b, a, mask);
+#else
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+#endif
+    }
+};
+
+template <>
+struct DPBatchSimdTraits_<signed char> : DPBatchSimdBase_
+{
+    enum { LANES = 16 };
+
+    static inline TVector set1(signed char x) { return _mm_set1_epi8(x); }
+    static inline TVector adds(TVector const & a, TVector const & b) { return _mm_adds_epi8(a, b); }
+    static inline TVector cmpeq(TVector const & a, TVector const & b) { return _mm_cmpeq_epi8(a, b); }
+
+    static inline TVector max(TVector const & a, TVector const & b)
+    {
+#if defined(__SSE4_1__)
+        return _mm_max_epi8(a, b);
+#else
+        return blend(_mm_cmpgt_epi8(a, b), a, b);
+#endif
+    }
+};
+
+template <>
+struct DPBatchSimdTraits_<short> : DPBatchSimdBase_
+{
+    enum { LANES = 8 };
+
+    static inline TVector set1(short x) { return _mm_set1_epi16(x); }
+    static inline TVector adds(TVector const & a, TVector const & b) { return _mm_adds_epi16(a, b); }
+    static inline TVector max(TVector const & a, TVector const & b) { return _mm_max_epi16(a, b); }
+    static inline TVector cmpeq(TVector const & a, TVector const & b) { return _mm_cmpeq_epi16(a, b); }
+};
+
+#endif  // #if defined(__AVX2__)
+
+#endif  // #if SEQAN_DP_BATCH_SIMD
+
+// ----------------------------------------------------------------------------
+// Class DPBatchChunk_
+// ----------------------------------------------------------------------------
+
+// The state of one SIMD chunk.  The sequences are stored lane-interleaved,
+// i.e. character j of all lanes is stored consecutively, and padded to the
+// longest sequence of the chunk.  The buffers are kept between chunks to
+// avoid reallocations.
+
+template <typename TLane>
+struct DPBatchChunk_
+{
+    unsigned lanes;
+    unsigned maxH;
+    unsigned maxV;
+
+    String<TLane> seqH;
+    String<TLane> seqV;
+    String<TLane> colH;         // scores of the current column, (maxV + 1) vectors
+    String<TLane> colE;         // horizontal gap scores of the current column
+    String<TLane> colMax;       // column (or matrix) maxima, only used for local alignments
+    String<TLane> trace;        // maxH * maxV trace vectors, column-major
+
+    String<unsigned> lenH;
+    String<unsigned> lenV;
+    String<int> best;
+    String<unsigned> bestH;     // end column of the best alignment
+    String<unsigned> bestV;     // end row of the best alignment
+
+    DPBatchChunk_() : lanes(0), maxH(0), maxV(0)
+    {}
+};
+
+// ----------------------------------------------------------------------------
+// Class DPBatchLengthGreater_
+// ----------------------------------------------------------------------------
+
+// Sorts the pairs by decreasing lengths, so that the pairs sharing a chunk have
+// similar lengths and little padding is computed.
+
+template <typename TSetH, typename TSetV>
+struct DPBatchLengthGreater_
+{
+    TSetH const & setH;
+    TSetV const & setV;
+
+    DPBatchLengthGreater_(TSetH const & setH_, TSetV const & setV_) : setH(setH_), setV(setV_)
+    {}
+
+    bool operator()(unsigned a, unsigned b) const
+    {
+        if (length(setV[a]) != length(setV[b]))
+            return length(setV[a]) > length(setV[b]);
+        if (length(setH[a]) != length(setH[b]))
+            return length(setH[a]) > length(setH[b]);
+        return a < b;
+    }
+};
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function _dpBatchGapScore()
+// ----------------------------------------------------------------------------
+
+// Score of a leading gap of the given length.
+inline int
+_dpBatchGapScore(DPBatchConfig_ const & config, unsigned gapLength)
+{
+    if (gapLength == 0)
+        return 0;
+    return config.gapOpen + static_cast<int>(gapLength - 1) * config.gapExtend;
+}
+
+// ----------------------------------------------------------------------------
+// Function _dpBatchSetUpConfig()
+// ----------------------------------------------------------------------------
+
+template <typename TScoreValue, typename TScoreSpec>
+inline void
+_dpBatchSetScores(DPBatchConfig_ & config, Score<TScoreValue, TScoreSpec> const & scoringScheme)
+{
+    config.gapOpen = static_cast<int>(scoreGapOpen(scoringScheme));
+    config.gapExtend = static_cast<int>(scoreGapExtend(scoringScheme));
+}
+
+template <typename TScoreValue>
+inline void
+_dpBatchSetScores(DPBatchConfig_ & config, Score<TScoreValue, Simple> const & scoringScheme)
+{
+    config.match = static_cast<int>(scoreMatch(scoringScheme));
+    config.mismatch = static_cast<int>(scoreMismatch(scoringScheme));
+    config.gapOpen = static_cast<int>(scoreGapOpen(scoringScheme));
+    config.gapExtend = static_cast<int>(scoreGapExtend(scoringScheme));
+}
+
+template <typename TScoreValue, typename TScoreSpec, bool TOP, bool LEFT, bool RIGHT, bool BOTTOM, typename TACSpec>
+inline void
+_dpBatchSetUpConfig(DPBatchConfig_ & config,
+                    Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                    AlignConfig<TOP, LEFT, RIGHT, BOTTOM, TACSpec> const &)
+{
+    _dpBatchSetScores(config, scoringScheme);
+    config.freeTop = TOP;
+    config.freeLeft = LEFT;
+    config.searchRight = RIGHT;
+    config.searchBottom = BOTTOM;
+}
+
+template <typename TScoreValue, typename TScoreSpec>
+inline void
+_dpBatchSetUpConfig(DPBatchConfig_ & config,
+                    Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                    SmithWaterman const &)
+{
+    _dpBatchSetScores(config, scoringScheme);
+    config.isLocal = true;
+}
+
+// ----------------------------------------------------------------------------
+// Function _dpBatchFitsLane()
+// ----------------------------------------------------------------------------
+
+// Returns true if all DP values of sequences of lengths up to maxH and maxV stay in [-limit, limit].
+// The smallest lane value (-limit - 1) is reserved as minus infinity.
+
+inline bool
+_dpBatchFitsLane(DPBatchConfig_ const & config, unsigned maxH, unsigned maxV, __int64 limit)
+{
+    __int64 absOpen = std::abs(config.gapOpen);
+    __int64 absExtend = std::abs(config.gapExtend);
+    __int64 absSubst = std::max(std::abs(config.match), std::abs(config.mismatch));
+
+    // Every cell can be reached by at most two gaps and one substitution from a cell
+    // that is at least as large as the all-gaps path, the gap cells by one more gap.
+    __int64 lower = 3 * absOpen + absSubst;
+    if (!config.isLocal)
+        lower += absExtend * (static_cast<__int64>(maxH) + maxV);
+    else
+        lower += absExtend;
+    __int64 upper = static_cast<__int64>(std::max(config.match, 0)) * std::min(maxH, maxV) + absSubst;
+
+    return lower <= limit && upper <= limit;
+}
+
+// ----------------------------------------------------------------------------
+// Function _dpBatchTrackColumn()
+// ----------------------------------------------------------------------------
+
+// Updates the best score and end position of every lane after column j was computed.
+// For local alignments this is only done if the column maximum of a lane exceeds its
+// current best score, in which case the (valid part of the) column is scanned.
+
+template <typename TLane>
+inline void
+_dpBatchTrackColumn(DPBatchChunk_<TLane> & chunk, DPBatchConfig_ const & config, unsigned j)
+{
+    unsigned lanes = chunk.lanes;
+    TLane const * colH = begin(chunk.colH, Standard());
+
+    for (unsigned l = 0; l < lanes; ++l)
+    {
+        unsigned lh = chunk.lenH[l];
+        unsigned lv = chunk.lenV[l];
+        if (j > lh)
+            continue;
+
+        int & best = chunk.best[l];
+        if (config.isLocal)
+        {
+            if (j == 0 || chunk.colMax[l] <= best)
+                continue;
+            for (unsigned i = 1; i <= lv; ++i)
+                if (colH[i * lanes + l] > best)
+                {
+                    best = colH[i * lanes + l];
+                    chunk.bestH[l] = j;
+                    chunk.bestV[l] = i;
+                }
+            continue;
+        }
+
+        if (config.searchBottom && colH[lv * lanes + l] > best)
+        {
+            best = colH[lv * lanes + l];
+            chunk.bestH[l] = j;
+            chunk.bestV[l] = lv;
+        }
+        if (j != lh)
+            continue;
+        if (config.searchRight)
+        {
+            for (unsigned i = 0; i <= lv; ++i)
+                if (colH[i * lanes + l] > best)
+                {
+                    best = colH[i * lanes + l];
+                    chunk.bestH[l] = j;
+                    chunk.bestV[l] = i;
+                }
+        }
+        else if (!config.searchBottom)
+        {
+            best = colH[lv * lanes + l];
+            chunk.bestH[l] = j;
+            chunk.bestV[l] = lv;
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _dpBatchComputeChunk()
+// ----------------------------------------------------------------------------
+
+// Computes the DP matrices of all lanes column by column.  The trace value of
+// a cell encodes the origin of the score (bits 0-1: 0 = diagonal, 1 =
+// horizontal gap, 2 = vertical gap, 3 = start of a local alignment) and whether
+// the horizontal (bit 2) or vertical (bit 3) gap was opened in this cell.
+
+#if SEQAN_DP_BATCH_SIMD
+
+template <bool LOCAL, bool TRACE, typename TLane>
+void
+_dpBatchComputeChunk(DPBatchChunk_<TLane> & chunk, DPBatchConfig_ const & config)
+{
+    typedef DPBatchSimdTraits_<TLane> TSimd;
+    typedef typename TSimd::TVector TVector;
+
+    unsigned const lanes = TSimd::LANES;
+    unsigned const maxH = chunk.maxH;
+    unsigned const maxV = chunk.maxV;
+    TLane const minusInf = MinValue<TLane>::VALUE;
+
+    resize(chunk.colH, (maxV + 1) * lanes);
+    resize(chunk.colE, (maxV + 1) * lanes);
+    resize(chunk.colMax, lanes);
+    if (TRACE)
+        resize(chunk.trace, static_cast<size_t>(maxH) * maxV * lanes);
+
+    TLane * colH = begin(chunk.colH, Standard());
+    TLane * colE = begin(chunk.colE, Standard());
+    TLane const * seqH = begin(chunk.seqH, Standard());
+    TLane const * seqV = begin(chunk.seqV, Standard());
+
+    // Initialize the first column.
+    for (unsigned i = 0; i <= maxV; ++i)
+    {
+        TLane init = (LOCAL || config.freeLeft) ? 0 : static_cast<TLane>(_dpBatchGapScore(config, i));
+        for (unsigned l = 0; l < lanes; ++l)
+        {
+            colH[i * lanes + l] = init;
+            colE[i * lanes + l] = minusInf;
+        }
+    }
+    _dpBatchTrackColumn(chunk, config, 0);
+
+    TVector const vMatch = TSimd::set1(static_cast<TLane>(config.match));
+    TVector const vMismatch = TSimd::set1(static_cast<TLane>(config.mismatch));
+    TVector const vOpen = TSimd::set1(static_cast<TLane>(config.gapOpen));
+    TVector const vExtend = TSimd::set1(static_cast<TLane>(config.gapExtend));
+    TVector const vMinusInf = TSimd::set1(minusInf);
+    TVector const vZero = TSimd::set1(0);
+    TVector const vFromHorizontal = TSimd::set1(1);
+    TVector const vFromVertical = TSimd::set1(2);
+    TVector const vStop = TSimd::set1(3);
+    TVector const vOpenHorizontal = TSimd::set1(4);
+    TVector const vOpenVertical = TSimd::set1(8);
+
+    // Without traceback the local score is the matrix maximum.  Cells beyond the end of a lane's sequences
+    // only derive from valid cells by adding non-positive scores and cannot exceed it.  With traceback
+    // the maximum is determined column-wise to find the end position.
+    TVector colMax = vZero;
+    for (unsigned j = 1; j <= maxH; ++j)
+    {
+        if (TRACE)
+            colMax = vZero;
+        TVector const vCharH = TSimd::load(seqH + (j - 1) * lanes);
+        TVector diag = TSimd::load(colH);
+        TVector up = TSimd::set1((LOCAL || config.freeTop) ? 0 : static_cast<TLane>(_dpBatchGapScore(config, j)));
+        TVector f = vMinusInf;
+        TSimd::store(colH, up);
+
+        TLane * trace = TRACE ? begin(chunk.trace, Standard()) + static_cast<size_t>(j - 1) * maxV * lanes : 0;
+
+        for (unsigned i = 1; i <= maxV; ++i)
+        {
+            TVector const left = TSimd::load(colH + i * lanes);
+            TVector const subst = TSimd::blend(TSimd::cmpeq(vCharH, TSimd::load(seqV + (i - 1) * lanes)),
+                                               vMatch, vMismatch);
+
+            TVector const eOpen = TSimd::adds(left, vOpen);
+            TVector const e = TSimd::max(TSimd::adds(TSimd::load(colE + i * lanes), vExtend), eOpen);
+            TVector const fOpen = TSimd::adds(up, vOpen);
+            f = TSimd::max(TSimd::adds(f, vExtend), fOpen);
+            TVector const d = TSimd::adds(diag, subst);
+            TVector h = TSimd::max(d, TSimd::max(e, f));
+            if (LOCAL)
+            {
+                h = TSimd::max(h, vZero);
+                colMax = TSimd::max(colMax, h);
+            }
+
+            if (TRACE)
+            {
+                TVector t = TSimd::blend(TSimd::cmpeq(h, d), vZero,
+                                         TSimd::blend(TSimd::cmpeq(h, f), vFromVertical, vFromHorizontal));
+                if (LOCAL)
+                    t = TSimd::blend(TSimd::cmpeq(h, vZero), vStop, t);
+                t = TSimd::bitOr(t, TSimd::bitAnd(TSimd::cmpeq(e, eOpen), vOpenHorizontal));
+                t = TSimd::bitOr(t, TSimd::bitAnd(TSimd::cmpeq(f, fOpen), vOpenVertical));
+                TSimd::store(trace + (i - 1) * lanes, t);
+            }
+
+            diag = left;
+            up = h;
+            TSimd::store(colH + i * lanes, h);
+            TSimd::store(colE + i * lanes, e);
+        }
+
+        if (LOCAL && TRACE)
+            TSimd::store(begin(chunk.colMax, Standard()), colMax);
+        if (!LOCAL || TRACE)
+            _dpBatchTrackColumn(chunk, config, j);
+    }
+
+    if (LOCAL && !TRACE)
+    {
+        TSimd::store(begin(chunk.colMax, Standard()), colMax);
+        for (unsigned l = 0; l < lanes; ++l)
+            chunk.best[l] = chunk.colMax[l];
+    }
+}
+
+#endif  // #if SEQAN_DP_BATCH_SIMD
+
+// ----------------------------------------------------------------------------
+// Function _dpBatchTraceback()
+// ----------------------------------------------------------------------------
+
+// Follows the trace of one lane from its best cell and records the segments in the
+// same order as _computeTraceback(), i.e. from the end to the begin of the alignment.
+
+template <typename TTraceSegments, typename TLane>
+void
+_dpBatchTraceback(TTraceSegments & target,
+                  DPBatchChunk_<TLane> const & chunk,
+                  DPBatchConfig_ const & config,
+                  unsigned lane)
+{
+    typedef typename TraceBitMap_::TTraceValue TTraceValue;
+
+    unsigned const lanes = chunk.lanes;
+    unsigned const lh = chunk.lenH[lane];
+    unsigned const lv = chunk.lenV[lane];
+    unsigned h = chunk.bestH[lane];
+    unsigned v = chunk.bestV[lane];
+    TLane const * trace = begin(chunk.trace, Standard());
+
+    if (!config.isLocal)
+    {
+        if (v != lv)
+            _recordSegment(target, lh, v, lv - v, +TraceBitMap_::VERTICAL);
+        if (h != lh)
+            _recordSegment(target, h, v, lh - h, +TraceBitMap_::HORIZONTAL);
+    }
+
+    TTraceValue lastDir = TraceBitMap_::NONE;
+    unsigned fragmentLength = 0;
+    int state = 0;  // 0: H, 1: horizontal gap, 2: vertical gap
+    while (h != 0 && v != 0)
+    {
+        int t = trace[(static_cast<size_t>(h - 1) * chunk.maxV + (v - 1)) * lanes + lane];
+        TTraceValue dir;
+        if (state == 0)
+        {
+            if ((t & 3) == 3)
+                break;
+            if ((t & 3) != 0)
+            {
+                state = t & 3;
+                continue;
+            }
+            dir = TraceBitMap_::DIAGONAL;
+        }
+        else if (state == 1)
+        {
+            dir = TraceBitMap_::HORIZONTAL;
+            if (t & 4)
+                state = 0;
+        }
+        else
+        {
+            dir = TraceBitMap_::VERTICAL;
+            if (t & 8)
+                state = 0;
+        }
+
+        if (dir != lastDir)
+        {
+            _recordSegment(target, h, v, fragmentLength, lastDir);
+            lastDir = dir;
+            fragmentLength = 0;
+        }
+        ++fragmentLength;
+        if (dir != TraceBitMap_::VERTICAL)
+            --h;
+        if (dir != TraceBitMap_::HORIZONTAL)
+            --v;
+    }
+    _recordSegment(target, h, v, fragmentLength, lastDir);
+
+    if (!config.isLocal)
+    {
+        // Record leading gaps if any.
+        if (v != 0u)
+            _recordSegment(target, 0, 0, v, +TraceBitMap_::VERTICAL);
+        if (h != 0u)
+            _recordSegment(target, 0, 0, h, +TraceBitMap_::HORIZONTAL);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _dpBatchAdaptTrace()
+// ----------------------------------------------------------------------------
+
+template <typename TLane>
+inline void
+_dpBatchAdaptTrace(Nothing &, unsigned, DPBatchChunk_<TLane> const &, DPBatchConfig_ const &, unsigned)
+{}
+
+template <typename TSequence, typename TAlignSpec, typename TSetSpec, typename TLane>
+inline void
+_dpBatchAdaptTrace(StringSet<Align<TSequence, TAlignSpec>, TSetSpec> & aligns,
+                   unsigned pairId,
+                   DPBatchChunk_<TLane> const & chunk,
+                   DPBatchConfig_ const & config,
+                   unsigned lane)
+{
+    typedef Align<TSequence, TAlignSpec> TAlign;
+    typedef TraceSegment_<typename Position<TAlign>::Type, typename Size<TAlign>::Type> TTraceSegment;
+
+    String<TTraceSegment> traceSegments;
+    _dpBatchTraceback(traceSegments, chunk, config, lane);
+    _adaptTraceSegmentsTo(row(aligns[pairId], 0), row(aligns[pairId], 1), traceSegments);
+}
+
+// ----------------------------------------------------------------------------
+// Function _dpBatchCollectSources()
+// ----------------------------------------------------------------------------
+
+// Collects the sources of the rows of all alignments without copying them.
+
+template <typename TSequence, typename TAlignSpec, typename TSetSpec>
+inline void
+_dpBatchCollectSources(StringSet<TSequence, Dependent<> > & setH,
+                       StringSet<TSequence, Dependent<> > & setV,
+                       StringSet<Align<TSequence, TAlignSpec>, TSetSpec> & aligns)
+{
+    typedef typename Size<StringSet<Align<TSequence, TAlignSpec>, TSetSpec> >::Type TSize;
+
+    clear(setH);
+    clear(setV);
+    reserve(setH, length(aligns), Exact());
+    reserve(setV, length(aligns), Exact());
+    for (TSize k = 0; k < length(aligns); ++k)
+    {
+        SEQAN_ASSERT_EQ(length(rows(aligns[k])), 2u);
+        appendValue(setH, source(row(aligns[k], 0)));
+        appendValue(setV, source(row(aligns[k], 1)));
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _dpBatchAlignPair()
+// ----------------------------------------------------------------------------
+
+// Scalar fallback for pairs that cannot be processed by the SIMD kernel.
+
+template <typename TSequenceH, typename TSequenceV, typename TScoreValue, typename TScoreSpec,
+          bool TOP, bool LEFT, bool RIGHT, bool BOTTOM, typename TACSpec>
+inline TScoreValue
+_dpBatchAlignPair(Nothing &, unsigned,
+                  TSequenceH const & seqH,
+                  TSequenceV const & seqV,
+                  Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                  AlignConfig<TOP, LEFT, RIGHT, BOTTOM, TACSpec> const & alignConfig)
+{
+    return globalAlignmentScore(seqH, seqV, scoringScheme, alignConfig);
+}
+
+template <typename TSequenceH, typename TSequenceV, typename TScoreValue, typename TScoreSpec>
+inline TScoreValue
+_dpBatchAlignPair(Nothing &, unsigned,
+                  TSequenceH const & seqH,
+                  TSequenceV const & seqV,
+                  Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                  SmithWaterman const & algoTag)
+{
+    String<TraceSegment_<unsigned, unsigned> > traceSegments;
+    return _setUpAndRunAlignment(traceSegments, seqH, seqV, scoringScheme, algoTag);
+}
+
+template <typename TSequence, typename TAlignSpec, typename TSetSpec, typename TSequenceH, typename TSequenceV,
+          typename TScoreValue, typename TScoreSpec, bool TOP, bool LEFT, bool RIGHT, bool BOTTOM, typename TACSpec>
+inline TScoreValue
+_dpBatchAlignPair(StringSet<Align<TSequence, TAlignSpec>, TSetSpec> & aligns,
+                  unsigned pairId,
+                  TSequenceH const &,
+                  TSequenceV const &,
+                  Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                  AlignConfig<TOP, LEFT, RIGHT, BOTTOM, TACSpec> const & alignConfig)
+{
+    return globalAlignment(aligns[pairId], scoringScheme, alignConfig);
+}
+
+template <typename TSequence, typename TAlignSpec, typename TSetSpec, typename TSequenceH, typename TSequenceV,
+          typename TScoreValue, typename TScoreSpec>
+inline TScoreValue
+_dpBatchAlignPair(StringSet<Align<TSequence, TAlignSpec>, TSetSpec> & aligns,
+                  unsigned pairId,
+                  TSequenceH const &,
+                  TSequenceV const &,
+                  Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                  SmithWaterman const &)
+{
+    return localAlignment(aligns[pairId], scoringScheme);
+}
+
+// ----------------------------------------------------------------------------
+// Function _dpBatchSetUpChunk()
+// ----------------------------------------------------------------------------
+
+// Fills the lanes of a chunk with the pairs order[first..first+count).  Unused
+// lanes get empty sequences.  Padded positions of seqH and seqV use different
+// codes that are no ordValue, so they never match.
+
+template <typename TLane, typename TSetH, typename TSetV, typename TOrder>
+void
+_dpBatchSetUpChunk(DPBatchChunk_<TLane> & chunk,
+                   unsigned lanes,
+                   TSetH const & setH,
+                   TSetV const & setV,
+                   TOrder const & order,
+                   unsigned first,
+                   unsigned count,
+                   DPBatchConfig_ const & config)
+{
+    typedef typename Value<TSetH>::Type TSequenceH;
+    typedef typename Value<TSetV>::Type TSequenceV;
+    typedef typename Iterator<TSequenceH const, Standard>::Type TIterH;
+    typedef typename Iterator<TSequenceV const, Standard>::Type TIterV;
+
+    chunk.lanes = lanes;
+    chunk.maxH = 0;
+    chunk.maxV = 0;
+    resize(chunk.lenH, lanes);
+    resize(chunk.lenV, lanes);
+    for (unsigned l = 0; l < lanes; ++l)
+    {
+        chunk.lenH[l] = (l < count) ? length(setH[order[first + l]]) : 0;
+        chunk.lenV[l] = (l < count) ? length(setV[order[first + l]]) : 0;
+        chunk.maxH = std::max(chunk.maxH, static_cast<unsigned>(chunk.lenH[l]));
+        chunk.maxV = std::max(chunk.maxV, static_cast<unsigned>(chunk.lenV[l]));
+    }
+
+    resize(chunk.seqH, chunk.maxH * lanes);
+    resize(chunk.seqV, chunk.maxV * lanes);
+    arrayFill(begin(chunk.seqH, Standard()), end(chunk.seqH, Standard()), static_cast<TLane>(-1));
+    arrayFill(begin(chunk.seqV, Standard()), end(chunk.seqV, Standard()), static_cast<TLane>(-2));
+    for (unsigned l = 0; l < count; ++l)
+    {
+        TIterH itH = begin(setH[order[first + l]], Standard());
+        for (unsigned j = 0; j < chunk.lenH[l]; ++j, ++itH)
+            chunk.seqH[j * lanes + l] = static_cast<TLane>(ordValue(*itH));
+        TIterV itV = begin(setV[order[first + l]], Standard());
+        for (unsigned i = 0; i < chunk.lenV[l]; ++i, ++itV)
+            chunk.seqV[i * lanes + l] = static_cast<TLane>(ordValue(*itV));
+    }
+
+    resize(chunk.best, lanes);
+    resize(chunk.bestH, lanes);
+    resize(chunk.bestV, lanes);
+    for (unsigned l = 0; l < lanes; ++l)
+    {
+        chunk.best[l] = config.isLocal ? 0 : MinValue<int>::VALUE;
+        chunk.bestH[l] = 0;
+        chunk.bestV[l] = 0;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _dpBatchRunChunk()
+// ----------------------------------------------------------------------------
+
+// Computes a chunk with lane type TLane if all its DP values fit into the lanes.
+// Returns the number of pairs processed, 0 if the chunk does not fit.
+
+#if SEQAN_DP_BATCH_SIMD
+
+template <typename TLane, typename TScoreValue, typename TTarget, typename TSetH, typename TSetV, typename TOrder>
+unsigned
+_dpBatchRunChunk(DPBatchChunk_<TLane> & chunk,
+                 String<TScoreValue> & scores,
+                 TTarget & target,
+                 TSetH const & setH,
+                 TSetV const & setV,
+                 TOrder const & order,
+                 unsigned first,
+                 DPBatchConfig_ const & config)
+{
+    unsigned const lanes = DPBatchSimdTraits_<TLane>::LANES;
+    unsigned const count = std::min(lanes, static_cast<unsigned>(length(order)) - first);
+
+    // The pairs are sorted by decreasing length, the first pair of the chunk is the longest one.
+    unsigned maxH = 0;
+    unsigned maxV = length(setV[order[first]]);
+    for (unsigned l = 0; l < count; ++l)
+        maxH = std::max(maxH, static_cast<unsigned>(length(setH[order[first + l]])));
+    if (!_dpBatchFitsLane(config, maxH, maxV, MaxValue<TLane>::VALUE))
+        return 0;
+
+    _dpBatchSetUpChunk(chunk, lanes, setH, setV, order, first, count, config);
+
+    bool const trace = !IsSameType<TTarget, Nothing>::VALUE;
+    if (config.isLocal)
+    {
+        if (trace)
+            _dpBatchComputeChunk<true, true>(chunk, config);
+        else
+            _dpBatchComputeChunk<true, false>(chunk, config);
+    }
+    else
+    {
+        if (trace)
+            _dpBatchComputeChunk<false, true>(chunk, config);
+        else
+            _dpBatchComputeChunk<false, false>(chunk, config);
+    }
+
+    for (unsigned l = 0; l < count; ++l)
+    {
+        scores[order[first + l]] = static_cast<TScoreValue>(chunk.best[l]);
+        _dpBatchAdaptTrace(target, order[first + l], chunk, config, l);
+    }
+    return count;
+}
+
+#endif  // #if SEQAN_DP_BATCH_SIMD
+
+// ----------------------------------------------------------------------------
+// Function _alignBatch()
+// ----------------------------------------------------------------------------
+
+// Aligns the pairs (setH[k], setV[k]) and stores the scores in scores[k] and, if target is a
+// StringSet of Align objects, the alignments in target[k].  algoConfig is an AlignConfig for
+// global and SmithWaterman for local alignments.  The pairs are processed in SIMD chunks with
+// 8 bit lanes if possible, with 16 bit lanes otherwise, and the remaining pairs (or all pairs,
+// if the scoring scheme is not supported by the kernel) with the scalar DP.
+
+template <typename TScoreValue, typename TTarget, typename TSetH, typename TSetV, typename TScoreSpec,
+          typename TAlgoConfig>
+void
+_alignBatch(String<TScoreValue> & scores,
+            TTarget & target,
+            TSetH const & setH,
+            TSetV const & setV,
+            Score<TScoreValue, TScoreSpec> const & scoringScheme,
+            TAlgoConfig const & algoConfig)
+{
+    typedef typename Value<typename Value<TSetH>::Type>::Type TAlphabetH;
+    typedef typename Value<typename Value<TSetV>::Type>::Type TAlphabetV;
+
+    SEQAN_ASSERT_EQ(length(setH), length(setV));
+    DPBatchConfig_ config;
+    _dpBatchSetUpConfig(config, scoringScheme, algoConfig);
+
+    unsigned const pairCount = length(setH);
+    resize(scores, pairCount, Exact());
+    if (pairCount == 0u)
+        return;
+
+    // The kernel compares character codes, scores with Simple and requires non-positive gap scores.
+    // For local alignments, the padding must not increase scores, i.e. mismatches must be non-positive.
+    bool simd = SEQAN_DP_BATCH_SIMD && IsSameType<TScoreSpec, Simple>::VALUE && IsIntegral<TScoreValue>::VALUE &&
+                IsSameType<TAlphabetH, TAlphabetV>::VALUE &&
+                static_cast<__uint64>(ValueSize<TAlphabetH>::VALUE) < static_cast<__uint64>(MaxValue<short>::VALUE) &&
+                config.gapOpen <= 0 && config.gapExtend <= 0 && (!config.isLocal || config.mismatch <= 0);
+
+    String<unsigned> order;
+    resize(order, pairCount, Exact());
+    for (unsigned k = 0; k < pairCount; ++k)
+        order[k] = k;
+
+    unsigned pos = 0;
+#if SEQAN_DP_BATCH_SIMD
+    if (simd)
+    {
+        std::sort(begin(order, Standard()), end(order, Standard()), DPBatchLengthGreater_<TSetH, TSetV>(setH, setV));
+
+        bool const byteCodes = static_cast<__uint64>(ValueSize<TAlphabetH>::VALUE) < static_cast<__uint64>(MaxValue<signed char>::VALUE);
+        DPBatchChunk_<signed char> chunk8;
+        DPBatchChunk_<short> chunk16;
+        while (pos < pairCount)
+        {
+            unsigned done = 0;
+            if (byteCodes)
+                done = _dpBatchRunChunk(chunk8, scores, target, setH, setV, order, pos, config);
+            if (done == 0u)
+                done = _dpBatchRunChunk(chunk16, scores, target, setH, setV, order, pos, config);
+            if (done == 0u)
+            {
+                // The chunk is too long for 16 bit lanes, align its longest pair with the scalar DP.
+                unsigned k = order[pos];
+                scores[k] = _dpBatchAlignPair(target, k, setH[k], setV[k], scoringScheme, algoConfig);
+                done = 1;
+            }
+            pos += done;
+        }
+    }
+#else
+    ignoreUnusedVariableWarning(simd);
+#endif
+
+    for (; pos < pairCount; ++pos)
+    {
+        unsigned k = order[pos];
+        scores[k] = _dpBatchAlignPair(target, k, setH[k], setV[k], scoringScheme, algoConfig);
+    }
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef SEQAN_CORE_INCLUDE_SEQAN_ALIGN_DP_BATCH_SIMD_H_
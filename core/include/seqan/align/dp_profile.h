@@ -91,6 +91,14 @@ struct GlobalAlignment_;
 struct AlignmentSuboptimal_;
 typedef Tag<AlignmentSuboptimal_> SuboptimalAlignment;
 
+// ----------------------------------------------------------------------------
+// Class StripedAlignment
+// ----------------------------------------------------------------------------
+
+// Used to specify the striped SIMD Smith-Waterman algorithm.
+struct AlignmentStriped_;
+typedef Tag<AlignmentStriped_> StripedAlignment;
+
 // ----------------------------------------------------------------------------
 // Class LocalAlignment_
 // ----------------------------------------------------------------------------
@@ -210,6 +210,13 @@ struct SetupAlignmentProfile_<SmithWaterman, TAlignConfig, TGapCosts, TTraceSwit
     typedef DPProfile_<LocalAlignment_<>, TGapCosts, TTraceSwitch> Type;
 };
 
+// Profile for the striped Smith-Waterman algorithm.
+template <typename TAlignConfig, typename TGapCosts, typename TTraceSwitch>
+struct SetupAlignmentProfile_<SmithWatermanStriped, TAlignConfig, TGapCosts, TTraceSwitch>
+{
+    typedef DPProfile_<LocalAlignment_<StripedAlignment>, TGapCosts, TTraceSwitch> Type;
+};
+
 // Profile for Waterman-Eggert algorithm
 template <typename TAlignConfig, typename TGapCosts, typename TTraceSwitch>
 struct SetupAlignmentProfile_<WatermanEggert, TAlignConfig, TGapCosts, TTraceSwitch>
@@ -0,0 +1,485 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Author: agent <agent@local>
+// ==========================================================================
+// Striped Smith-Waterman (Farrar, Bioinformatics 2007) selected by the
+// DPProfile_<LocalAlignment_<StripedAlignment>, ...> profile.  The vertical
+// sequence is the query, its scores are precomputed for every character of
+// the horizontal sequence in a striped query profile.  A column is computed
+// with saturated 8 bit lanes and recomputed with 16 bit lanes if the score
+// might have overflowed.  The vertical gaps are resolved with the lazy-F loop.
+//
+// The SIMD pass only yields the score and the end position of the best local
+// alignment.  For the traceback the begin position is computed by a second
+// pass over the reversed prefixes and the trace of the enclosed region is
+// computed with the scalar global DP.
+// ==========================================================================
+
+#ifndef SEQAN_CORE_INCLUDE_SEQAN_ALIGN_DP_STRIPED_SIMD_H_
+#define SEQAN_CORE_INCLUDE_SEQAN_ALIGN_DP_STRIPED_SIMD_H_
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Class DPStripedSimdTraits_
+// ----------------------------------------------------------------------------
+
+// Extends the intrinsics wrapper of the batch kernel by the operations needed
+// for the striped layout.  shiftUp() moves every lane to the next higher lane
+// and shifts in a zero, any() tests if a comparison mask has a set lane.
+
+#if SEQAN_DP_BATCH_SIMD
+
+template <typename TLane>
+struct DPStripedSimdTraits_;
+
+#if defined(__AVX2__)
+
+template <>
+struct DPStripedSimdTraits_<signed char> : DPBatchSimdTraits_<signed char>
+{
+    static inline TVector cmpgt(TVector const & a, TVector const & b) { return _mm256_cmpgt_epi8(a, b); }
+    static inline bool any(TVector const & mask) { return _mm256_movemask_epi8(mask) != 0; }
+
+    static inline TVector shiftUp(TVector const & a)
+    {
+        return _mm256_alignr_epi8(a, _mm256_permute2x128_si256(a, a, 0x08), 15);
+    }
+};
+
+template <>
+struct DPStripedSimdTraits_<short> : DPBatchSimdTraits_<short>
+{
+    static inline TVector cmpgt(TVector const & a, TVector const & b) { return _mm256_cmpgt_epi16(a, b); }
+    static inline bool any(TVector const & mask) { return _mm256_movemask_epi8(mask) != 0; }
+
+    static inline TVector shiftUp(TVector const & a)
+    {
+        return _mm256_alignr_epi8(a, _mm256_permute2x128_si256(a, a, 0x08), 14);
+    }
+};
+
+#else  // #if defined(__AVX2__)
+
+template <>
+struct DPStripedSimdTraits_<signed char> : DPBatchSimdTraits_<signed char>
+{
+    static inline TVector cmpgt(TVector const & a, TVector const & b) { return _mm_cmpgt_epi8(a, b); }
+    static inline bool any(TVector const & mask) { return _mm_movemask_epi8(mask) != 0; }
+    static inline TVector shiftUp(TVector const & a) { return _mm_slli_si128(a, 1); }
+};
+
+template <>
+struct DPStripedSimdTraits_<short> : DPBatchSimdTraits_<short>
+{
+    static inline TVector cmpgt(TVector const & a, TVector const & b) { return _mm_cmpgt_epi16(a, b); }
+    static inline bool any(TVector const & mask) { return _mm_movemask_epi8(mask) != 0; }
+    static inline TVector shiftUp(TVector const & a) { return _mm_slli_si128(a, 2); }
+};
+
+#endif  // #if defined(__AVX2__)
+
+#endif  // #if SEQAN_DP_BATCH_SIMD
+
+// ----------------------------------------------------------------------------
+// Class DPStripedProfile_
+// ----------------------------------------------------------------------------
+
+// The striped query profile and the column buffers.  Query position i is
+// stored in segment i % segLen and lane i / segLen.  The profile row of a
+// character of the horizontal sequence is computed when it occurs first.
+
+template <typename TLane>
+struct DPStripedProfile_
+{
+    unsigned segLen;
+    int maxScore;               // largest substitution score in the computed rows
+
+    String<TLane> profile;      // ValueSize rows of segLen vectors
+    String<bool> hasRow;
+    String<TLane> colH;         // scores of the previous column
+    String<TLane> colHNext;     // scores of the current column
+    String<TLane> colE;         // horizontal gap scores
+    String<TLane> colBest;      // scores of the column containing the best cell
+
+    DPStripedProfile_() : segLen(0), maxScore(0)
+    {}
+};
+
+// ----------------------------------------------------------------------------
+// Class DPStripedResult_
+// ----------------------------------------------------------------------------
+
+struct DPStripedResult_
+{
+    int best;
+    unsigned endH;              // column of the last aligned character of seqH
+    unsigned endV;              // row of the last aligned character of seqV
+    unsigned beginH;
+    unsigned beginV;
+
+    DPStripedResult_() : best(0), endH(0), endV(0), beginH(0), beginV(0)
+    {}
+};
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+#if SEQAN_DP_BATCH_SIMD
+
+// ----------------------------------------------------------------------------
+// Function _dpStripedComputeProfileRow()
+// ----------------------------------------------------------------------------
+
+// Returns false if a substitution score does not fit into the lanes.
+template <typename TLane, typename TValueH, typename TSequenceV, typename TScoreValue, typename TScoreSpec>
+inline bool
+_dpStripedComputeProfileRow(DPStripedProfile_<TLane> & prof,
+                            unsigned rowId,
+                            TValueH const & valH,
+                            TSequenceV const & seqV,
+                            Score<TScoreValue, TScoreSpec> const & scoringScheme)
+{
+    unsigned const LANES = DPStripedSimdTraits_<TLane>::LANES;
+    int const laneMin = MinValue<TLane>::VALUE;
+    int const laneMax = MaxValue<TLane>::VALUE;
+    unsigned lenV = length(seqV);
+
+    TLane * row = begin(prof.profile, Standard()) + rowId * prof.segLen * LANES;
+    for (unsigned s = 0; s < prof.segLen; ++s)
+    {
+        for (unsigned k = 0; k < LANES; ++k)
+        {
+            unsigned i = k * prof.segLen + s;
+            // The padding rows behind the query never score positive.
+            int val = laneMin;
+            if (i < lenV)
+            {
+                val = static_cast<int>(score(scoringScheme, valH, seqV[i]));
+                if (val >= laneMax)
+                    return false;
+                prof.maxScore = _max(prof.maxScore, val);
+                val = _max(val, laneMin);
+            }
+            row[s * LANES + k] = static_cast<TLane>(val);
+        }
+    }
+    prof.hasRow[rowId] = true;
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Function _dpStripedFill()
+// ----------------------------------------------------------------------------
+
+// Computes the best local score and its end position.  Scores below the lane
+// minimum are clamped: since no cell exceeds the lane maximum, a clamped
+// value is negative either way and cut off at zero.  Returns false if the
+// score might have overflowed the lanes.
+
+template <typename TLane, typename TSequenceH, typename TSequenceV, typename TScoreValue, typename TScoreSpec>
+inline bool
+_dpStripedFill(DPStripedResult_ & result,
+               DPStripedProfile_<TLane> & prof,
+               TSequenceH const & seqH,
+               TSequenceV const & seqV,
+               Score<TScoreValue, TScoreSpec> const & scoringScheme)
+{
+    typedef DPStripedSimdTraits_<TLane> TTraits;
+    typedef typename TTraits::TVector TVector;
+    typedef typename Value<TSequenceH>::Type TValueH;
+
+    unsigned const LANES = TTraits::LANES;
+    int const laneMin = MinValue<TLane>::VALUE;
+    int const laneMax = MaxValue<TLane>::VALUE;
+
+    unsigned lenH = length(seqH);
+    unsigned lenV = length(seqV);
+    prof.segLen = (lenV + LANES - 1) / LANES;
+    prof.maxScore = 0;
+    unsigned segSize = prof.segLen * LANES;
+
+    resize(prof.profile, +ValueSize<TValueH>::VALUE * segSize, Exact());
+    clear(prof.hasRow);
+    resize(prof.hasRow, +ValueSize<TValueH>::VALUE, false, Exact());
+    resize(prof.colH, segSize, Exact());
+    resize(prof.colHNext, segSize, Exact());
+    resize(prof.colE, segSize, Exact());
+    resize(prof.colBest, segSize, Exact());
+    arrayFill(begin(prof.colH, Standard()), end(prof.colH, Standard()), static_cast<TLane>(0));
+    arrayFill(begin(prof.colE, Standard()), end(prof.colE, Standard()), static_cast<TLane>(0));
+    arrayFill(begin(prof.colBest, Standard()), end(prof.colBest, Standard()), static_cast<TLane>(0));
+
+    TVector const vZero = TTraits::set1(0);
+    TVector const vGapOpen = TTraits::set1(static_cast<TLane>(_max(static_cast<int>(scoreGapOpen(scoringScheme)),
+                                                                   laneMin)));
+    TVector const vGapExtend = TTraits::set1(static_cast<TLane>(_max(static_cast<int>(scoreGapExtend(scoringScheme)),
+                                                                     laneMin)));
+    TVector const vGapLazy = TTraits::max(vGapOpen, vGapExtend);
+    TVector vBest = vZero;
+
+    TLane * pH = begin(prof.colH, Standard());
+    TLane * pHNext = begin(prof.colHNext, Standard());
+    TLane * pE = begin(prof.colE, Standard());
+    TLane laneBuffer[LANES];
+
+    result.best = 0;
+    result.endH = 0;
+    result.endV = 0;
+
+    for (unsigned j = 0; j < lenH; ++j)
+    {
+        TValueH valH = seqH[j];
+        unsigned rowId = ordValue(valH);
+        if (!prof.hasRow[rowId] && !_dpStripedComputeProfileRow(prof, rowId, valH, seqV, scoringScheme))
+            return false;
+        TLane const * pProfile = begin(prof.profile, Standard()) + rowId * segSize;
+
+        // The diagonal predecessor of segment 0 is the last segment shifted by one lane.
+        TVector vH = TTraits::shiftUp(TTraits::load(pH + (prof.segLen - 1) * LANES));
+        TVector vF = vZero;
+        TVector vColMax = vZero;
+
+        for (unsigned s = 0; s < prof.segLen; ++s)
+        {
+            vH = TTraits::adds(vH, TTraits::load(pProfile + s * LANES));
+            TVector vE = TTraits::load(pE + s * LANES);
+            vH = TTraits::max(TTraits::max(vH, vE), TTraits::max(vF, vZero));
+            vColMax = TTraits::max(vColMax, vH);
+            TTraits::store(pHNext + s * LANES, vH);
+
+            TVector vHOpen = TTraits::adds(vH, vGapOpen);
+            TTraits::store(pE + s * LANES, TTraits::max(TTraits::adds(vE, vGapExtend), vHOpen));
+            vF = TTraits::max(TTraits::adds(vF, vGapExtend), vHOpen);
+            vH = TTraits::load(pH + s * LANES);
+        }
+
+        // Lazy-F loop: propagate the vertical gaps across the segment borders
+        // until they cannot improve any cell.  The gaps opened in unchanged
+        // cells were already propagated above, so F only continues its own
+        // chain.  Where F replaces H, the chain might also be reopened, which
+        // is the cheaper step if the gap open score exceeds the extension.
+        vF = TTraits::shiftUp(vF);
+        unsigned s = 0;
+        vH = TTraits::load(pHNext);
+        while (TTraits::any(TTraits::cmpgt(vF, TTraits::max(TTraits::adds(vH, vGapOpen), vZero))))
+        {
+            vH = TTraits::max(vH, vF);
+            vColMax = TTraits::max(vColMax, vH);
+            TTraits::store(pHNext + s * LANES, vH);
+
+            TTraits::store(pE + s * LANES, TTraits::max(TTraits::load(pE + s * LANES), TTraits::adds(vH, vGapOpen)));
+            vF = TTraits::adds(vF, vGapLazy);
+            if (++s == prof.segLen)
+            {
+                s = 0;
+                vF = TTraits::shiftUp(vF);
+            }
+            vH = TTraits::load(pHNext + s * LANES);
+        }
+
+        if (TTraits::any(TTraits::cmpgt(vColMax, vBest)))
+        {
+            TTraits::store(laneBuffer, vColMax);
+            for (unsigned k = 0; k < LANES; ++k)
+                result.best = _max(result.best, static_cast<int>(laneBuffer[k]));
+            if (result.best + prof.maxScore >= laneMax)
+                return false;
+            vBest = TTraits::set1(static_cast<TLane>(result.best));
+            result.endH = j;
+            arrayCopyForward(pHNext, pHNext + segSize, begin(prof.colBest, Standard()));
+        }
+        std::swap(pH, pHNext);
+    }
+
+    if (result.best + prof.maxScore >= laneMax)
+        return false;
+
+    // The first row of the best column reaching the best score.
+    for (unsigned i = 0; i < lenV && result.best > 0; ++i)
+    {
+        if (prof.colBest[(i % prof.segLen) * LANES + i / prof.segLen] == result.best)
+        {
+            result.endV = i;
+            break;
+        }
+    }
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Function _dpStripedRun()
+// ----------------------------------------------------------------------------
+
+// Computes the score and end position and, if requested, the begin position of
+// the best local alignment.  The end position is the first maximal cell in
+// column-major order, hence no alignment of the same score ends in a cell that
+// precedes it.  Therefore, the best local alignment of the reversed prefixes
+// starts in the end cell and its end yields the begin position.
+
+template <typename TLane, typename TSequenceH, typename TSequenceV, typename TScoreValue, typename TScoreSpec>
+inline bool
+_dpStripedRun(DPStripedResult_ & result,
+              TSequenceH const & seqH,
+              TSequenceV const & seqV,
+              Score<TScoreValue, TScoreSpec> const & scoringScheme,
+              bool computeBegin)
+{
+    DPStripedProfile_<TLane> prof;
+    if (!_dpStripedFill(result, prof, seqH, seqV, scoringScheme))
+        return false;
+    if (!computeBegin || result.best == 0)
+        return true;
+
+    String<typename Value<TSequenceH>::Type> revH;
+    String<typename Value<TSequenceV>::Type> revV;
+    resize(revH, result.endH + 1, Exact());
+    resize(revV, result.endV + 1, Exact());
+    for (unsigned j = 0; j <= result.endH; ++j)
+        revH[j] = seqH[result.endH - j];
+    for (unsigned i = 0; i <= result.endV; ++i)
+        revV[i] = seqV[result.endV - i];
+
+    DPStripedResult_ revResult;
+    if (!_dpStripedFill(revResult, prof, revH, revV, scoringScheme))
+        return false;
+    SEQAN_ASSERT_EQ(revResult.best, result.best);
+    result.beginH = result.endH - revResult.endH;
+    result.beginV = result.endV - revResult.endV;
+    return true;
+}
+
+#endif  // #if SEQAN_DP_BATCH_SIMD
+
+// ----------------------------------------------------------------------------
+// Function _dpStripedLocalAlignment()
+// ----------------------------------------------------------------------------
+
+// Returns false if the striped kernel cannot be used for the given input.
+template <typename TSequenceH, typename TSequenceV, typename TScoreValue, typename TScoreSpec>
+inline bool
+_dpStripedLocalAlignment(DPStripedResult_ & result,
+                         TSequenceH const & seqH,
+                         TSequenceV const & seqV,
+                         Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                         bool computeBegin)
+{
+#if SEQAN_DP_BATCH_SIMD
+    typedef typename Value<TSequenceH>::Type TValueH;
+
+    if (!IsIntegral<TScoreValue>::VALUE || +ValueSize<TValueH>::VALUE > 256u)
+        return false;
+    if (scoreGapOpen(scoringScheme) > 0 || scoreGapExtend(scoringScheme) > 0)
+        return false;
+    if (empty(seqH) || empty(seqV))
+        return false;
+
+    if (_dpStripedRun<signed char>(result, seqH, seqV, scoringScheme, computeBegin))
+        return true;
+    return _dpStripedRun<short>(result, seqH, seqV, scoringScheme, computeBegin);
+#else
+    (void)result;
+    (void)seqH;
+    (void)seqV;
+    (void)scoringScheme;
+    (void)computeBegin;
+    return false;
+#endif
+}
+
+// ----------------------------------------------------------------------------
+// Function _computeAlignment()                              [StripedAlignment]
+// ----------------------------------------------------------------------------
+
+// Falls back to the standard Smith-Waterman profile if the striped kernel is
+// not applicable or the score exceeds the 16 bit lanes.
+
+template <typename TTraceTarget, typename TScoutState, typename TSequenceH, typename TSequenceV,
+          typename TScoreValue, typename TScoreSpec, typename TGapCosts, typename TTraceFlag>
+inline typename Value<Score<TScoreValue, TScoreSpec> >::Type
+_computeAlignment(TTraceTarget & traceSegments,
+                  TScoutState & scoutState,
+                  TSequenceH const & seqH,
+                  TSequenceV const & seqV,
+                  Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                  DPBand_<BandOff> const & band,
+                  DPProfile_<LocalAlignment_<StripedAlignment>, TGapCosts, TTraceFlag> const &)
+{
+    typedef typename Value<TTraceTarget>::Type TTraceSegment;
+    typedef typename Infix<TSequenceH const>::Type TInfixH;
+    typedef typename Infix<TSequenceV const>::Type TInfixV;
+
+    DPStripedResult_ result;
+    bool withTrace = IsTracebackEnabled_<TTraceFlag>::VALUE;
+    // An alignment of score 0 is empty, the standard algorithm handles this case.
+    if (!_dpStripedLocalAlignment(result, seqH, seqV, scoringScheme, withTrace) || (withTrace && result.best == 0))
+        return _computeAlignment(traceSegments, scoutState, seqH, seqV, scoringScheme, band,
+                                 DPProfile_<LocalAlignment_<>, TGapCosts, TTraceFlag>());
+
+    if (!withTrace)
+        return result.best;
+
+    // The best local alignment is the best global alignment of the enclosed region.
+    TInfixH infixH = infix(seqH, result.beginH, result.endH + 1);
+    TInfixV infixV = infix(seqV, result.beginV, result.endV + 1);
+    String<TTraceSegment> regionSegments;
+    TScoreValue regionScore = _setUpAndRunAlignment(regionSegments, infixH, infixV, scoringScheme, AlignConfig<>(),
+                                                    Gotoh());
+    SEQAN_ASSERT_EQ(static_cast<int>(regionScore), result.best);
+    (void)regionScore;
+
+    for (unsigned k = 0; k < length(regionSegments); ++k)
+    {
+        TTraceSegment segment = regionSegments[k];
+        segment._horizontalBeginPos += result.beginH;
+        segment._verticalBeginPos += result.beginV;
+        appendValue(traceSegments, segment);
+    }
+    return result.best;
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef SEQAN_CORE_INCLUDE_SEQAN_ALIGN_DP_STRIPED_SIMD_H_
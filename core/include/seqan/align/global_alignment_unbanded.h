@@ -84,6 +84,7 @@ class Fragment;
  * @signature TScoreVal globalAlignment(gapsH, gapsV,   scoringScheme, [alignConfig,] [lowerDiag, upperDiag,] [algorithmTag]);
  * @signature TScoreVal globalAlignment(frags, strings, scoringScheme, [alignConfig,] [lowerDiag, upperDiag,] [algorithmTag]);
  * @signature TScoreVal globalAlignment(alignGraph,     scoringScheme, [alignConfig,] [lowerDiag, upperDiag,] [algorithmTag]);
+ * @signature String<TScoreVal> globalAlignment(alignSet, scoringScheme, [alignConfig]);
  * 
  * @param align        The @link Align @endlink object to use for storing the pairwise alignment.
  * @param gapsH        The @link Gaps @endlink object for the first row (horizontal in the DP matrix).
@@ -91,6 +92,8 @@ class Fragment;
  * @param frags        String of @link Fragment @endlink objects to store alignment in.
  * @param strings      StringSet of length two with the strings to align.
  * @param alignGraph   Alignment Graph for the resulting alignment.  Must be initialized with two strings.
+ * @param alignSet     A @link StringSet @endlink of @link Align @endlink objects with two rows each.  All pairs are
+ *                     aligned, the scores are returned in a String.
  * @param scoringScheme The @link Score scoring scheme @endlink to use for the alignment.  Note that
  *                      the user is responsible for ensuring that the scoring scheme is compatible with <tt>algorithmTag</tt>.
  * @param alignConfig  @link AlignConfig @endlink instance to use for the alignment configuration.
@@ -123,6 +126,10 @@ class Fragment;
  * Needleman-Wunsch algorithm supports scoring schemes with linear gap costs only while Gotoh's algorithm also allows
  * affine gap costs.
  * 
+ * For many short pairs, <tt>alignSet</tt> can be used to align a whole batch of pairs at once.  With a @link
+ * SimpleScore @endlink with integral scores and non-positive gap scores, pairs of similar lengths are aligned
+ * simultaneously in the lanes of SSE or AVX2 registers, the other pairs are aligned one by one.
+ * 
  * The available alignment algorithms all have some restrictions.  Gotoh's algorithm can handle arbitrary substitution
  * and affine gap scores.  Needleman-Wunsch is limited to linear gap scores.  The implementation of Hirschberg's
  * algorithm is further limited that it does not support <tt>alignConfig</tt> objects or banding.  The implementation of
@@ -173,6 +180,7 @@ class Fragment;
 ..signature:globalAlignment(gapsH, gapsV,   scoringScheme, [alignConfig,] [lowerDiag, upperDiag,] [algorithmTag])
 ..signature:globalAlignment(frags, strings, scoringScheme, [alignConfig,] [lowerDiag, upperDiag,] [algorithmTag])
 ..signature:globalAlignment(alignmentGraph, scoringScheme, [alignConfig,] [lowerDiag, upperDiag,] [algorithmTag])
+..signature:globalAlignment(alignSet,       scoringScheme, [alignConfig])
 ..param.align:
 An @Class.Align@ object that stores the alignment.
 The number of rows must be 2 and the sequences must have already been set.
@@ -191,6 +199,10 @@ The sequence with id $0$ is the horizontal one, the sequence with id $1$ is the
 ...remarks:The underlying @Class.StringSet@ must be an @Spec.Owner|Owner StringSet@.
 ..param.strings:A @Class.StringSet@ containing two sequences.
 ...type:Class.StringSet
+..param.alignSet:
+A @Class.StringSet@ of @Class.Align@ objects with two rows each.
+All pairs are aligned, the scores are returned in a @Class.String@.
+...type:Class.StringSet
 ..param.scoringScheme:
 The scoring scheme to use for the alignment.
 Note that the user is responsible for ensuring that the scoring scheme is compatible with $algorithmTag$.
@@ -226,6 +238,9 @@ Fourth, you can select the algorithm to use with $algorithmTag$.
 This can be one of @Tag.Pairwise Global Alignment Algorithms.value.NeedlemanWunsch@ and @Tag.Pairwise Global Alignment Algorithms.value.Gotoh@.
 The Needleman-Wunsch algorithm supports scoring schemes with linear gap costs only while Gotoh's algorithm also allows affine gap costs.
 ..remarks:
+For many short pairs, $alignSet$ can be used to align a whole batch of pairs at once.
+With a @Spec.Simple Score@ with integral scores and non-positive gap scores, pairs of similar lengths are aligned simultaneously in the lanes of SSE or AVX2 registers, the other pairs are aligned one by one.
+..remarks:
 The available alignment algorithms all have some restrictions.
 Gotoh's algorithm can handle arbitrary substitution and affine gap scores.
 Needleman-Wunsch is limited to linear gap scores.
@@ -529,6 +544,37 @@ TScoreValue globalAlignment(String<Fragment<TSize, TFragmentSpec>, TStringSpec>
     return globalAlignment(fragmentString, strings, scoringScheme, alignConfig);
 }
 
+// ----------------------------------------------------------------------------
+// Function globalAlignment()                                 [unbanded, batch]
+// ----------------------------------------------------------------------------
+
+template <typename TSequence, typename TAlignSpec, typename TSetSpec,
+          typename TScoreValue, typename TScoreSpec,
+          bool TOP, bool LEFT, bool RIGHT, bool BOTTOM, typename TACSpec>
+String<TScoreValue> globalAlignment(StringSet<Align<TSequence, TAlignSpec>, TSetSpec> & alignSet,
+                                    Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                                    AlignConfig<TOP, LEFT, RIGHT, BOTTOM, TACSpec> const & alignConfig)
+{
+    StringSet<TSequence, Dependent<> > seqSetH;
+    StringSet<TSequence, Dependent<> > seqSetV;
+    _dpBatchCollectSources(seqSetH, seqSetV, alignSet);
+
+    String<TScoreValue> scores;
+    _alignBatch(scores, alignSet, seqSetH, seqSetV, scoringScheme, alignConfig);
+    return scores;
+}
+
+// Interface without AlignConfig<>.
+
+template <typename TSequence, typename TAlignSpec, typename TSetSpec,
+          typename TScoreValue, typename TScoreSpec>
+String<TScoreValue> globalAlignment(StringSet<Align<TSequence, TAlignSpec>, TSetSpec> & alignSet,
+                                    Score<TScoreValue, TScoreSpec> const & scoringScheme)
+{
+    AlignConfig<> alignConfig;
+    return globalAlignment(alignSet, scoringScheme, alignConfig);
+}
+
 // ----------------------------------------------------------------------------
 // Function globalAlignmentScore()
 // ----------------------------------------------------------------------------
@@ -541,10 +587,14 @@ TScoreValue globalAlignment(String<Fragment<TSize, TFragmentSpec>, TStringSpec>
  * @signature TScoreVal globalAlignmentScore(strings,    scoringScheme[, alignConfig][, lowerDiag, upperDiag][, algorithmTag]);
  * @signature TScoreVal globalAlignmentScore(seqH, seqV, {MyersBitVector | MyersHirschberg});
  * @signature TScoreVal globalAlignmentScore(strings,    {MyersBitVector | MyersHirschberg});
+ * @signature String<TScoreVal> globalAlignmentScore(seqSetH, seqSetV, scoringScheme[, alignConfig]);
  * 
  * @param[in] seqH          Horizontal gapped sequence in alignment matrix.  Types: String
  * @param[in] seqV          Vertical gapped sequence in alignment matrix.  Types: String
  * @param[in] strings       A @link StringSet @endlink containing two sequences.  Type: StringSet.
+ * @param[in] seqSetH       A @link StringSet @endlink with the horizontal sequences of a batch of pairs.
+ * @param[in] seqSetV       A @link StringSet @endlink with the vertical sequences, of the same length as
+ *                          <tt>seqSetH</tt>.
  * @param[in] alignConfig   The @link AlignConfig @endlink to use for the alignment.  Type: AlignConfig
  * @param[in] scoringScheme The scoring scheme to use for the alignment.  Note that the user is responsible for ensuring
  *                          that the scoring scheme is compatible with <tt>algorithmTag</tt>.  Type: @link Score @endlink.
@@ -565,6 +615,9 @@ TScoreValue globalAlignment(String<Fragment<TSize, TFragmentSpec>, TStringSpec>
  * The same limitations to algorithms as in @link globalAlignment @endlink apply.  Furthermore, the
  * <tt>MyersBitVector</tt> and <tt>MyersHirschberg</tt> variants can only be used without any other parameter.
  * 
+ * Given two StringSets <tt>seqSetH</tt> and <tt>seqSetV</tt>, the scores of all pairs <tt>seqSetH[i]</tt> and
+ * <tt>seqSetV[i]</tt> are returned in a String.  See @link globalAlignment @endlink for the vectorized batch alignment.
+ * 
  * @see http://trac.seqan.de/wiki/Tutorial/PairwiseSequenceAlignment
  * @see globalAlignment
  */
@@ -577,12 +630,17 @@ TScoreValue globalAlignment(String<Fragment<TSize, TFragmentSpec>, TStringSpec>
 ..signature:globalAlignmentScore(strings,    scoringScheme, [alignConfig,] [lowerDiag, upperDiag,] [algorithmTag])
 ..signature:globalAlignmentScore(seqH, seqV, {MyersBitVector | MyersHirschberg})
 ..signature:globalAlignmentScore(strings,    {MyersBitVector | MyersHirschberg})
+..signature:globalAlignmentScore(seqSetH, seqSetV, scoringScheme, [alignConfig])
 ..param.seqH:Horizontal gapped sequence in alignment matrix.
 ...type:Class.String
 ..param.seqV:Vertical gapped sequence in alignment matrix.
 ...type:Class.String
 ..param.strings:A @Class.StringSet@ containing two sequences.
 ...type:Class.StringSet
+..param.seqSetH:The horizontal sequences of a batch of pairs.
+...type:Class.StringSet
+..param.seqSetV:The vertical sequences of a batch of pairs, must have the same length as $seqSetH$.
+...type:Class.StringSet
 ..param.scoringScheme:
 The scoring scheme to use for the alignment.
 Note that the user is responsible for ensuring that the scoring scheme is compatible with $algorithmTag$.
@@ -606,6 +664,9 @@ Note that Myers' bit-vector algorithm does not compute an alignment (only in the
 ..remarks:
 The same limitations to algorithms as in @Function.globalAlignment@ apply.
 Furthermore, the $MyersBitVector$ and $MyersHirschberg$ variants can only be used without any other parameter.
+..remarks:
+Given two StringSets $seqSetH$ and $seqSetV$, the scores of all pairs $seqSetH[i]$ and $seqSetV[i]$ are returned in a @Class.String@.
+See @Function.globalAlignment@ for the vectorized batch alignment.
 ..see:Function.globalAlignment
 ..wiki:Tutorial/PairwiseSequenceAlignment
 */
@@ -735,6 +796,40 @@ TScoreValue globalAlignmentScore(StringSet<TString, TSpec> const & strings,
     return globalAlignmentScore(strings[0], strings[1], scoringScheme, alignConfig);
 }
 
+// ----------------------------------------------------------------------------
+// Function globalAlignmentScore()                            [unbanded, batch]
+// ----------------------------------------------------------------------------
+
+template <typename TSequenceH, typename TSpecH,
+          typename TSequenceV, typename TSpecV,
+          typename TScoreValue, typename TScoreSpec,
+          bool TOP, bool LEFT, bool RIGHT, bool BOTTOM, typename TACSpec>
+String<TScoreValue> globalAlignmentScore(StringSet<TSequenceH, TSpecH> const & seqSetH,
+                                         StringSet<TSequenceV, TSpecV> const & seqSetV,
+                                         Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                                         AlignConfig<TOP, LEFT, RIGHT, BOTTOM, TACSpec> const & alignConfig)
+{
+    SEQAN_ASSERT_EQ(length(seqSetH), length(seqSetV));
+
+    Nothing noTrace;
+    String<TScoreValue> scores;
+    _alignBatch(scores, noTrace, seqSetH, seqSetV, scoringScheme, alignConfig);
+    return scores;
+}
+
+// Interface without AlignConfig<>.
+
+template <typename TSequenceH, typename TSpecH,
+          typename TSequenceV, typename TSpecV,
+          typename TScoreValue, typename TScoreSpec>
+String<TScoreValue> globalAlignmentScore(StringSet<TSequenceH, TSpecH> const & seqSetH,
+                                         StringSet<TSequenceV, TSpecV> const & seqSetV,
+                                         Score<TScoreValue, TScoreSpec> const & scoringScheme)
+{
+    AlignConfig<> alignConfig;
+    return globalAlignmentScore(seqSetH, seqSetV, scoringScheme, alignConfig);
+}
+
 }  // namespace seqan
 
 #endif  // #ifndef SEQAN_CORE_INCLUDE_SEQAN_ALIGN_GLOBAL_ALIGNMENT_UNBANDED_H_
@@ -66,7 +66,10 @@ namespace seqan {
  * 
  * @signature TScoreVal localAlignment(align,          scoringScheme, [lowerDiag, upperDiag]);
  * @signature TScoreVal localAlignment(gapsH, gapsV,   scoringScheme, [lowerDiag, upperDiag]);
+ * @signature TScoreVal localAlignment(align,          scoringScheme, algorithmTag);
+ * @signature TScoreVal localAlignment(gapsH, gapsV,   scoringScheme, algorithmTag);
  * @signature TScoreVal localAlignment(fragmentString, scoringScheme, [lowerDiag, upperDiag]);
+ * @signature String<TScoreVal> localAlignment(alignSet, scoringScheme);
  * 
  * @param lowerDiag Optional lower diagonal (<tt>int</tt>).
  * @param lowerDiag Optional upper diagonal (<tt>int</tt>).
@@ -81,6 +84,10 @@ namespace seqan {
  *                       with id <tt>0</tt> is the horizontal one, the sequence
  *                       with id <tt>1</tt> is the vertical one.
  * @param gapsV Vertical gapped sequence in alignment matrix. Types: Gaps
+ * @param alignSet A @link StringSet @endlink of @link Align @endlink objects with two rows each.
+ *                 All pairs are aligned, the scores are returned in a String.
+ * @param algorithmTag The Tag for picking the alignment algorithm, either <tt>SmithWaterman</tt> (default) or
+ *                     <tt>SmithWatermanStriped</tt>. Types: PairwiseLocalAlignmentAlgorithms
  * @param scoringScheme The scoring scheme to use for the alignment. Note that
  *                      the user is responsible for ensuring that the scoring
  *                      scheme is compatible with <tt>algorithmTag</tt>. Types:
@@ -112,6 +119,14 @@ namespace seqan {
  * diagonal has index <tt>0</tt>, the <tt>i</tt>th diagonal below has index <tt>-i</tt>, the <tt>i</tt>th above has
  * index <tt>i</tt>.
  * 
+ * For many short pairs, <tt>alignSet</tt> can be used to align a whole batch of pairs at once.  With a @link
+ * SimpleScore @endlink with integral scores and non-positive gap and mismatch scores, pairs of similar lengths are
+ * aligned simultaneously in the lanes of SSE or AVX2 registers, the other pairs are aligned one by one.
+ * 
+ * For long pairs, e.g. when scanning a protein database with a @link ScoreMatrix @endlink, the
+ * <tt>SmithWatermanStriped</tt> tag computes the matrix with a striped SIMD query profile of the vertical sequence.
+ * The optimal score is the same, but another alignment of the same score may be returned.
+ * 
  * The examples below show some common use cases.
  * 
  * @section Examples
@@ -153,6 +168,7 @@ namespace seqan {
  * </ul>
  *
  * @see globalAlignment
+ * @see localAlignmentScore
  * @see LocalAlignmentEnumerator
  * @see PairwiseLocalAlignmentAlgorithms
  */
@@ -164,6 +180,9 @@ namespace seqan {
 ..signature:localAlignment(align,          scoringScheme, [lowerDiag, upperDiag])
 ..signature:localAlignment(gapsH, gapsV,   scoringScheme, [lowerDiag, upperDiag])
 ..signature:localAlignment(fragmentString, scoringScheme, [lowerDiag, upperDiag])
+..signature:localAlignment(align,          scoringScheme, algorithmTag)
+..signature:localAlignment(gapsH, gapsV,   scoringScheme, algorithmTag)
+..signature:localAlignment(alignSet,       scoringScheme)
 ..param.align:
 An @Class.Align@ object that stores the alignment.
 The number of rows must be 2 and the sequences must have already been set.
@@ -176,6 +195,10 @@ $align[0]$ is the horizontal one in the alignment matrix alignment, $align[1]$ i
 ..param.fragmentString:
 String of @Class.Fragment@ objects.
 The sequence with id $0$ is the horizontal one, the sequence with id $1$ is the vertical one.
+..param.alignSet:
+A @Class.StringSet@ of @Class.Align@ objects with two rows each.
+All pairs are aligned, the scores are returned in a @Class.String@.
+...type:Class.StringSet
 ..param.scoringScheme:
 The scoring scheme to use for the alignment.
 Note that the user is responsible for ensuring that the scoring scheme is compatible with $algorithmTag$.
@@ -184,6 +207,8 @@ Note that the user is responsible for ensuring that the scoring scheme is compat
 ...type:nolink:$int$
 ..param.upperDiag:Optional upper diagonal.
 ...type:nolink:$int$
+..param.algorithmTag:Tag for picking the alignment algorithm, $SmithWaterman$ (default) or $SmithWatermanStriped$.
+...type:Tag.Pairwise Local Alignment Algorithms
 ..returns:An integer with the alignment score, as given by the @Metafunction.Value@ metafunction of the @Class.Score@ type.
 ..remarks:The Waterman-Eggert algorithm (local alignment with declumping) is available through the @Class.LocalAlignmentEnumerator@ class.
 ..remarks:
@@ -202,6 +227,12 @@ Using @Class.Fragment@ strings is useful for collecting many pairwise alignments
 Second, you can optionally give a band for the alignment using $lowerDiag$ and $upperDiag$.
 The center diagonal has index $0$, the $i$th diagonal below has index $-i$, the $i$th above has index $i$.
 ..remarks:
+For many short pairs, $alignSet$ can be used to align a whole batch of pairs at once.
+With a @Spec.Simple Score@ with integral scores and non-positive gap and mismatch scores, pairs of similar lengths are aligned simultaneously in the lanes of SSE or AVX2 registers, the other pairs are aligned one by one.
+..remarks:
+For long pairs, e.g. when scanning a protein database with a @Spec.Score Matrix@, the $SmithWatermanStriped$ tag computes the matrix with a striped SIMD query profile of the vertical sequence.
+The optimal score is the same, but another alignment of the same score may be returned.
+..remarks:
 The examples below show some common use cases.
 ..example.text:Local alignment of two sequences using an @Class.Align@ object.
 ..example.code:
@@ -226,6 +257,7 @@ Score<int, Simple> scoringScheme(5, -3, -1, -5);
 
 int result = localAlignment(gapsH, gapsV, scoringScheme, -2, 2);
 ..see:Function.globalAlignment
+..see:Function.localAlignmentScore
 ..see:Class.LocalAlignmentEnumerator
 ..include:seqan/align.h
 ..wiki:Tutorial/PairwiseSequenceAlignment
@@ -238,9 +270,11 @@ int result = localAlignment(gapsH, gapsV, scoringScheme, -2, 2);
 // ----------------------------------------------------------------------------
 
 template <typename TSequence, typename TAlignSpec,
-          typename TScoreValue, typename TScoreSpec>
+          typename TScoreValue, typename TScoreSpec,
+          typename TAlgoTag>
 TScoreValue localAlignment(Align<TSequence, TAlignSpec> & align,
-                           Score<TScoreValue, TScoreSpec> const & scoringScheme)
+                           Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                           TAlgoTag const & algoTag)
 {
     SEQAN_ASSERT_EQ(length(rows(align)), 2u);
     typedef Align<TSequence, TAlignSpec> TAlign;
@@ -250,33 +284,56 @@ TScoreValue localAlignment(Align<TSequence, TAlignSpec> & align,
 
     String<TTraceSegment> traceSegments;
     TScoreValue score = _setUpAndRunAlignment(traceSegments, source(row(align, 0)), source(row(align, 1)),
-                                              scoringScheme, SmithWaterman());
+                                              scoringScheme, algoTag);
     _adaptTraceSegmentsTo(row(align, 0), row(align, 1), traceSegments);
     return score;
 }
 
+// Interface without algorithm tag.
+
+template <typename TSequence, typename TAlignSpec,
+          typename TScoreValue, typename TScoreSpec>
+TScoreValue localAlignment(Align<TSequence, TAlignSpec> & align,
+                           Score<TScoreValue, TScoreSpec> const & scoringScheme)
+{
+    return localAlignment(align, scoringScheme, SmithWaterman());
+}
+
 // ----------------------------------------------------------------------------
 // Function localAlignment()                                   [unbanded, Gaps]
 // ----------------------------------------------------------------------------
 
 template <typename TSequenceH, typename TGapsSpecH,
           typename TSequenceV, typename TGapsSpecV,
-          typename TScoreValue, typename TScoreSpec>
+          typename TScoreValue, typename TScoreSpec,
+          typename TAlgoTag>
 TScoreValue localAlignment(Gaps<TSequenceH, TGapsSpecH> & gapsH,
                            Gaps<TSequenceV, TGapsSpecV> & gapsV,
-                           Score<TScoreValue, TScoreSpec> const & scoringScheme)
+                           Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                           TAlgoTag const & algoTag)
 {
     typedef typename Size<TSequenceH>::Type TSize;
     typedef typename Position<TSequenceH>::Type TPosition;
     typedef TraceSegment_<TPosition, TSize> TTraceSegment;
 
     String<TTraceSegment> traceSegments;
-    TScoreValue score = _setUpAndRunAlignment(traceSegments, source(gapsH), source(gapsV), scoringScheme,
-                                              SmithWaterman());
+    TScoreValue score = _setUpAndRunAlignment(traceSegments, source(gapsH), source(gapsV), scoringScheme, algoTag);
     _adaptTraceSegmentsTo(gapsH, gapsV, traceSegments);
     return score;
 }
 
+// Interface without algorithm tag.
+
+template <typename TSequenceH, typename TGapsSpecH,
+          typename TSequenceV, typename TGapsSpecV,
+          typename TScoreValue, typename TScoreSpec>
+TScoreValue localAlignment(Gaps<TSequenceH, TGapsSpecH> & gapsH,
+                           Gaps<TSequenceV, TGapsSpecV> & gapsV,
+                           Score<TScoreValue, TScoreSpec> const & scoringScheme)
+{
+    return localAlignment(gapsH, gapsV, scoringScheme, SmithWaterman());
+}
+
 // ----------------------------------------------------------------------------
 // Function localAlignment()                     [unbanded, Graph<Alignment<>>]
 // ----------------------------------------------------------------------------
@@ -325,6 +382,124 @@ TScoreValue localAlignment(String<Fragment<TSize, TFragmentSpec>, TStringSpec> &
     return score;
 }
 
+// ----------------------------------------------------------------------------
+// Function localAlignment()                                  [unbanded, batch]
+// ----------------------------------------------------------------------------
+
+template <typename TSequence, typename TAlignSpec, typename TSetSpec,
+          typename TScoreValue, typename TScoreSpec>
+String<TScoreValue> localAlignment(StringSet<Align<TSequence, TAlignSpec>, TSetSpec> & alignSet,
+                                   Score<TScoreValue, TScoreSpec> const & scoringScheme)
+{
+    StringSet<TSequence, Dependent<> > seqSetH;
+    StringSet<TSequence, Dependent<> > seqSetV;
+    _dpBatchCollectSources(seqSetH, seqSetV, alignSet);
+
+    String<TScoreValue> scores;
+    _alignBatch(scores, alignSet, seqSetH, seqSetV, scoringScheme, SmithWaterman());
+    return scores;
+}
+
+// ----------------------------------------------------------------------------
+// Function localAlignmentScore()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn localAlignmentScore
+ * @headerfile <seqan/align.h>
+ * @brief Computes the best local alignment score of a pair or of a batch of sequence pairs.
+ * 
+ * @signature TScoreVal localAlignmentScore(seqH, seqV, scoringScheme[, algorithmTag]);
+ * @signature String<TScoreVal> localAlignmentScore(seqSetH, seqSetV, scoringScheme);
+ * 
+ * @param seqH          Horizontal sequence in the alignment matrix.
+ * @param seqV          Vertical sequence in the alignment matrix.
+ * @param seqSetH       A @link StringSet @endlink with the horizontal sequences.
+ * @param seqSetV       A @link StringSet @endlink with the vertical sequences, of the same length as <tt>seqSetH</tt>.
+ * @param scoringScheme The scoring scheme to use for the alignment.  Types: Score
+ * @param algorithmTag  The Tag for picking the alignment algorithm, either <tt>SmithWaterman</tt> (default) or
+ *                      <tt>SmithWatermanStriped</tt>. Types: PairwiseLocalAlignmentAlgorithms
+ * 
+ * @return TScoreVal         The Smith-Waterman score of <tt>seqH</tt> and <tt>seqV</tt>.
+ * @return String<TScoreVal> The Smith-Waterman score of <tt>seqSetH[i]</tt> and <tt>seqSetV[i]</tt> at position
+ *                           <tt>i</tt>.
+ * 
+ * This function does not perform the traceback step.  With a @link SimpleScore @endlink with integral scores and
+ * non-positive gap and mismatch scores, pairs of similar lengths are aligned simultaneously in the lanes of SSE or AVX2
+ * registers, the other pairs are aligned one by one.
+ * 
+ * With <tt>SmithWatermanStriped</tt> a single pair is aligned with a striped SIMD query profile of <tt>seqV</tt>.
+ * 
+ * @see localAlignment
+ * @see globalAlignmentScore
+ */
+
+/**
+.Function.localAlignmentScore
+..summary:Computes the best local alignment score of a pair or of a batch of sequence pairs.
+..cat:Alignments
+..signature:localAlignmentScore(seqH, seqV, scoringScheme[, algorithmTag])
+..signature:localAlignmentScore(seqSetH, seqSetV, scoringScheme)
+..param.seqH:Horizontal sequence in the alignment matrix.
+..param.seqV:Vertical sequence in the alignment matrix.
+..param.seqSetH:The horizontal sequences.
+...type:Class.StringSet
+..param.seqSetV:The vertical sequences, must have the same length as $seqSetH$.
+...type:Class.StringSet
+..param.scoringScheme:The scoring scheme to use for the alignment.
+...type:Class.Score
+..param.algorithmTag:Tag for picking the alignment algorithm, $SmithWaterman$ (default) or $SmithWatermanStriped$.
+...type:Tag.Pairwise Local Alignment Algorithms
+..returns:The Smith-Waterman score of $seqH$ and $seqV$, or a @Class.String@ with the Smith-Waterman score of $seqSetH[i]$ and $seqSetV[i]$ at position $i$.
+..remarks:This function does not perform the traceback step.
+With a @Spec.Simple Score@ with integral scores and non-positive gap and mismatch scores, pairs of similar lengths are aligned simultaneously in the lanes of SSE or AVX2 registers, the other pairs are aligned one by one.
+With $SmithWatermanStriped$ a single pair is aligned with a striped SIMD query profile of $seqV$.
+..see:Function.localAlignment
+..see:Function.globalAlignmentScore
+..include:seqan/align.h
+*/
+
+template <typename TSequenceH,
+          typename TSequenceV,
+          typename TScoreValue, typename TScoreSpec,
+          typename TAlgoTag>
+TScoreValue localAlignmentScore(TSequenceH const & seqH,
+                                TSequenceV const & seqV,
+                                Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                                TAlgoTag const & algoTag)
+{
+    DPScoutState_<Default> noState;
+    return _setUpAndRunAlignment(noState, seqH, seqV, scoringScheme, algoTag,
+                                 TracebackConfig_<SingleTrace, GapsLeft>());
+}
+
+template <typename TSequenceH,
+          typename TSequenceV,
+          typename TScoreValue, typename TScoreSpec>
+TScoreValue localAlignmentScore(TSequenceH const & seqH,
+                                TSequenceV const & seqV,
+                                Score<TScoreValue, TScoreSpec> const & scoringScheme)
+{
+    return localAlignmentScore(seqH, seqV, scoringScheme, SmithWaterman());
+}
+
+// Batch interface.
+
+template <typename TSequenceH, typename TSpecH,
+          typename TSequenceV, typename TSpecV,
+          typename TScoreValue, typename TScoreSpec>
+String<TScoreValue> localAlignmentScore(StringSet<TSequenceH, TSpecH> const & seqSetH,
+                                        StringSet<TSequenceV, TSpecV> const & seqSetV,
+                                        Score<TScoreValue, TScoreSpec> const & scoringScheme)
+{
+    SEQAN_ASSERT_EQ(length(seqSetH), length(seqSetV));
+
+    Nothing noTrace;
+    String<TScoreValue> scores;
+    _alignBatch(scores, noTrace, seqSetH, seqSetV, scoringScheme, SmithWaterman());
+    return scores;
+}
+
 }  // namespace seqan
 
 #endif  // #ifndef SEQAN_CORE_INCLUDE_SEQAN_ALIGN_LOCAL_ALIGNMENT_UNBANDED_H_
@@ -105,5 +105,10 @@
 #include <seqan/bam_io/sam_writer.h>
 
 #include <seqan/bam_io/bam_stream.h>
+#if SEQAN_HAS_ZLIB
+#include <seqan/bam_io/bam_record_view.h>
+#include <seqan/bam_io/read_bam_parallel.h>
+#include <seqan/bam_io/bam_sort.h>
+#endif  // #if SEQAN_HAS_ZLIB
 
 #endif  // CORE_INCLUDE_SEQAN_BAM_IO_H_
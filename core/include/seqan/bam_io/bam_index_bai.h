@@ -89,6 +89,39 @@ struct BaiBamIndexBinData_
     String<Pair<__uint64, __uint64> > chunkBegEnds;
 };
 
+// ----------------------------------------------------------------------------
+// Helper Class BaiBamIndexBuilder_
+// ----------------------------------------------------------------------------
+
+// State for building a BAI index while the records of a coordinate-sorted BAM file are read or written.  The
+// records are added one after another with the virtual offset of their end, see _baiBuilderAddRecord().
+
+struct BaiBamIndexBuilder_
+{
+    // Reference and bin of the chunk that is currently extended.
+    __int32 saveRefId;
+    __uint32 saveBin;
+    __uint64 saveOffset;
+    // Reference, bin, begin position and end offset of the previous record.
+    __int32 lastRefId;
+    __uint32 lastBin;
+    __int32 lastPos;
+    __uint64 lastOffset;
+    // Data of the meta bin of the current reference.
+    __uint64 metaBegin;
+    __uint64 numMapped;
+    __uint64 numUnmapped;
+    // Number of records without coordinate at the end of the file.
+    __uint64 numNoCoord;
+    // Set to false if the records are not sorted by coordinate.
+    bool ok;
+
+    BaiBamIndexBuilder_() :
+        saveRefId(-1), saveBin(maxValue<__uint32>()), saveOffset(0), lastRefId(-1), lastBin(maxValue<__uint32>()),
+        lastPos(0), lastOffset(0), metaBegin(0), numMapped(0), numUnmapped(0), numNoCoord(0), ok(true)
+    {}
+};
+
 // ----------------------------------------------------------------------------
 // Spec BAI BamIndex
 // ----------------------------------------------------------------------------
@@ -139,6 +172,8 @@ public:
 
     // 1<<14 is the size of the minimum bin.
     static const __int32 BAM_LIDX_SHIFT = 14;
+    // Id of the pseudo bin that stores the offsets and the numbers of mapped and unmapped reads of a reference.
+    static const __uint32 BAM_MAX_BIN = 37450;
 
     String<TBinIndex_> _binIndices;
     String<TLinearIndex_> _linearIndices;
@@ -543,27 +578,11 @@ read(BamIndex<Bai> & index, char * filename)
 }
 
 // ----------------------------------------------------------------------------
-// Function buildIndex()
+// Function _writeIndex()
 // ----------------------------------------------------------------------------
 
-/*DISABLED
-.Function.BamIndex#buildIndex
-..class:Class.BamIndex
-..cat:BAM I/O
-..signature:buildIndex(index, filename)
-..summary:Build index for BAM file with given filename.
-..remarks:This will create an index file named $filename + ".bai"$.
-..param.index:Target data structure.
-...type:Class.BamIndex
-..param.filename:Path to BAM file to load.
-...type:nolink:$char const *$
-..returns:$bool$ indicating success.
-..include:seqan/bam_io.h
- */
-
 inline int _writeIndex(BamIndex<Bai> const & index, char const * filename)
 {
-    std::cerr << "WRITE INDEX TO " << filename << std::endl;
     // Open output stream.
     std::ofstream out(filename, std::ios::binary | std::ios::out);
 
@@ -604,7 +623,7 @@ inline int _writeIndex(BamIndex<Bai> const & index, char const * filename)
         }
 
         // Write out linear index.
-        __int32 numIntervals = length(index._linearIndices);
+        __int32 numIntervals = length(linearIndex);
         out.write(reinterpret_cast<char *>(&numIntervals), 4);
         typedef Iterator<String<__uint64> const, Rooted>::Type TLinearIndexIter;
         for (TLinearIndexIter it = begin(linearIndex, Rooted()); !atEnd(it); goNext(it))
@@ -612,45 +631,238 @@ inline int _writeIndex(BamIndex<Bai> const & index, char const * filename)
     }
 
     // Write the number of unaligned reads if set.
-    std::cerr << "UNALIGNED\t" << index._unalignedCount << std::endl;
     if (index._unalignedCount != maxValue<__uint64>())
         out.write(reinterpret_cast<char const *>(&index._unalignedCount), 8);
 
     return !out.good();  // 1 on error, 0 on success.
 }
 
-inline void _baiAddAlignmentChunkToBin(BamIndex<Bai> & index,
-                                       __uint32 currBin,
-                                       __uint32 currOffset,
-                                       __uint64 prevOffset)
+// ----------------------------------------------------------------------------
+// Function save()
+// ----------------------------------------------------------------------------
+
+/**
+.Function.BamIndex#save
+..class:Class.BamIndex
+..cat:BAM I/O
+..signature:save(index, filename)
+..summary:Write a BAI index to a file.
+..param.index:The index to write.
+...type:Class.BamIndex
+..param.filename:Path to the BAI file to write.
+...type:nolink:$char const *$
+..returns:$int$, 0 on success, 1 on errors.
+..include:seqan/bam_io.h
+*/
+
+inline int
+save(BamIndex<Bai> const & index, char const * filename)
+{
+    return _writeIndex(index, filename);
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _baiAddChunk()
+// ----------------------------------------------------------------------------
+
+// Append the chunk [beginOffset, endOffset) to the bin of the given reference.
+
+inline void _baiAddChunk(BamIndex<Bai> & index,
+                         __int32 refId,
+                         __uint32 bin,
+                         __uint64 beginOffset,
+                         __uint64 endOffset)
+{
+    appendValue(index._binIndices[refId][bin].chunkBegEnds, Pair<__uint64>(beginOffset, endOffset));
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _baiBuilderInit()
+// ----------------------------------------------------------------------------
+
+// Reset index and builder for a BAM file with numRefSeqs reference sequences whose first record starts at the
+// virtual offset firstOffset.
+
+inline void _baiBuilderInit(BamIndex<Bai> & index,
+                            BaiBamIndexBuilder_ & builder,
+                            unsigned numRefSeqs,
+                            __uint64 firstOffset)
+{
+    clear(index._binIndices);
+    clear(index._linearIndices);
+    resize(index._binIndices, numRefSeqs);
+    resize(index._linearIndices, numRefSeqs);
+    index._unalignedCount = 0;
+
+    builder = BaiBamIndexBuilder_();
+    builder.saveOffset = firstOffset;
+    builder.lastOffset = firstOffset;
+    builder.metaBegin = firstOffset;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _baiBuilderAddRecord()
+// ----------------------------------------------------------------------------
+
+// Add the next record of the BAM file to the index.  The record starts at the end offset of the previous record and
+// covers [beginPos, endPos) of reference refId.  bin is the bin stored in the record and endOffset the virtual offset
+// behind the record.  Returns false if the records are not sorted by coordinate.
+//
+// This follows bam_index_core() of the samtools.
+
+inline bool _baiBuilderAddRecord(BamIndex<Bai> & index,
+                                 BaiBamIndexBuilder_ & builder,
+                                 __int32 refId,
+                                 __int32 beginPos,
+                                 __int32 endPos,
+                                 __uint32 bin,
+                                 __uint16 flag,
+                                 __uint64 endOffset)
 {
-    // If this is not the first reference sequence then add previous reference data.
-    Pair<__uint64> newChunk(currOffset, prevOffset);
+    if (!builder.ok)
+        return false;
 
-    // If no interest exists yet for this bin, create one and store alignment chunk.
-    BamIndex<Bai>::TBinIndex_::iterator binIter = back(index._binIndices).find(currBin);
-    if (binIter == back(index._binIndices).end())
+    // Records without coordinate form the end of the file.
+    if (builder.lastRefId < 0 && builder.saveBin != maxValue<__uint32>() && refId >= 0)
+        return builder.ok = false;
+    if (refId < 0)
+        ++builder.numNoCoord;
+
+    // Check the order and reset the bin on a change of the reference.
+    if (builder.saveBin == maxValue<__uint32>() || builder.lastRefId < refId || (builder.lastRefId >= 0 && refId < 0))
+    {
+        builder.lastRefId = refId;
+        builder.lastBin = maxValue<__uint32>();
+    }
+    else if (static_cast<__uint32>(builder.lastRefId) > static_cast<__uint32>(refId) ||
+             (refId >= 0 && builder.lastPos > beginPos))
+    {
+        return builder.ok = false;
+    }
+
+    if (refId >= static_cast<__int32>(length(index._binIndices)))
+        return builder.ok = false;
+
+    // Update the linear index.
+    if (refId >= 0 && !(flag & BAM_FLAG_UNMAPPED))
+    {
+        BamIndex<Bai>::TLinearIndex_ & linearIndex = index._linearIndices[refId];
+        unsigned beginWindow = beginPos >> BamIndex<Bai>::BAM_LIDX_SHIFT;
+        unsigned endWindow = (_max(endPos, beginPos + 1) - 1) >> BamIndex<Bai>::BAM_LIDX_SHIFT;
+        if (length(linearIndex) < endWindow + 1)
+            resize(linearIndex, endWindow + 1, 0);
+        for (unsigned i = beginWindow; i <= endWindow; ++i)
+            if (linearIndex[i] == 0u)
+                linearIndex[i] = builder.lastOffset;
+    }
+
+    // Close the chunk of the previous bin and the meta data of the previous reference.
+    if (bin != builder.lastBin)
     {
-        BaiBamIndexBinData_ binData;
-        appendValue(binData.chunkBegEnds, newChunk);
-        back(index._binIndices).insert(std::make_pair(currBin, binData));
+        if (builder.saveBin != maxValue<__uint32>() && builder.saveRefId >= 0)
+        {
+            _baiAddChunk(index, builder.saveRefId, builder.saveBin, builder.saveOffset, builder.lastOffset);
+            if (builder.lastBin == maxValue<__uint32>())
+            {
+                _baiAddChunk(index, builder.saveRefId, BamIndex<Bai>::BAM_MAX_BIN, builder.metaBegin,
+                             builder.lastOffset);
+                _baiAddChunk(index, builder.saveRefId, BamIndex<Bai>::BAM_MAX_BIN, builder.numMapped,
+                             builder.numUnmapped);
+                builder.numMapped = builder.numUnmapped = 0;
+                builder.metaBegin = builder.lastOffset;
+            }
+        }
+        builder.saveOffset = builder.lastOffset;
+        builder.saveBin = builder.lastBin = bin;
+        builder.saveRefId = refId;
     }
+
+    if (endOffset <= builder.lastOffset)
+        return builder.ok = false;  // Offsets must increase.
+
+    if (flag & BAM_FLAG_UNMAPPED)
+        ++builder.numUnmapped;
     else
+        ++builder.numMapped;
+    builder.lastOffset = endOffset;
+    builder.lastPos = beginPos;
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _baiBuilderFinish()
+// ----------------------------------------------------------------------------
+
+// Close the last chunk, merge adjacent chunks and fill the gaps of the linear indices.  As in samtools, the last chunk
+// ends at fileEndOffset, the virtual offset behind the EOF block.  Returns false if an error occured while adding the
+// records.
+
+inline bool _baiBuilderFinish(BamIndex<Bai> & index, BaiBamIndexBuilder_ & builder, __uint64 fileEndOffset)
+{
+    if (!builder.ok)
+        return false;
+
+    if (builder.saveBin != maxValue<__uint32>() && builder.saveRefId >= 0)
     {
-        // Otherwise, just append alignment chunk.
-        appendValue(binIter->second.chunkBegEnds, newChunk);
+        _baiAddChunk(index, builder.saveRefId, builder.saveBin, builder.saveOffset, fileEndOffset);
+        _baiAddChunk(index, builder.saveRefId, BamIndex<Bai>::BAM_MAX_BIN, builder.metaBegin, fileEndOffset);
+        _baiAddChunk(index, builder.saveRefId, BamIndex<Bai>::BAM_MAX_BIN, builder.numMapped, builder.numUnmapped);
+    }
+
+    typedef BamIndex<Bai>::TBinIndex_::iterator TBinIter;
+    for (unsigned i = 0; i < length(index._binIndices); ++i)
+    {
+        // Merge chunks that end in the block in which the next chunk starts.
+        for (TBinIter it = index._binIndices[i].begin(); it != index._binIndices[i].end(); ++it)
+        {
+            if (it->first == BamIndex<Bai>::BAM_MAX_BIN)
+                continue;
+            String<Pair<__uint64> > & chunks = it->second.chunkBegEnds;
+            unsigned last = 0;
+            for (unsigned j = 1; j < length(chunks); ++j)
+            {
+                if ((chunks[last].i2 >> 16) == (chunks[j].i1 >> 16))
+                    chunks[last].i2 = chunks[j].i2;
+                else
+                    chunks[++last] = chunks[j];
+            }
+            resize(chunks, last + 1);
+        }
+
+        // Windows without a record start at the offset of the previous window.
+        BamIndex<Bai>::TLinearIndex_ & linearIndex = index._linearIndices[i];
+        for (unsigned j = 1; j < length(linearIndex); ++j)
+            if (linearIndex[j] == 0u)
+                linearIndex[j] = linearIndex[j - 1];
     }
+
+    index._unalignedCount = builder.numNoCoord;
+    return true;
 }
 
+// ----------------------------------------------------------------------------
+// Function buildIndex()
+// ----------------------------------------------------------------------------
+
+/**
+.Function.BamIndex#buildIndex
+..class:Class.BamIndex
+..cat:BAM I/O
+..signature:buildIndex(index, filename)
+..summary:Build index for BAM file with given filename.
+..remarks:This will create an index file named $filename + ".bai"$.
+The BAM file must be sorted by coordinate.
+..param.index:Target data structure.
+...type:Class.BamIndex
+..param.filename:Path to BAM file to load.
+...type:nolink:$char const *$
+..returns:$bool$ indicating success.
+..include:seqan/bam_io.h
+ */
+
 inline bool
 buildIndex(BamIndex<Bai> & index, char const * filename)
 {
-    SEQAN_FAIL("This does not work ye!");
-
-    index._unalignedCount = 0;
-    clear(index._binIndices);
-    clear(index._linearIndices);
-
     // Open BAM file for reading.
     Stream<Bgzf> bamStream;
     if (!open(bamStream, filename, "r"))
@@ -666,151 +878,31 @@ buildIndex(BamIndex<Bai> & index, char const * filename)
 
     // Read BAM header.
     BamHeader header;
-    int res = readRecord(header, bamIOContext, bamStream, Bam());
-    if (res != 0)
+    if (readRecord(header, bamIOContext, bamStream, Bam()) != 0)
         return false;  // Could not read BAM header.
-    __uint32 numRefSeqs = length(header.sequenceInfos);
-
-    // Scan over BAM file and create index.
-    BamAlignmentRecord record;
-    __uint32 currBin    = maxValue<__uint32>();
-    __uint32 prevBin    = maxValue<__uint32>();
-    __int32 currRefId   = BamAlignmentRecord::INVALID_REFID;
-    __int32 prevRefId   = BamAlignmentRecord::INVALID_REFID;
-    __uint64 currOffset = streamTell(bamStream);
-    __uint64 prevOffset = currOffset;
-    __int32 prevPos     = minValue<__int32>();
-
-    while (!atEnd(bamStream))
-    {
-        // Load next record.
-        res = readRecord(record, bamIOContext, bamStream, Bam());
-        if (res != 0)
-            return false;
-
-        // Check ordering.
-        if (prevRefId == record.rID && prevPos > record.beginPos)
-            return false;
-
-        // The reference sequence changed, close bins for previous reference.
-        if (prevRefId != record.rID)
-        {
-            if (prevRefId != BamAlignmentRecord::INVALID_REFID)
-            {
-                _baiAddAlignmentChunkToBin(index, currBin, currOffset, prevOffset);
 
-                // Add an index for all empty references between prevRefId (excluded) and record.rID (included).
-                for (int i = prevRefId + 1; i < record.rID; ++i)
-                {
-                    BamIndex<Bai>::TBinIndex_ binIndex;
-                    appendValue(index._binIndices, binIndex);
-                    BamIndex<Bai>::TLinearIndex_ linearIndex;
-                    appendValue(index._linearIndices, linearIndex);
-                }
-
-                // Update bin book keeping.
-                currOffset = prevOffset;
-                currBin    = record.bin;
-                prevBin    = record.bin;
-                currRefId  = record.rID;
-            }
-            else
-            {
-                // Otherwise, this is the first pass.  Create an index for all empty references up to and including
-                // current refId.
-                for (int i = 0; i < record.rID; ++i)
-                {
-                    BamIndex<Bai>::TBinIndex_ binIndex;
-                    appendValue(index._binIndices, binIndex);
-                    BamIndex<Bai>::TLinearIndex_ linearIndex;
-                    appendValue(index._linearIndices, linearIndex);
-                }
-            }
+    // Scan over BAM file and add each record to the index.
+    BaiBamIndexBuilder_ builder;
+    _baiBuilderInit(index, builder, _max(length(header.sequenceInfos), length(refNameStore)), streamTell(bamStream));
 
-            // Update reference book keeping.
-            prevRefId = record.rID;
-            prevBin = minValue<__int32>();
-        }
-
-        // If the alignment's reference id is valid and its bin is not a leaf.
-        if (record.rID >= 0 && record.bin < 4681)
-        {
-            __int32 beginOffset = record.beginPos >> BamIndex<Bai>::BAM_LIDX_SHIFT;
-            __int32 endPos      = getAlignmentLengthInRef(record);
-            __int32 endOffset   = (endPos - 1) >> BamIndex<Bai>::BAM_LIDX_SHIFT;
-
-            // Resize linear index if necessary.
-            unsigned oldSize = length(index._linearIndices);
-            unsigned newSize = endOffset + 1;
-            if (oldSize < newSize)
-                resize(back(index._linearIndices), newSize, 0);
-
-            // Store offset.
-            for (int i = beginOffset + 1; i <= endOffset; ++i)
-                if (back(index._linearIndices)[i] == 0u)
-                    back(index._linearIndices)[i] = prevOffset;
-        }
-
-        // Handle the case if we changed to a new BAI bin.
-        if (record.bin != prevBin)
-        {
-            // If not first bin of reference, save previous bin data.
-            if (currBin != maxValue<__uint32>())
-                _baiAddAlignmentChunkToBin(index, currBin, currOffset, prevOffset);
-
-            // Update markers.
-            currOffset = prevOffset;
-            currBin    = record.bin;
-            prevBin    = record.bin;
-            currRefId  = record.rID;
-
-            // If the reference id is invalid then break out.
-            if (currRefId < 0)
-                break;
-        }
-
-        // Make sure that the current file pointer is beyond prevOffset.
-        if (streamTell(bamStream) <= static_cast<__int64>(prevOffset))
-            return false;  // Calculating offsets failed.
-
-        // Update prevOffset and prevPos.
-        prevOffset = streamTell(bamStream);
-        prevPos    = record.beginPos;
-    }
-
-    // Count remaining unaligned records.
+    BamAlignmentRecord record;
     while (!streamEof(bamStream))
     {
-        SEQAN_ASSERT_GT(index._unalignedCount, 0u);
-
-        res = readRecord(record, bamIOContext, bamStream, Bam());
-        if (res != 0 || record.rID >= 0)
-            return false;  // Could not read record.
-
-        index._unalignedCount += 1;
-    }
-
-    // After loading all alignments, if any data was read, perform checks.
-    if (currRefId >= 0)
-    {
-        // Store last alignment chunk to its bin and then write last reference entry with data.
-        _baiAddAlignmentChunkToBin(index, currBin, currOffset, prevOffset);
-
-        // Finally, write any empty references remaining at end of file.
-        SEQAN_ASSERT_GEQ(numRefSeqs, length(index._binIndices));
-        BamIndex<Bai>::TBinIndex_ binIndex;
-        resize(index._binIndices, numRefSeqs, binIndex);  // TODO(holtgrew): binIndex is unnecessary if resize used T() as default value as vector.resize() does.
+        if (readRecord(record, bamIOContext, bamStream, Bam()) != 0)
+            return false;
+        __int32 endPos = record.beginPos + getAlignmentLengthInRef(record);
+        if (!_baiBuilderAddRecord(index, builder, record.rID, record.beginPos, endPos, record.bin, record.flag,
+                                  streamTell(bamStream)))
+            return false;  // Not sorted by coordinate.
     }
 
-    // Merge small bins if possible.
-    SEQAN_FAIL("TODO: Merge bins!");
+    if (!_baiBuilderFinish(index, builder, (__uint64)size(bamStream._file) << 16))
+        return false;
 
     // Write out index.
     CharString baiFilename(filename);
     append(baiFilename, ".bai");
-    res = _writeIndex(index, toCString(baiFilename));
-
-    return (res == 0);
+    return _writeIndex(index, toCString(baiFilename)) == 0;
 }
 
 }  // namespace seqan
@@ -0,0 +1,839 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Author: agent <agent@local>
+// ==========================================================================
+// Lazy access to BAM records.  A BamRecordView points to the binary record
+// in the decompressed BGZF block and decodes the fields on demand, readBatch()
+// returns views for all records of the current block.
+// ==========================================================================
+
+#ifndef CORE_INCLUDE_SEQAN_BAM_IO_BAM_RECORD_VIEW_H_
+#define CORE_INCLUDE_SEQAN_BAM_IO_BAM_RECORD_VIEW_H_
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Class BamRecordView
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class BamRecordView
+ * @headerfile <seqan/bam_io.h>
+ * @brief Read-only view of a binary BAM record that decodes its fields on demand.
+ *
+ * @signature class BamRecordView;
+ *
+ * A view is obtained from @link BamRecordBatch @endlink by @link BamRecordBatch#readBatch @endlink and points to the
+ * record's bytes behind the <tt>block_size</tt> field.  The fixed-size fields are read directly from these bytes,
+ * query name, CIGAR, sequence, qualities and tags are only decoded when requested.  Use
+ * @link BamRecordView#decodeRecord @endlink to obtain a complete @link BamAlignmentRecord @endlink.
+ *
+ * Views are invalidated by the next call to <tt>readBatch</tt> and by any other read or seek on the stream.
+ */
+
+/**
+.Class.BamRecordView
+..cat:BAM I/O
+..summary:Read-only view of a binary BAM record that decodes its fields on demand.
+..signature:BamRecordView
+..remarks:A view is obtained from a @Class.BamRecordBatch@ by @Function.readBatch@ and points to the record's bytes
+behind the $block_size$ field.  The fixed-size fields are read directly from these bytes, query name, CIGAR,
+sequence, qualities and tags are only decoded when requested.
+..remarks:Views are invalidated by the next call to @Function.readBatch@ and by any other read or seek on the stream.
+..include:seqan/bam_io.h
+*/
+
+class BamRecordView
+{
+public:
+    char const * _data;     // record bytes behind block_size
+    __int32 _length;        // value of block_size
+
+    BamRecordView() : _data(0), _length(0)
+    {}
+
+    BamRecordView(char const * data, __int32 length) : _data(data), _length(length)
+    {}
+};
+
+// ----------------------------------------------------------------------------
+// Class BamRecordBatch
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class BamRecordBatch
+ * @headerfile <seqan/bam_io.h>
+ * @brief Views of the BAM records of one decompressed BGZF block.
+ *
+ * @signature class BamRecordBatch;
+ *
+ * The member <tt>views</tt> is a <tt>String&lt;BamRecordView&gt;</tt> that is filled by
+ * @link BamRecordBatch#readBatch @endlink.
+ */
+
+/**
+.Class.BamRecordBatch
+..cat:BAM I/O
+..summary:Views of the BAM records of one decompressed BGZF block.
+..signature:BamRecordBatch
+..include:seqan/bam_io.h
+
+.Memvar.BamRecordBatch#views
+..class:Class.BamRecordBatch
+..summary:The views of the records read by the last call of @Function.readBatch@.
+..type:nolink:$String<BamRecordView>$
+*/
+
+class BamRecordBatch
+{
+public:
+    String<BamRecordView> views;
+
+    // Buffer for a record that spans more than one BGZF block.
+    CharString _spill;
+};
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Helper Function _bamViewField()
+// ----------------------------------------------------------------------------
+
+// Records are not aligned in the block, so fields are copied out instead of being dereferenced.
+
+template <typename TValue>
+inline TValue
+_bamViewField(BamRecordView const & view, unsigned offset)
+{
+    SEQAN_ASSERT_LEQ(offset + sizeof(TValue), static_cast<unsigned>(view._length));
+    TValue x;
+    memcpy(&x, view._data + offset, sizeof(TValue));
+    return x;
+}
+
+// Offsets of the variable-length fields.
+
+inline unsigned
+_bamViewCigarOffset(BamRecordView const & view)
+{
+    return 32 + (_bamViewField<__uint32>(view, 8) & 0xff);
+}
+
+inline unsigned
+_bamViewSeqOffset(BamRecordView const & view)
+{
+    return _bamViewCigarOffset(view) + 4 * (_bamViewField<__uint32>(view, 12) & 0xffff);
+}
+
+inline unsigned
+_bamViewQualOffset(BamRecordView const & view)
+{
+    return _bamViewSeqOffset(view) + (_bamViewField<__int32>(view, 16) + 1) / 2;
+}
+
+inline unsigned
+_bamViewTagsOffset(BamRecordView const & view)
+{
+    return _bamViewQualOffset(view) + _bamViewField<__int32>(view, 16);
+}
+
+// ----------------------------------------------------------------------------
+// Fixed-size fields
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BamRecordView#getRID
+ * @brief Return the reference id of the record as stored in the file.
+ * @signature __int32 getRID(view);
+ *
+ * @fn BamRecordView#getBeginPos
+ * @brief Return the 0-based begin position of the record.
+ * @signature __int32 getBeginPos(view);
+ *
+ * @fn BamRecordView#getFlag
+ * @brief Return the flag of the record.
+ * @signature __uint16 getFlag(view);
+ *
+ * @fn BamRecordView#getMapQ
+ * @brief Return the mapping quality of the record.
+ * @signature __uint8 getMapQ(view);
+ *
+ * @fn BamRecordView#getBin
+ * @brief Return the BAI bin of the record.
+ * @signature __uint16 getBin(view);
+ *
+ * @fn BamRecordView#getRNextId
+ * @brief Return the reference id of the next fragment as stored in the file.
+ * @signature __int32 getRNextId(view);
+ *
+ * @fn BamRecordView#getPNext
+ * @brief Return the 0-based position of the next fragment.
+ * @signature __int32 getPNext(view);
+ *
+ * @fn BamRecordView#getTLen
+ * @brief Return the template length of the record.
+ * @signature __int32 getTLen(view);
+ *
+ * @fn BamRecordView#getSeqLength
+ * @brief Return the length of the read sequence.
+ * @signature __int32 getSeqLength(view);
+ */
+
+/**
+.Function.getRID
+..class:Class.BamRecordView
+..cat:BAM I/O
+..summary:Return the reference id of a @Class.BamRecordView@ as stored in the file.
+..signature:getRID(view)
+..param.view:The view to query.
+...type:Class.BamRecordView
+..returns:$__int32$, the reference id, not translated by the @Class.BamIOContext@.
+..include:seqan/bam_io.h
+..see:Function.decodeRecord
+
+.Function.getBeginPos
+..class:Class.BamRecordView
+..cat:BAM I/O
+..summary:Return the 0-based begin position of a @Class.BamRecordView@.
+..signature:getBeginPos(view)
+..param.view:The view to query.
+...type:Class.BamRecordView
+..returns:$__int32$, the begin position.
+..include:seqan/bam_io.h
+
+.Function.getFlag
+..class:Class.BamRecordView
+..cat:BAM I/O
+..summary:Return the flag of a @Class.BamRecordView@.
+..signature:getFlag(view)
+..param.view:The view to query.
+...type:Class.BamRecordView
+..returns:$__uint16$, the flag.
+..include:seqan/bam_io.h
+
+.Function.getMapQ
+..class:Class.BamRecordView
+..cat:BAM I/O
+..summary:Return the mapping quality of a @Class.BamRecordView@.
+..signature:getMapQ(view)
+..param.view:The view to query.
+...type:Class.BamRecordView
+..returns:$__uint8$, the mapping quality.
+..include:seqan/bam_io.h
+
+.Function.getBin
+..class:Class.BamRecordView
+..cat:BAM I/O
+..summary:Return the BAI bin of a @Class.BamRecordView@.
+..signature:getBin(view)
+..param.view:The view to query.
+...type:Class.BamRecordView
+..returns:$__uint16$, the bin.
+..include:seqan/bam_io.h
+
+.Function.getRNextId
+..class:Class.BamRecordView
+..cat:BAM I/O
+..summary:Return the reference id of the next fragment of a @Class.BamRecordView@ as stored in the file.
+..signature:getRNextId(view)
+..param.view:The view to query.
+...type:Class.BamRecordView
+..returns:$__int32$, the reference id of the next fragment.
+..include:seqan/bam_io.h
+
+.Function.getPNext
+..class:Class.BamRecordView
+..cat:BAM I/O
+..summary:Return the 0-based position of the next fragment of a @Class.BamRecordView@.
+..signature:getPNext(view)
+..param.view:The view to query.
+...type:Class.BamRecordView
+..returns:$__int32$, the position of the next fragment.
+..include:seqan/bam_io.h
+
+.Function.getTLen
+..class:Class.BamRecordView
+..cat:BAM I/O
+..summary:Return the template length of a @Class.BamRecordView@.
+..signature:getTLen(view)
+..param.view:The view to query.
+...type:Class.BamRecordView
+..returns:$__int32$, the template length.
+..include:seqan/bam_io.h
+
+.Function.getSeqLength
+..class:Class.BamRecordView
+..cat:BAM I/O
+..summary:Return the length of the read sequence of a @Class.BamRecordView@.
+..signature:getSeqLength(view)
+..param.view:The view to query.
+...type:Class.BamRecordView
+..returns:$__int32$, the sequence length.
+..include:seqan/bam_io.h
+*/
+
+inline __int32
+getRID(BamRecordView const & view)
+{
+    return _bamViewField<__int32>(view, 0);
+}
+
+inline __int32
+getBeginPos(BamRecordView const & view)
+{
+    return _bamViewField<__int32>(view, 4);
+}
+
+inline __uint16
+getBin(BamRecordView const & view)
+{
+    return _bamViewField<__uint32>(view, 8) >> 16;
+}
+
+inline __uint8
+getMapQ(BamRecordView const & view)
+{
+    return (_bamViewField<__uint32>(view, 8) >> 8) & 0xff;
+}
+
+inline __uint16
+getFlag(BamRecordView const & view)
+{
+    return _bamViewField<__uint32>(view, 12) >> 16;
+}
+
+inline __int32
+getSeqLength(BamRecordView const & view)
+{
+    return _bamViewField<__int32>(view, 16);
+}
+
+inline __int32
+getRNextId(BamRecordView const & view)
+{
+    return _bamViewField<__int32>(view, 20);
+}
+
+inline __int32
+getPNext(BamRecordView const & view)
+{
+    return _bamViewField<__int32>(view, 24);
+}
+
+inline __int32
+getTLen(BamRecordView const & view)
+{
+    return _bamViewField<__int32>(view, 28);
+}
+
+// ----------------------------------------------------------------------------
+// Function hasFlag*()
+// ----------------------------------------------------------------------------
+
+///.Function.hasFlagMultiple.param.record.type:Class.BamRecordView
+///.Function.hasFlagAllProper.param.record.type:Class.BamRecordView
+///.Function.hasFlagUnmapped.param.record.type:Class.BamRecordView
+///.Function.hasFlagNextUnmapped.param.record.type:Class.BamRecordView
+///.Function.hasFlagRC.param.record.type:Class.BamRecordView
+///.Function.hasFlagNextRC.param.record.type:Class.BamRecordView
+///.Function.hasFlagFirst.param.record.type:Class.BamRecordView
+///.Function.hasFlagLast.param.record.type:Class.BamRecordView
+///.Function.hasFlagSecondary.param.record.type:Class.BamRecordView
+///.Function.hasFlagQCNoPass.param.record.type:Class.BamRecordView
+///.Function.hasFlagDuplicate.param.record.type:Class.BamRecordView
+
+inline bool
+hasFlagMultiple(BamRecordView const & view)
+{
+    return (getFlag(view) & BAM_FLAG_MULTIPLE) == BAM_FLAG_MULTIPLE;
+}
+
+inline bool
+hasFlagAllProper(BamRecordView const & view)
+{
+    return (getFlag(view) & BAM_FLAG_ALL_PROPER) == BAM_FLAG_ALL_PROPER;
+}
+
+inline bool
+hasFlagUnmapped(BamRecordView const & view)
+{
+    return (getFlag(view) & BAM_FLAG_UNMAPPED) == BAM_FLAG_UNMAPPED;
+}
+
+inline bool
+hasFlagNextUnmapped(BamRecordView const & view)
+{
+    return (getFlag(view) & BAM_FLAG_NEXT_UNMAPPED) == BAM_FLAG_NEXT_UNMAPPED;
+}
+
+inline bool
+hasFlagRC(BamRecordView const & view)
+{
+    return (getFlag(view) & BAM_FLAG_RC) == BAM_FLAG_RC;
+}
+
+inline bool
+hasFlagNextRC(BamRecordView const & view)
+{
+    return (getFlag(view) & BAM_FLAG_NEXT_RC) == BAM_FLAG_NEXT_RC;
+}
+
+inline bool
+hasFlagFirst(BamRecordView const & view)
+{
+    return (getFlag(view) & BAM_FLAG_FIRST) == BAM_FLAG_FIRST;
+}
+
+inline bool
+hasFlagLast(BamRecordView const & view)
+{
+    return (getFlag(view) & BAM_FLAG_LAST) == BAM_FLAG_LAST;
+}
+
+inline bool
+hasFlagSecondary(BamRecordView const & view)
+{
+    return (getFlag(view) & BAM_FLAG_SECONDARY) == BAM_FLAG_SECONDARY;
+}
+
+inline bool
+hasFlagQCNoPass(BamRecordView const & view)
+{
+    return (getFlag(view) & BAM_FLAG_QC_NO_PASS) == BAM_FLAG_QC_NO_PASS;
+}
+
+inline bool
+hasFlagDuplicate(BamRecordView const & view)
+{
+    return (getFlag(view) & BAM_FLAG_DUPLICATE) == BAM_FLAG_DUPLICATE;
+}
+
+// ----------------------------------------------------------------------------
+// Function getAlignmentLengthInRef()
+// ----------------------------------------------------------------------------
+
+///.Function.getAlignmentLengthInRef.param.record.type:Class.BamRecordView
+
+// Sums up the binary CIGAR without decoding it, counting the same operations as _getLengthInRef().
+
+inline unsigned
+getAlignmentLengthInRef(BamRecordView const & view)
+{
+    unsigned nCigarOp = _bamViewField<__uint32>(view, 12) & 0xffff;
+    unsigned offset = _bamViewCigarOffset(view);
+    unsigned l = 0;
+    for (unsigned i = 0; i < nCigarOp; ++i, offset += 4)
+    {
+        __uint32 ui = _bamViewField<__uint32>(view, offset);
+        // All operations of "MIDNSHP=" but I, S and H.
+        if ((0xcdu >> (ui & 0x0007)) & 1u)
+            l += ui >> 4;
+    }
+    return l;
+}
+
+// ----------------------------------------------------------------------------
+// Function getQName()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BamRecordView#getQName
+ * @brief Decode the query name of a record.
+ * @signature void getQName(qName, view);
+ *
+ * @fn BamRecordView#getCigar
+ * @brief Decode the CIGAR of a record into a <tt>String&lt;CigarElement&lt;&gt; &gt;</tt>.
+ * @signature void getCigar(cigar, view);
+ *
+ * @fn BamRecordView#getSeq
+ * @brief Decode the read sequence of a record, empty for '*'.
+ * @signature void getSeq(seq, view);
+ *
+ * @fn BamRecordView#getQual
+ * @brief Decode the Phred qualities of a record as in SAM, empty for '*'.
+ * @signature void getQual(qual, view);
+ *
+ * @fn BamRecordView#getTags
+ * @brief Copy the raw BAM tags of a record, use @link BamTagsDict @endlink to access them.
+ * @signature void getTags(tags, view);
+ */
+
+/**
+.Function.getQName
+..class:Class.BamRecordView
+..cat:BAM I/O
+..summary:Decode the query name of a @Class.BamRecordView@.
+..signature:getQName(qName, view)
+..param.qName:The string to write the query name to.
+...type:Shortcut.CharString
+..param.view:The view to decode.
+...type:Class.BamRecordView
+..include:seqan/bam_io.h
+
+.Function.getCigar
+..class:Class.BamRecordView
+..cat:BAM I/O
+..summary:Decode the CIGAR of a @Class.BamRecordView@.
+..signature:getCigar(cigar, view)
+..param.cigar:The string to write the CIGAR to.
+...type:nolink:$String<CigarElement<> >$
+..param.view:The view to decode.
+...type:Class.BamRecordView
+..include:seqan/bam_io.h
+
+.Function.getSeq
+..class:Class.BamRecordView
+..cat:BAM I/O
+..summary:Decode the read sequence of a @Class.BamRecordView@, empty for '*'.
+..signature:getSeq(seq, view)
+..param.seq:The string to write the sequence to.
+...type:Shortcut.CharString
+..param.view:The view to decode.
+...type:Class.BamRecordView
+..include:seqan/bam_io.h
+
+.Function.getQual
+..class:Class.BamRecordView
+..cat:BAM I/O
+..summary:Decode the Phred qualities of a @Class.BamRecordView@ as in SAM, empty for '*'.
+..signature:getQual(qual, view)
+..param.qual:The string to write the qualities to.
+...type:Shortcut.CharString
+..param.view:The view to decode.
+...type:Class.BamRecordView
+..include:seqan/bam_io.h
+
+.Function.getTags
+..class:Class.BamRecordView
+..cat:BAM I/O
+..summary:Copy the raw BAM tags of a @Class.BamRecordView@.
+..signature:getTags(tags, view)
+..param.tags:The string to write the tags to, use @Class.BamTagsDict@ to access them.
+...type:Shortcut.CharString
+..param.view:The view to decode.
+...type:Class.BamRecordView
+..include:seqan/bam_io.h
+*/
+
+template <typename TTarget>
+inline void
+getQName(TTarget & qName, BamRecordView const & view)
+{
+    unsigned lReadName = _bamViewField<__uint32>(view, 8) & 0xff;
+    SEQAN_ASSERT_GT(lReadName, 0u);
+    resize(qName, lReadName - 1, Exact());
+    std::copy(view._data + 32, view._data + 32 + lReadName - 1, begin(qName, Standard()));
+}
+
+// ----------------------------------------------------------------------------
+// Function getCigar()
+// ----------------------------------------------------------------------------
+
+template <typename TCigarString>
+inline void
+getCigar(TCigarString & cigar, BamRecordView const & view)
+{
+    typedef typename Iterator<TCigarString, Standard>::Type TCigarIter;
+    static char const * CIGAR_MAPPING = "MIDNSHP=";
+
+    unsigned nCigarOp = _bamViewField<__uint32>(view, 12) & 0xffff;
+    unsigned offset = _bamViewCigarOffset(view);
+    resize(cigar, nCigarOp, Exact());
+    TCigarIter itEnd = end(cigar, Standard());
+    for (TCigarIter it = begin(cigar, Standard()); it != itEnd; ++it, offset += 4)
+    {
+        __uint32 ui = _bamViewField<__uint32>(view, offset);
+        it->operation = CIGAR_MAPPING[ui & 0x0007];
+        it->count = ui >> 4;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function getSeq()
+// ----------------------------------------------------------------------------
+
+template <typename TSequence>
+inline void
+getSeq(TSequence & seq, BamRecordView const & view)
+{
+    typedef typename Iterator<TSequence, Standard>::Type TSeqIter;
+    static char const * SEQ_MAPPING = "=ACMGRSVTWYHKDBN";
+
+    __int32 lSeq = getSeqLength(view);
+    SEQAN_ASSERT_LEQ(_bamViewQualOffset(view), static_cast<unsigned>(view._length));
+    __uint8 const * ptr = reinterpret_cast<__uint8 const *>(view._data + _bamViewSeqOffset(view));
+
+    resize(seq, lSeq, Exact());
+    TSeqIter it = begin(seq, Standard());
+    for (__int32 i = 1; i < lSeq; i += 2, ++ptr)
+    {
+        *it++ = SEQ_MAPPING[*ptr >> 4];
+        *it++ = SEQ_MAPPING[*ptr & 0x0f];
+    }
+    if (lSeq & 1)
+        *it = SEQ_MAPPING[*ptr >> 4];
+}
+
+// ----------------------------------------------------------------------------
+// Function getQual()
+// ----------------------------------------------------------------------------
+
+template <typename TQualString>
+inline void
+getQual(TQualString & qual, BamRecordView const & view)
+{
+    typedef typename Iterator<TQualString, Standard>::Type TQualIter;
+
+    __int32 lSeq = getSeqLength(view);
+    unsigned offset = _bamViewQualOffset(view);
+    SEQAN_ASSERT_LEQ(offset + lSeq, static_cast<unsigned>(view._length));
+
+    // A first byte of 0xff stands for '*', as in readRecord().
+    if (lSeq == 0 || view._data[offset] == '\xFF')
+    {
+        clear(qual);
+        return;
+    }
+    resize(qual, lSeq, Exact());
+    char const * ptr = view._data + offset;
+    TQualIter itEnd = end(qual, Standard());
+    for (TQualIter it = begin(qual, Standard()); it != itEnd; ++it, ++ptr)
+        *it = *ptr + '!';
+}
+
+// ----------------------------------------------------------------------------
+// Function getTags()
+// ----------------------------------------------------------------------------
+
+template <typename TTarget>
+inline void
+getTags(TTarget & tags, BamRecordView const & view)
+{
+    unsigned offset = _bamViewTagsOffset(view);
+    SEQAN_ASSERT_LEQ(offset, static_cast<unsigned>(view._length));
+    resize(tags, view._length - offset, Exact());
+    std::copy(view._data + offset, view._data + view._length, begin(tags, Standard()));
+}
+
+// ----------------------------------------------------------------------------
+// Function decodeRecord()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BamRecordView#decodeRecord
+ * @brief Decode all fields of a view into a @link BamAlignmentRecord @endlink.
+ *
+ * @signature void decodeRecord(record, context, view);
+ *
+ * @param[out] record  The @link BamAlignmentRecord @endlink to decode into.
+ * @param[in]  context The @link BamIOContext @endlink used for translating the reference id.
+ * @param[in]  view    The BamRecordView to decode.
+ *
+ * The result is the same as <tt>readRecord(record, context, stream, Bam())</tt> would have read.
+ */
+
+/**
+.Function.decodeRecord
+..class:Class.BamRecordView
+..cat:BAM I/O
+..summary:Decode all fields of a @Class.BamRecordView@ into a @Class.BamAlignmentRecord@.
+..signature:decodeRecord(record, context, view)
+..param.record:The record to decode into.
+...type:Class.BamAlignmentRecord
+..param.context:The context used for translating the reference id.
+...type:Class.BamIOContext
+..param.view:The view to decode.
+...type:Class.BamRecordView
+..remarks:The result is the same as $readRecord(record, context, stream, Bam())$ would have read.
+..include:seqan/bam_io.h
+*/
+
+template <typename TNameStore, typename TNameStoreCache>
+inline void
+decodeRecord(BamAlignmentRecord & record,
+             BamIOContext<TNameStore, TNameStoreCache> const & context,
+             BamRecordView const & view)
+{
+    record.rID = getRID(view);
+    if (record.rID >= 0 && !empty(context.translateFile2GlobalRefId))
+        record.rID = context.translateFile2GlobalRefId[record.rID];
+    record.beginPos = getBeginPos(view);
+    record.bin = getBin(view);
+    record.mapQ = getMapQ(view);
+    record.flag = getFlag(view);
+    record.rNextId = getRNextId(view);
+    record.pNext = getPNext(view);
+    record.tLen = getTLen(view);
+    getQName(record.qName, view);
+    getCigar(record.cigar, view);
+    getSeq(record.seq, view);
+    getQual(record.qual, view);
+    getTags(record.tags, view);
+}
+
+// ----------------------------------------------------------------------------
+// Function readBatch()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BamRecordBatch#readBatch
+ * @brief Read views of all records in the current BGZF block.
+ *
+ * @signature int readBatch(batch, stream, Bam());
+ * @signature int readBatch(batch, bamStream);
+ *
+ * @param[out]    batch     The BamRecordBatch to fill.
+ * @param[in,out] stream    The @link BgzfStream @endlink to read from, positioned behind the header.
+ * @param[in,out] bamStream The @link BamStream @endlink to read from, must have been opened for reading a BAM file.
+ *
+ * @return int A status code, 0 on success, != 0 on failure.  At the end of the file, 0 is returned and
+ *             <tt>batch.views</tt> is empty.
+ *
+ * All records that lie completely in the current block are returned without copying, a record at the beginning of
+ * the batch that spans block borders is copied into a buffer of the batch.  The views are invalidated by the next
+ * call.  Reading views and records with <tt>readRecord</tt> from the same stream can be mixed between batches.
+ */
+
+/**
+.Function.readBatch
+..class:Class.BamRecordBatch
+..cat:BAM I/O
+..summary:Read views of all records in the current BGZF block.
+..signature:readBatch(batch, stream, Bam())
+..signature:readBatch(batch, bamIO)
+..param.batch:The batch to fill.
+...type:Class.BamRecordBatch
+..param.stream:The BGZF stream to read from, positioned behind the header.
+...type:Spec.BGZF Stream
+..param.bamIO:The @Class.BamStream@ to read from, must have been opened for reading a BAM file.
+...type:Class.BamStream
+..returns:An $int$ status code, $0$ on success, non-$0$ on failure.  At the end of the file, $0$ is returned and
+$batch.views$ is empty.
+..remarks:All records that lie completely in the current block are returned without copying, a record at the
+beginning of the batch that spans block borders is copied into a buffer of the batch.  The views are invalidated by the
+next call.
+..include:seqan/bam_io.h
+*/
+
+inline int
+readBatch(BamRecordBatch & batch, Stream<Bgzf> & stream, Bam const & /*tag*/)
+{
+    clear(batch.views);
+
+    // Load the next block if the current one is exhausted.  Empty blocks are valid anywhere in the file, e.g. in
+    // concatenated files, and are skipped.
+    while (stream._blockOffset >= stream._blockLength)
+    {
+        int res = _bgzfReadBlock(stream);
+        if (res == -2)
+            return 0;  // EOF.
+        if (res != 0)
+            return 1;
+    }
+
+    char const * ptr = &stream._uncompressedBlock[0] + stream._blockOffset;
+    char const * ptrEnd = &stream._uncompressedBlock[0] + stream._blockLength;
+    __int32 blockSize = 0;
+
+    // The record at the current position was cut by the previous batch, copy it.
+    if (ptrEnd - ptr < 4 || (memcpy(&blockSize, ptr, 4), ptrEnd - ptr - 4 < blockSize))
+    {
+        resize(batch._spill, 4);
+        if (streamReadBlock(&batch._spill[0], stream, 4) != 4u)
+            return 1;
+        memcpy(&blockSize, &batch._spill[0], 4);
+        if (blockSize < 32)
+            return 1;
+        resize(batch._spill, 4 + blockSize);
+        if (streamReadBlock(&batch._spill[4], stream, blockSize) != static_cast<size_t>(blockSize))
+            return 1;
+        appendValue(batch.views, BamRecordView(&batch._spill[4], blockSize));
+
+        // Stop at block borders, the next batch starts with the next block.
+        if (stream._blockOffset >= stream._blockLength)
+            return 0;
+        ptr = &stream._uncompressedBlock[0] + stream._blockOffset;
+        ptrEnd = &stream._uncompressedBlock[0] + stream._blockLength;
+    }
+
+    // Take all records that lie completely in the block.
+    while (ptrEnd - ptr >= 4)
+    {
+        memcpy(&blockSize, ptr, 4);
+        if (blockSize < 32)
+            return 1;
+        if (ptrEnd - ptr - 4 < blockSize)
+            break;
+        appendValue(batch.views, BamRecordView(ptr + 4, blockSize));
+        ptr += 4 + blockSize;
+    }
+
+    // Leave a cut record in the block, mark a completely read block as unread like streamReadBlock() does.
+    stream._blockOffset = ptr - &stream._uncompressedBlock[0];
+    if (stream._blockOffset == stream._blockLength)
+    {
+        stream._blockPosition = tell(stream._file);
+        stream._blockOffset = 0;
+        stream._blockLength = 0;
+    }
+    return 0;
+}
+
+inline int
+readBatch(BamRecordBatch & batch, BamStream & bamIO)
+{
+    if (bamIO._format != BamStream::BAM || bamIO._mode != BamStream::READ)
+        return 1;  // Views exist only for BAM records.
+
+    BamReader_ * s = static_cast<BamReader_ *>(bamIO._reader.get());
+    int res = readBatch(batch, s->_stream, Bam());
+    bamIO._isGood = bamIO._isGood && (res == 0);
+    return res;
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef CORE_INCLUDE_SEQAN_BAM_IO_BAM_RECORD_VIEW_H_
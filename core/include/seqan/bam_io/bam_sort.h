@@ -0,0 +1,895 @@
+// ==========================================================================
+//                              bam_index_base.h
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Author: agent <agent@local>
+// ==========================================================================
+// External sorting of BAM/SAM files with bounded memory.
+//
+// The records are read into memory until the memory limit is reached, sorted
+// and written to temporary BGZF-compressed runs.  The runs are merged using a
+// heap into the final BAM file.  When sorting by coordinate, the BAI index is
+// built while the final file is written.
+// ==========================================================================
+
+#ifndef CORE_INCLUDE_SEQAN_BAM_IO_BAM_SORT_H_
+#define CORE_INCLUDE_SEQAN_BAM_IO_BAM_SORT_H_
+
+#include <algorithm>
+#include <cstdio>
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Tags SortByCoordinate, SortByQueryName
+// ----------------------------------------------------------------------------
+
+/*!
+ * @tag BamSortOrderTags#SortByCoordinate
+ * @headerfile <seqan/bam_io.h>
+ * @brief Sort BAM records by reference id, begin position and strand; records without reference come last.
+ *
+ * @signature typedef Tag<SortByCoordinate_> SortByCoordinate;
+ *
+ * @tag BamSortOrderTags#SortByQueryName
+ * @headerfile <seqan/bam_io.h>
+ * @brief Sort BAM records by query name, numbers in the names are compared numerically.
+ *
+ * @signature typedef Tag<SortByQueryName_> SortByQueryName;
+ */
+
+/**
+.Tag.BAM Sort Order
+..cat:BAM I/O
+..summary:Tags for selecting the order of @Function.sortBamFile@.
+..tag.SortByCoordinate:Sort by reference id, begin position and strand.
+Records without reference come last.
+..tag.SortByQueryName:Sort by query name, numbers in the names are compared numerically.
+Mates are ordered by their first/last flags.
+..include:seqan/bam_io.h
+*/
+
+struct SortByCoordinate_;
+typedef Tag<SortByCoordinate_> SortByCoordinate;
+
+struct SortByQueryName_;
+typedef Tag<SortByQueryName_> SortByQueryName;
+
+// ----------------------------------------------------------------------------
+// Class BamSortOptions
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class BamSortOptions
+ * @headerfile <seqan/bam_io.h>
+ * @brief Options for @link sortBamFile @endlink.
+ *
+ * @signature struct BamSortOptions;
+ *
+ * @var __uint64 BamSortOptions::memoryLimit
+ * @brief Approximate number of bytes used for the records held in memory, default: 768 MB.
+ *
+ * @var unsigned BamSortOptions::numThreads
+ * @brief Number of threads for sorting and for (de)compression, default: <tt>omp_get_max_threads()</tt>.
+ *
+ * @var unsigned BamSortOptions::maxMergeWidth
+ * @brief Maximal number of runs merged at once, default: 256.  More runs are merged in several passes.
+ *
+ * @var CharString BamSortOptions::tmpPrefix
+ * @brief Prefix of the temporary run files, default: the output file name.
+ *
+ * @var int BamSortOptions::compressionLevel
+ * @brief zlib compression level of the output file, default: <tt>Z_DEFAULT_COMPRESSION</tt>.
+ *
+ * @var bool BamSortOptions::buildIndex
+ * @brief Write a BAI index <tt>outFilename + ".bai"</tt> when sorting by coordinate, default: <tt>true</tt>.
+ */
+
+/**
+.Class.BamSortOptions
+..cat:BAM I/O
+..summary:Options for @Function.sortBamFile@.
+..signature:BamSortOptions
+..include:seqan/bam_io.h
+
+.Memvar.BamSortOptions#memoryLimit
+..class:Class.BamSortOptions
+..summary:Approximate number of bytes used for the records held in memory, default: 768 MB.
+..type:nolink:$__uint64$
+
+.Memvar.BamSortOptions#numThreads
+..class:Class.BamSortOptions
+..summary:Number of threads for sorting and for (de)compression, default: $omp_get_max_threads()$.
+..type:nolink:$unsigned$
+
+.Memvar.BamSortOptions#maxMergeWidth
+..class:Class.BamSortOptions
+..summary:Maximal number of runs merged at once, default: 256.
+More runs are merged in several passes.
+..type:nolink:$unsigned$
+
+.Memvar.BamSortOptions#tmpPrefix
+..class:Class.BamSortOptions
+..summary:Prefix of the temporary run files, default: the output file name.
+..type:Shortcut.CharString
+
+.Memvar.BamSortOptions#compressionLevel
+..class:Class.BamSortOptions
+..summary:zlib compression level of the output file, default: $Z_DEFAULT_COMPRESSION$.
+..type:nolink:$int$
+
+.Memvar.BamSortOptions#buildIndex
+..class:Class.BamSortOptions
+..summary:Write a BAI index $outFilename + ".bai"$ when sorting by coordinate, default: $true$.
+..type:nolink:$bool$
+*/
+
+struct BamSortOptions
+{
+    __uint64 memoryLimit;
+    unsigned numThreads;
+    unsigned maxMergeWidth;
+    CharString tmpPrefix;
+    int compressionLevel;
+    bool buildIndex;
+
+    BamSortOptions() :
+        memoryLimit(768ull * 1024 * 1024), numThreads(omp_get_max_threads()), maxMergeWidth(256),
+        compressionLevel(Z_DEFAULT_COMPRESSION), buildIndex(true)
+    {}
+};
+
+// ----------------------------------------------------------------------------
+// Helper Class BamSortLess_
+// ----------------------------------------------------------------------------
+
+template <typename TSortOrder>
+struct BamSortLess_;
+
+// Coordinate order as in samtools sort, the reference id is compared unsigned such that unmapped reads come last.
+template <>
+struct BamSortLess_<SortByCoordinate>
+{
+    bool operator()(BamAlignmentRecord const & a, BamAlignmentRecord const & b) const
+    {
+        if (a.rID != b.rID)
+            return static_cast<__uint32>(a.rID) < static_cast<__uint32>(b.rID);
+        if (a.beginPos != b.beginPos)
+            return static_cast<__uint32>(a.beginPos + 1) < static_cast<__uint32>(b.beginPos + 1);
+        return (a.flag & BAM_FLAG_RC) < (b.flag & BAM_FLAG_RC);
+    }
+};
+
+// Query name order as in samtools sort -n, runs of digits are compared by their numeric value.
+template <>
+struct BamSortLess_<SortByQueryName>
+{
+    static int _compare(CharString const & a, CharString const & b)
+    {
+        typedef Iterator<CharString const, Standard>::Type TIter;
+
+        TIter itA = begin(a, Standard()), endA = end(a, Standard());
+        TIter itB = begin(b, Standard()), endB = end(b, Standard());
+        while (itA != endA && itB != endB)
+        {
+            if (isdigit(*itA) && isdigit(*itB))
+            {
+                // Skip leading zeros, then the longer number is larger and numbers of equal length compare
+                // lexicographically.
+                while (itA != endA && *itA == '0')
+                    ++itA;
+                while (itB != endB && *itB == '0')
+                    ++itB;
+                TIter numA = itA, numB = itB;
+                while (itA != endA && isdigit(*itA))
+                    ++itA;
+                while (itB != endB && isdigit(*itB))
+                    ++itB;
+                if (itA - numA != itB - numB)
+                    return (itA - numA < itB - numB) ? -1 : 1;
+                for (; numA != itA; ++numA, ++numB)
+                    if (*numA != *numB)
+                        return (*numA < *numB) ? -1 : 1;
+            }
+            else
+            {
+                if (*itA != *itB)
+                    return (static_cast<unsigned char>(*itA) < static_cast<unsigned char>(*itB)) ? -1 : 1;
+                ++itA;
+                ++itB;
+            }
+        }
+        if (itA != endA)
+            return 1;
+        if (itB != endB)
+            return -1;
+        return 0;
+    }
+
+    bool operator()(BamAlignmentRecord const & a, BamAlignmentRecord const & b) const
+    {
+        int res = _compare(a.qName, b.qName);
+        if (res != 0)
+            return res < 0;
+        return (a.flag & (BAM_FLAG_FIRST | BAM_FLAG_LAST)) < (b.flag & (BAM_FLAG_FIRST | BAM_FLAG_LAST));
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Helper Class BamSortIndexLess_
+// ----------------------------------------------------------------------------
+
+// Compares positions in a string of records, equal records are ordered by their positions to get a stable order.
+template <typename TSortOrder>
+struct BamSortIndexLess_
+{
+    String<BamAlignmentRecord> const * records;
+    BamSortLess_<TSortOrder> less;
+
+    BamSortIndexLess_(String<BamAlignmentRecord> const & records) : records(&records)
+    {}
+
+    bool operator()(unsigned a, unsigned b) const
+    {
+        if (less((*records)[a], (*records)[b]))
+            return true;
+        if (less((*records)[b], (*records)[a]))
+            return false;
+        return a < b;
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Helper Class BamSortWriter_
+// ----------------------------------------------------------------------------
+
+// Information about a record in the write buffer of a BamSortWriter_ that is needed for the BAI index.
+struct BamSortPendingRecord_
+{
+    // End position of the record in the write buffer.
+    __int64 endPos;
+    __int32 rID;
+    __int32 beginPos;
+    __int32 endPosInRef;
+    __uint32 bin;
+    __uint16 flag;
+};
+
+// Writes the final BAM file.  The uncompressed data is collected and cut into blocks which are compressed in
+// parallel.  As the block boundaries are known, the virtual offsets of the records are known as soon as the blocks
+// are written and the records can be added to the BAI index.
+struct BamSortWriter_
+{
+    typedef Stream<Bgzf>::TFile TFile;
+
+    // Uncompressed data of a block, chosen such that the compressed block always fits into 64 KB.
+    static const unsigned BLOCK_SIZE = 0xff00;
+    static const unsigned BLOCKS_PER_THREAD = 4;
+
+    TFile file;
+    __int64 filePos;
+    unsigned numThreads;
+    int compressionLevel;
+
+    // Uncompressed data that is not written yet and the records ending in it.
+    CharString buffer;
+    String<BamSortPendingRecord_> pending;
+    // Buffers for the compressed blocks and their positions in the file.
+    String<String<char> > compressedBlocks;
+    String<__int64> blockPositions;
+
+    bool buildIndex;
+    BamIndex<Bai> index;
+    BaiBamIndexBuilder_ builder;
+
+    BamSortWriter_() : filePos(0), numThreads(1), compressionLevel(Z_DEFAULT_COMPRESSION), buildIndex(false)
+    {}
+};
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Helper Function _bamSortRecordSize()
+// ----------------------------------------------------------------------------
+
+// Approximate number of bytes a record occupies in memory.
+inline __uint64 _bamSortRecordSize(BamAlignmentRecord const & record)
+{
+    return sizeof(BamAlignmentRecord) + capacity(record.qName) + capacity(record.seq) + capacity(record.qual) +
+           capacity(record.cigar) * sizeof(CigarElement<>) + capacity(record.tags);
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bamSortPermutation()
+// ----------------------------------------------------------------------------
+
+// Compute the sorted order of the records.  Each thread sorts a part, then the sorted parts are merged pairwise.
+template <typename TSortOrder>
+inline void _bamSortPermutation(String<unsigned> & perm,
+                                String<BamAlignmentRecord> const & records,
+                                unsigned numThreads,
+                                TSortOrder const & /*tag*/)
+{
+    typedef Iterator<String<unsigned>, Standard>::Type TIter;
+
+    resize(perm, length(records), Exact());
+    for (unsigned i = 0; i < length(perm); ++i)
+        perm[i] = i;
+    if (empty(perm))
+        return;
+
+    BamSortIndexLess_<TSortOrder> less(records);
+    Splitter<unsigned> splitter(0, length(perm), _max(1u, numThreads));
+    int numParts = length(splitter);
+    TIter permBegin = begin(perm, Standard());
+
+    SEQAN_OMP_PRAGMA(parallel for num_threads(numThreads))
+    for (int i = 0; i < numParts; ++i)
+        std::sort(permBegin + splitter[i], permBegin + splitter[i + 1], less);
+
+    for (int width = 1; width < numParts; width *= 2)
+    {
+        SEQAN_OMP_PRAGMA(parallel for num_threads(numThreads))
+        for (int i = 0; i < numParts - width; i += 2 * width)
+            std::inplace_merge(permBegin + splitter[i], permBegin + splitter[i + width],
+                               permBegin + splitter[_min(i + 2 * width, numParts)], less);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bamSortRunFilename()
+// ----------------------------------------------------------------------------
+
+inline void _bamSortRunFilename(CharString & filename, CharString const & prefix, unsigned runId)
+{
+    std::stringstream ss;
+    ss << prefix << ".sort." << runId << ".tmp";
+    filename = ss.str();
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bamSortRemoveRuns()
+// ----------------------------------------------------------------------------
+
+inline void _bamSortRemoveRuns(String<CharString> const & runFilenames)
+{
+    for (unsigned i = 0; i < length(runFilenames); ++i)
+        std::remove(toCString(runFilenames[i]));
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bamSortWriteRecord()                         Stream<Bgzf>
+// ----------------------------------------------------------------------------
+
+// The runs contain the records in the BAM format without a header.
+template <typename TNameStore, typename TNameStoreCache>
+inline int _bamSortWriteRecord(Stream<Bgzf> & stream,
+                               BamAlignmentRecord const & record,
+                               BamIOContext<TNameStore, TNameStoreCache> const & context)
+{
+    return write2(stream, record, context, Bam());
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bamSortWriteRun()
+// ----------------------------------------------------------------------------
+
+template <typename TNameStore, typename TNameStoreCache, typename TSortOrder>
+inline int _bamSortWriteRun(CharString const & filename,
+                            String<BamAlignmentRecord> const & records,
+                            BamIOContext<TNameStore, TNameStoreCache> const & context,
+                            BamSortOptions const & options,
+                            TSortOrder const & tag)
+{
+    String<unsigned> perm;
+    _bamSortPermutation(perm, records, options.numThreads, tag);
+
+    // The runs are read once only, therefore the fastest compression is used.
+    Stream<Bgzf> stream;
+    if (!open(stream, toCString(filename), "w1"))
+        return 1;
+    setNumThreads(stream, options.numThreads);
+
+    for (unsigned i = 0; i < length(perm); ++i)
+        if (_bamSortWriteRecord(stream, records[perm[i]], context) != 0)
+            return 1;
+    return streamFlush(stream) != 0;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bamSortFlush()
+// ----------------------------------------------------------------------------
+
+// Compress and write out the full blocks of the buffer, or all data if final is true.  Then the records ending in the
+// written data are added to the index.
+inline int _bamSortFlush(BamSortWriter_ & writer, bool final)
+{
+    unsigned const BLOCK_SIZE = BamSortWriter_::BLOCK_SIZE;
+
+    __int64 flushLength = final ? length(writer.buffer) : length(writer.buffer) / BLOCK_SIZE * BLOCK_SIZE;
+    int numBlocks = (flushLength + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    if (numBlocks == 0)
+        return 0;
+
+    if ((int)length(writer.compressedBlocks) < numBlocks)
+        resize(writer.compressedBlocks, numBlocks);
+    resize(writer.blockPositions, numBlocks + 1, Exact());
+
+    bool ok = true;
+    SEQAN_OMP_PRAGMA(parallel for num_threads(writer.numThreads) schedule(dynamic))
+    for (int i = 0; i < numBlocks; ++i)
+    {
+        int inputLength = _min((__int64)BLOCK_SIZE, flushLength - (__int64)i * BLOCK_SIZE);
+        int blockLength = inputLength;
+        int compressedLength = _bgzfDeflate(writer.compressedBlocks[i], &writer.buffer[0] + (__int64)i * BLOCK_SIZE,
+                                            blockLength, writer.compressionLevel);
+        // Blocks of BLOCK_SIZE bytes always fit, therefore all data must be consumed.
+        if (compressedLength < 0 || blockLength != inputLength)
+            ok = false;
+        else
+            resize(writer.compressedBlocks[i], compressedLength);
+    }
+    if (!ok)
+        return 1;
+
+    for (int i = 0; i < numBlocks; ++i)
+    {
+        writer.blockPositions[i] = writer.filePos;
+        if (!write(writer.file, &writer.compressedBlocks[i][0], length(writer.compressedBlocks[i])))
+            return 1;
+        writer.filePos += length(writer.compressedBlocks[i]);
+    }
+    writer.blockPositions[numBlocks] = writer.filePos;
+
+    // Add the records ending in the written data to the index.
+    unsigned numDone = 0;
+    for (; numDone < length(writer.pending) && writer.pending[numDone].endPos <= flushLength; ++numDone)
+    {
+        BamSortPendingRecord_ const & rec = writer.pending[numDone];
+        __uint64 endOffset;
+        if (rec.endPos == flushLength)
+            endOffset = (__uint64)writer.filePos << 16;
+        else
+            endOffset = ((__uint64)writer.blockPositions[rec.endPos / BLOCK_SIZE] << 16) | (rec.endPos % BLOCK_SIZE);
+        if (writer.buildIndex &&
+            !_baiBuilderAddRecord(writer.index, writer.builder, rec.rID, rec.beginPos, rec.endPosInRef, rec.bin,
+                                  rec.flag, endOffset))
+            return 1;  // Not sorted by coordinate.
+    }
+    erase(writer.pending, 0, numDone);
+    for (unsigned i = 0; i < length(writer.pending); ++i)
+        writer.pending[i].endPos -= flushLength;
+    erase(writer.buffer, 0, flushLength);
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bamSortWriteRecord()                       BamSortWriter_
+// ----------------------------------------------------------------------------
+
+template <typename TNameStore, typename TNameStoreCache>
+inline int _bamSortWriteRecord(BamSortWriter_ & writer,
+                               BamAlignmentRecord const & record,
+                               BamIOContext<TNameStore, TNameStoreCache> const & context)
+{
+    __int64 beginPos = length(writer.buffer);
+    if (write2(writer.buffer, record, context, Bam()) != 0)
+        return 1;
+
+    if (writer.buildIndex)
+    {
+        // Take the bin from the written data, it is computed when writing.
+        __uint32 binMqNl = 0;
+        memcpy(&binMqNl, &writer.buffer[beginPos + 12], 4);
+
+        BamSortPendingRecord_ rec;
+        rec.endPos = length(writer.buffer);
+        rec.rID = record.rID;
+        rec.beginPos = record.beginPos;
+        rec.endPosInRef = record.beginPos + getAlignmentLengthInRef(record);
+        rec.bin = binMqNl >> 16;
+        rec.flag = record.flag;
+        appendValue(writer.pending, rec);
+    }
+
+    if (length(writer.buffer) >= (__int64)BamSortWriter_::BLOCK_SIZE * BamSortWriter_::BLOCKS_PER_THREAD *
+                                  writer.numThreads)
+        return _bamSortFlush(writer, false);
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bamSortOpenWriter()
+// ----------------------------------------------------------------------------
+
+// Open the output file and write the header into its own blocks.
+template <typename TNameStore, typename TNameStoreCache>
+inline int _bamSortOpenWriter(BamSortWriter_ & writer,
+                              char const * filename,
+                              BamHeader const & header,
+                              BamIOContext<TNameStore, TNameStoreCache> const & context,
+                              BamSortOptions const & options,
+                              bool buildIndex)
+{
+    if (!open(writer.file, filename, OPEN_WRONLY | OPEN_CREATE))
+        return 1;
+    writer.filePos = 0;
+    writer.numThreads = _max(1u, options.numThreads);
+    writer.compressionLevel = options.compressionLevel;
+    writer.buildIndex = buildIndex;
+
+    if (write2(writer.buffer, header, context, Bam()) != 0 || _bamSortFlush(writer, true) != 0)
+        return 1;
+
+    if (buildIndex)
+        _baiBuilderInit(writer.index, writer.builder, _max(length(header.sequenceInfos), length(nameStore(context))),
+                        (__uint64)writer.filePos << 16);
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bamSortCloseWriter()
+// ----------------------------------------------------------------------------
+
+// Write out the remaining data and the empty block marking the end of the file.
+inline int _bamSortCloseWriter(BamSortWriter_ & writer)
+{
+    if (_bamSortFlush(writer, true) != 0)
+        return 1;
+
+    String<char> eofBlock;
+    int inputLength = 0;
+    int eofLength = _bgzfDeflate(eofBlock, "", inputLength, writer.compressionLevel);
+    if (eofLength < 0 || !write(writer.file, &eofBlock[0], eofLength))
+        return 1;
+    writer.filePos += eofLength;
+    close(writer.file);
+
+    if (writer.buildIndex && !_baiBuilderFinish(writer.index, writer.builder, (__uint64)writer.filePos << 16))
+        return 1;
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bamSortMergeRuns()
+// ----------------------------------------------------------------------------
+
+// Compares the current records of the runs for the heap, which has the smallest record at its top.  Equal records
+// are taken from the earlier run first to keep the order stable.
+template <typename TSortOrder>
+struct BamSortHeapGreater_
+{
+    String<BamAlignmentRecord> const * records;
+    BamSortLess_<TSortOrder> less;
+
+    BamSortHeapGreater_(String<BamAlignmentRecord> const & records) : records(&records)
+    {}
+
+    bool operator()(unsigned a, unsigned b) const
+    {
+        if (less((*records)[b], (*records)[a]))
+            return true;
+        if (less((*records)[a], (*records)[b]))
+            return false;
+        return a > b;
+    }
+};
+
+// Merge the runs [beginRun, endRun) into target.
+template <typename TTarget, typename TNameStore, typename TNameStoreCache, typename TSortOrder>
+inline int _bamSortMergeRuns(TTarget & target,
+                             String<CharString> const & runFilenames,
+                             unsigned beginRun,
+                             unsigned endRun,
+                             BamIOContext<TNameStore, TNameStoreCache> & context,
+                             TSortOrder const & /*tag*/)
+{
+    unsigned numRuns = endRun - beginRun;
+
+    // The runs are read sequentially, only the target is compressed in parallel.  This keeps the memory of each
+    // run at one block.
+    Stream<Bgzf> * runs = new Stream<Bgzf>[numRuns];
+    String<BamAlignmentRecord> current;
+    resize(current, numRuns);
+    String<unsigned> heap;
+
+    int res = 0;
+    for (unsigned i = 0; i < numRuns && res == 0; ++i)
+    {
+        setNumThreads(runs[i], 1);
+        if (!open(runs[i], toCString(runFilenames[beginRun + i]), "r"))
+            res = 1;
+        else if (!streamEof(runs[i]))
+        {
+            if (readRecord(current[i], context, runs[i], Bam()) != 0)
+                res = 1;
+            appendValue(heap, i);
+        }
+    }
+
+    BamSortHeapGreater_<TSortOrder> greater(current);
+    std::make_heap(begin(heap, Standard()), end(heap, Standard()), greater);
+    while (!empty(heap) && res == 0)
+    {
+        std::pop_heap(begin(heap, Standard()), end(heap, Standard()), greater);
+        unsigned i = back(heap);
+        if (_bamSortWriteRecord(target, current[i], context) != 0)
+        {
+            res = 1;
+            break;
+        }
+
+        if (streamEof(runs[i]))
+        {
+            eraseBack(heap);
+            continue;
+        }
+        if (readRecord(current[i], context, runs[i], Bam()) != 0)
+            res = 1;
+        std::push_heap(begin(heap, Standard()), end(heap, Standard()), greater);
+    }
+
+    delete[] runs;
+    return res;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bamSortSetSortOrder()
+// ----------------------------------------------------------------------------
+
+// Set the SO tag of the @HD header record, a header record is added if there is none.
+inline void _bamSortSetSortOrder(BamHeader & header, char const * sortOrder)
+{
+    unsigned i = 0;
+    for (; i < length(header.records); ++i)
+        if (header.records[i].type == BAM_HEADER_FIRST)
+            break;
+
+    if (i == length(header.records))
+    {
+        BamHeaderRecord record;
+        record.type = BAM_HEADER_FIRST;
+        appendValue(record.tags, Pair<CharString>("VN", "1.4"));
+        insertValue(header.records, 0, record);
+        i = 0;
+    }
+    setTagValue("SO", sortOrder, header.records[i]);
+}
+
+inline char const * _bamSortOrderName(SortByCoordinate const & /*tag*/)
+{
+    return "coordinate";
+}
+
+inline char const * _bamSortOrderName(SortByQueryName const & /*tag*/)
+{
+    return "queryname";
+}
+
+inline bool _bamSortCanBuildIndex(SortByCoordinate const & /*tag*/)
+{
+    return true;
+}
+
+inline bool _bamSortCanBuildIndex(SortByQueryName const & /*tag*/)
+{
+    return false;
+}
+
+// ----------------------------------------------------------------------------
+// Function sortBamFile()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn sortBamFile
+ * @headerfile <seqan/bam_io.h>
+ * @brief Sort a SAM or BAM file into a BAM file using bounded memory.
+ *
+ * @signature int sortBamFile(outFilename, inFilename, order[, options]);
+ *
+ * @param[in] outFilename The path of the BAM file to write.
+ * @param[in] inFilename  The path of the SAM or BAM file to sort.
+ * @param[in] order       The sort order.  Types: @link BamSortOrderTags#SortByCoordinate @endlink,
+ *                        @link BamSortOrderTags#SortByQueryName @endlink
+ * @param[in] options     The @link BamSortOptions @endlink to use.
+ *
+ * @return int A status code, 0 on success.
+ *
+ * @section Remarks
+ *
+ * The records are read into memory until <tt>options.memoryLimit</tt> is reached.  Then they are sorted in parallel
+ * and written to a temporary run file.  The runs are merged into the output file, the temporary files are removed
+ * afterwards.  Records that compare equal keep their order of the input file.  The SO tag of the header is set to
+ * the sort order.
+ *
+ * When sorting by coordinate and <tt>options.buildIndex</tt> is set, the BAI index is built while the output file
+ * is written and saved to <tt>outFilename + ".bai"</tt>.
+ */
+
+/**
+.Function.sortBamFile
+..cat:BAM I/O
+..summary:Sort a SAM or BAM file into a BAM file using bounded memory.
+..signature:sortBamFile(outFilename, inFilename, order[, options])
+..param.outFilename:The path of the BAM file to write.
+...type:nolink:$char const *$
+..param.inFilename:The path of the SAM or BAM file to sort.
+...type:nolink:$char const *$
+..param.order:The sort order.
+...type:Tag.BAM Sort Order
+..param.options:The options to use.
+...type:Class.BamSortOptions
+..returns:An $int$ status code: $0$ on success, non-$0$ on failure.
+..remarks:The records are read into memory until $options.memoryLimit$ is reached.
+Then they are sorted in parallel and written to a temporary run file.
+The runs are merged into the output file, the temporary files are removed afterwards.
+Records that compare equal keep their order of the input file.
+The SO tag of the header is set to the sort order.
+..remarks:When sorting by coordinate and $options.buildIndex$ is set, the BAI index is built while the output file is
+written and saved to $outFilename + ".bai"$.
+..include:seqan/bam_io.h
+..example.code:
+BamSortOptions options;
+options.memoryLimit = 2ull * 1024 * 1024 * 1024;
+if (sortBamFile("sorted.bam", "unsorted.bam", SortByCoordinate(), options) != 0)
+    std::cerr << "ERROR: Could not sort file.\n";
+*/
+
+template <typename TSortOrder>
+inline int sortBamFile(char const * outFilename,
+                       char const * inFilename,
+                       TSortOrder const & tag,
+                       BamSortOptions const & options)
+{
+    BamStream in(inFilename);
+    if (!isGood(in))
+        return 1;
+
+    CharString tmpPrefix = empty(options.tmpPrefix) ? CharString(outFilename) : options.tmpPrefix;
+    String<CharString> runFilenames;
+    int res = 0;
+
+    // Form sorted runs.
+    String<BamAlignmentRecord> records;
+    __uint64 memory = 0;
+    while (!atEnd(in) && res == 0)
+    {
+        resize(records, length(records) + 1);
+        if (readRecord(back(records), in) != 0)
+        {
+            res = 1;
+            break;
+        }
+        memory += _bamSortRecordSize(back(records));
+        if (memory < options.memoryLimit)
+            continue;
+
+        resize(runFilenames, length(runFilenames) + 1);
+        _bamSortRunFilename(back(runFilenames), tmpPrefix, length(runFilenames) - 1);
+        res = _bamSortWriteRun(back(runFilenames), records, in.bamIOContext, options, tag);
+        clear(records);
+        memory = 0;
+    }
+
+    BamHeader header = in.header;
+    _bamSortSetSortOrder(header, _bamSortOrderName(tag));
+    bool buildIndex = options.buildIndex && _bamSortCanBuildIndex(tag);
+
+    BamSortWriter_ writer;
+    if (res == 0)
+        res = _bamSortOpenWriter(writer, outFilename, header, in.bamIOContext, options, buildIndex);
+
+    if (res == 0 && empty(runFilenames))
+    {
+        // All records fit into memory, write them out directly.
+        String<unsigned> perm;
+        _bamSortPermutation(perm, records, options.numThreads, tag);
+        for (unsigned i = 0; i < length(perm) && res == 0; ++i)
+            res = _bamSortWriteRecord(writer, records[perm[i]], in.bamIOContext);
+    }
+    else if (res == 0)
+    {
+        if (!empty(records))
+        {
+            resize(runFilenames, length(runFilenames) + 1);
+            _bamSortRunFilename(back(runFilenames), tmpPrefix, length(runFilenames) - 1);
+            res = _bamSortWriteRun(back(runFilenames), records, in.bamIOContext, options, tag);
+        }
+        clear(records);
+
+        // Merge groups of runs until they can be merged at once.
+        unsigned maxMergeWidth = _max(2u, options.maxMergeWidth);
+        unsigned nextRunId = length(runFilenames);
+        while (length(runFilenames) > maxMergeWidth && res == 0)
+        {
+            String<CharString> mergedFilenames;
+            for (unsigned beginRun = 0; beginRun < length(runFilenames) && res == 0; beginRun += maxMergeWidth)
+            {
+                unsigned endRun = _min(beginRun + maxMergeWidth, (unsigned)length(runFilenames));
+                resize(mergedFilenames, length(mergedFilenames) + 1);
+                _bamSortRunFilename(back(mergedFilenames), tmpPrefix, nextRunId++);
+
+                Stream<Bgzf> stream;
+                if (!open(stream, toCString(back(mergedFilenames)), "w1"))
+                {
+                    res = 1;
+                    break;
+                }
+                setNumThreads(stream, options.numThreads);
+                res = _bamSortMergeRuns(stream, runFilenames, beginRun, endRun, in.bamIOContext, tag);
+                if (res == 0 && streamFlush(stream) != 0)
+                    res = 1;
+            }
+            _bamSortRemoveRuns(runFilenames);
+            runFilenames = mergedFilenames;
+        }
+
+        if (res == 0)
+            res = _bamSortMergeRuns(writer, runFilenames, 0, length(runFilenames), in.bamIOContext, tag);
+    }
+    _bamSortRemoveRuns(runFilenames);
+
+    if (res == 0)
+        res = _bamSortCloseWriter(writer);
+
+    if (res == 0 && buildIndex)
+    {
+        CharString baiFilename = outFilename;
+        append(baiFilename, ".bai");
+        res = save(writer.index, toCString(baiFilename));
+    }
+    return res;
+}
+
+template <typename TSortOrder>
+inline int sortBamFile(char const * outFilename,
+                       char const * inFilename,
+                       TSortOrder const & tag)
+{
+    return sortBamFile(outFilename, inFilename, tag, BamSortOptions());
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef CORE_INCLUDE_SEQAN_BAM_IO_BAM_SORT_H_
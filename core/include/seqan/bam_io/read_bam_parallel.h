@@ -0,0 +1,554 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Author: agent <agent@local>
+// ==========================================================================
+// Pipelined parallel reading of BAM records.  The BGZF blocks of the file
+// travel through a ring buffer of slots, every slot passes the stages
+//
+//   read -> inflate -> split -> parse -> consume
+//
+// Reading, splitting (cutting the byte stream into complete records) and
+// consuming are serial stages, inflating and parsing run on all threads.
+// Every thread of the team repeatedly picks the most advanced stage it can
+// work on, so the consumer runs concurrently with the other stages.
+// ==========================================================================
+
+#ifndef CORE_INCLUDE_SEQAN_BAM_IO_READ_BAM_PARALLEL_H_
+#define CORE_INCLUDE_SEQAN_BAM_IO_READ_BAM_PARALLEL_H_
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Class BamParallelReadOptions
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class BamParallelReadOptions
+ * @headerfile <seqan/bam_io.h>
+ * @brief Options for @link BamStream#readRecordBatches @endlink.
+ *
+ * @signature struct BamParallelReadOptions;
+ *
+ * @var unsigned BamParallelReadOptions::numThreads
+ * @brief Number of threads for decompression, parsing and the consumer, default: <tt>omp_get_max_threads()</tt>.
+ *
+ * @var unsigned BamParallelReadOptions::numSlots
+ * @brief Number of BGZF blocks in flight, 0 for <tt>4 * numThreads</tt>, default: 0.
+ *
+ * @var bool BamParallelReadOptions::keepOrder
+ * @brief Pass the batches in file order, default: <tt>true</tt>.  Otherwise, batches are passed as soon as they are
+ *        parsed.
+ */
+
+/**
+.Class.BamParallelReadOptions
+..cat:BAM I/O
+..summary:Options for @Function.readRecordBatches@.
+..signature:BamParallelReadOptions
+..include:seqan/bam_io.h
+
+.Memvar.BamParallelReadOptions#numThreads
+..class:Class.BamParallelReadOptions
+..summary:Number of threads for decompression, parsing and the consumer, default: $omp_get_max_threads()$.
+..type:nolink:$unsigned$
+
+.Memvar.BamParallelReadOptions#numSlots
+..class:Class.BamParallelReadOptions
+..summary:Number of BGZF blocks in flight, $0$ for $4 * numThreads$, default: $0$.
+..type:nolink:$unsigned$
+
+.Memvar.BamParallelReadOptions#keepOrder
+..class:Class.BamParallelReadOptions
+..summary:Pass the batches in file order, default: $true$.
+Otherwise, batches are passed as soon as they are parsed.
+..type:nolink:$bool$
+*/
+
+struct BamParallelReadOptions
+{
+    unsigned numThreads;
+    unsigned numSlots;
+    bool keepOrder;
+
+    BamParallelReadOptions() :
+        numThreads(omp_get_max_threads()), numSlots(0), keepOrder(true)
+    {}
+};
+
+// ----------------------------------------------------------------------------
+// Helper Class BamPipelineSlot_
+// ----------------------------------------------------------------------------
+
+// One BGZF block on its way through the pipeline.  The state is only changed with atomicCas(), the thread that
+// changed it to one of the ...ING states owns the slot until it leaves that state.
+
+struct BamPipelineSlot_
+{
+    enum State
+    {
+        EMPTY, READING, READ, INFLATING, INFLATED, SPLITTING, SPLIT, PARSING, PARSED, CONSUMING
+    };
+
+    int volatile state;
+    __int64 seq;                            // number of the block in the file
+
+    String<char> compressed;
+    int compressedLength;
+    String<char> uncompressed;
+    int uncompressedLength;
+
+    CharString raw;                         // complete records ending in this block
+    unsigned numRecords;
+    String<BamAlignmentRecord> records;
+
+    BamPipelineSlot_() :
+        state(EMPTY), seq(0), compressedLength(0), uncompressedLength(0), numRecords(0)
+    {}
+};
+
+// ----------------------------------------------------------------------------
+// Helper Class BamPipeline_
+// ----------------------------------------------------------------------------
+
+template <typename TNameStore, typename TNameStoreCache>
+struct BamPipeline_
+{
+    typedef BamIOContext<TNameStore, TNameStoreCache> TContext;
+
+    Stream<Bgzf> & stream;
+    TContext const & context;
+    bool keepOrder;
+
+    // Ring buffer, block seq lives in slot seq % length(slots).
+    String<BamPipelineSlot_> slots;
+
+    // Locks of the serial stages and the members only accessed by the lock holders.
+    int volatile readLock;
+    int volatile splitLock;
+    int volatile consumeLock;
+    __int64 nextRead;
+    __int64 nextSplit;
+    __int64 nextConsume;
+    CharString carry;                       // beginning of a record that continues in the next block
+
+    __int64 volatile eofSeq;                // number of blocks in the file, -1 while unknown
+    __int64 volatile numFinished;
+    int volatile error;
+
+    BamPipeline_(Stream<Bgzf> & stream, TContext const & context, bool keepOrder) :
+        stream(stream), context(context), keepOrder(keepOrder), readLock(0), splitLock(0), consumeLock(0),
+        nextRead(0), nextSplit(0), nextConsume(0), eofSeq(-1), numFinished(0), error(0)
+    {}
+};
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Helper Functions _bamPipelineClaim(), _bamPipelineTryLock(), _bamPipelineUnlock()
+// ----------------------------------------------------------------------------
+
+inline bool
+_bamPipelineClaim(BamPipelineSlot_ & slot, int from, int to)
+{
+    return slot.state == from && atomicCas(slot.state, from, to) == from;
+}
+
+inline bool
+_bamPipelineTryLock(int volatile & lock)
+{
+    return lock == 0 && atomicCas(lock, 0, 1) == 0;
+}
+
+inline void
+_bamPipelineUnlock(int volatile & lock)
+{
+    atomicCas(lock, 1, 0);
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bamPipelineRead()
+// ----------------------------------------------------------------------------
+
+// Read the next compressed block into its slot if the slot is free.  Returns true if there was work to do.
+
+template <typename TPipeline>
+inline bool
+_bamPipelineRead(TPipeline & pipe)
+{
+    if (pipe.eofSeq >= 0 || !_bamPipelineTryLock(pipe.readLock))
+        return false;
+
+    bool worked = false;
+    BamPipelineSlot_ & slot = pipe.slots[pipe.nextRead % length(pipe.slots)];
+    if (pipe.eofSeq < 0 && _bamPipelineClaim(slot, BamPipelineSlot_::EMPTY, BamPipelineSlot_::READING))
+    {
+        int res = _bgzfReadCompressedBlock(slot.compressed, pipe.stream._file);
+        if (res == -2)
+        {
+            atomicCas(slot.state, (int)BamPipelineSlot_::READING, (int)BamPipelineSlot_::EMPTY);
+            atomicCas(pipe.eofSeq, (__int64)-1, pipe.nextRead);
+        }
+        else if (res < 0)
+        {
+            pipe.error = 1;
+        }
+        else
+        {
+            slot.compressedLength = res;
+            slot.seq = pipe.nextRead++;
+            atomicCas(slot.state, (int)BamPipelineSlot_::READING, (int)BamPipelineSlot_::READ);
+        }
+        worked = true;
+    }
+    _bamPipelineUnlock(pipe.readLock);
+    return worked;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bamPipelineInflate()
+// ----------------------------------------------------------------------------
+
+template <typename TPipeline>
+inline bool
+_bamPipelineInflate(TPipeline & pipe)
+{
+    for (unsigned i = 0; i < length(pipe.slots); ++i)
+    {
+        BamPipelineSlot_ & slot = pipe.slots[i];
+        if (!_bamPipelineClaim(slot, BamPipelineSlot_::READ, BamPipelineSlot_::INFLATING))
+            continue;
+
+        slot.uncompressedLength = _bgzfInflate(&slot.uncompressed[0], length(slot.uncompressed),
+                                               &slot.compressed[0], slot.compressedLength);
+        if (slot.uncompressedLength < 0)
+            pipe.error = 1;
+        else
+            atomicCas(slot.state, (int)BamPipelineSlot_::INFLATING, (int)BamPipelineSlot_::INFLATED);
+        return true;
+    }
+    return false;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bamPipelineSplit()
+// ----------------------------------------------------------------------------
+
+// Prepend the carried bytes to the next block in file order and cut it behind the last complete record.
+
+template <typename TPipeline>
+inline bool
+_bamPipelineSplit(TPipeline & pipe)
+{
+    if (!_bamPipelineTryLock(pipe.splitLock))
+        return false;
+
+    bool worked = false;
+    BamPipelineSlot_ & slot = pipe.slots[pipe.nextSplit % length(pipe.slots)];
+    if (_bamPipelineClaim(slot, BamPipelineSlot_::INFLATED, BamPipelineSlot_::SPLITTING))
+    {
+        SEQAN_ASSERT_EQ(slot.seq, pipe.nextSplit);
+
+        swap(slot.raw, pipe.carry);
+        append(slot.raw, prefix(slot.uncompressed, slot.uncompressedLength));
+
+        char const * ptrBegin = begin(slot.raw, Standard());
+        char const * ptrEnd = end(slot.raw, Standard());
+        char const * ptr = ptrBegin;
+        __int32 blockSize = 0;
+        slot.numRecords = 0;
+        while (ptrEnd - ptr >= 4)
+        {
+            memcpy(&blockSize, ptr, 4);
+            if (blockSize < 32)
+            {
+                pipe.error = 1;
+                break;
+            }
+            if (ptrEnd - ptr - 4 < blockSize)
+                break;
+            ptr += 4 + blockSize;
+            ++slot.numRecords;
+        }
+        assign(pipe.carry, suffix(slot.raw, ptr - ptrBegin));
+        resize(slot.raw, ptr - ptrBegin);
+
+        ++pipe.nextSplit;
+        atomicCas(slot.state, (int)BamPipelineSlot_::SPLITTING, (int)BamPipelineSlot_::SPLIT);
+        worked = true;
+    }
+    _bamPipelineUnlock(pipe.splitLock);
+    return worked;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bamPipelineParse()
+// ----------------------------------------------------------------------------
+
+template <typename TPipeline>
+inline bool
+_bamPipelineParse(TPipeline & pipe)
+{
+    for (unsigned i = 0; i < length(pipe.slots); ++i)
+    {
+        BamPipelineSlot_ & slot = pipe.slots[i];
+        if (!_bamPipelineClaim(slot, BamPipelineSlot_::SPLIT, BamPipelineSlot_::PARSING))
+            continue;
+
+        resize(slot.records, slot.numRecords);
+        char const * ptr = begin(slot.raw, Standard());
+        __int32 blockSize = 0;
+        for (unsigned j = 0; j < slot.numRecords; ++j)
+        {
+            memcpy(&blockSize, ptr, 4);
+            decodeRecord(slot.records[j], pipe.context, BamRecordView(ptr + 4, blockSize));
+            ptr += 4 + blockSize;
+        }
+        atomicCas(slot.state, (int)BamPipelineSlot_::PARSING, (int)BamPipelineSlot_::PARSED);
+        return true;
+    }
+    return false;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bamPipelineConsume()
+// ----------------------------------------------------------------------------
+
+// Pass a parsed batch to the consumer, the next one in file order if the order is kept, any one otherwise.
+
+template <typename TPipeline, typename TConsumer>
+inline bool
+_bamPipelineConsume(TPipeline & pipe, TConsumer & consumer)
+{
+    if (!_bamPipelineTryLock(pipe.consumeLock))
+        return false;
+
+    BamPipelineSlot_ * slot = 0;
+    if (pipe.keepOrder)
+    {
+        slot = &pipe.slots[pipe.nextConsume % length(pipe.slots)];
+        if (!_bamPipelineClaim(*slot, BamPipelineSlot_::PARSED, BamPipelineSlot_::CONSUMING))
+            slot = 0;
+    }
+    else
+    {
+        for (unsigned i = 0; slot == 0 && i < length(pipe.slots); ++i)
+            if (_bamPipelineClaim(pipe.slots[i], BamPipelineSlot_::PARSED, BamPipelineSlot_::CONSUMING))
+                slot = &pipe.slots[i];
+    }
+
+    if (slot != 0)
+    {
+        if (!empty(slot->records))
+            consumer(slot->records);
+        ++pipe.nextConsume;
+        atomicCas(slot->state, (int)BamPipelineSlot_::CONSUMING, (int)BamPipelineSlot_::EMPTY);
+        atomicInc(pipe.numFinished);
+    }
+    _bamPipelineUnlock(pipe.consumeLock);
+    return slot != 0;
+}
+
+// ----------------------------------------------------------------------------
+// Function readRecordBatches()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BamStream#readRecordBatches
+ * @brief Read all remaining records in parallel and pass them in batches to a consumer.
+ *
+ * @signature int readRecordBatches(consumer, context, stream[, options]);
+ * @signature int readRecordBatches(consumer, bamStream[, options]);
+ *
+ * @param[in,out] consumer  Functor that is called as <tt>consumer(records)</tt> with a
+ *                          <tt>String&lt;BamAlignmentRecord&gt;</tt> of the records of one batch.
+ * @param[in]     context   The @link BamIOContext @endlink for translating reference ids.
+ * @param[in,out] stream    The @link BgzfStream @endlink to read from, positioned behind the header.
+ * @param[in,out] bamStream The @link BamStream @endlink to read from.
+ * @param[in]     options   The @link BamParallelReadOptions @endlink to use.
+ *
+ * @return int A status code, 0 on success, != 0 on failure.
+ *
+ * The BGZF blocks are decompressed and their records are parsed on <tt>options.numThreads</tt> threads while the
+ * consumer processes the previous batches.  At most <tt>options.numSlots</tt> blocks are held in memory, a slow
+ * consumer stalls the other stages.  There is one batch per BGZF block, a record belongs to the block it ends in.
+ *
+ * The consumer is never called concurrently but may be called from any thread of the team.  It may modify or swap
+ * the records.  If <tt>options.keepOrder</tt> is false, the batches are passed as soon as they are parsed.
+ *
+ * SAM files in a @link BamStream @endlink are read serially with batches of 1024 records.
+ */
+
+/**
+.Function.readRecordBatches
+..class:Class.BamStream
+..cat:BAM I/O
+..summary:Read all remaining records in parallel and pass them in batches to a consumer.
+..signature:readRecordBatches(consumer, context, stream[, options])
+..signature:readRecordBatches(consumer, bamIO[, options])
+..param.consumer:Functor that is called as $consumer(records)$ with a $String<BamAlignmentRecord>$ of the records
+of one batch.
+..param.context:The context for translating reference ids.
+...type:Class.BamIOContext
+..param.stream:The BGZF stream to read from, positioned behind the header.
+...type:Spec.BGZF Stream
+..param.bamIO:The stream to read from.
+...type:Class.BamStream
+..param.options:The options to use.
+...type:Class.BamParallelReadOptions
+..returns:An $int$ status code, $0$ on success, non-$0$ on failure.
+..remarks:The BGZF blocks are decompressed and their records are parsed on $options.numThreads$ threads while the
+consumer processes the previous batches.
+At most $options.numSlots$ blocks are held in memory, a slow consumer stalls the other stages.
+There is one batch per BGZF block, a record belongs to the block it ends in.
+..remarks:The consumer is never called concurrently but may be called from any thread of the team.
+It may modify or swap the records.
+If $options.keepOrder$ is false, the batches are passed as soon as they are parsed.
+..remarks:SAM files in a @Class.BamStream@ are read serially with batches of 1024 records.
+..include:seqan/bam_io.h
+*/
+
+template <typename TConsumer, typename TNameStore, typename TNameStoreCache>
+inline int
+readRecordBatches(TConsumer & consumer,
+                  BamIOContext<TNameStore, TNameStoreCache> const & context,
+                  Stream<Bgzf> & stream,
+                  BamParallelReadOptions const & options)
+{
+    typedef BamPipeline_<TNameStore, TNameStoreCache> TPipeline;
+    unsigned const MAX_BLOCK_SIZE = 64 * 1024;
+
+    unsigned numThreads = std::max(options.numThreads, 1u);
+    unsigned numSlots = (options.numSlots == 0u) ? 4 * numThreads : options.numSlots;
+
+    TPipeline pipe(stream, context, options.keepOrder);
+    resize(pipe.slots, numSlots);
+    for (unsigned i = 0; i < numSlots; ++i)
+    {
+        resize(pipe.slots[i].compressed, MAX_BLOCK_SIZE);
+        resize(pipe.slots[i].uncompressed, MAX_BLOCK_SIZE);
+    }
+
+    // The rest of the current block (behind the header) is the beginning of the first block.  The file is positioned
+    // behind the current block, also if it was loaded from the cache or the read-ahead batch.
+    if (stream._blockOffset < stream._blockLength)
+        assign(pipe.carry, infix(stream._uncompressedBlock, stream._blockOffset, stream._blockLength));
+
+    SEQAN_OMP_PRAGMA(parallel num_threads(numThreads))
+    {
+        while (!pipe.error && !(pipe.eofSeq >= 0 && pipe.numFinished == pipe.eofSeq))
+        {
+            // Prefer the later stages, they free the slots.
+            if (!_bamPipelineConsume(pipe, consumer) &&
+                !_bamPipelineParse(pipe) &&
+                !_bamPipelineSplit(pipe) &&
+                !_bamPipelineInflate(pipe) &&
+                !_bamPipelineRead(pipe))
+                _workStealingYield();
+        }
+    }
+
+    // Everything is read, mark the current block as consumed.
+    stream._blockPosition = tell(stream._file);
+    stream._blockOffset = 0;
+    stream._blockLength = 0;
+
+    if (pipe.error)
+        return 1;
+    return empty(pipe.carry) ? 0 : 1;  // The last record is truncated otherwise.
+}
+
+template <typename TConsumer, typename TNameStore, typename TNameStoreCache>
+inline int
+readRecordBatches(TConsumer & consumer,
+                  BamIOContext<TNameStore, TNameStoreCache> const & context,
+                  Stream<Bgzf> & stream)
+{
+    return readRecordBatches(consumer, context, stream, BamParallelReadOptions());
+}
+
+template <typename TConsumer>
+inline int
+readRecordBatches(TConsumer & consumer, BamStream & bamIO, BamParallelReadOptions const & options)
+{
+    if (bamIO._mode != BamStream::READ)
+        return 1;
+
+    int res = 0;
+    if (bamIO._format == BamStream::BAM)
+    {
+        BamReader_ * s = static_cast<BamReader_ *>(bamIO._reader.get());
+        res = readRecordBatches(consumer, bamIO.bamIOContext, s->_stream, options);
+    }
+    else
+    {
+        String<BamAlignmentRecord> records;
+        while (res == 0 && !atEnd(bamIO))
+        {
+            resize(records, 1024);
+            unsigned i = 0;
+            for (; i < length(records) && !atEnd(bamIO); ++i)
+                if ((res = readRecord(records[i], bamIO)) != 0)
+                    break;
+            resize(records, i);
+            if (res == 0 && !empty(records))
+                consumer(records);
+        }
+    }
+
+    bamIO._isGood = bamIO._isGood && (res == 0);
+    return res;
+}
+
+template <typename TConsumer>
+inline int
+readRecordBatches(TConsumer & consumer, BamStream & bamIO)
+{
+    return readRecordBatches(consumer, bamIO, BamParallelReadOptions());
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef CORE_INCLUDE_SEQAN_BAM_IO_READ_BAM_PARALLEL_H_
@@ -162,8 +162,10 @@ struct Tuple<TValue, SIZE, Pack>
         return i[k];
     }
 
+    // Return by value, a const reference to a member of a packed struct would
+    // be bound to a temporary copy and dangle after returning.
     template <typename TPos>
-    inline typename StoredTupleValue_<TValue>::Type const &
+    inline typename StoredTupleValue_<TValue>::Type
     operator[](TPos k) const
     {
         SEQAN_ASSERT_GEQ(static_cast<__int64>(k), 0);
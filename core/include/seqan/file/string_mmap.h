@@ -186,6 +186,15 @@ See the @Memfunc.External String#String@ constructor for more details.
 			open(*this, fileName, openMode);
         }
 
+        // The copy is stored in its own temporary file, the mapping of the source must not be shared.
+        String(String const & source):
+			data_begin(NULL),
+			data_end(NULL),
+			advise(source.advise)
+        {
+			assign(*this, source);
+        }
+
 		template <typename TSource>
 		String & operator =(TSource const & source)
 		{
@@ -0,0 +1,516 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Author: agent <agent@local>
+// ==========================================================================
+// Approximate search of many short needles with Myers' bit-vector algorithm.
+// Several needles share one 64 bit word, each needle occupies a lane of
+// length(needle) bits.  The score of every needle is kept in a packed
+// counter that lives in the lane of the next needle (or in the unused bits
+// above the last lane).
+// ==========================================================================
+
+#ifndef SEQAN_HEADER_FIND_MULTIPLE_MYERS_H
+#define SEQAN_HEADER_FIND_MULTIPLE_MYERS_H
+
+namespace SEQAN_NAMESPACE_MAIN
+{
+
+//////////////////////////////////////////////////////////////////////////////
+// Multiple Myers
+//////////////////////////////////////////////////////////////////////////////
+
+/*!
+ * @class MultipleMyersPattern
+ * @extends Pattern
+ * @headerfile <seqan/find.h>
+ * @brief Approximate search of many short needles using packed bit-parallel Myers.
+ *
+ * @signature template <typename TNeedle>
+ *            class Pattern<TNeedle, MultipleMyers>;
+ *
+ * @tparam TNeedle The needle type, a string of keywords. Types: StringSet
+ *
+ * @section Remarks
+ *
+ * Needles are packed into the lanes of 64 bit words (at most 56 bits per word) and all of them are
+ * searched with edit distance in a single scan of the haystack.  Every keyword must have a length
+ * between 8 and 56.  Each call of @link find @endlink reports one keyword that ends at the current
+ * haystack position with at most <tt>-minScore</tt> errors, @link MultipleMyersPattern#position @endlink
+ * returns the keyword index and @link MultipleMyersPattern#getScore @endlink its score.
+ *
+ * The words are stored in structure-of-arrays layout and updated with branch-free code such that
+ * the compiler can vectorize the update of consecutive words.
+ */
+
+/**
+.Spec.MultipleMyers:
+..summary: Approximate search of many short needles using packed bit-parallel Myers.
+..general:Class.Pattern
+..cat:Searching
+..signature:Pattern<TNeedle, MultipleMyers>
+..param.TNeedle:The needle type, a string of keywords.
+...type:Class.StringSet
+..remarks.text:Needles are packed into the lanes of 64 bit words (at most 56 bits per word) and all of them are
+searched with edit distance in a single scan of the haystack.
+Every keyword must have a length between 8 and 56.
+Each call of @Function.find@ reports one keyword that ends at the current haystack position
+with at most $-minScore$ errors, @Function.position@ returns the keyword index and @Function.getScore@ its score.
+..remarks.text:The words are stored in structure-of-arrays layout and updated with branch-free code such that
+the compiler can vectorize the update of consecutive words.
+..include:seqan/find.h
+*/
+
+///.Class.Pattern.param.TSpec.type:Spec.MultipleMyers
+
+struct MultipleMyers_;
+typedef Tag<MultipleMyers_> MultipleMyers;
+
+//////////////////////////////////////////////////////////////////////////////
+
+template <typename TNeedle>
+class Pattern<TNeedle, MultipleMyers> {
+//____________________________________________________________________________
+public:
+	typedef __uint64 TWord;
+	typedef typename Size<TNeedle>::Type TSize;
+
+	enum { MACHINE_WORD_SIZE = 64, MAX_LANE_BITS = 56, MIN_KEYWORD_LENGTH = 8 };
+
+	Holder<TNeedle> data_host;
+
+	unsigned wordCount;					// number of packed words
+	unsigned alphabetSize;
+
+	String<TWord> bitMasks;				// alphabetSize * wordCount, character-major
+	String<TWord> laneTop;				// highest bit of every lane
+	String<TWord> laneLow;				// lowest bit of every lane
+	String<TWord> counterTop;			// highest bit of every score counter
+	String<TWord> counterInit;			// initial counter values (depend on maxErrors)
+	String<unsigned> firstKeyword;		// index of the first keyword in each word
+
+	String<unsigned char> counterShift;	// per keyword: position of its counter
+	String<unsigned char> counterWidth;	// per keyword: width of its counter
+
+	String<TWord> VP, VN, C, matches;	// search state, one entry per word
+
+	unsigned maxErrors;
+	unsigned curWord;					// next word to report matches from
+	TWord curMatches;					// pending matches of word curWord-1
+	TSize data_keywordIndex;
+	int data_score;
+
+//____________________________________________________________________________
+
+	Pattern():
+		wordCount(0),
+		alphabetSize(0),
+		maxErrors(0),
+		curWord(0),
+		curMatches(0),
+		data_keywordIndex(0),
+		data_score(0)
+	{}
+
+	template <typename TNeedle2>
+	Pattern(TNeedle2 const & ndl, int _limit = -1):
+		wordCount(0),
+		alphabetSize(0),
+		maxErrors(-_limit),
+		curWord(0),
+		curMatches(0),
+		data_keywordIndex(0),
+		data_score(0)
+	{
+		setHost(*this, ndl);
+	}
+//____________________________________________________________________________
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// Host Metafunctions
+//////////////////////////////////////////////////////////////////////////////
+
+template <typename TNeedle>
+struct Host< Pattern<TNeedle, MultipleMyers> >
+{
+	typedef TNeedle Type;
+};
+
+template <typename TNeedle>
+struct Host< Pattern<TNeedle, MultipleMyers> const>
+{
+	typedef TNeedle const Type;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// Functions
+//////////////////////////////////////////////////////////////////////////////
+
+template <typename TNeedle, typename TNeedle2>
+void setHost (Pattern<TNeedle, MultipleMyers> & me, TNeedle2 const & needle)
+{
+	typedef Pattern<TNeedle, MultipleMyers> TPattern;
+	typedef typename TPattern::TWord TWord;
+	typedef typename Value<TNeedle>::Type TKeyword;
+	typedef typename Value<TKeyword>::Type TAlphabet;
+	typedef typename Iterator<TNeedle2 const, Standard>::Type TIter;
+
+	me.alphabetSize = ValueSize<TAlphabet>::VALUE;
+
+	// greedily distribute the keywords to words
+	unsigned keywordCount = length(needle);
+	String<unsigned> laneBegin;
+	resize(laneBegin, keywordCount, Exact());
+	clear(me.firstKeyword);
+
+	unsigned bits = TPattern::MAX_LANE_BITS;
+	TIter it = begin(needle, Standard());
+	for (unsigned j = 0; j < keywordCount; ++j, ++it)
+	{
+		unsigned len = length(*it);
+		SEQAN_ASSERT_GEQ_MSG(len, (unsigned)TPattern::MIN_KEYWORD_LENGTH, "Keyword is too short for MultipleMyers.");
+		SEQAN_ASSERT_LEQ_MSG(len, (unsigned)TPattern::MAX_LANE_BITS, "Keyword is too long for MultipleMyers.");
+		if (bits + len > (unsigned)TPattern::MAX_LANE_BITS)
+		{
+			appendValue(me.firstKeyword, j);
+			bits = 0;
+		}
+		laneBegin[j] = bits;
+		bits += len;
+	}
+	me.wordCount = length(me.firstKeyword);
+	appendValue(me.firstKeyword, keywordCount);
+
+	clear(me.bitMasks);
+	resize(me.bitMasks, me.alphabetSize * me.wordCount, 0, Exact());
+	resize(me.laneTop, me.wordCount, Exact());
+	resize(me.laneLow, me.wordCount, Exact());
+	resize(me.counterTop, me.wordCount, Exact());
+	resize(me.counterShift, keywordCount, Exact());
+	resize(me.counterWidth, keywordCount, Exact());
+
+	it = begin(needle, Standard());
+	for (unsigned w = 0; w < me.wordCount; ++w)
+	{
+		TWord top = 0, low = 0, ctop = (TWord)1 << (TPattern::MACHINE_WORD_SIZE - 1);
+		for (unsigned j = me.firstKeyword[w]; j < me.firstKeyword[w + 1]; ++j, ++it)
+		{
+			unsigned len = length(*it);
+			unsigned lane = laneBegin[j];
+			for (unsigned i = 0; i < len; ++i)
+				me.bitMasks[me.wordCount * ordValue(convert<TAlphabet>(getValue(*it, i))) + w] |= (TWord)1 << (lane + i);
+			low |= (TWord)1 << lane;
+			top |= (TWord)1 << (lane + len - 1);
+
+			// the counter of keyword j occupies the next lane or the unused high bits
+			me.counterShift[j] = lane + len;
+			if (j + 1 < me.firstKeyword[w + 1])
+			{
+				me.counterWidth[j] = length(*(it + 1));
+				ctop |= (TWord)1 << (lane + len + length(*(it + 1)) - 1);
+			}
+			else
+				me.counterWidth[j] = TPattern::MACHINE_WORD_SIZE - (lane + len);
+		}
+		me.laneTop[w] = top;
+		me.laneLow[w] = low;
+		me.counterTop[w] = ctop;
+	}
+	setValue(me.data_host, needle);
+}
+
+template <typename TNeedle, typename TNeedle2>
+void setHost (Pattern<TNeedle, MultipleMyers> & me, TNeedle2 & needle)
+{
+	setHost(me, reinterpret_cast<TNeedle2 const &>(needle));
+}
+
+//____________________________________________________________________________
+
+template <typename TNeedle>
+inline void _patternInit (Pattern<TNeedle, MultipleMyers> & me)
+{
+	typedef typename Pattern<TNeedle, MultipleMyers>::TWord TWord;
+	typedef typename Iterator<TNeedle const, Standard>::Type TIter;
+
+	SEQAN_ASSERT_LT_MSG(me.maxErrors, 128u, "Too many errors for MultipleMyers.");
+
+	// counter of keyword j starts with 2^(width-1) - (maxErrors + 1) + length(keyword),
+	// its highest bit is unset iff the keyword has at most maxErrors errors
+	resize(me.counterInit, me.wordCount, Exact());
+	TIter it = begin(host(me), Standard());
+	for (unsigned w = 0; w < me.wordCount; ++w)
+	{
+		TWord init = 0;
+		for (unsigned j = me.firstKeyword[w]; j < me.firstKeyword[w + 1]; ++j, ++it)
+		{
+			TWord offset = ((TWord)1 << (me.counterWidth[j] - 1)) - (me.maxErrors + 1);
+			init += (offset + length(*it)) << me.counterShift[j];
+		}
+		me.counterInit[w] = init;
+	}
+
+	resize(me.VP, me.wordCount, Exact());
+	resize(me.VN, me.wordCount, Exact());
+	resize(me.C, me.wordCount, Exact());
+	resize(me.matches, me.wordCount, Exact());
+	for (unsigned w = 0; w < me.wordCount; ++w)
+	{
+		me.VP[w] = ~(TWord)0;
+		me.VN[w] = 0;
+		me.C[w] = me.counterInit[w];
+	}
+	me.curWord = me.wordCount;
+	me.curMatches = 0;
+}
+
+//____________________________________________________________________________
+
+template <typename TNeedle>
+inline typename Host<Pattern<TNeedle, MultipleMyers>const>::Type &
+host(Pattern<TNeedle, MultipleMyers> & me)
+{
+	return value(me.data_host);
+}
+
+template <typename TNeedle>
+inline typename Host<Pattern<TNeedle, MultipleMyers>const>::Type &
+host(Pattern<TNeedle, MultipleMyers> const & me)
+{
+	return value(me.data_host);
+}
+
+//____________________________________________________________________________
+
+/*!
+ * @fn MultipleMyersPattern#position
+ * @brief Returns the index of the keyword found last.
+ *
+ * @signature TSize position(pattern);
+ *
+ * @param[in] pattern The MultipleMyersPattern to query.
+ *
+ * @return TSize The index of the last found keyword in the needle.
+ */
+
+template <typename TNeedle>
+inline typename Size<TNeedle>::Type
+position(Pattern<TNeedle, MultipleMyers> & me)
+{
+	return me.data_keywordIndex;
+}
+
+//____________________________________________________________________________
+
+/*!
+ * @fn MultipleMyersPattern#scoreLimit
+ * @brief Returns the minimal score a match must have.
+ *
+ * @signature int scoreLimit(pattern);
+ *
+ * @param[in] pattern The MultipleMyersPattern to query.
+ *
+ * @return int The score limit, i.e. the negated number of allowed errors.
+ */
+
+///.Function.scoreLimit.param.pattern.type:Spec.MultipleMyers
+///.Function.scoreLimit.class:Spec.MultipleMyers
+
+template <typename TNeedle>
+inline int
+scoreLimit(Pattern<TNeedle, MultipleMyers> const & me)
+{
+	return - (int) me.maxErrors;
+}
+
+/*!
+ * @fn MultipleMyersPattern#setScoreLimit
+ * @brief Sets the minimal score a match must have.
+ *
+ * @signature void setScoreLimit(pattern, limit);
+ *
+ * @param[in,out] pattern The MultipleMyersPattern to modify.
+ * @param[in]     limit   The score limit, i.e. the negated number of allowed errors.
+ *
+ * The new limit takes effect with the next search, i.e. after the finder was cleared.
+ */
+
+///.Function.setScoreLimit.param.pattern.type:Spec.MultipleMyers
+///.Function.setScoreLimit.class:Spec.MultipleMyers
+
+template <typename TNeedle, typename TScoreValue>
+inline void
+setScoreLimit(Pattern<TNeedle, MultipleMyers> & me, TScoreValue _limit)
+{
+	me.maxErrors = -_limit;
+}
+
+/*!
+ * @fn MultipleMyersPattern#getScore
+ * @brief Returns the score of the keyword found last.
+ *
+ * @signature int getScore(pattern);
+ *
+ * @param[in] pattern The MultipleMyersPattern to query.
+ *
+ * @return int The negated edit distance of the last found keyword.
+ */
+
+///.Function.getScore.param.pattern.type:Spec.MultipleMyers
+///.Function.getScore.class:Spec.MultipleMyers
+
+template <typename TNeedle>
+inline int
+getScore(Pattern<TNeedle, MultipleMyers> const & me)
+{
+	return me.data_score;
+}
+
+//____________________________________________________________________________
+// One text character, returns true if any keyword ends here.
+
+template <typename TNeedle>
+inline bool
+_multipleMyersStep(Pattern<TNeedle, MultipleMyers> & me, unsigned ord)
+{
+	typedef typename Pattern<TNeedle, MultipleMyers>::TWord TWord;
+
+	TWord const * eqs = begin(me.bitMasks, Standard()) + me.wordCount * ord;
+	TWord const * tops = begin(me.laneTop, Standard());
+	TWord const * lows = begin(me.laneLow, Standard());
+	TWord const * ctops = begin(me.counterTop, Standard());
+	TWord * vps = begin(me.VP, Standard());
+	TWord * vns = begin(me.VN, Standard());
+	TWord * cs = begin(me.C, Standard());
+	TWord * ms = begin(me.matches, Standard());
+	TWord any = 0;
+
+	for (unsigned w = 0; w < me.wordCount; ++w)
+	{
+		TWord VP = vps[w];
+		TWord VN = vns[w];
+		TWord X = eqs[w] | VN;
+		TWord Y = X & VP;
+
+		// lane-wise VP + Y, no carry crosses a lane border
+		TWord sum = ((VP & ~tops[w]) + (Y & ~tops[w])) ^ ((VP ^ Y) & tops[w]);
+		TWord D0 = (sum ^ VP) | X;
+		TWord HN = VP & D0;
+		TWord HP = VN | ~(VP | D0);
+
+		// shifted-in bits are 0 for infix search
+		X = (HP << 1) & ~lows[w];
+		vns[w] = X & D0;
+		vps[w] = ((HN << 1) & ~lows[w]) | ~(X | D0);
+
+		// each counter sits directly above the highest bit of its lane
+		TWord c = cs[w] + ((HP & tops[w]) << 1) - ((HN & tops[w]) << 1);
+		cs[w] = c;
+		ms[w] = ~c & ctops[w];
+		any |= ms[w];
+	}
+	return any != 0;
+}
+
+// Reports the next pending match, returns false if there is none.
+template <typename TNeedle>
+inline bool
+_multipleMyersNextMatch(Pattern<TNeedle, MultipleMyers> & me)
+{
+	typedef typename Pattern<TNeedle, MultipleMyers>::TWord TWord;
+
+	while (me.curMatches == 0)
+	{
+		if (me.curWord == me.wordCount)
+			return false;
+		me.curMatches = me.matches[me.curWord++];
+	}
+
+	unsigned w = me.curWord - 1;
+	TWord bit = me.curMatches & (~me.curMatches + 1);
+	me.curMatches ^= bit;
+
+	// the i-th counter top in the word belongs to the i-th keyword
+	unsigned j = me.firstKeyword[w] + popCount(me.counterTop[w] & (bit - 1));
+	unsigned width = me.counterWidth[j];
+	TWord mask = ((TWord)1 << width) - 1;
+	TWord offset = ((TWord)1 << (width - 1)) - (me.maxErrors + 1);
+	me.data_keywordIndex = j;
+	me.data_score = - (int)(((me.C[w] >> me.counterShift[j]) & mask) - offset);
+	return true;
+}
+
+//____________________________________________________________________________
+
+template <typename TFinder, typename TNeedle>
+inline bool find(TFinder & finder, Pattern<TNeedle, MultipleMyers> & me)
+{
+	typedef typename Value<typename Value<TNeedle>::Type>::Type TAlphabet;
+
+	if (empty(finder))
+	{
+		_patternInit(me);
+		_finderSetNonEmpty(finder);
+	}
+	else
+	{
+		if (_multipleMyersNextMatch(me))
+			return true;
+		if (atEnd(finder))
+			return false;
+		goNext(finder);
+	}
+
+	for (; !atEnd(finder); goNext(finder))
+	{
+		if (_multipleMyersStep(me, ordValue(convert<TAlphabet>(*finder))))
+		{
+			me.curWord = 0;
+			me.curMatches = 0;
+			_multipleMyersNextMatch(me);
+			_setFinderEnd(finder);
+			return true;
+		}
+	}
+	return false;
+}
+
+template <typename TFinder, typename TNeedle>
+inline bool find(TFinder & finder, Pattern<TNeedle, MultipleMyers> & me, int const minScore)
+{
+	setScoreLimit(me, minScore);
+	return find(finder, me);
+}
+
+}// namespace SEQAN_NAMESPACE_MAIN
+
+#endif //#ifndef SEQAN_HEADER_FIND_MULTIPLE_MYERS_H
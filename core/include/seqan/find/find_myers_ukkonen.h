@@ -36,6 +36,7 @@
 #define SEQAN_HEADER_FIND_MYERS_UKKONEN_H
 
 #include <seqan/misc/misc_sse2.h>
+#include <seqan/find/find_myers_ukkonen_simd.h>
 
 namespace SEQAN_NAMESPACE_MAIN 
 {
@@ -1365,7 +1366,12 @@ SEQAN_CHECKPOINT
 		shift = largePattern.blockCount * ordValue((typename Value< TNeedle >::Type) *finder);
 
 		// computing the necessary blocks, carries between blocks following one another are stored
-		for (currentBlock = 0; currentBlock <= limit; currentBlock++) 
+		// (whole SIMD vectors of blocks first, the remaining blocks in the scalar loop)
+		currentBlock = _myersLargeBlocksSimd(begin(largeState.VP, Standard()), begin(largeState.VN, Standard()),
+		                                     begin(pattern.bitMasks, Standard()) + shift, limit + 1,
+		                                     largeState.lastBlock, largeState.scoreMask,
+		                                     carryD0, carryHP, carryHN, state.errors);
+		for (; currentBlock <= limit; currentBlock++) 
 		{
 			X = pattern.bitMasks[shift + currentBlock] | largeState.VN[currentBlock];
 	
@@ -0,0 +1,281 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Author: agent <agent@local>
+// ==========================================================================
+// Vectorized column update of Myers' bit-vector algorithm for needles longer
+// than one machine word.  A SIMD vector holds 2 (SSE2) or 4 (AVX2)
+// consecutive 64 bit blocks of a column, i.e. it is treated as one 128 or
+// 256 bit word.  The carries of the addition and of the shifts are
+// propagated between the lanes with a few scalar mask operations, so the
+// result is identical to the scalar block loop.
+//
+// The vector code is used if SEQAN_MYERS_SIMD is non-zero, which is the
+// default if the compiler targets SSE2 or AVX2.  Define SEQAN_MYERS_SIMD to 0
+// to always use the scalar loop.
+// ==========================================================================
+
+#ifndef SEQAN_HEADER_FIND_MYERS_UKKONEN_SIMD_H
+#define SEQAN_HEADER_FIND_MYERS_UKKONEN_SIMD_H
+
+#ifndef SEQAN_MYERS_SIMD
+#if defined(__AVX2__) || (defined(__SSE2__) && (defined(__x86_64__) || defined(_M_X64)))
+#define SEQAN_MYERS_SIMD 1
+#else
+#define SEQAN_MYERS_SIMD 0
+#endif
+#endif
+
+#if SEQAN_MYERS_SIMD
+#if defined(__AVX2__)
+#include <immintrin.h>
+#else
+#include <emmintrin.h>
+#endif
+#endif
+
+namespace seqan {
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Class MyersSimdTraits_
+// ----------------------------------------------------------------------------
+
+// Thin wrapper around the intrinsics of 64 bit lanes.  topBits() and allOnes()
+// return a bit mask with one bit per lane, fromMask() converts such a mask
+// back into lanes of 0 or 1.  shiftInLanes() moves every lane to the next
+// higher lane and fills the lowest lane with the given word.
+
+#if SEQAN_MYERS_SIMD
+
+#if defined(__AVX2__)
+
+struct MyersSimdTraits_
+{
+    typedef __m256i TVector;
+    enum { LANES = 4 };
+
+    static inline TVector load(void const * ptr)
+    {
+        return _mm256_loadu_si256(reinterpret_cast<TVector const *>(ptr));
+    }
+
+    static inline void store(void * ptr, TVector const & vec)
+    {
+        _mm256_storeu_si256(reinterpret_cast<TVector *>(ptr), vec);
+    }
+
+    static inline TVector bitAnd(TVector const & a, TVector const & b) { return _mm256_and_si256(a, b); }
+    static inline TVector bitOr(TVector const & a, TVector const & b) { return _mm256_or_si256(a, b); }
+    static inline TVector bitXor(TVector const & a, TVector const & b) { return _mm256_xor_si256(a, b); }
+    static inline TVector bitNot(TVector const & a) { return _mm256_xor_si256(a, _mm256_set1_epi32(-1)); }
+    static inline TVector add(TVector const & a, TVector const & b) { return _mm256_add_epi64(a, b); }
+    static inline TVector shl1(TVector const & a) { return _mm256_slli_epi64(a, 1); }
+    static inline TVector shr63(TVector const & a) { return _mm256_srli_epi64(a, 63); }
+
+    static inline unsigned topBits(TVector const & a)
+    {
+        return _mm256_movemask_pd(_mm256_castsi256_pd(a));
+    }
+
+    static inline unsigned allOnes(TVector const & a)
+    {
+        return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(a, _mm256_set1_epi32(-1))));
+    }
+
+    static inline TVector fromMask(unsigned mask)
+    {
+        return _mm256_and_si256(_mm256_srlv_epi64(_mm256_set1_epi64x(mask), _mm256_set_epi64x(3, 2, 1, 0)),
+                                _mm256_set1_epi64x(1));
+    }
+
+    static inline TVector shiftInLanes(TVector const & a, __uint64 word)
+    {
+        return _mm256_blend_epi32(_mm256_permute4x64_epi64(a, 0x93), _mm256_set_epi64x(0, 0, 0, word), 0x03);
+    }
+};
+
+#else  // #if defined(__AVX2__)
+
+struct MyersSimdTraits_
+{
+    typedef __m128i TVector;
+    enum { LANES = 2 };
+
+    static inline TVector load(void const * ptr)
+    {
+        return _mm_loadu_si128(reinterpret_cast<TVector const *>(ptr));
+    }
+
+    static inline void store(void * ptr, TVector const & vec)
+    {
+        _mm_storeu_si128(reinterpret_cast<TVector *>(ptr), vec);
+    }
+
+    static inline TVector bitAnd(TVector const & a, TVector const & b) { return _mm_and_si128(a, b); }
+    static inline TVector bitOr(TVector const & a, TVector const & b) { return _mm_or_si128(a, b); }
+    static inline TVector bitXor(TVector const & a, TVector const & b) { return _mm_xor_si128(a, b); }
+    static inline TVector bitNot(TVector const & a) { return _mm_xor_si128(a, _mm_set1_epi32(-1)); }
+    static inline TVector add(TVector const & a, TVector const & b) { return _mm_add_epi64(a, b); }
+    static inline TVector shl1(TVector const & a) { return _mm_slli_epi64(a, 1); }
+    static inline TVector shr63(TVector const & a) { return _mm_srli_epi64(a, 63); }
+
+    static inline unsigned topBits(TVector const & a)
+    {
+        return _mm_movemask_pd(_mm_castsi128_pd(a));
+    }
+
+    static inline unsigned allOnes(TVector const & a)
+    {
+        // SSE2 has no 64 bit comparison, combine the results of the 32 bit halves
+        unsigned m = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, _mm_set1_epi32(-1))));
+        m &= m >> 1;
+        return (m & 1) | ((m >> 1) & 2);
+    }
+
+    static inline TVector fromMask(unsigned mask)
+    {
+        return _mm_set_epi64x((mask >> 1) & 1, mask & 1);
+    }
+
+    static inline TVector shiftInLanes(TVector const & a, __uint64 word)
+    {
+        return _mm_or_si128(_mm_slli_si128(a, 8), _mm_set_epi64x(0, word));
+    }
+};
+
+#endif  // #if defined(__AVX2__)
+
+#endif  // #if SEQAN_MYERS_SIMD
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function _myersLargeBlocksSimd()
+// ----------------------------------------------------------------------------
+
+// Computes the first blocks of a column of the large-pattern Myers and returns
+// the number of blocks computed.  The remaining blocks (less than one vector)
+// are left to the scalar loop, which continues with the returned carries.  If
+// the last active cell lies in a computed block, the errors are updated.
+// This generic version computes nothing and is used for word types that are
+// not 64 bit integers.
+
+template <typename TWord, typename TErrors>
+inline unsigned
+_myersLargeBlocksSimd(TWord *, TWord *, TWord const *, unsigned, unsigned, TWord,
+                      TWord &, TWord &, TWord &, TErrors &)
+{
+    return 0;
+}
+
+#if SEQAN_MYERS_SIMD
+
+template <typename TErrors>
+inline unsigned
+_myersLargeBlocksSimd(unsigned long * VP,
+                      unsigned long * VN,
+                      unsigned long const * bitMasks,
+                      unsigned blockCount,
+                      unsigned lastBlock,
+                      unsigned long scoreMask,
+                      unsigned long & carryD0,
+                      unsigned long & carryHP,
+                      unsigned long & carryHN,
+                      TErrors & errors)
+{
+    typedef MyersSimdTraits_ TTraits;
+    typedef TTraits::TVector TVector;
+
+    if (BitsPerValue<unsigned long>::VALUE != 64)
+        return 0;
+
+    unsigned const LANES = TTraits::LANES;
+    unsigned const laneMask = (1u << LANES) - 1;
+    unsigned block = 0;
+
+    for (; block + LANES <= blockCount; block += LANES)
+    {
+        TVector vp = TTraits::load(VP + block);
+        TVector vn = TTraits::load(VN + block);
+        TVector X = TTraits::bitOr(TTraits::load(bitMasks + block), vn);
+        TVector Y = TTraits::bitAnd(X, vp);
+
+        // vp + Y over the whole vector: add the lanes, then add the carries
+        // generated (G) or propagated (P) by the lower lanes
+        TVector sum = TTraits::add(vp, Y);
+        unsigned G = TTraits::topBits(TTraits::bitOr(TTraits::bitAnd(vp, Y),
+                                                     TTraits::bitAnd(TTraits::bitOr(vp, Y), TTraits::bitNot(sum))));
+        unsigned P = TTraits::allOnes(sum);
+        unsigned carries = (((G << 1) | (unsigned)carryD0) + P) ^ P;
+        sum = TTraits::add(sum, TTraits::fromMask(carries & laneMask));
+        carryD0 = carries >> LANES;
+
+        TVector D0 = TTraits::bitOr(TTraits::bitXor(sum, vp), X);
+        TVector HN = TTraits::bitAnd(vp, D0);
+        TVector HP = TTraits::bitOr(vn, TTraits::bitNot(TTraits::bitOr(vp, D0)));
+
+        X = TTraits::bitOr(TTraits::shl1(HP), TTraits::shr63(TTraits::shiftInLanes(HP, (__uint64)carryHP << 63)));
+        carryHP = (TTraits::topBits(HP) >> (LANES - 1)) & 1;
+        vn = TTraits::bitAnd(X, D0);
+
+        vp = TTraits::bitOr(TTraits::shl1(HN), TTraits::shr63(TTraits::shiftInLanes(HN, (__uint64)carryHN << 63)));
+        carryHN = (TTraits::topBits(HN) >> (LANES - 1)) & 1;
+        vp = TTraits::bitOr(vp, TTraits::bitNot(TTraits::bitOr(X, D0)));
+
+        TTraits::store(VP + block, vp);
+        TTraits::store(VN + block, vn);
+
+        // the block containing the last active cell updates the errors
+        if (lastBlock - block < LANES)
+        {
+            unsigned long hp[LANES], hn[LANES];
+            TTraits::store(hp, HP);
+            TTraits::store(hn, HN);
+            if ((hp[lastBlock - block] & scoreMask) != 0ul)
+                errors++;
+            else if ((hn[lastBlock - block] & scoreMask) != 0ul)
+                errors--;
+        }
+    }
+    return block;
+}
+
+#endif  // #if SEQAN_MYERS_SIMD
+
+}  // namespace seqan
+
+#endif  // #ifndef SEQAN_HEADER_FIND_MYERS_UKKONEN_SIMD_H
@@ -79,6 +79,8 @@
 #include <seqan/index/shape_threshold.h>
 #include <seqan/index/index_qgram.h>
 #include <seqan/index/index_qgram_openaddressing.h>
+#include <seqan/index/index_qgram_parallel.h>
+#include <seqan/index/index_qgram_minimizer.h>
 //#include <seqan/index/index_qgram_nested.h>
 
 //____________________________________________________________________________
@@ -101,6 +103,7 @@
 
 #include <seqan/index/pump_separator7.h>
 #include <seqan/index/index_skew7_multi.h>
+#include <seqan/index/index_skew7_parallel.h>
 
 //____________________________________________________________________________
 // enhanced table creators
@@ -175,9 +178,11 @@
 // #include <seqan/index/index_fm_wavelet_tree.h>
 #include <seqan/index/index_fm_rank_dictionary_wt.h>
 #include <seqan/index/index_fm_rank_dictionary_bms.h>
+#include <seqan/index/index_fm_rank_dictionary_ibm.h>
 #include <seqan/index/index_fm_sentinel_rank_dictionary.h>
 #include <seqan/index/index_fm_lf_table.h>
 #include <seqan/index/index_fm.h>
 #include <seqan/index/index_fm_stree.h>
+#include <seqan/index/index_fm_bidirectional.h>
 
 #endif //#ifndef SEQAN_HEADER_...
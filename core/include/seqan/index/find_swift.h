@@ -2264,6 +2264,189 @@ getMaxDeviationOfOrder(Pattern<TIndex, Swift<TSpec> > &pattern)
 }
 
 
+//////////////////////////////////////////////////////////////////////////////
+// Partitioned filtration
+//
+// The haystack is cut into windows, every window is filtered by a private copy
+// of finder and pattern (and thus private buckets).  A window scan starts and
+// ends with a margin of two parallelogram spans and keeps only the hits whose
+// parallelogram begins in the window.  As the bucket grid is fixed by absolute
+// haystack positions, the union of the kept hits equals the hits of a serial scan.
+
+// scan the q-grams beginning in [beginPos, endPos) outside repeats and flush the buckets
+template <typename THaystack, typename TIndex, typename TSpec, typename TPos>
+inline void
+_swiftScanRange(
+    Finder<THaystack, Swift<TSpec> > &finder,
+    Pattern<TIndex, Swift<TSpec> > &pattern,
+    TPos beginPos,
+    TPos endPos)
+{
+    typedef typename Fibre<TIndex, QGramShape>::Type    TShape;
+    typedef Finder<THaystack, Swift<TSpec> >            TFinder;
+    typedef typename TFinder::THstkPos                  THstkPos;
+
+    TShape &shape = pattern.shape;
+    clear(finder.hits);
+
+    if (_firstNonRepeatRange(finder, pattern))
+    {
+        do
+        {
+            THstkPos localBegin = _max(finder.startPos, (THstkPos)beginPos);
+            THstkPos localEnd = _min((THstkPos)(finder.endPos - length(shape) + 1), (THstkPos)endPos);
+
+            // filter the part of a non-repeat region within the scan range
+            if (localBegin < localEnd)
+            {
+                finder.curPos = localBegin;
+                hostIterator(finder) = begin(host(finder)) + localBegin;
+                _swiftMultiProcessQGram(finder, pattern, hash(shape, hostIterator(hostIterator(finder))));
+
+                for (++finder.curPos, ++finder; finder.curPos < localEnd; ++finder.curPos, ++finder)
+                    _swiftMultiProcessQGram(finder, pattern, hashNext(shape, hostIterator(hostIterator(finder))));
+            }
+        }
+        while ((TPos)finder.endPos < endPos + (TPos)length(shape) - 1 && _nextNonRepeatRange(finder, pattern));
+    }
+    _swiftMultiFlushBuckets(finder, pattern);
+}
+
+/*!
+ * @fn Swift#windowFindAll
+ * 
+ * @headerfile seqan/index.h
+ * 
+ * @brief Filters the whole haystack at once, optionally in parallel.  The found hits can be retrieved with
+ *        @link Swift#getWindowFindHits @endlink.
+ * 
+ * @signature windowFindAll(finder, pattern, errorRate, minLength, parallelTag)
+ * 
+ * @param finder A finder with window interface. Types: @link Swift @endlink
+ * @param pattern A pattern with window interface. Types: @link Swift @endlink
+ * @param errorRate Error rate that is allowed between reads and reference. Types: <tt>double</tt>
+ * @param minLength Minimal length of a local match, 0 for semi-global filters.
+ * @param parallelTag Tag to select the serial or parallel filtration. Types: @link ParallelismTags @endlink.
+ * 
+ * @return TReturn <tt>true</tt> if there are hits, <tt>false</tt> otherwise.
+ * 
+ * In the parallel version <tt>omp_get_max_threads()</tt> threads filter disjoint haystack windows with their own
+ * copies of finder and pattern.  The hits are the same as those of a serial scan.  They are sorted by window and
+ * within a window in the order they were found.  The bucket counters of <tt>pattern</tt> are not updated, so the
+ * search cannot be continued with @link Finder#find @endlink or @link Swift#windowFindNext @endlink.
+ * 
+ * @see Swift#getWindowFindHits
+ */
+
+/**
+.Function.windowFindAll:
+..cat:Searching
+..summary:Filters the whole haystack at once, optionally in parallel.
+The found hits can be retrieved with @Function.getWindowFindHits@.
+..signature:windowFindAll(finder, pattern, errorRate, minLength, parallelTag)
+..class:Spec.Swift
+..param.finder:A finder with window interface.
+...type:Spec.Swift
+..param.pattern: A pattern with window interface.
+...type:Spec.Swift
+..param.errorRate:Error rate that is allowed between reads and reference.
+...type:nolink:double
+..param.minLength:Minimal length of a local match, 0 for semi-global filters.
+..param.parallelTag:Tag to select the serial or parallel filtration.
+...type:Tag.Parallel
+..returns:$true$ if there are hits, $false$ otherwise.
+..remarks:In the parallel version $omp_get_max_threads()$ threads filter disjoint haystack windows with their own
+copies of finder and pattern. The hits are the same as those of a serial scan. They are sorted by window and
+within a window in the order they were found. The bucket counters of $pattern$ are not updated, so the
+search cannot be continued with @Function.find@ or @Function.windowFindNext@.
+..see:Function.getWindowFindHits
+..include:seqan/index.h
+*/
+template <typename THaystack, typename TIndex, typename TSpec, typename TSize>
+inline bool
+windowFindAll(
+    Finder<THaystack, Swift<TSpec> > &finder,
+    Pattern<TIndex, Swift<TSpec> > &pattern,
+    double errorRate,
+    TSize minLength,
+    Serial)
+{
+    pattern.finderLength = pattern.params.tabooLength + length(container(finder));
+    _patternInit(pattern, errorRate, minLength);
+    _finderSetNonEmpty(finder);
+
+    _swiftScanRange(finder, pattern, (__int64)0, (__int64)length(container(finder)));
+    finder.curHit = begin(finder.hits, Standard());
+    finder.endHit = end(finder.hits, Standard());
+    return !empty(finder.hits);
+}
+
+template <typename THaystack, typename TIndex, typename TSpec, typename TSize>
+inline bool
+windowFindAll(
+    Finder<THaystack, Swift<TSpec> > &finder,
+    Pattern<TIndex, Swift<TSpec> > &pattern,
+    double errorRate,
+    TSize minLength,
+    Parallel)
+{
+    typedef Finder<THaystack, Swift<TSpec> >                TFinder;
+    typedef Pattern<TIndex, Swift<TSpec> >                  TPattern;
+    typedef typename TFinder::THitString                    THitString;
+    typedef typename Iterator<THitString, Standard>::Type   THitIter;
+    typedef typename TPattern::TBucketParams                TBucketParams;
+
+    pattern.finderLength = pattern.params.tabooLength + length(container(finder));
+    _patternInit(pattern, errorRate, minLength);
+    _finderSetNonEmpty(finder);
+
+    // all q-gram hits of a parallelogram are at most span haystack positions apart
+    __int64 span = 0;
+    for (unsigned i = 0; i < length(pattern.bucketParams); ++i)
+    {
+        TBucketParams const &bucketParams = pattern.bucketParams[i];
+        span = _max(span, (__int64)bucketParams.delta + bucketParams.overlap);
+    }
+    for (unsigned seqNo = 0; seqNo < countSequences(host(pattern)); ++seqNo)
+        span = _max(span, (__int64)sequenceLength(seqNo, host(pattern)));
+    span += length(pattern.shape);
+
+    __int64 hstkLength = length(container(finder));
+    __int64 margin = 2 * span;
+    __int64 windows = _min((__int64)omp_get_max_threads(), hstkLength / (4 * margin));
+    if (windows < 2)
+        return windowFindAll(finder, pattern, errorRate, minLength, Serial());
+
+    Splitter<__int64> splitter(0, hstkLength, windows);
+    String<THitString> windowHits;
+    resize(windowHits, windows);
+
+    SEQAN_OMP_PRAGMA(parallel for schedule(static, 1))
+    for (int w = 0; w < (int)windows; ++w)
+    {
+        TFinder localFinder(finder);
+        TPattern localPattern(pattern);
+        _swiftScanRange(localFinder, localPattern,
+                        _max((__int64)0, splitter[w] - margin),
+                        _min(hstkLength, splitter[w + 1] + margin));
+
+        // keep the hits of parallelograms beginning in this window
+        __int64 windowBegin = (w == 0)? MinValue<__int64>::VALUE: splitter[w];
+        __int64 windowEnd = (w + 1 == (int)windows)? MaxValue<__int64>::VALUE: splitter[w + 1];
+        for (THitIter it = begin(localFinder.hits, Standard()); it != end(localFinder.hits, Standard()); ++it)
+            if (windowBegin <= (*it).hstkPos && (*it).hstkPos < windowEnd)
+                appendValue(windowHits[w], *it);
+    }
+
+    clear(finder.hits);
+    for (unsigned w = 0; w < length(windowHits); ++w)
+        append(finder.hits, windowHits[w]);
+    finder.curHit = begin(finder.hits, Standard());
+    finder.endHit = end(finder.hits, Standard());
+    return !empty(finder.hits);
+}
+
+
 }// namespace SEQAN_NAMESPACE_MAIN
 
 #endif //#ifndef SEQAN_HEADER_FIND_SHIFTAND_H
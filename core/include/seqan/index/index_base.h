@@ -45,6 +45,7 @@ namespace SEQAN_NAMESPACE_MAIN {
 // suffix array construction specs
 struct Skew3;
 struct Skew7;
+struct ParallelSkew7;
 struct LarssonSadakane;
 struct ManberMyers;
 struct SAQSort;
@@ -156,6 +157,69 @@ struct DefaultIndexSpec
     typedef IndexEsa<> Type;
 };
 
+// ----------------------------------------------------------------------------
+// Class MMapFibres
+// ----------------------------------------------------------------------------
+
+/**
+.Class.MMapFibres:
+..cat:Index
+..summary:Configuration of a @Spec.MMap String@ text whose index fibres are memory mapped as well.
+..signature:MMapFibres<TConfig>
+..param.TConfig:The configuration of the text and the fibres.
+...default:$MMapConfig<>$
+..remarks:The fibres of an index over a $String<TValue, MMap<MMapFibres<> > >$ are of type $String<TFibreValue, MMap<> >$.
+Opening a saved index then maps the fibre files instead of reading them.
+Mapped fibres live in their files, so @Function.Index#save@ does not write anything for such an index.
+Build and save the index with in-memory fibres, e.g. over a $String<TValue>$ or a plain $String<TValue, MMap<> >$ text.
+..example.code:
+Index<DnaString, FMIndex<> > index(text);
+save(index, "genome");
+
+Index<String<Dna, MMap<MMapFibres<> > >, FMIndex<> > mapped;
+open(mapped, "genome", OPEN_RDONLY);
+..include:seqan/index.h
+*/
+
+/*!
+ * @class MMapFibres
+ * @headerfile <seqan/index.h>
+ * @brief Configuration of a @link MMapString @endlink text whose index fibres
+ *        are memory mapped as well.
+ *
+ * @signature template <[typename TConfig]>
+ *            struct MMapFibres;
+ *
+ * @tparam TConfig The configuration of the text and the fibres.  Default:
+ *                 <tt>MMapConfig&lt;&gt;</tt>.
+ *
+ * @section Remarks
+ *
+ * The fibres of an index over a <tt>String&lt;TValue, MMap&lt;MMapFibres&lt;&gt;
+ * &gt; &gt;</tt> are memory mapped strings.  Opening a saved index then maps the
+ * fibre files instead of reading them.  Mapped fibres live in their files, so
+ * @link Index#save @endlink does not write anything for such an index.  Build and
+ * save the index with in-memory fibres, e.g. over a <tt>String&lt;TValue&gt;</tt>
+ * or a plain MMap string text.
+ *
+ * @section Examples
+ *
+ * @code{.cpp}
+ * Index<DnaString, FMIndex<> > index(text);
+ * save(index, "genome");
+ *
+ * Index<String<Dna, MMap<MMapFibres<> > >, FMIndex<> > mapped;
+ * open(mapped, "genome", OPEN_RDONLY);
+ * @endcode
+ */
+
+template <typename TConfig = MMapConfig<> >
+struct MMapFibres
+{
+    typedef typename TConfig::TFile TFile;
+    typedef typename TConfig::TSize TSize;
+};
+
 // ----------------------------------------------------------------------------
 // Metafunction DefaultIndexStringSpec
 // ----------------------------------------------------------------------------
@@ -169,6 +233,9 @@ struct DefaultIndexSpec
 ..param.TIndex:An @Class.Index@ Type.
 ..returns:If the underlying text is a @Class.String@ or a set of Strings (see @Class.StringSet@) the String's spec. type is returned.
 ..remarks:Most of the @Class.Index@ fibres are strings. The @Class.String@ specialization type is chosen by this meta-function.
+..remarks:If the text is a @Spec.MMap String@ configured with @Class.MMapFibres@ (or a set of them), the fibres are
+memory mapped strings as well. An index saved with @Function.Index#save@ can then be opened without reading its fibres
+into memory. Texts that are plain @Spec.MMap String@s get in-memory fibres.
 ..include:seqan/index.h
 */
 
@@ -188,6 +255,12 @@ struct DefaultIndexSpec
  *
  * Most of the @link Index @endlink fibres are strings. The @link String
  * @endlink specialization type is chosen by this meta-function.
+ *
+ * If the text is a @link MMapString @endlink configured with @link MMapFibres
+ * @endlink (or a set of them), the fibres are memory mapped strings as well.
+ * An index saved with @link Index#save @endlink can then be opened without
+ * reading its fibres into memory.  Texts that are plain MMap strings get
+ * in-memory fibres.
  */
 // default which should actually never been used
 template <typename TIndex>
@@ -202,6 +275,12 @@ struct DefaultIndexStringSpec<String<TValue, External<TSpec> > >
     typedef External<TSpec> Type;
 };
 
+template <typename TValue, typename TConfig>
+struct DefaultIndexStringSpec<String<TValue, MMap<MMapFibres<TConfig> > > >
+{
+    typedef MMap<TConfig> Type;
+};
+
 template <typename TString, typename TSpec>
 struct DefaultIndexStringSpec<StringSet<TString, TSpec> >:
     DefaultIndexStringSpec<TString>{};
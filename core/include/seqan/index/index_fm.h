@@ -152,32 +152,72 @@ To get a reference or the type of a specific fibre use @Function.getFibre@ or @M
 ..include:seqan/index.h
 */
 
+// ----------------------------------------------------------------------------
+// Metafunction FMIndexBitStringSpec_
+// ----------------------------------------------------------------------------
+
+// The specialisation of the rank support bit strings of an FM index. If the fibres of the index are memory mapped
+// (see MMapFibres), the rank dictionary and the compressed suffix array are memory mapped as well and a saved index
+// can be opened without reading it into memory.
+
+template <typename TStringSpec>
+struct FMIndexBitStringSpec_
+{
+    typedef void Type;
+};
+
+template <typename TConfig>
+struct FMIndexBitStringSpec_<MMap<TConfig> >
+{
+    typedef MMap<TConfig> Type;
+};
+
 template <typename TText, typename TWaveletTreeSpec, typename TSpec>
 struct Fibre<Index<TText, FMIndex<WT<TWaveletTreeSpec>, TSpec> >, FibreOccTable>
 {
     typedef typename Value<TText>::Type TValue_;
-	typedef SentinelRankDictionary<RankDictionary<WaveletTree<TValue_> >, Sentinel> Type;
+    typedef typename FMIndexBitStringSpec_<typename DefaultIndexStringSpec<TText>::Type>::Type TBitStringSpec_;
+	typedef SentinelRankDictionary<RankDictionary<WaveletTree<TValue_, TBitStringSpec_> >, Sentinel> Type;
 };
 
 template <typename TText, typename TStringSetSpec, typename TWaveletTreeSpec, typename TSpec>
 struct Fibre<Index<StringSet<TText, TStringSetSpec>, FMIndex<WT<TWaveletTreeSpec>, TSpec > >, FibreOccTable>
 {
     typedef typename Value<TText>::Type TValue_;
-    typedef SentinelRankDictionary<RankDictionary<WaveletTree<TValue_> >, Sentinels> Type;
+    typedef typename FMIndexBitStringSpec_<typename DefaultIndexStringSpec<TText>::Type>::Type TBitStringSpec_;
+    typedef SentinelRankDictionary<RankDictionary<WaveletTree<TValue_, TBitStringSpec_> >, Sentinels> Type;
 };
 
 template <typename TText, typename TWaveletTreeSpec, typename TSpec>
 struct Fibre<Index<TText, FMIndex<SBM<TWaveletTreeSpec>, TSpec> >, FibreOccTable>
 {
     typedef typename Value<Index<TText, FMIndex<WT<TWaveletTreeSpec>, TSpec> > >::Type TValue_;
-	typedef SentinelRankDictionary<RankDictionary<SequenceBitMask<TValue_> >, Sentinel> Type;
+    typedef typename FMIndexBitStringSpec_<typename DefaultIndexStringSpec<TText>::Type>::Type TBitStringSpec_;
+	typedef SentinelRankDictionary<RankDictionary<SequenceBitMask<TValue_, TBitStringSpec_> >, Sentinel> Type;
 };
 
 template <typename TText, typename TStringSetSpec, typename TWaveletTreeSpec, typename TSpec>
 struct Fibre<Index<StringSet<TText, TStringSetSpec>, FMIndex<SBM<TWaveletTreeSpec>, TSpec > >, FibreOccTable>
 {
     typedef typename Value<TText>::Type TValue_;
-    typedef SentinelRankDictionary<RankDictionary<SequenceBitMask<TValue_> >, Sentinels> Type;
+    typedef typename FMIndexBitStringSpec_<typename DefaultIndexStringSpec<TText>::Type>::Type TBitStringSpec_;
+    typedef SentinelRankDictionary<RankDictionary<SequenceBitMask<TValue_, TBitStringSpec_> >, Sentinels> Type;
+};
+
+template <typename TText, typename TBitMaskSpec, typename TSpec>
+struct Fibre<Index<TText, FMIndex<IBM<TBitMaskSpec>, TSpec> >, FibreOccTable>
+{
+    typedef typename Value<TText>::Type TValue_;
+    typedef typename FMIndexBitStringSpec_<typename DefaultIndexStringSpec<TText>::Type>::Type TBitStringSpec_;
+	typedef SentinelRankDictionary<RankDictionary<InterleavedBitMask<TValue_, TBitStringSpec_> >, Sentinel> Type;
+};
+
+template <typename TText, typename TStringSetSpec, typename TBitMaskSpec, typename TSpec>
+struct Fibre<Index<StringSet<TText, TStringSetSpec>, FMIndex<IBM<TBitMaskSpec>, TSpec > >, FibreOccTable>
+{
+    typedef typename Value<TText>::Type TValue_;
+    typedef typename FMIndexBitStringSpec_<typename DefaultIndexStringSpec<TText>::Type>::Type TBitStringSpec_;
+    typedef SentinelRankDictionary<RankDictionary<InterleavedBitMask<TValue_, TBitStringSpec_> >, Sentinels> Type;
 };
 
 template <typename TText, typename TOccSpec, typename TSpec>
@@ -216,7 +256,9 @@ template <typename TText, typename TOccSpec, typename TSpec>
 struct Fibre<Index<TText, FMIndex<TOccSpec, TSpec> >, FibreSA>
 {
 	typedef typename SAValue<Index<TText, FMIndex<TOccSpec, TSpec> > >::Type                TSAValue_;
-	typedef SparseString<String<TSAValue_>, void>                                           TSparseString_;
+    typedef typename FMIndexBitStringSpec_<typename DefaultIndexStringSpec<TText>::Type>::Type TBitStringSpec_;
+    typedef typename DefaultIndexStringSpec<RankSupportBitString<TBitStringSpec_> >::Type  TSAStringSpec_;
+	typedef SparseString<String<TSAValue_, TSAStringSpec_>, TBitStringSpec_>                TSparseString_;
 	typedef typename Fibre<Index<TText, FMIndex<TOccSpec, TSpec> >, FibreLfTable>::Type     TLfTable_;
 	typedef CompressedSA<TSparseString_, TLfTable_, void>                                   Type;
 };
@@ -276,6 +318,7 @@ struct FmIndexInfo_
 ..param.TOccSpec:Occurrence table specialisation. 
 ...type:Tag.WT
 ...type:Tag.SBM
+...type:Tag.IBM
 ...remarks:The tags are really shortcuts for the different @Class.SentinelRankDictionary@s
 ...default:Tag.WT
 ..param.TSpec:FM index specialisation.
@@ -664,18 +707,20 @@ inline bool _indexCreateLfTables(Index<TText, FMIndex<TIndexSpec, TSpec> > & ind
 /**
 .Function.FMIndex#indexCreate
 ..summary:Creates a specific @Metafunction.Fibre@.
-..signature:indexCreate(index, fibreTag)
+..signature:indexCreate(index, fibreTag[, algoTag])
 ..param.index:The index to be created.
 ...type:Spec.FMIndex
 ..param.fibreTag:The fibre of the index to be computed.
 ...type:Tag.FM Index Fibres.tag.FibreSaLfTable
+..param.algoTag:The algorithm used to build the temporary suffix array, e.g. $Skew7$ or $ParallelSkew7$.
+...default:$Skew7$
 ..remarks:If you call this function on the compressed text version of the FM index
 you will get an error message: "Logic error. It is not possible to create this index without a text."
 */
 
 // This function creates the index.
-template <typename TText, typename TIndexSpec, typename TSpec>
-inline bool _indexCreate(Index<TText, FMIndex<TIndexSpec, TSpec > > & index, TText & text)
+template <typename TText, typename TIndexSpec, typename TSpec, typename TAlgSpec>
+inline bool _indexCreate(Index<TText, FMIndex<TIndexSpec, TSpec > > & index, TText & text, TAlgSpec const & alg)
 {
 	typedef Index<TText, FMIndex<TIndexSpec, TSpec> >   TIndex;
 	typedef typename Fibre<TIndex, FibreTempSA>::Type   TTempSA;
@@ -686,9 +731,7 @@ inline bool _indexCreate(Index<TText, FMIndex<TIndexSpec, TSpec > > & index, TTe
     TTempSA tempSA;
     
 	resize(tempSA, lengthSum(text), Exact());
-	createSuffixArray(tempSA,
-			text,
-			Skew7());
+	createSuffixArray(tempSA, text, alg);
 
 
 	// create the compressed SA
@@ -701,6 +744,18 @@ inline bool _indexCreate(Index<TText, FMIndex<TIndexSpec, TSpec > > & index, TTe
 }
 
 
+template <typename TText, typename TIndexSpec, typename TSpec>
+inline bool _indexCreate(Index<TText, FMIndex<TIndexSpec, TSpec > > & index, TText & text)
+{
+    return _indexCreate(index, text, Skew7());
+}
+
+template <typename TText, typename TIndexSpec, typename TSpec, typename TAlgSpec>
+inline bool indexCreate(Index<TText, FMIndex<TIndexSpec, TSpec> > & index, FibreSaLfTable const, TAlgSpec const & alg)
+{
+    return _indexCreate(index, getFibre(index, FibreText()), alg);
+}
+
 template <typename TText, typename TIndexSpec, typename TSpec>
 inline bool indexCreate(Index<TText, FMIndex<TIndexSpec, TSpec> > & index, FibreSaLfTable const)
 {
@@ -780,6 +835,148 @@ inline void _range(const Index<TText, FMIndex<TOccSpec, TSpec> > & index, const
 	setPosition(range.i2, ep + 1);
 }
 
+// ----------------------------------------------------------------------------
+// Function findRanges
+// ----------------------------------------------------------------------------
+
+/**
+.Function.FMIndex#findRanges
+..class:Spec.FMIndex
+..summary:Searches many patterns at once and computes their suffix array ranges.
+..signature:findRanges(ranges, index, patterns)
+..param.ranges:The resulting ranges, one for each pattern.
+...type:Class.String
+...remarks:The $i$-th entry is a @Class.Pair@ $(begin, end)$ of suffix array positions. The occurrences of the
+$i$-th pattern are the entries $begin$ to $end - 1$ of the suffix array fibre @Tag.FM Index Fibres.FibreSA@.
+The range is empty if the pattern does not occur.
+..param.index:The FM index.
+...type:Spec.FMIndex
+..param.patterns:The patterns to search.
+...type:Class.StringSet
+..remarks:The backward searches of a window of patterns are advanced in lockstep. For each step the occurrence table
+entries of all patterns of the window are prefetched before their ranks are computed, such that the cache misses of
+the different patterns overlap. This is considerably faster than searching the patterns one by one with a
+@Class.Finder@ if many patterns are searched. If OpenMP is enabled, the windows are searched in parallel.
+..include:seqan/index.h
+..example.code:
+Index<DnaString, FMIndex<> > index(genome);
+String<Pair<unsigned> > ranges;
+findRanges(ranges, index, reads);
+
+for (unsigned i = 0; i < length(ranges); ++i)
+    for (unsigned j = ranges[i].i1; j < ranges[i].i2; ++j)
+        std::cout << "read " << i << " occurs at " << getFibre(index, FibreSA())[j] << std::endl;
+*/
+
+// The number of backward searches advanced in lockstep. The window must be large enough to hide the memory latency
+// and small enough to keep the search states in the L1 cache.
+struct FMIndexBatchSize_
+{
+    enum { VALUE = 256 };
+};
+
+template <typename TRanges, typename TText, typename TOccSpec, typename TSpec, typename TPatterns, typename TPos>
+inline void _findRangesWindow(TRanges & ranges,
+                              Index<TText, FMIndex<TOccSpec, TSpec> > const & index,
+                              TPatterns const & patterns,
+                              TPos windowBegin,
+                              TPos windowEnd)
+{
+    typedef Index<TText, FMIndex<TOccSpec, TSpec> >             TIndex;
+    typedef typename Value<TIndex>::Type                        TAlphabet;
+    typedef typename ValueSize<TAlphabet>::Type                 TAlphabetSize;
+    typedef typename Size<TIndex>::Type                         TSize;
+    typedef typename Value<TRanges>::Type                       TRange;
+    typedef typename Value<TRange, 1>::Type                     TRangePos;
+
+    // sp and ep are the begin and end (exclusive) of the current suffix array range,
+    // patternPos is the number of characters still to be searched.
+    TSize sp[FMIndexBatchSize_::VALUE];
+    TSize ep[FMIndexBatchSize_::VALUE];
+    TSize patternPos[FMIndexBatchSize_::VALUE];
+    unsigned active[FMIndexBatchSize_::VALUE];
+    unsigned activeCount = 0;
+
+    // initialization with the last character of each pattern
+    for (TPos i = windowBegin; i < windowEnd; ++i)
+    {
+        unsigned k = i - windowBegin;
+        TSize patternLength = length(patterns[i]);
+        if (patternLength == 0)
+        {
+            sp[k] = countSequences(index);
+            ep[k] = index.n;
+            continue;
+        }
+
+        TAlphabetSize letterPosition = getCharacterPosition(index.lfTable.prefixSumTable,
+                                                            (TAlphabet)patterns[i][patternLength - 1]);
+        sp[k] = getPrefixSum(index.lfTable.prefixSumTable, letterPosition);
+        ep[k] = getPrefixSum(index.lfTable.prefixSumTable, letterPosition + 1);
+        patternPos[k] = patternLength - 1;
+        if (sp[k] < ep[k] && patternPos[k] > 0)
+            active[activeCount++] = k;
+    }
+
+    // the search as proposed by Ferragina and Manzini, one character of all active patterns per round
+    while (activeCount > 0)
+    {
+        for (unsigned a = 0; a < activeCount; ++a)
+        {
+            unsigned k = active[a];
+            TAlphabet letter = patterns[windowBegin + k][patternPos[k] - 1];
+            _prefetchOccurrences(index.lfTable.occTable, letter, sp[k] - 1);
+            _prefetchOccurrences(index.lfTable.occTable, letter, ep[k] - 1);
+        }
+
+        unsigned stillActive = 0;
+        for (unsigned a = 0; a < activeCount; ++a)
+        {
+            unsigned k = active[a];
+            TAlphabet letter = patterns[windowBegin + k][--patternPos[k]];
+            TAlphabetSize letterPosition = getCharacterPosition(index.lfTable.prefixSumTable, letter);
+            TSize prefixSum = getPrefixSum(index.lfTable.prefixSumTable, letterPosition);
+            sp[k] = prefixSum + countOccurrences(index.lfTable.occTable, letter, sp[k] - 1);
+            ep[k] = prefixSum + countOccurrences(index.lfTable.occTable, letter, ep[k] - 1);
+            if (sp[k] < ep[k] && patternPos[k] > 0)
+                active[stillActive++] = k;
+        }
+        activeCount = stillActive;
+    }
+
+    for (TPos i = windowBegin; i < windowEnd; ++i)
+    {
+        unsigned k = i - windowBegin;
+        if (sp[k] < ep[k])
+            ranges[i] = TRange((TRangePos)sp[k], (TRangePos)ep[k]);
+        else
+            ranges[i] = TRange((TRangePos)sp[k], (TRangePos)sp[k]);
+    }
+}
+
+template <typename TRanges, typename TText, typename TOccSpec, typename TSpec, typename TPatterns>
+inline void findRanges(TRanges & ranges,
+                       Index<TText, FMIndex<TOccSpec, TSpec> > & index,
+                       TPatterns const & patterns)
+{
+    typedef typename Size<TPatterns>::Type  TPatternsSize;
+    typedef typename MakeSigned<TPatternsSize>::Type  TSignedSize;
+
+    indexRequire(index, FibreSaLfTable());
+    resize(ranges, length(patterns), Exact());
+
+    Index<TText, FMIndex<TOccSpec, TSpec> > const & constIndex = index;
+    TSignedSize windows = (length(patterns) + FMIndexBatchSize_::VALUE - 1) / FMIndexBatchSize_::VALUE;
+
+    SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
+    for (TSignedSize w = 0; w < windows; ++w)
+    {
+        TPatternsSize windowBegin = (TPatternsSize)w * FMIndexBatchSize_::VALUE;
+        TPatternsSize windowEnd = _min(windowBegin + (TPatternsSize)FMIndexBatchSize_::VALUE, length(patterns));
+        _findRangesWindow(ranges, constIndex, patterns, windowBegin, windowEnd);
+    }
+}
+
 // ----------------------------------------------------------------------------
 // Function open
 // ----------------------------------------------------------------------------
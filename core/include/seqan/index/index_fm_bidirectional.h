@@ -0,0 +1,759 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Author: agent <agent@local>
+// ==========================================================================
+// The bidirectional FM index consists of an FM index of the text and an FM
+// index of the reversed text.  The iterator keeps the suffix array ranges
+// of both indices in sync such that a pattern can be extended to the left
+// as well as to the right.  This allows approximate searches with search
+// schemes, see Kucherov et al., Approximate string matching using a
+// bidirectional index, CPM 2014.
+// ==========================================================================
+
+#ifndef INDEX_FM_BIDIRECTIONAL_H_
+#define INDEX_FM_BIDIRECTIONAL_H_
+
+namespace seqan {
+
+// ==========================================================================
+// Forwards
+// ==========================================================================
+
+/*!
+ * @class BidirectionalIndex
+ * @extends Index
+ * @headerfile seqan/index.h
+ * @brief An index of a text and its reverse supporting the extension of a pattern in both directions.
+ *
+ * @signature template <typename TText, typename TIndexSpec>
+ *            Index<TText, BidirectionalIndex<TIndexSpec> >
+ *
+ * @tparam TText      The text type. Types: @link String @endlink, @link StringSet @endlink
+ * @tparam TIndexSpec The specialisation of the two underlying indices. Types: @link FMIndex @endlink
+ *                    Default: <tt>FMIndex&lt;&gt;</tt>.
+ *
+ * The index of the reversed text stores its own copy of the reversed text.  Use a
+ * <tt>TopDown&lt;&gt;</tt> iterator and the functions @link BidirectionalIndex#extendLeft @endlink
+ * and @link BidirectionalIndex#extendRight @endlink to search.
+ */
+
+/**
+.Spec.BidirectionalIndex:
+..summary:An index of a text and its reverse supporting the extension of a pattern in both directions.
+..cat:Index
+..general:Class.Index
+..signature:Index<TText, BidirectionalIndex<TIndexSpec> >
+..param.TText:The text type.
+...type:Class.String
+...type:Class.StringSet
+..param.TIndexSpec:The specialisation of the two underlying indices.
+...type:Spec.FMIndex
+...default:$FMIndex<>$
+..remarks:The index of the reversed text stores its own copy of the reversed text.
+Use a $TopDown<>$ iterator and the functions @Function.extendLeft@ and @Function.extendRight@ to search.
+..include:seqan/index.h
+*/
+template <typename TIndexSpec = FMIndex<> >
+struct BidirectionalIndex;
+
+// ==========================================================================
+// Classes
+// ==========================================================================
+
+// ----------------------------------------------------------------------------
+// Class BidirectionalIndex
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec>
+class Index<TText, BidirectionalIndex<TIndexSpec> >
+{
+public:
+    // fwd extends patterns to the left, rev is built over the reversed text and extends patterns to the right.
+    Index<TText, TIndexSpec> fwd;
+    Index<TText, TIndexSpec> rev;
+
+    Index() {}
+
+    Index(TText & text, unsigned compressionFactor = 10) :
+        fwd(text, compressionFactor)
+    {
+        create(rev.text, text);
+        reverse(getFibre(rev, FibreText()));
+        rev.n = _computeBwtLength(getFibre(rev, FibreText()));
+        rev.compressionFactor = compressionFactor;
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Class BidirectionalIndex Iterator
+// ----------------------------------------------------------------------------
+
+// The iterator represents a pattern by its suffix array range in the index of the text and the range in the index
+// of the reversed text.  Both ranges have the same size.
+template <typename TText, typename TIndexSpec, typename TSpec>
+class Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > >
+{
+public:
+    typedef Index<TText, BidirectionalIndex<TIndexSpec> >   TIndex;
+    typedef typename Size<TIndex>::Type                     TSize;
+
+    TIndex const *  index;
+    Pair<TSize>     fwdRange;
+    Pair<TSize>     revRange;
+    TSize           repLen;
+
+    Iter() :
+        index(NULL),
+        repLen(0)
+    {}
+
+    Iter(TIndex & _index) :
+        index(&_index)
+    {
+        indexRequire(_index, FibreSaLfTable());
+        goRoot(*this);
+    }
+};
+
+// ==========================================================================
+// Functions
+// ==========================================================================
+
+// ----------------------------------------------------------------------------
+// Function clear
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec>
+inline void clear(Index<TText, BidirectionalIndex<TIndexSpec> > & index)
+{
+    clear(index.fwd);
+    clear(index.rev);
+}
+
+// ----------------------------------------------------------------------------
+// Function indexCreate
+// ----------------------------------------------------------------------------
+
+/**
+.Function.BidirectionalIndex#indexCreate
+..summary:Creates the indices of the text and of the reversed text.
+..signature:indexCreate(index, fibreTag)
+..param.index:The index to be created.
+...type:Spec.BidirectionalIndex
+..param.fibreTag:The fibre of the underlying indices to be computed.
+...type:Tag.FM Index Fibres.tag.FibreSaLfTable
+..returns:A $bool$ which is $true$ on success.
+..include:seqan/index.h
+*/
+template <typename TText, typename TIndexSpec>
+inline bool indexCreate(Index<TText, BidirectionalIndex<TIndexSpec> > & index, FibreSaLfTable const fibre)
+{
+    return indexCreate(index.fwd, fibre) && indexCreate(index.rev, fibre);
+}
+
+// ----------------------------------------------------------------------------
+// Function indexSupplied
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec>
+inline bool indexSupplied(Index<TText, BidirectionalIndex<TIndexSpec> > & index, FibreSaLfTable const fibre)
+{
+    return indexSupplied(index.fwd, fibre) && indexSupplied(index.rev, fibre);
+}
+
+template <typename TText, typename TIndexSpec>
+inline bool indexSupplied(Index<TText, BidirectionalIndex<TIndexSpec> > const & index, FibreSaLfTable const fibre)
+{
+    return indexSupplied(index.fwd, fibre) && indexSupplied(index.rev, fibre);
+}
+
+// ----------------------------------------------------------------------------
+// Function _countSentinels
+// ----------------------------------------------------------------------------
+
+// This function returns the number of sentinels in the range [beginPos, endPos) of the BWT.
+template <typename TRankDictionary, typename TPos>
+inline TPos _countSentinels(SentinelRankDictionary<TRankDictionary, Sentinel> const & dictionary,
+                            TPos beginPos, TPos endPos)
+{
+    return (beginPos <= (TPos)dictionary.sentinelPosition && (TPos)dictionary.sentinelPosition < endPos) ? 1 : 0;
+}
+
+template <typename TRankDictionary, typename TPos>
+inline TPos _countSentinels(SentinelRankDictionary<TRankDictionary, Sentinels> const & dictionary,
+                            TPos beginPos, TPos endPos)
+{
+    TPos count = getRank(getFibre(dictionary, FibreSentinelPosition()), endPos - 1);
+    if (beginPos > 0)
+        count -= getRank(getFibre(dictionary, FibreSentinelPosition()), beginPos - 1);
+    return count;
+}
+
+// ----------------------------------------------------------------------------
+// Function _extend
+// ----------------------------------------------------------------------------
+
+// This function extends the pattern represented by range by c using a backward search step in index and updates
+// the range of the opposite index (mirrorRange).  The suffixes in the opposite range are ordered by the character
+// following the pattern in the opposite direction, therefore the new opposite range starts after all occurrences
+// preceded by a sentinel or a smaller character.
+template <typename TIndex, typename TSize, typename TChar>
+inline bool _extend(TIndex const & index, Pair<TSize> & range, Pair<TSize> & mirrorRange, TChar c, bool root)
+{
+    typedef typename Fibre<TIndex, FibreLfTable>::Type          TLfTable;
+    typedef typename Fibre<TLfTable, FibrePrefixSumTable>::Type TPrefixSumTable;
+
+    TPrefixSumTable const & pst = getFibre(getFibre(index, FibreLfTable()), FibrePrefixSumTable());
+
+    unsigned cPosition = getCharacterPosition(pst, c);
+    TSize prefixSum = getPrefixSum(pst, cPosition);
+
+    // The range of the empty pattern does not contain the suffixes consisting of a sentinel only, but the characters
+    // preceding them must be considered.  Both texts consist of the same characters, thus both ranges are equal.
+    if (root)
+    {
+        TSize newEnd = getPrefixSum(pst, cPosition + 1);
+        if (prefixSum >= newEnd)
+            return false;
+
+        range.i1 = mirrorRange.i1 = prefixSum;
+        range.i2 = mirrorRange.i2 = newEnd;
+        return true;
+    }
+
+    TSize newBegin = prefixSum + countOccurrences(index.lfTable.occTable, c, range.i1 - 1);
+    TSize newEnd = prefixSum + countOccurrences(index.lfTable.occTable, c, range.i2 - 1);
+
+    if (newBegin >= newEnd)
+        return false;
+
+    TSize smaller = _countSentinels(index.lfTable.occTable, range.i1, range.i2);
+    for (unsigned k = 0; k < cPosition; ++k)
+        smaller += countOccurrences(index.lfTable.occTable, getCharacter(pst, k), range.i2 - 1) -
+                   countOccurrences(index.lfTable.occTable, getCharacter(pst, k), range.i1 - 1);
+
+    mirrorRange.i1 += smaller;
+    mirrorRange.i2 = mirrorRange.i1 + (newEnd - newBegin);
+    range.i1 = newBegin;
+    range.i2 = newEnd;
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Function goRoot
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec, typename TSpec>
+inline void goRoot(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > & it)
+{
+    typedef typename Size<Index<TText, BidirectionalIndex<TIndexSpec> > >::Type TSize;
+
+    // The sentinels are the smallest characters, all other suffixes start with the empty pattern.
+    TSize numSentinels = countSequences(it.index->fwd);
+    it.fwdRange = Pair<TSize>(numSentinels, it.index->fwd.n);
+    it.revRange = Pair<TSize>(numSentinels, it.index->rev.n);
+    it.repLen = 0;
+}
+
+// ----------------------------------------------------------------------------
+// Function isRoot
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec, typename TSpec>
+inline bool isRoot(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > const & it)
+{
+    return it.repLen == 0;
+}
+
+// ----------------------------------------------------------------------------
+// Function extendLeft
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BidirectionalIndex#extendLeft
+ * @headerfile seqan/index.h
+ * @brief Extends the pattern of a bidirectional index iterator to the left.
+ *
+ * @signature bool extendLeft(it, c);
+ * @signature bool extendLeft(it, pattern);
+ *
+ * @param[in,out] it      The iterator.
+ * @param[in]     c       The character to prepend.
+ * @param[in]     pattern The string to prepend.
+ *
+ * @return bool <tt>true</tt> if the extended pattern occurs in the text, <tt>false</tt> otherwise.  In the latter
+ *              case the iterator is not modified.
+ */
+
+/**
+.Function.extendLeft
+..summary:Extends the pattern of a bidirectional index iterator to the left.
+..cat:Index
+..signature:extendLeft(it, c)
+..signature:extendLeft(it, pattern)
+..param.it:An iterator of a bidirectional index.
+...type:Spec.BidirectionalIndex
+..param.c:The character to prepend.
+..param.pattern:The string to prepend.
+..returns:$true$ if the extended pattern occurs in the text, $false$ otherwise.
+In the latter case the iterator is not modified.
+...type:nolink:$bool$
+..see:Function.extendRight
+..include:seqan/index.h
+..example.code:
+Index<DnaString, BidirectionalIndex<> > index(genome);
+Iterator<Index<DnaString, BidirectionalIndex<> >, TopDown<> >::Type it(index);
+
+extendRight(it, "CG");  // CG
+extendLeft(it, 'A');    // ACG
+extendRight(it, 'T');   // ACGT
+std::cout << countOccurrences(it) << std::endl;
+*/
+template <typename TText, typename TIndexSpec, typename TSpec, typename TChar>
+inline bool _extendLeftChar(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > & it,
+                            TChar c)
+{
+    if (!_extend(it.index->fwd, it.fwdRange, it.revRange, c, isRoot(it)))
+        return false;
+    ++it.repLen;
+    return true;
+}
+
+template <typename TText, typename TIndexSpec, typename TSpec, typename TPattern>
+inline bool _extendLeft(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > & it,
+                        TPattern const & pattern, True)
+{
+    typedef typename Size<TPattern const>::Type TSize;
+
+    Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > tmp = it;
+    for (TSize i = length(pattern); i > 0; --i)
+        if (!_extendLeftChar(tmp, pattern[i - 1]))
+            return false;
+    it = tmp;
+    return true;
+}
+
+template <typename TText, typename TIndexSpec, typename TSpec, typename TChar>
+inline bool _extendLeft(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > & it,
+                        TChar c, False)
+{
+    return _extendLeftChar(it, c);
+}
+
+template <typename TText, typename TIndexSpec, typename TSpec, typename TObject>
+inline bool extendLeft(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > & it,
+                       TObject const & obj)
+{
+    return _extendLeft(it, obj, typename IsSequence<TObject>::Type());
+}
+
+template <typename TText, typename TIndexSpec, typename TSpec>
+inline bool extendLeft(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > & it,
+                       char const * pattern)
+{
+    return _extendLeft(it, CharString(pattern), True());
+}
+
+// ----------------------------------------------------------------------------
+// Function extendRight
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BidirectionalIndex#extendRight
+ * @headerfile seqan/index.h
+ * @brief Extends the pattern of a bidirectional index iterator to the right.
+ *
+ * @signature bool extendRight(it, c);
+ * @signature bool extendRight(it, pattern);
+ *
+ * @param[in,out] it      The iterator.
+ * @param[in]     c       The character to append.
+ * @param[in]     pattern The string to append.
+ *
+ * @return bool <tt>true</tt> if the extended pattern occurs in the text, <tt>false</tt> otherwise.  In the latter
+ *              case the iterator is not modified.
+ */
+
+/**
+.Function.extendRight
+..summary:Extends the pattern of a bidirectional index iterator to the right.
+..cat:Index
+..signature:extendRight(it, c)
+..signature:extendRight(it, pattern)
+..param.it:An iterator of a bidirectional index.
+...type:Spec.BidirectionalIndex
+..param.c:The character to append.
+..param.pattern:The string to append.
+..returns:$true$ if the extended pattern occurs in the text, $false$ otherwise.
+In the latter case the iterator is not modified.
+...type:nolink:$bool$
+..see:Function.extendLeft
+..include:seqan/index.h
+*/
+template <typename TText, typename TIndexSpec, typename TSpec, typename TChar>
+inline bool _extendRightChar(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > & it,
+                             TChar c)
+{
+    if (!_extend(it.index->rev, it.revRange, it.fwdRange, c, isRoot(it)))
+        return false;
+    ++it.repLen;
+    return true;
+}
+
+template <typename TText, typename TIndexSpec, typename TSpec, typename TPattern>
+inline bool _extendRight(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > & it,
+                         TPattern const & pattern, True)
+{
+    typedef typename Size<TPattern const>::Type TSize;
+
+    Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > tmp = it;
+    for (TSize i = 0; i < length(pattern); ++i)
+        if (!_extendRightChar(tmp, pattern[i]))
+            return false;
+    it = tmp;
+    return true;
+}
+
+template <typename TText, typename TIndexSpec, typename TSpec, typename TChar>
+inline bool _extendRight(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > & it,
+                         TChar c, False)
+{
+    return _extendRightChar(it, c);
+}
+
+template <typename TText, typename TIndexSpec, typename TSpec, typename TObject>
+inline bool extendRight(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > & it,
+                        TObject const & obj)
+{
+    return _extendRight(it, obj, typename IsSequence<TObject>::Type());
+}
+
+template <typename TText, typename TIndexSpec, typename TSpec>
+inline bool extendRight(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > & it,
+                        char const * pattern)
+{
+    return _extendRight(it, CharString(pattern), True());
+}
+
+// ----------------------------------------------------------------------------
+// Function repLength
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec, typename TSpec>
+inline typename Size<Index<TText, BidirectionalIndex<TIndexSpec> > >::Type
+repLength(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > const & it)
+{
+    return it.repLen;
+}
+
+// ----------------------------------------------------------------------------
+// Function container
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec, typename TSpec>
+inline Index<TText, BidirectionalIndex<TIndexSpec> > const &
+container(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > const & it)
+{
+    return *it.index;
+}
+
+// ----------------------------------------------------------------------------
+// Function range
+// ----------------------------------------------------------------------------
+
+// The range refers to the suffix array of the index of the text.
+template <typename TText, typename TIndexSpec, typename TSpec>
+inline Pair<typename Size<Index<TText, BidirectionalIndex<TIndexSpec> > >::Type>
+range(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > const & it)
+{
+    return it.fwdRange;
+}
+
+// ----------------------------------------------------------------------------
+// Function countOccurrences
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec, typename TSpec>
+inline typename Size<Index<TText, BidirectionalIndex<TIndexSpec> > >::Type
+countOccurrences(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > const & it)
+{
+    return it.fwdRange.i2 - it.fwdRange.i1;
+}
+
+// ----------------------------------------------------------------------------
+// Function getOccurrences
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec, typename TSpec>
+inline typename Infix<typename Fibre<Index<TText, TIndexSpec>, FibreSA>::Type const>::Type
+getOccurrences(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > const & it)
+{
+    return infix(getFibre(it.index->fwd, FibreSA()), it.fwdRange.i1, it.fwdRange.i2);
+}
+
+// ----------------------------------------------------------------------------
+// Function findMismatches
+// ----------------------------------------------------------------------------
+
+// A search of a search scheme.  The pattern is divided into pieces which are searched in the order given by
+// pieces, the search is connected, i.e. each piece is adjacent to the already searched ones.  After the i-th piece
+// is searched the number of mismatches must lie in [minErrors[i], maxErrors[i]].
+struct SearchSchemeSearch_
+{
+    String<unsigned> pieces;
+    String<unsigned> minErrors;
+    String<unsigned> maxErrors;
+};
+
+inline void _appendSearch(String<SearchSchemeSearch_> & scheme,
+                          char const * pieces, char const * minErrors, char const * maxErrors)
+{
+    SearchSchemeSearch_ search;
+    for (unsigned i = 0; pieces[i] != 0; ++i)
+    {
+        appendValue(search.pieces, pieces[i] - '1');
+        appendValue(search.minErrors, minErrors[i] - '0');
+        appendValue(search.maxErrors, maxErrors[i] - '0');
+    }
+    appendValue(scheme, search);
+}
+
+// The schemes for one and two mismatches are the optimal ones of Kucherov et al.  For more mismatches the pattern
+// is divided into maxErrors + 1 pieces of which one must occur exactly.  The search starting with this piece
+// extends it to the right and then to the left.
+inline void _getSearchScheme(String<SearchSchemeSearch_> & scheme, unsigned maxErrors)
+{
+    clear(scheme);
+    if (maxErrors == 0)
+    {
+        _appendSearch(scheme, "1", "0", "0");
+    }
+    else if (maxErrors == 1)
+    {
+        _appendSearch(scheme, "12", "00", "01");
+        _appendSearch(scheme, "21", "01", "01");
+    }
+    else if (maxErrors == 2)
+    {
+        _appendSearch(scheme, "123", "000", "022");
+        _appendSearch(scheme, "321", "000", "012");
+        _appendSearch(scheme, "213", "011", "012");
+    }
+    else
+    {
+        for (unsigned first = 0; first <= maxErrors; ++first)
+        {
+            SearchSchemeSearch_ search;
+            for (unsigned i = first; i <= maxErrors; ++i)
+                appendValue(search.pieces, i);
+            for (unsigned i = first; i > 0; --i)
+                appendValue(search.pieces, i - 1);
+            resize(search.minErrors, maxErrors + 1, 0u);
+            resize(search.maxErrors, maxErrors + 1, maxErrors);
+            search.maxErrors[0] = 0;
+            appendValue(scheme, search);
+        }
+    }
+}
+
+template <typename TIter, typename TPattern, typename TPieceEnds, typename TDelegate>
+inline void _findMismatches(TIter const & it,
+                            TPattern const & pattern,
+                            SearchSchemeSearch_ const & search,
+                            TPieceEnds const & pieceEnds,
+                            unsigned step,
+                            unsigned patternBegin,
+                            unsigned patternEnd,
+                            unsigned errors,
+                            TDelegate & delegate)
+{
+    typedef typename Value<typename Container<TIter>::Type>::Type   TAlphabet;
+
+    // Skip the pieces which are searched completely or empty.
+    while (step < length(search.pieces))
+    {
+        unsigned piece = search.pieces[step];
+        unsigned pieceBegin = (piece == 0) ? 0 : pieceEnds[piece - 1];
+        if (pieceBegin < pieceEnds[piece] && (patternBegin > pieceBegin || patternEnd < pieceEnds[piece]))
+            break;
+        if (errors < search.minErrors[step])
+            return;
+        ++step;
+    }
+
+    if (step == length(search.pieces))
+    {
+        delegate(it, errors);
+        return;
+    }
+
+    // The piece is either right of the searched part of the pattern or left of it.
+    bool right = pieceEnds[search.pieces[step]] > patternEnd;
+    unsigned pos = right ? patternEnd : patternBegin - 1;
+    unsigned nextBegin = right ? patternBegin : patternBegin - 1;
+    unsigned nextEnd = right ? patternEnd + 1 : patternEnd;
+
+    for (unsigned ord = 0; ord < ValueSize<TAlphabet>::VALUE; ++ord)
+    {
+        TAlphabet c = TAlphabet(ord);
+        unsigned nextErrors = errors + (ordEqual(c, pattern[pos]) ? 0 : 1);
+        if (nextErrors > search.maxErrors[step])
+            continue;
+
+        TIter child = it;
+        if (right ? extendRight(child, c) : extendLeft(child, c))
+            _findMismatches(child, pattern, search, pieceEnds, step, nextBegin, nextEnd, nextErrors, delegate);
+    }
+}
+
+/*!
+ * @fn BidirectionalIndex#findMismatches
+ * @headerfile seqan/index.h
+ * @brief Searches a pattern with mismatches using search schemes.
+ *
+ * @signature void findMismatches(index, pattern, maxErrors, delegate);
+ *
+ * @param[in]     index     The bidirectional index.
+ * @param[in]     pattern   The pattern to search.
+ * @param[in]     maxErrors The maximal number of mismatches.
+ * @param[in,out] delegate  A functor called as <tt>delegate(it, errors)</tt> for each approximate match, where
+ *                          <tt>it</tt> is an iterator representing the matched text and <tt>errors</tt> the number of
+ *                          mismatches.
+ *
+ * The occurrences of a text pattern may be reported by more than one search of the scheme.
+ */
+
+/**
+.Function.findMismatches
+..summary:Searches a pattern with mismatches using search schemes.
+..cat:Index
+..signature:findMismatches(index, pattern, maxErrors, delegate)
+..param.index:The bidirectional index.
+...type:Spec.BidirectionalIndex
+..param.pattern:The pattern to search.
+..param.maxErrors:The maximal number of mismatches.
+..param.delegate:A functor called as $delegate(it, errors)$ for each approximate match, where $it$ is an iterator
+representing the matched text and $errors$ the number of mismatches.
+..remarks:The pattern is divided into pieces that are searched in different orders and with different error bounds
+such that every distribution of at most $maxErrors$ mismatches is covered, see Kucherov et al.,
+Approximate string matching using a bidirectional index, CPM 2014.
+The occurrences of a text pattern may be reported by more than one search of the scheme.
+..include:seqan/index.h
+*/
+template <typename TText, typename TIndexSpec, typename TPattern, typename TDelegate>
+inline void findMismatches(Index<TText, BidirectionalIndex<TIndexSpec> > & index,
+                           TPattern const & pattern,
+                           unsigned maxErrors,
+                           TDelegate & delegate)
+{
+    typedef Index<TText, BidirectionalIndex<TIndexSpec> >               TIndex;
+    typedef typename Iterator<TIndex, TopDown<> >::Type                 TIter;
+
+    String<SearchSchemeSearch_> scheme;
+    _getSearchScheme(scheme, maxErrors);
+
+    unsigned numPieces = length(scheme[0].pieces);
+    String<unsigned> pieceEnds;
+    for (unsigned i = 1; i <= numPieces; ++i)
+        appendValue(pieceEnds, (unsigned)((length(pattern) * i) / numPieces));
+
+    TIter root(index);
+    for (unsigned s = 0; s < length(scheme); ++s)
+    {
+        unsigned first = scheme[s].pieces[0];
+        unsigned firstBegin = (first == 0) ? 0 : pieceEnds[first - 1];
+        _findMismatches(root, pattern, scheme[s], pieceEnds, 0, firstBegin, firstBegin, 0, delegate);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function open
+// ----------------------------------------------------------------------------
+
+/**
+.Function.BidirectionalIndex#open
+..summary:This functions loads a bidirectional index from disk.
+..signature:open(index, fileName [, openMode])
+..param.index:The index.
+...type:Spec.BidirectionalIndex
+..param.fileName:C-style character string containing the file name.
+The index of the reversed text is read from files with the prefix $fileName.rev$.
+..param.openMode:The combination of flags defining how the file should be opened.
+..returns:A $bool$ which is $true$ on success.
+..include:seqan/index.h
+*/
+template <typename TText, typename TIndexSpec>
+inline bool open(Index<TText, BidirectionalIndex<TIndexSpec> > & index, const char * fileName, int openMode)
+{
+    String<char> name;
+    name = fileName;    append(name, ".rev");
+    return open(index.fwd, fileName, openMode) && open(index.rev, toCString(name), openMode);
+}
+
+template <typename TText, typename TIndexSpec>
+inline bool open(Index<TText, BidirectionalIndex<TIndexSpec> > & index, const char * fileName)
+{
+    return open(index, fileName, DefaultOpenMode<Index<TText, BidirectionalIndex<TIndexSpec> > >::VALUE);
+}
+
+// ----------------------------------------------------------------------------
+// Function save
+// ----------------------------------------------------------------------------
+
+/**
+.Function.BidirectionalIndex#save
+..summary:This functions saves a bidirectional index to disk.
+..signature:save(index, fileName [, openMode])
+..param.index:The index.
+...type:Spec.BidirectionalIndex
+..param.fileName:C-style character string containing the file name.
+The index of the reversed text is written to files with the prefix $fileName.rev$.
+..param.openMode:The combination of flags defining how the file should be opened.
+..returns:A $bool$ which is $true$ on success.
+..include:seqan/index.h
+*/
+template <typename TText, typename TIndexSpec>
+inline bool save(Index<TText, BidirectionalIndex<TIndexSpec> > const & index, const char * fileName, int openMode)
+{
+    String<char> name;
+    name = fileName;    append(name, ".rev");
+    return save(index.fwd, fileName, openMode) && save(index.rev, toCString(name), openMode);
+}
+
+template <typename TText, typename TIndexSpec>
+inline bool save(Index<TText, BidirectionalIndex<TIndexSpec> > const & index, const char * fileName)
+{
+    return save(index, fileName, DefaultOpenMode<Index<TText, BidirectionalIndex<TIndexSpec> > >::VALUE);
+}
+
+}
+#endif  // INDEX_FM_BIDIRECTIONAL_H_
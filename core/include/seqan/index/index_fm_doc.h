@@ -39,6 +39,7 @@ space efficient.
 ..param.TOccSpec:Occurrence table specialisation. 
 ...type:Tag.WT
 ...type:Tag.SBM
+...type:Tag.IBM
 ...remarks:The tags are really shortcuts for the different @Class.SentinelRankDictionary@s
 ...default:Tag.WT
 ..param.TSpec:FM index specialisation.
@@ -76,11 +77,13 @@ entries for the sentinels. The returned position correspond to the suffix array
 /**
 .Function.FMIndex#indexCreate
 ..summary:Creates a specific @Metafunction.Fibre@.
-..signature:indexCreate(index, fibreTag)
+..signature:indexCreate(index, fibreTag[, algoTag])
 ..param.index:The index to be created.
 ...type:Spec.FMIndex
 ..param.fibreTag:The fibre of the index to be computed.
 ...type:Tag.FM Index Fibres.tag.FibreSaLfTable
+..param.algoTag:The algorithm used to build the temporary suffix array, e.g. $Skew7$ or $ParallelSkew7$.
+...default:$Skew7$
 ..remarks:If you call this function on the compressed text version of the FM index
 you will get an error message: "Logic error. It is not possible to create this index without a text."
 */
@@ -559,13 +562,37 @@ actually occurring in the original text are accounted for when calling length.
 ..general:Class.RankDictionary
 ..summary:The string set bit string dictionary is a string set of rank support bit strings for constant time acces
 of the rank of a specified character at a specified position.
-..signature:SequenceBitMask<TValue>
+..signature:SequenceBitMask<TValue[, TSpec]>
 ..param.TValue:The value type of the .
+..param.TSpec:The specialisation of the @Class.RankSupportBitString@ fibres.
+...default:$void$
 ..include:seqan/index.h
 ..remarks:This data structure is optimized for very small alphabets, such as @Spec.Dna@ or @Spec.Dna5@. Consider using a @Spec.WaveletTree@ if your alphabet size is larger.
 */
 ///.Function.RankDictionary#getFibre.param.fibreTag.type:Spec.SequenceBitMask Fibres
 /**
+.Tag.IBM
+..summary:Tag that specifies the @Spec.FMIndex@ to use an interleaved bit mask as the occurrence table.
+..cat:Index
+*/
+/**
+.Spec.InterleavedBitMask:
+..cat:Index
+..general:Class.RankDictionary
+..summary:A rank dictionary storing the bit planes of the characters and the rank samples interleaved in blocks of
+one cache line.
+..signature:InterleavedBitMask<TValue[, TSpec]>
+..param.TValue:The value type of the dictionary.
+...remarks:Only alphabets of at most five characters are supported, such as @Spec.Dna@ or @Spec.Dna5@.
+..param.TSpec:The specialisation of the string of blocks.
+...default:$void$
+...remarks:Use $MMap<>$ to map the blocks of a saved dictionary into memory.
+..remarks:A block of 64 bytes stores the number of occurrences of each character before the block followed by the
+bits of the values of the next 128 (@Spec.Dna@) or 64 (@Spec.Dna5@) characters. A rank query
+(@Function.countOccurrences@) touches a single cache line and uses hardware popcount instructions.
+..include:seqan/index.h
+*/
+/**
 .Tag.WaveletTree Fibres
 ..summary:Tag to select a specific fibre (e.g. table, object, ...) of a @Spec.WaveletTree@.
 ..remarks:These tags can be used to get @Metafunction.Fibre.Fibres@ of a @Spec.WaveletTree@.
@@ -588,6 +615,7 @@ sequence.
 ..param.TSpec:The rank dictionary specialisation.
 ...type:Spec.WaveletTree
 ...type:Spec.SequenceBitMask
+...type:Spec.InterleavedBitMask
 ...default:@Spec.WaveletTree@
 ..include:seqan/index.h
 */
@@ -596,8 +624,10 @@ sequence.
 ..general:Class.RankDictionary
 ..cat:Index
 ..summary:A wavelet tree is a tree like binary encoding of a text.
-..signature:WaveletTree<TValue>
+..signature:WaveletTree<TValue[, TSpec]>
 ..param.TValue:The value type of the wavelet tree.
+..param.TSpec:The specialisation of the @Class.RankSupportBitString@ fibres.
+...default:$void$
 ..include:seqan/index.h
 ..remarks:The nodes of a wavelet tree consist of a bit string as well as a character c. In each level of the tree, 
 characters smaller than c are represented as a 0 while character greater or equal to c are represented with a 1.
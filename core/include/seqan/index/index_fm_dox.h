@@ -42,6 +42,9 @@
  * @tag FMIndexRankDictionarySpec#SBM
  * @brief Tag that specifies the @link FMIndex @endlink to use a StringSet of rank support bis strings as the occurrence table.
  *
+ * @tag FMIndexRankDictionarySpec#IBM
+ * @brief Tag that specifies the @link FMIndex @endlink to use an interleaved bit mask as the occurrence table.
+ *
  */
 
 /*!
@@ -108,7 +111,7 @@
  * 
  * @tparam TOccSpec Occurrence table specialisation.The tags are really
  *                  shortcuts for the different @link SentinelRankDictionary
- *                  @endlinks Types: @link FMIndexRankDictionarySpec#WT @endlink, @link FMIndexRankDictionarySpec#SBM @endlink, Default: @link FMIndexRankDictionarySpec#WT @endlink
+ *                  @endlinks Types: @link FMIndexRankDictionarySpec#WT @endlink, @link FMIndexRankDictionarySpec#SBM @endlink, @link FMIndexRankDictionarySpec#IBM @endlink, Default: @link FMIndexRankDictionarySpec#WT @endlink
  *
  * @tparam TSpec FM index specialisation. Types: @link FMIndexCompressionSpec#CompressText @endlink, @link FMIndexCompressionSpec#void @endlink, Default: @link FMIndexCompressionSpec#void @endlink
  *
@@ -774,7 +777,7 @@
  * @signature RankDictionary<TSpec>
  * 
  * @tparam TSpec The rank dictionary specialisation. Types: WaveletTree,
- *               SequenceBitMask Default: @link WaveletTree @endlink
+ *               SequenceBitMask, InterleavedBitMask Default: @link WaveletTree @endlink
  */
 
 /*!
@@ -786,9 +789,12 @@
  * 
  * @brief A wavelet tree is a tree like binary encoding of a text.
  * 
- * @signature template <typename TValue>
- *            RankDictionary<WaveletTree<TValue> >
+ * @signature template <typename TValue, typename TSpec>
+ *            RankDictionary<WaveletTree<TValue, TSpec> >
  * 
+ * @tparam TSpec  The specialization of the @link RankSupportBitString @endlink
+ *                fibres, e.g. <tt>MMap&lt;&gt;</tt> to map the bit strings of a
+ *                saved wavelet tree into memory.  Default: <tt>void</tt>.
  * @tparam TValue The value type of the wavelet tree.
  * 
  * @section Remarks
@@ -836,9 +842,12 @@
  *        bit strings for constant time acces of the rank of a specified
  *        character at a specified position.
  * 
- * @signature template <typename TValue>
- *            RankDictionary<SequenceBitMask<TValue> >
+ * @signature template <typename TValue, typename TSpec>
+ *            RankDictionary<SequenceBitMask<TValue, TSpec> >
  * 
+ * @tparam TSpec  The specialization of the @link RankSupportBitString @endlink
+ *                fibres, e.g. <tt>MMap&lt;&gt;</tt> to map the bit strings of a
+ *                saved dictionary into memory.  Default: <tt>void</tt>.
  * @tparam TValue The value type of the .
  * 
  * @section Remarks
@@ -848,6 +857,34 @@
  * your alphabet size is larger.
  */
 
+/*!
+ * @class InterleavedBitMask
+ *
+ * @extends RankDictionary
+ * 
+ * @headerfile seqan/index.h
+ * 
+ * @brief A rank dictionary storing the bit planes of the characters and the
+ *        rank samples interleaved in blocks of one cache line.
+ * 
+ * @signature template <typename TValue, typename TSpec>
+ *            RankDictionary<InterleavedBitMask<TValue, TSpec> >
+ * 
+ * @tparam TSpec  The specialization of the string of blocks, e.g.
+ *                <tt>MMap&lt;&gt;</tt> to map the blocks of a saved
+ *                dictionary into memory.  Default: <tt>void</tt>.
+ * @tparam TValue The value type of the dictionary.  Only alphabets of at most
+ *                five characters are supported, such as @link Dna @endlink or
+ *                @link Dna5 @endlink.
+ * 
+ * @section Remarks
+ * 
+ * A block of 64 bytes stores the number of occurrences of each character
+ * before the block followed by the bits of the values of the next 128 (Dna) or
+ * 64 (Dna5) characters.  A rank query touches a single cache line and uses
+ * hardware popcount instructions.
+ */
+
 /*!
  * @class SequenceBitMaskFibres SequenceBitMask Fibres
  * 
@@ -49,7 +49,7 @@ namespace seqan {
 // Forwards
 // ==========================================================================
 
-template <typename TValue>
+template <typename TValue, typename TSpec>
 struct WaveletTree;
 
 template<typename TValue> 
@@ -246,12 +246,12 @@ inline bool empty(LfTable<TOccTable, TPrefixSumTable> & lfTable)
 ..include:seqan/index.h
 */
 
-template <typename TValue, typename TSpec, typename TPrefixSumTable, typename TText>
-inline bool createLfTable(LfTable<SentinelRankDictionary<RankDictionary<WaveletTree<TValue> >, TSpec>, TPrefixSumTable> & lfTable, TText const text)
+template <typename TValue, typename TWaveletTreeSpec, typename TSpec, typename TPrefixSumTable, typename TText>
+inline bool createLfTable(LfTable<SentinelRankDictionary<RankDictionary<WaveletTree<TValue, TWaveletTreeSpec> >, TSpec>, TPrefixSumTable> & lfTable, TText const text)
 {
     typedef typename SAValue<TText>::Type   TSAValue;
     typedef TValue                          TAlphabet;
-    typedef typename Fibre<SentinelRankDictionary<RankDictionary<WaveletTree<TValue> >, TSpec>, FibreSentinentalPosition>::Type TDollarPos;
+    typedef typename Fibre<SentinelRankDictionary<RankDictionary<WaveletTree<TValue, TWaveletTreeSpec> >, TSpec>, FibreSentinentalPosition>::Type TDollarPos;
 
     String<TSAValue> sa;
     resize(sa, length(text), Exact());
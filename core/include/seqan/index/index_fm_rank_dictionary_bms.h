@@ -43,7 +43,7 @@ namespace seqan {
 // Forwards
 // ==========================================================================
 
-template <typename TValue>
+template <typename TValue, typename TSpec = void>
 class SequenceBitMask;
 
 template<typename TSpec> 
@@ -85,45 +85,45 @@ class SBM;
 // Metafunction Fibre
 // ----------------------------------------------------------------------------
 
-template <typename TValue>
-struct Fibre<RankDictionary<SequenceBitMask<TValue> >, FibreBitStrings>
+template <typename TValue, typename TSpec>
+struct Fibre<RankDictionary<SequenceBitMask<TValue, TSpec> >, FibreBitStrings>
 {
-    typedef StringSet<RankSupportBitString<void> > Type;
+    typedef StringSet<RankSupportBitString<TSpec> > Type;
 };
 
-template <typename TValue>
-struct Fibre<RankDictionary<SequenceBitMask<TValue> > const, FibreBitStrings>
+template <typename TValue, typename TSpec>
+struct Fibre<RankDictionary<SequenceBitMask<TValue, TSpec> > const, FibreBitStrings>
 {
-    typedef typename Fibre<RankDictionary<WaveletTree<TValue> >, FibreBitStrings>::Type const Type;
+    typedef typename Fibre<RankDictionary<SequenceBitMask<TValue, TSpec> >, FibreBitStrings>::Type const Type;
 };
 
 // ----------------------------------------------------------------------------
 // Metafunction Size
 // ----------------------------------------------------------------------------
 
-template <typename TValue>
-struct Size<RankDictionary<SequenceBitMask<TValue> > >
+template <typename TValue, typename TSpec>
+struct Size<RankDictionary<SequenceBitMask<TValue, TSpec> > >
 {
     typedef typename Size<String<TValue> >::Type Type;
 };
 
-template <typename TValue>
-struct Size<RankDictionary<SequenceBitMask<TValue> > const> :
-    public Size<RankDictionary<SequenceBitMask<TValue> > > {};
+template <typename TValue, typename TSpec>
+struct Size<RankDictionary<SequenceBitMask<TValue, TSpec> > const> :
+    public Size<RankDictionary<SequenceBitMask<TValue, TSpec> > > {};
 
 // ----------------------------------------------------------------------------
 // Metafunction Value
 // ----------------------------------------------------------------------------
 
-template <typename TValue>
-struct Value<RankDictionary<SequenceBitMask<TValue> > >
+template <typename TValue, typename TSpec>
+struct Value<RankDictionary<SequenceBitMask<TValue, TSpec> > >
 {
     typedef TValue Type;
 };
 
-template <typename TValue>
-struct Value<RankDictionary<SequenceBitMask<TValue> > const> :
-    public Value<RankDictionary<SequenceBitMask<TValue> > > {};
+template <typename TValue, typename TSpec>
+struct Value<RankDictionary<SequenceBitMask<TValue, TSpec> > const> :
+    public Value<RankDictionary<SequenceBitMask<TValue, TSpec> > > {};
 
 // ==========================================================================
 // Classes
@@ -138,15 +138,18 @@ struct Value<RankDictionary<SequenceBitMask<TValue> > const> :
 ..cat:Index
 ..summary:The string set bit string dictionary is a string set of rank support bit strings for constant time acces
 of the rank of a specified character at a specified position.
-..signature:SequenceBitMask<TValue>
+..signature:SequenceBitMask<TValue[, TSpec]>
 ..param.TValue:The value type of the .
+..param.TSpec:The specialisation of the @Class.RankSupportBitString@ fibres.
+...default:$void$
+...remarks:Use $MMap<>$ to map the bit strings of a saved dictionary into memory.
 ..include:seqan/index.h
 ..remarks:This data structure is optimized for very small alphabets, such as @Spec.Dna@ or @Spec.Dna5@. Consider using a @Spec.WaveletTree@ if your alphabet size is larger.
 */
-template <typename TValue>
-class RankDictionary<SequenceBitMask<TValue> >
+template <typename TValue, typename TSpec>
+class RankDictionary<SequenceBitMask<TValue, TSpec> >
 {
-    typedef typename Fibre<RankDictionary<SequenceBitMask<TValue> >, FibreBitStrings>::Type    TBitStrings;
+    typedef typename Fibre<RankDictionary<SequenceBitMask<TValue, TSpec> >, FibreBitStrings>::Type    TBitStrings;
 
 public:
     TBitStrings bitStrings;
@@ -179,7 +182,7 @@ public:
 
     bool operator==(RankDictionary const & b) const
     {
-        typedef typename Size<typename Fibre<RankDictionary<SequenceBitMask<TValue> >, FibreBitStrings>::Type>::Type TSize;
+        typedef typename Size<typename Fibre<RankDictionary<SequenceBitMask<TValue, TSpec> >, FibreBitStrings>::Type>::Type TSize;
         
         if (length(bitStrings) != length(b.bitStrings))
             return false;
@@ -200,8 +203,8 @@ public:
 // Function clear
 // ----------------------------------------------------------------------------
 
-template <typename TValue>
-inline void clear(RankDictionary<SequenceBitMask<TValue> > & dictionary)
+template <typename TValue, typename TSpec>
+inline void clear(RankDictionary<SequenceBitMask<TValue, TSpec> > & dictionary)
 {
     clear(getFibre(dictionary, FibreBitStrings()));
 }
@@ -210,8 +213,8 @@ inline void clear(RankDictionary<SequenceBitMask<TValue> > & dictionary)
 // Function empty
 // ----------------------------------------------------------------------------
 
-template <typename TValue>
-inline bool empty(RankDictionary<SequenceBitMask<TValue> > const & dictionary)
+template <typename TValue, typename TSpec>
+inline bool empty(RankDictionary<SequenceBitMask<TValue, TSpec> > const & dictionary)
 {
     return empty(getFibre(dictionary, FibreBitStrings()));
 }
@@ -220,11 +223,11 @@ inline bool empty(RankDictionary<SequenceBitMask<TValue> > const & dictionary)
 // Function getValue
 // ----------------------------------------------------------------------------
 
-template <typename TValue, typename TPos>
+template <typename TValue, typename TSpec, typename TPos>
 inline TValue
-getValue(RankDictionary<SequenceBitMask<TValue> > const & dictionary, TPos pos)
+getValue(RankDictionary<SequenceBitMask<TValue, TSpec> > const & dictionary, TPos pos)
 {
-    typedef typename Fibre<RankDictionary<SequenceBitMask<TValue> > const, FibreBitStrings>::Type TBitStrings;
+    typedef typename Fibre<RankDictionary<SequenceBitMask<TValue, TSpec> > const, FibreBitStrings>::Type TBitStrings;
 
     TBitStrings & bitStrings = getFibre(dictionary, FibreBitStrings());
     for (unsigned i = 0; i < ValueSize<TValue>::VALUE - 1; ++i)
@@ -234,11 +237,11 @@ getValue(RankDictionary<SequenceBitMask<TValue> > const & dictionary, TPos pos)
     return maxValue<TValue>();
 }
 
-template <typename TValue, typename TPos>
+template <typename TValue, typename TSpec, typename TPos>
 inline TValue
-getValue(RankDictionary<SequenceBitMask<TValue> > & dictionary, TPos pos)
+getValue(RankDictionary<SequenceBitMask<TValue, TSpec> > & dictionary, TPos pos)
 {
-    return getValue(const_cast<RankDictionary<SequenceBitMask<TValue> > const &>(dictionary), pos);
+    return getValue(const_cast<RankDictionary<SequenceBitMask<TValue, TSpec> > const &>(dictionary), pos);
 }
 
 // ----------------------------------------------------------------------------
@@ -246,16 +249,16 @@ getValue(RankDictionary<SequenceBitMask<TValue> > & dictionary, TPos pos)
 // ----------------------------------------------------------------------------
 
 ///.Function.RankDictionary#getFibre.param.fibreTag.type:Spec.SequenceBitMask Fibres
-template <typename TValue>
-inline typename Fibre<RankDictionary<SequenceBitMask<TValue> >, FibreBitStrings>::Type &
-getFibre(RankDictionary<SequenceBitMask<TValue> >& dictionary, FibreBitStrings)
+template <typename TValue, typename TSpec>
+inline typename Fibre<RankDictionary<SequenceBitMask<TValue, TSpec> >, FibreBitStrings>::Type &
+getFibre(RankDictionary<SequenceBitMask<TValue, TSpec> >& dictionary, FibreBitStrings)
 {
     return dictionary.bitStrings;
 }
 
-template <typename TValue>
-inline typename Fibre<RankDictionary<SequenceBitMask<TValue> >, FibreBitStrings>::Type const &
-getFibre(RankDictionary<SequenceBitMask<TValue> > const &dictionary, FibreBitStrings)
+template <typename TValue, typename TSpec>
+inline typename Fibre<RankDictionary<SequenceBitMask<TValue, TSpec> >, FibreBitStrings>::Type const &
+getFibre(RankDictionary<SequenceBitMask<TValue, TSpec> > const &dictionary, FibreBitStrings)
 {
     return dictionary.bitStrings;
 }
@@ -266,33 +269,44 @@ getFibre(RankDictionary<SequenceBitMask<TValue> > const &dictionary, FibreBitStr
 
 // This functions computes the number of occurrences of a specified character
 // up to a specified position.
-template <typename TValue, typename TCharIn, typename TPos>
-inline typename Size<RankDictionary<SequenceBitMask<TValue> > const>::Type
-countOccurrences(RankDictionary<SequenceBitMask<TValue> > const & dictionary,
+template <typename TValue, typename TSpec, typename TCharIn, typename TPos>
+inline typename Size<RankDictionary<SequenceBitMask<TValue, TSpec> > const>::Type
+countOccurrences(RankDictionary<SequenceBitMask<TValue, TSpec> > const & dictionary,
                                  TCharIn const character, TPos const pos)
 {
     return getRank(dictionary.bitStrings[ordValue(character)], pos);
 }
 
-template < typename TValue, typename TCharIn, typename TPos>
-inline typename Size<RankDictionary<SequenceBitMask<TValue> > >::Type
-countOccurrences(RankDictionary<SequenceBitMask<TValue> > & dictionary, TCharIn const character,
+template <typename TValue, typename TSpec, typename TCharIn, typename TPos>
+inline typename Size<RankDictionary<SequenceBitMask<TValue, TSpec> > >::Type
+countOccurrences(RankDictionary<SequenceBitMask<TValue, TSpec> > & dictionary, TCharIn const character,
                                  TPos const pos)
 {
-    return countOccurrences(const_cast<RankDictionary<SequenceBitMask<TValue> > const &>(dictionary), character, pos);
+    return countOccurrences(const_cast<RankDictionary<SequenceBitMask<TValue, TSpec> > const &>(dictionary), character, pos);
 
     //return getRank(dictionary.bitStrings[ordValue(character)], pos);
 }
 
+// ----------------------------------------------------------------------------
+// Function _prefetchOccurrences
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec, typename TCharIn, typename TPos>
+inline void _prefetchOccurrences(RankDictionary<SequenceBitMask<TValue, TSpec> > const & dictionary,
+                                 TCharIn const character, TPos const pos)
+{
+    _prefetchRank(dictionary.bitStrings[ordValue(character)], pos);
+}
+
 // ----------------------------------------------------------------------------
 // Function createRankDictionary
 // ----------------------------------------------------------------------------
 
 // TODO(singer): createRankDictionary
-template <typename TValue, typename TText> 
-inline void createRankDictionary(RankDictionary<SequenceBitMask<TValue> > & dictionary, TText const & text)
+template <typename TValue, typename TSpec, typename TText>
+inline void createRankDictionary(RankDictionary<SequenceBitMask<TValue, TSpec> > & dictionary, TText const & text)
 { 
-    typedef typename Fibre<RankDictionary<SequenceBitMask<TValue> >, FibreBitStrings>::Type TBitStrings;
+    typedef typename Fibre<RankDictionary<SequenceBitMask<TValue, TSpec> >, FibreBitStrings>::Type TBitStrings;
 
     TBitStrings & bitStrings = getFibre(dictionary, FibreBitStrings());
     resize(bitStrings, ValueSize<TValue>::VALUE, Exact());
@@ -307,8 +321,8 @@ inline void createRankDictionary(RankDictionary<SequenceBitMask<TValue> > & dict
         _updateRanks(bitStrings[i]);
 }
 
-template <typename TValue, typename TSpec, typename TPrefixSumTable, typename TText> 
-inline void createRankDictionary(LfTable<SentinelRankDictionary<RankDictionary<SequenceBitMask<TValue> >, TSpec >, TPrefixSumTable> & lfTable,
+template <typename TValue, typename TBitMaskSpec, typename TSpec, typename TPrefixSumTable, typename TText>
+inline void createRankDictionary(LfTable<SentinelRankDictionary<RankDictionary<SequenceBitMask<TValue, TBitMaskSpec> >, TSpec >, TPrefixSumTable> & lfTable,
                               TText const & text)
 {
     createRankDictionary(getFibre(getFibre(lfTable, FibreOccTable()), FibreRankDictionary()), text);
@@ -318,26 +332,26 @@ inline void createRankDictionary(LfTable<SentinelRankDictionary<RankDictionary<S
 // Function open
 // ----------------------------------------------------------------------------
 
-template <typename TValue>
-inline bool open(RankDictionary<SequenceBitMask<TValue> > & dictionary, const char * fileName, int openMode)
+template <typename TValue, typename TSpec>
+inline bool open(RankDictionary<SequenceBitMask<TValue, TSpec> > & dictionary, const char * fileName, int openMode)
 {
     String<char> name;
     name = fileName;    append(name, ".rd"); if (!open(getFibre(dictionary, FibreBitStrings()), toCString(name), openMode)) return false;
     return true;
 }
 
-template <typename TValue>
-inline bool open(RankDictionary<SequenceBitMask<TValue> > & dictionary, const char * fileName)
+template <typename TValue, typename TSpec>
+inline bool open(RankDictionary<SequenceBitMask<TValue, TSpec> > & dictionary, const char * fileName)
 {
-    return open(dictionary, fileName, DefaultOpenMode<RankDictionary<SequenceBitMask<TValue> > >::VALUE);
+    return open(dictionary, fileName, DefaultOpenMode<RankDictionary<SequenceBitMask<TValue, TSpec> > >::VALUE);
 }
 
 // ----------------------------------------------------------------------------
 // Function save
 // ----------------------------------------------------------------------------
 
-template <typename TValue>
-inline bool save(RankDictionary<SequenceBitMask<TValue> > const & dictionary, const char * fileName, int openMode)
+template <typename TValue, typename TSpec>
+inline bool save(RankDictionary<SequenceBitMask<TValue, TSpec> > const & dictionary, const char * fileName, int openMode)
 {
     String<char> name;
     name = fileName;    append(name, ".rd");   if (!save(getFibre(dictionary, FibreBitStrings()), toCString(name), openMode)) return false;
@@ -345,10 +359,10 @@ inline bool save(RankDictionary<SequenceBitMask<TValue> > const & dictionary, co
     return true;
 }
 
-template <typename TValue>
-inline bool save(RankDictionary<SequenceBitMask<TValue> > const & dictionary, const char * fileName)
+template <typename TValue, typename TSpec>
+inline bool save(RankDictionary<SequenceBitMask<TValue, TSpec> > const & dictionary, const char * fileName)
 {
-    return save(dictionary, fileName, DefaultOpenMode<RankDictionary<SequenceBitMask<TValue> > >::VALUE);
+    return save(dictionary, fileName, DefaultOpenMode<RankDictionary<SequenceBitMask<TValue, TSpec> > >::VALUE);
 }
 }
 #endif  // INDEX_FM_RANKDICTIONARY_SBM
@@ -0,0 +1,474 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Author: agent <agent@local>
+// ==========================================================================
+
+//SEQAN_NO_DDDOC:do not generate documentation for this file
+
+#ifndef INDEX_FM_RANK_DICTIONARY_IBM_H_
+#define INDEX_FM_RANK_DICTIONARY_IBM_H_
+
+namespace seqan {
+
+// ==========================================================================
+// Forwards
+// ==========================================================================
+
+template <typename TValue, typename TSpec = void>
+class InterleavedBitMask;
+
+template<typename TSpec>
+class RankDictionary;
+
+// ==========================================================================
+// Tags
+// ==========================================================================
+
+/**
+.Tag.IBM
+..summary:Tag that specifies the @Spec.FMIndex@ to use an interleaved bit mask as the occurrence table.
+..cat:Index
+*/
+template <typename TSpec = void>
+class IBM;
+
+// ==========================================================================
+// Classes
+// ==========================================================================
+
+// ----------------------------------------------------------------------------
+// Class InterleavedBitMaskBlock_
+// ----------------------------------------------------------------------------
+
+// A block stores the number of occurrences of each character before the block followed by the bit planes of the
+// characters in the block.  The word w of bit plane p contains the p-th bit of the values of the characters
+// w * 64, ..., w * 64 + 63 of the block.  A block fills exactly one cache line, thus a rank query touches only one
+// cache line.
+template <typename TValue>
+struct InterleavedBitMaskBlock_
+{
+    enum { VALUE_SIZE = ValueSize<TValue>::VALUE };
+    enum { BITS_PER_VALUE = BitsPerValue<TValue>::VALUE };
+    enum { WORDS_PER_PLANE = (8 - VALUE_SIZE) / BITS_PER_VALUE };
+    enum { VALUES_PER_BLOCK = WORDS_PER_PLANE * 64 };
+
+    __uint64 ranks[VALUE_SIZE];
+    __uint64 planes[WORDS_PER_PLANE][BITS_PER_VALUE];
+
+    inline bool operator==(InterleavedBitMaskBlock_ const & other) const
+    {
+        for (unsigned i = 0; i < (unsigned)VALUE_SIZE; ++i)
+            if (ranks[i] != other.ranks[i])
+                return false;
+        for (unsigned w = 0; w < (unsigned)WORDS_PER_PLANE; ++w)
+            for (unsigned p = 0; p < (unsigned)BITS_PER_VALUE; ++p)
+                if (planes[w][p] != other.planes[w][p])
+                    return false;
+        return true;
+    }
+};
+
+// ==========================================================================
+// Metafunctions
+// ==========================================================================
+
+// ----------------------------------------------------------------------------
+// Metafunction Fibre
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec>
+struct Fibre<RankDictionary<InterleavedBitMask<TValue, TSpec> >, FibreBlocks>
+{
+    typedef String<InterleavedBitMaskBlock_<TValue>,
+                   typename DefaultIndexStringSpec<RankSupportBitString<TSpec> >::Type> Type;
+};
+
+template <typename TValue, typename TSpec>
+struct Fibre<RankDictionary<InterleavedBitMask<TValue, TSpec> > const, FibreBlocks>
+{
+    typedef typename Fibre<RankDictionary<InterleavedBitMask<TValue, TSpec> >, FibreBlocks>::Type const Type;
+};
+
+// ----------------------------------------------------------------------------
+// Metafunction Size
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec>
+struct Size<RankDictionary<InterleavedBitMask<TValue, TSpec> > >
+{
+    typedef typename Size<String<TValue> >::Type Type;
+};
+
+template <typename TValue, typename TSpec>
+struct Size<RankDictionary<InterleavedBitMask<TValue, TSpec> > const> :
+    public Size<RankDictionary<InterleavedBitMask<TValue, TSpec> > > {};
+
+// ----------------------------------------------------------------------------
+// Metafunction Value
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec>
+struct Value<RankDictionary<InterleavedBitMask<TValue, TSpec> > >
+{
+    typedef TValue Type;
+};
+
+template <typename TValue, typename TSpec>
+struct Value<RankDictionary<InterleavedBitMask<TValue, TSpec> > const> :
+    public Value<RankDictionary<InterleavedBitMask<TValue, TSpec> > > {};
+
+// ----------------------------------------------------------------------------
+// Spec InterleavedBitMask
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec>
+class RankDictionary<InterleavedBitMask<TValue, TSpec> >
+{
+    typedef typename Fibre<RankDictionary<InterleavedBitMask<TValue, TSpec> >, FibreBlocks>::Type   TBlocks;
+
+public:
+    TBlocks blocks;
+    typename Size<RankDictionary>::Type _length;
+
+    RankDictionary() :
+        _length(0)
+    {}
+
+    template <typename TText>
+    RankDictionary(TText const & text) :
+        _length(0)
+    {
+        createRankDictionary(*this, text);
+    }
+
+    RankDictionary & operator=(RankDictionary const & other)
+    {
+        blocks = other.blocks;
+        _length = other._length;
+        return *this;
+    }
+
+    bool operator==(RankDictionary const & b) const
+    {
+        typedef typename Size<TBlocks>::Type TSize;
+
+        if (_length != b._length || length(blocks) != length(b.blocks))
+            return false;
+
+        for (TSize i = 0; i < length(blocks); ++i)
+            if (!(blocks[i] == b.blocks[i]))
+                return false;
+
+        return true;
+    }
+};
+
+// ==========================================================================
+// Functions
+// ==========================================================================
+
+// ----------------------------------------------------------------------------
+// Function allocate
+// ----------------------------------------------------------------------------
+
+// The blocks are aligned to cache lines.
+template <typename TValue, typename TSpec, typename TSize, typename TUsage>
+inline void
+allocate(String<InterleavedBitMaskBlock_<TValue>, Alloc<TSpec> > & /*me*/,
+         InterleavedBitMaskBlock_<TValue> * & data,
+         TSize count,
+         Tag<TUsage> const &)
+{
+#ifdef PLATFORM_WINDOWS_VS
+    data = (InterleavedBitMaskBlock_<TValue> *) _aligned_malloc(count * sizeof(InterleavedBitMaskBlock_<TValue>), 64);
+#else
+    void * ptr = NULL;
+    if (posix_memalign(&ptr, 64, count * sizeof(InterleavedBitMaskBlock_<TValue>)))
+        ptr = NULL;
+    data = (InterleavedBitMaskBlock_<TValue> *) ptr;
+#endif
+}
+
+// ----------------------------------------------------------------------------
+// Function deallocate
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec, typename TSize, typename TUsage>
+inline void
+deallocate(String<InterleavedBitMaskBlock_<TValue>, Alloc<TSpec> > & /*me*/,
+           InterleavedBitMaskBlock_<TValue> * data,
+           TSize,
+           Tag<TUsage> const)
+{
+#ifdef PLATFORM_WINDOWS_VS
+    _aligned_free((void *) data);
+#else
+    free((void *) data);
+#endif
+}
+
+// ----------------------------------------------------------------------------
+// Function clear
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec>
+inline void clear(RankDictionary<InterleavedBitMask<TValue, TSpec> > & dictionary)
+{
+    clear(getFibre(dictionary, FibreBlocks()));
+    dictionary._length = 0;
+}
+
+// ----------------------------------------------------------------------------
+// Function empty
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec>
+inline bool empty(RankDictionary<InterleavedBitMask<TValue, TSpec> > const & dictionary)
+{
+    return empty(getFibre(dictionary, FibreBlocks()));
+}
+
+// ----------------------------------------------------------------------------
+// Function length
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec>
+inline typename Size<RankDictionary<InterleavedBitMask<TValue, TSpec> > const>::Type
+length(RankDictionary<InterleavedBitMask<TValue, TSpec> > const & dictionary)
+{
+    return dictionary._length;
+}
+
+// ----------------------------------------------------------------------------
+// Function getFibre
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec>
+inline typename Fibre<RankDictionary<InterleavedBitMask<TValue, TSpec> >, FibreBlocks>::Type &
+getFibre(RankDictionary<InterleavedBitMask<TValue, TSpec> > & dictionary, FibreBlocks)
+{
+    return dictionary.blocks;
+}
+
+template <typename TValue, typename TSpec>
+inline typename Fibre<RankDictionary<InterleavedBitMask<TValue, TSpec> >, FibreBlocks>::Type const &
+getFibre(RankDictionary<InterleavedBitMask<TValue, TSpec> > const & dictionary, FibreBlocks)
+{
+    return dictionary.blocks;
+}
+
+// ----------------------------------------------------------------------------
+// Function getValue
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec, typename TPos>
+inline TValue
+getValue(RankDictionary<InterleavedBitMask<TValue, TSpec> > const & dictionary, TPos pos)
+{
+    typedef InterleavedBitMaskBlock_<TValue> TBlock;
+
+    TBlock const & block = dictionary.blocks[pos / TBlock::VALUES_PER_BLOCK];
+    unsigned posInBlock = pos % TBlock::VALUES_PER_BLOCK;
+
+    unsigned ord = 0;
+    for (unsigned p = 0; p < (unsigned)TBlock::BITS_PER_VALUE; ++p)
+        ord |= ((block.planes[posInBlock / 64][p] >> (posInBlock % 64)) & 1u) << p;
+    return TValue(ord);
+}
+
+template <typename TValue, typename TSpec, typename TPos>
+inline TValue
+getValue(RankDictionary<InterleavedBitMask<TValue, TSpec> > & dictionary, TPos pos)
+{
+    return getValue(const_cast<RankDictionary<InterleavedBitMask<TValue, TSpec> > const &>(dictionary), pos);
+}
+
+// ----------------------------------------------------------------------------
+// Function _matchingBits
+// ----------------------------------------------------------------------------
+
+// This function returns a word with the bits set at the positions of the character of the specified value.
+template <typename TValue>
+inline __uint64
+_matchingBits(InterleavedBitMaskBlock_<TValue> const & block, unsigned word, unsigned ordChar)
+{
+    __uint64 bits = ~(__uint64)0;
+    for (unsigned p = 0; p < (unsigned)InterleavedBitMaskBlock_<TValue>::BITS_PER_VALUE; ++p)
+        bits &= ((ordChar >> p) & 1u) ? block.planes[word][p] : ~block.planes[word][p];
+    return bits;
+}
+
+// ----------------------------------------------------------------------------
+// Function countOccurrences
+// ----------------------------------------------------------------------------
+
+// This functions computes the number of occurrences of a specified character
+// up to a specified position.
+template <typename TValue, typename TSpec, typename TCharIn, typename TPos>
+inline typename Size<RankDictionary<InterleavedBitMask<TValue, TSpec> > const>::Type
+countOccurrences(RankDictionary<InterleavedBitMask<TValue, TSpec> > const & dictionary,
+                 TCharIn const character, TPos const pos)
+{
+    typedef InterleavedBitMaskBlock_<TValue> TBlock;
+
+    TBlock const & block = dictionary.blocks[pos / TBlock::VALUES_PER_BLOCK];
+    unsigned posInBlock = pos % TBlock::VALUES_PER_BLOCK;
+    unsigned ordChar = ordValue(TValue(character));
+
+    // The words before the word of the position are counted completely, the words after it not at all.
+    typename Size<RankDictionary<InterleavedBitMask<TValue, TSpec> > const>::Type occ = block.ranks[ordChar];
+    __uint64 const mask = ((__uint64)2u << (posInBlock % 64)) - 1;
+    for (unsigned w = 0; w < (unsigned)TBlock::WORDS_PER_PLANE; ++w)
+    {
+        __uint64 wordMask = (w < posInBlock / 64) ? ~(__uint64)0 : ((w == posInBlock / 64) ? mask : (__uint64)0);
+        occ += popCount(_matchingBits(block, w, ordChar) & wordMask);
+    }
+    return occ;
+}
+
+template <typename TValue, typename TSpec, typename TCharIn, typename TPos>
+inline typename Size<RankDictionary<InterleavedBitMask<TValue, TSpec> > >::Type
+countOccurrences(RankDictionary<InterleavedBitMask<TValue, TSpec> > & dictionary, TCharIn const character,
+                 TPos const pos)
+{
+    return countOccurrences(const_cast<RankDictionary<InterleavedBitMask<TValue, TSpec> > const &>(dictionary),
+                            character, pos);
+}
+
+// ----------------------------------------------------------------------------
+// Function _prefetchOccurrences
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec, typename TCharIn, typename TPos>
+inline void _prefetchOccurrences(RankDictionary<InterleavedBitMask<TValue, TSpec> > const & dictionary,
+                                 TCharIn const /*character*/, TPos const pos)
+{
+    _prefetchRankValue(begin(dictionary.blocks, Standard()) + pos / InterleavedBitMaskBlock_<TValue>::VALUES_PER_BLOCK);
+}
+
+// ----------------------------------------------------------------------------
+// Function createRankDictionary
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec, typename TText>
+inline void createRankDictionary(RankDictionary<InterleavedBitMask<TValue, TSpec> > & dictionary, TText const & text)
+{
+    typedef InterleavedBitMaskBlock_<TValue>                                                        TBlock;
+    typedef typename Fibre<RankDictionary<InterleavedBitMask<TValue, TSpec> >, FibreBlocks>::Type   TBlocks;
+    typedef typename Size<TText>::Type                                                              TSize;
+
+    SEQAN_STATIC_ASSERT_MSG(TBlock::WORDS_PER_PLANE > 0 &&
+                            TBlock::VALUE_SIZE + TBlock::WORDS_PER_PLANE * TBlock::BITS_PER_VALUE == 8,
+                            "The interleaved bit mask supports only alphabets such as Dna and Dna5.");
+
+    TBlocks & blocks = getFibre(dictionary, FibreBlocks());
+    dictionary._length = length(text);
+    resize(blocks, (length(text) + TBlock::VALUES_PER_BLOCK - 1) / TBlock::VALUES_PER_BLOCK, Exact());
+
+    __uint64 ranks[TBlock::VALUE_SIZE];
+    for (unsigned c = 0; c < (unsigned)TBlock::VALUE_SIZE; ++c)
+        ranks[c] = 0;
+
+    for (TSize b = 0; b < length(blocks); ++b)
+    {
+        TBlock & block = blocks[b];
+        for (unsigned c = 0; c < (unsigned)TBlock::VALUE_SIZE; ++c)
+            block.ranks[c] = ranks[c];
+        for (unsigned w = 0; w < (unsigned)TBlock::WORDS_PER_PLANE; ++w)
+            for (unsigned p = 0; p < (unsigned)TBlock::BITS_PER_VALUE; ++p)
+                block.planes[w][p] = 0;
+
+        TSize blockEnd = _min((b + 1) * TBlock::VALUES_PER_BLOCK, length(text));
+        for (TSize i = b * TBlock::VALUES_PER_BLOCK; i < blockEnd; ++i)
+        {
+            unsigned ordChar = ordValue(TValue(text[i]));
+            unsigned posInBlock = i % TBlock::VALUES_PER_BLOCK;
+            for (unsigned p = 0; p < (unsigned)TBlock::BITS_PER_VALUE; ++p)
+                block.planes[posInBlock / 64][p] |= (__uint64)((ordChar >> p) & 1u) << (posInBlock % 64);
+            ++ranks[ordChar];
+        }
+    }
+}
+
+template <typename TValue, typename TBitMaskSpec, typename TSpec, typename TPrefixSumTable, typename TText>
+inline void createRankDictionary(LfTable<SentinelRankDictionary<RankDictionary<InterleavedBitMask<TValue, TBitMaskSpec> >, TSpec >, TPrefixSumTable> & lfTable,
+                              TText const & text)
+{
+    createRankDictionary(getFibre(getFibre(lfTable, FibreOccTable()), FibreRankDictionary()), text);
+}
+
+// ----------------------------------------------------------------------------
+// Function open
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec>
+inline bool open(RankDictionary<InterleavedBitMask<TValue, TSpec> > & dictionary, const char * fileName, int openMode)
+{
+    String<__uint64> lengthString;
+
+    String<char> name;
+    name = fileName;    append(name, ".rd");    if (!open(getFibre(dictionary, FibreBlocks()), toCString(name), openMode)) return false;
+    name = fileName;    append(name, ".rdl");   if (!open(lengthString, toCString(name), openMode) || empty(lengthString)) return false;
+    dictionary._length = lengthString[0];
+    return true;
+}
+
+template <typename TValue, typename TSpec>
+inline bool open(RankDictionary<InterleavedBitMask<TValue, TSpec> > & dictionary, const char * fileName)
+{
+    return open(dictionary, fileName, DefaultOpenMode<RankDictionary<InterleavedBitMask<TValue, TSpec> > >::VALUE);
+}
+
+// ----------------------------------------------------------------------------
+// Function save
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec>
+inline bool save(RankDictionary<InterleavedBitMask<TValue, TSpec> > const & dictionary, const char * fileName, int openMode)
+{
+    String<__uint64> lengthString;
+    appendValue(lengthString, dictionary._length);
+
+    String<char> name;
+    name = fileName;    append(name, ".rd");    if (!save(getFibre(dictionary, FibreBlocks()), toCString(name), openMode)) return false;
+    name = fileName;    append(name, ".rdl");   if (!save(lengthString, toCString(name), openMode)) return false;
+    return true;
+}
+
+template <typename TValue, typename TSpec>
+inline bool save(RankDictionary<InterleavedBitMask<TValue, TSpec> > const & dictionary, const char * fileName)
+{
+    return save(dictionary, fileName, DefaultOpenMode<RankDictionary<InterleavedBitMask<TValue, TSpec> > >::VALUE);
+}
+
+}
+#endif  // INDEX_FM_RANK_DICTIONARY_IBM_H_
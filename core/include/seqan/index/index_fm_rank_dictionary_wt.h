@@ -49,7 +49,7 @@ struct FibreDollarPosition_;
 struct FibreOccTable_;
 struct FibreRankDictionary_;
 
-template <typename TValue>
+template <typename TValue, typename TSpec>
 struct WaveletTree;
 
 // ==========================================================================
@@ -89,7 +89,7 @@ typedef Tag<FibreRankDictionary_> const FibreRankDictionary;
 /*
 .Metafunction.Fibre:
 ..summary:Type of a specific FMIndex member (fibre).
-..signature:Fibre<RankDictionary<WaveletTree<TValue> >, TFibreSpec>::Type
+..signature:Fibre<RankDictionary<WaveletTree<TValue, TSpec> >, TFibreSpec>::Type
 ..class:Spec.FMIndex
 ..cat:Index
 ..param.TValue:The character type of the @Class.String@ the wavelet tree represents.
@@ -103,58 +103,58 @@ To get a reference or the type of a specific fibre use @Function.getFibre@ or @M
 ..include:seqan/index.h
 */
 
-template <typename TValue>
-struct Fibre<RankDictionary<WaveletTree<TValue> >, FibreBitStrings>
+template <typename TValue, typename TSpec>
+struct Fibre<RankDictionary<WaveletTree<TValue, TSpec> >, FibreBitStrings>
 {
-    typedef StringSet<RankSupportBitString<void> > Type;
+    typedef StringSet<RankSupportBitString<TSpec> > Type;
 };
 
-template <typename TValue>
-struct Fibre<RankDictionary<WaveletTree<TValue> > const, FibreBitStrings>
+template <typename TValue, typename TSpec>
+struct Fibre<RankDictionary<WaveletTree<TValue, TSpec> > const, FibreBitStrings>
 {
-    typedef typename Fibre<RankDictionary<WaveletTree<TValue> >, FibreBitStrings>::Type const Type;
+    typedef typename Fibre<RankDictionary<WaveletTree<TValue, TSpec> >, FibreBitStrings>::Type const Type;
 };
 
-template <typename TValue>
-struct Fibre<RankDictionary<WaveletTree<TValue> >, FibreTreeStructure>
+template <typename TValue, typename TSpec>
+struct Fibre<RankDictionary<WaveletTree<TValue, TSpec> >, FibreTreeStructure>
 {
     typedef typename MakeUnsigned<TValue>::Type TUChar_;
     typedef RightArrayBinaryTree<TUChar_, void>  Type;
 };
 
-template <typename TValue>
-struct Fibre<RankDictionary<WaveletTree<TValue> > const, FibreTreeStructure>
+template <typename TValue, typename TSpec>
+struct Fibre<RankDictionary<WaveletTree<TValue, TSpec> > const, FibreTreeStructure>
 {
-    typedef typename Fibre<RankDictionary<WaveletTree<TValue> >, FibreTreeStructure>::Type const Type;
+    typedef typename Fibre<RankDictionary<WaveletTree<TValue, TSpec> >, FibreTreeStructure>::Type const Type;
 };
 
 // ----------------------------------------------------------------------------
 // Metafunction Size
 // ----------------------------------------------------------------------------
  
-template <typename TValue>
-struct Size<RankDictionary<WaveletTree<TValue> > >
+template <typename TValue, typename TSpec>
+struct Size<RankDictionary<WaveletTree<TValue, TSpec> > >
 {
     typedef typename Size<String<TValue> >::Type Type;
 };
 
-template <typename TValue>
-struct Size<RankDictionary<WaveletTree<TValue> > const> :
-    public Size<RankDictionary<WaveletTree<TValue> > > {};
+template <typename TValue, typename TSpec>
+struct Size<RankDictionary<WaveletTree<TValue, TSpec> > const> :
+    public Size<RankDictionary<WaveletTree<TValue, TSpec> > > {};
 
 // ----------------------------------------------------------------------------
 // Metafunction Value
 // ----------------------------------------------------------------------------
 
-template <typename TValue>
-struct Value<RankDictionary<WaveletTree<TValue> > >
+template <typename TValue, typename TSpec>
+struct Value<RankDictionary<WaveletTree<TValue, TSpec> > >
 {
     typedef TValue Type;
 };
 
-template <typename TValue>
-struct Value<RankDictionary<WaveletTree<TValue> > const> :
-    public Value<RankDictionary<WaveletTree<TValue> > > {};
+template <typename TValue, typename TSpec>
+struct Value<RankDictionary<WaveletTree<TValue, TSpec> > const> :
+    public Value<RankDictionary<WaveletTree<TValue, TSpec> > > {};
 
 
 // ==========================================================================
@@ -188,8 +188,11 @@ class RankDictionary;
 .Spec.WaveletTree:
 ..cat:Index
 ..summary:A wavelet tree is a tree like binary encoding of a text.
-..signature:WaveletTree<TValue>
+..signature:WaveletTree<TValue[, TSpec]>
 ..param.TValue:The value type of the wavelet tree.
+..param.TSpec:The specialisation of the @Class.RankSupportBitString@ fibres.
+...default:$void$
+...remarks:Use $MMap<>$ to map the bit strings of a saved wavelet tree into memory.
 ..include:seqan/index.h
 ..remarks:The nodes of a wavelet tree consist of a bit string as well as a character c. In each level of the tree, 
 characters smaller than c are represented as a 0 while character greater or equal to c are represented with a 1.
@@ -197,11 +200,11 @@ The characters represented by a 0 form the string to be represented by the left
 by a 1 form the string of the right subtree. Therefore, only the bit string of the root node represents all characters while all other nodes represent subsets.
 */
 
-template <typename TValue>
-class RankDictionary<WaveletTree<TValue> >
+template <typename TValue, typename TSpec>
+class RankDictionary<WaveletTree<TValue, TSpec> >
 {
-    typedef typename Fibre<RankDictionary<WaveletTree<TValue> >, FibreBitStrings>::Type    TBitStrings;
-    typedef typename Fibre<RankDictionary<WaveletTree<TValue> >, FibreTreeStructure>::Type TWaveletTreeStructure;
+    typedef typename Fibre<RankDictionary<WaveletTree<TValue, TSpec> >, FibreBitStrings>::Type    TBitStrings;
+    typedef typename Fibre<RankDictionary<WaveletTree<TValue, TSpec> >, FibreTreeStructure>::Type TWaveletTreeStructure;
 
 public:
     TBitStrings bitStrings;
@@ -236,7 +239,7 @@ public:
 
     bool operator==(RankDictionary const & b) const
     {
-        typedef typename Size<typename Fibre<RankDictionary<WaveletTree<TValue> >, FibreBitStrings>::Type>::Type TSize;
+        typedef typename Size<typename Fibre<RankDictionary<WaveletTree<TValue, TSpec> >, FibreBitStrings>::Type>::Type TSize;
         
         if (length(bitStrings) != length(b.bitStrings))
             return false;
@@ -267,8 +270,8 @@ public:
 ..include:seqan/index.h
 */
 
-template <typename TValue>
-inline void clear(RankDictionary<WaveletTree<TValue> > & dictionary)
+template <typename TValue, typename TSpec>
+inline void clear(RankDictionary<WaveletTree<TValue, TSpec> > & dictionary)
 {
     clear(getFibre(dictionary, FibreBitStrings()));
     clear(getFibre(dictionary, FibreTreeStructure()));
@@ -289,8 +292,8 @@ inline void clear(RankDictionary<WaveletTree<TValue> > & dictionary)
 ..include:seqan/index.h
 */
 
-template <typename TValue>
-inline bool empty(RankDictionary<WaveletTree<TValue> > const & dictionary)
+template <typename TValue, typename TSpec>
+inline bool empty(RankDictionary<WaveletTree<TValue, TSpec> > const & dictionary)
 {
     return empty(getFibre(dictionary, FibreTreeStructure()));
 }
@@ -310,12 +313,12 @@ inline bool empty(RankDictionary<WaveletTree<TValue> > const & dictionary)
 ..include:seqan/index.h
 */
 
-template <typename TValue, typename TPos>
+template <typename TValue, typename TSpec, typename TPos>
 inline TValue
-getValue(RankDictionary<WaveletTree<TValue> > & dictionary,
+getValue(RankDictionary<WaveletTree<TValue, TSpec> > & dictionary,
                  TPos pos)
 {
-    typedef typename Fibre<RankDictionary<WaveletTree<TValue> >, FibreTreeStructure>::Type const    TWaveletTreeStructure;
+    typedef typename Fibre<RankDictionary<WaveletTree<TValue, TSpec> >, FibreTreeStructure>::Type const    TWaveletTreeStructure;
     typedef typename Fibre<TWaveletTreeStructure, FibreTreeStructureEncoding>::Type                 TWaveletTreeStructureString;
     typedef typename Value<TWaveletTreeStructureString>::Type                                       TWaveletTreeStructureEntry;
     typedef typename Value<TWaveletTreeStructureEntry, 1>::Type                                     TChar;
@@ -352,11 +355,11 @@ getValue(RankDictionary<WaveletTree<TValue> > & dictionary,
 }
 
 // TODO(singer): We would like to have only one variant BUT there is a getValue() with const.
-template <typename TValue, typename TPos>
+template <typename TValue, typename TSpec, typename TPos>
 inline TValue
-getValue(RankDictionary<WaveletTree<TValue> > const & tree, TPos pos)
+getValue(RankDictionary<WaveletTree<TValue, TSpec> > const & tree, TPos pos)
 {
-    return getValue(const_cast<RankDictionary<WaveletTree<TValue> > &>(tree), pos);
+    return getValue(const_cast<RankDictionary<WaveletTree<TValue, TSpec> > &>(tree), pos);
 }
 
 // ----------------------------------------------------------------------------
@@ -376,30 +379,30 @@ getValue(RankDictionary<WaveletTree<TValue> > const & tree, TPos pos)
 ..returns:A reference to the @Metafunction.Fibre@ object.
 ..include:seqan/index.h
 */
-template <typename TValue>
-inline typename Fibre<RankDictionary<WaveletTree<TValue> >, FibreBitStrings>::Type &
-getFibre(RankDictionary<WaveletTree<TValue> >& dictionary, const FibreBitStrings)
+template <typename TValue, typename TSpec>
+inline typename Fibre<RankDictionary<WaveletTree<TValue, TSpec> >, FibreBitStrings>::Type &
+getFibre(RankDictionary<WaveletTree<TValue, TSpec> >& dictionary, const FibreBitStrings)
 {
     return dictionary.bitStrings;
 }
 
-template <typename TValue>
-inline typename Fibre<RankDictionary<WaveletTree<TValue> >, FibreBitStrings>::Type const &
-getFibre(RankDictionary<WaveletTree<TValue> > const & dictionary, const FibreBitStrings)
+template <typename TValue, typename TSpec>
+inline typename Fibre<RankDictionary<WaveletTree<TValue, TSpec> >, FibreBitStrings>::Type const &
+getFibre(RankDictionary<WaveletTree<TValue, TSpec> > const & dictionary, const FibreBitStrings)
 {
     return dictionary.bitStrings;
 }
 
-template <typename TValue>
-inline typename Fibre<RankDictionary<WaveletTree<TValue> >, FibreTreeStructure>::Type &
-getFibre(RankDictionary<WaveletTree<TValue> >& dictionary, FibreTreeStructure)
+template <typename TValue, typename TSpec>
+inline typename Fibre<RankDictionary<WaveletTree<TValue, TSpec> >, FibreTreeStructure>::Type &
+getFibre(RankDictionary<WaveletTree<TValue, TSpec> >& dictionary, FibreTreeStructure)
 {
     return dictionary.waveletTreeStructure;
 }
 
-template <typename TValue>
-inline typename Fibre<RankDictionary<WaveletTree<TValue> >, FibreTreeStructure>::Type const &
-getFibre(RankDictionary<WaveletTree<TValue> > const & dictionary, const FibreTreeStructure)
+template <typename TValue, typename TSpec>
+inline typename Fibre<RankDictionary<WaveletTree<TValue, TSpec> >, FibreTreeStructure>::Type const &
+getFibre(RankDictionary<WaveletTree<TValue, TSpec> > const & dictionary, const FibreTreeStructure)
 {
     return dictionary.waveletTreeStructure;
 }
@@ -423,11 +426,11 @@ getFibre(RankDictionary<WaveletTree<TValue> > const & dictionary, const FibreTre
 ..include:seqan/index.h
 */
 
-template < typename TValue, typename TCharIn, typename TPos>
-inline unsigned countOccurrences(RankDictionary<WaveletTree<TValue> > const & tree, TCharIn const character,
+template <typename TValue, typename TSpec, typename TCharIn, typename TPos>
+inline unsigned countOccurrences(RankDictionary<WaveletTree<TValue, TSpec> > const & tree, TCharIn const character,
                                    TPos const pos)
 {
-    typedef typename Fibre<RankDictionary<WaveletTree<TValue> >, FibreTreeStructure>::Type TWaveletTreeStructure;
+    typedef typename Fibre<RankDictionary<WaveletTree<TValue, TSpec> >, FibreTreeStructure>::Type TWaveletTreeStructure;
     typedef typename Fibre<TWaveletTreeStructure, FibreTreeStructureEncoding>::Type TWaveletTreeStructureString;
     typedef typename Value<TWaveletTreeStructureString>::Type TWaveletTreeStructureEntry;
     typedef typename Value<TWaveletTreeStructureEntry, 1>::Type TChar;
@@ -468,19 +471,32 @@ inline unsigned countOccurrences(RankDictionary<WaveletTree<TValue> > const & tr
     return 0;
 }
 
+// ----------------------------------------------------------------------------
+// Function _prefetchOccurrences
+// ----------------------------------------------------------------------------
+
+// Only the bit string of the root can be prefetched, the nodes below depend on its rank.
+template <typename TValue, typename TSpec, typename TCharIn, typename TPos>
+inline void _prefetchOccurrences(RankDictionary<WaveletTree<TValue, TSpec> > const & tree, TCharIn const /*character*/,
+                                 TPos const pos)
+{
+    if (!empty(tree.bitStrings))
+        _prefetchRank(tree.bitStrings[0], pos);
+}
+
 // ----------------------------------------------------------------------------
 // Function _fillWaveletTree
 // ----------------------------------------------------------------------------
 
 // This function is used to fill the bit strings of the wavelet tree.
-template <typename TValue, typename TText>
-inline void _fillWaveletTree(RankDictionary<WaveletTree<TValue> > & tree, TText const & text)
+template <typename TValue, typename TSpec, typename TText>
+inline void _fillWaveletTree(RankDictionary<WaveletTree<TValue, TSpec> > & tree, TText const & text)
 {
-    typedef typename Fibre<RankDictionary<WaveletTree<TValue> >, FibreBitStrings>::Type     TFibreRankSupportBitStrings;
+    typedef typename Fibre<RankDictionary<WaveletTree<TValue, TSpec> >, FibreBitStrings>::Type     TFibreRankSupportBitStrings;
     typedef typename Value<TFibreRankSupportBitStrings>::Type                               TFibreRankSupportBitString;
     typedef typename Fibre<TFibreRankSupportBitString, FibreBits>::Type                     TFibreBitString;
     typedef typename Size<TFibreBitString>::Type                                            TSize;
-    typedef typename Fibre<RankDictionary<WaveletTree<TValue> >, FibreTreeStructure>::Type  TWaveletTreeStructure;
+    typedef typename Fibre<RankDictionary<WaveletTree<TValue, TSpec> >, FibreTreeStructure>::Type  TWaveletTreeStructure;
 
     resize(tree.bitStrings, _length(tree.waveletTreeStructure), Exact());
 
@@ -530,15 +546,15 @@ inline void _fillWaveletTree(RankDictionary<WaveletTree<TValue> > & tree, TText
 */
 
 // TODO(singer): change to createRankDictionary
-template <typename TValue, typename TText> 
-inline void createRankDictionary(RankDictionary<WaveletTree<TValue> > & dictionary, TText const & text)
+template <typename TValue, typename TSpec, typename TText>
+inline void createRankDictionary(RankDictionary<WaveletTree<TValue, TSpec> > & dictionary, TText const & text)
 {
     createRightArrayBinaryTree(getFibre(dictionary, FibreTreeStructure()), text);
     _fillWaveletTree(dictionary, text);
 }
 
-template <typename TValue, typename TSpec, typename TPrefixSumTable, typename TText> 
-inline void createRankDictionary(LfTable<SentinelRankDictionary<RankDictionary<WaveletTree<TValue> >, TSpec >, TPrefixSumTable> & lfTable,
+template <typename TValue, typename TWaveletTreeSpec, typename TSpec, typename TPrefixSumTable, typename TText>
+inline void createRankDictionary(LfTable<SentinelRankDictionary<RankDictionary<WaveletTree<TValue, TWaveletTreeSpec> >, TSpec >, TPrefixSumTable> & lfTable,
                               TText const & text)
 {
     createRightArrayBinaryTree(lfTable);
@@ -567,8 +583,8 @@ inline void createRankDictionary(LfTable<SentinelRankDictionary<RankDictionary<W
 ..include:seqan/index.h
 */
 
-template <typename TValue>
-inline bool open(RankDictionary<WaveletTree<TValue> > & dictionary, const char * fileName, int openMode)
+template <typename TValue, typename TSpec>
+inline bool open(RankDictionary<WaveletTree<TValue, TSpec> > & dictionary, const char * fileName, int openMode)
 {
     String<char> name;
     name = fileName;    append(name, ".wtc"); if (!open(getFibre(dictionary, FibreBitStrings()), toCString(name), openMode)) return false;
@@ -576,10 +592,10 @@ inline bool open(RankDictionary<WaveletTree<TValue> > & dictionary, const char *
     return true;
 }
 
-    template <typename TValue>
-inline bool open(RankDictionary<WaveletTree<TValue> > & tree, const char * fileName)
+    template <typename TValue, typename TSpec>
+inline bool open(RankDictionary<WaveletTree<TValue, TSpec> > & tree, const char * fileName)
 {
-    return open(tree, fileName, DefaultOpenMode<RankDictionary<WaveletTree<TValue> > >::VALUE);
+    return open(tree, fileName, DefaultOpenMode<RankDictionary<WaveletTree<TValue, TSpec> > >::VALUE);
 }
 
 // ----------------------------------------------------------------------------
@@ -604,8 +620,8 @@ inline bool open(RankDictionary<WaveletTree<TValue> > & tree, const char * fileN
 ..include:seqan/index.h
 */
 
-template <typename TValue>
-inline bool save(RankDictionary<WaveletTree<TValue> > const & dictionary, const char * fileName, int openMode)
+template <typename TValue, typename TSpec>
+inline bool save(RankDictionary<WaveletTree<TValue, TSpec> > const & dictionary, const char * fileName, int openMode)
 {
     String<char> name;
     name = fileName;    append(name, ".wtc");   
@@ -617,10 +633,10 @@ inline bool save(RankDictionary<WaveletTree<TValue> > const & dictionary, const
     return true;
 }
 
-template <typename TValue>
-inline bool save(RankDictionary<WaveletTree<TValue> > const & tree, const char * fileName)
+template <typename TValue, typename TSpec>
+inline bool save(RankDictionary<WaveletTree<TValue, TSpec> > const & tree, const char * fileName)
 {
-    return save(tree, fileName, DefaultOpenMode<RankDictionary<WaveletTree<TValue> > >::VALUE);
+    return save(tree, fileName, DefaultOpenMode<RankDictionary<WaveletTree<TValue, TSpec> > >::VALUE);
 }
 
 }
@@ -99,22 +99,30 @@ template <typename TSpec>
 struct Position<RankSupportBitString<TSpec> > :
 	Size<RankSupportBitString<TSpec> > {};
 
+// The fibres of a rank support bit string are memory mapped if TSpec is MMap<TConfig>.
+template <typename TConfig>
+struct DefaultIndexStringSpec<RankSupportBitString<MMap<TConfig> > >
+{
+    typedef MMap<TConfig> Type;
+};
+
 template <typename TSpec>
 struct Fibre<RankSupportBitString<TSpec>, FibreBits>
 {
-    typedef String<unsigned long long> Type;
+    typedef String<unsigned long long, typename DefaultIndexStringSpec<RankSupportBitString<TSpec> >::Type> Type;
 };
 
 template <typename TSpec>
 struct Fibre<RankSupportBitString<TSpec>, FibreBlocks>
 {
-    typedef String<unsigned short> Type;
+    typedef String<unsigned short, typename DefaultIndexStringSpec<RankSupportBitString<TSpec> >::Type> Type;
 };
 
 template <typename TSpec>
 struct Fibre<RankSupportBitString<TSpec>, FibreSuperBlocks>
 {
-    typedef String<typename Size<RankSupportBitString<TSpec> >::Type> Type;
+    typedef String<typename Size<RankSupportBitString<TSpec> >::Type,
+                   typename DefaultIndexStringSpec<RankSupportBitString<TSpec> >::Type> Type;
 };
 
 // ==========================================================================
@@ -128,6 +136,7 @@ struct Fibre<RankSupportBitString<TSpec>, FibreSuperBlocks>
 ..signature:RankSupportBitString<TSpec>
 ..param.TSpec:Specialisation tag.
 ...default:void
+...remarks:Use $MMap<>$ to map the fibres of a saved bit string into memory instead of reading them.
 ..remarks:The constant rank query time is achieved by evaluating precomputed subsolutions. In order to do so, the bit string is divided into blocks of length l. A super block string stores for each block of l blocks the number of bits set from the beginning. In addition a block string stores the number of bits set in each block from the start of the last super block block. Therefore it is possible to compute the result of a rank query in constant time by adding information from the bit, block and super block string.
 ..include:seqan/index.h
 */
@@ -298,6 +307,28 @@ getRank(RankSupportBitString<TSpec> const & bitString, TPos const pos)
          + _getRankInBlock(bitString, pos);
 }
 
+// ==========================================================================
+// This function issues a prefetch for the super block, block and bits needed to compute the rank of a position.
+// It is used to interleave many rank queries such that their cache misses overlap.
+template <typename TValue>
+inline void _prefetchRankValue(TValue const * ptr)
+{
+#if defined(__GNUC__)
+    __builtin_prefetch(ptr, 0, 1);
+#elif defined(PLATFORM_WINDOWS_VS)
+    _mm_prefetch(reinterpret_cast<char const *>(ptr), _MM_HINT_T1);
+#else
+    (void)ptr;
+#endif
+}
+
+template <typename TSpec, typename TPos>
+inline void _prefetchRank(RankSupportBitString<TSpec> const & bitString, TPos const pos)
+{
+    _prefetchRankValue(begin(bitString.superBlocks, Standard()) + _getSuperBlockPos(bitString, pos));
+    _prefetchRankValue(begin(bitString.blocks, Standard()) + _getBlockPos(bitString, pos));
+    _prefetchRankValue(begin(bitString.bits, Standard()) + _getBlockPos(bitString, pos));
+}
 
 /**
 .Function.empty
@@ -701,6 +732,38 @@ inline bool open(
     return open(string, fileName, OPEN_RDONLY);
 }
 
+// The number of bit strings is determined first such that the string set is resized only once. Otherwise, the
+// already opened bit strings would be copied which is expensive for memory mapped fibres.
+template <typename TSpec, typename TSetSpec>
+inline bool open(
+    StringSet<RankSupportBitString<TSpec>, TSetSpec> & strings,
+    const char * fileName,
+    int openMode)
+{
+    char id[12]; // 2^32 has 10 decimal digits + 1 (0x00)
+    String<char> name;
+    unsigned count = 0;
+    while (true)
+    {
+        sprintf(id, ".%u.bit", count);
+        name = fileName;    append(name, id);
+        if (!fileExists(toCString(name)))
+            break;
+        ++count;
+    }
+
+    clear(strings);
+    resize(strings, count, Exact());
+    for (unsigned i = 0; i < count; ++i)
+    {
+        sprintf(id, ".%u", i);
+        name = fileName;    append(name, id);
+        if (!open(strings[i], toCString(name), (openMode & ~OPEN_CREATE) | OPEN_QUIET))
+            return false;
+    }
+    return count > 0;
+}
+
 template <typename TSpec, typename TSetSpec>
 inline bool open(
     StringSet<RankSupportBitString<TSpec>, TSetSpec> & strings,
@@ -45,7 +45,7 @@ namespace seqan {
 template <typename TOccTable, typename TPrefixSumTable>
 struct LfTable;
 
-template <typename TValue>
+template <typename TValue, typename TSpec = void>
 struct WaveletTree;
 
 template<typename TValue> 
@@ -245,10 +245,10 @@ inline void createRightArrayBinaryTree(Iter<RightArrayBinaryTree<TChar, TSpec>,
 }
 
 // This function computes the wavelet tree structure contained in the lfTable.
-template < typename TValue, typename TSpec, typename TPrefixSumTable>
-inline void createRightArrayBinaryTree(LfTable<SentinelRankDictionary<RankDictionary<WaveletTree<TValue> >, TSpec>, TPrefixSumTable> & lfTable)
+template < typename TValue, typename TWaveletTreeSpec, typename TSpec, typename TPrefixSumTable>
+inline void createRightArrayBinaryTree(LfTable<SentinelRankDictionary<RankDictionary<WaveletTree<TValue, TWaveletTreeSpec> >, TSpec>, TPrefixSumTable> & lfTable)
 {
-    typedef typename Fibre<RankDictionary<WaveletTree<TValue> >, FibreTreeStructure>::Type TRightArrayBinaryTree;
+    typedef typename Fibre<RankDictionary<WaveletTree<TValue, TWaveletTreeSpec> >, FibreTreeStructure>::Type TRightArrayBinaryTree;
     TRightArrayBinaryTree & rightArrayBinaryTree = lfTable.occTable.rankDictionary.waveletTreeStructure;
 
     typename Iterator<TRightArrayBinaryTree, TopDown<ParentLinks<void> > >::Type it(rightArrayBinaryTree, 0u);
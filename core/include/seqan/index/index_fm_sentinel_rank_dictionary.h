@@ -95,16 +95,22 @@ typedef Tag<FibreSentinelPosition_> const   FibreSentinelPosition;
 // TODO(DOC)
 ///.Metafunction.Fibre.param.TSpec.type:Tag.SentinelRankDictionary Fibres
 
-template <typename TValue, typename TSpec>
-struct Fibre<SentinelRankDictionary<RankDictionary<WaveletTree<TValue> >, TSpec>, FibreRankDictionary>
+template <typename TValue, typename TWaveletTreeSpec, typename TSpec>
+struct Fibre<SentinelRankDictionary<RankDictionary<WaveletTree<TValue, TWaveletTreeSpec> >, TSpec>, FibreRankDictionary>
 {
-    typedef RankDictionary<WaveletTree<TValue> > Type;
+    typedef RankDictionary<WaveletTree<TValue, TWaveletTreeSpec> > Type;
 };
 
-template <typename TValue, typename TSpec>
-struct Fibre<SentinelRankDictionary<RankDictionary<SequenceBitMask<TValue> >, TSpec>, FibreRankDictionary>
+template <typename TValue, typename TBitMaskSpec, typename TSpec>
+struct Fibre<SentinelRankDictionary<RankDictionary<SequenceBitMask<TValue, TBitMaskSpec> >, TSpec>, FibreRankDictionary>
 {
-    typedef RankDictionary<SequenceBitMask<TValue> > Type;
+    typedef RankDictionary<SequenceBitMask<TValue, TBitMaskSpec> > Type;
+};
+
+template <typename TValue, typename TBitMaskSpec, typename TSpec>
+struct Fibre<SentinelRankDictionary<RankDictionary<InterleavedBitMask<TValue, TBitMaskSpec> >, TSpec>, FibreRankDictionary>
+{
+    typedef RankDictionary<InterleavedBitMask<TValue, TBitMaskSpec> > Type;
 };
 
 template <typename TRankDictionary, typename TSpec>
@@ -128,7 +134,14 @@ struct Fibre<SentinelRankDictionary<TRankDictionary, Sentinel> const, FibreSenti
 template <typename TRankDictionary>
 struct Fibre<SentinelRankDictionary<TRankDictionary, Sentinels>, FibreSentinelPosition>
 {
-    typedef RankSupportBitString<void> Type;
+    // The sentinel positions are stored like the bit strings of the rank dictionary, e.g. memory mapped.
+    typedef typename Value<typename Fibre<TRankDictionary, FibreBitStrings>::Type>::Type Type;
+};
+
+template <typename TValue, typename TBitMaskSpec>
+struct Fibre<SentinelRankDictionary<RankDictionary<InterleavedBitMask<TValue, TBitMaskSpec> >, Sentinels>, FibreSentinelPosition>
+{
+    typedef RankSupportBitString<TBitMaskSpec> Type;
 };
 
 template <typename TRankDictionary>
@@ -496,6 +509,29 @@ inline unsigned countOccurrences(SentinelRankDictionary<TRankDictionary, Sentine
     return occ;
 }
 
+// ----------------------------------------------------------------------------
+// Function _prefetchOccurrences
+// ----------------------------------------------------------------------------
+
+// This function prefetches the data needed by countOccurrences() without computing the rank.
+template <typename TRankDictionary, typename TChar, typename TPos>
+inline void _prefetchOccurrences(SentinelRankDictionary<TRankDictionary, Sentinel> const & dictionary,
+                                 TChar const character,
+                                 TPos const pos)
+{
+    _prefetchOccurrences(getFibre(dictionary, FibreRankDictionary()), character, pos);
+}
+
+template <typename TRankDictionary, typename TChar, typename TPos>
+inline void _prefetchOccurrences(SentinelRankDictionary<TRankDictionary, Sentinels> const & dictionary,
+                                 TChar const character,
+                                 TPos const pos)
+{
+    _prefetchOccurrences(getFibre(dictionary, FibreRankDictionary()), character, pos);
+    if (ordEqual(getSentinelSubstitute(dictionary), character))
+        _prefetchRank(getFibre(dictionary, FibreSentinelPosition()), pos);
+}
+
 // ----------------------------------------------------------------------------
 // Function getSentinelSubstitute
 // ----------------------------------------------------------------------------
@@ -124,13 +124,13 @@ struct Fibre<SparseString<TFibreValueString, TSpec> const, FibreValueString>
 template <typename TFibreValueString, typename TSpec>
 struct Fibre<SparseString<TFibreValueString, TSpec>, FibreIndicatorString>
 {
-    typedef RankSupportBitString<void> Type;
+    typedef RankSupportBitString<TSpec> Type;
 };
 
 template <typename TFibreValueString, typename TSpec>
 struct Fibre<SparseString<TFibreValueString, TSpec> const, FibreIndicatorString>
 {
-    typedef RankSupportBitString<void> const Type;
+    typedef RankSupportBitString<TSpec> const Type;
 };
 
 // ==========================================================================
@@ -168,6 +168,7 @@ struct Iterator<SparseString<TFibreValueString, TSpec> const, Rooted>:
 ..param.TValueString:The string containing the values.
 ..param.TSpec:The specialisation tag.
 ...default:void.
+...remarks:The specialisation of the @Class.RankSupportBitString@ storing the indicators, e.g. $MMap<>$.
 ..include:seqan/String.h
 */
 template <typename TValueString, typename TSpec = void>
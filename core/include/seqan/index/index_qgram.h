@@ -1511,11 +1511,17 @@ To take effect of changing the $stepSize$ the q-gram index should be empty or re
 .Function.createQGramIndex:
 ..summary:Builds a q-gram index on a sequence. 
 ..cat:Index
-..signature:createQGramIndex(index)
+..signature:createQGramIndex(index[, parallelTag])
 ..signature:createQGramIndex(sa, dir, bucketMap, text, shape, stepSize) [DEPRECATED]
 ..class:Spec.IndexQGram
 ..param.index:The q-gram index.
 ...type:Spec.IndexQGram
+..param.parallelTag:Tag to select the serial or parallel construction.
+...type:Tag.Parallel
+...default:$Serial$
+...remarks:The parallel construction splits the text into chunks with private q-gram histograms.
+It yields the same SA and Dir as the serial construction but needs one histogram of size $length(dir)$ per chunk.
+Indices with open addressing or disabled buckets are always constructed serially.
 ..param.sa:The resulting list in which all q-grams are sorted alphabetically.
 ..param.dir:The resulting array that indicates at which position in index the corresponding q-grams can be found.
 ..param.bucketMap:Stores the q-gram hashes for the openaddressing hash maps, see @Function.indexBucketMap@.
@@ -1536,11 +1542,16 @@ The resulting tables must have appropriate size before calling this function.
  * 
  * @brief Builds a q-gram index on a sequence.
  * 
- * @signature createQGramIndex(index)
+ * @signature createQGramIndex(index[, parallelTag])
  * @signature createQGramIndex(sa, dir, bucketMap, text, shape, stepSize)
  *            [DEPRECATED]
  * 
  * @param index The q-gram index. Types: @link IndexQGram @endlink
+ * @param parallelTag Tag to select the serial or parallel construction. Types: @link ParallelismTags @endlink.
+ *                    Default: <tt>Serial</tt>.  The parallel construction splits the text into chunks with private
+ *                    q-gram histograms.  It yields the same SA and Dir as the serial construction but needs one
+ *                    histogram of size <tt>length(dir)</tt> per chunk.  Indices with open addressing or disabled
+ *                    buckets are always constructed serially.
  * @param stepSize Store every <tt>stepSize</tt>'th q-gram in the index.
  * @param text The sequence.
  * @param bucketMap Stores the q-gram hashes for the openaddressing hash maps,
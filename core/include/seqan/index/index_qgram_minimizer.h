@@ -0,0 +1,360 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Author: agent <agent@local>
+// ==========================================================================
+// Q-gram index that stores only the (w,k)-minimizers of the text.
+// ==========================================================================
+
+#ifndef SEQAN_HEADER_INDEX_QGRAM_MINIMIZER_H
+#define SEQAN_HEADER_INDEX_QGRAM_MINIMIZER_H
+
+namespace SEQAN_NAMESPACE_MAIN
+{
+
+/**
+.Spec.Minimizer
+..summary:A q-gram index that stores only the (w,k)-minimizers of the text.
+..cat:Index
+..general:Spec.IndexQGram
+..signature:Index<TText, IndexQGram<TShapeSpec, Minimizer<WINDOW_SIZE> > >
+..param.TText:The text type.
+...type:Class.String
+...type:Class.StringSet
+..param.TShapeSpec:The @Class.Shape@ specialization type of the k-mers, e.g. $UngappedShape<k>$.
+..param.WINDOW_SIZE:The number $w$ of consecutive k-mers a minimizer is chosen from.
+...default:10
+..remarks:Of every $w$ consecutive k-mers of a sequence only the k-mer with the smallest (pseudo-randomized) hash value is stored,
+ties are broken by the leftmost position. Every minimizer position is stored once, which reduces the size of the
+QGramSA fibre by a factor of about $(w+1)/2$. Directory and buckets are the same as for the @Spec.IndexQGram@ index,
+i.e. @Function.getOccurrences@ and @Function.countOccurrences@ of a shape return the positions where its k-mer is a minimizer.
+..remarks:Two strings sharing a substring of length $w+k-1$ share a minimizer. Use @Function.getOccurrences@ with a pattern of at
+least that length to find all its exact occurrences.
+..remarks:The QGramCounts and QGramCountsDir fibres are not sampled and still count all k-mers.
+..example.code:
+Index<DnaString, IndexQGram<UngappedShape<12>, Minimizer<10> > > index(genome);
+String<unsigned> occs;
+getOccurrences(occs, index, read);
+..include:seqan/index.h
+*/
+/*!
+ * @class Minimizer
+ * @extends IndexQGram
+ * @headerfile <seqan/index.h>
+ * @brief A q-gram index that stores only the (w,k)-minimizers of the text.
+ *
+ * @signature template <typename TText, typename TShapeSpec, unsigned WINDOW_SIZE>
+ *            class Index<TText, IndexQGram<TShapeSpec, Minimizer<WINDOW_SIZE> > >;
+ *
+ * @tparam TText       The text type. Types: @link String @endlink, @link StringSet @endlink
+ * @tparam TShapeSpec  The @link Shape @endlink specialization type of the k-mers, e.g. <tt>UngappedShape&lt;k&gt;</tt>.
+ * @tparam WINDOW_SIZE The number <tt>w</tt> of consecutive k-mers a minimizer is chosen from. Default: 10.
+ *
+ * Of every <tt>w</tt> consecutive k-mers of a sequence only the k-mer with the smallest (pseudo-randomized) hash
+ * value is stored, ties are broken by the leftmost position.  Every minimizer position is stored once, which reduces
+ * the size of the QGramSA fibre by a factor of about <tt>(w+1)/2</tt>.  Directory and buckets are the same as for the
+ * @link IndexQGram @endlink index, i.e. @link IndexQGram#getOccurrences @endlink and
+ * @link IndexQGram#countOccurrences @endlink of a shape return the positions where its k-mer is a minimizer.
+ *
+ * Two strings sharing a substring of length <tt>w+k-1</tt> share a minimizer.  Use
+ * @link Minimizer#getOccurrences @endlink with a pattern of at least that length to find all its exact occurrences.
+ *
+ * The QGramCounts and QGramCountsDir fibres are not sampled and still count all k-mers.
+ */
+
+	template <unsigned WINDOW_SIZE = 10>
+	struct Minimizer {};
+
+    //////////////////////////////////////////////////////////////////////////////
+    // Minimizer order
+    //
+    // Ordering the k-mers by their plain hash value would prefer low complexity
+    // k-mers like AAA...A, the hash values are scrambled by an xorshift-multiply.
+
+    template <typename THashValue>
+    inline __uint64
+    _minimizerRank(THashValue hashValue)
+    {
+        __uint64 x = (__uint64)hashValue;
+        x ^= x >> 31;
+        x *= 0x7fb5d329728ea185ull;
+        x ^= x >> 27;
+        x *= 0x81dadef4bc2dd44dull;
+        x ^= x >> 33;
+        return x;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    // Enumerate the minimizers of a sequence and pass them to func
+    //
+    // A sliding window minimum over the k-mer ranks, the ring buffer holds the
+    // candidates of the current window with increasing ranks.
+
+    template <typename TSeq, typename TShape, typename TPos, typename TFunctor>
+    inline void
+    _minimizerScanSeq(TSeq const &seq, TShape &shape, unsigned windowSize, TPos &pos, TFunctor &func)
+    {
+		typedef typename Iterator<TSeq const, Standard>::Type   TIterator;
+		typedef typename Value<TShape>::Type                    THashValue;
+		typedef typename Size<TSeq>::Type                       TSize;
+        typedef Pair<THashValue, TSize>                         TCandidate;
+
+        if (empty(shape) || length(seq) < length(shape)) return;
+        TSize kmerCount = length(seq) - length(shape) + 1;
+
+        String<TCandidate> ring;
+        resize(ring, windowSize, Exact());
+        unsigned first = 0, count = 0;
+        TSize lastPos = MaxValue<TSize>::VALUE;
+
+        TIterator itText = begin(seq, Standard());
+        for (TSize i = 0; i < kmerCount; ++i, ++itText)
+        {
+            THashValue h = (i == 0)? hash(shape, itText): hashNext(shape, itText);
+            __uint64 rank = _minimizerRank(h);
+
+            // remove candidates with a greater rank, the leftmost of equal ranks stays in front
+            while (count != 0 && _minimizerRank(ring[(first + count - 1) % windowSize].i1) > rank)
+                --count;
+            // remove the candidate that left the window
+            if (count == windowSize || (count != 0 && ring[first].i2 + windowSize <= i))
+            {
+                first = (first + 1) % windowSize;
+                --count;
+            }
+            ring[(first + count) % windowSize] = TCandidate(h, i);
+            ++count;
+
+            if ((i + 1 >= windowSize || i + 1 == kmerCount) && ring[first].i2 != lastPos)
+            {
+                lastPos = ring[first].i2;
+                _qgramParallelSetPos(pos, lastPos);
+                func(ring[first].i1, pos);
+            }
+        }
+    }
+
+    template <typename TText, typename TShape, typename TSAValue, typename TFunctor>
+    inline void
+    _minimizerScan(TText const &text, TShape shape, unsigned windowSize, TSAValue, TFunctor &func)
+    {
+        TSAValue pos = 0;
+        _minimizerScanSeq(text, shape, windowSize, pos, func);
+    }
+
+    template <typename TString, typename TSpec, typename TShape, typename TSAValue, typename TFunctor>
+    inline void
+    _minimizerScan(StringSet<TString, TSpec> const &stringSet, TShape shape, unsigned windowSize, TSAValue, TFunctor &func)
+    {
+        TSAValue pos;
+        for (unsigned seqNo = 0; seqNo < length(stringSet); ++seqNo)
+        {
+            assignValueI1(pos, seqNo);
+            _minimizerScanSeq(stringSet[seqNo], shape, windowSize, pos, func);
+        }
+    }
+
+    // remember the first minimizer of a pattern
+    template <typename THashValue, typename TPos>
+    struct MinimizerFirstFunctor_
+    {
+        THashValue  hashValue;
+        TPos        pos;
+        bool        found;
+
+        MinimizerFirstFunctor_():
+            hashValue(0),
+            pos(0),
+            found(false) {}
+
+        inline void operator() (THashValue hashValue_, TPos pos_)
+        {
+            if (found) return;
+            hashValue = hashValue_;
+            pos = pos_;
+            found = true;
+        }
+    };
+
+    //////////////////////////////////////////////////////////////////////////////
+    // Index construction
+
+	template < typename TText, typename TShapeSpec, unsigned WINDOW_SIZE >
+	void createQGramIndex(Index<TText, IndexQGram<TShapeSpec, Minimizer<WINDOW_SIZE> > > &index)
+	{
+		typedef Index<TText, IndexQGram<TShapeSpec, Minimizer<WINDOW_SIZE> > >  TIndex;
+		typedef typename Fibre<TIndex, QGramSA>::Type                           TSA;
+		typedef typename Fibre<TIndex, QGramDir>::Type                          TDir;
+		typedef typename Fibre<TIndex, QGramBucketMap>::Type                    TBucketMap;
+		typedef typename Value<TSA>::Type                                       TSAValue;
+		typedef typename Iterator<TSA, Standard>::Type                          TSAIter;
+		typedef typename Iterator<TDir, Standard>::Type                         TDirIter;
+
+		TDir &dir = indexDir(index);
+
+		// 1. clear counters
+		_qgramClearDir(dir, indexBucketMap(index));
+
+		// 2. count minimizers
+        QGramCountFunctor_<TDirIter, TBucketMap> countFunc(begin(dir, Standard()), indexBucketMap(index));
+        _minimizerScan(indexText(index), indexShape(index), WINDOW_SIZE, TSAValue(), countFunc);
+
+		// 3. cumulative sum
+		resize(indexSA(index), _qgramCummulativeSum(dir, False()), Exact());
+
+		// 4. fill suffix array
+        QGramScatterFunctor_<TSAIter, TDirIter, TBucketMap> fillFunc(begin(indexSA(index), Standard()),
+                                                                     begin(dir, Standard()) + 1,
+                                                                     indexBucketMap(index));
+        _minimizerScan(indexText(index), indexShape(index), WINDOW_SIZE, TSAValue(), fillFunc);
+	}
+
+	template < typename TText, typename TShapeSpec, unsigned WINDOW_SIZE >
+	void createQGramIndex(Index<TText, IndexQGram<TShapeSpec, Minimizer<WINDOW_SIZE> > > &index, Serial)
+	{
+        createQGramIndex(index);
+	}
+
+	template < typename TText, typename TShapeSpec, unsigned WINDOW_SIZE >
+	void createQGramIndex(Index<TText, IndexQGram<TShapeSpec, Minimizer<WINDOW_SIZE> > > &index, Parallel)
+	{
+        createQGramIndex(index);
+	}
+
+	template <typename TText, typename TShapeSpec, unsigned WINDOW_SIZE, typename TParallelTag>
+	inline bool indexCreate(
+		Index<TText, IndexQGram<TShapeSpec, Minimizer<WINDOW_SIZE> > > &index,
+		FibreSADir,
+		Tag<TParallelTag>)
+	{
+		resize(indexDir(index), _fullDirLength(index), Exact());
+		createQGramIndex(index);
+		return true;
+	}
+
+	template <typename TText, typename TShapeSpec, unsigned WINDOW_SIZE>
+	inline bool indexCreate(
+		Index<TText, IndexQGram<TShapeSpec, Minimizer<WINDOW_SIZE> > > &index,
+		FibreSADir,
+		Default const)
+	{
+		return indexCreate(index, FibreSADir(), Serial());
+	}
+
+	// SA and Dir of a minimizer index can only be built together
+	template <typename TText, typename TShapeSpec, unsigned WINDOW_SIZE>
+	inline bool indexCreate(
+		Index<TText, IndexQGram<TShapeSpec, Minimizer<WINDOW_SIZE> > > &index,
+		FibreSA,
+		Default const)
+	{
+		return indexCreate(index, FibreSADir(), Serial());
+	}
+
+	template <typename TText, typename TShapeSpec, unsigned WINDOW_SIZE>
+	inline bool indexCreate(
+		Index<TText, IndexQGram<TShapeSpec, Minimizer<WINDOW_SIZE> > > &index,
+		FibreDir,
+		Default const)
+	{
+		return indexCreate(index, FibreSADir(), Serial());
+	}
+
+    //////////////////////////////////////////////////////////////////////////////
+    // Pattern lookup
+
+/**
+.Function.getOccurrences
+..signature:getOccurrences(occs, index, pattern)
+..param.occs:A container the text positions of all occurrences of $pattern$ are appended to.
+..param.pattern:A pattern of length at least $w+k-1$ (for a @Spec.Minimizer@ index).
+..remarks:The pattern is looked up by its first minimizer and all candidates are verified against the text.
+*/
+/*!
+ * @fn Minimizer#getOccurrences
+ * @headerfile <seqan/index.h>
+ * @brief Find all exact occurrences of a pattern in a minimizer index.
+ *
+ * @signature void getOccurrences(occs, index, pattern);
+ *
+ * @param[out] occs    A container the text positions of all occurrences of <tt>pattern</tt> are appended to.
+ * @param[in]  index   The minimizer index.
+ * @param[in]  pattern The pattern to search, must have length at least <tt>w+k-1</tt>.
+ *
+ * The pattern is looked up by the minimizer of its first window and all candidates are verified against the text.
+ * The occurrences are appended in the order of the QGramSA fibre.
+ */
+
+	template <typename TOccs, typename TText, typename TShapeSpec, unsigned WINDOW_SIZE, typename TPattern>
+	inline void
+	getOccurrences(
+		TOccs &occs,
+		Index<TText, IndexQGram<TShapeSpec, Minimizer<WINDOW_SIZE> > > &index,
+		TPattern const &pattern)
+	{
+		typedef Index<TText, IndexQGram<TShapeSpec, Minimizer<WINDOW_SIZE> > >  TIndex;
+		typedef typename Fibre<TIndex, QGramSA>::Type                           TSA;
+		typedef typename Fibre<TIndex, QGramShape>::Type                        TShape;
+		typedef typename Value<TSA>::Type                                       TSAValue;
+		typedef typename Value<TShape>::Type                                    THashValue;
+		typedef typename Size<TPattern>::Type                                   TPatternSize;
+		typedef typename Iterator<TSA const, Standard>::Type                    TSAIter;
+
+		indexRequire(index, QGramSADir());
+
+		TShape shape = indexShape(index);
+		TPatternSize len = length(pattern);
+		SEQAN_ASSERT_GEQ(len, (TPatternSize)(WINDOW_SIZE + length(shape) - 1));
+
+		// the first window of every occurrence has the same minimizer
+		MinimizerFirstFunctor_<THashValue, TPatternSize> func;
+		TPatternSize firstPos = 0;
+		_minimizerScanSeq(prefix(pattern, WINDOW_SIZE + length(shape) - 1), shape, WINDOW_SIZE, firstPos, func);
+		if (!func.found) return;
+
+		typename Size<typename Fibre<TIndex, QGramDir>::Type>::Type bucket = getBucket(indexBucketMap(index), func.hashValue);
+		TSAIter it = begin(indexSA(index), Standard()) + indexDir(index)[bucket];
+		TSAIter itEnd = begin(indexSA(index), Standard()) + indexDir(index)[bucket + 1];
+		for (; it != itEnd; ++it)
+		{
+			if (getSeqOffset(*it) < func.pos)
+				continue;
+			TSAValue occ = posAdd(*it, -(__int64)func.pos);
+			if (getSeqOffset(occ) + len > sequenceLength(getSeqNo(occ), indexText(index)))
+				continue;
+			if (infix(index, occ, posAdd(occ, len)) == pattern)
+				appendValue(occs, occ);
+		}
+	}
+
+}
+
+#endif //#ifndef SEQAN_HEADER_INDEX_QGRAM_MINIMIZER_H
@@ -0,0 +1,378 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Author: agent <agent@local>
+// ==========================================================================
+// Parallel counting sort construction of the q-gram index.
+// ==========================================================================
+
+#ifndef SEQAN_HEADER_INDEX_QGRAM_PARALLEL_H
+#define SEQAN_HEADER_INDEX_QGRAM_PARALLEL_H
+
+namespace SEQAN_NAMESPACE_MAIN
+{
+
+    //////////////////////////////////////////////////////////////////////////////
+    // The text is cut into chunks of consecutive q-grams (across sequence
+    // borders for string sets).  Every chunk counts its q-grams into a private
+    // histogram, the histograms are combined by a parallel prefix sum over the
+    // buckets and every chunk scatters its q-grams into its own offsets.  As the
+    // chunks of the same bucket are consecutive, the resulting SA and Dir are
+    // identical to those of the serial construction.
+    //////////////////////////////////////////////////////////////////////////////
+
+    // count q-grams into a chunk histogram
+    template <typename TCountIter, typename TBucketMap>
+    struct QGramCountFunctor_
+    {
+        TCountIter          cnt;
+        TBucketMap const    &bucketMap;
+
+        QGramCountFunctor_(TCountIter cnt_, TBucketMap const &bucketMap_):
+            cnt(cnt_),
+            bucketMap(bucketMap_) {}
+
+        template <typename THashValue, typename TPos>
+        inline void operator() (THashValue hashValue, TPos const &)
+        {
+            ++cnt[getBucket(bucketMap, hashValue, Parallel())];
+        }
+    };
+
+    // scatter q-gram positions into the SA
+    template <typename TSAIter, typename TCountIter, typename TBucketMap>
+    struct QGramScatterFunctor_
+    {
+        TSAIter             sa;
+        TCountIter          cnt;
+        TBucketMap const    &bucketMap;
+
+        QGramScatterFunctor_(TSAIter sa_, TCountIter cnt_, TBucketMap const &bucketMap_):
+            sa(sa_),
+            cnt(cnt_),
+            bucketMap(bucketMap_) {}
+
+        template <typename THashValue, typename TPos>
+        inline void operator() (THashValue hashValue, TPos const &pos)
+        {
+            sa[cnt[getBucket(bucketMap, hashValue, Parallel())]++] = pos;
+        }
+    };
+
+    //////////////////////////////////////////////////////////////////////////////
+    // q-gram limits
+    //
+    // limits[i] is the number of indexed q-grams in sequences 0..i-1
+
+    template <typename TLimits, typename TText, typename TShape, typename TStepSize>
+    inline void
+    _qgramParallelLimits(TLimits &limits, TText const &text, TShape const &shape, TStepSize stepSize)
+    {
+        resize(limits, 2, Exact());
+        limits[0] = 0;
+        limits[1] = _qgramQGramCount(text, shape, stepSize);
+    }
+
+    template <typename TLimits, typename TString, typename TSpec, typename TShape, typename TStepSize>
+    inline void
+    _qgramParallelLimits(TLimits &limits, StringSet<TString, TSpec> const &stringSet, TShape const &shape, TStepSize stepSize)
+    {
+        typedef typename Value<TLimits>::Type TSize;
+
+        resize(limits, length(stringSet) + 1, Exact());
+        TSize sum = 0;
+        limits[0] = 0;
+        for (unsigned seqNo = 0; seqNo < length(stringSet); ++seqNo)
+        {
+            if (!empty(shape) && length(stringSet[seqNo]) >= length(shape))
+                sum += (length(stringSet[seqNo]) - length(shape)) / stepSize + 1;
+            limits[seqNo + 1] = sum;
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    // Hash the q-grams [qBegin, qEnd) of a chunk and pass them to func
+
+    template <typename TPos, typename TSize>
+    inline void
+    _qgramParallelSetPos(TPos &pos, TSize i)
+    {
+        pos = i;
+    }
+
+    template <typename T1, typename T2, typename TSpec, typename TSize>
+    inline void
+    _qgramParallelSetPos(Pair<T1, T2, TSpec> &pos, TSize i)
+    {
+        assignValueI2(pos, i);
+    }
+
+    template <typename TSeq, typename TShape, typename TSize, typename TPos, typename TFunctor>
+    inline void
+    _qgramParallelScanSeq(
+        TSeq const &seq,
+        TShape &shape,
+        TSize stepSize,
+        TSize qBegin,
+        TSize qEnd,
+        TPos &pos,
+        TFunctor &func)
+    {
+		typedef typename Iterator<TSeq const, Standard>::Type TIterator;
+
+        if (qBegin >= qEnd) return;
+
+        TIterator itText = begin(seq, Standard()) + qBegin * stepSize;
+        _qgramParallelSetPos(pos, qBegin * stepSize);
+        func(hash(shape, itText), pos);
+        if (stepSize == 1)
+            for (TSize i = qBegin + 1; i < qEnd; ++i)
+            {
+                ++itText;
+                _qgramParallelSetPos(pos, i);
+                func(hashNext(shape, itText), pos);
+            }
+        else
+            for (TSize i = qBegin + 1; i < qEnd; ++i)
+            {
+                itText += stepSize;
+                _qgramParallelSetPos(pos, i * stepSize);
+                func(hash(shape, itText), pos);
+            }
+    }
+
+    template <typename TText, typename TShape, typename TLimits, typename TSize, typename TSAValue, typename TFunctor>
+    inline void
+    _qgramParallelScan(
+        TText const &text,
+        TShape shape,
+        TLimits const &,
+        TSize stepSize,
+        TSize qBegin,
+        TSize qEnd,
+        TSAValue,
+        TFunctor &func)
+    {
+        TSAValue pos = 0;
+        _qgramParallelScanSeq(text, shape, stepSize, qBegin, qEnd, pos, func);
+    }
+
+    template <typename TString, typename TSpec, typename TShape, typename TLimits, typename TSize, typename TSAValue, typename TFunctor>
+    inline void
+    _qgramParallelScan(
+        StringSet<TString, TSpec> const &stringSet,
+        TShape shape,
+        TLimits const &limits,
+        TSize stepSize,
+        TSize qBegin,
+        TSize qEnd,
+        TSAValue,
+        TFunctor &func)
+    {
+		typedef typename Iterator<TLimits const, Standard>::Type TLimitsIter;
+
+        if (qBegin >= qEnd) return;
+
+        // the sequence that contains q-gram qBegin
+        TLimitsIter itLimits = std::upper_bound(begin(limits, Standard()), end(limits, Standard()), qBegin) - 1;
+        unsigned seqNo = itLimits - begin(limits, Standard());
+
+        TSAValue pos;
+        for (; qBegin < qEnd; ++seqNo)
+        {
+            TSize seqEnd = limits[seqNo + 1];
+            assignValueI1(pos, seqNo);
+            _qgramParallelScanSeq(stringSet[seqNo], shape, stepSize,
+                                  (TSize)(qBegin - limits[seqNo]),
+                                  (TSize)(_min(qEnd, seqEnd) - limits[seqNo]),
+                                  pos, func);
+            qBegin = seqEnd;
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    // Parallel prefix sum over the chunk histograms
+    //
+    // cnt[t * dirLength + i] is the number of q-grams of bucket i in chunk t.
+    // Afterwards it is the first SA position of these q-grams and dir[i] is the
+    // beginning of bucket i.
+
+    template <typename TDir, typename TCounts, typename TSize>
+    inline void
+    _qgramParallelCummulativeSum(TDir &dir, TCounts &cnt, TSize chunks)
+    {
+        typedef typename Iterator<TCounts, Standard>::Type  TCountIter;
+        typedef typename Iterator<TDir, Standard>::Type     TDirIter;
+
+        TSize dirLength = length(dir);
+        Splitter<TSize> splitter(0, dirLength, Parallel());
+        int parts = length(splitter);
+
+        String<TSize> partSum;
+        resize(partSum, parts + 1, 0, Exact());
+
+        // sum up all counts of a range of buckets
+        SEQAN_OMP_PRAGMA(parallel for)
+        for (int p = 0; p < parts; ++p)
+        {
+            TSize sum = 0;
+            for (TSize t = 0; t < chunks; ++t)
+            {
+                TCountIter c = begin(cnt, Standard()) + t * dirLength + splitter[p];
+                TCountIter cEnd = begin(cnt, Standard()) + t * dirLength + splitter[p + 1];
+                for (; c != cEnd; ++c)
+                    sum += *c;
+            }
+            partSum[p + 1] = sum;
+        }
+
+        for (int p = 0; p < parts; ++p)
+            partSum[p + 1] += partSum[p];
+
+        // exclusive prefix sums, chunks of the same bucket are consecutive to keep the SA order
+        SEQAN_OMP_PRAGMA(parallel for)
+        for (int p = 0; p < parts; ++p)
+        {
+            TSize sum = partSum[p];
+            TDirIter d = begin(dir, Standard()) + splitter[p];
+            for (TSize i = splitter[p]; i < splitter[p + 1]; ++i, ++d)
+            {
+                *d = sum;
+                TCountIter c = begin(cnt, Standard()) + i;
+                for (TSize t = 0; t < chunks; ++t, c += dirLength)
+                {
+                    TSize tmp = *c;
+                    *c = sum;
+                    sum += tmp;
+                }
+            }
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    // Parallel q-gram index construction
+
+    // only direct addressing is supported, the bucket order of open addressing
+    // would depend on the thread schedule
+    template <typename TIndex, typename TBucketMap>
+    inline bool
+    _createQGramIndexParallel(TIndex &, TBucketMap &)
+    {
+        return false;
+    }
+
+    template <typename TIndex>
+    inline bool
+    _createQGramIndexParallel(TIndex &index, Nothing &bucketMap)
+    {
+		typedef typename Fibre<TIndex, QGramText>::Type     TText;
+		typedef typename Fibre<TIndex, QGramSA>::Type       TSA;
+		typedef typename Fibre<TIndex, QGramDir>::Type      TDir;
+		typedef typename Value<TSA>::Type                   TSAValue;
+		typedef typename Value<TDir>::Type                  TSize;
+        typedef String<TSize, Alloc<> >                     TCounts;
+		typedef typename Iterator<TCounts, Standard>::Type  TCountIter;
+		typedef typename Iterator<TSA, Standard>::Type      TSAIter;
+
+		TText const &text = indexText(index);
+		TSA         &sa   = indexSA(index);
+		TDir        &dir  = indexDir(index);
+        TSize stepSize = getStepSize(index);
+
+        if (_qgramDisableBuckets(index) || empty(indexShape(index)))
+            return false;
+
+        TCounts limits;
+        _qgramParallelLimits(limits, text, indexShape(index), stepSize);
+        TSize qgramCount = back(limits);
+
+        // the histograms of all chunks must not take more space than the SA
+        TSize dirLength = length(dir);
+        TSize chunks = _min((TSize)omp_get_max_threads(), (TSize)(qgramCount / dirLength));
+        if (chunks < 2)
+            return false;
+
+        Splitter<TSize> splitter(0, qgramCount, chunks);
+        TCounts cnt;
+        resize(cnt, chunks * dirLength, 0, Exact());
+
+        // 1+2. count q-grams per chunk
+        SEQAN_OMP_PRAGMA(parallel for)
+        for (int t = 0; t < (int)chunks; ++t)
+        {
+            QGramCountFunctor_<TCountIter, Nothing> func(begin(cnt, Standard()) + (TSize)t * dirLength, bucketMap);
+            _qgramParallelScan(text, indexShape(index), limits, stepSize, splitter[t], splitter[t + 1], TSAValue(), func);
+        }
+
+        // 3. cumulative sum
+        _qgramParallelCummulativeSum(dir, cnt, chunks);
+
+        // 4. fill suffix array
+        SEQAN_OMP_PRAGMA(parallel for)
+        for (int t = 0; t < (int)chunks; ++t)
+        {
+            QGramScatterFunctor_<TSAIter, TCountIter, Nothing> func(begin(sa, Standard()),
+                                                                   begin(cnt, Standard()) + (TSize)t * dirLength,
+                                                                   bucketMap);
+            _qgramParallelScan(text, indexShape(index), limits, stepSize, splitter[t], splitter[t + 1], TSAValue(), func);
+        }
+        return true;
+    }
+
+	template < typename TIndex >
+	void createQGramIndex(TIndex &index, Parallel)
+	{
+        if (!_createQGramIndexParallel(index, index.bucketMap))
+            createQGramIndex(index);
+	}
+
+	template < typename TIndex >
+	void createQGramIndex(TIndex &index, Serial)
+	{
+        createQGramIndex(index);
+	}
+
+	template <typename TText, typename TShapeSpec, typename TSpec, typename TParallelTag>
+	inline bool indexCreate(
+		Index<TText, IndexQGram<TShapeSpec, TSpec> > &index,
+		FibreSADir,
+		Tag<TParallelTag> parallelTag)
+	{
+		resize(indexSA(index), _qgramQGramCount(index), Exact());
+		resize(indexDir(index), _fullDirLength(index), Exact());
+		createQGramIndex(index, parallelTag);
+		resize(indexSA(index), back(indexDir(index)), Exact());     // shrink if some buckets were disabled
+		return true;
+	}
+
+}
+
+#endif //#ifndef SEQAN_HEADER_INDEX_QGRAM_PARALLEL_H
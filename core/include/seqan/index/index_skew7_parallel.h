@@ -0,0 +1,890 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Author: agent <agent@local>
+// ==========================================================================
+// Parallel in-memory variant of the Skew7 suffix array construction.
+// ==========================================================================
+
+#ifndef SEQAN_HEADER_INDEX_SKEW7_PARALLEL_H
+#define SEQAN_HEADER_INDEX_SKEW7_PARALLEL_H
+
+namespace SEQAN_NAMESPACE_MAIN
+{
+
+/**
+.Tag.ParallelSkew7
+..cat:Index
+..summary:Parallel in-memory suffix array construction based on the Skew7 (DC7) algorithm.
+..remarks:All phases of @Function.createSuffixArray@ (tuple sorting, naming, recursion and the
+7-way merge) are distributed over $omp_get_max_threads()$ threads. The peak memory consumption
+is that of the in-memory $Skew7$ algorithm plus a few counter arrays per thread.
+For external or non-contiguous strings and for string sets the external $Skew7$ algorithm is used,
+whose sorter pools sort their in-memory buckets in parallel.
+..example.code:
+Index<DnaString, IndexEsa<> > esa(genome);
+indexCreate(esa, FibreSA(), ParallelSkew7());
+..include:seqan/index.h
+*/
+/*!
+ * @tag ParallelSkew7
+ * @headerfile <seqan/index.h>
+ * @brief Parallel in-memory suffix array construction based on the Skew7 (DC7) algorithm.
+ *
+ * @signature struct ParallelSkew7;
+ *
+ * All phases of @link createSuffixArray @endlink (tuple sorting, naming, recursion and the 7-way merge) are
+ * distributed over <tt>omp_get_max_threads()</tt> threads.  The peak memory consumption is that of the in-memory
+ * Skew7 algorithm plus a few counter arrays per thread.  For external or non-contiguous strings and for string sets
+ * the external Skew7 algorithm is used, whose sorter pools sort their in-memory buckets in parallel.
+ */
+
+	struct ParallelSkew7 {};
+
+
+    //////////////////////////////////////////////////////////////////////////////
+    // parallel counting sort
+    //////////////////////////////////////////////////////////////////////////////
+
+    // key of radixPass (dec == 0) and radixExtend (dec == 1), j is sorted by r[j - dec + shift]
+    // positions beyond the end of r get the smallest key 0
+    template <typename TText, typename TSize>
+    struct Skew7CharKey_
+    {
+		typedef typename Iterator<TText const, Standard>::Type TIter;
+
+        TIter       text;
+        TSize       textLength;
+        TSize       shift;
+        TSize       dec;
+        unsigned    digitShift;
+        TSize       mask;
+
+        Skew7CharKey_(TText const &r, TSize shift_, TSize dec_, unsigned digitShift_, TSize mask_):
+            text(begin(r, Standard())),
+            textLength(length(r)),
+            shift(shift_),
+            dec(dec_),
+            digitShift(digitShift_),
+            mask(mask_) {}
+
+        inline bool skip(TSize j) const
+        {
+            return j < dec;
+        }
+
+        inline TSize value(TSize j) const
+        {
+            return j - dec;
+        }
+
+        inline TSize bucket(TSize j) const
+        {
+            TSize k = j - dec + shift;
+            TSize key = (k < textLength)? (TSize)ordValue(text[k]) + 1 : 0;
+            return (key >> digitShift) & mask;
+        }
+    };
+
+    // key of the fast tuple sort for small alphabets, j is sorted by the 7-tuple starting at r[j]
+    template <typename TText, typename TSize>
+    struct Skew7TupleKey_
+    {
+        typedef typename Value<TText>::Type                     TValue;
+		typedef typename Iterator<TText const, Standard>::Type  TIter;
+
+        Shape<TValue, UngappedShape<7> > shape;
+        TIter       text;
+        TSize       textLength;
+
+        Skew7TupleKey_(TText const &r):
+            text(begin(r, Standard())),
+            textLength(length(r)) {}
+
+        inline bool skip(TSize) const
+        {
+            return false;
+        }
+
+        inline TSize value(TSize j) const
+        {
+            return j;
+        }
+
+        inline TSize bucket(TSize j)
+        {
+            return hash2(shape, text + j, textLength - j);
+        }
+    };
+
+    // stably sort a[0..count-1] into b using the buckets of key
+    // every thread counts and scatters one chunk of a, so the result equals the serial counting sort
+    template <typename TTarget, typename TSource, typename TSize, typename TKey>
+    void _skew7ParallelCountingSort(
+        TTarget &b,
+        TSource const &a,
+        TSize count,
+        TKey const &keyProto,
+        TSize bucketCount)
+    {
+        typedef String<TSize, Alloc<> >                             TCounts;
+		typedef typename Iterator<TCounts, Standard>::Type          TCountIter;
+		typedef typename Iterator<TSource const, Standard>::Type    TSourceIter;
+		typedef typename Iterator<TTarget, Standard>::Type          TTargetIter;
+
+        if (count == 0) return;
+
+        Splitter<TSize> splitter(0, count);
+        int chunks = length(splitter);
+
+        TCounts cnt;
+        resize(cnt, (TSize)chunks * bucketCount, 0, Exact());
+
+        // count occurrences per chunk
+        SEQAN_OMP_PRAGMA(parallel for)
+        for (int t = 0; t < chunks; ++t)
+        {
+            TKey key(keyProto);
+            TCountIter c = begin(cnt, Standard()) + (TSize)t * bucketCount;
+            TSourceIter it = begin(a, Standard()) + splitter[t];
+            TSourceIter itEnd = begin(a, Standard()) + splitter[t + 1];
+            for (; it != itEnd; ++it)
+                if (!key.skip(*it))
+                    ++c[key.bucket(*it)];
+        }
+
+        // exclusive prefix sums, chunks of the same bucket are consecutive to keep the sort stable
+        TSize sum = 0;
+        for (TSize i = 0; i < bucketCount; ++i)
+        {
+            TCountIter c = begin(cnt, Standard()) + i;
+            for (int t = 0; t < chunks; ++t, c += bucketCount)
+            {
+                TSize tmp = *c;
+                *c = sum;
+                sum += tmp;
+            }
+        }
+
+        // sort
+        SEQAN_OMP_PRAGMA(parallel for)
+        for (int t = 0; t < chunks; ++t)
+        {
+            TKey key(keyProto);
+            TCountIter c = begin(cnt, Standard()) + (TSize)t * bucketCount;
+            TTargetIter target = begin(b, Standard());
+            TSourceIter it = begin(a, Standard()) + splitter[t];
+            TSourceIter itEnd = begin(a, Standard()) + splitter[t + 1];
+            for (; it != itEnd; ++it)
+                if (!key.skip(*it))
+                    target[c[key.bucket(*it)]++] = key.value(*it);
+        }
+    }
+
+    // lsb radix sort a by the characters r[j - dec + shifts[0]], ..., r[j - dec + shifts[shiftCount - 1]]
+    // (shifts[0] being the least significant) and store the result in b
+    //
+    // large alphabets (recursion levels) are split into digits of at most 16 bits to bound the size of
+    // the per-thread counters. temp must not overlap a or b and is used as ping-pong buffer.
+    template <typename TTarget, typename TSource, typename TTemp, typename TText, typename TSize>
+    void _skew7ParallelRadixSort(
+        TTarget &b,
+        TSource const &a,
+        TTemp &temp,
+        TText const &r,
+        TSize K,
+        TSize const shifts[],
+        unsigned shiftCount,
+        TSize dec)
+    {
+        typedef Skew7CharKey_<TText, TSize> TKey;
+
+        // keys are in 0..K, 0 is reserved for positions beyond the end
+        unsigned bits = 0;
+        while (bits < BitsPerValue<TSize>::VALUE && (K >> bits) != 0)
+            ++bits;
+
+        unsigned digits = 1;
+        if (bits > 16)
+            digits = (bits + 15) / 16;
+        unsigned digitBits = (bits + digits - 1) / digits;
+        TSize bucketCount = (digits == 1)? K + 1 : (TSize)1 << digitBits;
+        TSize mask = (digits == 1)? ~(TSize)0 : bucketCount - 1;
+
+        unsigned passes = shiftCount * digits;
+        TSize count = length(b);
+        for (unsigned pass = 0; pass < passes; ++pass)
+        {
+            TKey key(r, shifts[pass / digits], (pass == 0)? dec : (TSize)0, (pass % digits) * digitBits, mask);
+
+            // alternate between b and temp such that the last pass writes into b
+            bool toTarget = ((passes - 1 - pass) % 2 == 0);
+            if (pass == 0)
+            {
+                if (toTarget)
+                    _skew7ParallelCountingSort(b, a, (TSize)length(a), key, bucketCount);
+                else
+                    _skew7ParallelCountingSort(temp, a, (TSize)length(a), key, bucketCount);
+            }
+            else
+            {
+                if (toTarget)
+                    _skew7ParallelCountingSort(b, temp, count, key, bucketCount);
+                else
+                    _skew7ParallelCountingSort(temp, b, count, key, bucketCount);
+            }
+        }
+    }
+
+    template <typename TSAOut, typename TText, typename TSAIn, typename TEnable>
+    inline bool _fastTupleSortParallelSkew7(TSAOut &, TText const &, TSAIn const &, TEnable)
+    {
+        return false;
+    }
+
+    template <typename TSAOut, typename TText, typename TSAIn>
+    inline bool _fastTupleSortParallelSkew7(TSAOut &SA124, TText const &s, TSAIn const &s124, True)
+    {
+		typedef typename Value<TSAOut>::Type TSize;
+
+        // optimized tuple sort for short alphabets
+        Skew7TupleKey_<TText, TSize> key(s);
+        _skew7ParallelCountingSort(SA124, s124, (TSize)length(s124), key, (TSize)_fullDir2Length(key.shape));
+        return true;
+    }
+
+
+    //////////////////////////////////////////////////////////////////////////////
+    // parallel multiway merge
+    //////////////////////////////////////////////////////////////////////////////
+
+    // text position of the ii-th suffix of s124 (see SEQAN_GET_ISKEW7)
+    template <typename TSize>
+    inline TSize _getISkew7(TSize ii, TSize const _n[7], TSize const _o[7])
+    {
+        TSize _n24 = _n[2] + _n[4];
+        return (ii < _n[4] ? (ii * 7) + _o[4] : (ii < _n24 ? ((ii - _n[4]) * 7) + _o[2] : ((ii - _n24) * 7) + _o[1]));
+    }
+
+    // set spos, tpos, islast for the suffix with SA value j of stream 0, 1 (i.e. SA124), 3, 5 or 6
+    // and return its residue class
+    template <typename TValueIter, typename TSize>
+    inline unsigned _loadSuffixSkew7(
+        TValueIter spos[],
+        TSize tpos[],
+        bool islast[],
+        unsigned stream,
+        TSize j,
+        TValueIter textBegin,
+        TSize n,
+        TSize const _n[7],
+        TSize const _o[7])
+    {
+        unsigned a = stream;
+        if (stream == 1)
+        {
+            TSize ii = j;
+            a = (ii < _n[4] ? 4 : (ii < _n[2] + _n[4] ? 2 : 1));
+            j = _getISkew7(ii, _n, _o);
+            tpos[a] = ii;
+        }
+        else
+            tpos[a] = j / 7;
+        spos[a] = textBegin + j;
+        islast[a] = (j + 7 >= n);
+        return a;
+    }
+
+    // merge the streams [pos[i], max[i]) of SA0, SA124, SA3, SA5 and SA6 into SA[k..]
+    // this is the main merge loop of the Skew7 algorithm, pos[1], pos[2] and pos[4] point into SA124
+    template <typename TSA, typename TSize, typename TSAIter, typename TValueIter, typename TString>
+    void _mergeRangeSkew7(
+        TSA &SA,
+        TSize k,
+        TSAIter pos[7],
+        TSAIter max[7],
+        TValueIter textBegin,
+        TSize n,
+        TString const &s124,
+        TSize const adjust[7][7],
+        TSize const _n[7],
+        TSize const _o[7])
+    {
+        TValueIter spos[7];
+        TSize tpos[7];
+        bool islast[7];
+
+        int a, b, rank[5];
+        int fill = 0;
+        TSize kEnd = k + (max[0] - pos[0]) + (max[1] - pos[1]) + (max[3] - pos[3]) + (max[5] - pos[5]) + (max[6] - pos[6]);
+        if (k == kEnd) return;
+
+        // fill the stream ranking list
+        for (int i = 0; i < 7; ++i)
+        {
+            if (i == 2 || i == 4) continue; // insert only the least suffix of SA124
+            if (pos[i] == max[i]) continue;
+
+            a = _loadSuffixSkew7(spos, tpos, islast, i, (TSize)*(pos[i]), textBegin, n, _n, _o);
+
+            // get the rank of stream a's suffix
+            int j;
+            for (j = 0;  j < fill;  ++j)
+            {
+                b = rank[j];
+                if (_leqSkew7 (a,  b,   spos, tpos, islast, s124, adjust)) break;
+            }
+
+            // insert the suffix
+            for (int i = fill; i > j; --i)
+                rank[i] = rank[i - 1];
+            rank[j] = a;
+            fill++;
+        }
+
+        // main merge loop
+        while (fill > 1)
+        {
+            // add the least suffix to SA and get the next of the corresponding stream
+            a = rank[0];
+            SA[k++] = spos[a] - textBegin;
+            if (a == 1 || a == 2 || a == 4)
+                pos[4] = pos[2] = ++pos[1];
+            else
+                ++pos[a];
+
+            if (pos[a] < max[a])
+            {
+                a = _loadSuffixSkew7(spos, tpos, islast, (a == 2 || a == 4)? 1 : a, (TSize)*(pos[a]), textBegin, n, _n, _o);
+
+                // get the rank of stream a's suffix
+                int right;
+                for (right = 1;  right < fill;  right++)
+                {
+                    b = rank[right];
+                    if (_leqSkew7 (a,  b,   spos, tpos, islast, s124, adjust)) break;
+                }
+
+                // remove the least suffix ...
+                for (int i = 1; i < right; ++i)
+                    rank[i - 1] = rank[i];
+
+                // ... and insert the new one
+                rank[right - 1] = a;
+            }
+            else
+            {
+                // only remove the least suffix
+                fill--;
+                for (int i = 0; i < fill; ++i)
+                    rank[i] = rank[i + 1];
+            }
+        }
+
+        // only one stream left to fill SA with
+        a = rank[0];
+        if (a == 1 || a == 2 || a == 4)
+            for (;  k < kEnd;  ++k) SA[k] = _getISkew7((TSize)*(pos[1]++), _n, _o);
+        else
+            for (;  k < kEnd;  ++k) SA[k] = *(pos[a]++);
+    }
+
+    // bound[y] is the number of suffixes of stream y that are less than the m-th suffix of stream x
+    // only the ranges [lo[y], hi[y]) are searched
+    template <typename TSize, typename TSAIter, typename TValueIter, typename TString>
+    void _splitStreamsSkew7(
+        TSize bound[7],
+        unsigned x,
+        TSize m,
+        TSize const lo[7],
+        TSize const hi[7],
+        TSAIter const first[7],
+        TValueIter textBegin,
+        TSize n,
+        TString const &s124,
+        TSize const adjust[7][7],
+        TSize const _n[7],
+        TSize const _o[7])
+    {
+        static const unsigned streams[5] = {0, 1, 3, 5, 6};
+
+        TValueIter spos[7];
+        TSize tpos[7];
+        bool islast[7];
+
+        for (unsigned i = 0; i < 5; ++i)
+        {
+            unsigned y = streams[i];
+            if (y == x)
+            {
+                bound[y] = m;
+                continue;
+            }
+
+            TSize l = lo[y];
+            TSize r = hi[y];
+            while (l < r)
+            {
+                TSize mid = l + (r - l) / 2;
+                // the pivot must be reloaded as suffixes of SA124 may share the residue class
+                unsigned a = _loadSuffixSkew7(spos, tpos, islast, x, (TSize)first[x][m], textBegin, n, _n, _o);
+                unsigned b = _loadSuffixSkew7(spos, tpos, islast, y, (TSize)first[y][mid], textBegin, n, _n, _o);
+                if (_leqSkew7 (b,  a,   spos, tpos, islast, s124, adjust))
+                    l = mid + 1;
+                else
+                    r = mid;
+            }
+            bound[y] = l;
+        }
+        bound[2] = bound[4] = bound[1];
+    }
+
+    // merge SA0, SA124, SA3, SA5, SA6 into SA
+    //
+    // SA124 resides in SA[n-n124..n-1] and is overwritten by the output. The merge proceeds in rounds
+    // whose output never exceeds the first SA124 entry read in the round, within a round the threads
+    // merge disjoint ranges separated by binary searched pivots.
+    template <typename TSA, typename TSAIter, typename TValueIter, typename TSize, typename TString>
+    void _mergeParallelSkew7(
+        TSA &SA,
+        TSAIter const first[7],
+        TSize const size[7],
+        TValueIter textBegin,
+        TSize n,
+        TString const &s124,
+        TSize const adjust[7][7],
+        TSize const _n[7],
+        TSize const _o[7])
+    {
+        static const unsigned streams[5] = {0, 1, 3, 5, 6};
+
+        TSize const _n124 = size[1];
+        TSize const off = n - _n124;
+        TSize const minRound = 4096;
+        TSize p[7] = {0, 0, 0, 0, 0, 0, 0};
+        TSize hi[7];
+        String<TSize, Alloc<> > splits;
+
+        while (true)
+        {
+            TSize slack = off - (p[0] + p[3] + p[5] + p[6]);
+            TSize rest = _n124 - p[1];
+            if (rest == 0 || slack < minRound)
+                break;
+
+            // the round ends at SA124[p[1] + delta] and must not write beyond SA[off + p[1]],
+            // i.e. delta may not exceed the number of SA0, SA3, SA5, SA6 suffixes left after the round
+            // binary search the largest such delta
+            TSize deltaLo = 0;
+            TSize deltaHi = _min(rest - 1, slack);
+            while (deltaLo < deltaHi)
+            {
+                TSize delta = deltaHi - (deltaHi - deltaLo) / 2;
+                _splitStreamsSkew7(hi, 1u, p[1] + delta, p, size, first, textBegin, n, s124, adjust, _n, _o);
+                if (delta <= off - (hi[0] + hi[3] + hi[5] + hi[6]))
+                    deltaLo = delta;
+                else
+                    deltaHi = delta - 1;
+            }
+            _splitStreamsSkew7(hi, 1u, p[1] + deltaLo, p, size, first, textBegin, n, s124, adjust, _n, _o);
+
+            // choose the largest stream of the round to split it among the threads
+            unsigned x = 0;
+            TSize roundSize = 0;
+            for (unsigned i = 0; i < 5; ++i)
+            {
+                unsigned y = streams[i];
+                roundSize += hi[y] - p[y];
+                if (hi[y] - p[y] > hi[x] - p[x])
+                    x = y;
+            }
+            if (roundSize == 0)
+                break;
+
+            int chunks = _min((TSize)omp_get_max_threads(), hi[x] - p[x]);
+            resize(splits, 7 * (chunks + 1), Exact());
+            for (int i = 0; i < 7; ++i)
+            {
+                splits[i] = p[i];
+                splits[7 * chunks + i] = hi[i];
+            }
+
+            SEQAN_OMP_PRAGMA(parallel for)
+            for (int t = 1; t < chunks; ++t)
+                _splitStreamsSkew7(&splits[7 * t], x, p[x] + (TSize)((__uint64)(hi[x] - p[x]) * t / chunks), p, hi,
+                                   first, textBegin, n, s124, adjust, _n, _o);
+
+            SEQAN_OMP_PRAGMA(parallel for)
+            for (int t = 0; t < chunks; ++t)
+            {
+                TSAIter pos[7], max[7];
+                TSize k = 0;
+                for (int i = 0; i < 7; ++i)
+                {
+                    pos[i] = first[i] + splits[7 * t + i];
+                    max[i] = first[i] + splits[7 * (t + 1) + i];
+                    if (i != 2 && i != 4)
+                        k += splits[7 * t + i];
+                }
+                _mergeRangeSkew7(SA, k, pos, max, textBegin, n, s124, adjust, _n, _o);
+            }
+
+            for (int i = 0; i < 7; ++i)
+                p[i] = hi[i];
+        }
+
+        // at the end, only few suffixes of SA0, SA3, SA5, SA6 are left
+        // merge them serially with SA124 up to the last one of them
+        TSize last124 = p[1];
+        for (unsigned i = 0; i < 5; ++i)
+        {
+            unsigned y = streams[i];
+            if (y == 1 || p[y] == size[y])
+                continue;
+            TSize bound[7];
+            _splitStreamsSkew7(bound, y, size[y] - 1, p, size, first, textBegin, n, s124, adjust, _n, _o);
+            last124 = _max(last124, bound[1]);
+        }
+
+        {
+            TSAIter pos[7], max[7];
+            for (int i = 0; i < 7; ++i)
+            {
+                pos[i] = first[i] + p[i];
+                max[i] = first[i] + size[i];
+            }
+            max[1] = max[2] = max[4] = first[1] + last124;
+            _mergeRangeSkew7(SA, p[0] + p[1] + p[3] + p[5] + p[6], pos, max, textBegin, n, s124, adjust, _n, _o);
+        }
+
+        // the remaining suffixes of SA124 are already in place, only their positions need to be computed
+        TSAIter it124 = first[1];
+        SEQAN_OMP_PRAGMA(parallel for)
+        for (__int64 i = last124; i < (__int64)_n124; ++i)
+            it124[i] = _getISkew7((TSize)it124[i], _n, _o);
+    }
+
+
+	//////////////////////////////////////////////////////////////////////////////
+	// Parallel Skew algorithm with difference cover of Z_7
+	//
+	// This is the in-memory Skew7 algorithm where every step is parallelized:
+	//
+	// * the 7-tuples and the suffixes of SA0, SA3, SA5, SA6 are sorted with parallel counting sorts
+	// * lexicographic names are assigned with a parallel prefix sum
+	// * the 7-way merge is split into independent ranges by binary searched pivots
+	//
+	// Temporary buffers are placed in the unused parts of SA exactly as in Skew7.
+
+    template < typename TSA,
+               typename TText >
+    void createSuffixArray(
+		TSA &SA,
+		TText &s,
+		ParallelSkew7 const &,
+		unsigned K,
+        unsigned maxdepth,
+		unsigned depth)
+    {
+		typedef typename Value<TSA>::Type TSize;
+		typedef typename Value<TText>::Type TValue;
+        typedef String<TSize, Alloc<> > TBuffer;
+		typedef typename Iterator<TSA, Standard>::Type TSAIter;
+		typedef typename Iterator<TBuffer, Standard>::Type TBufferIter;
+		typedef typename Iterator<TText const, Standard>::Type TValueIter;
+
+		SEQAN_ASSERT(IsContiguous<TText>::VALUE == true);
+		SEQAN_ASSERT(IsContiguous<TSA>::VALUE == true);
+
+		TSize n = length(s);
+
+        // the parallel overhead doesn't pay off for short texts
+        if (n < 8192)
+        {
+            createSuffixArray(SA, s, Skew7(), K, maxdepth, depth);
+            return;
+        }
+
+        #ifdef SEQAN_DEBUG_INDEX
+            std::cerr << "--- CREATE SUFFIX ARRAY ---" << std::endl;
+            std::cerr << "ParallelSkew7 [random access]" << std::endl;
+			std::cerr << "enter level " << depth << " (" << n << ")" << std::endl;
+        #endif
+
+		TSize _n[7];
+		TSize _o[7];
+
+		_n[0] = n/7;
+		_o[0] = n%7;
+		TSize j = n + 6;
+		for(int i = 1; i < 7; ++i, --j) {
+			_n[i] = j/7;
+			_o[i] = j%7;
+		}
+
+		TSize _n24  = _n[2]+_n[4];
+		TSize _n124 = _n[1]+_n24;
+
+        TBuffer s124;
+        resize(s124, _n124, Exact());
+		// we use SA[n-n124..n-1] as a temporary buffer instead of allocating one
+		typename Suffix<TSA>::Type SA124 = suffix(SA, n - _n124);
+        TSAIter itSA124 = begin(SA124, Standard());
+        TBufferIter itS124 = begin(s124, Standard());
+        TValueIter textBegin = begin(s, Standard());
+
+
+		// generate positions of mod 3, mod 5 and mod 6 suffixes
+		{
+			TSize j = 0;
+			if (_n[2] > _n[4]) s124[j++] = _o[2];
+			if (_n[1] > _n[4]) s124[j++] = _o[1];
+
+            TBufferIter it = itS124 + j;
+            TSize o4 = _o[4];
+            SEQAN_OMP_PRAGMA(parallel for)
+			for (__int64 i = 0; i < (__int64)_n[4]; ++i) {
+				it[3 * i]     = o4 + 7 * i;
+				it[3 * i + 1] = o4 + 7 * i + 2;
+				it[3 * i + 2] = o4 + 7 * i + 3;
+			}
+		}
+
+
+		// lsb radix sort the mod 3, mod 5 and mod 6 7-tupels
+        if (!_fastTupleSortParallelSkew7(SA124, s, s124, typename Eval<BitsPerValue<TValue>::VALUE < 4>::Type()))
+		{
+            // SA[0..n124-1] is not used yet and serves as ping-pong buffer
+            typename Infix<TSA>::Type temp = infix(SA, 0, _n124);
+            TSize shifts[7] = {6, 5, 4, 3, 2, 1, 0};
+            _skew7ParallelRadixSort(SA124, s124, temp, s, (TSize)K, shifts, 7, (TSize)0);
+		}
+
+
+		// find lexicographic names of 7-tupel
+		TSize name = 0;
+		{
+			TSize ofs[7] = {0, _n24, _n[4], 0, 0, 0, 0};
+            TSize clip = _max(n, (TSize)6) - 6;
+            Splitter<TSize> splitter(0, _n124);
+            int chunks = length(splitter);
+            String<TSize, Alloc<> > names;
+            resize(names, chunks + 1, Exact());
+
+            // count new names per chunk, then assign names starting at the chunk's prefix sum
+            for (int phase = 0; phase < 2; ++phase)
+            {
+                SEQAN_OMP_PRAGMA(parallel for)
+                for (int t = 0; t < chunks; ++t)
+                {
+                    TSize nameCount = (phase == 0)? 0 : names[t];
+                    for (TSize i = splitter[t], l, prev = 0; i < splitter[t + 1]; ++i)
+                    {
+                        l = itSA124[i];
+                        // the last 6 7-tupels always differ from the rest
+                        bool differ = (i == 0 || l >= clip || (prev = itSA124[i - 1]) >= clip);
+                        for (TSize d = 0; !differ && d < 7; ++d)
+                            differ = (textBegin[l + d] != textBegin[prev + d]);
+                        if (differ)
+                            ++nameCount;
+                        if (phase == 1)
+                            itS124[(l/7) + ofs[(n-l) % 7]] = nameCount - 1;   // select a third
+                    }
+                    if (phase == 0)
+                        names[t + 1] = nameCount;
+                }
+
+                if (phase == 0)
+                {
+                    names[0] = 0;
+                    for (int t = 0; t < chunks; ++t)
+                        names[t + 1] += names[t];
+                    name = names[chunks];
+                }
+            }
+		}
+
+
+		// recurse if names are not yet unique
+		if (name < _n124) {
+            if (depth != maxdepth)
+            {
+			    createSuffixArray(SA124, s124, ParallelSkew7(), name, maxdepth, depth + 1);
+			    #ifdef SEQAN_TEST_SKEW7
+				    SEQAN_ASSERT(isSuffixArray(SA124, s124));
+			    #endif
+            }
+			// store unique names in s124 using the suffix array
+            SEQAN_OMP_PRAGMA(parallel for)
+			for (__int64 i = 0;  i < (__int64)_n124;  i++) itS124[itSA124[i]] = i;
+		} else { // generate the suffix array of s124 directly
+            SEQAN_OMP_PRAGMA(parallel for)
+			for (__int64 i = 0;  i < (__int64)_n124;  i++) itSA124[itS124[i]] = i;
+        }
+
+
+		// use SA[0...n3-1] and SA[n3...n3+n5-1] as a temporary buffers instead of allocating some
+		// and allocate SA0, SA3, SA5 and SA6
+
+		{
+			typename Infix<TSA>::Type s3 = infix(SA, 0, _n[3]), s5 = infix(SA, _n[3], _n[3] + _n[5]);
+			String<TSize, typename Skew7StringSpec_<TSA>::Type> SA0, SA3, SA5, SA6;
+
+			resize(SA0, _n[0], Exact());
+			resize(SA3, _n[3], Exact());
+			resize(SA5, _n[5], Exact());
+			resize(SA6, _n[6], Exact());
+
+			// stably sort the mod 5 and mod 3 suffixes from SA124 by their first character
+			{
+                Splitter<TSize> splitter(0, _n124);
+                int chunks = length(splitter);
+                String<TSize, Alloc<> > cnt3, cnt5;
+                resize(cnt3, chunks + 1, 0, Exact());
+                resize(cnt5, chunks + 1, 0, Exact());
+
+                // count, then distribute the suffixes of each chunk
+                for (int phase = 0; phase < 2; ++phase)
+                {
+                    SEQAN_OMP_PRAGMA(parallel for)
+                    for (int t = 0; t < chunks; ++t)
+                    {
+                        TSize j3 = (phase == 0)? 0 : cnt3[t];
+                        TSize j5 = (phase == 0)? 0 : cnt5[t];
+                        for (TSize i = splitter[t], l; i < splitter[t + 1]; ++i) {
+                            l = itSA124[i];
+                            if (l < _n[4]) {
+                                if ((l = _o[4] + (7 * l)) > 0) {
+                                    if (phase == 1) s5[j5] = l - 1;
+                                    ++j5;
+                                }
+                            } else if (l < _n24) {
+                                if ((l = _o[2] + (7 * (l - _n[4]))) > 0) {
+                                    if (phase == 1) s3[j3] = l - 1;
+                                    ++j3;
+                                }
+                            }
+                        }
+                        if (phase == 0)
+                        {
+                            cnt3[t + 1] = j3;
+                            cnt5[t + 1] = j5;
+                        }
+                    }
+
+                    if (phase == 0)
+                        for (int t = 0; t < chunks; ++t)
+                        {
+                            cnt3[t + 1] += cnt3[t];
+                            cnt5[t + 1] += cnt5[t];
+                        }
+                }
+
+                // the remaining part of SA[0..n-n124-1] serves as ping-pong buffer
+                TSize shift0[1] = {0};
+                {
+                    typename Infix<TSA>::Type temp = infix(SA, _n[3] + _n[5], _n[3] + _n[5] + _n[3]);
+                    _skew7ParallelRadixSort(SA3, s3, temp, s, (TSize)K, shift0, 1, (TSize)0);
+                }
+                {
+                    typename Infix<TSA>::Type temp = infix(SA, _n[3] + _n[5], _n[3] + _n[5] + _n[5]);
+                    _skew7ParallelRadixSort(SA5, s5, temp, s, (TSize)K, shift0, 1, (TSize)0);
+                }
+
+                // stably sort the mod 6 suffixes from SA5 by their first character
+                {
+                    typename Infix<TSA>::Type temp = infix(SA, 0, _n[6]);
+                    _skew7ParallelRadixSort(SA6, SA5, temp, s, (TSize)K, shift0, 1, (TSize)1);
+                }
+
+                // stably sort the mod 0 suffixes from SA6 by their first character
+                {
+                    typename Infix<TSA>::Type temp = infix(SA, 0, _n[0]);
+                    _skew7ParallelRadixSort(SA0, SA6, temp, s, (TSize)K, shift0, 1, (TSize)1);
+                }
+			}
+
+			// MULTIWAY MERGE all SA_ streams
+			{
+				// a helper matrix to lex-name-compare every combination of suffixes
+				TSize adjust[7][7] =
+					//      0               1              2             3             4              5               6
+				   {{0             , _n124-_n[0]   , _n24-_n[0]  , _n124-_n[0] , _n[4]-_n[0] , _n[4]-_n[0]   , _n24-_n[0]    },  // 0
+					{1-_n[1]       , 0             , 0           , 1-_n[1]     , 0           , 1-_n[1]-_n[2] , 1-_n[1]-_n[2] },  // 1*
+					{1-_n[2]       , 0             , 0           , _n[1]       , 0           , _n[1]         , 1-_n[2]       },  // 2*
+					{1+_n[4]-_n[3] , 1+_n[4]-_n[3] , _n24-_n[3]  , 0           , _n124-_n[3] , _n24-_n[3]    , _n124-_n[3]   },  // 3
+					{_n[1]+_n[2]   , 0             , 0           ,_n[2]        , 0           , _n[1]+_n[2]   , _n[2]         },  // 4*
+					{_n24-_n[5]    , _n124-_n[5]   , _n[4]-_n[5] , _n[4]-_n[5] , _n24-_n[5]  , 0             , _n124-_n[5]   },  // 5
+					{_n124-_n[6]   , _n24-_n[6]    , _n124-_n[6] , _n[4]-_n[6] , _n[4]-_n[6] , _n24-_n[6]    , 0             }}; // 6
+
+				TSAIter first[7] = {begin(SA0, Standard()), itSA124, itSA124,
+								    begin(SA3, Standard()), itSA124, begin(SA5, Standard()), begin(SA6, Standard())};
+                TSize size[7] = {(TSize)length(SA0), _n124, _n124, (TSize)length(SA3), _n124, (TSize)length(SA5), (TSize)length(SA6)};
+
+                _mergeParallelSkew7(SA, first, size, textBegin, n, s124, adjust, _n, _o);
+			}
+		}
+
+        #ifdef SEQAN_DEBUG_INDEX
+            std::cerr << "left level " << depth << std::endl;
+        #endif
+	}
+
+    template < typename TSA,
+               typename TText >
+    inline void createSuffixArray(
+		TSA &SA,
+		TText &s,
+		ParallelSkew7 const &alg,
+		unsigned K,
+        unsigned maxdepth)
+	{
+		createSuffixArray(SA, s, alg, K, maxdepth, 1);
+	}
+
+    // external strings can't be accessed in parallel, use the external Skew7 instead
+	template <
+		typename TSA,
+		typename TText >
+	inline void _createSuffixArrayWrapper(
+		TSA &sa,
+		TText const &s,
+		ParallelSkew7 const &,
+        False)
+	{
+        _createSuffixArrayPipelining(sa, s, Skew7());
+	}
+
+//}
+
+}
+
+#endif
@@ -586,6 +586,67 @@ If $charsLeft$ is smaller than the shape's span, the hash value corresponds to t
 		return me.hValue;
     }
 
+//____________________________________________________________________________
+// ungapped shapes on packed strings
+
+	// If the alphabet has 2^k characters, a packed string stores a q-gram as the
+	// bit sequence of its hash value. It is extracted with at most two word reads.
+	template <typename TValue, typename TPackedString, typename THostspec, typename TSpan>
+	inline bool
+	_isPackedHashable(Iter<TPackedString, Packed<THostspec> > const &, TSpan span)
+	{
+		typedef PackedTraits_<TPackedString> TTraits;
+
+		return IsSameType<TValue, typename Value<TPackedString>::Type>::VALUE &&
+		       (__uint64)ValueSize<TValue>::VALUE == (1ull << TTraits::BITS_PER_VALUE) &&
+		       (unsigned)span <= (unsigned)TTraits::VALUES_PER_HOST_VALUE;
+	}
+
+	template <typename TPackedString, typename THostspec, typename TSpan>
+	inline __uint64
+	_hashPacked(Iter<TPackedString, Packed<THostspec> > const &it, TSpan span)
+	{
+		typedef PackedTraits_<TPackedString> TTraits;
+
+		return _packedWordAt(it, span) >> ((TTraits::VALUES_PER_HOST_VALUE - span) * TTraits::BITS_PER_VALUE);
+	}
+
+	template <typename TValue, typename TPackedString, typename THostspec>
+	inline typename Value< Shape<TValue, SimpleShape> >::Type
+	hash(Shape<TValue, SimpleShape> &me, Iter<TPackedString, Packed<THostspec> > it)
+	{
+		typedef typename Size< Shape<TValue, SimpleShape> >::Type	TSize;
+
+		SEQAN_ASSERT_GT((unsigned)me.span, 0u);
+
+		if (_isPackedHashable<TValue>(it, me.span))
+		{
+			me.leftChar = *it;
+			return me.hValue = _hashPacked(it, me.span);
+		}
+
+		me.hValue = ordValue(me.leftChar = *it);
+		for(TSize i = 1; i < me.span; ++i) {
+			++it;
+			me.hValue = me.hValue * ValueSize<TValue>::VALUE + ordValue((TValue)*it);
+		}
+		return me.hValue;
+	}
+
+	template <typename TValue, unsigned q, typename TPackedString, typename THostspec>
+	inline typename Value< Shape<TValue, UngappedShape<q> > >::Type
+	hash(Shape<TValue, UngappedShape<q> > &me, Iter<TPackedString, Packed<THostspec> > it)
+	{
+		if (_isPackedHashable<TValue>(it, q))
+		{
+			me.leftChar = *it;
+			return me.hValue = _hashPacked(it, q);
+		}
+
+		me.hValue = ordValue(me.leftChar = *it);
+		return me.hValue = _hashFixedShape(me.hValue, it, TValue(), UngappedShape<q>());
+	}
+
 	template <typename TValue, typename TSpec, typename TIter, typename TSize>
 	inline typename Value< Shape<TValue, TSpec> >::Type
 	hash(Shape<TValue, TSpec> &me, TIter it, TSize charsLeft)
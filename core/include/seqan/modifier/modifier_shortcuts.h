@@ -552,6 +552,82 @@ inline void reverseComplement(StringSet<TSequence, TSpec> const & stringSet, Tag
 		reverseComplement(stringSet[seqNo], Serial());
 }
 
+// Packed Dna and Rna strings are reverse-complemented a word at a time.  Their
+// complement is the bitwise negation of the 2-bit value.
+
+inline __uint64
+_reverseComplementPackedWord(__uint64 word)
+{
+    // reverse the order of the 32 2-bit values, then negate them
+    word = ((word >> 2) & 0x3333333333333333ull) | ((word & 0x3333333333333333ull) << 2);
+    word = ((word >> 4) & 0x0f0f0f0f0f0f0f0full) | ((word & 0x0f0f0f0f0f0f0f0full) << 4);
+    word = ((word >> 8) & 0x00ff00ff00ff00ffull) | ((word & 0x00ff00ff00ff00ffull) << 8);
+    word = ((word >> 16) & 0x0000ffff0000ffffull) | ((word & 0x0000ffff0000ffffull) << 16);
+    word = (word >> 32) | (word << 32);
+    return ~word;
+}
+
+template <typename TValue, typename THostspec, typename TParallelTag>
+inline void
+_reverseComplementPacked(String<TValue, Packed<THostspec> > & sequence, Tag<TParallelTag>, False)
+{
+    typedef typename Iterator<String<TValue, Packed<THostspec> >, Standard>::Type TIter;
+
+    // packed values are proxies and can't be std::swap'ed
+    FunctorComplement<TValue> func;
+    TIter it1 = begin(sequence, Standard());
+    TIter it2 = end(sequence, Standard());
+    while (it1 < it2)
+    {
+        --it2;
+        TValue tmp = getValue(it1);
+        assignValue(it1, func(getValue(it2)));
+        assignValue(it2, func(tmp));
+        ++it1;
+    }
+}
+
+template <typename TValue, typename THostspec, typename TParallelTag>
+inline void
+_reverseComplementPacked(String<TValue, Packed<THostspec> > & sequence, Tag<TParallelTag>, True)
+{
+    typedef String<TValue, Packed<THostspec> > TSequence;
+    typedef PackedTraits_<TSequence> TTraits;
+    typedef typename Iterator<typename Host<TSequence>::Type, Standard>::Type THostIter;
+    typedef typename Size<TSequence>::Type TSize;
+
+    TSize len = length(sequence);
+    if (len == 0)
+        return;
+
+    // reverse the order of the words and reverse-complement each word
+    TSize numWords = TTraits::toHostLength(len);
+    THostIter first = begin(host(sequence), Standard()) + 1;
+    THostIter last = first + numWords;
+    for (; first + 1 < last; ++first)
+    {
+        --last;
+        __uint64 tmp = first->i;
+        first->i = _reverseComplementPackedWord(last->i);
+        last->i = _reverseComplementPackedWord(tmp);
+    }
+    if (first + 1 == last)
+        first->i = _reverseComplementPackedWord(first->i);
+
+    // the unused values of the last word are now in front, shift them out
+    TSize unused = numWords * TTraits::VALUES_PER_HOST_VALUE - len;
+    if (unused != 0)
+        arrayCopyForward(begin(sequence, Standard()) + unused,
+                         begin(sequence, Standard()) + (unused + len),
+                         begin(sequence, Standard()));
+}
+
+template <typename TValue, typename THostspec, typename TParallelTag>
+inline void reverseComplement(String<TValue, Packed<THostspec> > & sequence, Tag<TParallelTag> parallelTag)
+{
+    _reverseComplementPacked(sequence, parallelTag, typename Or<IsSameType<TValue, Dna>, IsSameType<TValue, Rna> >::Type());
+}
+
 template <typename TText>
 inline void reverseComplement(TText & text)
 {
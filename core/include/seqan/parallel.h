@@ -58,6 +58,9 @@
 // Splitting.
 #include <seqan/parallel/parallel_splitting.h>
 
+// Work stealing.
+#include <seqan/parallel/parallel_work_stealing.h>
+
 // Parallel variants of basic algorithms
 #include <seqan/parallel/parallel_algorithms.h>
 
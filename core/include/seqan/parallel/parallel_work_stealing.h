@@ -0,0 +1,802 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Author: agent <agent@local>
+// ==========================================================================
+// Work-stealing deque and task pool.  Every thread of the pool owns a
+// Chase-Lev deque, pushes and pops the tasks it spawns at the bottom and
+// steals from the top of the other deques when its own deque runs empty.
+// ==========================================================================
+
+#ifndef SEQAN_PARALLEL_PARALLEL_WORK_STEALING_H_
+#define SEQAN_PARALLEL_PARALLEL_WORK_STEALING_H_
+
+#if defined(PLATFORM_WINDOWS)
+#include <windows.h>
+#else  // #if defined(PLATFORM_WINDOWS)
+#include <sched.h>
+#endif  // #if defined(PLATFORM_WINDOWS)
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Class WorkStealingDeque
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class WorkStealingDeque
+ * @headerfile <seqan/parallel.h>
+ * @brief Lock-free double-ended queue for work stealing (Chase-Lev deque).
+ *
+ * @signature template <typename TValue>
+ *            class WorkStealingDeque;
+ *
+ * @tparam TValue The element type.  Must be cheap to copy, typically a pointer.
+ *
+ * The deque has one owner thread that may append and remove elements at the back with @link
+ * WorkStealingDeque#appendValue @endlink and @link WorkStealingDeque#tryPopBack @endlink.  All other threads may
+ * only remove elements from the front with @link WorkStealingDeque#trySteal @endlink.  None of these operations
+ * takes a lock, the owner and the thieves only synchronize with a compare-and-swap when they compete for the last
+ * element.  The capacity grows automatically.
+ */
+
+/**
+.Class.WorkStealingDeque
+..cat:Parallelism
+..summary:Lock-free double-ended queue for work stealing (Chase-Lev deque).
+..signature:WorkStealingDeque<TValue>
+..param.TValue:The element type.
+...remarks:Must be cheap to copy, typically a pointer.
+..remarks:The deque has one owner thread that may append and remove elements at the back with @Function.WorkStealingDeque#appendValue@ and @Function.tryPopBack@.
+All other threads may only remove elements from the front with @Function.trySteal@.
+None of these operations takes a lock, the owner and the thieves only synchronize with a compare-and-swap when they compete for the last element.
+The capacity grows automatically.
+..include:seqan/parallel.h
+ */
+
+template <typename TValue>
+struct WorkStealingDequeBuffer_
+{
+    TValue *    data;
+    __int64     mask;
+
+    explicit
+    WorkStealingDequeBuffer_(__int64 capacity) :
+        data(new TValue[capacity]), mask(capacity - 1)
+    {}
+
+    ~WorkStealingDequeBuffer_()
+    {
+        delete[] data;
+    }
+};
+
+template <typename TValue>
+class WorkStealingDeque
+{
+public:
+    typedef WorkStealingDequeBuffer_<TValue> TBuffer;
+
+    // Elements are stored at the positions [top, bottom) of the ring buffer.
+    __int64 volatile    top;
+    __int64 volatile    bottom;
+    TBuffer * volatile  buffer;
+
+    // Buffers replaced when growing are kept until destruction since thieves may still read from them.
+    String<TBuffer *>   retired;
+
+    explicit
+    WorkStealingDeque(__int64 capacity = 64) :
+        top(0), bottom(0)
+    {
+        __int64 cap = 2;
+        while (cap < capacity)
+            cap <<= 1;
+        buffer = new TBuffer(cap);
+    }
+
+    ~WorkStealingDeque()
+    {
+        delete buffer;
+        for (unsigned i = 0; i < length(retired); ++i)
+            delete retired[i];
+    }
+
+private:
+    WorkStealingDeque(WorkStealingDeque const &);
+    WorkStealingDeque & operator=(WorkStealingDeque const &);
+};
+
+// ----------------------------------------------------------------------------
+// Class WorkStealingGroup
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class WorkStealingGroup
+ * @headerfile <seqan/parallel.h>
+ * @brief A group of tasks that can be waited for.
+ *
+ * @signature class WorkStealingGroup;
+ *
+ * Tasks are assigned to a group when they are spawned with @link WorkStealingPool#spawn @endlink.  @link
+ * WorkStealingPool#wait @endlink returns when all tasks of the group are finished.  Tasks spawned by a task can be
+ * assigned to the same group or to a new group that the task waits for.
+ */
+
+/**
+.Class.WorkStealingGroup
+..cat:Parallelism
+..summary:A group of tasks that can be waited for.
+..signature:WorkStealingGroup
+..remarks:Tasks are assigned to a group when they are spawned with @Function.spawn@.
+@Function.wait@ returns when all tasks of the group are finished.
+Tasks spawned by a task can be assigned to the same group or to a new group that the task waits for.
+..include:seqan/parallel.h
+ */
+
+class WorkStealingGroup
+{
+public:
+    // Number of spawned but not yet finished tasks.
+    long volatile pending;
+
+    WorkStealingGroup() : pending(0)
+    {}
+
+private:
+    WorkStealingGroup(WorkStealingGroup const &);
+    WorkStealingGroup & operator=(WorkStealingGroup const &);
+};
+
+// ----------------------------------------------------------------------------
+// Class WorkStealingTask_
+// ----------------------------------------------------------------------------
+
+struct WorkStealingTaskBase_
+{
+    WorkStealingGroup * group;
+
+    explicit
+    WorkStealingTaskBase_(WorkStealingGroup & group) : group(&group)
+    {}
+
+    virtual ~WorkStealingTaskBase_()
+    {}
+
+    virtual void run() = 0;
+};
+
+template <typename TFunctor>
+struct WorkStealingTask_ : public WorkStealingTaskBase_
+{
+    TFunctor functor;
+
+    WorkStealingTask_(WorkStealingGroup & group, TFunctor const & functor) :
+        WorkStealingTaskBase_(group), functor(functor)
+    {}
+
+    virtual void run()
+    {
+        functor();
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Class WorkStealingPool
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class WorkStealingPool
+ * @headerfile <seqan/parallel.h>
+ * @brief Thread pool that balances dynamically spawned tasks by work stealing.
+ *
+ * @signature class WorkStealingPool;
+ *
+ * Tasks are functors without arguments that are spawned with @link WorkStealingPool#spawn @endlink into a @link
+ * WorkStealingGroup @endlink and executed by @link WorkStealingPool#wait @endlink.  Each thread of the pool owns a
+ * @link WorkStealingDeque @endlink.  A thread executes the tasks it spawned in LIFO order and steals the oldest tasks
+ * of randomly chosen other threads when its deque runs empty.  Tasks may spawn and wait for tasks themselves, which
+ * allows nested (e.g. recursive divide-and-conquer) parallelism.  A thread waiting for a group executes other tasks in
+ * the meantime.
+ *
+ * The threads are OpenMP threads that are started by the outermost call of @link WorkStealingPool#wait @endlink.
+ * Without OpenMP all tasks are executed by the calling thread.  Outside of @link WorkStealingPool#wait @endlink, only
+ * the thread that owns the pool may spawn tasks.  Every task must be waited for before the pool is destroyed.
+ *
+ * @section Examples
+ *
+ * @code{.cpp}
+ * struct CountReads
+ * {
+ *     unsigned * result;
+ *     TReads const * reads;
+ *
+ *     void operator()() const { *result = countMatches(*reads); }
+ * };
+ *
+ * WorkStealingPool pool;
+ * WorkStealingGroup group;
+ * for (unsigned i = 0; i < length(chunks); ++i)
+ * {
+ *     CountReads task = { &results[i], &chunks[i] };
+ *     spawn(pool, group, task);
+ * }
+ * wait(pool, group);
+ * @endcode
+ */
+
+/*!
+ * @fn WorkStealingPool::WorkStealingPool
+ * @brief Constructor
+ *
+ * @signature WorkStealingPool::WorkStealingPool([threadCount]);
+ *
+ * @param threadCount The number of threads.  Default: <tt>omp_get_max_threads()</tt>.
+ */
+
+/**
+.Class.WorkStealingPool
+..cat:Parallelism
+..summary:Thread pool that balances dynamically spawned tasks by work stealing.
+..signature:WorkStealingPool
+..remarks:Tasks are functors without arguments that are spawned with @Function.spawn@ into a @Class.WorkStealingGroup@ and executed by @Function.wait@.
+Each thread of the pool owns a @Class.WorkStealingDeque@.
+A thread executes the tasks it spawned in LIFO order and steals the oldest tasks of randomly chosen other threads when its deque runs empty.
+Tasks may spawn and wait for tasks themselves, which allows nested (e.g. recursive divide-and-conquer) parallelism.
+A thread waiting for a group executes other tasks in the meantime.
+..remarks:The threads are OpenMP threads that are started by the outermost call of @Function.wait@.
+Without OpenMP all tasks are executed by the calling thread.
+Outside of @Function.wait@, only the thread that owns the pool may spawn tasks.
+Every task must be waited for before the pool is destroyed.
+..include:seqan/parallel.h
+
+.Memfunc.WorkStealingPool#WorkStealingPool
+..summary:Constructor
+..signature:WorkStealingPool([threadCount])
+..param.threadCount:The number of threads.
+...default:$omp_get_max_threads()$
+..class:Class.WorkStealingPool
+ */
+
+class WorkStealingPool
+{
+public:
+    typedef WorkStealingDeque<WorkStealingTaskBase_ *> TDeque;
+
+    String<TDeque *>    deques;
+    String<unsigned>    victimSeeds;
+
+    // Set while the threads of the pool are running.
+    bool volatile       active;
+    bool volatile       done;
+
+    explicit
+    WorkStealingPool(unsigned threadCount = omp_get_max_threads()) :
+        active(false), done(false)
+    {
+        if (threadCount < 1u)
+            threadCount = 1;
+        resize(deques, threadCount, Exact());
+        resize(victimSeeds, threadCount, Exact());
+        for (unsigned i = 0; i < threadCount; ++i)
+        {
+            deques[i] = new TDeque();
+            victimSeeds[i] = 2 * i + 1;
+        }
+    }
+
+    ~WorkStealingPool()
+    {
+        for (unsigned i = 0; i < length(deques); ++i)
+            delete deques[i];
+    }
+
+private:
+    WorkStealingPool(WorkStealingPool const &);
+    WorkStealingPool & operator=(WorkStealingPool const &);
+};
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function _workStealingFence()
+// ----------------------------------------------------------------------------
+
+// Full memory barrier, orders the loads and stores of the Chase-Lev protocol.
+
+inline void _workStealingFence()
+{
+#if defined(PLATFORM_WINDOWS) && !defined(PLATFORM_WINDOWS_MINGW)
+    MemoryBarrier();
+#else  // #if defined(PLATFORM_WINDOWS) && !defined(PLATFORM_WINDOWS_MINGW)
+    __sync_synchronize();
+#endif  // #if defined(PLATFORM_WINDOWS) && !defined(PLATFORM_WINDOWS_MINGW)
+}
+
+// ----------------------------------------------------------------------------
+// Function _workStealingYield()
+// ----------------------------------------------------------------------------
+
+inline void _workStealingYield()
+{
+#if defined(PLATFORM_WINDOWS)
+    SwitchToThread();
+#else  // #if defined(PLATFORM_WINDOWS)
+    sched_yield();
+#endif  // #if defined(PLATFORM_WINDOWS)
+}
+
+// ----------------------------------------------------------------------------
+// Function empty()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn WorkStealingDeque#empty
+ * @brief Returns whether the deque is empty.
+ *
+ * @signature bool empty(deque);
+ *
+ * @param deque The WorkStealingDeque to query.
+ *
+ * @return bool <tt>true</tt> if the deque contains no elements.  The result is only a snapshot if other threads
+ *              access the deque concurrently.
+ */
+
+/**
+.Function.WorkStealingDeque#empty
+..class:Class.WorkStealingDeque
+..cat:Parallelism
+..summary:Returns whether the deque is empty.
+..signature:empty(deque)
+..param.deque:The deque to query.
+...type:Class.WorkStealingDeque
+..returns:$true$ if the deque contains no elements.
+The result is only a snapshot if other threads access the deque concurrently.
+..include:seqan/parallel.h
+ */
+
+template <typename TValue>
+inline bool
+empty(WorkStealingDeque<TValue> const & deque)
+{
+    return deque.bottom <= deque.top;
+}
+
+// ----------------------------------------------------------------------------
+// Function length()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn WorkStealingDeque#length
+ * @brief Returns the number of elements in the deque.
+ *
+ * @signature __int64 length(deque);
+ *
+ * @param deque The WorkStealingDeque to query.
+ *
+ * @return __int64 The number of elements.  The result is only a snapshot if other threads access the deque
+ *                 concurrently.
+ */
+
+/**
+.Function.WorkStealingDeque#length
+..class:Class.WorkStealingDeque
+..cat:Parallelism
+..summary:Returns the number of elements in the deque.
+..signature:length(deque)
+..param.deque:The deque to query.
+...type:Class.WorkStealingDeque
+..returns:The number of elements.
+The result is only a snapshot if other threads access the deque concurrently.
+..include:seqan/parallel.h
+ */
+
+template <typename TValue>
+inline __int64
+length(WorkStealingDeque<TValue> const & deque)
+{
+    __int64 len = deque.bottom - deque.top;
+    return (len < 0) ? 0 : len;
+}
+
+// ----------------------------------------------------------------------------
+// Function appendValue()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn WorkStealingDeque#appendValue
+ * @brief Appends an element to the back of the deque.
+ *
+ * @signature void appendValue(deque, val);
+ *
+ * @param deque The WorkStealingDeque to append to.
+ * @param val   The element to append.
+ *
+ * May only be called by the owner of the deque.
+ */
+
+/**
+.Function.WorkStealingDeque#appendValue
+..class:Class.WorkStealingDeque
+..cat:Parallelism
+..summary:Appends an element to the back of the deque.
+..signature:appendValue(deque, val)
+..param.deque:The deque to append to.
+...type:Class.WorkStealingDeque
+..param.val:The element to append.
+..remarks:May only be called by the owner of the deque.
+..include:seqan/parallel.h
+ */
+
+template <typename TValue>
+inline void
+appendValue(WorkStealingDeque<TValue> & deque, TValue const & val)
+{
+    typedef typename WorkStealingDeque<TValue>::TBuffer TBuffer;
+
+    __int64 b = deque.bottom;
+    __int64 t = deque.top;
+    TBuffer * buf = deque.buffer;
+
+    if (b - t > buf->mask)
+    {
+        // Grow the buffer, the old one stays readable for concurrent thieves.
+        TBuffer * newBuf = new TBuffer(2 * (buf->mask + 1));
+        for (__int64 i = t; i < b; ++i)
+            newBuf->data[i & newBuf->mask] = buf->data[i & buf->mask];
+        appendValue(deque.retired, buf);
+        _workStealingFence();
+        deque.buffer = buf = newBuf;
+    }
+
+    buf->data[b & buf->mask] = val;
+    _workStealingFence();
+    deque.bottom = b + 1;
+}
+
+// ----------------------------------------------------------------------------
+// Function tryPopBack()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn WorkStealingDeque#tryPopBack
+ * @brief Removes the element at the back of the deque.
+ *
+ * @signature bool tryPopBack(val, deque);
+ *
+ * @param val   The removed element.
+ * @param deque The WorkStealingDeque to remove the element from.
+ *
+ * @return bool <tt>true</tt> if an element was removed, <tt>false</tt> if the deque was empty or the last element
+ *              was stolen concurrently.
+ *
+ * May only be called by the owner of the deque.
+ */
+
+/**
+.Function.tryPopBack
+..class:Class.WorkStealingDeque
+..cat:Parallelism
+..summary:Removes the element at the back of the deque.
+..signature:tryPopBack(val, deque)
+..param.val:The removed element.
+..param.deque:The deque to remove the element from.
+...type:Class.WorkStealingDeque
+..returns:$true$ if an element was removed, $false$ if the deque was empty or the last element was stolen concurrently.
+..remarks:May only be called by the owner of the deque.
+..include:seqan/parallel.h
+ */
+
+template <typename TValue>
+inline bool
+tryPopBack(TValue & val, WorkStealingDeque<TValue> & deque)
+{
+    typedef typename WorkStealingDeque<TValue>::TBuffer TBuffer;
+
+    __int64 b = deque.bottom - 1;
+    TBuffer * buf = deque.buffer;
+    deque.bottom = b;
+    _workStealingFence();
+    __int64 t = deque.top;
+
+    if (t > b)
+    {
+        // The deque was empty.
+        deque.bottom = b + 1;
+        return false;
+    }
+
+    val = buf->data[b & buf->mask];
+    if (t < b)
+        return true;
+
+    // This is the last element, compete with the thieves for it.
+    bool success = (atomicCas(deque.top, t, t + 1) == t);
+    deque.bottom = b + 1;
+    return success;
+}
+
+// ----------------------------------------------------------------------------
+// Function trySteal()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn WorkStealingDeque#trySteal
+ * @brief Removes the element at the front of the deque.
+ *
+ * @signature bool trySteal(val, deque);
+ *
+ * @param val   The removed element.
+ * @param deque The WorkStealingDeque to remove the element from.
+ *
+ * @return bool <tt>true</tt> if an element was removed, <tt>false</tt> if the deque was empty or another thread
+ *              removed the element concurrently.
+ *
+ * May be called by any thread.
+ */
+
+/**
+.Function.trySteal
+..class:Class.WorkStealingDeque
+..cat:Parallelism
+..summary:Removes the element at the front of the deque.
+..signature:trySteal(val, deque)
+..param.val:The removed element.
+..param.deque:The deque to remove the element from.
+...type:Class.WorkStealingDeque
+..returns:$true$ if an element was removed, $false$ if the deque was empty or another thread removed the element concurrently.
+..remarks:May be called by any thread.
+..include:seqan/parallel.h
+ */
+
+template <typename TValue>
+inline bool
+trySteal(TValue & val, WorkStealingDeque<TValue> & deque)
+{
+    typedef typename WorkStealingDeque<TValue>::TBuffer TBuffer;
+
+    __int64 t = deque.top;
+    _workStealingFence();
+    __int64 b = deque.bottom;
+
+    if (t >= b)
+        return false;
+
+    _workStealingFence();
+    TBuffer * buf = deque.buffer;
+    TValue tmp = buf->data[t & buf->mask];
+    if (atomicCas(deque.top, t, t + 1) != t)
+        return false;
+
+    val = tmp;
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Function _workStealingThreadId()
+// ----------------------------------------------------------------------------
+
+// Returns the deque of the calling thread, the owner thread uses deque 0 outside of the pool threads.
+
+inline unsigned
+_workStealingThreadId(WorkStealingPool const & pool)
+{
+    if (!pool.active)
+        return 0;
+    unsigned tid = getThreadId();
+    SEQAN_ASSERT_LT(tid, length(pool.deques));
+    return tid;
+}
+
+// ----------------------------------------------------------------------------
+// Function _workStealingRunOne()
+// ----------------------------------------------------------------------------
+
+// Executes one task of the own deque or, if it is empty, of another thread.  Returns false if no task was found.
+
+inline bool
+_workStealingRunOne(WorkStealingPool & pool, unsigned tid)
+{
+    WorkStealingTaskBase_ * task = 0;
+    bool found = tryPopBack(task, *pool.deques[tid]);
+
+    unsigned threadCount = length(pool.deques);
+    if (!found && threadCount > 1u)
+    {
+        // Scan the other deques starting at a pseudo-random victim.
+        unsigned & seed = pool.victimSeeds[tid];
+        seed = seed * 1103515245u + 12345u;
+        unsigned victim = (seed >> 16) % threadCount;
+        for (unsigned i = 0; i < threadCount && !found; ++i, ++victim)
+        {
+            if (victim == threadCount)
+                victim = 0;
+            if (victim != tid)
+                found = trySteal(task, *pool.deques[victim]);
+        }
+    }
+
+    if (!found)
+        return false;
+
+    WorkStealingGroup * group = task->group;
+    task->run();
+    delete task;
+    _workStealingFence();
+    atomicDec(group->pending);
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Function _workStealingHelp()
+// ----------------------------------------------------------------------------
+
+// Executes tasks until all tasks of the group are finished.
+
+inline void
+_workStealingHelp(WorkStealingPool & pool, WorkStealingGroup & group, unsigned tid)
+{
+    while (group.pending != 0)
+        if (!_workStealingRunOne(pool, tid))
+            _workStealingYield();
+    _workStealingFence();
+}
+
+// ----------------------------------------------------------------------------
+// Function spawn()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn WorkStealingPool#spawn
+ * @brief Spawns a task.
+ *
+ * @signature void spawn(pool, group, functor);
+ *
+ * @param pool    The WorkStealingPool to execute the task.
+ * @param group   The WorkStealingGroup the task belongs to.
+ * @param functor The task to execute.  A copy of <tt>functor</tt> is called without arguments by any of the
+ *                threads of the pool.
+ *
+ * The task is not executed before @link WorkStealingPool#wait @endlink is called for its group or for any other group
+ * of the pool.
+ */
+
+/**
+.Function.spawn
+..class:Class.WorkStealingPool
+..cat:Parallelism
+..summary:Spawns a task.
+..signature:spawn(pool, group, functor)
+..param.pool:The pool to execute the task.
+...type:Class.WorkStealingPool
+..param.group:The group the task belongs to.
+...type:Class.WorkStealingGroup
+..param.functor:The task to execute.
+A copy of $functor$ is called without arguments by any of the threads of the pool.
+..remarks:The task is not executed before @Function.wait@ is called for its group or for any other group of the pool.
+..include:seqan/parallel.h
+ */
+
+template <typename TFunctor>
+inline void
+spawn(WorkStealingPool & pool, WorkStealingGroup & group, TFunctor const & functor)
+{
+    WorkStealingTaskBase_ * task = new WorkStealingTask_<TFunctor>(group, functor);
+    atomicInc(group.pending);
+    appendValue(*pool.deques[_workStealingThreadId(pool)], task);
+}
+
+// ----------------------------------------------------------------------------
+// Function wait()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn WorkStealingPool#wait
+ * @brief Waits for all tasks of a group.
+ *
+ * @signature void wait(pool, group);
+ *
+ * @param pool  The WorkStealingPool that executes the tasks.
+ * @param group The WorkStealingGroup to wait for.
+ *
+ * The calling thread executes tasks while waiting.  The outermost call starts the threads of the pool, calls from
+ * within a task only help to execute tasks until the group is finished.
+ */
+
+/**
+.Function.wait
+..class:Class.WorkStealingPool
+..cat:Parallelism
+..summary:Waits for all tasks of a group.
+..signature:wait(pool, group)
+..param.pool:The pool that executes the tasks.
+...type:Class.WorkStealingPool
+..param.group:The group to wait for.
+...type:Class.WorkStealingGroup
+..remarks:The calling thread executes tasks while waiting.
+The outermost call starts the threads of the pool, calls from within a task only help to execute tasks until the group is finished.
+..include:seqan/parallel.h
+ */
+
+inline void
+wait(WorkStealingPool & pool, WorkStealingGroup & group)
+{
+    if (pool.active || length(pool.deques) == 1u)
+    {
+        _workStealingHelp(pool, group, _workStealingThreadId(pool));
+        return;
+    }
+
+    if (group.pending == 0)
+        return;
+
+    pool.done = false;
+    pool.active = true;
+    _workStealingFence();
+
+    // Without OpenMP, the calling thread executes all tasks as thread 0.
+    SEQAN_OMP_PRAGMA(parallel num_threads(length(pool.deques)))
+    {
+        unsigned tid = getThreadId();
+        if (tid == 0u)
+        {
+            _workStealingHelp(pool, group, tid);
+            pool.done = true;
+        }
+        else
+        {
+            while (!pool.done)
+                if (!_workStealingRunOne(pool, tid))
+                    _workStealingYield();
+        }
+    }
+
+    pool.active = false;
+    _workStealingFence();
+}
+
+}  // namespace seqan
+
+#endif  // SEQAN_PARALLEL_PARALLEL_WORK_STEALING_H_
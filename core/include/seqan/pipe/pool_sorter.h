@@ -181,6 +181,10 @@ namespace SEQAN_NAMESPACE_MAIN
  * If there exists an explicit function mapping input elements to their destined positions in the output
  * stream, @link MapperSpec @endlink should be preferred.
  *
+ * When compiled with OpenMP, large in-memory buckets are sorted using <tt>omp_get_max_threads()</tt> threads.
+ * If the elements are sorted externally, the sorted runs are merged in a separate thread while the
+ * sorted stream is read.  The compare function must therefore be safe to call concurrently.
+ *
  * @section Example
  *
  * @include demos/pipe/pool_sorter.cpp
@@ -205,6 +209,9 @@ namespace SEQAN_NAMESPACE_MAIN
 ...type:Spec.SorterConfigSize
 ..remarks:The Pool's input/output type is $TValue$ and the size type is determined by the $TConfig$.
 ...note:If there exists an explicit function mapping input elements to their destined positions in the output stream, @Spec.MapperSpec@ should be preferred.
+...note:When compiled with OpenMP, large in-memory buckets are sorted using $omp_get_max_threads()$ threads.
+If the elements are sorted externally, the sorted runs are merged in a separate thread while the sorted stream is read.
+The compare function must therefore be safe to call concurrently.
 ..include:seqan/pipe.h
 */
 
@@ -223,6 +230,11 @@ namespace SEQAN_NAMESPACE_MAIN
 
     //////////////////////////////////////////////////////////////////////////////
 	// cache bucket based synchronous multiway merge
+	//
+	// If more than one thread is available, the multiway merge runs in a
+	// separate merger thread.  It hands merged pages over to the reader
+	// through a ring of MERGE_QUEUE_PAGES pages, so that the merge overlaps
+	// with the pipeline stage that consumes the sorted stream.
     struct ReadSorterSpec_;
 	typedef Tag<ReadSorterSpec_> ReadSorterSpec;
 
@@ -242,13 +254,44 @@ namespace SEQAN_NAMESPACE_MAIN
 */
         typedef PriorityType<TPageBucket, TStreamComparer> TPrioQueue;
 
+        enum { MERGE_QUEUE_PAGES = 4 };
+
+        struct MergeWorker_
+        {
+            Handler *me;
+            MergeWorker_(Handler *_me): me(_me) {}
+
+            template <typename TThread>
+            inline void run(TThread *)
+            {
+                me->_mergePages();
+            }
+        };
+
+        typedef Thread<MergeWorker_>                    TMergeThread;
+        typedef String<TValue>                          TMergedPage;
+
 		TPool       &pool;
         TBuffer     bucketBuffer;
         TPrioQueue  pqueue;
 
+        TMergeThread    *mergeThread;
+        TMergedPage     mergedPages[MERGE_QUEUE_PAGES];
+        unsigned        readPage;           // page the reader is at
+        size_t          readPos;            // position of the reader in readPage
+        Semaphore       freePages;          // pages the merger thread may fill
+        Semaphore       filledPages;        // pages the reader may consume
+        volatile bool   stopMerging;
+
         Handler(TPool &_pool):
             pool(_pool),
-            pqueue(TStreamComparer(_pool.handlerArgs)) { }
+            pqueue(TStreamComparer(_pool.handlerArgs)),
+            mergeThread(NULL),
+            readPage(0),
+            readPos(0),
+            freePages(MERGE_QUEUE_PAGES),
+            filledPages(0),
+            stopMerging(false) { }
 
         ~Handler() {
             cancel();
@@ -275,47 +318,58 @@ namespace SEQAN_NAMESPACE_MAIN
                 bucketBuffer, pool.bucketBufferSize, *this,
                 pool._size, pool.pageSize,
                 insertBucket(*this));
+
+            // 2. start the merger thread and wait for the first merged page
+            if (omp_get_max_threads() > 1 && length(pqueue) > 1)
+            {
+                for (unsigned i = 0; i < MERGE_QUEUE_PAGES; ++i)
+                    reserve(mergedPages[i], pool.pageSize, Exact());
+
+                Handler *self = this;
+                mergeThread = new TMergeThread(self);
+                if (!mergeThread->open())
+                {
+                    delete mergeThread;
+                    mergeThread = NULL;
+                    return true;
+                }
+                filledPages.lock();
+            }
             return true;
         }
 
         inline TValue const & front() const
         {
+            if (mergeThread)
+                return mergedPages[readPage][readPos];
 			return *(top(pqueue).cur);
         }
 
         inline void pop(TValue &Ref_) 
 		{
-            TPageBucket &pb = top(pqueue);
-			SEQAN_ASSERT_LEQ(pb.cur, pb.end);
+            if (mergeThread)
+            {
+                Ref_ = mergedPages[readPage][readPos];
+                _nextMerged();
+                return;
+            }
 
-            Ref_ = *pb.cur;
-            if (++pb.cur == pb.end)
-			{
-                // bucket is empty, we have to fetch the next bucket
-				if (!readBucket(pb, pb.pageNo, pool.pageSize, pool.dataSize(pb.pageNo), pool.file)) {
-					::seqan::pop(pqueue);
-					return;
-				}
-			}
-			adjustTop(pqueue);
+            Ref_ = *top(pqueue).cur;
+            _popBucket();
         }
 
         inline void pop()
         {
-            TPageBucket &pb = top(pqueue);
-			SEQAN_ASSERT_LEQ(pb.cur, pb.end);
-
-            if (++pb.cur == pb.end)
-                // bucket is empty, we have to fetch the next bucket
-				if (!readBucket(pb, pb.pageNo, pool.pageSize, pool.dataSize(pb.pageNo), pool.file)) {
-					::seqan::pop(pqueue);
-					return;
-				}
-			adjustTop(pqueue);
+            if (mergeThread)
+                _nextMerged();
+            else
+                _popBucket();
         }
 
 		inline bool eof() const
         {
+            if (mergeThread)
+                return empty(mergedPages[readPage]);
 			return empty(pqueue);
 		}
 
@@ -326,12 +380,68 @@ namespace SEQAN_NAMESPACE_MAIN
         
         void cancel()
         {
+            if (mergeThread)
+            {
+                // let the merger thread run out and wait for it to exit
+                stopMerging = true;
+                freePages.unlock();
+                mergeThread->wait();
+                delete mergeThread;
+                mergeThread = NULL;
+            }
             clear(pqueue);
             freePage(bucketBuffer, *this);
         }
 
         inline void process() {}
 
+        // Removes the smallest element of the multiway merge.
+        inline void _popBucket()
+        {
+            TPageBucket &pb = top(pqueue);
+			SEQAN_ASSERT_LEQ(pb.cur, pb.end);
+
+            if (++pb.cur == pb.end)
+                // bucket is empty, we have to fetch the next bucket
+				if (!readBucket(pb, pb.pageNo, pool.pageSize, pool.dataSize(pb.pageNo), pool.file)) {
+					::seqan::pop(pqueue);
+					return;
+				}
+			adjustTop(pqueue);
+        }
+
+        // Advances the reader, at the end of a page it is handed back to the merger thread.
+        inline void _nextMerged()
+        {
+            if (++readPos != length(mergedPages[readPage]))
+                return;
+
+            freePages.unlock();
+            readPage = (readPage + 1) % MERGE_QUEUE_PAGES;
+            readPos = 0;
+            filledPages.lock();
+        }
+
+        // Main loop of the merger thread.  An empty page marks the end of the stream.
+        void _mergePages()
+        {
+            for (unsigned page = 0; ; page = (page + 1) % MERGE_QUEUE_PAGES)
+            {
+                freePages.lock();
+
+                TMergedPage &mergedPage = mergedPages[page];
+                clear(mergedPage);
+                while (!stopMerging && !empty(pqueue) && length(mergedPage) < pool.pageSize)
+                {
+                    appendValue(mergedPage, *top(pqueue).cur);
+                    _popBucket();
+                }
+
+                filledPages.unlock();
+                if (empty(mergedPage))
+                    break;
+            }
+        }
     };
 
 
@@ -470,6 +580,42 @@ namespace SEQAN_NAMESPACE_MAIN
         }
 	};
 
+	//////////////////////////////////////////////////////////////////////////////
+	// parallel in-memory bucket sort
+	//
+	// Buckets that are large enough are split into one part per thread. The
+	// parts are sorted concurrently and then merged pairwise in log(#threads)
+	// rounds. Small buckets or a single available thread fall back to std::sort.
+
+	enum { SORTER_PARALLEL_MIN_SIZE = 8192 };
+
+	template < typename TValue, typename TLess >
+	inline void _sortPoolBuffer(TValue *first, TValue *last, TLess const &less)
+	{
+		typedef Splitter<TValue *> TSplitter;
+
+		if (last - first < (__int64)SORTER_PARALLEL_MIN_SIZE || omp_get_max_threads() <= 1)
+		{
+			std::sort(first, last, less);
+			return;
+		}
+
+		TSplitter splitter(first, last, Parallel());
+		int numParts = length(splitter);
+
+		SEQAN_OMP_PRAGMA(parallel for)
+		for (int i = 0; i < numParts; ++i)
+			std::sort(splitter[i], splitter[i + 1], less);
+
+		for (int width = 1; width < numParts; width *= 2)
+		{
+			SEQAN_OMP_PRAGMA(parallel for)
+			for (int i = 0; i < numParts - width; i += 2 * width)
+				std::inplace_merge(splitter[i], splitter[i + width],
+				                   splitter[_min(i + 2 * width, numParts)], less);
+		}
+	}
+
 	template < typename TValue,
 			   typename TConfig >
     inline Buffer<TValue, PageFrame<typename TConfig::File, Dynamic> > & processBuffer(
@@ -477,7 +623,7 @@ namespace SEQAN_NAMESPACE_MAIN
         BufferHandler< Pool< TValue, SorterSpec<TConfig> >, WriteFileSpec > &me)
     {
         AdaptorCompare2Less<typename TConfig::Compare> cmp(me.pool.handlerArgs);
-        std::sort(buf.begin, buf.end, cmp);
+        _sortPoolBuffer(buf.begin, buf.end, cmp);
 		return buf;
     }
 
@@ -491,7 +637,7 @@ namespace SEQAN_NAMESPACE_MAIN
         BufferHandler< Pool< TValue, SorterSpec<TConfig> >, MemorySpec > &me)
     {
         AdaptorCompare2Less<typename TConfig::Compare> cmp(me.pool.handlerArgs);
-        std::sort(buf.begin, buf.end, cmp);
+        _sortPoolBuffer(buf.begin, buf.end, cmp);
 		return buf;
     }
 
@@ -52,6 +52,7 @@
 #include <seqan/seq_io/guess_stream_format.h>
 
 #include <seqan/seq_io/read_fasta_fastq.h>
+#include <seqan/seq_io/read_fasta_fastq_parallel.h>
 #include <seqan/seq_io/read_embl.h>
 #include <seqan/seq_io/read_genbank.h>
 
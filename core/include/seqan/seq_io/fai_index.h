@@ -32,8 +32,15 @@
 // Author: Manuel Holtgrewe <manuel.holtgrewe@fu-berlin.de>
 // ==========================================================================
 // Code for loading and writing FAI FASTA index files.
+//
+// BGZF compressed FASTA files are supported as well.  Their FAI file refers
+// to offsets in the uncompressed data, like samtools does.  A GZI file with
+// the compressed and uncompressed offsets of each BGZF block is used for
+// translating these offsets into virtual offsets into the BGZF file.
 // ==========================================================================
 
+#include <algorithm>
+#include <fstream>
 #include <iostream>
 
 #include <seqan/sequence.h>
@@ -79,6 +86,50 @@ public:
     {}
 };
 
+// ----------------------------------------------------------------------------
+// Class FaiBuildState_
+// ----------------------------------------------------------------------------
+
+// State of the FASTA parser in build().  The parser is fed with chunks of the file such that the blocks of a BGZF file
+// can be parsed one after the other.
+
+struct FaiBuildState_
+{
+    enum TState
+    {
+        HEADER_START,   // Expecting the '>' of the first header.
+        NAME,           // In the sequence name.
+        HEADER_REST,    // In the header behind the sequence name.
+        FIRST_LINE,     // In the first sequence line.
+        FIRST_LINE_CR,  // Behind a '\r' that terminated the first sequence line.
+        SEQUENCE        // In the remaining sequence lines.
+    };
+
+    TState state;
+    // Offset of the next character in the (uncompressed) file.
+    __uint64 pos;
+    // The entry for the current sequence.
+    FaiIndexEntry_ entry;
+
+    FaiBuildState_() : state(HEADER_START), pos(0)
+    {}
+};
+
+// ----------------------------------------------------------------------------
+// Class FaiGziLess_
+// ----------------------------------------------------------------------------
+
+// Compares an uncompressed offset with the uncompressed offset of a GZI entry.
+
+struct FaiGziLess_
+{
+    template <typename TEntry>
+    inline bool operator()(__uint64 pos, TEntry const & entry) const
+    {
+        return pos < entry.i2;
+    }
+};
+
 // ----------------------------------------------------------------------------
 // Class FaiIndex
 // ----------------------------------------------------------------------------
@@ -95,6 +146,11 @@ public:
  *
  * Also see the <a href="http://trac.seqan.de/wiki/Tutorial/IndexedFastaIO">Indexed FASTA I/O Tutorial</a>.
  *
+ * The FASTA file can also be compressed with <tt>bgzip</tt>.  The BGZF block offsets are then stored in a GZI file
+ * (<tt>"${fastaFileName}.gzi"</tt>) next to the FAI file, and only the blocks that overlap a region are decompressed
+ * when reading it.  The most recently used blocks are kept in a cache.  When building the index, the blocks are
+ * decompressed by the number of threads set for the <tt>bgzfStream</tt> member.  This requires zlib.
+ *
  * @section Example
  *
  * The following example demonstrates the usage of the FaiIndex class.
@@ -119,6 +175,11 @@ public:
 ..wiki:Tutorial/IndexedFastaIO|Tutorial: Indexed FASTA I/O
 ..example.text:The following example demonstrate the usage of the FAIIndex class.
 ..example.file:demos/seq_io/fai_index_example.cpp
+..remarks:The FASTA file can also be compressed with $bgzip$.
+The BGZF block offsets are then stored in a GZI file ($fastaFileName + ".gzi"$) next to the FAI file, and only the blocks that overlap a region are decompressed when reading it.
+The most recently used blocks are kept in a cache.
+When building the index, the blocks are decompressed by the number of threads set for the $bgzfStream$ member.
+This requires zlib.
 ..include:seqan/seq_io.h
 
 .Memvar.FaiIndex#FaiIndex
@@ -148,8 +209,20 @@ public:
     String<char, MMap<> > mmapString;
     bool mmapStringOpen;
 
+    // Whether the FASTA file is BGZF compressed.  It is then read through bgzfStream instead of mmapString.
+    bool isBgzf;
+    // The name of the GZI file.
+    CharString gziFilename;
+    // Compressed and uncompressed offset of each BGZF block, starting with (0, 0) for the first block.
+    String<Pair<__uint64, __uint64> > gziIndex;
+#if SEQAN_HAS_ZLIB
+    // The BGZF stream for reading regions, it caches the recently decompressed blocks.  Its number of threads is
+    // used by build().  Mutable since readRegion() takes the index as const.
+    mutable Stream<Bgzf> bgzfStream;
+#endif  // #if SEQAN_HAS_ZLIB
+
     FaiIndex() :
-        refNameStoreCache(refNameStore), mmapStringOpen(false)
+        refNameStoreCache(refNameStore), mmapStringOpen(false), isBgzf(false)
     {}
 };
 
@@ -192,6 +265,9 @@ inline void clear(FaiIndex & index)
     clear(index.indexEntryStore);
     clear(index.refNameStore);
     refresh(index.refNameStoreCache);
+    index.isBgzf = false;
+    clear(index.gziFilename);
+    clear(index.gziIndex);
 }
 
 // ----------------------------------------------------------------------------
@@ -370,6 +446,9 @@ inline __uint64 numSeqs(FaiIndex const & index)
  * @param[in]  beginPos The begin position of the region to read.  Type: unsigned.
  * @param[in]  endPos   The end position of the region to read.  Type: unsigned.
  * @param[in]  region   The @link GenomicRegion @endlink to read.
+ *
+ * For BGZF compressed FASTA files, only the blocks overlapping the region are decompressed.  Since these blocks are
+ * cached in <tt>faiIndex</tt>, such an index must not be used by multiple threads at the same time.
  */
 
 /**
@@ -393,9 +472,109 @@ inline __uint64 numSeqs(FaiIndex const & index)
 ..param.region:The @Class.GenomicRegion@ to read.
 ...type:Class.GenomicRegion
 ..return:Status code $int$, $0$ indicating success and $1$ an error.
+..remarks:For BGZF compressed FASTA files, only the blocks overlapping the region are decompressed.
+Since these blocks are cached in $faiIndex$, such an index must not be used by multiple threads at the same time.
 ..include:seqan/seq_io.h
 */
 
+// ----------------------------------------------------------------------------
+// Helper Function _faiFileOffset()
+// ----------------------------------------------------------------------------
+
+// Returns the offset of the character at pos of the sequence in the (uncompressed) FASTA file.
+
+inline __uint64 _faiFileOffset(FaiIndexEntry_ const & entry, __uint64 pos)
+{
+    // Compute offset of the completely filled lines, then add the remaining bytes.
+    return entry.offset + (pos / entry.lineLength) * entry.overallLineLength + pos % entry.lineLength;
+}
+
+#if SEQAN_HAS_ZLIB
+
+// ----------------------------------------------------------------------------
+// Helper Function _faiIsBgzfFile()
+// ----------------------------------------------------------------------------
+
+inline bool _faiIsBgzfFile(char const * filename)
+{
+    char header[18];
+    std::ifstream file(filename, std::ios::binary | std::ios::in);
+    file.read(header, sizeof(header));
+    return file.gcount() == (std::streamsize)sizeof(header) && _bgzfCheckHeader(header);
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _faiOpenBgzf()
+// ----------------------------------------------------------------------------
+
+inline bool _faiOpenBgzf(FaiIndex & index, char const * filename)
+{
+    close(index.bgzfStream);
+    if (!open(index.bgzfStream, filename, "r"))
+        return false;
+
+    // Regions are read by random access, so cache the last 64 blocks.  The stream only reads ahead when blocks are
+    // read sequentially, so a single block is decompressed for each jump.
+    index.bgzfStream._maxCacheSize = 64 * 64 * 1024;
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _readRegionBgzf()
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec>
+inline int _readRegionBgzf(String<TValue, TSpec> & str,
+                           FaiIndex const & index,
+                           unsigned refId,
+                           unsigned beginPos,
+                           unsigned endPos)
+{
+    typedef Pair<__uint64, __uint64> TGziEntry;
+    typedef typename Iterator<String<TGziEntry> const, Standard>::Type TGziIter;
+    typedef typename Iterator<String<TValue, TSpec>, Standard>::Type TTargetIter;
+
+    clear(str);
+    if (beginPos == endPos)
+        return 0;
+    if (empty(index.gziIndex))
+        return 1;  // No GZI index.
+
+    FaiIndexEntry_ const & entry = index.indexEntryStore[refId];
+    __uint64 beginOffset = _faiFileOffset(entry, beginPos);
+    __uint64 endOffset = _faiFileOffset(entry, endPos - 1) + 1;
+
+    // Seek to the region start in the last block that starts at or before it.
+    TGziIter itBlock = std::upper_bound(begin(index.gziIndex, Standard()), end(index.gziIndex, Standard()),
+                                        beginOffset, FaiGziLess_()) - 1;
+    __uint64 virtualPos = (itBlock->i1 << 16) | (beginOffset - itBlock->i2);
+    if (streamSeek(index.bgzfStream, virtualPos, SEEK_SET) != 0)
+        return 1;
+
+    // Read the region including the line breaks, only the blocks in the region are decompressed (or taken from the
+    // cache).
+    String<char> buffer;
+    resize(buffer, endOffset - beginOffset);
+    if (streamReadBlock(&buffer[0], index.bgzfStream, length(buffer)) != length(buffer))
+        return 1;
+
+    // Copy out the characters and convert via iterator assignment to target string's type.
+    resize(str, endPos - beginPos, TValue());
+    TTargetIter itTarget = begin(str, Standard());
+    TTargetIter itTargetEnd = end(str, Standard());
+    for (unsigned i = 0; i < length(buffer) && itTarget != itTargetEnd; ++i)
+    {
+        if (isspace(buffer[i]))
+            continue;  // Skip spaces.
+        *itTarget = buffer[i];
+        ++itTarget;
+    }
+
+    return itTarget != itTargetEnd;  // Fail if the file ended early.
+}
+
+#endif  // #if SEQAN_HAS_ZLIB
+
 template <typename TValue, typename TSpec>
 inline int readRegion(String<TValue, TSpec> & str,
                       FaiIndex const & index,
@@ -409,18 +588,16 @@ inline int readRegion(String<TValue, TSpec> & str,
     endPos = std::min(std::max(beginPos, endPos), seqLen);
     unsigned toRead = endPos - beginPos;
 
+#if SEQAN_HAS_ZLIB
+    if (index.isBgzf)
+        return _readRegionBgzf(str, index, refId, beginPos, endPos);
+#endif  // #if SEQAN_HAS_ZLIB
+
     typedef typename Iterator<String<char, MMap<> > const, Standard>::Type TSourceIter;
     typedef typename Iterator<String<TValue, TSpec>, Standard>::Type TTargetIter;
     TSourceIter itSource = begin(index.mmapString, Standard());
-    __uint64 offset = index.indexEntryStore[refId].offset;
-    // First, compute offset of the completely filled lines.
-    unsigned numLines = beginPos / index.indexEntryStore[refId].lineLength;
-    unsigned numBytes = numLines * index.indexEntryStore[refId].overallLineLength;
-    // Then, compute overall offset by adding remaining bytes, too.
-    numBytes += beginPos % index.indexEntryStore[refId].lineLength;
-    offset += numBytes;
     // Advance iterator in MMap file.
-    itSource += offset;
+    itSource += _faiFileOffset(index.indexEntryStore[refId], beginPos);
 
     // Copy out the characters from FASTA file and convert via iterator assignment to target string's type.
     resize(str, toRead, TValue());
@@ -521,6 +698,8 @@ inline int readSequence(String<TValue, TSpec> & str, FaiIndex const & index, uns
  *                           <tt>"${fastaFileName}.fai"</tt>.
  *
  * @return int 0 on success, non-0 on errors.
+ *
+ * If the FASTA file is BGZF compressed then the GZI file <tt>"${fastaFileName}.gzi"</tt> is read as well.
  */
 
 /**
@@ -537,9 +716,44 @@ inline int readSequence(String<TValue, TSpec> & str, FaiIndex const & index, uns
 ...default:$fastaFileName + ".fai"$.
 ...type:nolink:$char const *$
 ..return:Status code $int$, $0$ indicating success and $1$ an error.
+..remarks:If the FASTA file is BGZF compressed then the GZI file $fastaFileName + ".gzi"$ is read as well.
 ..include:seqan/seq_io.h
 */
 
+#if SEQAN_HAS_ZLIB
+
+// ----------------------------------------------------------------------------
+// Helper Function _readGzi()
+// ----------------------------------------------------------------------------
+
+// Read a GZI file as written by bgzip and samtools: the number of entries followed by the compressed and uncompressed
+// offset of each block but the first, all as little-endian 64 bit integers.
+
+inline int _readGzi(String<Pair<__uint64, __uint64> > & gziIndex, char const * gziFilename)
+{
+    clear(gziIndex);
+    appendValue(gziIndex, Pair<__uint64, __uint64>(0, 0));
+
+    std::ifstream gziStream(gziFilename, std::ios::binary | std::ios::in);
+    __uint64 numEntries = 0;
+    if (!gziStream.read(reinterpret_cast<char *>(&numEntries), sizeof(numEntries)))
+        return 1;
+
+    for (__uint64 i = 0; i < numEntries; ++i)
+    {
+        __uint64 offsets[2];
+        if (!gziStream.read(reinterpret_cast<char *>(&offsets[0]), sizeof(offsets)))
+            return 1;
+        if (offsets[1] < back(gziIndex).i2)
+            return 1;  // Must be sorted.
+        appendValue(gziIndex, Pair<__uint64, __uint64>(offsets[0], offsets[1]));
+    }
+
+    return 0;
+}
+
+#endif  // #if SEQAN_HAS_ZLIB
+
 inline int read(FaiIndex & index, char const * fastaFilename, char const * faiFilename)
 {
     clear(index);  // Also clears filename, thus backup above and restore below.
@@ -548,9 +762,26 @@ inline int read(FaiIndex & index, char const * fastaFilename, char const * faiFi
 
     if (index.mmapStringOpen)
         close(index.mmapString);
-    if (!open(index.mmapString, toCString(fastaFilename), OPEN_RDONLY))
-        return 1;  // Could not open file.
-    index.mmapStringOpen = true;
+    index.mmapStringOpen = false;
+
+#if SEQAN_HAS_ZLIB
+    if (_faiIsBgzfFile(fastaFilename))
+    {
+        index.isBgzf = true;
+        index.gziFilename = fastaFilename;
+        append(index.gziFilename, ".gzi");
+        if (!_faiOpenBgzf(index, fastaFilename))
+            return 1;  // Could not open file.
+        if (_readGzi(index.gziIndex, toCString(index.gziFilename)) != 0)
+            return 1;  // Could not read GZI file.
+    }
+    else
+#endif  // #if SEQAN_HAS_ZLIB
+    {
+        if (!open(index.mmapString, toCString(fastaFilename), OPEN_RDONLY))
+            return 1;  // Could not open file.
+        index.mmapStringOpen = true;
+    }
 
     // Open file.
     std::ifstream faiStream(toCString(index.faiFilename), std::ios::binary | std::ios::in);
@@ -691,6 +922,9 @@ inline int read(FaiIndex & index)
  *                        const *</tt>.
  *
  * @return int 0 on success, 1 on errors.
+ *
+ * If the FASTA file is BGZF compressed then the GZI file is written as well, to the name that was derived from the
+ * FASTA file name by @link FaiIndex#build @endlink or @link FaiIndex#read @endlink.
  */
 
 /**
@@ -706,9 +940,31 @@ inline int read(FaiIndex & index)
 ...default:The FAI file name from the previous call to @Function.FaiIndex#build@, if any.
 ...type:nolink:$char const *$
 ..return:Status code $int$, $0$ indicating success and $1$ an error.
+..remarks:If the FASTA file is BGZF compressed then the GZI file is written as well, to the name that was derived from the FASTA file name by @Function.FaiIndex#build@ or @Function.FaiIndex#read@.
 ..include:seqan/seq_io.h
 */
 
+// ----------------------------------------------------------------------------
+// Helper Function _writeGzi()
+// ----------------------------------------------------------------------------
+
+// Write a GZI file, see _readGzi() for the format.  The implicit entry for the first block is not written.
+
+inline int _writeGzi(String<Pair<__uint64, __uint64> > const & gziIndex, char const * gziFilename)
+{
+    std::ofstream gziOut(gziFilename, std::ios::binary | std::ios::out);
+
+    __uint64 numEntries = empty(gziIndex) ? 0 : length(gziIndex) - 1;
+    gziOut.write(reinterpret_cast<char const *>(&numEntries), sizeof(numEntries));
+    for (unsigned i = 1; i < length(gziIndex); ++i)
+    {
+        __uint64 offsets[2] = { gziIndex[i].i1, gziIndex[i].i2 };
+        gziOut.write(reinterpret_cast<char const *>(&offsets[0]), sizeof(offsets));
+    }
+
+    return !gziOut.good();  // 1 on errors, 0 on success.
+}
+
 // TODO(holtgrew): The wrappers can go when the clash from read() from the file module is gone.
 
 inline int write(FaiIndex const & index, char const * faiFilename)
@@ -723,6 +979,9 @@ inline int write(FaiIndex const & index, char const * faiFilename)
                  << entry.lineLength << '\t' << entry.overallLineLength << '\n';
     }
 
+    if (index.isBgzf && (empty(index.gziFilename) || _writeGzi(index.gziIndex, toCString(index.gziFilename)) != 0))
+        return 1;
+
     return !indexOut.good();  // 1 on errors, 0 on success.
 }
 
@@ -769,6 +1028,9 @@ inline int write(FaiIndex & index)
  *                         Default: <tt>"${seqFileName}.fai"</tt>.
  *
  * @return 0 on success, non-0 on errors.
+ *
+ * BGZF compressed FASTA files are detected automatically.  For them, the GZI file name
+ * <tt>"${seqFileName}.gzi"</tt> is stored in <tt>faiIndex</tt> as well.
  */
 
 /**
@@ -785,9 +1047,202 @@ inline int write(FaiIndex & index)
 ...default:$fastaFilename + ".fai"$
 ...type:nolink:$char const *$
 ..returns:$int$, equal to 0 on success, != 0 otherwise.
+..remarks:BGZF compressed FASTA files are detected automatically.
+For them, the GZI file name $fastaFilename + ".gzi"$ is stored in $faiIndex$ as well.
 ..include:seqan/stream.h
  */
 
+// ----------------------------------------------------------------------------
+// Helper Function _faiBuildAppendEntry()
+// ----------------------------------------------------------------------------
+
+inline void _faiBuildAppendEntry(FaiIndex & index, FaiBuildState_ & state)
+{
+    appendValue(index.indexEntryStore, state.entry);
+    appendValue(index.refNameStore, state.entry.name);
+    state.entry = FaiIndexEntry_();
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _faiBuildConsume()
+// ----------------------------------------------------------------------------
+
+// Parse the FASTA chunk [first, last) and add the sequences that end in it to the index.  Returns 0 on success, 1 on
+// errors.
+
+inline int _faiBuildConsume(FaiIndex & index, FaiBuildState_ & state, char const * first, char const * last)
+{
+    for (char const * it = first; it != last; ++it)
+    {
+        // Most of the file is sequence, count its characters in a tight loop.
+        if (state.state == FaiBuildState_::SEQUENCE)
+        {
+            for (; it != last && *it != '>'; ++it)
+                if (!isspace(*it))
+                    ++state.entry.sequenceLength;
+            if (it == last)
+                break;
+        }
+
+        char c = *it;
+        __uint64 pos = state.pos + (it - first);
+        switch (state.state)
+        {
+        case FaiBuildState_::HEADER_START:
+            if (c != '>')
+                return 1;  // Must be >.
+            state.state = FaiBuildState_::NAME;
+            break;
+
+        case FaiBuildState_::NAME:
+            if (!isspace(c))
+            {
+                appendValue(state.entry.name, c);
+                break;
+            }
+            // c could be the header's line break.
+            state.state = FaiBuildState_::HEADER_REST;
+            // Fall through.
+
+        case FaiBuildState_::HEADER_REST:
+            if (c == '\n')
+            {
+                state.entry.offset = pos + 1;
+                state.state = FaiBuildState_::FIRST_LINE;
+            }
+            break;
+
+        case FaiBuildState_::FIRST_LINE:
+            if (c == '\r')
+            {
+                state.state = FaiBuildState_::FIRST_LINE_CR;
+            }
+            else if (c == '\n')
+            {
+                state.entry.overallLineLength = pos + 1 - state.entry.offset;
+                state.state = FaiBuildState_::SEQUENCE;
+            }
+            else if (c == '>' && state.entry.lineLength == 0u)
+            {
+                // Empty sequence, this is the next header.
+                _faiBuildAppendEntry(index, state);
+                state.state = FaiBuildState_::NAME;
+            }
+            else
+            {
+                ++state.entry.lineLength;
+                ++state.entry.sequenceLength;
+            }
+            break;
+
+        case FaiBuildState_::FIRST_LINE_CR:
+            // Windows line break if followed by '\n', Mac line break otherwise.
+            state.state = FaiBuildState_::SEQUENCE;
+            state.entry.overallLineLength = pos - state.entry.offset;
+            if (c == '\n')
+            {
+                state.entry.overallLineLength += 1;
+                break;
+            }
+            // c is the first character behind the line.
+            // Fall through.
+
+        case FaiBuildState_::SEQUENCE:
+            if (c == '>')
+            {
+                _faiBuildAppendEntry(index, state);
+                state.state = FaiBuildState_::NAME;
+            }
+            else if (!isspace(c))
+            {
+                ++state.entry.sequenceLength;
+            }
+            break;
+        }
+    }
+
+    state.pos += last - first;
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _faiBuildFinish()
+// ----------------------------------------------------------------------------
+
+// Add the last sequence after the whole file has been consumed.  Returns 0 on success, 1 on errors.
+
+inline int _faiBuildFinish(FaiIndex & index, FaiBuildState_ & state)
+{
+    switch (state.state)
+    {
+    case FaiBuildState_::HEADER_START:  // Empty file.
+    case FaiBuildState_::NAME:          // The header line must be complete.
+    case FaiBuildState_::HEADER_REST:
+        return 1;
+
+    case FaiBuildState_::FIRST_LINE:
+    case FaiBuildState_::FIRST_LINE_CR:
+        state.entry.overallLineLength = state.pos - state.entry.offset;
+        // Fall through.
+
+    case FaiBuildState_::SEQUENCE:
+        _faiBuildAppendEntry(index, state);
+        break;
+    }
+
+    // Refresh name store cache.
+    refresh(index.refNameStoreCache);
+
+    return 0;
+}
+
+#if SEQAN_HAS_ZLIB
+
+// ----------------------------------------------------------------------------
+// Helper Function _buildBgzf()
+// ----------------------------------------------------------------------------
+
+// Build the FAI and GZI index for a BGZF compressed FASTA file, the blocks are decompressed in parallel by the
+// number of threads set for index.bgzfStream.
+
+inline int _buildBgzf(FaiIndex & index, char const * seqFilename)
+{
+    typedef Pair<__uint64, __uint64> TGziEntry;
+
+    index.isBgzf = true;
+    index.gziFilename = seqFilename;
+    append(index.gziFilename, ".gzi");
+    clear(index.gziIndex);
+
+    if (!_faiOpenBgzf(index, seqFilename))
+        return 1;  // Could not open file.
+
+    // Read the file block by block, do not cache blocks for the random access later.
+    Stream<Bgzf> & stream = index.bgzfStream;
+    int maxCacheSize = stream._maxCacheSize;
+    stream._maxCacheSize = 0;
+
+    FaiBuildState_ state;
+    int res = 0;
+    while ((res = _bgzfReadBlock(stream)) == 0)
+    {
+        appendValue(index.gziIndex, TGziEntry(stream._blockPosition, state.pos));
+        char const * block = &stream._uncompressedBlock[0];
+        if (_faiBuildConsume(index, state, block, block + stream._blockLength) != 0)
+            return 1;
+        stream._blockLength = 0;  // Mark block as consumed.
+        stream._blockOffset = 0;
+    }
+    if (res != -2)
+        return 1;  // Error other than EOF.
+
+    stream._maxCacheSize = maxCacheSize;
+
+    return _faiBuildFinish(index, state);
+}
+
+#endif  // #if SEQAN_HAS_ZLIB
+
 inline int build(FaiIndex & index, char const * seqFilename, char const * faiFilename)
 {
     index.fastaFilename = seqFilename;
@@ -795,6 +1250,14 @@ inline int build(FaiIndex & index, char const * seqFilename, char const * faiFil
     
     if (index.mmapStringOpen)
         close(index.mmapString);
+    index.mmapStringOpen = false;
+
+#if SEQAN_HAS_ZLIB
+    if (_faiIsBgzfFile(seqFilename))
+        return _buildBgzf(index, seqFilename);
+#endif  // #if SEQAN_HAS_ZLIB
+    index.isBgzf = false;
+
     if (!open(index.mmapString, toCString(seqFilename), OPEN_RDONLY))
         return 1;  // Could not open file.
     index.mmapStringOpen = true;
@@ -810,65 +1273,12 @@ inline int build(FaiIndex & index, char const * seqFilename, char const * faiFil
         return 1;  // Invalid format, not FASTA.
 
     // Re-using the FASTA/FASTQ parsing code from read_fasta_fastq is not really feasible here.  We roll our own
-    // mini-parser from scratch.
-    CharString line;
-    CharString seqName;
-    __uint32 seqLength = 0;
-    __uint64 seqOffset = 0;
-    __uint32 lineLength = 0;
-    __uint32 lineSize = 0;
-    while (!atEnd(reader))
-    {
-        clear(line);
-        clear(seqName);
-
-        if (value(reader) != '>')
-            return 1;  // Must be >.
-
-        goNext(reader);
-
-        int res = readUntilWhitespace(seqName, reader);
-        if (res != 0)
-            return res;  // Error reading.
-
-        res = skipLine(reader);
-        if (res != 0)
-            return res;  // Error reading.
-
-        seqOffset = reader._current - begin(reader._string, Standard());
-
-        res = readLine(line, reader);
-        if (res != 0 && res != EOF_BEFORE_SUCCESS)
-            return res;  // Error reading.
-
-        lineSize = reader._current - begin(reader._string, Standard()) - seqOffset;
-        lineLength = length(line);
-        seqLength = lineLength;
-
-        while (!atEnd(reader))
-        {
-            char c = value(reader);
-            if (c == '>')
-                break;
-            if (!isspace(c))
-                seqLength += 1;
-            goNext(reader);
-        }
-
-        FaiIndexEntry_ entry;
-        entry.name = seqName;
-        entry.sequenceLength = seqLength;
-        entry.offset = seqOffset;
-        entry.lineLength = lineLength;
-        entry.overallLineLength = lineSize;
-        appendValue(index.indexEntryStore, entry);
-        appendValue(index.refNameStore, entry.name);
-    }
-
-    // Refresh name store cache.
-    refresh(index.refNameStoreCache);
-
-    return 0;
+    // mini-parser from scratch, it is fed with the whole file at once here and block-wise for BGZF files.
+    FaiBuildState_ state;
+    char const * text = begin(index.mmapString, Standard());
+    if (_faiBuildConsume(index, state, text, text + length(index.mmapString)) != 0)
+        return 1;
+    return _faiBuildFinish(index, state);
 }
 
 inline int build(FaiIndex & index, char const * seqFilename)
@@ -287,8 +287,8 @@ _clearAndReserveMemory(TIdString & meta, TSeqString & seq, TQualString & qual,
 // ----------------------------------------------------------------------------
 
 // This overload of _readSequenceFastAQ() assumes that the separator characters, such as '>'/'+' are not part of
-// the alphabet.  This way, we can use _readHelper() and do not have to fall back to the more complicated way
-// used in the case of char.
+// the alphabet.  This way, we can copy whole runs of alphanumeric characters and do not have to fall back to the
+// more complicated way used in the case of char.
 
 template <typename TAlph, typename TSpec, typename TRecordReader, typename TFormatTag>
 inline int
@@ -296,8 +296,25 @@ _readSequenceFastAQ(String<TAlph, TSpec> & string,
                     TRecordReader & reader,
                     TFormatTag const & /*formatTag*/)
 {
-//     return _readHelper(string, reader, Tag<TAlph>(), Whitespace_(), false);
-    return _readHelper(string, reader, AlphaNum_(), Whitespace_(), false);
+    // Same as _readHelper(string, reader, AlphaNum_(), Whitespace_(), false) but copies a line at a time.
+    while (!atEnd(reader))
+    {
+        char c = value(reader);
+        if (isspace(c))
+        {
+            goNext(reader);
+            if (resultCode(reader) != 0)
+                return resultCode(reader);
+            continue;
+        }
+        if (!isalnum(c))
+            return 0;  // Done, at stop char.
+
+        int res = _readUntilFinder(string, reader, NonAlphaNumFinder_());
+        if (res != 0)
+            return res;
+    }
+    return EOF_BEFORE_SUCCESS;
 }
 
 // If we want to read char values from a FASTA or FASTQ file then we have to fall back to a more complicated
@@ -332,9 +349,15 @@ _readSequenceFastAQCharImpl(TString & string,
             return 0;  // Done, at stop char.
         }
 
-        if (!isspace(c))
-            appendValue(string, c);
         afterEol = false;
+        if (!isspace(c))
+        {
+            // Copy the rest of the line up to the next whitespace.
+            int res = _readUntilFinder(string, reader, WhitespaceFinder_());
+            if (res != 0)
+                return res;
+            continue;
+        }
         goNext(reader);
         if (resultCode(reader) != 0)
             return resultCode(reader);
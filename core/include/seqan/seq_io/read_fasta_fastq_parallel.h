@@ -0,0 +1,486 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Author: agent <agent@local>
+// ==========================================================================
+// Parallel reading of FASTA and FASTQ files that are completely in memory,
+// e.g. memory mapped.  The text is cut into chunks of equal size whose
+// beginnings are moved forward to the next record.  Rounds of chunks are
+// parsed in parallel into string sets of their own, which are then appended
+// to the result in file order.
+//
+// A chunk must end exactly where the next one begins.  Otherwise, e.g. for
+// FASTQ files with multi-line sequences, a chunk began in the middle of a
+// record and the whole text is read serially instead.  So the result is
+// always the same as reading the records one by one.
+// ==========================================================================
+
+#ifndef SEQAN_SEQ_IO_READ_FASTA_FASTQ_PARALLEL_H_
+#define SEQAN_SEQ_IO_READ_FASTA_FASTQ_PARALLEL_H_
+
+#include <cstring>
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Class SequenceParallelReadOptions
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class SequenceParallelReadOptions
+ * @headerfile <seqan/seq_io.h>
+ * @brief Options for @link FastaFastqIO#readAllParallel @endlink.
+ *
+ * @signature struct SequenceParallelReadOptions;
+ *
+ * @var unsigned SequenceParallelReadOptions::numThreads
+ * @brief Number of threads for parsing, default: <tt>omp_get_max_threads()</tt>.
+ *
+ * @var __uint64 SequenceParallelReadOptions::chunkSize
+ * @brief Number of characters each thread parses at a time, default: 8 MiB.
+ */
+
+/**
+.Class.SequenceParallelReadOptions
+..cat:Input/Output
+..summary:Options for @Function.readAllParallel@.
+..signature:SequenceParallelReadOptions
+..include:seqan/seq_io.h
+
+.Memvar.SequenceParallelReadOptions#numThreads
+..class:Class.SequenceParallelReadOptions
+..summary:Number of threads for parsing, default: $omp_get_max_threads()$.
+..type:nolink:$unsigned$
+
+.Memvar.SequenceParallelReadOptions#chunkSize
+..class:Class.SequenceParallelReadOptions
+..summary:Number of characters each thread parses at a time, default: 8 MiB.
+..type:nolink:$__uint64$
+*/
+
+struct SequenceParallelReadOptions
+{
+    unsigned numThreads;
+    __uint64 chunkSize;
+
+    SequenceParallelReadOptions() :
+        numThreads(omp_get_max_threads()), chunkSize(8 * 1024 * 1024)
+    {}
+};
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function _fastAQSyncPos()
+// ----------------------------------------------------------------------------
+
+// Returns the beginning of the first line at or after pos.
+inline __uint64
+_fastAQNextLine(char const * text, __uint64 len, __uint64 pos)
+{
+    if (pos == 0 || pos >= len || text[pos - 1] == '\n')
+        return pos;
+    char const * eol = static_cast<char const *>(std::memchr(text + pos, '\n', len - pos));
+    return (eol != 0) ? eol - text + 1 : len;
+}
+
+// Returns the beginning of the first record at or after pos.  In FASTA files, records begin with a line that starts
+// with '>'.
+inline __uint64
+_fastAQSyncPos(char const * text, __uint64 len, __uint64 pos, Fasta const & /*tag*/)
+{
+    for (pos = _fastAQNextLine(text, len, pos); pos < len; pos = _fastAQNextLine(text, len, pos + 1))
+        if (text[pos] == '>')
+            return pos;
+    return len;
+}
+
+// In FASTQ files, a quality line can start with '@' as well.  It is followed by the '@' line of the next record and
+// then a sequence line, whereas the line after the next of a record beginning starts with '+'.
+inline __uint64
+_fastAQSyncPos(char const * text, __uint64 len, __uint64 pos, Fastq const & /*tag*/)
+{
+    for (pos = _fastAQNextLine(text, len, pos); pos < len; pos = _fastAQNextLine(text, len, pos + 1))
+    {
+        if (text[pos] != '@')
+            continue;
+        __uint64 plusPos = _fastAQNextLine(text, len, _fastAQNextLine(text, len, pos + 1) + 1);
+        if (plusPos >= len || text[plusPos] == '+')
+            return pos;
+    }
+    return len;
+}
+
+// ----------------------------------------------------------------------------
+// Function _readFastAQRange()
+// ----------------------------------------------------------------------------
+
+// Appends the records that begin in [beginPos, endPos) of text to the string sets.  stopPos is set to the end of the
+// last record read.
+
+template <typename TId, typename TIdSpec, typename TSequence, typename TSeqSpec, typename TQualities,
+          typename TQualSpec, typename TText, typename TTag>
+inline int
+_readFastAQRange(StringSet<TId, TIdSpec> & ids,
+                 StringSet<TSequence, TSeqSpec> & seqs,
+                 StringSet<TQualities, TQualSpec> & quals,
+                 TText & text,
+                 __uint64 beginPos,
+                 __uint64 endPos,
+                 __uint64 & stopPos,
+                 TTag const & tag)
+{
+    typedef RecordReader<TText, SinglePass<StringReader> > TReader;
+
+    TReader reader(text);
+    setPosition(reader, beginPos);
+
+    TId id;
+    TSequence seq;
+    TQualities qual;
+    int res = 0;
+    while (!atEnd(reader) && (__uint64)position(reader) < endPos)
+    {
+        if ((res = readRecord(id, seq, qual, reader, tag)) != 0)
+            break;
+        appendValue(ids, id);
+        appendValue(seqs, seq);
+        appendValue(quals, qual);
+    }
+    stopPos = position(reader);
+    return res;
+}
+
+// Without qualities, FASTQ qualities are stored in the sequence if its alphabet has qualities.
+template <typename TId, typename TIdSpec, typename TSequence, typename TSeqSpec, typename TText, typename TTag>
+inline int
+_readFastAQRange(StringSet<TId, TIdSpec> & ids,
+                 StringSet<TSequence, TSeqSpec> & seqs,
+                 Nothing & /*quals*/,
+                 TText & text,
+                 __uint64 beginPos,
+                 __uint64 endPos,
+                 __uint64 & stopPos,
+                 TTag const & tag)
+{
+    typedef RecordReader<TText, SinglePass<StringReader> > TReader;
+
+    TReader reader(text);
+    setPosition(reader, beginPos);
+
+    TId id;
+    TSequence seq;
+    int res = 0;
+    while (!atEnd(reader) && (__uint64)position(reader) < endPos)
+    {
+        if ((res = readRecord(id, seq, reader, tag)) != 0)
+            break;
+        appendValue(ids, id);
+        appendValue(seqs, seq);
+    }
+    stopPos = position(reader);
+    return res;
+}
+
+// ----------------------------------------------------------------------------
+// Function _appendStringSets()
+// ----------------------------------------------------------------------------
+
+// Appends the strings of all sets in parts to target.
+
+template <typename TString, typename TSpec, typename TParts>
+inline void
+_appendStringSets(StringSet<TString, TSpec> & target, TParts & parts, unsigned /*numThreads*/)
+{
+    for (unsigned p = 0; p < length(parts); ++p)
+        for (unsigned i = 0; i < length(parts[p]); ++i)
+            appendValue(target, parts[p][i]);
+}
+
+// The concatenation strings are copied in parallel to their final positions.
+template <typename TString, typename TDelimiter, typename TParts>
+inline void
+_appendStringSets(StringSet<TString, Owner<ConcatDirect<TDelimiter> > > & target, TParts & parts, unsigned numThreads)
+{
+    typedef StringSet<TString, Owner<ConcatDirect<TDelimiter> > > TStringSet;
+    typedef typename StringSetLimits<TStringSet>::Type TLimits;
+    typedef typename Value<TLimits>::Type TLimit;
+
+    ignoreUnusedVariableWarning(numThreads);  // Only used with OpenMP.
+
+    int numParts = length(parts);
+    String<TLimit> charOffsets;
+    String<TLimit> countOffsets;
+    resize(charOffsets, numParts + 1, Exact());
+    resize(countOffsets, numParts + 1, Exact());
+    charOffsets[0] = length(target.concat);
+    countOffsets[0] = length(target);
+    for (int p = 0; p < numParts; ++p)
+    {
+        charOffsets[p + 1] = charOffsets[p] + length(parts[p].concat);
+        countOffsets[p + 1] = countOffsets[p] + length(parts[p]);
+    }
+
+    resize(target.concat, charOffsets[numParts], Generous());
+    resize(target.limits, countOffsets[numParts] + 1, Generous());
+
+    SEQAN_OMP_PRAGMA(parallel for num_threads(numThreads) schedule(dynamic))
+    for (int p = 0; p < numParts; ++p)
+    {
+        std::copy(begin(parts[p].concat, Standard()), end(parts[p].concat, Standard()),
+                  begin(target.concat, Standard()) + charOffsets[p]);
+        for (unsigned i = 1; i < length(parts[p].limits); ++i)
+            target.limits[countOffsets[p] + i] = charOffsets[p] + parts[p].limits[i];
+    }
+}
+
+template <typename TParts>
+inline void
+_appendStringSets(Nothing & /*target*/, TParts & /*parts*/, unsigned /*numThreads*/)
+{}
+
+// ----------------------------------------------------------------------------
+// Function _readFastAQParallel()
+// ----------------------------------------------------------------------------
+
+// Appends all records that begin at or after beginPos to the string sets.  stopPos is set to the end of the last
+// record read.
+
+template <typename TIdSet, typename TSeqSet, typename TQualSet, typename TText, typename TTag>
+inline int
+_readFastAQParallel(TIdSet & ids,
+                    TSeqSet & seqs,
+                    TQualSet & quals,
+                    TText & text,
+                    __uint64 beginPos,
+                    __uint64 & stopPos,
+                    TTag const & tag,
+                    SequenceParallelReadOptions const & options)
+{
+    __uint64 len = length(text);
+    unsigned numThreads = std::max(options.numThreads, 1u);
+    __uint64 chunkSize = std::max(options.chunkSize, (__uint64)1);
+    if (beginPos > len)
+        beginPos = len;
+
+    // Cut the text into chunks that begin with a record.
+    int numChunks = (len - beginPos + chunkSize - 1) / chunkSize;
+    if (numThreads == 1u || numChunks <= 1)
+        return _readFastAQRange(ids, seqs, quals, text, beginPos, len, stopPos, tag);
+
+    char const * textBegin = begin(text, Standard());
+    String<__uint64> syncPos;
+    resize(syncPos, numChunks + 1, Exact());
+    syncPos[0] = beginPos;
+    syncPos[numChunks] = len;
+    SEQAN_OMP_PRAGMA(parallel for num_threads(numThreads) schedule(static))
+    for (int k = 1; k < numChunks; ++k)
+        syncPos[k] = _fastAQSyncPos(textBegin, len, beginPos + k * chunkSize, tag);
+    for (int k = 1; k < numChunks; ++k)
+        syncPos[k] = std::max(syncPos[k], syncPos[k - 1]);
+
+    // Parse the chunks round by round, so only a few chunks are kept twice in memory.
+    int const roundSize = 4 * numThreads;
+    String<TIdSet> partIds;
+    String<TSeqSet> partSeqs;
+    String<TQualSet> partQuals;
+    String<int> partRes;
+    String<__uint64> partStop;
+    bool ok = true;
+
+    for (int roundBegin = 0; ok && roundBegin < numChunks; roundBegin += roundSize)
+    {
+        int numParts = std::min(roundSize, numChunks - roundBegin);
+        clear(partIds);
+        clear(partSeqs);
+        clear(partQuals);
+        resize(partIds, numParts);
+        resize(partSeqs, numParts);
+        resize(partQuals, numParts);
+        resize(partRes, numParts, Exact());
+        resize(partStop, numParts, Exact());
+
+        SEQAN_OMP_PRAGMA(parallel for num_threads(numThreads) schedule(dynamic))
+        for (int p = 0; p < numParts; ++p)
+            partRes[p] = _readFastAQRange(partIds[p], partSeqs[p], partQuals[p], text, syncPos[roundBegin + p],
+                                          syncPos[roundBegin + p + 1], partStop[p], tag);
+
+        // A chunk that fails or does not end where the next one begins is read serially below.
+        for (int p = 0; ok && p < numParts; ++p)
+            ok = (partRes[p] == 0 && partStop[p] == syncPos[roundBegin + p + 1]);
+        if (!ok)
+        {
+            beginPos = syncPos[roundBegin];
+            break;
+        }
+
+        _appendStringSets(ids, partIds, numThreads);
+        _appendStringSets(seqs, partSeqs, numThreads);
+        _appendStringSets(quals, partQuals, numThreads);
+    }
+
+    if (ok)
+    {
+        stopPos = len;
+        return 0;
+    }
+    return _readFastAQRange(ids, seqs, quals, text, beginPos, len, stopPos, tag);
+}
+
+// ----------------------------------------------------------------------------
+// Function readAllParallel()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn FastaFastqIO#readAllParallel
+ * @headerfile <seqan/seq_io.h>
+ * @brief Read all FASTA or FASTQ records of a text in memory using multiple threads.
+ *
+ * @signature int readAllParallel(ids, seqs, text, tag[, options]);
+ * @signature int readAllParallel(ids, seqs, quals, text, tag[, options]);
+ *
+ * @param[out] ids     @link StringSet @endlink of identifiers.
+ * @param[out] seqs    @link StringSet @endlink of sequences.
+ * @param[out] quals   @link StringSet @endlink of qualities.
+ * @param[in]  text    The file contents, e.g. a @link MMapString @endlink.  Types: <tt>String&lt;char, TSpec&gt;</tt>
+ * @param[in]  tag     The format selector. Types: nolink:<tt>Fasta</tt>, <tt>Fastq</tt>
+ * @param[in]  options The @link SequenceParallelReadOptions @endlink to use.
+ *
+ * @return int 0 on success, non-0 value on errors.
+ *
+ * @section Remarks
+ *
+ * The records are stored in file order, the result is the same as reading them with @link
+ * FastaFastqIO#readRecord @endlink one by one.  Use <tt>Owner&lt;ConcatDirect&lt;&gt; &gt;</tt> string sets, which are
+ * filled in parallel as well.  FASTQ files must have one sequence and quality line per record to be parsed in
+ * parallel, other files are read serially.
+ */
+
+/**
+.Function.readAllParallel
+..cat:Input/Output
+..summary:Read all FASTA or FASTQ records of a text in memory using multiple threads.
+..signature:readAllParallel(ids, seqs, text, tag[, options])
+..signature:readAllParallel(ids, seqs, quals, text, tag[, options])
+..param.ids:@Class.StringSet@ of identifiers.
+..param.seqs:@Class.StringSet@ of sequences.
+..param.quals:@Class.StringSet@ of qualities.
+..param.text:The file contents, e.g. a @Spec.MMap String@.
+...type:Shortcut.CharString
+..param.tag:The format selector.
+...type:nolink:$Fasta$, $Fastq$
+..param.options:The options to use.
+...type:Class.SequenceParallelReadOptions
+..returns:$0$ on success, non-$0$ on errors.
+..remarks:The records are stored in file order, the result is the same as reading them with @Function.readRecord@ one by one.
+Use $Owner<ConcatDirect<> >$ string sets, which are filled in parallel as well.
+FASTQ files must have one sequence and quality line per record to be parsed in parallel, other files are read serially.
+..example.code:
+String<char, MMap<> > text;
+open(text, "reads.fq", OPEN_RDONLY);
+
+StringSet<CharString, Owner<ConcatDirect<> > > ids;
+StringSet<String<Dna5Q>, Owner<ConcatDirect<> > > seqs;
+int res = readAllParallel(ids, seqs, text, Fastq());
+..include:seqan/seq_io.h
+*/
+
+template <typename TId, typename TIdSpec, typename TSequence, typename TSeqSpec, typename TQualities,
+          typename TQualSpec, typename TTextSpec, typename TTag>
+inline int
+readAllParallel(StringSet<TId, TIdSpec> & ids,
+                StringSet<TSequence, TSeqSpec> & seqs,
+                StringSet<TQualities, TQualSpec> & quals,
+                String<char, TTextSpec> & text,
+                TTag const & tag,
+                SequenceParallelReadOptions const & options)
+{
+    clear(ids);
+    clear(seqs);
+    clear(quals);
+    __uint64 stopPos = 0;
+    return _readFastAQParallel(ids, seqs, quals, text, 0, stopPos, tag, options);
+}
+
+template <typename TId, typename TIdSpec, typename TSequence, typename TSeqSpec, typename TQualities,
+          typename TQualSpec, typename TTextSpec, typename TTag>
+inline int
+readAllParallel(StringSet<TId, TIdSpec> & ids,
+                StringSet<TSequence, TSeqSpec> & seqs,
+                StringSet<TQualities, TQualSpec> & quals,
+                String<char, TTextSpec> & text,
+                TTag const & tag)
+{
+    return readAllParallel(ids, seqs, quals, text, tag, SequenceParallelReadOptions());
+}
+
+template <typename TId, typename TIdSpec, typename TSequence, typename TSeqSpec, typename TTextSpec, typename TTag>
+inline int
+readAllParallel(StringSet<TId, TIdSpec> & ids,
+                StringSet<TSequence, TSeqSpec> & seqs,
+                String<char, TTextSpec> & text,
+                TTag const & tag,
+                SequenceParallelReadOptions const & options)
+{
+    clear(ids);
+    clear(seqs);
+    Nothing quals;
+    __uint64 stopPos = 0;
+    return _readFastAQParallel(ids, seqs, quals, text, 0, stopPos, tag, options);
+}
+
+template <typename TId, typename TIdSpec, typename TSequence, typename TSeqSpec, typename TTextSpec, typename TTag>
+inline int
+readAllParallel(StringSet<TId, TIdSpec> & ids,
+                StringSet<TSequence, TSeqSpec> & seqs,
+                String<char, TTextSpec> & text,
+                TTag const & tag)
+{
+    return readAllParallel(ids, seqs, text, tag, SequenceParallelReadOptions());
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef SEQAN_SEQ_IO_READ_FASTA_FASTQ_PARALLEL_H_
@@ -948,6 +948,120 @@ int readAll(StringSet<TId, TIdSpec> & ids,
     return res;
 }
 
+// ----------------------------------------------------------------------------
+// Function readAllParallel()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn SequenceStream#readAllParallel
+ * @brief Read all sequence records from a @link SequenceStream @endlink object using multiple threads.
+ *
+ * @signature int readAllParallel(ids, seqs, seqStream[, options]);
+ * @signature int readAllParallel(ids, seqs, quals, seqStream[, options]);
+ *
+ * @param[out] ids       The identifiers of the sequence are written here. Types: @link StringSet @endlink of @link
+ *                       CharString @endlink.
+ * @param[out] seqs      The sequence of the record is written here. Types: StringSet
+ * @param[out] quals     The qualities of the sequence is written here.  Optional.  If the sequences have no
+ *                       qualities, as in FASTA files, the @link StringSet @endlink will contain empty strings.
+ *                       Type: @link StringSet @endlink of @link CharString @endlink
+ * @param[out] seqStream The @link SequenceStream @endlink object to read from.  Type: SequenceStream
+ * @param[in]  options   The @link SequenceParallelReadOptions @endlink to use.
+ *
+ * @return int 0 on success, non-0 value on errors.
+ *
+ * @section Remarks
+ *
+ * Uncompressed files opened with the default single-pass hint are parsed in parallel like with @link
+ * FastaFastqIO#readAllParallel @endlink, the result is the same as with @link SequenceStream#readAll @endlink.
+ * Other files are read serially with @link SequenceStream#readAll @endlink.
+ */
+
+/**
+.Function.SequenceStream#readAllParallel
+..class:Class.SequenceStream
+..summary:Read all sequence records from a @Class.SequenceStream@ object using multiple threads.
+..signature:int readAllParallel(ids, seqs, seqIO[, options])
+..signature:int readAllParallel(ids, seqs, quals, seqIO[, options])
+..param.ids:The identifiers of the sequence are written here.
+...type:nolink:@Class.StringSet@ of @Shortcut.CharString@.
+..param.seq:The sequence of the record is written here.
+...type:Class.StringSet
+..param.quals:The qualities of the sequence is written here. Optional.
+...type:nolink:@Class.StringSet@ of @Shortcut.CharString@.
+...remarks:If the sequences have no qualities, as in FASTA files, the @Class.StringSet@ will contain empty strings.
+..param.seqIO:The @Class.SequenceStream@ object to read from.
+...type:Class.SequenceStream
+..param.options:The options to use.
+...type:Class.SequenceParallelReadOptions
+..returns:An integer, $0$ on success, $1$ on errors.
+...type:nolink:$int$
+..remarks:Uncompressed files opened with the default single-pass hint are parsed in parallel like with
+@Function.readAllParallel@, the result is the same as with @Function.SequenceStream#readAll@.
+Other files are read serially with @Function.SequenceStream#readAll@.
+..include:seqan/seq_io.h
+*/
+
+template <typename TId, typename TIdSpec, typename TSequence, typename TSeqSpec, typename TQualities,
+          typename TQualSpec>
+int readAllParallel(StringSet<TId, TIdSpec> & ids,
+                    StringSet<TSequence, TSeqSpec> & seqs,
+                    StringSet<TQualities, TQualSpec> & quals,
+                    SequenceStream & seqIO,
+                    SequenceParallelReadOptions const & options)
+{
+    int res = 0;
+
+    if (seqIO._fileFormat == SeqIOFileFormat_::FILE_FORMAT_FASTA)
+        res = seqIO._impl->readAllParallel(ids, seqs, quals, Fasta(), options);
+    else if (seqIO._fileFormat == SeqIOFileFormat_::FILE_FORMAT_FASTQ)
+        res = seqIO._impl->readAllParallel(ids, seqs, quals, Fastq(), options);
+    else
+        res = 1;
+
+    seqIO._isGood = seqIO._impl->_isGood;
+    seqIO._atEnd = seqIO._impl->_atEnd;
+    return res;
+}
+
+template <typename TId, typename TIdSpec, typename TSequence, typename TSeqSpec, typename TQualities,
+          typename TQualSpec>
+int readAllParallel(StringSet<TId, TIdSpec> & ids,
+                    StringSet<TSequence, TSeqSpec> & seqs,
+                    StringSet<TQualities, TQualSpec> & quals,
+                    SequenceStream & seqIO)
+{
+    return readAllParallel(ids, seqs, quals, seqIO, SequenceParallelReadOptions());
+}
+
+template <typename TId, typename TIdSpec, typename TSequence, typename TSeqSpec>
+int readAllParallel(StringSet<TId, TIdSpec> & ids,
+                    StringSet<TSequence, TSeqSpec> & seqs,
+                    SequenceStream & seqIO,
+                    SequenceParallelReadOptions const & options)
+{
+    int res = 0;
+
+    if (seqIO._fileFormat == SeqIOFileFormat_::FILE_FORMAT_FASTA)
+        res = seqIO._impl->readAllParallel(ids, seqs, Fasta(), options);
+    else if (seqIO._fileFormat == SeqIOFileFormat_::FILE_FORMAT_FASTQ)
+        res = seqIO._impl->readAllParallel(ids, seqs, Fastq(), options);
+    else
+        res = 1;
+
+    seqIO._isGood = seqIO._impl->_isGood;
+    seqIO._atEnd = seqIO._impl->_atEnd;
+    return res;
+}
+
+template <typename TId, typename TIdSpec, typename TSequence, typename TSeqSpec>
+int readAllParallel(StringSet<TId, TIdSpec> & ids,
+                    StringSet<TSequence, TSeqSpec> & seqs,
+                    SequenceStream & seqIO)
+{
+    return readAllParallel(ids, seqs, seqIO, SequenceParallelReadOptions());
+}
+
 // ----------------------------------------------------------------------------
 // Function writeRecord()
 // ----------------------------------------------------------------------------
@@ -869,6 +869,61 @@ public:
         return res;
     }
 
+    // -----------------------------------------------------------------------
+    // Function readAllParallel()
+    // -----------------------------------------------------------------------
+
+    // These two template functions parse the whole file in parallel if it is in memory and fall back to readAll()
+    // otherwise.
+
+    template <typename TId, typename TIdSpec, typename TSequence, typename TSeqSpec, typename TQualities,
+              typename TQualSpec, typename TFormatTag>
+    int readAllParallel(StringSet<TId, TIdSpec> & ids,
+                        StringSet<TSequence, TSeqSpec> & seqs,
+                        StringSet<TQualities, TQualSpec> & quals,
+                        TFormatTag const & tag,
+                        SequenceParallelReadOptions const & options)
+    {
+        if (_fileType != SeqIOFileType_::FILE_TYPE_TEXT || _hintDoublePass)
+            return readAll(ids, seqs, quals, tag);
+
+        clear(ids);
+        clear(seqs);
+        clear(quals);
+
+        __uint64 stopPos = 0;
+        int res = _readFastAQParallel(ids, seqs, quals, *_mmapString, position(*_mmapReaderSinglePass), stopPos, tag,
+                                      options);
+        setPosition(*_mmapReaderSinglePass, stopPos);
+        _atEnd = seqan::atEnd(*_mmapReaderSinglePass);
+
+        _isGood = _isGood && (res == 0);
+        return res;
+    }
+
+    template <typename TId, typename TIdSpec, typename TSequence, typename TSeqSpec, typename TFormatTag>
+    int readAllParallel(StringSet<TId, TIdSpec> & ids,
+                        StringSet<TSequence, TSeqSpec> & seqs,
+                        TFormatTag const & tag,
+                        SequenceParallelReadOptions const & options)
+    {
+        if (_fileType != SeqIOFileType_::FILE_TYPE_TEXT || _hintDoublePass)
+            return readAll(ids, seqs, tag);
+
+        clear(ids);
+        clear(seqs);
+
+        Nothing quals;
+        __uint64 stopPos = 0;
+        int res = _readFastAQParallel(ids, seqs, quals, *_mmapString, position(*_mmapReaderSinglePass), stopPos, tag,
+                                      options);
+        setPosition(*_mmapReaderSinglePass, stopPos);
+        _atEnd = seqan::atEnd(*_mmapReaderSinglePass);
+
+        _isGood = _isGood && (res == 0);
+        return res;
+    }
+
     // -----------------------------------------------------------------------
     // Function writeRecord()
     // -----------------------------------------------------------------------
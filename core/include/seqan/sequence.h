@@ -49,6 +49,7 @@
 // ===========================================================================
 
 #include <seqan/basic.h>
+#include <seqan/misc/misc_bit_twiddling.h>  // popCount() for packed strings
 
 // ----------------------------------------------------------------------------
 // STL prerequisites.
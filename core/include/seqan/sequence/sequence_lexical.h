@@ -1067,6 +1067,58 @@ SEQAN_CHECKPOINT
     return _lex.data_lcp;
 }
 
+
+//////////////////////////////////////////////////////////////////////////////
+// hammingDistance
+//////////////////////////////////////////////////////////////////////////////
+
+/*!
+ * @fn hammingDistance
+ * @headerfile <seqan/sequence.h>
+ * @brief Number of positions at which two sequences of equal length differ.
+ *
+ * @signature TSize hammingDistance(left, right);
+ *
+ * @param[in] left  The first sequence.
+ * @param[in] right The second sequence, must have the same length as <tt>left</tt>.
+ *
+ * @return TSize The number of mismatching positions.  TSize is the Size type of <tt>left</tt>.
+ *
+ * @section Remarks
+ *
+ * Two Packed Strings are compared a machine word at a time.
+ */
+
+/**
+.Function.hammingDistance:
+..summary:Number of positions at which two sequences of equal length differ.
+..cat:Comparisons
+..signature:hammingDistance(left, right)
+..param.left:The first sequence.
+..param.right:The second sequence. Must have the same length as $left$.
+..returns:The number of mismatching positions.
+..remarks:Two @Spec.Packed String@ objects are compared a machine word at a time.
+..include:seqan/sequence.h
+*/
+template <typename TLeft, typename TRight>
+inline typename Size<TLeft>::Type
+hammingDistance(TLeft const & left, TRight const & right)
+{
+    typedef typename Iterator<TLeft const, Standard>::Type TLeftIter;
+    typedef typename Iterator<TRight const, Standard>::Type TRightIter;
+
+    SEQAN_ASSERT_EQ(length(left), length(right));
+
+    typename Size<TLeft>::Type dist = 0;
+    TLeftIter leftIt = begin(left, Standard());
+    TLeftIter leftEnd = end(left, Standard());
+    TRightIter rightIt = begin(right, Standard());
+    for (; leftIt != leftEnd; ++leftIt, ++rightIt)
+        if (*leftIt != *rightIt)
+            ++dist;
+    return dist;
+}
+
 } //namespace SEQAN_NAMESPACE_MAIN
 
 #endif //#ifndef SEQAN_HEADER_...
@@ -120,6 +120,19 @@ struct PackedTraits_
     {
         return (len == 0)? 0: 1 + (len + VALUES_PER_HOST_VALUE - 1) / VALUES_PER_HOST_VALUE;
     }
+
+    // mask of the first n values in a host word (the first value occupies the most significant bits)
+    static inline
+    typename THostValue::TBitVector
+    prefixMask(typename Size<TPackedString>::Type n)
+    {
+        typedef typename THostValue::TBitVector TBitVector;
+
+        TBitVector allOne = ~(TBitVector)0 >> WASTED_BITS;
+        if (n >= (typename Size<TPackedString>::Type)VALUES_PER_HOST_VALUE)
+            return allOne;
+        return allOne & ~(allOne >> (n * BITS_PER_VALUE));
+    }
 };
 
 /**
@@ -771,17 +784,21 @@ _arrayConstructCopyDefault(TSource1 source_begin,
 // |      |   aaa|BBCCCC|ddd   |      | target
 // ------------------------------------
 
-template < typename TPackedString, typename TSpec >
+template < typename TSourceString, typename TTargetString, typename TSpec >
 inline void 
-arrayCopyForward(Iter<TPackedString, Packed<TSpec> > source_begin,
-                 Iter<TPackedString, Packed<TSpec> > source_end,
-                 Iter<TPackedString, Packed<TSpec> > target_begin)
+arrayCopyForward(Iter<TSourceString, Packed<TSpec> > source_begin,
+                 Iter<TSourceString, Packed<TSpec> > source_end,
+                 Iter<TTargetString, Packed<TSpec> > target_begin)
 {
-    typedef PackedTraits_<TPackedString> TTraits;
+    typedef PackedTraits_<TTargetString> TTraits;
     typedef typename TTraits::THostValue THostValue;
-    typedef typename Size<TPackedString>::Type TSize;
-    typedef typename Host<Iter<TPackedString, Packed<TSpec> > >::Type THostIter;
-    
+    typedef typename Size<TTargetString>::Type TSize;
+    typedef typename Host<Iter<TSourceString, Packed<TSpec> > >::Type THostIter;
+    typedef typename THostValue::TBitVector TBitVector;
+
+    // the unused bits of a word must neither be shifted into values nor into the target's unused bits
+    static const TBitVector ALL_ONE = ~(TBitVector)0 >> TTraits::WASTED_BITS;
+
     TSize size = source_end - source_begin;
 
     // will we touch more than one word in the target string?
@@ -808,7 +825,7 @@ arrayCopyForward(Iter<TPackedString, Packed<TSpec> > source_begin,
             if (source_end.localPos < source_begin.localPos)
                 --source_lastWord;
 
-            register typename THostValue::TBitVector prevWord = hostIterator(source_begin)->i;
+            register TBitVector prevWord = hostIterator(source_begin)->i & ALL_ONE;
             register int rightShift = TTraits::VALUES_PER_HOST_VALUE - leftShift;
             leftShift *= TTraits::BITS_PER_VALUE;
             rightShift *= TTraits::BITS_PER_VALUE;
@@ -816,8 +833,8 @@ arrayCopyForward(Iter<TPackedString, Packed<TSpec> > source_begin,
             {
                 // words must be shifted and or'ed (BB|CCCC in the figure)
                 ++hostIterator(source_begin);
-                register typename THostValue::TBitVector curWord = hostIterator(source_begin)->i;
-                hostIterator(target_begin)->i = (prevWord << leftShift) | (curWord >> rightShift);
+                register TBitVector curWord = hostIterator(source_begin)->i & ALL_ONE;
+                hostIterator(target_begin)->i = ((prevWord << leftShift) | (curWord >> rightShift)) & ALL_ONE;
                 prevWord = curWord;
             }
         }
@@ -826,11 +843,12 @@ arrayCopyForward(Iter<TPackedString, Packed<TSpec> > source_begin,
             // words need not to be shifted
             arrayCopyForward(hostIterator(source_begin), hostIterator(source_end), hostIterator(target_begin));
             hostIterator(target_begin) += hostIterator(source_end) - hostIterator(source_begin);
+            hostIterator(source_begin) = hostIterator(source_end);
         }
     }
 
-    // copy (less than VALUES_PER_HOST_VALUE many) remaining values (d's in figure above)
-    while (source_begin.localPos != source_end.localPos)
+    // copy (at most VALUES_PER_HOST_VALUE many) remaining values (d's in figure above)
+    while (source_begin != source_end)
     {
         assignValue(target_begin, getValue(source_begin));
         ++source_begin;
@@ -852,16 +870,20 @@ arrayCopyForward(Iter<TPackedString, Packed<TSpec> > source_begin,
 // |      |      |   aaa|BBCCCC|ddd   | target
 // ------------------------------------
 
-template < typename TPackedString, typename TSpec >
+template < typename TSourceString, typename TTargetString, typename TSpec >
 inline void 
-arrayCopyBackward(Iter<TPackedString, Packed<TSpec> > source_begin,
-                  Iter<TPackedString, Packed<TSpec> > source_end,
-                  Iter<TPackedString, Packed<TSpec> > target_begin)
+arrayCopyBackward(Iter<TSourceString, Packed<TSpec> > source_begin,
+                  Iter<TSourceString, Packed<TSpec> > source_end,
+                  Iter<TTargetString, Packed<TSpec> > target_begin)
 {
-    typedef PackedTraits_<TPackedString> TTraits;
+    typedef PackedTraits_<TTargetString> TTraits;
     typedef typename TTraits::THostValue THostValue;
-    typedef typename Size<TPackedString>::Type TSize;
-    typedef typename Host<Iter<TPackedString, Packed<TSpec> > >::Type THostIter;
+    typedef typename Size<TTargetString>::Type TSize;
+    typedef typename Host<Iter<TTargetString, Packed<TSpec> > >::Type THostIter;
+    typedef typename THostValue::TBitVector TBitVector;
+
+    // the unused bits of a word must neither be shifted into values nor into the target's unused bits
+    static const TBitVector ALL_ONE = ~(TBitVector)0 >> TTraits::WASTED_BITS;
 
     // iterator to the first whole word in the target
     THostIter target_firstWord = hostIterator(target_begin);
@@ -886,7 +908,7 @@ arrayCopyBackward(Iter<TPackedString, Packed<TSpec> > source_begin,
         register int leftShift = source_end.localPos;
         if (leftShift != 0)
         {
-            register typename THostValue::TBitVector prevWord = hostIterator(source_end)->i;
+            register TBitVector prevWord = hostIterator(source_end)->i & ALL_ONE;
             register int rightShift = TTraits::VALUES_PER_HOST_VALUE - leftShift;
             leftShift *= TTraits::BITS_PER_VALUE;
             rightShift *= TTraits::BITS_PER_VALUE;
@@ -896,8 +918,8 @@ arrayCopyBackward(Iter<TPackedString, Packed<TSpec> > source_begin,
                 --hostIterator(target_begin);
 
                 // words must be shifted and or'ed (BB|CCCC in the figure)
-                register typename THostValue::TBitVector curWord = hostIterator(source_end)->i;
-                hostIterator(target_begin)->i = (curWord << leftShift) | (prevWord >> rightShift);
+                register TBitVector curWord = hostIterator(source_end)->i & ALL_ONE;
+                hostIterator(target_begin)->i = ((curWord << leftShift) | (prevWord >> rightShift)) & ALL_ONE;
                 prevWord = curWord;
             }
         }
@@ -975,11 +997,11 @@ arrayFill(Iter<TPackedString, Packed<TSpec> > begin_,
 // --------------------------------------------------------------------------
 
 // TODO(weese): There should be default wrappers using arrayCopyForward (so that these overloads are not necessary)
-template < typename TPackedString, typename TSpec >
+template < typename TSourceString, typename TTargetString, typename TSpec >
 inline void 
-arrayMoveForward(Iter<TPackedString, Packed<TSpec> > source_begin,
-                 Iter<TPackedString, Packed<TSpec> > source_end,
-                 Iter<TPackedString, Packed<TSpec> > target_begin)
+arrayMoveForward(Iter<TSourceString, Packed<TSpec> > source_begin,
+                 Iter<TSourceString, Packed<TSpec> > source_end,
+                 Iter<TTargetString, Packed<TSpec> > target_begin)
 {
     arrayCopyForward(source_begin, source_end, target_begin);
 }
@@ -989,11 +1011,11 @@ arrayMoveForward(Iter<TPackedString, Packed<TSpec> > source_begin,
 // --------------------------------------------------------------------------
 
 // TODO(weese): There should be default wrappers using arrayCopyBackward (so that these overloads are not necessary)
-template < typename TPackedString, typename TSpec >
+template < typename TSourceString, typename TTargetString, typename TSpec >
 inline void
-arrayMoveBackward(Iter<TPackedString, Packed<TSpec> > source_begin,
-                  Iter<TPackedString, Packed<TSpec> > source_end,
-                  Iter<TPackedString, Packed<TSpec> > target_begin)
+arrayMoveBackward(Iter<TSourceString, Packed<TSpec> > source_begin,
+                  Iter<TSourceString, Packed<TSpec> > source_end,
+                  Iter<TTargetString, Packed<TSpec> > target_begin)
 {
     arrayCopyBackward(source_begin, source_end, target_begin);
 }
@@ -1003,11 +1025,11 @@ arrayMoveBackward(Iter<TPackedString, Packed<TSpec> > source_begin,
 // --------------------------------------------------------------------------
 
 // TODO(weese): it should be not necessary to overload construct/destruct functions for POD/Simple types (IsSimple == true)
-template < typename TPackedString, typename TSpec >
+template < typename TSourceString, typename TTargetString, typename TSpec >
 inline void
-arrayConstructCopy(Iter<TPackedString, Packed<TSpec> > source_begin,
-                   Iter<TPackedString, Packed<TSpec> > source_end,
-                   Iter<TPackedString, Packed<TSpec> > target_begin)
+arrayConstructCopy(Iter<TSourceString, Packed<TSpec> > source_begin,
+                   Iter<TSourceString, Packed<TSpec> > source_end,
+                   Iter<TTargetString, Packed<TSpec> > target_begin)
 {
     arrayCopyForward(source_begin, source_end, target_begin);
 }
@@ -1618,6 +1640,170 @@ operator-(Iter<TPackedString, Packed<THostspec> > const & iterLeft,
            (TDiff)iterLeft.localPos - (TDiff)iterRight.localPos;
 }
 
+
+// ============================================================================
+// Word-parallel kernels
+// ============================================================================
+
+// --------------------------------------------------------------------------
+// Function _packedWordAt()
+// --------------------------------------------------------------------------
+
+// Returns the values beginning at it as one host word, aligned like a word of
+// the host string (the value at it in the most significant bits).  Only the
+// first n values are meaningful.  The word following hostIterator(it) is read
+// only if some of these n values lie in it.
+
+template <typename TPackedString, typename THostspec, typename TSize>
+inline typename PackedTraits_<TPackedString>::THostValue::TBitVector
+_packedWordAt(Iter<TPackedString, Packed<THostspec> > const & it, TSize n)
+{
+    typedef PackedTraits_<TPackedString> TTraits;
+    typedef typename TTraits::THostValue::TBitVector TBitVector;
+
+    TBitVector word = hostIterator(it)->i;
+    if (it.localPos != 0)
+    {
+        word <<= it.localPos * TTraits::BITS_PER_VALUE;
+        if (n > (TSize)(TTraits::VALUES_PER_HOST_VALUE - it.localPos))
+            word |= (hostIterator(it) + 1)->i >> ((TTraits::VALUES_PER_HOST_VALUE - it.localPos) * TTraits::BITS_PER_VALUE);
+    }
+    return word;
+}
+
+// --------------------------------------------------------------------------
+// Function _comparePacked()
+// --------------------------------------------------------------------------
+
+// Compares the first len values of two packed ranges a host word at a time.
+// Sets lexical.data_lcp and, if the ranges differ, lexical.data_compare.
+
+template <typename TSpec, typename TLeftString, typename TRightString, typename THostspec, typename TSize>
+inline void
+_comparePacked(Lexical<TSpec> & lexical,
+               Iter<TLeftString, Packed<THostspec> > leftIt,
+               Iter<TRightString, Packed<THostspec> > rightIt,
+               TSize len)
+{
+    typedef PackedTraits_<TLeftString> TTraits;
+    typedef typename TTraits::THostValue THostValue;
+    typedef typename THostValue::TBitVector TBitVector;
+
+    for (lexical.data_lcp = 0; (TSize)lexical.data_lcp < len; )
+    {
+        TSize n = _min(len - (TSize)lexical.data_lcp, (TSize)TTraits::VALUES_PER_HOST_VALUE);
+        TBitVector mask = TTraits::prefixMask(n);
+        TBitVector leftWord = _packedWordAt(leftIt, n) & mask;
+        TBitVector rightWord = _packedWordAt(rightIt, n) & mask;
+
+        if (leftWord != rightWord)
+        {
+            // the first value is stored in the most significant bits, hence
+            // the words compare like the value sequences they contain
+            TBitVector diff = leftWord ^ rightWord;
+            int shift = (TTraits::VALUES_PER_HOST_VALUE - 1) * TTraits::BITS_PER_VALUE;
+            for (; ((diff >> shift) & THostValue::BIT_MASK) == 0; shift -= TTraits::BITS_PER_VALUE)
+                ++lexical.data_lcp;
+            lexical.data_compare = (leftWord < rightWord)? Lexical<TSpec>::LESS: Lexical<TSpec>::GREATER;
+            return;
+        }
+
+        lexical.data_lcp += n;
+        leftIt += n;
+        rightIt += n;
+    }
+}
+
+// --------------------------------------------------------------------------
+// Function compare()
+// --------------------------------------------------------------------------
+
+///.Function.compare.param.left.type:Spec.Packed String
+///.Function.compare.param.right.type:Spec.Packed String
+
+template <typename TSpec, typename TValue, typename THostspec>
+inline void
+compare(Lexical<TSpec> & lexical,
+        String<TValue, Packed<THostspec> > const & left,
+        String<TValue, Packed<THostspec> > const & right)
+{
+    typedef typename Size<String<TValue, Packed<THostspec> > >::Type TSize;
+
+    // signed values don't compare like their bit patterns
+    if (!IsSameType<typename MakeUnsigned<TValue>::Type, TValue>::VALUE)
+    {
+        compare_(lexical, left, right);
+        return;
+    }
+
+    TSize minLength = length(left);
+    if (length(left) == length(right))
+        lexical.data_compare = Lexical<TSpec>::EQUAL;
+    else if (length(left) < length(right))
+        lexical.data_compare = Lexical<TSpec>::LEFT_IS_PREFIX;
+    else
+    {
+        lexical.data_compare = Lexical<TSpec>::RIGHT_IS_PREFIX;
+        minLength = length(right);
+    }
+
+    lexical.data_lcp = 0;
+    if (minLength != 0)
+        _comparePacked(lexical, begin(left, Standard()), begin(right, Standard()), minLength);
+}
+
+// --------------------------------------------------------------------------
+// Function hammingDistance()
+// --------------------------------------------------------------------------
+
+// Counts the mismatching values of two packed ranges a host word at a time.
+// The bits of each value are or'ed into its least significant bit and the
+// resulting bits are counted.
+
+template <typename TLeftString, typename TRightString, typename THostspec, typename TSize>
+inline TSize
+_hammingDistancePacked(Iter<TLeftString, Packed<THostspec> > leftIt,
+                       Iter<TRightString, Packed<THostspec> > rightIt,
+                       TSize len)
+{
+    typedef PackedTraits_<TLeftString> TTraits;
+    typedef typename TTraits::THostValue::TBitVector TBitVector;
+
+    static const TBitVector LOWEST_BITS = FillMultiplierRecursion_<
+        TBitVector,
+        TTraits::BITS_PER_VALUE,
+        TTraits::VALUES_PER_HOST_VALUE>::VALUE;
+
+    TSize dist = 0;
+    while (len != 0)
+    {
+        TSize n = _min(len, (TSize)TTraits::VALUES_PER_HOST_VALUE);
+        TBitVector diff = (_packedWordAt(leftIt, n) ^ _packedWordAt(rightIt, n)) & TTraits::prefixMask(n);
+        TBitVector folded = diff;
+        for (int i = 1; i < TTraits::BITS_PER_VALUE; ++i)
+            folded |= diff >> i;
+        dist += popCount(folded & LOWEST_BITS);
+
+        len -= n;
+        leftIt += n;
+        rightIt += n;
+    }
+    return dist;
+}
+
+///.Function.hammingDistance.param.left.type:Spec.Packed String
+///.Function.hammingDistance.param.right.type:Spec.Packed String
+
+template <typename TValue, typename THostspec>
+inline typename Size<String<TValue, Packed<THostspec> > >::Type
+hammingDistance(String<TValue, Packed<THostspec> > const & left,
+                String<TValue, Packed<THostspec> > const & right)
+{
+    SEQAN_ASSERT_EQ(length(left), length(right));
+
+    return _hammingDistancePacked(begin(left, Standard()), begin(right, Standard()), length(left));
+}
+
 }  // namespace seqan
 
 #endif  // #ifndef SEQAN_SEQUENCE_STRING_PACKED_H_
@@ -59,6 +59,7 @@
 #include <seqan/sequence_journaled/journal_entries_unbalanced_tree.h>
 #include <seqan/sequence_journaled/journal_entries_unbalanced_tree_iterator.h>
 #include <seqan/sequence_journaled/journal_entries_sorted_array.h>
+#include <seqan/sequence_journaled/journal_entries_bplus_tree.h>
 #include <seqan/sequence_journaled/sequence_journaled.h>
 #include <seqan/sequence_journaled/sequence_journaled_iterator.h>
 
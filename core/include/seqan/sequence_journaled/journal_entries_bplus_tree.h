@@ -0,0 +1,1210 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Author: agent <agent@local>
+// ==========================================================================
+// Journal entries stored in a B+-tree.
+//
+// The leaves hold the journal entries in order and are linked for sequential
+// iteration.  The inner nodes store the virtual length of each subtree, so
+// the virtual position of an entry is implicit: it is the sum of the lengths
+// left of it.  This way an insertion or deletion only updates one leaf and
+// the lengths on the path to the root instead of all entries right of it.
+// The virtualPosition member of the stored entries is unused, the iterator
+// returns copies of the entries with the virtual position filled in.
+//
+// An inner node holds the lengths of its children in one cache line.  Nodes
+// are split when full but underfull nodes are not merged, only empty nodes
+// are removed.
+// ==========================================================================
+
+#ifndef SEQAN_SEQUENCE_JOURNALED_JOURNAL_ENTRIES_BPLUS_TREE_H_
+#define SEQAN_SEQUENCE_JOURNALED_JOURNAL_ENTRIES_BPLUS_TREE_H_
+
+namespace seqan {
+
+// ============================================================================
+// Tags, Classes
+// ============================================================================
+
+// Tag: B+-tree.
+struct BPlusTree {};
+
+template <typename TCargo>
+struct JournalEntriesBPlusTreeLeaf_
+{
+    enum { CAPACITY = 16 };
+
+    // The entries, their virtual positions are not maintained.
+    TCargo entries[CAPACITY];
+    // Number of entries.
+    unsigned count;
+    // Sum of the entry lengths.
+    typename Size<TCargo>::Type length;
+    // Neighbouring leaves, 0 for the first/last leaf.
+    JournalEntriesBPlusTreeLeaf_ * prev;
+    JournalEntriesBPlusTreeLeaf_ * next;
+
+    JournalEntriesBPlusTreeLeaf_() : count(0), length(0), prev(0), next(0) {}
+};
+
+template <typename TSize>
+struct JournalEntriesBPlusTreeInner_
+{
+    enum { CAPACITY = 64 / sizeof(TSize) };
+
+    // Virtual lengths of the subtrees.
+    TSize lengths[CAPACITY];
+    // Children, leaves in the lowest inner level.
+    void * children[CAPACITY];
+    // Number of children.
+    unsigned count;
+
+    JournalEntriesBPlusTreeInner_() : count(0) {}
+};
+
+template <typename TCargo_>
+class JournalEntries<TCargo_, BPlusTree>
+{
+public:
+    typedef TCargo_ TCargo;
+    typedef typename Size<TCargo>::Type TSize;
+    typedef typename Position<TCargo>::Type TPos;
+    typedef JournalEntriesBPlusTreeLeaf_<TCargo> TLeaf;
+    typedef JournalEntriesBPlusTreeInner_<TSize> TInner;
+    typedef BPlusTree TSpec;
+
+    enum { MAX_HEIGHT = 32 };
+
+    // The root, a leaf if _height is 0 and an inner node otherwise.
+    void * _root;
+    // Number of inner levels.
+    unsigned _height;
+    // Number of entries.
+    TSize _entryCount;
+    // Virtual length, i.e. the sum of all entry lengths.
+    TSize _length;
+    // First and last leaf.
+    TLeaf * _firstLeaf;
+    TLeaf * _lastLeaf;
+    // Length of the underlying string.
+    TSize _originalStringLength;
+
+    JournalEntries()
+            : _root(0), _height(0), _entryCount(0), _length(0), _firstLeaf(0), _lastLeaf(0),
+              _originalStringLength(0)
+    {}
+
+    JournalEntries(JournalEntries const & other)
+            : _root(0), _height(0), _entryCount(0), _length(0), _firstLeaf(0), _lastLeaf(0),
+              _originalStringLength(0)
+    {
+        _copyJournalEntriesBPlusTree(*this, other);
+    }
+
+    ~JournalEntries()
+    {
+        _clearJournalEntriesBPlusTree(*this);
+    }
+
+    JournalEntries &
+    operator=(JournalEntries const & other)
+    {
+        if (this != &other)
+            _copyJournalEntriesBPlusTree(*this, other);
+        return *this;
+    }
+};
+
+// Path from the root to an entry.
+template <typename TJournalEntries>
+struct JournalEntriesBPlusTreePath_
+{
+    typedef typename TJournalEntries::TLeaf TLeaf;
+    typedef typename TJournalEntries::TInner TInner;
+    typedef typename TJournalEntries::TPos TPos;
+
+    TInner * nodes[TJournalEntries::MAX_HEIGHT];
+    unsigned childPos[TJournalEntries::MAX_HEIGHT];
+    TLeaf * leaf;
+    unsigned index;
+    // Virtual position of the entry.
+    TPos entryBegin;
+};
+
+// The iterator points to an entry by its leaf and index.  The end iterator
+// points behind the last entry of the last leaf.  value() returns a copy of
+// the entry with the virtual position filled in.
+template <typename TJournalEntries>
+class Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> >
+{
+public:
+    typedef Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> > TIter;
+    typedef typename TJournalEntries::TCargo TCargo;
+    typedef typename TJournalEntries::TLeaf TLeaf;
+    typedef typename TJournalEntries::TPos TPos;
+
+    // The current leaf, 0 if the tree is empty.
+    TLeaf * _leaf;
+    // The index of the entry in the current leaf.
+    unsigned _index;
+    // The virtual position of the entry.
+    TPos _virtualPosition;
+    // The entry returned by value().
+    mutable TCargo _entry;
+
+    Iter() : _leaf(0), _index(0), _virtualPosition(0) {}
+
+    Iter(TIter const & other)
+            : _leaf(other._leaf),
+              _index(other._index),
+              _virtualPosition(other._virtualPosition)
+    {}
+
+    Iter(typename IterComplementConst<TIter>::Type const & other)
+            : _leaf(other._leaf),
+              _index(other._index),
+              _virtualPosition(other._virtualPosition)
+    {}
+
+    TIter &
+    operator=(TIter const & other)
+    {
+        _leaf = other._leaf;
+        _index = other._index;
+        _virtualPosition = other._virtualPosition;
+        return *this;
+    }
+};
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+template <typename TCargo>
+struct Iterator<JournalEntries<TCargo, BPlusTree>, Standard>
+{
+    typedef Iter<JournalEntries<TCargo, BPlusTree>, JournalEntriesIterSpec<BPlusTree> > Type;
+};
+
+template <typename TCargo>
+struct Iterator<JournalEntries<TCargo, BPlusTree> const, Standard>
+{
+    typedef Iter<JournalEntries<TCargo, BPlusTree> const, JournalEntriesIterSpec<BPlusTree> > Type;
+};
+
+template <typename TCargo>
+struct Value<JournalEntries<TCargo, BPlusTree> >
+{
+    typedef TCargo Type;
+};
+
+template <typename TCargo>
+struct Value<JournalEntries<TCargo, BPlusTree> const>
+{
+    typedef TCargo const Type;
+};
+
+template <typename TCargo>
+struct Reference<JournalEntries<TCargo, BPlusTree> >
+{
+    typedef TCargo const & Type;
+};
+
+template <typename TCargo>
+struct Reference<JournalEntries<TCargo, BPlusTree> const>
+{
+    typedef TCargo const & Type;
+};
+
+template <typename TJournalEntries>
+struct Value<Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> > >
+{
+    typedef typename TJournalEntries::TCargo const & Type;
+};
+
+template <typename TJournalEntries>
+struct GetValue<Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> > >
+{
+    typedef typename TJournalEntries::TCargo Type;
+};
+
+template <typename TJournalEntries>
+struct Reference<Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> > >
+{
+    typedef typename TJournalEntries::TCargo const & Type;
+};
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Helper functions for the tree structure
+// ----------------------------------------------------------------------------
+
+template <typename TCargo>
+inline void
+_clearJournalEntriesBPlusTreeRec(JournalEntries<TCargo, BPlusTree> & tree, void * node, unsigned height)
+{
+    typedef JournalEntries<TCargo, BPlusTree> TJournalEntries;
+    typedef typename TJournalEntries::TLeaf TLeaf;
+    typedef typename TJournalEntries::TInner TInner;
+
+    if (height == 0)
+    {
+        delete static_cast<TLeaf *>(node);
+        return;
+    }
+    TInner * inner = static_cast<TInner *>(node);
+    for (unsigned i = 0; i < inner->count; ++i)
+        _clearJournalEntriesBPlusTreeRec(tree, inner->children[i], height - 1);
+    delete inner;
+}
+
+template <typename TCargo>
+inline void
+_clearJournalEntriesBPlusTree(JournalEntries<TCargo, BPlusTree> & tree)
+{
+    if (tree._root != 0)
+        _clearJournalEntriesBPlusTreeRec(tree, tree._root, tree._height);
+    tree._root = 0;
+    tree._height = 0;
+    tree._entryCount = 0;
+    tree._length = 0;
+    tree._firstLeaf = 0;
+    tree._lastLeaf = 0;
+}
+
+// Finds the entry containing virtual position pos, or the last entry if pos is
+// not left of the end.  The tree must not be empty.
+template <typename TCargo, typename TPos>
+inline void
+_findJournalEntriesBPlusTree(JournalEntriesBPlusTreePath_<JournalEntries<TCargo, BPlusTree> > & path,
+                             JournalEntries<TCargo, BPlusTree> const & tree,
+                             TPos pos)
+{
+    typedef JournalEntries<TCargo, BPlusTree> TJournalEntries;
+    typedef typename TJournalEntries::TLeaf TLeaf;
+    typedef typename TJournalEntries::TInner TInner;
+    typedef typename TJournalEntries::TPos TPos_;
+
+    SEQAN_ASSERT(tree._root != 0);
+
+    TPos_ acc = 0;
+    void * node = tree._root;
+    for (unsigned level = 0; level < tree._height; ++level)
+    {
+        TInner * inner = static_cast<TInner *>(node);
+        unsigned i = 0;
+        while (i + 1 < inner->count && (TPos_)pos >= acc + inner->lengths[i])
+            acc += inner->lengths[i++];
+        path.nodes[level] = inner;
+        path.childPos[level] = i;
+        node = inner->children[i];
+    }
+
+    TLeaf * leaf = static_cast<TLeaf *>(node);
+    unsigned i = 0;
+    while (i + 1 < leaf->count && (TPos_)pos >= acc + leaf->entries[i].length)
+        acc += leaf->entries[i++].length;
+    path.leaf = leaf;
+    path.index = i;
+    path.entryBegin = acc;
+}
+
+// Changes the length of the entry the path points to.
+template <typename TCargo, typename TSize>
+inline void
+_setLengthJournalEntriesBPlusTree(JournalEntries<TCargo, BPlusTree> & tree,
+                                  JournalEntriesBPlusTreePath_<JournalEntries<TCargo, BPlusTree> > & path,
+                                  TSize newLength)
+{
+    TCargo & entry = path.leaf->entries[path.index];
+    for (unsigned level = 0; level < tree._height; ++level)
+    {
+        path.nodes[level]->lengths[path.childPos[level]] -= entry.length;
+        path.nodes[level]->lengths[path.childPos[level]] += newLength;
+    }
+    path.leaf->length -= entry.length;
+    path.leaf->length += newLength;
+    tree._length -= entry.length;
+    tree._length += newLength;
+    entry.length = newLength;
+}
+
+template <typename TSize>
+inline TSize
+_sumJournalEntriesBPlusTreeInner(JournalEntriesBPlusTreeInner_<TSize> const & inner)
+{
+    TSize sum = 0;
+    for (unsigned i = 0; i < inner.count; ++i)
+        sum += inner.lengths[i];
+    return sum;
+}
+
+// Inserts a child right of path.childPos[level] into path.nodes[level], splits
+// the node if it is full.  The length of the left neighbour must be up to date.
+template <typename TCargo, typename TSize>
+inline void
+_insertChildJournalEntriesBPlusTree(JournalEntries<TCargo, BPlusTree> & tree,
+                                    JournalEntriesBPlusTreePath_<JournalEntries<TCargo, BPlusTree> > & path,
+                                    int level,
+                                    void * child,
+                                    TSize childLength)
+{
+    typedef JournalEntries<TCargo, BPlusTree> TJournalEntries;
+    typedef typename TJournalEntries::TInner TInner;
+
+    if (level < 0)
+    {
+        // The root was split, add a new root.
+        TInner * root = new TInner;
+        root->count = 2;
+        root->children[0] = tree._root;
+        root->lengths[0] = tree._length - childLength;
+        root->children[1] = child;
+        root->lengths[1] = childLength;
+        tree._root = root;
+        ++tree._height;
+        SEQAN_ASSERT_LT(tree._height, (unsigned)TJournalEntries::MAX_HEIGHT);
+        return;
+    }
+
+    TInner * inner = path.nodes[level];
+    unsigned pos = path.childPos[level] + 1;
+
+    TInner * right = 0;
+    if (inner->count == (unsigned)TInner::CAPACITY)
+    {
+        // Split the node in halves.
+        unsigned half = TInner::CAPACITY / 2;
+        right = new TInner;
+        right->count = inner->count - half;
+        for (unsigned i = 0; i < right->count; ++i)
+        {
+            right->children[i] = inner->children[half + i];
+            right->lengths[i] = inner->lengths[half + i];
+        }
+        inner->count = half;
+        if (pos > half)
+        {
+            inner = right;
+            pos -= half;
+        }
+    }
+
+    for (unsigned i = inner->count; i > pos; --i)
+    {
+        inner->children[i] = inner->children[i - 1];
+        inner->lengths[i] = inner->lengths[i - 1];
+    }
+    inner->children[pos] = child;
+    inner->lengths[pos] = childLength;
+    ++inner->count;
+
+    if (right != 0)
+    {
+        TSize rightLength = _sumJournalEntriesBPlusTreeInner(*right);
+        if (level > 0)
+            path.nodes[level - 1]->lengths[path.childPos[level - 1]] =
+                    _sumJournalEntriesBPlusTreeInner(*path.nodes[level]);
+        _insertChildJournalEntriesBPlusTree(tree, path, level - 1, right, rightLength);
+    }
+}
+
+// Splits the leaf the path points to.  If the entry would be appended to the
+// last leaf, an empty leaf is appended instead.
+template <typename TCargo>
+inline void
+_splitLeafJournalEntriesBPlusTree(JournalEntries<TCargo, BPlusTree> & tree,
+                                  JournalEntriesBPlusTreePath_<JournalEntries<TCargo, BPlusTree> > & path,
+                                  bool append)
+{
+    typedef JournalEntries<TCargo, BPlusTree> TJournalEntries;
+    typedef typename TJournalEntries::TLeaf TLeaf;
+    typedef typename TJournalEntries::TSize TSize;
+
+    TLeaf * leaf = path.leaf;
+    TLeaf * right = new TLeaf;
+    unsigned half = (append)? leaf->count: TLeaf::CAPACITY / 2;
+    right->count = leaf->count - half;
+    for (unsigned i = 0; i < right->count; ++i)
+    {
+        right->entries[i] = leaf->entries[half + i];
+        right->length += right->entries[i].length;
+    }
+    leaf->count = half;
+    leaf->length -= right->length;
+
+    right->prev = leaf;
+    right->next = leaf->next;
+    if (leaf->next != 0)
+        leaf->next->prev = right;
+    else
+        tree._lastLeaf = right;
+    leaf->next = right;
+
+    TSize rightLength = right->length;
+    if (tree._height > 0)
+        path.nodes[tree._height - 1]->lengths[path.childPos[tree._height - 1]] = leaf->length;
+    _insertChildJournalEntriesBPlusTree(tree, path, (int)tree._height - 1, right, rightLength);
+}
+
+// Inserts an entry such that it starts at virtual position pos, which must be
+// the begin of an entry or the end.
+template <typename TCargo, typename TPos>
+inline void
+_insertJournalEntriesBPlusTree(JournalEntries<TCargo, BPlusTree> & tree,
+                               TPos pos,
+                               TCargo const & entry)
+{
+    typedef JournalEntries<TCargo, BPlusTree> TJournalEntries;
+    typedef typename TJournalEntries::TLeaf TLeaf;
+    typedef JournalEntriesBPlusTreePath_<TJournalEntries> TPath;
+
+    if (tree._root == 0)
+    {
+        TLeaf * leaf = new TLeaf;
+        tree._root = tree._firstLeaf = tree._lastLeaf = leaf;
+    }
+
+    TPath path;
+    while (true)
+    {
+        unsigned index;
+        if (tree._entryCount == 0)
+        {
+            path.leaf = static_cast<TLeaf *>(tree._root);
+            index = 0;
+        }
+        else
+        {
+            _findJournalEntriesBPlusTree(path, tree, pos);
+            index = path.index;
+            if ((typename TJournalEntries::TPos)pos >= tree._length && path.leaf == tree._lastLeaf)
+                index = path.leaf->count;
+            else
+                SEQAN_ASSERT_EQ((typename TJournalEntries::TPos)pos, path.entryBegin);
+        }
+
+        TLeaf * leaf = path.leaf;
+        if (leaf->count == (unsigned)TLeaf::CAPACITY)
+        {
+            _splitLeafJournalEntriesBPlusTree(tree, path, index == leaf->count);
+            continue;
+        }
+
+        for (unsigned i = leaf->count; i > index; --i)
+            leaf->entries[i] = leaf->entries[i - 1];
+        leaf->entries[index] = entry;
+        leaf->entries[index].virtualPosition = 0;
+        ++leaf->count;
+        leaf->length += entry.length;
+        for (unsigned level = 0; level < tree._height; ++level)
+            path.nodes[level]->lengths[path.childPos[level]] += entry.length;
+        tree._length += entry.length;
+        ++tree._entryCount;
+        return;
+    }
+}
+
+// Removes the entry the path points to.
+template <typename TCargo>
+inline void
+_removeJournalEntriesBPlusTree(JournalEntries<TCargo, BPlusTree> & tree,
+                               JournalEntriesBPlusTreePath_<JournalEntries<TCargo, BPlusTree> > & path)
+{
+    typedef JournalEntries<TCargo, BPlusTree> TJournalEntries;
+    typedef typename TJournalEntries::TLeaf TLeaf;
+    typedef typename TJournalEntries::TInner TInner;
+
+    _setLengthJournalEntriesBPlusTree(tree, path, 0u);
+
+    TLeaf * leaf = path.leaf;
+    for (unsigned i = path.index + 1; i < leaf->count; ++i)
+        leaf->entries[i - 1] = leaf->entries[i];
+    --leaf->count;
+    --tree._entryCount;
+    if (leaf->count != 0)
+        return;
+
+    // Remove the empty leaf and empty inner nodes above it.
+    if (leaf->prev != 0)
+        leaf->prev->next = leaf->next;
+    else
+        tree._firstLeaf = leaf->next;
+    if (leaf->next != 0)
+        leaf->next->prev = leaf->prev;
+    else
+        tree._lastLeaf = leaf->prev;
+    delete leaf;
+
+    int level = (int)tree._height - 1;
+    for (; level >= 0; --level)
+    {
+        TInner * inner = path.nodes[level];
+        for (unsigned i = path.childPos[level] + 1; i < inner->count; ++i)
+        {
+            inner->children[i - 1] = inner->children[i];
+            inner->lengths[i - 1] = inner->lengths[i];
+        }
+        if (--inner->count != 0)
+            break;
+        delete inner;
+    }
+    if (level < 0)
+    {
+        tree._root = 0;
+        tree._height = 0;
+        return;
+    }
+
+    // Shrink the tree if the root has a single child.
+    while (tree._height > 0 && static_cast<TInner *>(tree._root)->count == 1)
+    {
+        TInner * root = static_cast<TInner *>(tree._root);
+        tree._root = root->children[0];
+        --tree._height;
+        delete root;
+    }
+}
+
+template <typename TCargo>
+inline void
+_copyJournalEntriesBPlusTree(JournalEntries<TCargo, BPlusTree> & target,
+                             JournalEntries<TCargo, BPlusTree> const & source)
+{
+    typedef JournalEntries<TCargo, BPlusTree> TJournalEntries;
+    typedef typename TJournalEntries::TLeaf TLeaf;
+
+    _clearJournalEntriesBPlusTree(target);
+    for (TLeaf const * leaf = source._firstLeaf; leaf != 0; leaf = leaf->next)
+        for (unsigned i = 0; i < leaf->count; ++i)
+            _insertJournalEntriesBPlusTree(target, target._length, leaf->entries[i]);
+    target._originalStringLength = source._originalStringLength;
+}
+
+// ----------------------------------------------------------------------------
+// Helper functions for the entries
+// ----------------------------------------------------------------------------
+
+template <typename TCargo>
+bool _checkJournalEntriesBPlusTree(JournalEntries<TCargo, BPlusTree> const & tree)
+{
+    typedef JournalEntries<TCargo, BPlusTree> TJournalEntries;
+    typedef typename TJournalEntries::TLeaf TLeaf;
+    typedef typename TJournalEntries::TSize TSize;
+
+    TSize count = 0;
+    TSize totalLength = 0;
+    TLeaf const * prev = 0;
+    for (TLeaf const * leaf = tree._firstLeaf; leaf != 0; prev = leaf, leaf = leaf->next)
+    {
+        if (leaf->prev != prev || leaf->count == 0)
+            return false;
+        TSize leafLength = 0;
+        for (unsigned i = 0; i < leaf->count; ++i)
+        {
+            TCargo const & entry = leaf->entries[i];
+            if (entry.segmentSource == SOURCE_ORIGINAL)
+            {
+                if (entry.physicalPosition != entry.physicalOriginPosition)
+                    return false;
+            }
+            else if (count == 0)
+            {
+                if (entry.physicalOriginPosition != 0)
+                    return false;
+            }
+            else
+            {
+                TCargo const & left = (i > 0)? leaf->entries[i - 1]: prev->entries[prev->count - 1];
+                if (left.physicalOriginPosition != entry.physicalOriginPosition)
+                    return false;
+            }
+            leafLength += entry.length;
+            ++count;
+        }
+        if (leafLength != leaf->length)
+            return false;
+        totalLength += leafLength;
+    }
+    return prev == tree._lastLeaf && count == tree._entryCount && totalLength == tree._length;
+}
+
+// Sets the origin positions of the patch entries following the entry that
+// contains virtual position beginPos to the origin position of the entry left
+// of them.  The first original entry not left of endPos may have been changed
+// as well, so we stop at the next original entry.
+template <typename TCargo, typename TPos>
+inline void
+_updateOriginJournalEntriesBPlusTree(JournalEntries<TCargo, BPlusTree> & tree,
+                                     TPos beginPos,
+                                     TPos endPos)
+{
+    typedef JournalEntries<TCargo, BPlusTree> TJournalEntries;
+    typedef typename Iterator<TJournalEntries, Standard>::Type TIterator;
+    typedef typename TJournalEntries::TPos TPos_;
+
+    if (tree._entryCount == 0)
+        return;
+
+    TIterator it = findInJournalEntries(tree, beginPos);
+    TCargo * entry = &it._leaf->entries[it._index];
+    if (it._leaf == tree._firstLeaf && it._index == 0 && entry->segmentSource == SOURCE_PATCH)
+        entry->physicalOriginPosition = 0;
+    TPos_ origin = entry->physicalOriginPosition;
+    bool passedEnd = false;
+    for (++it; !atEnd(it); ++it)
+    {
+        entry = &it._leaf->entries[it._index];
+        if (entry->segmentSource == SOURCE_ORIGINAL)
+        {
+            if (it._virtualPosition >= (TPos_)endPos)
+            {
+                if (passedEnd)
+                    break;
+                passedEnd = true;
+            }
+        }
+        else
+        {
+            entry->physicalOriginPosition = origin;
+        }
+        origin = entry->physicalOriginPosition;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function operator<<()
+// ----------------------------------------------------------------------------
+
+template <typename TStream, typename TCargo>
+inline
+TStream &
+operator<<(TStream & stream, JournalEntries<TCargo, BPlusTree> const & tree)
+{
+    typedef typename Iterator<JournalEntries<TCargo, BPlusTree> const, Standard>::Type TIterator;
+
+    stream << "JournalEntries(";
+    for (TIterator it = begin(tree, Standard()); !atEnd(it); ++it)
+    {
+        if (it != begin(tree, Standard())) stream << ", ";
+        stream << value(it);
+    }
+    stream << ")";
+    return stream;
+}
+
+// ----------------------------------------------------------------------------
+// Function begin()
+// ----------------------------------------------------------------------------
+
+template <typename TCargo>
+inline
+typename Iterator<JournalEntries<TCargo, BPlusTree>, Standard>::Type
+begin(JournalEntries<TCargo, BPlusTree> & journalTree, Standard const &)
+{
+    typename Iterator<JournalEntries<TCargo, BPlusTree>, Standard>::Type result;
+    result._leaf = journalTree._firstLeaf;
+    return result;
+}
+
+template <typename TCargo>
+inline
+typename Iterator<JournalEntries<TCargo, BPlusTree> const, Standard>::Type
+begin(JournalEntries<TCargo, BPlusTree> const & journalTree, Standard const &)
+{
+    typename Iterator<JournalEntries<TCargo, BPlusTree> const, Standard>::Type result;
+    result._leaf = journalTree._firstLeaf;
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+// Function end()
+// ----------------------------------------------------------------------------
+
+template <typename TCargo>
+inline
+typename Iterator<JournalEntries<TCargo, BPlusTree>, Standard>::Type
+end(JournalEntries<TCargo, BPlusTree> & journalTree, Standard const &)
+{
+    typename Iterator<JournalEntries<TCargo, BPlusTree>, Standard>::Type result;
+    result._leaf = journalTree._lastLeaf;
+    result._index = (journalTree._lastLeaf != 0)? journalTree._lastLeaf->count: 0;
+    result._virtualPosition = journalTree._length;
+    return result;
+}
+
+template <typename TCargo>
+inline
+typename Iterator<JournalEntries<TCargo, BPlusTree> const, Standard>::Type
+end(JournalEntries<TCargo, BPlusTree> const & journalTree, Standard const &)
+{
+    typename Iterator<JournalEntries<TCargo, BPlusTree> const, Standard>::Type result;
+    result._leaf = journalTree._lastLeaf;
+    result._index = (journalTree._lastLeaf != 0)? journalTree._lastLeaf->count: 0;
+    result._virtualPosition = journalTree._length;
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+// Function length()
+// ----------------------------------------------------------------------------
+
+template <typename TCargo>
+inline typename Size<TCargo>::Type
+length(JournalEntries<TCargo, BPlusTree> const & journalTree)
+{
+    return journalTree._entryCount;
+}
+
+// ----------------------------------------------------------------------------
+// Function reinit()
+// ----------------------------------------------------------------------------
+
+template <typename TCargo>
+inline
+void reinit(JournalEntries<TCargo, BPlusTree> & tree,
+            typename Size<TCargo>::Type originalStringLength)
+{
+    _clearJournalEntriesBPlusTree(tree);
+    _insertJournalEntriesBPlusTree(tree, 0u, TCargo(SOURCE_ORIGINAL, 0, 0, 0, originalStringLength));
+    tree._originalStringLength = originalStringLength;
+}
+
+// ----------------------------------------------------------------------------
+// Function findInJournalEntries()
+// ----------------------------------------------------------------------------
+
+template <typename TCargo, typename TPos>
+inline
+typename Iterator<JournalEntries<TCargo, BPlusTree> const, Standard>::Type
+findInJournalEntries(JournalEntries<TCargo, BPlusTree> const & journalEntries,
+                     TPos pos)
+{
+    JournalEntriesBPlusTreePath_<JournalEntries<TCargo, BPlusTree> > path;
+    _findJournalEntriesBPlusTree(path, journalEntries, pos);
+
+    typename Iterator<JournalEntries<TCargo, BPlusTree> const, Standard>::Type result;
+    result._leaf = path.leaf;
+    result._index = path.index;
+    result._virtualPosition = path.entryBegin;
+    return result;
+}
+
+template <typename TCargo, typename TPos>
+inline
+typename Iterator<JournalEntries<TCargo, BPlusTree>, Standard>::Type
+findInJournalEntries(JournalEntries<TCargo, BPlusTree> & journalEntries,
+                     TPos pos)
+{
+    JournalEntriesBPlusTreePath_<JournalEntries<TCargo, BPlusTree> > path;
+    _findJournalEntriesBPlusTree(path, journalEntries, pos);
+
+    typename Iterator<JournalEntries<TCargo, BPlusTree>, Standard>::Type result;
+    result._leaf = path.leaf;
+    result._index = path.index;
+    result._virtualPosition = path.entryBegin;
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+// Function findJournalEntry()
+// ----------------------------------------------------------------------------
+
+template <typename TCargo, typename TPos>
+inline
+TCargo
+findJournalEntry(JournalEntries<TCargo, BPlusTree> const & journalEntries,
+                 TPos pos)
+{
+    return value(findInJournalEntries(journalEntries, pos));
+}
+
+// ----------------------------------------------------------------------------
+// Function recordInsertion()
+// ----------------------------------------------------------------------------
+
+template <typename TCargo>
+inline
+void recordInsertion(JournalEntries<TCargo, BPlusTree> & tree,
+                     typename Position<TCargo>::Type virtualPosition,
+                     typename Position<TCargo>::Type physicalBeginPos,
+                     typename Size<TCargo>::Type len)
+{
+    typedef JournalEntries<TCargo, BPlusTree> TJournalEntries;
+    typedef typename Position<TCargo>::Type TPos;
+
+    if (tree._entryCount == 0)
+    {
+        SEQAN_ASSERT_EQ(virtualPosition, 0u);
+        if (len == 0)
+            return;
+        _insertJournalEntriesBPlusTree(tree, 0u, TCargo(SOURCE_PATCH, physicalBeginPos, 0, 0, len));
+        return;
+    }
+
+    JournalEntriesBPlusTreePath_<TJournalEntries> path;
+    _findJournalEntriesBPlusTree(path, tree, virtualPosition);
+    TCargo entry = path.leaf->entries[path.index];
+
+    if (path.entryBegin + entry.length > virtualPosition && path.entryBegin != virtualPosition)
+    {
+        // Split the entry and insert the patch in between.
+        TPos offset = virtualPosition - path.entryBegin;
+        _setLengthJournalEntriesBPlusTree(tree, path, offset);
+        TPos origin = entry.physicalOriginPosition;
+        if (entry.segmentSource == SOURCE_ORIGINAL)
+            origin += offset;
+        _insertJournalEntriesBPlusTree(tree, virtualPosition,
+                                       TCargo(entry.segmentSource, entry.physicalPosition + offset, 0, origin,
+                                              entry.length - offset));
+    }
+    // Otherwise, the patch starts at the begin of the entry or at the end.
+    _insertJournalEntriesBPlusTree(tree, virtualPosition, TCargo(SOURCE_PATCH, physicalBeginPos, 0, 0, len));
+    _updateOriginJournalEntriesBPlusTree(tree, (virtualPosition > 0u)? virtualPosition - 1: 0u,
+                                         virtualPosition + len);
+
+    SEQAN_ASSERT(_checkJournalEntriesBPlusTree(tree));
+}
+
+// ----------------------------------------------------------------------------
+// Function recordErase()
+// ----------------------------------------------------------------------------
+
+template <typename TCargo>
+inline
+void recordErase(JournalEntries<TCargo, BPlusTree> & tree,
+                 typename Position<TCargo>::Type pos,
+                 typename Position<TCargo>::Type posEnd)
+{
+    typedef JournalEntries<TCargo, BPlusTree> TJournalEntries;
+    typedef typename Position<TCargo>::Type TPos;
+    typedef typename Size<TCargo>::Type TSize;
+
+    if (tree._entryCount == 0)
+    {
+        SEQAN_ASSERT_EQ(pos, 0u);
+        SEQAN_ASSERT_EQ(posEnd, 0u);
+        return;
+    }
+    if (tree._entryCount == 1 && pos == 0 && posEnd == tree._length)
+    {
+        // Erasing all of the single entry clears the tree.
+        TSize originalStringLength = tree._originalStringLength;
+        _clearJournalEntriesBPlusTree(tree);
+        tree._originalStringLength = originalStringLength;
+        return;
+    }
+    SEQAN_ASSERT_LEQ(posEnd, tree._length);
+
+    // Cut [pos, posEnd) piece by piece out of the entries overlapping it.
+    JournalEntriesBPlusTreePath_<TJournalEntries> path;
+    while (pos < posEnd)
+    {
+        _findJournalEntriesBPlusTree(path, tree, pos);
+        TCargo & entry = path.leaf->entries[path.index];
+        TPos entryEnd = path.entryBegin + entry.length;
+        TPos cutEnd = _min(entryEnd, posEnd);
+        TSize cut = cutEnd - pos;
+
+        if (pos == path.entryBegin && cutEnd == entryEnd)
+        {
+            _removeJournalEntriesBPlusTree(tree, path);
+        }
+        else if (pos == path.entryBegin)
+        {
+            // Remove a prefix.
+            entry.physicalPosition += cut;
+            if (entry.segmentSource == SOURCE_ORIGINAL)
+                entry.physicalOriginPosition += cut;
+            _setLengthJournalEntriesBPlusTree(tree, path, entry.length - cut);
+        }
+        else if (cutEnd == entryEnd)
+        {
+            // Remove a suffix.
+            _setLengthJournalEntriesBPlusTree(tree, path, entry.length - cut);
+        }
+        else
+        {
+            // Remove an infix, i.e. split the entry.
+            TPos offset = pos - path.entryBegin;
+            TCargo right(entry.segmentSource, entry.physicalPosition + offset + cut, 0,
+                         entry.physicalOriginPosition, entry.length - offset - cut);
+            if (entry.segmentSource == SOURCE_ORIGINAL)
+                right.physicalOriginPosition = right.physicalPosition;
+            _setLengthJournalEntriesBPlusTree(tree, path, offset);
+            _insertJournalEntriesBPlusTree(tree, pos, right);
+        }
+        posEnd -= cut;
+    }
+    _updateOriginJournalEntriesBPlusTree(tree, (pos > 0u)? pos - 1: 0u, pos);
+
+    SEQAN_ASSERT(_checkJournalEntriesBPlusTree(tree));
+}
+
+// ----------------------------------------------------------------------------
+// Function hostToVirtualPosition()
+// ----------------------------------------------------------------------------
+
+// Same as for the sorted array, but the upper bound of the host position among
+// the origin positions is found by descending the tree.  The origin positions
+// are non-decreasing, so at each inner node we go to the last child whose first
+// entry has an origin position not right of the host position.
+template <typename TCargo, typename TPos>
+inline
+typename Position<TCargo>::Type
+hostToVirtualPosition(JournalEntries<TCargo, BPlusTree> const & journalEntries, TPos const & hostPos)
+{
+    typedef JournalEntries<TCargo, BPlusTree> const TJournalEntries;
+    typedef typename TJournalEntries::TLeaf TLeaf;
+    typedef typename TJournalEntries::TInner TInner;
+    typedef typename Iterator<TJournalEntries, Standard>::Type TIterator;
+    typedef typename Position<TCargo>::Type TCargoPos;
+
+    if (journalEntries._entryCount == 0)
+        return 0;
+
+    TCargoPos result = journalEntries._originalStringLength;
+
+    // Find the first entry with an origin position greater than hostPos.
+    TIterator it;
+    it._virtualPosition = 0;
+    void * node = journalEntries._root;
+    for (unsigned level = journalEntries._height; level > 0; --level)
+    {
+        TInner * inner = static_cast<TInner *>(node);
+        unsigned i = inner->count - 1;
+        for (; i > 0; --i)
+        {
+            void * first = inner->children[i];
+            for (unsigned l = level - 1; l > 0; --l)
+                first = static_cast<TInner *>(first)->children[0];
+            if (static_cast<TLeaf *>(first)->entries[0].physicalOriginPosition <= (TCargoPos)hostPos)
+                break;
+        }
+        for (unsigned j = 0; j < i; ++j)
+            it._virtualPosition += inner->lengths[j];
+        node = inner->children[i];
+    }
+    it._leaf = static_cast<TLeaf *>(node);
+    it._index = 0;
+    while (it._index < it._leaf->count && it._leaf->entries[it._index].physicalOriginPosition <= (TCargoPos)hostPos)
+        it._virtualPosition += it._leaf->entries[it._index++].length;
+    if (it._index == it._leaf->count && it._leaf->next != 0)
+    {
+        it._leaf = it._leaf->next;
+        it._index = 0;
+    }
+
+    // If we end up at a patch entry then there are no more original entries left.
+    if (!atEnd(it) && value(it).segmentSource == SOURCE_PATCH)
+        return result;
+
+    if (!atEnd(it))
+        result = it._virtualPosition;
+
+    if (it == begin(journalEntries, Standard()))
+        return result;
+
+    // Go to the next original entry left of the current position.
+    --it;
+    while (it != begin(journalEntries, Standard()) && value(it).segmentSource == SOURCE_PATCH)
+        --it;
+    if (value(it).segmentSource == SOURCE_PATCH)
+        return result;
+    if ((TCargoPos)hostPos >= (TCargoPos)(value(it).physicalPosition + value(it).length))
+        return result;
+
+    return it._virtualPosition + (hostPos - value(it).physicalPosition);
+}
+
+// ----------------------------------------------------------------------------
+// Function clear()
+// ----------------------------------------------------------------------------
+
+template <typename TCargo>
+inline void
+clear(JournalEntries<TCargo, BPlusTree> & journalEntries)
+{
+    _clearJournalEntriesBPlusTree(journalEntries);
+    journalEntries._originalStringLength = 0u;
+}
+
+// ----------------------------------------------------------------------------
+// Iterator functions
+// ----------------------------------------------------------------------------
+
+template <typename TJournalEntries>
+inline
+typename Value<Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> > >::Type
+value(Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> > const & iterator)
+{
+    iterator._entry = iterator._leaf->entries[iterator._index];
+    iterator._entry.virtualPosition = iterator._virtualPosition;
+    return iterator._entry;
+}
+
+template <typename TJournalEntries>
+inline
+typename Value<Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> > >::Type
+value(Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> > & iterator)
+{
+    return value(const_cast<Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> > const &>(iterator));
+}
+
+template <typename TJournalEntries>
+inline
+typename Value<Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> > >::Type
+operator*(Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> > const & iterator)
+{
+    return value(iterator);
+}
+
+template <typename TJournalEntries>
+inline
+typename Value<Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> > >::Type
+operator*(Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> > & iterator)
+{
+    return value(iterator);
+}
+
+template <typename TJournalEntries>
+inline
+bool
+atEnd(Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> > const & iterator)
+{
+    return iterator._leaf == 0 || iterator._index == iterator._leaf->count;
+}
+
+template <typename TJournalEntries>
+inline
+bool
+atEnd(Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> > & iterator)
+{
+    return iterator._leaf == 0 || iterator._index == iterator._leaf->count;
+}
+
+template <typename TJournalEntries>
+inline
+Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> > &
+operator++(Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> > & iterator)
+{
+    SEQAN_ASSERT_NOT(atEnd(iterator));
+    iterator._virtualPosition += iterator._leaf->entries[iterator._index].length;
+    if (++iterator._index == iterator._leaf->count && iterator._leaf->next != 0)
+    {
+        iterator._leaf = iterator._leaf->next;
+        iterator._index = 0;
+    }
+    return iterator;
+}
+
+template <typename TJournalEntries>
+inline
+Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> >
+operator++(Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> > & iterator,
+           int /*postfix*/)
+{
+    Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> > temp(iterator);
+    ++iterator;
+    return temp;
+}
+
+template <typename TJournalEntries>
+inline
+Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> > &
+operator--(Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> > & iterator)
+{
+    if (iterator._index == 0)
+    {
+        SEQAN_ASSERT(iterator._leaf->prev != 0);
+        iterator._leaf = iterator._leaf->prev;
+        iterator._index = iterator._leaf->count;
+    }
+    --iterator._index;
+    iterator._virtualPosition -= iterator._leaf->entries[iterator._index].length;
+    return iterator;
+}
+
+template <typename TJournalEntries>
+inline
+Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> >
+operator--(Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> > & iterator,
+           int /*postfix*/)
+{
+    Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> > temp(iterator);
+    --iterator;
+    return temp;
+}
+
+template <typename TJournalEntries>
+inline
+bool
+operator==(Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> > const & a,
+           Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> > const & b)
+{
+    return a._leaf == b._leaf && a._index == b._index;
+}
+
+template <typename TJournalEntries>
+inline
+bool
+operator==(Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> > const & a,
+           typename IterComplementConst<Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> > >::Type const & b)
+{
+    return a._leaf == b._leaf && a._index == b._index;
+}
+
+template <typename TJournalEntries>
+inline
+bool
+operator!=(Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> > const & a,
+           Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> > const & b)
+{
+    return a._leaf != b._leaf || a._index != b._index;
+}
+
+template <typename TJournalEntries>
+inline
+bool
+operator!=(Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> > const & a,
+           typename IterComplementConst<Iter<TJournalEntries, JournalEntriesIterSpec<BPlusTree> > >::Type const & b)
+{
+    return a._leaf != b._leaf || a._index != b._index;
+}
+
+
+}  // namespace seqan
+
+#endif  // SEQAN_SEQUENCE_JOURNALED_JOURNAL_ENTRIES_BPLUS_TREE_H_
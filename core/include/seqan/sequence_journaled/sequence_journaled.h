@@ -64,6 +64,7 @@ namespace seqan {
  *
  * @tparam THostSpec    Specialization type for the host string.
  * @tparam TJournalSpec Specialization type for the journal.  Default: <tt>SortedArray</tt>.
+ *                      Use <tt>BPlusTree</tt> for strings with many changes at arbitrary positions.
  * @tparam TBufferSpec  Specialization type for the buffer string.  Default: <tt>Alloc&lt;&gt;</tt>.
  */
 
@@ -73,6 +74,9 @@ namespace seqan {
 ..general:Class.String
 ..summary:Journaled versions of arbitrary underlying string.
 ..signature:String<TValue, Journaled<THostSpec, TJournalSpec, TBufferSpec> >
+..param.TJournalSpec:Specialization type for the journal.
+...default:$SortedArray$
+...remarks:Use $BPlusTree$ for strings with many changes at arbitrary positions.
 ..include:seqan/sequence_journaled.h
  */
 
@@ -518,6 +522,64 @@ set(String<TValue, Journaled<THostSpec, TJournalSpec, TBufferSpec> > & target,
     assign(target, source);
 }
 
+// ----------------------------------------------------------------------------
+// Function snapshot
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn JournaledString#snapshot
+ * @brief Create a snapshot of a JournaledString that shares its host.
+ *
+ * @signature void snapshot(target, source);
+ *
+ * @param[out] target The JournaledString to become the snapshot.
+ * @param[in]  source The JournaledString to take the snapshot of.
+ *
+ * Unlike set(), the host is not copied but shared with <tt>source</tt>.  Only the journal and the insertion
+ * buffer are copied, i.e. the cost depends on the number of changes and not on the length of the host.
+ *
+ * The journal operations never modify the host, so a snapshot can be read and iterated from other threads while
+ * <tt>source</tt> is modified further, e.g. while new variants are applied to it.  The host must outlive the
+ * snapshot and must not be changed (e.g. by flatten() or by modifying it directly) while the snapshot is in use.
+ */
+
+/**
+.Function.snapshot:
+..class:Spec.Journaled String
+..cat:Sequences
+..summary:Create a snapshot of a journaled string that shares its host.
+..signature:snapshot(target, source)
+..param.target:The journaled string to become the snapshot.
+...type:Spec.Journaled String
+..param.source:The journaled string to take the snapshot of.
+...type:Spec.Journaled String
+..remarks:Unlike @Function.set@, the host is not copied but shared with $source$.
+Only the journal and the insertion buffer are copied, i.e. the cost depends on the number of changes and not on the length of the host.
+..remarks:The journal operations never modify the host, so a snapshot can be read and iterated from other threads
+while $source$ is modified further, e.g. while new variants are applied to it.
+The host must outlive the snapshot and must not be changed (e.g. by @Function.flatten@ or by modifying it directly)
+while the snapshot is in use.
+..include:seqan/sequence_journaled.h
+ */
+template <typename TValue, typename THostSpec, typename TJournalSpec, typename TBufferSpec>
+inline void
+snapshot(String<TValue, Journaled<THostSpec, TJournalSpec, TBufferSpec> > & target,
+         String<TValue, Journaled<THostSpec, TJournalSpec, TBufferSpec> > const & source)
+{
+    typedef String<TValue, Journaled<THostSpec, TJournalSpec, TBufferSpec> > TJournaledString;
+    typedef typename Host<TJournaledString>::Type THost;
+
+    if (&target == &source)
+        return;
+    if (empty(source._holder))
+        clear(target._holder);
+    else
+        setValue(target._holder, const_cast<THost &>(value(source._holder)));
+    assign(target._insertionBuffer, source._insertionBuffer);
+    assign(target._journalEntries, source._journalEntries);
+    target._length = source._length;
+}
+
 // ----------------------------------------------------------------------------
 // Function setHost
 // ----------------------------------------------------------------------------
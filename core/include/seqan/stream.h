@@ -85,6 +85,7 @@
 #include <seqan/basic.h>
 #include <seqan/file.h>
 #include <seqan/sequence.h>
+#include <seqan/parallel.h>
 
 // ===========================================================================
 // Stream Concept, Adaptions, Stream Class and Specializations.
@@ -131,6 +132,7 @@
 // ===========================================================================
 
 #include <seqan/stream/is.h> // currently empty
+#include <seqan/stream/tokenize_simd.h>
 #include <seqan/stream/tokenize.h>
 #include <seqan/stream/lexical_cast.h>
 
@@ -91,6 +91,31 @@ struct BgzfCacheEntry_
     int size;
     String<char> block;
     __int64 endOffset;
+    // Value of the stream's cache clock when the block was used last.
+    __int64 lastUse;
+};
+
+// One entry of the batch of blocks that is decompressed ahead of the reader or
+// waits for being compressed by the writer.  All entries of a batch are
+// (de)compressed in parallel.
+
+struct BgzfBatchEntry_
+{
+    // Buffer for compressed data, including header and footer.
+    String<char> compressedBlock;
+    // Buffer for uncompressed data.
+    String<char> uncompressedBlock;
+    // The address of the block in the file.
+    __int64 blockPosition;
+    // Length of the compressed block, the address of the next block is blockPosition + compressedLength.
+    int compressedLength;
+    // Length of the uncompressed data, -1 on error.
+    int uncompressedLength;
+    // Number of uncompressed bytes that made it into the compressed block when writing.
+    int consumedLength;
+
+    BgzfBatchEntry_() : blockPosition(0), compressedLength(0), uncompressedLength(0), consumedLength(0)
+    {}
 };
 
 /*!
@@ -129,6 +154,13 @@ struct BgzfCacheEntry_
 BGZF is the Block GZip Format which is used as the underlying format for BAM and TABIX.
 Data is written out compressed with gzip but the uncompressed data is split into blocks with a maximum block size.
 It is therefore possible to jump to beginnings of blocks in the resulting files, decompress the block and then jump into the block itself.
+..remarks:
+Since the blocks are independent of each other, they can be compressed and decompressed in parallel.
+By default, the stream uses as many threads as OpenMP provides ($omp_get_max_threads()$).
+When reading sequentially, a batch of blocks is decompressed ahead of the current one; after seeking, single blocks are read until sequential access is detected again.
+When writing, full blocks are collected and compressed as a batch.
+The order of the data is preserved in both cases.
+Use @Function.setNumThreads@ to change the number of threads.
 ..include:seqan/stream.h
 ..example.code:
 Stream<Bgzf> stream;
@@ -186,6 +218,12 @@ public:
     // Maximum cache size, as number of bytes in cached blocks.
     int _maxCacheSize;
 
+    // Incremented on each cache access, used for evicting the least recently used block.
+    __int64 _cacheClock;
+
+    // Addresses of the cached blocks, ordered by their last use.
+    std::map<__int64, __int64> _cacheLru;
+
     // Whether or not the file is owned (i.e. opened with open()) or just attached to an already open file via POSIX
     // file handle.
     bool _fileOwned;
@@ -193,8 +231,34 @@ public:
     // Size of the file in bytes as it is on the disk.
     __int64 _fileSize;
 
+    // Number of threads used for compressing and decompressing blocks, 1 for sequential operation.
+    unsigned _numThreads;
+
+    // Blocks decompressed ahead of the current one (reading) or waiting for compression (writing).
+    String<BgzfBatchEntry_> _batch;
+
+    // Number of used entries in _batch.
+    unsigned _batchSize;
+
+    // Address of the block following the one read last, and the number of blocks read in order up to it (reading).
+    // Blocks are only read ahead into _batch after READ_AHEAD_AFTER blocks were read in order.
+    static const unsigned READ_AHEAD_AFTER = 2;
+    __int64 _nextBlockAddress;
+    unsigned _sequentialBlocks;
+
+    // Number of uncompressed bytes in the blocks written to the file so far (writing).
+    __uint64 _uncompressedWritten;
+
+    // Positions returned by bgzfTellUncompressed() whose blocks have not been written yet, and pairs of (position,
+    // virtual offset) of those whose blocks have been written (writing).  Only these positions are recorded, such that
+    // the memory does not grow with the number of written blocks, see bgzfVirtualOffset().
+    String<__uint64> _pendingTells;
+    String<Pair<__uint64, __uint64> > _writtenTells;
+
     Stream() : _error(0), _atEof(false), _openMode(0), _compressLevel(Z_DEFAULT_COMPRESSION), _blockPosition(0),
-               _blockLength(0), _blockOffset(0), _cacheSize(0), _maxCacheSize(0), _fileOwned(false), _fileSize(0)
+               _blockLength(0), _blockOffset(0), _cacheSize(0), _maxCacheSize(0), _cacheClock(0), _fileOwned(false),
+               _fileSize(0), _numThreads(omp_get_max_threads()), _batchSize(0), _nextBlockAddress(0),
+               _sequentialBlocks(READ_AHEAD_AFTER), _uncompressedWritten(0)
     {}
 
     ~Stream()
@@ -408,6 +472,9 @@ _bgzfLoadBlockFromCache(Stream<Bgzf> & stream, __int64 blockAddress)
     std::map<__int64, BgzfCacheEntry_ *>::iterator it = stream._cache.find(blockAddress);
     if (it == stream._cache.end())
         return 0;
+    stream._cacheLru.erase(it->second->lastUse);
+    it->second->lastUse = ++stream._cacheClock;
+    stream._cacheLru[it->second->lastUse] = blockAddress;
 
     // Update fields of stream.
     if (stream._blockLength != 0)
@@ -437,17 +504,17 @@ _bgzfCacheBlock(Stream<Bgzf> & stream, size_t size)
     if (stream._cache.find(stream._blockPosition) != stream._cache.end())
         return true;  // Block is already cached.
 
-    // TODO(holtgrew): Implement LRU scheme?
-    
-    // Throw out blocks from cache until the new cache fits.  We simply remove the first block which should not make
-    // performance degrade much in practice.
+    // Throw out the least recently used blocks until the new block fits.
+    typedef std::map<__int64, BgzfCacheEntry_ *>::iterator TIterator;
     while (stream._cacheSize + stream._blockLength > stream._maxCacheSize)
     {
-        SEQAN_ASSERT_NOT(stream._cache.empty());
-        std::map<__int64, BgzfCacheEntry_ *>::iterator it = stream._cache.begin();
-        stream._cacheSize -= length(it->second->block);
-        delete it->second;
-        stream._cache.erase(it);
+        SEQAN_ASSERT_NOT(stream._cacheLru.empty());
+        TIterator oldest = stream._cache.find(stream._cacheLru.begin()->second);
+        SEQAN_ASSERT(oldest != stream._cache.end());
+        stream._cacheLru.erase(stream._cacheLru.begin());
+        stream._cacheSize -= length(oldest->second->block);
+        delete oldest->second;
+        stream._cache.erase(oldest);
     }
 
     // Create new cache entry, copy out block data and put it into the cache.
@@ -455,7 +522,9 @@ _bgzfCacheBlock(Stream<Bgzf> & stream, size_t size)
     entry->size = stream._blockLength;
     entry->block = prefix(stream._uncompressedBlock, stream._blockLength);
     entry->endOffset = stream._blockPosition + size;
+    entry->lastUse = ++stream._cacheClock;
     stream._cache[stream._blockPosition] = entry;
+    stream._cacheLru[entry->lastUse] = stream._blockPosition;
 
     stream._cacheSize += length(entry->block);
     SEQAN_ASSERT_LEQ(stream._cacheSize, stream._maxCacheSize);
@@ -475,16 +544,18 @@ _bgzfClearCache(Stream<Bgzf> & stream)
         delete it->second;
     stream._cacheSize = 0;
     stream._cache.clear();
+    stream._cacheLru.clear();
 }
 
 // ----------------------------------------------------------------------------
-// Helper Function _bgzfInflateBlock()
+// Helper Function _bgzfInflate()
 // ----------------------------------------------------------------------------
 
-// Inflate from compression to decompression buffer.
+// Inflate the compressed block of length blockLength in source into target which has room for targetCapacity bytes.
+// Returns the number of uncompressed bytes, -1 on errors.
 
 inline int
-_bgzfInflateBlock(Stream<Bgzf> & stream, size_t blockLength)
+_bgzfInflate(char * target, size_t targetCapacity, char const * source, size_t blockLength)
 {
     int const GZIP_WINDOW_BITS = -15;  // no zlib header
 
@@ -492,10 +563,10 @@ _bgzfInflateBlock(Stream<Bgzf> & stream, size_t blockLength)
 	int status;
     zs.zalloc = NULL;
     zs.zfree = NULL;
-    zs.next_in = static_cast<Bytef *>(static_cast<void *>(&stream._compressedBlock[0])) + 18;
+    zs.next_in = const_cast<Bytef *>(static_cast<Bytef const *>(static_cast<void const *>(source))) + 18;
     zs.avail_in = blockLength - 16;
-    zs.next_out = static_cast<Bytef *>(static_cast<void *>(&stream._uncompressedBlock[0]));
-    zs.avail_out = length(stream._uncompressedBlock);
+    zs.next_out = static_cast<Bytef *>(static_cast<void *>(target));
+    zs.avail_out = targetCapacity;
 
     status = inflateInit2(&zs, GZIP_WINDOW_BITS);
     if (status != Z_OK)
@@ -516,47 +587,41 @@ _bgzfInflateBlock(Stream<Bgzf> & stream, size_t blockLength)
 }
 
 // ----------------------------------------------------------------------------
-// Helper Function _bgzfReadBlock()
+// Helper Function _bgzfInflateBlock()
 // ----------------------------------------------------------------------------
 
-// Returns 0 on success, -1 on error, -2 on eof.
+// Inflate from compression to decompression buffer.
 
 inline int
-_bgzfReadBlock(Stream<Bgzf> & stream)
+_bgzfInflateBlock(Stream<Bgzf> & stream, size_t blockLength)
 {
-    int const BLOCK_HEADER_LENGTH = 18;
-    // Make sure there is enough space in the buffer for compressed data.
-    unsigned const MAX_BLOCK_SIZE = 64 * 1024;
-    resize(stream._compressedBlock, MAX_BLOCK_SIZE);
-    resize(stream._uncompressedBlock, MAX_BLOCK_SIZE);
+    return _bgzfInflate(&stream._uncompressedBlock[0], length(stream._uncompressedBlock),
+                        &stream._compressedBlock[0], blockLength);
+}
 
-    char header[BLOCK_HEADER_LENGTH];
+// ----------------------------------------------------------------------------
+// Helper Function _bgzfReadCompressedBlock()
+// ----------------------------------------------------------------------------
 
-    // Get address from block and try to get cached block from this address.
-    __int64 blockAddress = tell(stream._file);
-    if (_bgzfLoadBlockFromCache(stream, blockAddress))
-        return 0;
+// Read the next compressed block from the file into buffer which must have room for a block of maximal size.  Returns
+// the length of the compressed block, -1 on error, -2 on eof.
+
+inline int
+_bgzfReadCompressedBlock(String<char> & buffer, Stream<Bgzf>::TFile & file)
+{
+    int const BLOCK_HEADER_LENGTH = 18;
+    char header[BLOCK_HEADER_LENGTH];
 
     // Try to read the heder.
-    __int64 posBefore = tell(stream._file);
+    __int64 posBefore = tell(file);
     // TODO(holtgrew): Complicated reading because File<> interface is not so good.
-    bool success = read(stream._file, &header[0], sizeof(header));
-    int count = tell(stream._file) - posBefore;
+    bool success = read(file, &header[0], sizeof(header));
+    int count = tell(file) - posBefore;
     if (!success && count == 0)
         return -2;  // EOF.
     if (!success)  // Unnecessary, could go away when file interface changes.
         return -1; // Could not read header.
 
-    // If no data could be read for the header then we are at the end of the file, this is no error.
-    // TODO(holtgrew): Correct with EOF?
-    if (count == 0)
-    {
-        stream._blockLength = 0;
-        return 0;
-    }
-
-    int size = count;
-
     // Check that the header is valid.
     if (count != sizeof(header))
         return -1;  // Could not read the full header.
@@ -565,24 +630,175 @@ _bgzfReadBlock(Stream<Bgzf> & stream)
 
     // Copy header into buffer for compressed data.
     int blockLength = _bgzfUnpackInt16((unsigned char *)&header[16]) + 1;
-    char * compressedBlock = (char *)&stream._compressedBlock[0];
+    char * compressedBlock = &buffer[0];
     memcpy(compressedBlock, header, BLOCK_HEADER_LENGTH);
     int remaining = blockLength - BLOCK_HEADER_LENGTH;
 
     // Read remainder of block into buffer for compressed data.
     // TODO(holtgrew): Complicated reading because File<> interface is not so good.
-    posBefore = tell(stream._file);
-    success = read(stream._file, &compressedBlock[BLOCK_HEADER_LENGTH], remaining);
+    posBefore = tell(file);
+    success = read(file, &compressedBlock[BLOCK_HEADER_LENGTH], remaining);
     if (!success)
         return -1;
-    count = tell(stream._file) - posBefore;
+    count = tell(file) - posBefore;
     if (count != remaining)
         return -1;  // Read failed.
 
-    size += count;
+    return blockLength;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bgzfFillReadBatch()
+// ----------------------------------------------------------------------------
+
+// Read up to length(stream._batch) blocks starting at blockAddress and decompress them in parallel.  Returns 0 on
+// success, -1 on error, -2 on eof.  Errors in blocks behind the first one are only reported when these blocks are
+// requested.
+
+inline int
+_bgzfFillReadBatch(Stream<Bgzf> & stream, __int64 blockAddress)
+{
+    unsigned const MAX_BLOCK_SIZE = 64 * 1024;
+
+    // Read compressed blocks sequentially, this is limited by I/O anyway.
+    stream._batchSize = 0;
+    for (unsigned i = 0; i < length(stream._batch); ++i)
+    {
+        BgzfBatchEntry_ & entry = stream._batch[i];
+        resize(entry.compressedBlock, MAX_BLOCK_SIZE);
+        resize(entry.uncompressedBlock, MAX_BLOCK_SIZE);
+
+        entry.blockPosition = blockAddress;
+        int res = _bgzfReadCompressedBlock(entry.compressedBlock, stream._file);
+        if (res < 0)
+        {
+            if (i == 0)
+                return res;
+            break;
+        }
+        entry.compressedLength = res;
+        blockAddress += res;
+        ++stream._batchSize;
+    }
+
+    // Decompress the blocks in parallel.
+    SEQAN_OMP_PRAGMA(parallel for num_threads(stream._numThreads) schedule(dynamic))
+    for (int i = 0; i < (int)stream._batchSize; ++i)
+    {
+        BgzfBatchEntry_ & entry = stream._batch[i];
+        entry.uncompressedLength = _bgzfInflate(&entry.uncompressedBlock[0], length(entry.uncompressedBlock),
+                                                &entry.compressedBlock[0], entry.compressedLength);
+    }
+
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bgzfBatchContains()
+// ----------------------------------------------------------------------------
+
+// Returns true if the block at blockAddress has already been read ahead into the batch.
+
+inline bool
+_bgzfBatchContains(Stream<Bgzf> const & stream, __int64 blockAddress)
+{
+    for (unsigned i = 0; i < stream._batchSize; ++i)
+        if (stream._batch[i].blockPosition == blockAddress)
+            return true;
+    return false;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bgzfLoadBlockFromBatch()
+// ----------------------------------------------------------------------------
+
+// Make the block at blockAddress the current block, refill the batch if the block has not been read ahead.  Returns
+// 0 on success, -1 on error, -2 on eof.
+
+inline int
+_bgzfLoadBlockFromBatch(Stream<Bgzf> & stream, __int64 blockAddress)
+{
+    unsigned i = 0;
+    for (; i < stream._batchSize; ++i)
+        if (stream._batch[i].blockPosition == blockAddress)
+            break;
+
+    if (i == stream._batchSize)
+    {
+        int res = _bgzfFillReadBatch(stream, blockAddress);
+        if (res != 0)
+            return res;
+        i = 0;
+    }
+
+    BgzfBatchEntry_ & entry = stream._batch[i];
+    if (entry.uncompressedLength < 0)
+        return -1;  // Decompression failed.
+
+    // Swap decompressed data into the current block and position the file behind the block such that the next block
+    // address can be obtained from the file as in the sequential case.
+    swap(stream._uncompressedBlock, entry.uncompressedBlock);
+    entry.blockPosition = -1;  // The entry's buffer is now invalid.
+    seek(stream._file, blockAddress + entry.compressedLength, SEEK_SET);
+
+    if (stream._blockLength != 0)
+        stream._blockOffset = 0;  // Do not reset offset if this read follows a seek.
+
+    // Update block address and length in stream object and add block to cache.
+    stream._blockPosition = blockAddress;
+    stream._blockLength = entry.uncompressedLength;
+    _bgzfCacheBlock(stream, entry.compressedLength);
+
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bgzfReadBlock()
+// ----------------------------------------------------------------------------
+
+// Returns 0 on success, -1 on error, -2 on eof.
+
+inline int
+_bgzfReadBlock(Stream<Bgzf> & stream)
+{
+    // Make sure there is enough space in the buffer for compressed data.
+    unsigned const MAX_BLOCK_SIZE = 64 * 1024;
+    resize(stream._compressedBlock, MAX_BLOCK_SIZE);
+    resize(stream._uncompressedBlock, MAX_BLOCK_SIZE);
+
+    // Get address from block and check whether the blocks are read in order.
+    __int64 blockAddress = tell(stream._file);
+    if (blockAddress != stream._nextBlockAddress)
+        stream._sequentialBlocks = 0;
+    else if (stream._sequentialBlocks < Stream<Bgzf>::READ_AHEAD_AFTER)
+        ++stream._sequentialBlocks;
+    stream._nextBlockAddress = -1;
+
+    // Try to get cached block from this address.
+    if (_bgzfLoadBlockFromCache(stream, blockAddress))
+    {
+        stream._nextBlockAddress = tell(stream._file);
+        return 0;
+    }
+
+    // Decompress blocks ahead in parallel if enabled and the blocks are read in order.  After a seek to some other
+    // block, only single blocks are read until sequential access is detected again.
+    if (stream._numThreads > 1 &&
+        (stream._sequentialBlocks >= Stream<Bgzf>::READ_AHEAD_AFTER || _bgzfBatchContains(stream, blockAddress)))
+    {
+        int res = _bgzfLoadBlockFromBatch(stream, blockAddress);
+        if (res == 0)
+            stream._nextBlockAddress = tell(stream._file);
+        return res;
+    }
+
+    // Read the compressed block.
+    int size = _bgzfReadCompressedBlock(stream._compressedBlock, stream._file);
+    if (size < 0)
+        return size;  // Error or EOF.
 
     // Decompress between compression and decompression buffer.
-    count = _bgzfInflateBlock(stream, blockLength);
+    int count = _bgzfInflateBlock(stream, size);
     if (count < 0)
         return -1;  // Decompression failed.
 
@@ -593,18 +809,21 @@ _bgzfReadBlock(Stream<Bgzf> & stream)
     stream._blockPosition = blockAddress;
     stream._blockLength = count;
     _bgzfCacheBlock(stream, size);
+    stream._nextBlockAddress = blockAddress + size;
 
     return 0;
 }
 
 // ----------------------------------------------------------------------------
-// Helper Function _bgzfDeflateBlock()
+// Helper Function _bgzfDeflate()
 // ----------------------------------------------------------------------------
 
-// Deflate from uncompressed block to compressed block.  Also add extra field that stores the compressed block length.
+// Deflate inputLength bytes from source into the buffer target.  Also add extra field that stores the compressed block
+// length.  Returns the length of the compressed block, -1 on errors.  If the input does not compress enough then only a
+// prefix of the input is compressed and inputLength is set to the length of this prefix.
 
 inline int
-_bgzfDeflateBlock(Stream<Bgzf> & stream, int blockLength)
+_bgzfDeflate(String<char> & target, char const * source, int & inputLength, int compressLevel)
 {
     const int BLOCK_HEADER_LENGTH = 18;
     const int BLOCK_FOOTER_LENGTH = 8;
@@ -624,12 +843,11 @@ _bgzfDeflateBlock(Stream<Bgzf> & stream, int blockLength)
 
     const int MAX_BLOCK_SIZE = 64 * 1024;
 
-    // Make sure there is enough space in the buffer for compressed and uncompressed data.
-    resize(stream._compressedBlock, MAX_BLOCK_SIZE);
-    resize(stream._uncompressedBlock, MAX_BLOCK_SIZE);
+    // Make sure there is enough space in the buffer for compressed data.
+    resize(target, MAX_BLOCK_SIZE);
 
-    char * buffer = &stream._compressedBlock[0];
-    int bufferSize = length(stream._compressedBlock);
+    char * buffer = &target[0];
+    int bufferSize = length(target);
 
     // Init gzip header
     buffer[0] = GZIP_ID1;
@@ -652,19 +870,18 @@ _bgzfDeflateBlock(Stream<Bgzf> & stream, int blockLength)
     buffer[17] = 0;
 
     // Loop to retry for blocks that do not compress enough.
-    int inputLength = blockLength;
     int compressedLength = 0;
     while (true)
     {
         z_stream zs;
         zs.zalloc = NULL;
         zs.zfree = NULL;
-        zs.next_in = static_cast<Bytef *>(static_cast<void *>(&stream._uncompressedBlock[0]));
+        zs.next_in = const_cast<Bytef *>(static_cast<Bytef const *>(static_cast<void const *>(source)));
         zs.avail_in = inputLength;
         zs.next_out = static_cast<Bytef *>(static_cast<void *>(&buffer[BLOCK_HEADER_LENGTH]));
         zs.avail_out = bufferSize - BLOCK_HEADER_LENGTH - BLOCK_FOOTER_LENGTH;
 
-        int status = deflateInit2(&zs, stream._compressLevel, Z_DEFLATED,
+        int status = deflateInit2(&zs, compressLevel, Z_DEFLATED,
                                   GZIP_WINDOW_BITS, Z_DEFAULT_MEM_LEVEL, Z_DEFAULT_STRATEGY);
         if (status != Z_OK)
             return -1;  // deflateInit2() failed.
@@ -700,10 +917,33 @@ _bgzfDeflateBlock(Stream<Bgzf> & stream, int blockLength)
     // Set compressed length into buffer, compute CRC and write CRC into buffer.
     _bgzfPackInt16((unsigned char*)&buffer[16], compressedLength - 1);
     __uint32 crc = crc32(0L, NULL, 0L);
-    crc = crc32(crc, static_cast<Bytef *>(static_cast<void *>(&stream._uncompressedBlock[0])), inputLength);
+    crc = crc32(crc, static_cast<Bytef const *>(static_cast<void const *>(source)), inputLength);
     _bgzfPackInt32((unsigned char*)&buffer[compressedLength - 8], crc);
     _bgzfPackInt32((unsigned char*)&buffer[compressedLength - 4], inputLength);
 
+    return compressedLength;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bgzfDeflateBlock()
+// ----------------------------------------------------------------------------
+
+// Deflate from uncompressed block to compressed block.
+
+inline int
+_bgzfDeflateBlock(Stream<Bgzf> & stream, int blockLength)
+{
+    const int MAX_BLOCK_SIZE = 64 * 1024;
+
+    // Make sure there is enough space in the buffer for uncompressed data.
+    resize(stream._uncompressedBlock, MAX_BLOCK_SIZE);
+
+    int inputLength = blockLength;
+    int compressedLength = _bgzfDeflate(stream._compressedBlock, &stream._uncompressedBlock[0], inputLength,
+                                        stream._compressLevel);
+    if (compressedLength < 0)
+        return -1;
+
     // Copy data that did not fit into the compressed block forward in the uncompressed data buffer.
     int remaining = blockLength - inputLength;
     if (remaining > 0)
@@ -719,6 +959,137 @@ _bgzfDeflateBlock(Stream<Bgzf> & stream, int blockLength)
     return compressedLength;
 }
 
+// ----------------------------------------------------------------------------
+// Helper Function _bgzfWriteCompressedBlock()
+// ----------------------------------------------------------------------------
+
+// Write the compressed block of length blockLength from buffer to the file, it holds uncompressedLength bytes of
+// data.  Returns 0 on success, -1 on errors.
+
+inline int
+_bgzfWriteCompressedBlock(Stream<Bgzf> & stream, char const * buffer, int blockLength, int uncompressedLength)
+{
+    typedef Position<Stream<Bgzf> >::Type TPos;
+    TPos posBefore = tell(stream._file);
+    if (!write(stream._file, buffer, blockLength))
+        return -1;  // Could not write.
+    TPos posAfter = tell(stream._file);
+    int count = posAfter - posBefore;
+    if (count != blockLength)
+        return -1;  // Writing failed.
+
+    // Translate the pending positions in this block into virtual offsets.
+    __uint64 blockEnd = stream._uncompressedWritten + uncompressedLength;
+    unsigned numTells = 0;
+    for (; numTells < length(stream._pendingTells) && stream._pendingTells[numTells] < blockEnd; ++numTells)
+    {
+        __uint64 pos = stream._pendingTells[numTells];
+        __uint64 virtualOffset = (stream._blockPosition << 16) | (pos - stream._uncompressedWritten);
+        appendValue(stream._writtenTells, Pair<__uint64, __uint64>(pos, virtualOffset));
+    }
+    erase(stream._pendingTells, 0, numTells);
+
+    stream._uncompressedWritten = blockEnd;
+    stream._blockPosition += blockLength;
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bgzfFlushWriteBatch()
+// ----------------------------------------------------------------------------
+
+// Compress the blocks in the write batch in parallel and write them out in order.  Returns 0 on success, -1 on errors.
+
+inline int
+_bgzfFlushWriteBatch(Stream<Bgzf> & stream)
+{
+    if (stream._batchSize == 0)
+        return 0;
+
+    SEQAN_OMP_PRAGMA(parallel for num_threads(stream._numThreads) schedule(dynamic))
+    for (int i = 0; i < (int)stream._batchSize; ++i)
+    {
+        BgzfBatchEntry_ & entry = stream._batch[i];
+        entry.consumedLength = entry.uncompressedLength;
+        entry.compressedLength = _bgzfDeflate(entry.compressedBlock, &entry.uncompressedBlock[0],
+                                              entry.consumedLength, stream._compressLevel);
+    }
+
+    unsigned batchSize = stream._batchSize;
+    stream._batchSize = 0;
+    for (unsigned i = 0; i < batchSize; ++i)
+    {
+        BgzfBatchEntry_ & entry = stream._batch[i];
+        if (entry.compressedLength < 0)
+            return -1;  // Deflate failed.
+        if (_bgzfWriteCompressedBlock(stream, &entry.compressedBlock[0], entry.compressedLength,
+                                      entry.consumedLength) != 0)
+            return -1;
+
+        // Blocks that did not compress enough are continued in additional blocks.
+        for (int offset = entry.consumedLength; offset < entry.uncompressedLength; )
+        {
+            int inputLength = entry.uncompressedLength - offset;
+            int blockLength = _bgzfDeflate(entry.compressedBlock, &entry.uncompressedBlock[offset], inputLength,
+                                           stream._compressLevel);
+            if (blockLength < 0 ||
+                _bgzfWriteCompressedBlock(stream, &entry.compressedBlock[0], blockLength, inputLength) != 0)
+                return -1;
+            offset += inputLength;
+        }
+    }
+
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bgzfWriteFullBlock()
+// ----------------------------------------------------------------------------
+
+// Called when the current uncompressed block is full.  Compresses and writes it directly or adds it to the write
+// batch if parallel compression is enabled.  Returns 0 on success, -1 on errors.
+
+inline int streamFlush(Stream<Bgzf> & stream);
+
+inline int
+_bgzfWriteFullBlock(Stream<Bgzf> & stream)
+{
+    unsigned const MAX_BLOCK_SIZE = 64 * 1024;
+
+    if (stream._numThreads <= 1)
+        return streamFlush(stream);
+
+    // Move the block into the batch and compress the batch once it is full.
+    BgzfBatchEntry_ & entry = stream._batch[stream._batchSize++];
+    swap(entry.uncompressedBlock, stream._uncompressedBlock);
+    entry.uncompressedLength = stream._blockOffset;
+    resize(stream._uncompressedBlock, MAX_BLOCK_SIZE);
+    stream._blockOffset = 0;
+
+    if (stream._batchSize == length(stream._batch))
+        return _bgzfFlushWriteBatch(stream);
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bgzfResizeBatch()
+// ----------------------------------------------------------------------------
+
+// Allocate the batch for the current number of threads.  Each thread gets several blocks such that the threads stay
+// busy when the blocks take different times to (de)compress.
+
+inline void
+_bgzfResizeBatch(Stream<Bgzf> & stream)
+{
+    unsigned const BLOCKS_PER_THREAD = 4;
+
+    stream._batchSize = 0;
+    if (stream._numThreads > 1)
+        resize(stream._batch, stream._numThreads * BLOCKS_PER_THREAD);
+    else
+        clear(stream._batch);
+}
+
 // ----------------------------------------------------------------------------
 // Function attachToFile
 // ----------------------------------------------------------------------------
@@ -764,6 +1135,12 @@ attachToFile(Stream<Bgzf> & stream, int fileHandle, int mode)
     // Set compression level.
     if (mode & OPEN_WRONLY)
         stream._compressLevel = Z_DEFAULT_COMPRESSION;
+    stream._nextBlockAddress = tell(stream._file);
+    stream._sequentialBlocks = Stream<Bgzf>::READ_AHEAD_AFTER;
+    stream._uncompressedWritten = 0;
+    clear(stream._pendingTells);
+    clear(stream._writtenTells);
+    _bgzfResizeBatch(stream);
 }
 
 // ----------------------------------------------------------------------------
@@ -803,6 +1180,12 @@ open(Stream<Bgzf> & stream, char const * filename, char const * mode)
     stream._blockLength = 0;
     stream._blockOffset = 0;
     stream._fileSize = 0;
+    stream._nextBlockAddress = 0;  // Reading from the start of the file is sequential access.
+    stream._sequentialBlocks = Stream<Bgzf>::READ_AHEAD_AFTER;
+    stream._uncompressedWritten = 0;
+    clear(stream._pendingTells);
+    clear(stream._writtenTells);
+    _bgzfResizeBatch(stream);
 
     // Actually open files.
     if (mode[0] == 'r' || mode[0] == 'R')  // Open for reading.
@@ -848,6 +1231,84 @@ open(Stream<Bgzf> & stream, char const * filename, char const * mode)
     return false;
 }
 
+// ----------------------------------------------------------------------------
+// Function numThreads()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BgzfStream#numThreads
+ * @brief Return the number of threads used for compressing and decompressing blocks.
+ *
+ * @signature unsigned numThreads(stream);
+ *
+ * @param[in] stream The BgzfStream to query.
+ *
+ * @return unsigned The number of threads, 1 if blocks are processed sequentially.
+ */
+
+/**
+.Function.numThreads
+..class:Spec.BGZF Stream
+..cat:Input/Output
+..summary:Return the number of threads used for compressing and decompressing blocks.
+..signature:numThreads(stream)
+..param.stream:The BGZF Stream to query.
+...type:Spec.BGZF Stream
+..returns:The number of threads, 1 if blocks are processed sequentially.
+..see:Function.setNumThreads
+..include:seqan/stream.h
+*/
+
+inline unsigned
+numThreads(Stream<Bgzf> const & stream)
+{
+    return stream._numThreads;
+}
+
+// ----------------------------------------------------------------------------
+// Function setNumThreads()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BgzfStream#setNumThreads
+ * @brief Set the number of threads used for compressing and decompressing blocks.
+ *
+ * @signature void setNumThreads(stream, num);
+ *
+ * @param[in,out] stream The BgzfStream to configure.
+ * @param[in]     num    The number of threads, 1 to process blocks sequentially.  Type: <tt>unsigned</tt>.
+ *
+ * @section Remarks
+ *
+ * Parallel (de)compression requires OpenMP, otherwise the batches of blocks are processed by the calling thread.
+ * The stream can be reconfigured while it is open, pending blocks are written out first.
+ */
+
+/**
+.Function.setNumThreads
+..class:Spec.BGZF Stream
+..cat:Input/Output
+..summary:Set the number of threads used for compressing and decompressing blocks.
+..signature:setNumThreads(stream, num)
+..param.stream:The BGZF Stream to configure.
+...type:Spec.BGZF Stream
+..param.num:The number of threads, 1 to process blocks sequentially.
+...type:nolink:$unsigned$
+..remarks:Parallel (de)compression requires OpenMP, otherwise the batches of blocks are processed by the calling thread.
+The stream can be reconfigured while it is open, pending blocks are written out first.
+..see:Function.numThreads
+..include:seqan/stream.h
+*/
+
+inline void
+setNumThreads(Stream<Bgzf> & stream, unsigned num)
+{
+    if (stream._openMode & OPEN_WRONLY)
+        _bgzfFlushWriteBatch(stream);
+    stream._numThreads = (num == 0u) ? 1u : num;
+    _bgzfResizeBatch(stream);
+}
+
 // ----------------------------------------------------------------------------
 // Function streamFlush()
 // ----------------------------------------------------------------------------
@@ -855,22 +1316,19 @@ open(Stream<Bgzf> & stream, char const * filename, char const * mode)
 inline int
 streamFlush(Stream<Bgzf> & stream)
 {
+    // Write out the blocks waiting for parallel compression first.
+    if ((stream._openMode & OPEN_WRONLY) && _bgzfFlushWriteBatch(stream) != 0)
+        return -1;
+
     while (stream._blockOffset > 0)
     {
+        int inputLength = stream._blockOffset;
 		int blockLength = _bgzfDeflateBlock(stream, stream._blockOffset);
         if (blockLength < 0)
             return -1;
-
-        typedef Position<Stream<Bgzf> >::Type TPos;
-        TPos posBefore = tell(stream._file);
-        if (!write(stream._file, &stream._compressedBlock[0], blockLength))
-            return -1;  // Could not write.
-        TPos posAfter = tell(stream._file);
-        int count = posAfter - posBefore;
-        if (count != blockLength)
-            return -1;  // Writing failed.
-
-        stream._blockPosition += blockLength;
+        inputLength -= stream._blockOffset;  // Data that did not fit remains at the start of the buffer.
+        if (_bgzfWriteCompressedBlock(stream, &stream._compressedBlock[0], blockLength, inputLength) != 0)
+            return -1;
     }
 
     return 0;
@@ -919,8 +1377,9 @@ close(Stream<Bgzf> & stream)
         flush(stream._file);
     }
 
-    // Clear the cache.
+    // Clear the cache and the batch.
     _bgzfClearCache(stream);
+    stream._batchSize = 0;
 
     // Close file.
     close(stream._file);
@@ -1162,7 +1621,7 @@ streamWriteBlock(Stream<Bgzf> & stream, char const * source, size_t count)
         inPtr += copyLength;
         bytesWritten += copyLength;
 
-        if (stream._blockOffset == blockLength && streamFlush(stream) != 0)
+        if (stream._blockOffset == blockLength && _bgzfWriteFullBlock(stream) != 0)
             break;
     }
 
@@ -1220,12 +1679,145 @@ streamSeek(Stream<Bgzf> & stream, __uint64 virtualPos, int origin)
 // Function streamTell()
 // ----------------------------------------------------------------------------
 
+// When writing, the address of the current block is only known after the blocks before it have been compressed, so
+// pending blocks are compressed first.  Writers that need many positions should use bgzfTellUncompressed() and resolve
+// the positions with bgzfVirtualOffset() later.
+
 inline Position<Stream<Bgzf> >::Type
 streamTell(Stream<Bgzf> & stream)
 {
+    if (stream._openMode & OPEN_WRONLY)
+        _bgzfFlushWriteBatch(stream);
+
     return (stream._blockPosition << 16) | (stream._blockOffset & 0xFFFF);
 }
 
+// ----------------------------------------------------------------------------
+// Function bgzfTellUncompressed()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BgzfStream#bgzfTellUncompressed
+ * @brief Return the position in the uncompressed data written so far.
+ *
+ * @signature __uint64 bgzfTellUncompressed(stream);
+ *
+ * @param[in] stream The BgzfStream opened for writing.
+ *
+ * @return __uint64 The number of uncompressed bytes written to the stream.
+ *
+ * @section Remarks
+ *
+ * In contrast to @link BgzfStream#streamTell streamTell @endlink, this does not have to wait for the compression of
+ * pending blocks.  Use @link BgzfStream#bgzfVirtualOffset bgzfVirtualOffset @endlink for translating the position
+ * into a virtual offset once its block has been written.  The stream records the returned positions until it is
+ * closed.
+ */
+
+/**
+.Function.bgzfTellUncompressed
+..class:Spec.BGZF Stream
+..cat:Input/Output
+..summary:Return the position in the uncompressed data written so far.
+..signature:bgzfTellUncompressed(stream)
+..param.stream:The BGZF Stream opened for writing.
+...type:Spec.BGZF Stream
+..returns:The number of uncompressed bytes written to the stream, type $__uint64$.
+..remarks:In contrast to @Function.streamTell@, this does not have to wait for the compression of pending blocks.
+Use @Function.bgzfVirtualOffset@ for translating the position into a virtual offset once its block has been written.
+The stream records the returned positions until it is closed.
+..see:Function.bgzfVirtualOffset
+..include:seqan/stream.h
+*/
+
+inline __uint64
+bgzfTellUncompressed(Stream<Bgzf> & stream)
+{
+    __uint64 pos = stream._uncompressedWritten + stream._blockOffset;
+    for (unsigned i = 0; i < stream._batchSize; ++i)
+        pos += stream._batch[i].uncompressedLength;
+
+    // Remember the position for translating it once its block is written.
+    if (empty(stream._pendingTells) || back(stream._pendingTells) != pos)
+        appendValue(stream._pendingTells, pos);
+    return pos;
+}
+
+// ----------------------------------------------------------------------------
+// Function bgzfVirtualOffset()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BgzfStream#bgzfVirtualOffset
+ * @brief Translate a position in the uncompressed data into a virtual offset.
+ *
+ * @signature bool bgzfVirtualOffset(virtualOffset, stream, pos);
+ *
+ * @param[out] virtualOffset The virtual offset of <tt>pos</tt>, as returned by streamTell.  Type: <tt>__uint64</tt>.
+ * @param[in]  stream        The BgzfStream opened for writing.
+ * @param[in]  pos           A position returned by @link BgzfStream#bgzfTellUncompressed bgzfTellUncompressed
+ *                           @endlink.  Type: <tt>__uint64</tt>.
+ *
+ * @return bool <tt>false</tt> if the block containing <tt>pos</tt> has not been written yet or <tt>pos</tt> was not
+ *              returned by bgzfTellUncompressed, <tt>true</tt> otherwise.
+ *
+ * @section Remarks
+ *
+ * The virtual offsets of all positions are available after @link BgzfStream#streamFlush streamFlush @endlink.
+ */
+
+/**
+.Function.bgzfVirtualOffset
+..class:Spec.BGZF Stream
+..cat:Input/Output
+..summary:Translate a position in the uncompressed data into a virtual offset.
+..signature:bgzfVirtualOffset(virtualOffset, stream, pos)
+..param.virtualOffset:The virtual offset of $pos$, as returned by @Function.streamTell@.
+...type:nolink:$__uint64$
+..param.stream:The BGZF Stream opened for writing.
+...type:Spec.BGZF Stream
+..param.pos:A position returned by @Function.bgzfTellUncompressed@.
+...type:nolink:$__uint64$
+..returns:$false$ if the block containing $pos$ has not been written yet or $pos$ was not returned by
+@Function.bgzfTellUncompressed@, $true$ otherwise.
+..remarks:The virtual offsets of all positions are available after @Function.streamFlush@.
+..see:Function.bgzfTellUncompressed
+..include:seqan/stream.h
+*/
+
+inline bool
+bgzfVirtualOffset(__uint64 & virtualOffset, Stream<Bgzf> const & stream, __uint64 pos)
+{
+    typedef Pair<__uint64, __uint64> TTell;
+
+    if (pos > stream._uncompressedWritten)
+        return false;  // The block is still pending.
+
+    // A position at the end of the written data is at the start of the next block.
+    if (pos == stream._uncompressedWritten)
+    {
+        virtualOffset = (__uint64)stream._blockPosition << 16;
+        return true;
+    }
+
+    // Search for the recorded position, they are sorted.
+    TTell const * tells = begin(stream._writtenTells, Standard());
+    size_t lo = 0, hi = length(stream._writtenTells);
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        if (tells[mid].i1 < pos)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo == length(stream._writtenTells) || tells[lo].i1 != pos)
+        return false;  // Not returned by bgzfTellUncompressed().
+
+    virtualOffset = tells[lo].i2;
+    return true;
+}
+
 }  // namespace seqan
 
 #endif  // #ifndef EXTRAS_INCLUDE_SEQAN_STREAM_STREAM_BGZF_H_
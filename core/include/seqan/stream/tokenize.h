@@ -554,6 +554,153 @@ _countHelper(unsigned & count,
 
 
 
+// ----------------------------------------------------------------------------
+// Function _readUntilFinderCharwise()
+// ----------------------------------------------------------------------------
+
+template <typename TBuffer, typename TReader, typename TFinder>
+inline int
+_readUntilFinderCharwise(TBuffer & buffer, TReader & reader, TFinder const & finder, size_t & limit)
+{
+    for (; limit != 0; --limit)
+    {
+        if (atEnd(reader))
+            return EOF_BEFORE_SUCCESS;
+        char c = value(reader);
+        if (finder(c))
+            return 0;
+        _appendChar(buffer, c);
+        goNext(reader);
+        if (resultCode(reader) != 0)
+        {
+            --limit;
+            return resultCode(reader);
+        }
+    }
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Function _readUntilFinderChunked()
+// ----------------------------------------------------------------------------
+
+// Works on a record reader that buffers a contiguous chunk of characters in
+// [_current, _end) and can move forward with _advanceChunk().  The chunk is
+// searched for the delimiters of a finder (see tokenize_simd.h) as a whole
+// and the token is appended with one copy instead of going through value()
+// and goNext() for every character.
+
+template <typename TFile>
+inline void
+_advanceChunk(RecordReader<TFile, SinglePass<void> > & reader, size_t n)
+{
+    reader._current += n;
+    if (reader._current == reader._end)
+        _refillBuffer(reader);
+}
+
+template <typename TString>
+inline void
+_advanceChunk(RecordReader<TString, SinglePass<StringReader> > & reader, size_t n)
+{
+    reader._current += n;
+}
+
+template <typename TBuffer, typename TReader, typename TFinder>
+inline int
+_readUntilFinderChunked(TBuffer & buffer, TReader & reader, TFinder const & finder, size_t & limit)
+{
+    while (limit != 0)
+    {
+        if (atEnd(reader))
+            return EOF_BEFORE_SUCCESS;
+        char const * first = &*reader._current;
+        char const * last = first + std::min(static_cast<size_t>(reader._end - reader._current), limit);
+        char const * hit = _findFirst(first, last, finder);
+        _appendChars(buffer, first, hit);
+        _advanceChunk(reader, hit - first);
+        limit -= hit - first;
+        if (hit != last)
+            return 0;
+        if (resultCode(reader) != 0)
+            return resultCode(reader);
+    }
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Function _readUntilFinder()
+// ----------------------------------------------------------------------------
+
+// Appends characters from the reader to buffer until the finder matches the
+// current character or limit characters were read.  The limit is decreased by
+// the number of characters read.  Returns 0 on success, EOF_BEFORE_SUCCESS if
+// the end was reached before, or the result code of the reader.  Pass a
+// Nothing buffer to skip the characters.
+
+template <typename TBuffer, typename TReader, typename TFinder>
+inline int
+_readUntilFinder(TBuffer & buffer, TReader & reader, TFinder const & finder, size_t & limit)
+{
+    return _readUntilFinderCharwise(buffer, reader, finder, limit);
+}
+
+template <typename TBuffer, typename TFile, typename TFinder>
+inline int
+_readUntilFinder(TBuffer & buffer, RecordReader<TFile, SinglePass<void> > & reader, TFinder const & finder,
+                 size_t & limit)
+{
+    return _readUntilFinderChunked(buffer, reader, finder, limit);
+}
+
+// Only strings that store their chars contiguously, e.g. memory mapped files,
+// can be searched chunk-wise.
+
+template <typename TBuffer, typename TReader, typename TFinder>
+inline int
+_readUntilFinderString(TBuffer & buffer, TReader & reader, TFinder const & finder, size_t & limit,
+                       True const & /*contiguous*/)
+{
+    return _readUntilFinderChunked(buffer, reader, finder, limit);
+}
+
+template <typename TBuffer, typename TReader, typename TFinder>
+inline int
+_readUntilFinderString(TBuffer & buffer, TReader & reader, TFinder const & finder, size_t & limit,
+                       False const & /*contiguous*/)
+{
+    return _readUntilFinderCharwise(buffer, reader, finder, limit);
+}
+
+template <typename TBuffer, typename TString, typename TFinder>
+inline int
+_readUntilFinder(TBuffer & buffer, RecordReader<TString, SinglePass<StringReader> > & reader, TFinder const & finder,
+                 size_t & limit)
+{
+    typedef typename IsSameType<typename Iterator<TString, Standard>::Type, char *>::Type TContiguous;
+    return _readUntilFinderString(buffer, reader, finder, limit, TContiguous());
+}
+
+template <typename TBuffer, typename TReader, typename TFinder>
+inline int
+_readUntilFinder(TBuffer & buffer, TReader & reader, TFinder const & finder)
+{
+    size_t limit = MaxValue<size_t>::VALUE;
+    return _readUntilFinder(buffer, reader, finder, limit);
+}
+
+// ----------------------------------------------------------------------------
+// Function _skipUntilFinder()
+// ----------------------------------------------------------------------------
+
+template <typename TReader, typename TFinder>
+inline int
+_skipUntilFinder(TReader & reader, TFinder const & finder)
+{
+    Nothing nothing;
+    return _readUntilFinder(nothing, reader, finder);
+}
+
 // ----------------------------------------------------------------------------
 // Function _readAndCompareWithStr()
 // ----------------------------------------------------------------------------
@@ -634,85 +781,35 @@ template <typename TBuffer, typename TStream, typename TPass>
 inline int
 readUntilOneOf(TBuffer & buffer, RecordReader<TStream, TPass> & reader, char c1)
 {
-    while (!atEnd(reader))
-    {
-        char c = value(reader);
-        if (c == c1)
-            return 0;
-        appendValue(buffer, c, Generous());
-        goNext(reader);
-        if (resultCode(reader) != 0)
-            return resultCode(reader);
-    }
-    return EOF_BEFORE_SUCCESS;
+    return _readUntilFinder(buffer, reader, OneOfFinder_<1>(c1));
 }
 
 template <typename TBuffer, typename TStream, typename TPass>
 inline int
 readUntilOneOf(TBuffer & buffer, RecordReader<TStream, TPass> & reader, char c1, char c2)
 {
-    while (!atEnd(reader))
-    {
-        char c = value(reader);
-        if (c == c1 || c == c2)
-            return 0;
-        appendValue(buffer, c, Generous());
-        goNext(reader);
-        if (resultCode(reader) != 0)
-            return resultCode(reader);
-    }
-    return EOF_BEFORE_SUCCESS;
+    return _readUntilFinder(buffer, reader, OneOfFinder_<2>(c1, c2));
 }
 
 template <typename TBuffer, typename TStream, typename TPass>
 inline int
 readUntilOneOf(TBuffer & buffer, RecordReader<TStream, TPass> & reader, char c1, char c2, char c3)
 {
-    while (!atEnd(reader))
-    {
-        char c = value(reader);
-        if (c == c1 || c == c2 || c == c3)
-            return 0;
-        appendValue(buffer, c, Generous());
-        goNext(reader);
-        if (resultCode(reader) != 0)
-            return resultCode(reader);
-    }
-    return EOF_BEFORE_SUCCESS;
+    return _readUntilFinder(buffer, reader, OneOfFinder_<3>(c1, c2, c3));
 }
 
 template <typename TBuffer, typename TStream, typename TPass>
 inline int
 readUntilOneOf(TBuffer & buffer, RecordReader<TStream, TPass> & reader, char c1, char c2, char c3, char c4)
 {
-    while (!atEnd(reader))
-    {
-        char c = value(reader);
-        if (c == c1 || c == c2 || c == c3 || c == c4)
-            return 0;
-        appendValue(buffer, c, Generous());
-        goNext(reader);
-        if (resultCode(reader) != 0)
-            return resultCode(reader);
-    }
-    return EOF_BEFORE_SUCCESS;
+    return _readUntilFinder(buffer, reader, OneOfFinder_<4>(c1, c2, c3, c4));
 }
 
 template <typename TBuffer, typename TStream, typename TPass>
 inline int
 readUntilOneOf(TBuffer & buffer, RecordReader<TStream, TPass> & reader, char c1, char c2, char c3, char c4, char c5)
 {
-    while (!atEnd(reader))
-    {
-        char c = value(reader);
-        if (c == c1 || c == c2 || c == c3 || c == c4 || c == c5)
-            return 0;
-        appendValue(buffer, c, Generous());
-        goNext(reader);
-        if (resultCode(reader) != 0)
-            return resultCode(reader);
-    }
-    return EOF_BEFORE_SUCCESS;
+    return _readUntilFinder(buffer, reader, OneOfFinder_<5>(c1, c2, c3, c4, c5));
 }
 
 /*!
@@ -767,9 +864,7 @@ readUntilWhitespace(TBuffer & buffer,
                     RecordReader<TStream, TPass> & reader)
 {
     SEQAN_CHECKPOINT
-    return _readHelper(buffer,
-                       reader,
-                       Whitespace_());
+    return _readUntilFinder(buffer, reader, WhitespaceFinder_());
 }
 
 /*!
@@ -820,9 +915,7 @@ readUntilBlank(TBuffer & buffer,
                RecordReader<TStream, TPass> & reader)
 {
     SEQAN_CHECKPOINT
-    return _readHelper(buffer,
-                       reader,
-                       Blank_());
+    return _readUntilFinder(buffer, reader, OneOfFinder_<2>(' ', '\t'));
 }
 
 /*!
@@ -875,19 +968,7 @@ readUntilChar(TBuffer & buffer,
               TCharX const & x)
 {
     SEQAN_CHECKPOINT
-    typedef char TChar;
-
-    while (!atEnd(reader))
-    {
-        TChar c = value(reader);
-        if (c == x)
-            return 0;
-        appendValue(buffer, c, Generous());
-        goNext(reader);
-        if (resultCode(reader) != 0)
-            return resultCode(reader);
-    }
-    return EOF_BEFORE_SUCCESS;
+    return _readUntilFinder(buffer, reader, OneOfFinder_<1>(x));
 }
 
 /*!
@@ -1030,13 +1111,42 @@ _readNCharsIgnoringType(TBuffer & buffer,
     return 0;
 }
 
+// Copies the runs between whitespace at once, used for reading and skipping.
+template <typename TBuffer, typename TStream, typename TPass>
+inline int
+_readNCharsIgnoringWhitespace(TBuffer & buffer,
+                              RecordReader<TStream, TPass> & reader,
+                              unsigned const n)
+{
+    size_t remaining = n;
+    while (remaining != 0)
+    {
+        if (atEnd(reader))
+            return EOF_BEFORE_SUCCESS;
+
+        if (_charCompare(value(reader), Whitespace_()))
+        {
+            goNext(reader);
+            if (resultCode(reader) != 0)
+                return resultCode(reader);
+            continue;
+        }
+
+        int r = _readUntilFinder(buffer, reader, WhitespaceFinder_(), remaining);
+        if (r != 0)
+            return r;
+    }
+    return 0;
+}
+
 template <typename TBuffer, typename TStream, typename TPass>
 inline int
 readNCharsIgnoringWhitespace(TBuffer & buffer,
                              RecordReader<TStream, TPass> & reader,
                              unsigned const n)
 {
-    return _readNCharsIgnoringType(buffer, reader, n, Whitespace_());
+    reserve(buffer, n, Exact());
+    return _readNCharsIgnoringWhitespace(buffer, reader, n);
 }
 
 /*!
@@ -1152,7 +1262,8 @@ inline int
 skipNCharsIgnoringWhitespace(RecordReader<TStream, TPass> & reader,
                              unsigned const n)
 {
-    return _skipNCharsIgnoringType(reader, n, Whitespace_());
+    Nothing nothing;
+    return _readNCharsIgnoringWhitespace(nothing, reader, n);
 }
 
 /*!
@@ -1200,7 +1311,7 @@ inline int
 skipUntilWhitespace(RecordReader<TStream, TPass> & reader)
 {
     SEQAN_CHECKPOINT
-    return _skipHelper(reader, Whitespace_());
+    return _skipUntilFinder(reader, WhitespaceFinder_());
 }
 
 /*!
@@ -1244,7 +1355,7 @@ inline int
 skipUntilBlank(RecordReader<TStream, TPass> & reader)
 {
     SEQAN_CHECKPOINT
-    return _skipHelper(reader, Blank_());
+    return _skipUntilFinder(reader, OneOfFinder_<2>(' ', '\t'));
 }
 
 /*!
@@ -1335,18 +1446,7 @@ skipUntilChar(RecordReader<TStream, TPass> & reader,
               TCharX const & x)
 {
     SEQAN_CHECKPOINT
-    typedef char TChar;
-
-    while (!atEnd(reader))
-    {
-        TChar c = value(reader);
-        if (c == x)
-            return 0;
-        goNext(reader);
-        if (resultCode(reader) != 0)
-            return resultCode(reader);
-    }
-    return EOF_BEFORE_SUCCESS;
+    return _skipUntilFinder(reader, OneOfFinder_<1>(x));
 }
 
 /*!
@@ -1456,9 +1556,7 @@ readUntilTabOrLineBreak(TBuffer & buffer,
                         RecordReader<TStream, TPass> & reader)
 {
     SEQAN_CHECKPOINT
-    return _readHelper(buffer,
-                       reader,
-                       TabOrLineBreak_());
+    return _readUntilFinder(buffer, reader, OneOfFinder_<3>('\t', '\r', '\n'));
 }
 
 // ---
@@ -2008,44 +2106,31 @@ template <typename TStream, typename TPass, typename TBuffer>
 inline int
 readLine(TBuffer & buffer, RecordReader<TStream, TPass> & reader)
 {
-    int r = 0;
+    // Copy everything up to the next line break, taking early exits on errors.
+    int r = _readUntilFinder(buffer, reader, OneOfFinder_<2>('\n', '\r'));
+    if (r != 0)
+        return r;
 
-    // Loop over characters from stream, taking early exits on line breaks and errors.
-    while (!atEnd(reader))
+    // Unix EOL is the simplest case.
+    if (value(reader) == '\n')
     {
-        char c = value(reader);
-
-        // Unix EOL is the simplest case.
-        if (c == '\n')
-        {
-            if (!atEnd(reader))
-                goNext(reader);
-            return resultCode(reader);
-        }
-
-        // If the current character is '\r' then this can be an ANSI or a Mac line ending.
-        if (c == '\r')
-        {
-            goNext(reader);
-            if ((r = resultCode(reader)) != 0)
-                return r;
-            if (atEnd(reader))
-                return 0;  // Assume Mac EOL at end of file.
-            if (value(reader) == '\n')
-            {
-                // Assume Windows EOL.
-                if (!atEnd(reader))
-                    goNext(reader);
-                return resultCode(reader);
-            }
-            return 0;  // Was Mac EOL, not at end of file.
-        }
-
-        appendValue(buffer, c);
         goNext(reader);
+        return resultCode(reader);
     }
 
-    return EOF_BEFORE_SUCCESS;
+    // If the current character is '\r' then this can be an ANSI or a Mac line ending.
+    goNext(reader);
+    if ((r = resultCode(reader)) != 0)
+        return r;
+    if (atEnd(reader))
+        return 0;  // Assume Mac EOL at end of file.
+    if (value(reader) == '\n')
+    {
+        // Assume Windows EOL.
+        goNext(reader);
+        return resultCode(reader);
+    }
+    return 0;  // Was Mac EOL, not at end of file.
 }
 
 /*!
@@ -2153,7 +2238,7 @@ template <typename TStream, typename TPass>
 inline int
 skipLine(RecordReader<TStream, TPass> & reader)
 {
-    int r = _skipHelper(reader, UnixEOL_());
+    int r = _skipUntilFinder(reader, OneOfFinder_<1>('\n'));
 
     if (r != 0)
         return r;
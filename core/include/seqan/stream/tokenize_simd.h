@@ -0,0 +1,238 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Author: agent <agent@local>
+// ==========================================================================
+// Bulk delimiter search for the tokenization functions.  A finder describes
+// a set of delimiter characters.  It can test a single character and search
+// the first delimiter in a range of chars, 16 characters at a time with SSE2.
+//
+// The finders are used by _readUntilFinder() in tokenize.h.
+//
+// The vector code is used if SEQAN_TOKENIZE_SIMD is non-zero, which is the
+// default if the compiler targets SSE2.  Define SEQAN_TOKENIZE_SIMD to 0 to
+// always use the scalar loop.
+// ==========================================================================
+
+#ifndef SEQAN_STREAM_TOKENIZE_SIMD_H_
+#define SEQAN_STREAM_TOKENIZE_SIMD_H_
+
+#include <algorithm>
+#include <cstring>
+
+#ifndef SEQAN_TOKENIZE_SIMD
+#if defined(__SSE2__) || defined(_M_X64)
+#define SEQAN_TOKENIZE_SIMD 1
+#else
+#define SEQAN_TOKENIZE_SIMD 0
+#endif
+#endif
+
+#if SEQAN_TOKENIZE_SIMD
+#include <emmintrin.h>
+#endif
+
+namespace seqan {
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Class OneOfFinder_
+// ----------------------------------------------------------------------------
+
+// Finds one of N <= 5 given characters.  Unused slots repeat the first one.
+
+template <unsigned N>
+struct OneOfFinder_
+{
+    char chars[5];
+
+    OneOfFinder_(char c1, char c2 = 0, char c3 = 0, char c4 = 0, char c5 = 0)
+    {
+        chars[0] = c1;
+        chars[1] = (N > 1) ? c2 : c1;
+        chars[2] = (N > 2) ? c3 : c1;
+        chars[3] = (N > 3) ? c4 : c1;
+        chars[4] = (N > 4) ? c5 : c1;
+    }
+
+    inline bool operator()(char c) const
+    {
+        for (unsigned i = 0; i < N; ++i)
+            if (c == chars[i])
+                return true;
+        return false;
+    }
+
+#if SEQAN_TOKENIZE_SIMD
+    inline __m128i matches(__m128i const & x) const
+    {
+        __m128i result = _mm_cmpeq_epi8(x, _mm_set1_epi8(chars[0]));
+        for (unsigned i = 1; i < N; ++i)
+            result = _mm_or_si128(result, _mm_cmpeq_epi8(x, _mm_set1_epi8(chars[i])));
+        return result;
+    }
+#endif  // #if SEQAN_TOKENIZE_SIMD
+};
+
+// ----------------------------------------------------------------------------
+// Class WhitespaceFinder_
+// ----------------------------------------------------------------------------
+
+// Finds the characters for which isspace() holds in the "C" locale, i.e. ' '
+// and '\t' to '\r'.
+
+struct WhitespaceFinder_
+{
+    inline bool operator()(char c) const
+    {
+        return c == ' ' || static_cast<unsigned char>(c - '\t') <= '\r' - '\t';
+    }
+
+#if SEQAN_TOKENIZE_SIMD
+    inline __m128i matches(__m128i const & x) const
+    {
+        __m128i shifted = _mm_sub_epi8(x, _mm_set1_epi8('\t'));
+        __m128i inRange = _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8('\r' - '\t')), shifted);
+        return _mm_or_si128(inRange, _mm_cmpeq_epi8(x, _mm_set1_epi8(' ')));
+    }
+#endif  // #if SEQAN_TOKENIZE_SIMD
+};
+
+// ----------------------------------------------------------------------------
+// Class NonAlphaNumFinder_
+// ----------------------------------------------------------------------------
+
+// Finds the characters that are not ASCII letters or digits.
+
+struct NonAlphaNumFinder_
+{
+    inline bool operator()(char c) const
+    {
+        unsigned char u = static_cast<unsigned char>(c);
+        return !(static_cast<unsigned char>(u - '0') <= 9 || static_cast<unsigned char>((u | 0x20) - 'a') <= 25);
+    }
+
+#if SEQAN_TOKENIZE_SIMD
+    inline __m128i matches(__m128i const & x) const
+    {
+        // lower-case the letters by setting bit 5, then test the ranges
+        __m128i digit = _mm_sub_epi8(x, _mm_set1_epi8('0'));
+        digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+        __m128i alpha = _mm_sub_epi8(_mm_or_si128(x, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+        alpha = _mm_cmpeq_epi8(_mm_min_epu8(alpha, _mm_set1_epi8(25)), alpha);
+        return _mm_xor_si128(_mm_or_si128(digit, alpha), _mm_set1_epi8(-1));
+    }
+#endif  // #if SEQAN_TOKENIZE_SIMD
+};
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function _findFirst()
+// ----------------------------------------------------------------------------
+
+// Returns a pointer to the first character in [first, last) the finder
+// matches or last if there is none.
+
+template <typename TFinder>
+inline char const *
+_findFirst(char const * first, char const * last, TFinder const & finder)
+{
+#if SEQAN_TOKENIZE_SIMD
+    for (; last - first >= 16; first += 16)
+    {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<__m128i const *>(first));
+        unsigned mask = _mm_movemask_epi8(finder.matches(x));
+        if (mask != 0u)
+            return first + popCount((mask & -mask) - 1);
+    }
+#endif  // #if SEQAN_TOKENIZE_SIMD
+    for (; first != last; ++first)
+        if (finder(*first))
+            return first;
+    return last;
+}
+
+// memchr() is vectorized by the C library already.
+inline char const *
+_findFirst(char const * first, char const * last, OneOfFinder_<1> const & finder)
+{
+    char const * ptr = static_cast<char const *>(std::memchr(first, finder.chars[0], last - first));
+    return (ptr != 0) ? ptr : last;
+}
+
+// ----------------------------------------------------------------------------
+// Function _appendChars()
+// ----------------------------------------------------------------------------
+
+// Appends the characters [first, last) to a string, with a single copy for
+// char strings.
+
+template <typename TBuffer>
+inline void
+_appendChars(TBuffer & buffer, char const * first, char const * last)
+{
+    for (; first != last; ++first)
+        appendValue(buffer, *first, Generous());
+}
+
+template <typename TSpec>
+inline void
+_appendChars(String<char, Alloc<TSpec> > & buffer, char const * first, char const * last)
+{
+    typename Size<String<char, Alloc<TSpec> > >::Type len = length(buffer);
+    resize(buffer, len + (last - first), Generous());
+    std::memcpy(begin(buffer, Standard()) + len, first, last - first);
+}
+
+inline void
+_appendChars(Nothing &, char const *, char const *)
+{}
+
+template <typename TBuffer>
+inline void
+_appendChar(TBuffer & buffer, char c)
+{
+    appendValue(buffer, c, Generous());
+}
+
+inline void
+_appendChar(Nothing &, char)
+{}
+
+}  // namespace seqan
+
+#endif  // #ifndef SEQAN_STREAM_TOKENIZE_SIMD_H_
@@ -86,6 +86,7 @@
 
 #include <seqan/system/file_sync.h>
 #include <seqan/system/file_async.h>
+#include <seqan/system/file_async_uring.h>
 #include <seqan/system/file_directory.h>
 
 #endif //#ifndef SEQAN_HEADER_...
@@ -0,0 +1,770 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Author: agent <agent@local>
+// ==========================================================================
+// Asynchronous file access based on the Linux io_uring interface.
+//
+// File<Async<IOUring> > keeps one submission/completion ring per file.
+// Requests are only written into the submission queue and handed over to the
+// kernel in batches.  Page frames allocated through the file are registered
+// with the ring and are transferred with the fixed buffer operations.  On
+// systems without io_uring, File<Async<IOUring> > is the POSIX AIO based
+// File<Async<> >.
+// ==========================================================================
+
+//SEQAN_NO_GENERATED_FORWARDS: no forwards are generated for this file
+
+#ifndef SEQAN_HEADER_FILE_ASYNC_URING_H
+#define SEQAN_HEADER_FILE_ASYNC_URING_H
+
+#if defined(__linux__) && !defined(SEQAN_HAS_IO_URING)
+#include <sys/syscall.h>
+#ifdef __NR_io_uring_setup
+#define SEQAN_HAS_IO_URING 1
+#endif  // #ifdef __NR_io_uring_setup
+#endif  // #if defined(__linux__) && !defined(SEQAN_HAS_IO_URING)
+
+#if SEQAN_HAS_IO_URING
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+// Defined by <linux/fs.h>, clashes with FileReader::BLOCK_SIZE.
+#undef BLOCK_SIZE
+#endif  // #if SEQAN_HAS_IO_URING
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Tag IOUring
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class IOUringFile
+ * @extends AsyncFile
+ * @headerfile <seqan/file.h>
+ * @brief Asynchronous file access using the Linux io_uring interface.
+ *
+ * @signature template <>
+ *            class File<Async<IOUring> >;
+ *
+ * Requests are collected in the submission queue of the file and passed to the kernel in batches.  A request is
+ * submitted immediately if no other request is in flight, such that the device never waits for the submission of a
+ * batch.  Waiting for a request submits all collected requests.
+ *
+ * The file is opened a second time with <tt>O_DIRECT</tt>.  Requests whose buffer, offset and size are multiples of
+ * the page size bypass the page cache, the others use the cached file handle.  Page frames allocated through the
+ * file are registered with the kernel and transferred without mapping them on each request.
+ *
+ * On systems without io_uring support, this is the POSIX AIO based @link AsyncFile @endlink.
+ */
+
+/**
+.Spec.IOUring File
+..cat:Files
+..general:Spec.Async
+..summary:Asynchronous file access using the Linux io_uring interface.
+..signature:File<Async<IOUring> >
+..remarks:Requests are collected in the submission queue of the file and passed to the kernel in batches.
+A request is submitted immediately if no other request is in flight, such that the device never waits for the
+submission of a batch.
+Waiting for a request submits all collected requests.
+..remarks:The file is opened a second time with $O_DIRECT$.
+Requests whose buffer, offset and size are multiples of the page size bypass the page cache, the others use the cached
+file handle.
+Page frames allocated through the file are registered with the kernel and transferred without mapping them on each
+request.
+..remarks:On systems without io_uring support, this is the POSIX AIO based @Spec.Async@ file.
+..include:seqan/file.h
+*/
+
+struct IOUring_;
+typedef Tag<IOUring_> IOUring;
+
+#if SEQAN_HAS_IO_URING
+
+// ----------------------------------------------------------------------------
+// Helper Class IOUringContext_
+// ----------------------------------------------------------------------------
+
+struct IOUringRequest_;
+
+// The mapped rings of an io_uring instance and the state of the requests.
+struct IOUringContext_
+{
+    // Number of submission queue entries, the completion queue has twice as many.
+    static const unsigned QUEUE_DEPTH = 64;
+    // Number of collected requests that are submitted at once while other requests are in flight.
+    static const unsigned SUBMIT_BATCH = 16;
+
+    int fd;
+    unsigned features;
+
+    // Submission queue.
+    void * sqRing;
+    size_t sqRingSize;
+    unsigned * sqHead;
+    unsigned * sqTail;
+    unsigned * sqArray;
+    unsigned sqMask;
+    unsigned sqEntries;
+    io_uring_sqe * sqes;
+    size_t sqesSize;
+
+    // Completion queue, shares the mapping with the submission queue if IORING_FEAT_SINGLE_MMAP is set.
+    void * cqRing;
+    size_t cqRingSize;
+    unsigned * cqHead;
+    unsigned * cqTail;
+    unsigned cqMask;
+    unsigned cqEntries;
+    io_uring_cqe * cqes;
+
+    // Number of requests in the submission queue not yet passed to the kernel and number of requests in flight.
+    unsigned numQueued;
+    unsigned numInFlight;
+
+    // The page frames allocated through the file and the buffers currently registered with the kernel.  Freed
+    // buffers are cleared in registered until the buffers are registered again.
+    String<iovec> buffers;
+    String<iovec> registered;
+    bool buffersChanged;
+    bool useFixedBuffers;
+
+    IOUringContext_() :
+        fd(-1), features(0), sqRing(MAP_FAILED), sqRingSize(0), sqHead(NULL), sqTail(NULL), sqArray(NULL), sqMask(0),
+        sqEntries(0), sqes(NULL), sqesSize(0), cqRing(MAP_FAILED), cqRingSize(0), cqHead(NULL), cqTail(NULL),
+        cqMask(0), cqEntries(0), cqes(NULL), numQueued(0), numInFlight(0), buffersChanged(false),
+        useFixedBuffers(true)
+    {}
+};
+
+// ----------------------------------------------------------------------------
+// Helper Class IOUringRequest_
+// ----------------------------------------------------------------------------
+
+// The request type of File<Async<IOUring> >.  The kernel refers to the request by its address until it completed.
+struct IOUringRequest_
+{
+    enum State
+    {
+        IDLE,       // No request issued, waiting succeeds immediately.
+        QUEUED,     // In the submission queue.
+        IN_FLIGHT,  // Passed to the kernel.
+        DONE        // Completed, result holds the number of transferred bytes or -errno.
+    };
+
+    IOUringContext_ * context;
+    iovec iov;
+    off_t offset;
+    // The file handle used for the request and the cached file handle.
+    int handle;
+    int cachedHandle;
+    bool write;
+    State state;
+    ssize_t result;
+
+    IOUringRequest_() : context(NULL), offset(0), handle(-1), cachedHandle(-1), write(false), state(IDLE), result(0)
+    {
+        iov.iov_base = NULL;
+        iov.iov_len = 0;
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Class File<Async<IOUring> >
+// ----------------------------------------------------------------------------
+
+template <>
+class File<Async<IOUring> > : public File<Sync<IOUring> >
+{
+public:
+    typedef File<Sync<IOUring> > Base;
+
+    typedef off_t   FilePtr;
+    typedef off_t   SizeType;   // type of file size
+    typedef size_t  SizeType_;  // type of transfer size (for read or write)
+    typedef int     Handle;
+
+    // The file opened with O_DIRECT, or handle if direct access is not possible.
+    Handle handleAsync;
+    IOUringContext_ * context;
+    using Base::handle;
+
+    File(void * = NULL) :   // to be compatible with the FILE*(NULL) constructor
+        handleAsync(-1), context(NULL)
+    {}
+
+    virtual ~File() {}
+
+    bool open(char const * fileName, int openMode = DefaultOpenMode<File>::VALUE);
+    bool close();
+};
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Metafunction AsyncRequest
+// ----------------------------------------------------------------------------
+
+template <>
+struct AsyncRequest<File<Async<IOUring> > >
+{
+    typedef IOUringRequest_ Type;
+};
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Helper Function _ioUringSetup()
+// ----------------------------------------------------------------------------
+
+// Create the ring and map its queues.  Returns false if io_uring is not available, e.g. on kernels before 5.1 or if
+// it is disabled.
+inline bool _ioUringSetup(IOUringContext_ & ctx)
+{
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    ctx.fd = syscall(__NR_io_uring_setup, IOUringContext_::QUEUE_DEPTH, &params);
+    if (ctx.fd < 0)
+        return false;
+    ctx.features = params.features;
+
+    ctx.sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ctx.cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    if (ctx.features & IORING_FEAT_SINGLE_MMAP)
+        ctx.sqRingSize = ctx.cqRingSize = _max(ctx.sqRingSize, ctx.cqRingSize);
+
+    ctx.sqRing = mmap(NULL, ctx.sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ctx.fd,
+                      IORING_OFF_SQ_RING);
+    if (ctx.sqRing == MAP_FAILED)
+        return false;
+    if (ctx.features & IORING_FEAT_SINGLE_MMAP)
+        ctx.cqRing = ctx.sqRing;
+    else
+        ctx.cqRing = mmap(NULL, ctx.cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ctx.fd,
+                          IORING_OFF_CQ_RING);
+    if (ctx.cqRing == MAP_FAILED)
+        return false;
+
+    ctx.sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void * sqes = mmap(NULL, ctx.sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ctx.fd,
+                       IORING_OFF_SQES);
+    if (sqes == MAP_FAILED)
+        return false;
+    ctx.sqes = static_cast<io_uring_sqe *>(sqes);
+
+    char * sqRing = static_cast<char *>(ctx.sqRing);
+    ctx.sqHead = reinterpret_cast<unsigned *>(sqRing + params.sq_off.head);
+    ctx.sqTail = reinterpret_cast<unsigned *>(sqRing + params.sq_off.tail);
+    ctx.sqArray = reinterpret_cast<unsigned *>(sqRing + params.sq_off.array);
+    ctx.sqMask = *reinterpret_cast<unsigned *>(sqRing + params.sq_off.ring_mask);
+    ctx.sqEntries = params.sq_entries;
+
+    char * cqRing = static_cast<char *>(ctx.cqRing);
+    ctx.cqHead = reinterpret_cast<unsigned *>(cqRing + params.cq_off.head);
+    ctx.cqTail = reinterpret_cast<unsigned *>(cqRing + params.cq_off.tail);
+    ctx.cqMask = *reinterpret_cast<unsigned *>(cqRing + params.cq_off.ring_mask);
+    ctx.cqEntries = params.cq_entries;
+    ctx.cqes = reinterpret_cast<io_uring_cqe *>(cqRing + params.cq_off.cqes);
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _ioUringTeardown()
+// ----------------------------------------------------------------------------
+
+inline void _ioUringTeardown(IOUringContext_ & ctx)
+{
+    if (ctx.sqes != NULL)
+        munmap(ctx.sqes, ctx.sqesSize);
+    if (ctx.cqRing != MAP_FAILED && ctx.cqRing != ctx.sqRing)
+        munmap(ctx.cqRing, ctx.cqRingSize);
+    if (ctx.sqRing != MAP_FAILED)
+        munmap(ctx.sqRing, ctx.sqRingSize);
+    if (ctx.fd >= 0)
+        ::close(ctx.fd);
+    ctx.fd = -1;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _ioUringReap()
+// ----------------------------------------------------------------------------
+
+// Mark the requests in the completion queue as done.
+inline void _ioUringReap(IOUringContext_ & ctx)
+{
+    unsigned head = *ctx.cqHead;
+    unsigned tail = __atomic_load_n(ctx.cqTail, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head)
+    {
+        io_uring_cqe const & cqe = ctx.cqes[head & ctx.cqMask];
+        --ctx.numInFlight;
+        // Cancel requests have no request attached.
+        if (cqe.user_data == 0)
+            continue;
+        IOUringRequest_ & request = *reinterpret_cast<IOUringRequest_ *>(static_cast<uintptr_t>(cqe.user_data));
+        request.result = cqe.res;
+        request.state = IOUringRequest_::DONE;
+    }
+    __atomic_store_n(ctx.cqHead, head, __ATOMIC_RELEASE);
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _ioUringEnter()
+// ----------------------------------------------------------------------------
+
+// Pass the queued requests to the kernel and reap completed requests.  If wait is true, block until at least one
+// request completed.
+inline bool _ioUringEnter(IOUringContext_ & ctx, bool wait, long timeoutMilliSec = -1)
+{
+    // The completion queue is shared memory, polling it needs no system call.
+    if (!wait && ctx.numQueued == 0)
+    {
+        _ioUringReap(ctx);
+        return true;
+    }
+
+    unsigned flags = wait ? IORING_ENTER_GETEVENTS : 0;
+    void * arg = NULL;
+    size_t argSize = 0;
+#ifdef IORING_ENTER_EXT_ARG
+    __kernel_timespec ts;
+    io_uring_getevents_arg eventsArg;
+    if (wait && timeoutMilliSec >= 0 && (ctx.features & IORING_FEAT_EXT_ARG))
+    {
+        ts.tv_sec = timeoutMilliSec / 1000;
+        ts.tv_nsec = (timeoutMilliSec % 1000) * 1000000;
+        memset(&eventsArg, 0, sizeof(eventsArg));
+        eventsArg.ts = reinterpret_cast<uintptr_t>(&ts);
+        flags |= IORING_ENTER_EXT_ARG;
+        arg = &eventsArg;
+        argSize = sizeof(eventsArg);
+    }
+#else
+    (void)timeoutMilliSec;
+#endif  // #ifdef IORING_ENTER_EXT_ARG
+
+    SEQAN_PROTIMESTART(tw);
+    int result = syscall(__NR_io_uring_enter, ctx.fd, ctx.numQueued, wait ? 1 : 0, flags, arg, argSize);
+    SEQAN_PROADD(SEQAN_PROCWAIT, SEQAN_PROTIMEDIFF(tw));
+
+    if (result >= 0)
+    {
+        ctx.numQueued -= result;
+        ctx.numInFlight += result;
+    }
+    _ioUringReap(ctx);
+    return result >= 0 || errno == EINTR || errno == ETIME || errno == EAGAIN || errno == EBUSY;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _ioUringRegisterBuffers()
+// ----------------------------------------------------------------------------
+
+// Register the page frames with the kernel.  This is only done if no request is in flight, as requests may refer to
+// the registered buffers.
+inline void _ioUringRegisterBuffers(IOUringContext_ & ctx)
+{
+    if (!ctx.buffersChanged || !ctx.useFixedBuffers || ctx.numQueued != 0 || ctx.numInFlight != 0)
+        return;
+
+    if (!empty(ctx.registered))
+        syscall(__NR_io_uring_register, ctx.fd, IORING_UNREGISTER_BUFFERS, NULL, 0);
+    clear(ctx.registered);
+    ctx.buffersChanged = false;
+    if (empty(ctx.buffers))
+        return;
+
+    // Registering fails if the buffers exceed the locked memory limit, requests then use unregistered buffers.
+    if (syscall(__NR_io_uring_register, ctx.fd, IORING_REGISTER_BUFFERS, &ctx.buffers[0], length(ctx.buffers)) == 0)
+        ctx.registered = ctx.buffers;
+    else
+        ctx.useFixedBuffers = false;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _ioUringQueue()
+// ----------------------------------------------------------------------------
+
+// Write a request into the submission queue.  The request is passed to the kernel immediately if no other request is
+// in flight or if a batch is complete.
+inline bool _ioUringQueue(IOUringContext_ & ctx, IOUringRequest_ & request)
+{
+    // Make room in the submission queue and keep the requests in flight below the size of the completion queue.
+    while (ctx.numQueued == ctx.sqEntries || ctx.numQueued + ctx.numInFlight >= ctx.cqEntries)
+        if (!_ioUringEnter(ctx, ctx.numQueued < ctx.sqEntries))
+            return false;
+
+    _ioUringRegisterBuffers(ctx);
+
+    unsigned tail = *ctx.sqTail;
+    unsigned index = tail & ctx.sqMask;
+    io_uring_sqe & sqe = ctx.sqes[index];
+    memset(&sqe, 0, sizeof(sqe));
+
+    // Use a registered buffer if the request lies within one.
+    unsigned bufIndex = 0;
+    char * base = static_cast<char *>(request.iov.iov_base);
+    for (; bufIndex < length(ctx.registered); ++bufIndex)
+    {
+        char * bufBegin = static_cast<char *>(ctx.registered[bufIndex].iov_base);
+        if (bufBegin <= base && base + request.iov.iov_len <= bufBegin + ctx.registered[bufIndex].iov_len)
+            break;
+    }
+    if (bufIndex < length(ctx.registered))
+    {
+        sqe.opcode = request.write ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+        sqe.addr = reinterpret_cast<uintptr_t>(request.iov.iov_base);
+        sqe.len = request.iov.iov_len;
+        sqe.buf_index = bufIndex;
+    }
+    else
+    {
+        sqe.opcode = request.write ? IORING_OP_WRITEV : IORING_OP_READV;
+        sqe.addr = reinterpret_cast<uintptr_t>(&request.iov);
+        sqe.len = 1;
+    }
+    sqe.fd = request.handle;
+    sqe.off = request.offset;
+    sqe.user_data = reinterpret_cast<uintptr_t>(&request);
+
+    ctx.sqArray[index] = index;
+    __atomic_store_n(ctx.sqTail, tail + 1, __ATOMIC_RELEASE);
+    ++ctx.numQueued;
+    request.state = IOUringRequest_::QUEUED;
+
+    if (ctx.numInFlight == 0 || ctx.numQueued >= IOUringContext_::SUBMIT_BATCH)
+        return _ioUringEnter(ctx, false);
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _ioUringQueueCancel()
+// ----------------------------------------------------------------------------
+
+// Ask the kernel to cancel a request in flight.
+inline bool _ioUringQueueCancel(IOUringContext_ & ctx, IOUringRequest_ & request)
+{
+    while (ctx.numQueued == ctx.sqEntries || ctx.numQueued + ctx.numInFlight >= ctx.cqEntries)
+        if (!_ioUringEnter(ctx, ctx.numQueued < ctx.sqEntries))
+            return false;
+
+    unsigned tail = *ctx.sqTail;
+    unsigned index = tail & ctx.sqMask;
+    io_uring_sqe & sqe = ctx.sqes[index];
+    memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = IORING_OP_ASYNC_CANCEL;
+    sqe.fd = -1;
+    sqe.addr = reinterpret_cast<uintptr_t>(&request);
+    sqe.user_data = 0;
+
+    ctx.sqArray[index] = index;
+    __atomic_store_n(ctx.sqTail, tail + 1, __ATOMIC_RELEASE);
+    ++ctx.numQueued;
+    return _ioUringEnter(ctx, false);
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _ioUringFinish()
+// ----------------------------------------------------------------------------
+
+// Check the result of a completed request.  Transfers cut short by the kernel are completed synchronously.
+inline bool _ioUringFinish(IOUringRequest_ & request)
+{
+    while (request.result > 0 && static_cast<size_t>(request.result) < request.iov.iov_len)
+    {
+        char * buffer = static_cast<char *>(request.iov.iov_base) + request.result;
+        size_t count = request.iov.iov_len - request.result;
+        off_t offset = request.offset + request.result;
+        // The rest need not be aligned, therefore the cached file handle is used.
+        int handle = request.cachedHandle;
+        ssize_t res = request.write ? ::pwrite(handle, buffer, count, offset) : ::pread(handle, buffer, count, offset);
+        if (res <= 0)
+            break;
+        request.result += res;
+    }
+
+    if (request.result != static_cast<ssize_t>(request.iov.iov_len))
+    {
+        int errorNo = request.result < 0 ? -request.result : EIO;
+        std::cerr << "Asynchronous I/O operation failed (waitFor): \"" << ::strerror(errorNo) << '"' << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _ioUringIssue()
+// ----------------------------------------------------------------------------
+
+inline bool _ioUringIssue(File<Async<IOUring> > & me, void * buffer, size_t count, off_t fileOfs, bool write,
+                          IOUringRequest_ & request)
+{
+    request.context = me.context;
+    request.iov.iov_base = buffer;
+    request.iov.iov_len = count;
+    request.offset = fileOfs;
+    request.write = write;
+    request.result = 0;
+    request.state = IOUringRequest_::IDLE;
+    if (count == 0)
+        return true;
+    SEQAN_PROADD(SEQAN_PROIO, (count + SEQAN_PROPAGESIZE - 1) / SEQAN_PROPAGESIZE);
+
+    // O_DIRECT requires aligned buffers, offsets and sizes.
+    size_t pageSize = sysconf(_SC_PAGESIZE);
+    bool aligned = (reinterpret_cast<uintptr_t>(buffer) % pageSize) == 0 && (fileOfs % pageSize) == 0 &&
+                   (count % pageSize) == 0;
+    request.handle = aligned ? me.handleAsync : me.handle;
+    request.cachedHandle = me.handle;
+
+    if (me.context != NULL && _ioUringQueue(*me.context, request))
+        return true;
+
+    // Fall back to synchronous access if the request could not be queued.
+    request.handle = me.handle;
+    request.result = write ? ::pwrite(me.handle, buffer, count, fileOfs) : ::pread(me.handle, buffer, count, fileOfs);
+    request.state = IOUringRequest_::DONE;
+    return request.result == static_cast<ssize_t>(count);
+}
+
+// ----------------------------------------------------------------------------
+// Function File<Async<IOUring> >::open()
+// ----------------------------------------------------------------------------
+
+inline bool File<Async<IOUring> >::open(char const * fileName, int openMode)
+{
+    handle = ::open(fileName, Base::_getOFlag(openMode & ~OPEN_ASYNC),
+                    S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH);
+    if (handle == -1)
+    {
+        handleAsync = handle;
+        if (!(openMode & OPEN_QUIET))
+            std::cerr << "Open failed on file " << fileName << ": \"" << ::strerror(errno) << '"' << std::endl;
+        return false;
+    }
+
+    // Open the file a second time for direct access, it must not be truncated again.
+    handleAsync = ::open(fileName, Base::_getOFlag((openMode | OPEN_APPEND) & ~(OPEN_ASYNC | OPEN_CREATE)) | O_DIRECT,
+                         S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH);
+    if (handleAsync == -1)  // fall back to cached access, e.g. on tmpfs
+        handleAsync = handle;
+
+    context = new IOUringContext_;
+    if (!_ioUringSetup(*context))
+    {
+#if SEQAN_ENABLE_DEBUG || SEQAN_ENABLE_TESTING
+        if (!(openMode & OPEN_QUIET))
+            std::cerr << "Warning: io_uring setup failed, using synchronous access. \"" << ::strerror(errno) << '"'
+                      << std::endl;
+#endif
+        _ioUringTeardown(*context);
+        delete context;
+        context = NULL;
+    }
+
+    SEQAN_PROADD(SEQAN_PROOPENFILES, 1);
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Function File<Async<IOUring> >::close()
+// ----------------------------------------------------------------------------
+
+inline bool File<Async<IOUring> >::close()
+{
+    bool result = true;
+    if (context != NULL)
+    {
+        // Wait for all requests, they refer to the context.
+        while (context->numQueued != 0 || context->numInFlight != 0)
+            if (!_ioUringEnter(*context, context->numQueued == 0))
+            {
+                result = false;
+                break;
+            }
+        _ioUringTeardown(*context);
+        delete context;
+        context = NULL;
+    }
+    if (handleAsync != handle && handleAsync != -1)
+        result &= (::close(handleAsync) == 0);
+    result &= (::close(handle) == 0);
+    handleAsync = -1;
+    handle = -1;
+    SEQAN_PROSUB(SEQAN_PROOPENFILES, 1);
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+// Function asyncReadAt()
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSize, typename TPos>
+inline bool asyncReadAt(File<Async<IOUring> > & me, TValue * memPtr, TSize const count, TPos const fileOfs,
+                        IOUringRequest_ & request)
+{
+    return _ioUringIssue(me, memPtr, count * sizeof(TValue), static_cast<off_t>(fileOfs) * sizeof(TValue), false,
+                         request);
+}
+
+// ----------------------------------------------------------------------------
+// Function asyncWriteAt()
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSize, typename TPos>
+inline bool asyncWriteAt(File<Async<IOUring> > & me, TValue const * memPtr, TSize const count, TPos const fileOfs,
+                         IOUringRequest_ & request)
+{
+    return _ioUringIssue(me, const_cast<TValue *>(memPtr), count * sizeof(TValue),
+                         static_cast<off_t>(fileOfs) * sizeof(TValue), true, request);
+}
+
+// ----------------------------------------------------------------------------
+// Function waitFor()
+// ----------------------------------------------------------------------------
+
+inline bool waitFor(IOUringRequest_ & request)
+{
+    while (request.state == IOUringRequest_::QUEUED || request.state == IOUringRequest_::IN_FLIGHT)
+        if (!_ioUringEnter(*request.context, request.state == IOUringRequest_::IN_FLIGHT))
+            return false;
+    if (request.state == IOUringRequest_::IDLE)
+        return true;
+    return _ioUringFinish(request);
+}
+
+inline bool waitFor(IOUringRequest_ & request, long timeoutMilliSec, bool & inProgress)
+{
+    if (request.state == IOUringRequest_::QUEUED || request.state == IOUringRequest_::IN_FLIGHT)
+    {
+        // Submit the request and poll for its completion.
+        if (!_ioUringEnter(*request.context, false))
+            return false;
+        if (timeoutMilliSec != 0 && request.state != IOUringRequest_::DONE)
+            if (!_ioUringEnter(*request.context, request.state == IOUringRequest_::IN_FLIGHT, timeoutMilliSec))
+                return false;
+    }
+
+    inProgress = (request.state == IOUringRequest_::QUEUED || request.state == IOUringRequest_::IN_FLIGHT);
+    if (inProgress || request.state == IOUringRequest_::IDLE)
+        return true;
+    return _ioUringFinish(request);
+}
+
+// ----------------------------------------------------------------------------
+// Function cancel()
+// ----------------------------------------------------------------------------
+
+// The buffer of a cancelled request may be freed afterwards, therefore this waits until the kernel released it.
+inline bool cancel(File<Async<IOUring> > & /*me*/, IOUringRequest_ & request)
+{
+    if (request.state != IOUringRequest_::QUEUED && request.state != IOUringRequest_::IN_FLIGHT)
+        return true;
+    if (request.state == IOUringRequest_::QUEUED && !_ioUringEnter(*request.context, false))
+        return false;
+    if (request.state == IOUringRequest_::IN_FLIGHT)
+        _ioUringQueueCancel(*request.context, request);
+    while (request.state == IOUringRequest_::IN_FLIGHT)
+        if (!_ioUringEnter(*request.context, true))
+            return false;
+    request.state = IOUringRequest_::IDLE;
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Function release()
+// ----------------------------------------------------------------------------
+
+inline void release(File<Async<IOUring> > & /*me*/, IOUringRequest_ & /*request*/)
+{}
+
+// ----------------------------------------------------------------------------
+// Function allocate()
+// ----------------------------------------------------------------------------
+
+// Page frames are allocated page aligned and registered with the ring of the file.
+template <typename TValue, typename TSize>
+inline void allocate(File<Async<IOUring> > const & me, TValue * & data, TSize count)
+{
+    allocate(me, data, count, TagAllocateAligned());
+    if (data == NULL || me.context == NULL || !me.context->useFixedBuffers)
+        return;
+
+    iovec buffer;
+    buffer.iov_base = data;
+    buffer.iov_len = count * sizeof(TValue);
+    appendValue(me.context->buffers, buffer);
+    me.context->buffersChanged = true;
+}
+
+// ----------------------------------------------------------------------------
+// Function deallocate()
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSize>
+inline void deallocate(File<Async<IOUring> > const & me, TValue * data, TSize count)
+{
+    if (data != NULL && me.context != NULL)
+    {
+        // The memory may be reused before the buffers are registered again.
+        for (unsigned i = 0; i < length(me.context->registered); ++i)
+            if (me.context->registered[i].iov_base == data)
+                me.context->registered[i].iov_len = 0;
+        for (unsigned i = 0; i < length(me.context->buffers); ++i)
+            if (me.context->buffers[i].iov_base == data)
+            {
+                erase(me.context->buffers, i);
+                me.context->buffersChanged = true;
+                break;
+            }
+    }
+    deallocate(me, data, count, TagAllocateAligned());
+}
+
+#endif  // #if SEQAN_HAS_IO_URING
+
+}  // namespace seqan
+
+#endif  // #ifndef SEQAN_HEADER_FILE_ASYNC_URING_H
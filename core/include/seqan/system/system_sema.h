@@ -107,7 +107,7 @@ namespace SEQAN_NAMESPACE_MAIN
         }
 
         ~Semaphore() {
-            bool res = sem_destroy(hSemaphore);
+            bool res = !sem_destroy(hSemaphore);
             (void)res;  // Only used in assertion.
             SEQAN_ASSERT(res);
         }
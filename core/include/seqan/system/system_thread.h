@@ -58,10 +58,12 @@ namespace SEQAN_NAMESPACE_MAIN
         DWORD  hThreadID;
         Worker worker;
 
-        Thread() {}
+        Thread():
+            hThread(NULL) {}
 
         template <typename TArg>
         Thread(TArg &arg):
+            hThread(NULL),
             worker(arg) {}
 
         ~Thread() {
@@ -107,7 +109,7 @@ namespace SEQAN_NAMESPACE_MAIN
         }
 
         static DWORD WINAPI _start(LPVOID _this) {
-            reinterpret_cast<Thread*>(_this)->worker.run(&reinterpret_cast<Thread*>(_this));
+            reinterpret_cast<Thread*>(_this)->worker.run(reinterpret_cast<Thread*>(_this));
 			return 0;	// return value should indicate success/failure
         }
     };
@@ -123,10 +125,12 @@ namespace SEQAN_NAMESPACE_MAIN
         pthread_t data, *hThread;
         Worker worker;
 
-        Thread() {}
+        Thread():
+            hThread(NULL) {}
 
         template <typename TArg>
         Thread(TArg &arg):
+            hThread(NULL),
             worker(arg) {}
 
         ~Thread() {
@@ -153,11 +157,15 @@ namespace SEQAN_NAMESPACE_MAIN
         }
 
         inline bool wait() {
-            return !(pthread_join(data, NULL));
+            void *retVal;
+            return wait(retVal);
         }
 
         inline bool wait(void* &retVal) {
-            return !(pthread_join(data, &retVal));
+            // a joined thread must neither be cancelled nor joined again
+            if (pthread_join(data, &retVal)) return false;
+            hThread = NULL;
+            return true;
         }
 
         inline bool detach() {
@@ -176,7 +184,7 @@ namespace SEQAN_NAMESPACE_MAIN
         }
 
         static void* _start(void* _this) {
-            reinterpret_cast<Thread*>(_this)->worker.run(&reinterpret_cast<Thread*>(_this));
+            reinterpret_cast<Thread*>(_this)->worker.run(reinterpret_cast<Thread*>(_this));
 			return 0;
         }
     };
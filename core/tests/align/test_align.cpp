@@ -56,6 +56,8 @@
 #include "test_alignment_algorithms_global_banded.h"
 #include "test_alignment_algorithms_local.h"
 #include "test_alignment_algorithms_local_banded.h"
+#include "test_alignment_algorithms_batch.h"
+#include "test_alignment_algorithms_local_striped.h"
 #include "test_align_global_alignment_specialized.h"
 
 #include "test_align_alignment_operations.h"
@@ -490,6 +492,14 @@ SEQAN_BEGIN_TESTSUITE(test_align)
     SEQAN_CALL_TEST(test_alignment_algorithms_graph_local_affine);
     SEQAN_CALL_TEST(test_alignment_algorithms_fragments_local_affine);
 
+    // Batch Alignment.
+    SEQAN_CALL_TEST(test_alignment_algorithms_batch_global);
+    SEQAN_CALL_TEST(test_alignment_algorithms_batch_local);
+
+    // Striped Smith-Waterman.
+    SEQAN_CALL_TEST(test_alignment_algorithms_local_striped_score_matrix);
+    SEQAN_CALL_TEST(test_alignment_algorithms_local_striped_simple);
+
     // Suboptimal Alignment.
 
     // This is working on the old  module - should be replaced by the new module at some stage.
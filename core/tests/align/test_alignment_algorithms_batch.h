@@ -0,0 +1,282 @@
+// ==========================================================================
+//                     test_alignment_algorithms_batch.h
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Author: agent <agent@local>
+// ==========================================================================
+// Tests for the batch interfaces of globalAlignment() and localAlignment()
+// that align many pairs at once using the SIMD kernel.
+// ==========================================================================
+
+#ifndef CORE_TESTS_ALIGN_TEST_ALIGNMENT_ALGORITHMS_BATCH_H_
+#define CORE_TESTS_ALIGN_TEST_ALIGNMENT_ALGORITHMS_BATCH_H_
+
+#include <seqan/basic.h>
+#include <seqan/align.h>
+
+// Fills the sets with count random pairs whose lengths are drawn from [minLength, maxLength].
+// Every third vertical sequence is a mutated copy of the horizontal one, so the pairs have
+// alignments with positive and negative scores.
+template <typename TString>
+void testAlignBatchRandomPairs(seqan::StringSet<TString> & setH,
+                               seqan::StringSet<TString> & setV,
+                               unsigned count,
+                               unsigned minLength,
+                               unsigned maxLength,
+                               unsigned seed)
+{
+    using namespace seqan;
+    typedef typename Value<TString>::Type TAlphabet;
+
+    unsigned const alphSize = ValueSize<TAlphabet>::VALUE;
+    unsigned state = seed;
+    for (unsigned k = 0; k < count; ++k)
+    {
+        TString strH, strV;
+        state = state * 1103515245u + 12345u;
+        unsigned lenH = minLength + (state >> 8) % (maxLength - minLength + 1);
+        state = state * 1103515245u + 12345u;
+        unsigned lenV = minLength + (state >> 8) % (maxLength - minLength + 1);
+        for (unsigned i = 0; i < lenH; ++i)
+        {
+            state = state * 1103515245u + 12345u;
+            appendValue(strH, TAlphabet((state >> 8) % alphSize));
+        }
+        for (unsigned i = 0; i < lenV; ++i)
+        {
+            state = state * 1103515245u + 12345u;
+            if (k % 3 == 0 && i < lenH && (state >> 8) % 8 != 0)
+                appendValue(strV, strH[i]);
+            else
+                appendValue(strV, TAlphabet((state >> 8) % alphSize));
+        }
+        appendValue(setH, strH);
+        appendValue(setV, strV);
+    }
+}
+
+// Recomputes the score of an alignment from its rows.
+template <typename TSequence, typename TAlignSpec, typename TScoreValue, typename TScoreSpec>
+TScoreValue testAlignBatchScoreOfAlign(seqan::Align<TSequence, TAlignSpec> & align,
+                                       seqan::Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                                       bool freeLeadingH, bool freeLeadingV, bool freeTrailingH, bool freeTrailingV)
+{
+    using namespace seqan;
+    typedef typename Row<Align<TSequence, TAlignSpec> >::Type TRow;
+    typedef typename Iterator<TRow, Standard>::Type TIter;
+
+    TRow & rowH = row(align, 0);
+    TRow & rowV = row(align, 1);
+    SEQAN_ASSERT_EQ(length(rowH), length(rowV));
+
+    TScoreValue result = 0;
+    bool gapOpenH = false, gapOpenV = false;
+    unsigned col = 0, len = length(rowH);
+    unsigned firstH = len, firstV = len, lastH = 0, lastV = 0;
+    for (TIter it = begin(rowH, Standard()); it != end(rowH, Standard()); ++it, ++col)
+        if (!isGap(it))
+        {
+            firstH = std::min(firstH, col);
+            lastH = col + 1;
+        }
+    col = 0;
+    for (TIter it = begin(rowV, Standard()); it != end(rowV, Standard()); ++it, ++col)
+        if (!isGap(it))
+        {
+            firstV = std::min(firstV, col);
+            lastV = col + 1;
+        }
+
+    TIter itH = begin(rowH, Standard());
+    TIter itV = begin(rowV, Standard());
+    for (col = 0; col < len; ++col, ++itH, ++itV)
+    {
+        if (isGap(itH) && isGap(itV))
+            continue;
+        if (isGap(itH))
+        {
+            bool isFree = (freeLeadingH && col < firstH) || (freeTrailingH && col >= lastH);
+            if (!isFree)
+                result += gapOpenH ? scoreGapExtend(scoringScheme) : scoreGapOpen(scoringScheme);
+            gapOpenH = true;
+            gapOpenV = false;
+        }
+        else if (isGap(itV))
+        {
+            bool isFree = (freeLeadingV && col < firstV) || (freeTrailingV && col >= lastV);
+            if (!isFree)
+                result += gapOpenV ? scoreGapExtend(scoringScheme) : scoreGapOpen(scoringScheme);
+            gapOpenV = true;
+            gapOpenH = false;
+        }
+        else
+        {
+            result += score(scoringScheme, *itH, *itV);
+            gapOpenH = gapOpenV = false;
+        }
+    }
+    return result;
+}
+
+template <typename TString, typename TScore, typename TAlignConfig>
+void testAlignBatchGlobal(seqan::StringSet<TString> const & setH,
+                          seqan::StringSet<TString> const & setV,
+                          TScore const & scoringScheme,
+                          TAlignConfig const & alignConfig,
+                          bool top, bool left, bool right, bool bottom)
+{
+    using namespace seqan;
+    typedef typename Value<TScore>::Type TScoreValue;
+
+    String<TScoreValue> scores = globalAlignmentScore(setH, setV, scoringScheme, alignConfig);
+    SEQAN_ASSERT_EQ(length(scores), length(setH));
+    for (unsigned k = 0; k < length(setH); ++k)
+        SEQAN_ASSERT_EQ(scores[k], globalAlignmentScore(setH[k], setV[k], scoringScheme, alignConfig));
+
+    StringSet<Align<TString> > aligns;
+    resize(aligns, length(setH));
+    for (unsigned k = 0; k < length(setH); ++k)
+    {
+        resize(rows(aligns[k]), 2);
+        assignSource(row(aligns[k], 0), setH[k]);
+        assignSource(row(aligns[k], 1), setV[k]);
+    }
+    String<TScoreValue> alignScores = globalAlignment(aligns, scoringScheme, alignConfig);
+    SEQAN_ASSERT(alignScores == scores);
+    for (unsigned k = 0; k < length(setH); ++k)
+    {
+        // A leading gap in the horizontal row is free if there are 0's in the left column.
+        SEQAN_ASSERT_EQ(testAlignBatchScoreOfAlign(aligns[k], scoringScheme, left, top, right, bottom), scores[k]);
+        SEQAN_ASSERT_EQ(beginPosition(row(aligns[k], 0)), 0u);
+        SEQAN_ASSERT_EQ(beginPosition(row(aligns[k], 1)), 0u);
+        SEQAN_ASSERT_EQ(endPosition(row(aligns[k], 0)), length(setH[k]));
+        SEQAN_ASSERT_EQ(endPosition(row(aligns[k], 1)), length(setV[k]));
+    }
+}
+
+template <typename TString, typename TScore>
+void testAlignBatchLocal(seqan::StringSet<TString> const & setH,
+                         seqan::StringSet<TString> const & setV,
+                         TScore const & scoringScheme)
+{
+    using namespace seqan;
+    typedef typename Value<TScore>::Type TScoreValue;
+
+    String<TScoreValue> scores = localAlignmentScore(setH, setV, scoringScheme);
+    SEQAN_ASSERT_EQ(length(scores), length(setH));
+
+    StringSet<Align<TString> > aligns;
+    resize(aligns, length(setH));
+    for (unsigned k = 0; k < length(setH); ++k)
+    {
+        resize(rows(aligns[k]), 2);
+        assignSource(row(aligns[k], 0), setH[k]);
+        assignSource(row(aligns[k], 1), setV[k]);
+    }
+    String<TScoreValue> alignScores = localAlignment(aligns, scoringScheme);
+    SEQAN_ASSERT(alignScores == scores);
+
+    for (unsigned k = 0; k < length(setH); ++k)
+    {
+        Align<TString> align;
+        resize(rows(align), 2);
+        assignSource(row(align, 0), setH[k]);
+        assignSource(row(align, 1), setV[k]);
+        SEQAN_ASSERT_EQ(scores[k], localAlignment(align, scoringScheme));
+        SEQAN_ASSERT_EQ(testAlignBatchScoreOfAlign(aligns[k], scoringScheme, false, false, false, false), scores[k]);
+    }
+}
+
+SEQAN_DEFINE_TEST(test_alignment_algorithms_batch_global)
+{
+    using namespace seqan;
+
+    StringSet<DnaString> setH, setV;
+    testAlignBatchRandomPairs(setH, setV, 70, 1, 40, 1);
+    // Pairs too long for 8 bit lanes.
+    testAlignBatchRandomPairs(setH, setV, 20, 100, 300, 2);
+
+    Score<int, Simple> linear(2, -1, -2);
+    Score<int, Simple> affine(1, -3, -1, -5);
+    for (unsigned i = 0; i < 2; ++i)
+    {
+        Score<int, Simple> const & sc = (i == 0) ? linear : affine;
+        testAlignBatchGlobal(setH, setV, sc, AlignConfig<>(), false, false, false, false);
+        testAlignBatchGlobal(setH, setV, sc, AlignConfig<true, false, false, false>(), true, false, false, false);
+        testAlignBatchGlobal(setH, setV, sc, AlignConfig<false, true, false, false>(), false, true, false, false);
+        testAlignBatchGlobal(setH, setV, sc, AlignConfig<false, false, true, false>(), false, false, true, false);
+        testAlignBatchGlobal(setH, setV, sc, AlignConfig<false, false, false, true>(), false, false, false, true);
+        testAlignBatchGlobal(setH, setV, sc, AlignConfig<true, true, true, true>(), true, true, true, true);
+        testAlignBatchGlobal(setH, setV, sc, AlignConfig<true, false, true, false>(), true, false, true, false);
+    }
+
+    // Pairs too long for 16 bit lanes are aligned with the scalar DP.
+    StringSet<DnaString> longH, longV;
+    testAlignBatchRandomPairs(longH, longV, 3, 1700, 1800, 3);
+    testAlignBatchRandomPairs(longH, longV, 5, 10, 20, 4);
+    testAlignBatchGlobal(longH, longV, Score<int, Simple>(1, -10, -10), AlignConfig<>(), false, false, false, false);
+
+    // Char strings only fit into 16 bit lanes.
+    StringSet<CharString> charH, charV;
+    testAlignBatchRandomPairs(charH, charV, 40, 1, 30, 5);
+    testAlignBatchGlobal(charH, charV, affine, AlignConfig<>(), false, false, false, false);
+
+    // Empty batch.
+    StringSet<DnaString> emptySet;
+    SEQAN_ASSERT(empty(globalAlignmentScore(emptySet, emptySet, linear)));
+}
+
+SEQAN_DEFINE_TEST(test_alignment_algorithms_batch_local)
+{
+    using namespace seqan;
+
+    StringSet<Dna5String> setH, setV;
+    testAlignBatchRandomPairs(setH, setV, 70, 1, 40, 6);
+    testAlignBatchRandomPairs(setH, setV, 20, 100, 300, 7);
+
+    testAlignBatchLocal(setH, setV, Score<int, Simple>(2, -1, -2));
+    testAlignBatchLocal(setH, setV, Score<int, Simple>(2, -3, -1, -5));
+
+    // Scoring schemes not supported by the kernel fall back to the scalar DP.
+    StringSet<Peptide> pepH, pepV;
+    testAlignBatchRandomPairs(pepH, pepV, 10, 5, 30, 8);
+    Blosum62 blosum(-1, -11);
+    String<int> scores = localAlignmentScore(pepH, pepV, blosum);
+    for (unsigned k = 0; k < length(pepH); ++k)
+    {
+        Align<Peptide> align;
+        resize(rows(align), 2);
+        assignSource(row(align, 0), pepH[k]);
+        assignSource(row(align, 1), pepV[k]);
+        SEQAN_ASSERT_EQ(scores[k], localAlignment(align, blosum));
+    }
+}
+
+#endif  // #ifndef CORE_TESTS_ALIGN_TEST_ALIGNMENT_ALGORITHMS_BATCH_H_
@@ -0,0 +1,113 @@
+// ==========================================================================
+//                  test_alignment_algorithms_local_striped.h
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Author: agent <agent@local>
+// ==========================================================================
+// Tests for the striped SIMD Smith-Waterman algorithm.  The scores are
+// compared to the standard Smith-Waterman algorithm, the alignments are
+// rescored since another alignment of the same score may be returned.
+// ==========================================================================
+
+#ifndef CORE_TESTS_ALIGN_TEST_ALIGNMENT_ALGORITHMS_LOCAL_STRIPED_H_
+#define CORE_TESTS_ALIGN_TEST_ALIGNMENT_ALGORITHMS_LOCAL_STRIPED_H_
+
+#include <seqan/basic.h>
+#include <seqan/align.h>
+
+#include "test_alignment_algorithms_batch.h"
+
+template <typename TString, typename TScore>
+void testAlignStripedLocal(seqan::StringSet<TString> const & setH,
+                           seqan::StringSet<TString> const & setV,
+                           TScore const & scoringScheme)
+{
+    using namespace seqan;
+    typedef typename Value<TScore>::Type TScoreValue;
+
+    for (unsigned k = 0; k < length(setH); ++k)
+    {
+        TScoreValue score = localAlignmentScore(setH[k], setV[k], scoringScheme);
+        SEQAN_ASSERT_EQ(localAlignmentScore(setH[k], setV[k], scoringScheme, SmithWatermanStriped()), score);
+
+        Align<TString> align;
+        resize(rows(align), 2);
+        assignSource(row(align, 0), setH[k]);
+        assignSource(row(align, 1), setV[k]);
+        SEQAN_ASSERT_EQ(localAlignment(align, scoringScheme, SmithWatermanStriped()), score);
+        SEQAN_ASSERT_EQ(testAlignBatchScoreOfAlign(align, scoringScheme, false, false, false, false), score);
+
+        TString seqH = setH[k];
+        TString seqV = setV[k];
+        Gaps<TString> gapsH(seqH);
+        Gaps<TString> gapsV(seqV);
+        SEQAN_ASSERT_EQ(localAlignment(gapsH, gapsV, scoringScheme, SmithWatermanStriped()), score);
+        SEQAN_ASSERT_EQ(beginPosition(gapsH), beginPosition(row(align, 0)));
+        SEQAN_ASSERT_EQ(endPosition(gapsH), endPosition(row(align, 0)));
+        SEQAN_ASSERT_EQ(beginPosition(gapsV), beginPosition(row(align, 1)));
+        SEQAN_ASSERT_EQ(endPosition(gapsV), endPosition(row(align, 1)));
+    }
+}
+
+SEQAN_DEFINE_TEST(test_alignment_algorithms_local_striped_score_matrix)
+{
+    using namespace seqan;
+
+    StringSet<Peptide> setH, setV;
+    testAlignBatchRandomPairs(setH, setV, 60, 1, 50, 11);
+    // Scores of the similar pairs exceed the 8 bit lanes.
+    testAlignBatchRandomPairs(setH, setV, 12, 150, 400, 12);
+
+    testAlignStripedLocal(setH, setV, Blosum62(-1, -11));
+    testAlignStripedLocal(setH, setV, Blosum62(-2, -2));
+    testAlignStripedLocal(setH, setV, Blosum62(0, 0));
+}
+
+SEQAN_DEFINE_TEST(test_alignment_algorithms_local_striped_simple)
+{
+    using namespace seqan;
+
+    StringSet<Dna5String> setH, setV;
+    testAlignBatchRandomPairs(setH, setV, 60, 1, 60, 13);
+    testAlignBatchRandomPairs(setH, setV, 6, 500, 900, 14);
+
+    testAlignStripedLocal(setH, setV, Score<int, Simple>(2, -1, -2));
+    testAlignStripedLocal(setH, setV, Score<int, Simple>(2, -3, -1, -5));
+
+    // Scores exceeding the 16 bit lanes are computed with the scalar DP.
+    testAlignStripedLocal(setH, setV, Score<int, Simple>(100, -40, -20, -90));
+
+    // Pairs without a positive score have an empty alignment.
+    Dna5String seqH = "AAAA";
+    Dna5String seqV = "CCCCCC";
+    SEQAN_ASSERT_EQ(localAlignmentScore(seqH, seqV, Score<int, Simple>(1, -1, -1), SmithWatermanStriped()), 0);
+}
+
+#endif  // #ifndef CORE_TESTS_ALIGN_TEST_ALIGNMENT_ALGORITHMS_LOCAL_STRIPED_H_
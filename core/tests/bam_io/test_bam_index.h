@@ -66,7 +66,9 @@ SEQAN_DEFINE_TEST(test_bam_io_bam_index_bai)
     append(bamFilename, SEQAN_PATH_TO_ROOT());
     append(bamFilename, "/core/tests/bam_io/small.bam");
 
+    // Jumping must also work when blocks are decompressed in parallel.
     Stream<Bgzf> stream;
+    setNumThreads(stream, 2);
     open(stream, toCString(bamFilename), "r");
 
     StringSet<CharString> nameStore;
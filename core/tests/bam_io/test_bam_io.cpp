@@ -48,6 +48,9 @@
 #include "test_bam_index.h"
 #endif  // #if SEQAN_HAS_ZLIB
 #include "test_bam_stream.h"
+#if SEQAN_HAS_ZLIB
+#include "test_bam_sort.h"
+#endif  // #if SEQAN_HAS_ZLIB
 
 SEQAN_BEGIN_TESTSUITE(test_bam_io)
 {
@@ -152,6 +155,8 @@ SEQAN_BEGIN_TESTSUITE(test_bam_io)
     SEQAN_CALL_TEST(test_bam_io_bam_read_alignment);
     SEQAN_CALL_TEST(test_bam_io_bam_write_header);
     SEQAN_CALL_TEST(test_bam_io_bam_write_alignment);
+    SEQAN_CALL_TEST(test_bam_io_bam_read_batch);
+    SEQAN_CALL_TEST(test_bam_io_bam_read_batch_empty_block);
 
     // Test BAM indices.
     SEQAN_CALL_TEST(test_bam_io_bam_index_bai);
@@ -167,7 +172,18 @@ SEQAN_BEGIN_TESTSUITE(test_bam_io)
     SEQAN_CALL_TEST(test_bam_io_bam_stream_bam_read_header);
     SEQAN_CALL_TEST(test_bam_io_bam_stream_bam_read_records);
     SEQAN_CALL_TEST(test_bam_io_bam_stream_bam_read_ex1);
+#if SEQAN_HAS_ZLIB
+    SEQAN_CALL_TEST(test_bam_io_bam_stream_bam_read_batch_ex1);
+    SEQAN_CALL_TEST(test_bam_io_bam_stream_bam_read_record_batches);
+#endif  // #if SEQAN_HAS_ZLIB
     SEQAN_CALL_TEST(test_bam_io_bam_stream_bam_write_header);
     SEQAN_CALL_TEST(test_bam_io_bam_stream_bam_write_records);
+
+    // Tests for BAM sorting and index building.
+#if SEQAN_HAS_ZLIB
+    SEQAN_CALL_TEST(test_bam_io_bam_index_bai_build);
+    SEQAN_CALL_TEST(test_bam_io_bam_sort_coordinate);
+    SEQAN_CALL_TEST(test_bam_io_bam_sort_query_name);
+#endif  // #if SEQAN_HAS_ZLIB
 }
 SEQAN_END_TESTSUITE
@@ -0,0 +1,245 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Author: agent <agent@local>
+// ==========================================================================
+
+#ifndef CORE_TESTS_BAM_IO_TEST_BAM_SORT_H_
+#define CORE_TESTS_BAM_IO_TEST_BAM_SORT_H_
+
+#include <seqan/basic.h>
+#include <seqan/sequence.h>
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+#include <seqan/bam_io.h>
+
+// Read all records of a BAM file.
+inline void _testBamSortReadFile(seqan::BamHeader & header,
+                                 seqan::String<seqan::BamAlignmentRecord> & records,
+                                 char const * filename)
+{
+    using namespace seqan;
+
+    BamStream bamStream(filename);
+    SEQAN_ASSERT(isGood(bamStream));
+    header = bamStream.header;
+    clear(records);
+    while (!atEnd(bamStream))
+    {
+        resize(records, length(records) + 1);
+        SEQAN_ASSERT_EQ(readRecord(back(records), bamStream), 0);
+    }
+}
+
+// Write the records of ex1.bam in a scrambled order to filename and return them.
+inline void _testBamSortWriteShuffled(seqan::String<seqan::BamAlignmentRecord> & records, char const * filename)
+{
+    using namespace seqan;
+
+    CharString inPath = SEQAN_PATH_TO_ROOT();
+    append(inPath, "/core/tests/bam_io/ex1.bam");
+
+    BamHeader header;
+    _testBamSortReadFile(header, records, toCString(inPath));
+    SEQAN_ASSERT_GT(length(records), 1000u);
+
+    String<unsigned> order;
+    resize(order, length(records));
+    for (unsigned i = 0; i < length(order); ++i)
+        order[i] = i;
+    unsigned seed = 42;
+    for (unsigned i = length(order) - 1; i > 0; --i)
+    {
+        seed = seed * 1103515245u + 12345u;
+        std::swap(order[i], order[(seed >> 8) % (i + 1)]);
+    }
+
+    BamStream out(filename, BamStream::WRITE);
+    out.header = header;
+    for (unsigned i = 0; i < length(order); ++i)
+        SEQAN_ASSERT_EQ(writeRecord(out, records[order[i]]), 0);
+    SEQAN_ASSERT_EQ(close(out), 0);
+}
+
+// Check that both strings contain the same records, ignoring their order.
+inline void _testBamSortCompareRecordSets(seqan::String<seqan::BamAlignmentRecord> const & lhs,
+                                          seqan::String<seqan::BamAlignmentRecord> const & rhs)
+{
+    using namespace seqan;
+
+    SEQAN_ASSERT_EQ(length(lhs), length(rhs));
+    std::vector<std::string> lhsKeys, rhsKeys;
+    for (unsigned i = 0; i < length(lhs); ++i)
+    {
+        std::stringstream lhsKey, rhsKey;
+        lhsKey << lhs[i].qName << '\t' << lhs[i].flag << '\t' << lhs[i].rID << '\t' << lhs[i].beginPos << '\t'
+               << lhs[i].seq;
+        rhsKey << rhs[i].qName << '\t' << rhs[i].flag << '\t' << rhs[i].rID << '\t' << rhs[i].beginPos << '\t'
+               << rhs[i].seq;
+        lhsKeys.push_back(lhsKey.str());
+        rhsKeys.push_back(rhsKey.str());
+    }
+    std::sort(lhsKeys.begin(), lhsKeys.end());
+    std::sort(rhsKeys.begin(), rhsKeys.end());
+    SEQAN_ASSERT(lhsKeys == rhsKeys);
+}
+
+inline void _testBamSortCompareIndices(seqan::BamIndex<seqan::Bai> const & lhs,
+                                       seqan::BamIndex<seqan::Bai> const & rhs)
+{
+    SEQAN_ASSERT_EQ(length(lhs._binIndices), length(rhs._binIndices));
+    for (unsigned i = 0; i < length(lhs._binIndices); ++i)
+    {
+        SEQAN_ASSERT(lhs._binIndices[i].size() == rhs._binIndices[i].size());
+        typedef seqan::BamIndex<seqan::Bai>::TBinIndex_::const_iterator TIter;
+        for (TIter it = lhs._binIndices[i].begin(), it2 = rhs._binIndices[i].begin(); it != lhs._binIndices[i].end();
+             ++it, ++it2)
+        {
+            SEQAN_ASSERT_EQ(it->first, it2->first);
+            SEQAN_ASSERT_EQ(length(it->second.chunkBegEnds), length(it2->second.chunkBegEnds));
+            for (unsigned j = 0; j < length(it->second.chunkBegEnds); ++j)
+            {
+                SEQAN_ASSERT_EQ(it->second.chunkBegEnds[j].i1, it2->second.chunkBegEnds[j].i1);
+                SEQAN_ASSERT_EQ(it->second.chunkBegEnds[j].i2, it2->second.chunkBegEnds[j].i2);
+            }
+        }
+    }
+    SEQAN_ASSERT(lhs._linearIndices == rhs._linearIndices);
+    SEQAN_ASSERT_EQ(getUnalignedCount(lhs), getUnalignedCount(rhs));
+}
+
+SEQAN_DEFINE_TEST(test_bam_io_bam_index_bai_build)
+{
+    using namespace seqan;
+
+    // Copy small.bam to a temporary file, the index is written next to it.
+    CharString inPath = SEQAN_PATH_TO_ROOT();
+    append(inPath, "/core/tests/bam_io/small.bam");
+    CharString bamPath = SEQAN_TEMP_FILENAME();
+    append(bamPath, ".bam");
+    {
+        std::ifstream in(toCString(inPath), std::ios::binary);
+        std::ofstream out(toCString(bamPath), std::ios::binary);
+        out << in.rdbuf();
+    }
+
+    BamIndex<Bai> builtIndex;
+    SEQAN_ASSERT(buildIndex(builtIndex, toCString(bamPath)));
+
+    // The index built in memory and the one written must be equal to the one of samtools.
+    CharString baiPath = inPath;
+    append(baiPath, ".bai");
+    BamIndex<Bai> samtoolsIndex;
+    SEQAN_ASSERT_EQ(read(samtoolsIndex, toCString(baiPath)), 0);
+    _testBamSortCompareIndices(builtIndex, samtoolsIndex);
+
+    append(bamPath, ".bai");
+    BamIndex<Bai> writtenIndex;
+    SEQAN_ASSERT_EQ(read(writtenIndex, toCString(bamPath)), 0);
+    _testBamSortCompareIndices(writtenIndex, samtoolsIndex);
+}
+
+SEQAN_DEFINE_TEST(test_bam_io_bam_sort_coordinate)
+{
+    using namespace seqan;
+
+    CharString inPath = SEQAN_TEMP_FILENAME();
+    append(inPath, ".bam");
+    String<BamAlignmentRecord> expected;
+    _testBamSortWriteShuffled(expected, toCString(inPath));
+
+    // A small memory limit and merge width force several runs and merge passes.
+    CharString outPath = SEQAN_TEMP_FILENAME();
+    append(outPath, ".bam");
+    BamSortOptions options;
+    options.memoryLimit = 64 * 1024;
+    options.maxMergeWidth = 3;
+    options.numThreads = 4;
+    SEQAN_ASSERT_EQ(sortBamFile(toCString(outPath), toCString(inPath), SortByCoordinate(), options), 0);
+
+    BamHeader header;
+    String<BamAlignmentRecord> records;
+    _testBamSortReadFile(header, records, toCString(outPath));
+    CharString sortOrder;
+    SEQAN_ASSERT(getTagValue(sortOrder, "SO", header.records[0]));
+    SEQAN_ASSERT_EQ(sortOrder, "coordinate");
+
+    BamSortLess_<SortByCoordinate> less;
+    for (unsigned i = 1; i < length(records); ++i)
+        SEQAN_ASSERT_NOT(less(records[i], records[i - 1]));
+    _testBamSortCompareRecordSets(records, expected);
+
+    // The index written while sorting must be equal to the one built from the output.
+    CharString baiPath = outPath;
+    append(baiPath, ".bai");
+    BamIndex<Bai> sortIndex;
+    SEQAN_ASSERT_EQ(read(sortIndex, toCString(baiPath)), 0);
+    BamIndex<Bai> builtIndex;
+    SEQAN_ASSERT(buildIndex(builtIndex, toCString(outPath)));
+    _testBamSortCompareIndices(sortIndex, builtIndex);
+}
+
+SEQAN_DEFINE_TEST(test_bam_io_bam_sort_query_name)
+{
+    using namespace seqan;
+
+    CharString inPath = SEQAN_TEMP_FILENAME();
+    append(inPath, ".bam");
+    String<BamAlignmentRecord> expected;
+    _testBamSortWriteShuffled(expected, toCString(inPath));
+
+    CharString outPath = SEQAN_TEMP_FILENAME();
+    append(outPath, ".bam");
+    BamSortOptions options;
+    options.memoryLimit = 64 * 1024;
+    options.numThreads = 2;
+    SEQAN_ASSERT_EQ(sortBamFile(toCString(outPath), toCString(inPath), SortByQueryName(), options), 0);
+
+    BamHeader header;
+    String<BamAlignmentRecord> records;
+    _testBamSortReadFile(header, records, toCString(outPath));
+
+    BamSortLess_<SortByQueryName> less;
+    for (unsigned i = 1; i < length(records); ++i)
+        SEQAN_ASSERT_NOT(less(records[i], records[i - 1]));
+    _testBamSortCompareRecordSets(records, expected);
+
+    // Numbers in the names are compared by value.
+    SEQAN_ASSERT_LT(BamSortLess_<SortByQueryName>::_compare("r9", "r10"), 0);
+    SEQAN_ASSERT_LT(BamSortLess_<SortByQueryName>::_compare("a2b", "a02c"), 0);
+    SEQAN_ASSERT_GT(BamSortLess_<SortByQueryName>::_compare("r10", "r9a"), 0);
+    SEQAN_ASSERT_EQ(BamSortLess_<SortByQueryName>::_compare("r10", "r10"), 0);
+}
+
+#endif  // CORE_TESTS_BAM_IO_TEST_BAM_SORT_H_
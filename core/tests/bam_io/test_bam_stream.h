@@ -200,6 +200,169 @@ SEQAN_DEFINE_TEST(test_bam_io_bam_stream_bam_read_ex1)
     SEQAN_ASSERT_EQ(counts[1], 1806);
 }
 
+#if SEQAN_HAS_ZLIB
+// Copy a BAM file with BamStream, the BGZF writer fills the blocks completely.
+void testBamIORewriteBam(seqan::CharString & tmpPath, seqan::CharString const & filePath)
+{
+    tmpPath = SEQAN_TEMP_FILENAME();
+    append(tmpPath, ".bam");
+
+    seqan::BamStream bamIn(toCString(filePath));
+    seqan::BamStream bamOut(toCString(tmpPath), seqan::BamStream::WRITE);
+    bamOut.header = bamIn.header;
+    seqan::BamAlignmentRecord record;
+    while (!atEnd(bamIn))
+    {
+        SEQAN_ASSERT_EQ(readRecord(record, bamIn), 0);
+        SEQAN_ASSERT_EQ(writeRecord(bamOut, record), 0);
+    }
+}
+
+SEQAN_DEFINE_TEST(test_bam_io_bam_stream_bam_read_batch_ex1)
+{
+    seqan::CharString filePath = SEQAN_PATH_TO_ROOT();
+    append(filePath, "/core/tests/bam_io/ex1.bam");
+
+    // Rewrite the file, our BGZF writer fills the blocks completely and records span block borders.
+    seqan::CharString tmpPath;
+    testBamIORewriteBam(tmpPath, filePath);
+
+    seqan::BamStream bamIO(toCString(tmpPath));
+    seqan::BamStream bamIOExpected(toCString(filePath));
+    SEQAN_ASSERT(isGood(bamIO));
+    SEQAN_ASSERT(isGood(bamIOExpected));
+
+    // Compare the decoded views with readRecord(), every third batch is followed by a readRecord() on the same stream.
+    seqan::BamRecordBatch batch;
+    seqan::BamAlignmentRecord record, expected;
+    unsigned numRecords = 0, numBatches = 0;
+    while (!atEnd(bamIO))
+    {
+        SEQAN_ASSERT_EQ(readBatch(batch, bamIO), 0);
+        for (unsigned i = 0; i < length(batch.views); ++i, ++numRecords)
+        {
+            SEQAN_ASSERT_EQ(readRecord(expected, bamIOExpected), 0);
+            seqan::BamRecordView const & view = batch.views[i];
+            SEQAN_ASSERT_EQ(getBeginPos(view), expected.beginPos);
+            SEQAN_ASSERT_EQ(getFlag(view), expected.flag);
+            SEQAN_ASSERT_EQ(hasFlagUnmapped(view), hasFlagUnmapped(expected));
+            SEQAN_ASSERT_EQ(getAlignmentLengthInRef(view), getAlignmentLengthInRef(expected));
+
+            decodeRecord(record, bamIO.bamIOContext, view);
+            SEQAN_ASSERT_EQ(record.qName, expected.qName);
+            SEQAN_ASSERT_EQ(record.rID, expected.rID);
+            SEQAN_ASSERT_EQ(record.mapQ, expected.mapQ);
+            SEQAN_ASSERT_EQ(record.bin, expected.bin);
+            SEQAN_ASSERT_EQ(length(record.cigar), length(expected.cigar));
+            for (unsigned j = 0; j < length(record.cigar); ++j)
+            {
+                SEQAN_ASSERT_EQ(record.cigar[j].operation, expected.cigar[j].operation);
+                SEQAN_ASSERT_EQ(record.cigar[j].count, expected.cigar[j].count);
+            }
+            SEQAN_ASSERT_EQ(record.rNextId, expected.rNextId);
+            SEQAN_ASSERT_EQ(record.pNext, expected.pNext);
+            SEQAN_ASSERT_EQ(record.tLen, expected.tLen);
+            SEQAN_ASSERT_EQ(record.seq, expected.seq);
+            SEQAN_ASSERT_EQ(record.qual, expected.qual);
+            SEQAN_ASSERT_EQ(record.tags, expected.tags);
+        }
+        if (++numBatches % 3 == 0 && !atEnd(bamIO))
+        {
+            SEQAN_ASSERT_EQ(readRecord(record, bamIO), 0);
+            SEQAN_ASSERT_EQ(readRecord(expected, bamIOExpected), 0);
+            SEQAN_ASSERT_EQ(record.qName, expected.qName);
+            ++numRecords;
+        }
+    }
+    SEQAN_ASSERT(atEnd(bamIOExpected));
+    SEQAN_ASSERT_EQ(numRecords, 1501u + 1806u);
+    SEQAN_ASSERT_GT(numBatches, 1u);
+}
+#endif  // #if SEQAN_HAS_ZLIB
+
+#if SEQAN_HAS_ZLIB
+struct BamTestCollectRecords_
+{
+    seqan::String<seqan::BamAlignmentRecord> records;
+    unsigned numBatches;
+
+    BamTestCollectRecords_() : numBatches(0)
+    {}
+
+    void operator()(seqan::String<seqan::BamAlignmentRecord> & batch)
+    {
+        append(records, batch);
+        ++numBatches;
+    }
+};
+
+struct BamTestLessRecord_
+{
+    bool operator()(seqan::BamAlignmentRecord const & a, seqan::BamAlignmentRecord const & b) const
+    {
+        if (a.qName != b.qName)
+            return a.qName < b.qName;
+        if (a.flag != b.flag)
+            return a.flag < b.flag;
+        return a.beginPos < b.beginPos;
+    }
+};
+
+void testBamIOBamStreamReadRecordBatches(char const * pathFragment, bool keepOrder, unsigned numThreads)
+{
+    seqan::CharString filePath = SEQAN_PATH_TO_ROOT();
+    append(filePath, pathFragment);
+    if (seqan::endsWith(pathFragment, ".bam"))
+        testBamIORewriteBam(filePath, seqan::CharString(filePath));
+
+    seqan::BamStream bamIOExpected(toCString(filePath));
+    seqan::String<seqan::BamAlignmentRecord> expected;
+    while (!atEnd(bamIOExpected))
+    {
+        resize(expected, length(expected) + 1);
+        SEQAN_ASSERT_EQ(readRecord(back(expected), bamIOExpected), 0);
+    }
+
+    seqan::BamStream bamIO(toCString(filePath));
+    seqan::BamParallelReadOptions options;
+    options.keepOrder = keepOrder;
+    options.numThreads = numThreads;
+    options.numSlots = 3;
+    BamTestCollectRecords_ consumer;
+    SEQAN_ASSERT_EQ(readRecordBatches(consumer, bamIO, options), 0);
+    SEQAN_ASSERT(atEnd(bamIO));
+
+    // Without the order, compare the records sorted by name and position.
+    seqan::String<seqan::BamAlignmentRecord> & records = consumer.records;
+    SEQAN_ASSERT_EQ(length(records), length(expected));
+    if (!keepOrder)
+    {
+        std::sort(begin(records, seqan::Standard()), end(records, seqan::Standard()), BamTestLessRecord_());
+        std::sort(begin(expected, seqan::Standard()), end(expected, seqan::Standard()), BamTestLessRecord_());
+    }
+    for (unsigned i = 0; i < length(records); ++i)
+    {
+        SEQAN_ASSERT_EQ(records[i].qName, expected[i].qName);
+        SEQAN_ASSERT_EQ(records[i].rID, expected[i].rID);
+        SEQAN_ASSERT_EQ(records[i].flag, expected[i].flag);
+        SEQAN_ASSERT_EQ(records[i].beginPos, expected[i].beginPos);
+        SEQAN_ASSERT_EQ(records[i].seq, expected[i].seq);
+        SEQAN_ASSERT_EQ(records[i].qual, expected[i].qual);
+        SEQAN_ASSERT_EQ(records[i].tags, expected[i].tags);
+    }
+    SEQAN_ASSERT_GT(consumer.numBatches, 0u);
+}
+
+SEQAN_DEFINE_TEST(test_bam_io_bam_stream_bam_read_record_batches)
+{
+    testBamIOBamStreamReadRecordBatches("/core/tests/bam_io/ex1.bam", true, 1);
+    testBamIOBamStreamReadRecordBatches("/core/tests/bam_io/ex1.bam", true, 4);
+    testBamIOBamStreamReadRecordBatches("/core/tests/bam_io/ex1.bam", false, 4);
+    testBamIOBamStreamReadRecordBatches("/core/tests/bam_io/small.bam", true, 4);
+    testBamIOBamStreamReadRecordBatches("/core/tests/bam_io/small.sam", true, 4);
+}
+#endif  // #if SEQAN_HAS_ZLIB
+
 // ---------------------------------------------------------------------------
 // Write Header
 // ---------------------------------------------------------------------------
@@ -35,6 +35,8 @@
 #ifndef CORE_TESTS_BAM_IO_TEST_READ_BAM_H_
 #define CORE_TESTS_BAM_IO_TEST_READ_BAM_H_
 
+#include <fstream>
+
 #include <seqan/basic.h>
 #include <seqan/sequence.h>
 
@@ -157,4 +159,128 @@ SEQAN_DEFINE_TEST(test_bam_io_bam_read_alignment)
     // TODO(holtgrew): Check more alignments?
 }
 
+SEQAN_DEFINE_TEST(test_bam_io_bam_read_batch)
+{
+    using namespace seqan;
+
+    CharString bamFilename;
+    append(bamFilename, SEQAN_PATH_TO_ROOT());
+    append(bamFilename, "/core/tests/bam_io/small.bam");
+
+    Stream<Bgzf> stream;
+    setNumThreads(stream, 2);
+    SEQAN_ASSERT(open(stream, toCString(bamFilename), "r"));
+
+    StringSet<CharString> referenceNameStore;
+    NameStoreCache<StringSet<CharString> > referenceNameStoreCache(referenceNameStore);
+    BamIOContext<StringSet<CharString> > bamIOContext(referenceNameStore, referenceNameStoreCache);
+
+    BamHeader header;
+    SEQAN_ASSERT_EQ(readRecord(header, bamIOContext, stream, Bam()), 0);
+
+    BamRecordBatch batch;
+    String<BamAlignmentRecord> alignments;
+    while (!atEnd(stream))
+    {
+        SEQAN_ASSERT_EQ(readBatch(batch, stream, Bam()), 0);
+        for (unsigned i = 0; i < length(batch.views); ++i)
+        {
+            BamRecordView const & view = batch.views[i];
+            SEQAN_ASSERT_EQ(getRID(view), 0);
+            SEQAN_ASSERT_EQ(getBeginPos(view), static_cast<__int32>(length(alignments)));
+            SEQAN_ASSERT_EQ(getMapQ(view), 8u);
+            SEQAN_ASSERT_EQ(getSeqLength(view), 10);
+            SEQAN_ASSERT_EQ(getAlignmentLengthInRef(view), 9u);
+
+            resize(alignments, length(alignments) + 1);
+            decodeRecord(back(alignments), bamIOContext, view);
+        }
+    }
+    SEQAN_ASSERT_EQ(readBatch(batch, stream, Bam()), 0);
+    SEQAN_ASSERT(empty(batch.views));
+
+    SEQAN_ASSERT_EQ(length(alignments), 3u);
+
+    SEQAN_ASSERT_EQ(alignments[0].qName, "READ0");
+    SEQAN_ASSERT_EQ(alignments[0].flag, 2);
+    SEQAN_ASSERT_EQ(alignments[0].rID, 0);
+    SEQAN_ASSERT_EQ(alignments[0].beginPos, 0);
+    SEQAN_ASSERT_EQ(alignments[0].pNext, 30);
+    SEQAN_ASSERT_EQ(alignments[0].tLen, 40);
+    SEQAN_ASSERT_EQ(length(alignments[0].cigar), 3u);
+    SEQAN_ASSERT_EQ(alignments[0].cigar[1].operation, 'I');
+    SEQAN_ASSERT_EQ(alignments[0].cigar[1].count, 1u);
+    SEQAN_ASSERT_EQ(alignments[0].seq, "AAAAAAAAAA");
+    SEQAN_ASSERT_EQ(alignments[0].qual, "!!!!!!!!!!");
+    SEQAN_ASSERT_EQ(alignments[2].rNextId, -1);
+}
+
+SEQAN_DEFINE_TEST(test_bam_io_bam_read_batch_empty_block)
+{
+    using namespace seqan;
+
+    CharString bamFilename;
+    append(bamFilename, SEQAN_PATH_TO_ROOT());
+    append(bamFilename, "/core/tests/bam_io/small.bam");
+
+    StringSet<CharString> referenceNameStore;
+    NameStoreCache<StringSet<CharString> > referenceNameStoreCache(referenceNameStore);
+    BamIOContext<StringSet<CharString> > bamIOContext(referenceNameStore, referenceNameStoreCache);
+
+    BamHeader header;
+    String<BamAlignmentRecord> alignments;
+    {
+        Stream<Bgzf> stream;
+        SEQAN_ASSERT(open(stream, toCString(bamFilename), "r"));
+        SEQAN_ASSERT_EQ(readRecord(header, bamIOContext, stream, Bam()), 0);
+        while (!atEnd(stream))
+        {
+            resize(alignments, length(alignments) + 1);
+            SEQAN_ASSERT_EQ(readRecord(back(alignments), bamIOContext, stream, Bam()), 0);
+        }
+    }
+    SEQAN_ASSERT_EQ(length(alignments), 3u);
+
+    // Write the header and the first record and the remaining records into two files, each ending with an empty EOF
+    // block.  Their concatenation is a valid BAM file with an empty block in the middle.
+    CharString firstFilename = SEQAN_TEMP_FILENAME();
+    CharString secondFilename = SEQAN_TEMP_FILENAME();
+    CharString concatFilename = SEQAN_TEMP_FILENAME();
+    {
+        Stream<Bgzf> stream;
+        SEQAN_ASSERT(open(stream, toCString(firstFilename), "w"));
+        SEQAN_ASSERT_EQ(write2(stream, header, bamIOContext, Bam()), 0);
+        SEQAN_ASSERT_EQ(write2(stream, alignments[0], bamIOContext, Bam()), 0);
+        close(stream);
+        SEQAN_ASSERT(open(stream, toCString(secondFilename), "w"));
+        for (unsigned i = 1; i < length(alignments); ++i)
+            SEQAN_ASSERT_EQ(write2(stream, alignments[i], bamIOContext, Bam()), 0);
+        close(stream);
+
+        std::ofstream out(toCString(concatFilename), std::ios::binary);
+        std::ifstream first(toCString(firstFilename), std::ios::binary);
+        std::ifstream second(toCString(secondFilename), std::ios::binary);
+        out << first.rdbuf() << second.rdbuf();
+    }
+
+    Stream<Bgzf> stream;
+    SEQAN_ASSERT(open(stream, toCString(concatFilename), "r"));
+    BamHeader header2;
+    SEQAN_ASSERT_EQ(readRecord(header2, bamIOContext, stream, Bam()), 0);
+
+    BamRecordBatch batch;
+    unsigned count = 0;
+    do
+    {
+        SEQAN_ASSERT_EQ(readBatch(batch, stream, Bam()), 0);
+        for (unsigned i = 0; i < length(batch.views); ++i, ++count)
+        {
+            SEQAN_ASSERT_LT(count, length(alignments));
+            SEQAN_ASSERT_EQ(getBeginPos(batch.views[i]), alignments[count].beginPos);
+        }
+    }
+    while (!empty(batch.views));
+    SEQAN_ASSERT_EQ(count, length(alignments));
+}
+
 #endif  // CORE_TESTS_BAM_IO_TEST_READ_BAM_H_
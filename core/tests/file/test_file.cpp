@@ -44,6 +44,7 @@
 
 #include "test_embl.h"
 #include "test_file.h"
+#include "test_file_async.h"
 
 SEQAN_BEGIN_TESTSUITE(test_file)
 {
@@ -73,5 +74,8 @@ SEQAN_BEGIN_TESTSUITE(test_file)
 
 	SEQAN_CALL_TEST(test_file_embl_file);
 	SEQAN_CALL_TEST(test_file_embl_meta);
+
+    SEQAN_CALL_TEST(test_file_async_io_uring);
+    SEQAN_CALL_TEST(test_file_async_io_uring_external_string);
 }
 SEQAN_END_TESTSUITE
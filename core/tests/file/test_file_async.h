@@ -0,0 +1,131 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Author: agent <agent@local>
+// ==========================================================================
+
+#ifndef TESTS_FILE_TEST_FILE_ASYNC_H_
+#define TESTS_FILE_TEST_FILE_ASYNC_H_
+
+#include <seqan/basic.h>
+#include <seqan/sequence.h>
+#include <seqan/file.h>
+
+template <typename TFile>
+void testFileAsyncRequests(TFile & file)
+{
+    using namespace seqan;
+
+    typedef typename AsyncRequest<TFile>::Type TRequest;
+
+    const unsigned PAGE_SIZE = 4096;
+    const unsigned PAGES = 100;
+
+    // Pages are allocated through the const file, like the page frames of external strings.
+    TFile const & constFile = file;
+
+    // Write more pages than fit into the queue at once.
+    unsigned * pages[PAGES];
+    TRequest requests[PAGES];
+    for (unsigned i = 0; i < PAGES; ++i)
+    {
+        allocate(constFile, pages[i], PAGE_SIZE);
+        for (unsigned j = 0; j < PAGE_SIZE; ++j)
+            pages[i][j] = i * PAGE_SIZE + j;
+        SEQAN_ASSERT(asyncWriteAt(file, pages[i], PAGE_SIZE, (__int64)i * PAGE_SIZE, requests[i]));
+    }
+    for (unsigned i = 0; i < PAGES; ++i)
+        SEQAN_ASSERT(waitFor(requests[i]));
+
+    // Read them back in reverse order and poll for completion.
+    for (unsigned i = 0; i < PAGES; ++i)
+    {
+        memset(pages[i], 0, PAGE_SIZE * sizeof(unsigned));
+        unsigned pageNo = PAGES - 1 - i;
+        SEQAN_ASSERT(asyncReadAt(file, pages[i], PAGE_SIZE, (__int64)pageNo * PAGE_SIZE, requests[i]));
+    }
+    for (unsigned i = 0; i < PAGES; ++i)
+    {
+        bool inProgress = true;
+        while (inProgress)
+            SEQAN_ASSERT(waitFor(requests[i], 0, inProgress));
+        unsigned pageNo = PAGES - 1 - i;
+        for (unsigned j = 0; j < PAGE_SIZE; ++j)
+            SEQAN_ASSERT_EQ(pages[i][j], pageNo * PAGE_SIZE + j);
+    }
+
+    // Unaligned requests and cancelled requests.
+    SEQAN_ASSERT(asyncReadAt(file, pages[0] + 1, 10, (__int64)3, requests[0]));
+    SEQAN_ASSERT(waitFor(requests[0]));
+    for (unsigned j = 1; j < 11; ++j)
+        SEQAN_ASSERT_EQ(pages[0][j], j + 2);
+    SEQAN_ASSERT(asyncReadAt(file, pages[1], PAGE_SIZE, (__int64)0, requests[1]));
+    SEQAN_ASSERT(cancel(file, requests[1]));
+
+    for (unsigned i = 0; i < PAGES; ++i)
+        deallocate(constFile, pages[i], PAGE_SIZE);
+}
+
+SEQAN_DEFINE_TEST(test_file_async_io_uring)
+{
+    using namespace seqan;
+
+    File<Async<IOUring> > file;
+    SEQAN_ASSERT(open(file, SEQAN_TEMP_FILENAME(), OPEN_RDWR | OPEN_CREATE));
+    testFileAsyncRequests(file);
+    SEQAN_ASSERT(close(file));
+}
+
+SEQAN_DEFINE_TEST(test_file_async_io_uring_external_string)
+{
+    using namespace seqan;
+
+    typedef String<unsigned, External<ExternalConfig<File<Async<IOUring> >, 1024, 4> > > TExternalString;
+
+    CharString fileName = SEQAN_TEMP_FILENAME();
+    TExternalString str;
+    SEQAN_ASSERT(open(str, toCString(fileName), OPEN_RDWR | OPEN_CREATE));
+    for (unsigned i = 0; i < 100000; ++i)
+        appendValue(str, i * 7);
+    SEQAN_ASSERT(close(str));
+
+    TExternalString str2;
+    SEQAN_ASSERT(open(str2, toCString(fileName), OPEN_RDONLY));
+    SEQAN_ASSERT_EQ(length(str2), 100000u);
+    // Read through a const reference, otherwise the pages become dirty and are written back.
+    TExternalString const & constStr2 = str2;
+    for (unsigned i = 0; i < 100000; i += 997)
+        SEQAN_ASSERT_EQ(constStr2[i], i * 7);
+    for (unsigned i = 0; i < 100000; ++i)
+        SEQAN_ASSERT_EQ(constStr2[i], i * 7);
+}
+
+#endif  // TESTS_FILE_TEST_FILE_ASYNC_H_
@@ -41,6 +41,8 @@
 #include <cstring>  // size_t
 #include <cstdio>
 #include <vector>
+#include <algorithm>
+#include <cstdlib>
 #include <time.h>
 
 #define SEQAN_DEBUG
@@ -1501,6 +1503,97 @@ SEQAN_DEFINE_TEST(test_find_hamming_simple) {
     testFindApproximateHamming<HammingSimple, Dna>();
     }*/
 
+// Test the packed multi-needle Myers against one MyersUkkonen per needle.
+template <typename TNeedles, typename THaystack>
+void testMultipleMyers(TNeedles const & needles, THaystack & haystack, int minScore)
+{
+    typedef Triple<unsigned, unsigned, int> THit;  // end position, needle, score
+    String<THit> expected, found;
+
+    for (unsigned i = 0; i < length(needles); ++i)
+    {
+        Finder<THaystack> finder(haystack);
+        Pattern<DnaString, MyersUkkonen> pattern(needles[i], minScore);
+        while (find(finder, pattern))
+            appendValue(expected, THit(endPosition(finder), i, getScore(pattern)));
+    }
+
+    Finder<THaystack> finder(haystack);
+    Pattern<TNeedles, MultipleMyers> pattern(needles);
+    while (find(finder, pattern, minScore))
+        appendValue(found, THit(endPosition(finder), position(pattern), getScore(pattern)));
+
+    std::sort(begin(expected, Standard()), end(expected, Standard()));
+    SEQAN_ASSERT_EQ(length(found), length(expected));
+    for (unsigned i = 0; i < length(found); ++i)
+        SEQAN_ASSERT(found[i] == expected[i]);
+}
+
+SEQAN_DEFINE_TEST(test_find_multiple_myers) {
+    std::srand(42);
+    DnaString haystack;
+    for (unsigned i = 0; i < 3000; ++i)
+        appendValue(haystack, Dna(std::rand() % 4));
+
+    // needles of length 8..56, most of them taken from the haystack and mutated
+    StringSet<DnaString> needles;
+    for (unsigned i = 0; i < 60; ++i)
+    {
+        unsigned len = 8 + std::rand() % 49;
+        unsigned pos = std::rand() % (length(haystack) - len);
+        DnaString needle = infix(haystack, pos, pos + len);
+        if (i % 5 == 4)
+            for (unsigned j = 0; j < len; ++j)
+                needle[j] = Dna(std::rand() % 4);
+        for (unsigned e = std::rand() % 4; e > 0; --e)
+            needle[std::rand() % len] = Dna(std::rand() % 4);
+        appendValue(needles, needle);
+    }
+
+    for (int minScore = 0; minScore >= -4; --minScore)
+        testMultipleMyers(needles, haystack, minScore);
+}
+
+// Test Myers with needles spanning several machine words (and partially
+// filled SIMD vectors of blocks) against the DP search.
+SEQAN_DEFINE_TEST(test_myers_large_needles) {
+    std::srand(23);
+    DnaString haystack;
+    for (unsigned i = 0; i < 1500; ++i)
+        appendValue(haystack, Dna(std::rand() % 4));
+
+    unsigned const needleLengths[] = {65, 128, 129, 200, 256, 300, 513, 700};
+    for (unsigned n = 0; n < sizeof(needleLengths) / sizeof(unsigned); ++n)
+    {
+        unsigned len = needleLengths[n];
+        unsigned pos = std::rand() % (length(haystack) - len);
+        DnaString needle = infix(haystack, pos, pos + len);
+        for (unsigned e = len / 10; e > 0; --e)
+            needle[std::rand() % len] = Dna(std::rand() % 4);
+
+        for (int maxDistance = len / 8; maxDistance <= (int)len / 3; maxDistance += len / 10)
+        {
+            String<Pair<unsigned, int> > hitsMyers, hitsDP;
+            {
+                Finder<DnaString> finder(haystack);
+                Pattern<DnaString, MyersUkkonen> pattern(needle, -maxDistance);
+                while (find(finder, pattern))
+                    appendValue(hitsMyers, Pair<unsigned, int>(endPosition(finder), getScore(pattern)));
+            }
+            {
+                Finder<DnaString> finder(haystack);
+                Pattern<DnaString, DPSearch<SimpleScore> > pattern(needle, -maxDistance);
+                while (find(finder, pattern))
+                    appendValue(hitsDP, Pair<unsigned, int>(endPosition(finder), getScore(pattern)));
+            }
+            SEQAN_ASSERT_GT(length(hitsMyers), 0u);
+            SEQAN_ASSERT_EQ(length(hitsMyers), length(hitsDP));
+            for (unsigned i = 0; i < length(hitsMyers); ++i)
+                SEQAN_ASSERT(hitsMyers[i] == hitsDP[i]);
+        }
+    }
+}
+
 SEQAN_DEFINE_TEST(test_myers_find_infix_find_begin_at_start) {
     String<char> haystack = "___AAA___AAA";
     String<char> needle = "___AAA";
@@ -1743,6 +1836,12 @@ SEQAN_BEGIN_TESTSUITE(test_find) {
     SEQAN_CALL_TEST(test_myers_find_infix_find_begin_at_start);
     SEQAN_CALL_TEST(test_myers_find_infix_find_begin_within);
 
+    // Testing Myers with needles longer than a machine word.
+    SEQAN_CALL_TEST(test_myers_large_needles);
+
+    // Testing the packed multi-needle Myers.
+    SEQAN_CALL_TEST(test_find_multiple_myers);
+
     SEQAN_CALL_TEST(test_find_on_segments);
 
     SEQAN_CALL_TEST(test_find_hamming_simple);
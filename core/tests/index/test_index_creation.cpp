@@ -56,5 +56,8 @@ using namespace seqan;
 SEQAN_BEGIN_TESTSUITE(test_index)
 {
 	SEQAN_CALL_TEST(testIndexCreation);
+	SEQAN_CALL_TEST(testIndexCreationParallelSkew7);
+	SEQAN_CALL_TEST(testIndexOpenMMap);
+	SEQAN_CALL_TEST(testIndexSaveOpenMMapText);
 }
 SEQAN_END_TESTSUITE
@@ -269,6 +269,146 @@ SEQAN_DEFINE_TEST(testIndexCreation)
 
 //////////////////////////////////////////////////////////////////////////////
 
+template <typename TText>
+void testParallelSkew7(TText const &text)
+{
+		String<unsigned> sa, saSkew7;
+		resize(sa, length(text));
+		resize(saSkew7, length(text));
+
+		createSuffixArray(sa, text, ParallelSkew7());
+		createSuffixArray(saSkew7, text, Skew7());
+		SEQAN_ASSERT(isSuffixArray(sa, text));
+		SEQAN_ASSERT(sa == saSkew7);
+}
+
+SEQAN_DEFINE_TEST(testIndexCreationParallelSkew7)
+{
+		// short texts are delegated to Skew7
+		CharString shortText = "MISSISSIPPI";
+		testParallelSkew7(shortText);
+
+		// binary alphabet, many recursion levels
+		CharString text;
+		resize(text, 300000);
+		textRandomize(text);
+		testParallelSkew7(text);
+
+		// small alphabet, sorted by the fast tuple sort
+		DnaString dna;
+		resize(dna, 250000);
+		for (unsigned i = 0; i < length(dna); ++i)
+			dna[i] = Dna(pickRandomNumber(getRng()) % 4);
+		testParallelSkew7(dna);
+
+		// periodic text, non-unique names down to the last level
+		CharString periodic;
+		for (unsigned i = 0; i < 20000; ++i)
+			append(periodic, "ACGTACA");
+		testParallelSkew7(periodic);
+
+		// enhanced suffix array
+		Index<CharString> esa(text);
+		indexCreate(esa, FibreSA(), ParallelSkew7());
+		SEQAN_ASSERT(isSuffixArray(indexSA(esa), text));
+
+		// external text and suffix array, built by the pipelined Skew7 with parallel sorters
+		typedef String<unsigned, External<> > TExtSA;
+		String<char, External<> > extText;
+		TExtSA extSa;
+		extText = text;
+		resize(extSa, length(text));
+		createSuffixArray(extSa, extText, ParallelSkew7());
+		for (unsigned i = 0; i < length(text); ++i)
+			SEQAN_ASSERT_EQ(static_cast<TExtSA const &>(extSa)[i], indexSA(esa)[i]);
+
+		// FM index
+		typedef Index<DnaString, FMIndex<> > TFMIndex;
+		TFMIndex fmIndex(dna), fmIndexSkew7(dna);
+		indexCreate(fmIndex, FibreSaLfTable(), ParallelSkew7());
+		indexCreate(fmIndexSkew7, FibreSaLfTable());
+		for (unsigned i = 0; i < length(dna); i += 97)
+			SEQAN_ASSERT_EQ(getFibre(fmIndex, FibreSA())[i], getFibre(fmIndexSkew7, FibreSA())[i]);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+SEQAN_DEFINE_TEST(testIndexOpenMMap)
+{
+		DnaString text;
+		resize(text, 50000);
+		for (unsigned i = 0; i < length(text); ++i)
+			text[i] = Dna(pickRandomNumber(getRng()) % 4);
+
+		Index<DnaString> esa(text);
+		indexRequire(esa, EsaSA());
+		indexRequire(esa, EsaLcp());
+		indexRequire(esa, EsaChildtab());
+
+		CharString tempFilename = SEQAN_TEMP_FILENAME();
+		SEQAN_ASSERT(save(esa, toCString(tempFilename)));
+
+		// the fibres of an index over a text configured with MMapFibres are memory mapped
+		typedef Index<String<Dna, MMap<MMapFibres<> > > > TMMapIndex;
+		typedef Fibre<TMMapIndex, EsaSA>::Type TMMapSA;
+		SEQAN_ASSERT(+(IsSameType<TMMapSA, String<SAValue<TMMapIndex>::Type, MMap<> > >::VALUE));
+		TMMapIndex mmapEsa;
+		SEQAN_ASSERT(open(mmapEsa, toCString(tempFilename), OPEN_RDONLY));
+		SEQAN_ASSERT(indexSA(mmapEsa) == indexSA(esa));
+		SEQAN_ASSERT(indexLcp(mmapEsa) == indexLcp(esa));
+		SEQAN_ASSERT(indexChildtab(mmapEsa) == indexChildtab(esa));
+
+		for (unsigned i = 0; i < 100; ++i)
+		{
+			DnaString pattern = infix(text, i * 400, i * 400 + 5 + i % 7);
+			Finder<Index<DnaString> > finder(esa);
+			Finder<TMMapIndex> mmapFinder(mmapEsa);
+			while (find(finder, pattern))
+			{
+				SEQAN_ASSERT(find(mmapFinder, pattern));
+				SEQAN_ASSERT_EQ(position(mmapFinder), position(finder));
+			}
+			SEQAN_ASSERT_NOT(find(mmapFinder, pattern));
+		}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+SEQAN_DEFINE_TEST(testIndexSaveOpenMMapText)
+{
+		// a plain memory mapped text gets in-memory fibres that are written by save()
+		typedef String<Dna, MMap<> > TText;
+		typedef Index<TText> TIndex;
+		SEQAN_ASSERT(+(IsSameType<Fibre<TIndex, EsaSA>::Type, String<SAValue<TIndex>::Type> >::VALUE));
+
+		CharString tempFilename = SEQAN_TEMP_FILENAME();
+		DnaString text;
+		resize(text, 50000);
+		for (unsigned i = 0; i < length(text); ++i)
+			text[i] = Dna(pickRandomNumber(getRng()) % 4);
+
+		TText mmapText;
+		SEQAN_ASSERT(open(mmapText, toCString(tempFilename), OPEN_RDWR | OPEN_CREATE));
+		mmapText = text;
+
+		TIndex esa(mmapText);
+		indexRequire(esa, EsaSA());
+		indexRequire(esa, EsaLcp());
+		indexRequire(esa, EsaChildtab());
+		SEQAN_ASSERT(save(esa, toCString(tempFilename)));
+		close(mmapText);  // truncates the file to the text length
+
+		// the text is opened from the mapped file itself
+		TIndex openEsa;
+		SEQAN_ASSERT(open(openEsa, toCString(tempFilename), OPEN_RDONLY));
+		SEQAN_ASSERT(indexText(openEsa) == text);
+		SEQAN_ASSERT(indexSA(openEsa) == indexSA(esa));
+		SEQAN_ASSERT(indexLcp(openEsa) == indexLcp(esa));
+		SEQAN_ASSERT(indexChildtab(openEsa) == indexChildtab(esa));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 
 } //namespace SEQAN_NAMESPACE_MAIN
 
@@ -62,6 +62,7 @@ SEQAN_BEGIN_TESTSUITE(test_fm_index_beta)
     SEQAN_CALL_TEST(test_rsbs_equalOperator);
     SEQAN_CALL_TEST(test_rsbs_assignOperator);
     SEQAN_CALL_TEST(test_rsbs_open_save);
+    SEQAN_CALL_TEST(test_rsbs_open_mmap);
     
     SEQAN_CALL_TEST(test_rsbs_iterator_get_value);
 
@@ -136,6 +137,9 @@ SEQAN_BEGIN_TESTSUITE(test_fm_index_beta)
     SEQAN_CALL_TEST(test_fm_index_get_fibre);
     SEQAN_CALL_TEST(test_fm_index_search);
     SEQAN_CALL_TEST(test_fm_index_open_save);
+    SEQAN_CALL_TEST(test_fm_index_open_mmap);
+    SEQAN_CALL_TEST(test_fm_index_save_open_mmap_text);
+    SEQAN_CALL_TEST(test_fm_index_find_ranges);
 
     SEQAN_CALL_TEST(fm_index_iterator_constuctor);
     SEQAN_CALL_TEST(fm_index_iterator_go_down);
@@ -146,5 +150,8 @@ SEQAN_BEGIN_TESTSUITE(test_fm_index_beta)
     SEQAN_CALL_TEST(fm_index_iterator_is_root);
     SEQAN_CALL_TEST(fm_index_iterator_count_occurrences);
     SEQAN_CALL_TEST(fm_index_iterator_range);
+
+    SEQAN_CALL_TEST(fm_index_bidirectional_extend);
+    SEQAN_CALL_TEST(fm_index_bidirectional_find_mismatches);
 }
 SEQAN_END_TESTSUITE
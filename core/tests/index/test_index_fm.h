@@ -483,6 +483,152 @@ void fmIndexOpenSave(Index<TText, FMIndex<TIndexSpec, TOptimization> > /*tag*/)
     }
 }
 
+template <typename TText, typename TIndexSpec, typename TOptimization>
+void fmIndexOpenMMap(Index<TText, FMIndex<TIndexSpec, TOptimization> > /*tag*/)
+{
+	typedef Index<TText, FMIndex<TIndexSpec, TOptimization> > TIndex;
+	typedef typename Value<TIndex>::Type TAlphabet;
+    typedef Index<String<TAlphabet, MMap<MMapFibres<> > >, FMIndex<TIndexSpec, TOptimization> > TMMapIndex;
+    typedef typename Fibre<TMMapIndex, FibreSA>::Type TMMapSA;
+    typedef typename Fibre<TMMapSA, FibreSparseString>::Type TMMapSparseString;
+    typedef typename Fibre<TMMapSparseString, FibreValueString>::Type TMMapSAValues;
+    typedef String<TAlphabet> TString;
+
+    // Opting in with MMapFibres maps the fibres.
+    SEQAN_ASSERT(+(IsSameType<TMMapSAValues, String<typename Value<TMMapSAValues>::Type, MMap<> > >::VALUE));
+
+	TText text;
+	generateText(text, 10000);
+
+	CharString tempFilename = SEQAN_TEMP_FILENAME();
+
+    TIndex indexSave(text);
+    indexCreate(indexSave);
+    save(indexSave, toCString(tempFilename));
+
+    // The saved fibres are mapped into memory instead of being read.
+    TMMapIndex indexOpen;
+    SEQAN_ASSERT(open(indexOpen, toCString(tempFilename), OPEN_RDONLY));
+
+    Finder<TIndex> saveFinder(indexSave);
+    Finder<TMMapIndex> openFinder(indexOpen);
+
+    for (unsigned i = 0; i + 10 < length(text); i += 500)
+    {
+        TString pattern = infix(text, i, i + 1 + i % 10);
+        clear(saveFinder);
+        clear(openFinder);
+
+        while(find(saveFinder, pattern))
+        {
+            SEQAN_ASSERT(find(openFinder, pattern));
+            SEQAN_ASSERT_EQ(position(openFinder), position(saveFinder));
+        }
+        SEQAN_ASSERT_NOT(find(openFinder, pattern));
+    }
+}
+
+template <typename TText, typename TIndexSpec, typename TOptimization>
+void fmIndexSaveOpenMMapText(Index<TText, FMIndex<TIndexSpec, TOptimization> > /*tag*/)
+{
+	typedef typename Value<TText>::Type TAlphabet;
+    typedef String<TAlphabet, MMap<> > TMMapText;
+    typedef Index<TMMapText, FMIndex<TIndexSpec, TOptimization> > TIndex;
+    typedef typename Fibre<TIndex, FibreSA>::Type TSA;
+    typedef typename Fibre<TSA, FibreSparseString>::Type TSparseString;
+    typedef typename Fibre<TSparseString, FibreValueString>::Type TSAValues;
+    typedef String<TAlphabet> TString;
+
+    // A plain memory mapped text gets in-memory fibres that are written by save().
+    SEQAN_ASSERT(+(IsSameType<TSAValues, String<typename Value<TSAValues>::Type, Alloc<> > >::VALUE));
+
+	TText text;
+	generateText(text, 10000);
+
+	CharString tempFilename = SEQAN_TEMP_FILENAME();
+    CharString textFilename = tempFilename;
+    append(textFilename, ".txt");
+
+    // The text is mapped from the file that open() reads it from.
+    TMMapText mmapText;
+    SEQAN_ASSERT(open(mmapText, toCString(textFilename), OPEN_RDWR | OPEN_CREATE));
+    mmapText = text;
+
+    {
+        TIndex indexSave(mmapText);
+        indexCreate(indexSave);
+        SEQAN_ASSERT(save(indexSave, toCString(tempFilename)));
+    }
+    close(mmapText);  // Truncates the file to the text length.
+
+    TIndex indexOpen;
+    SEQAN_ASSERT(open(indexOpen, toCString(tempFilename), OPEN_RDONLY));
+    SEQAN_ASSERT(indexText(indexOpen) == text);
+
+    Index<TText, FMIndex<TIndexSpec, TOptimization> > indexExpected(text);
+    Finder<Index<TText, FMIndex<TIndexSpec, TOptimization> > > saveFinder(indexExpected);
+    Finder<TIndex> openFinder(indexOpen);
+
+    for (unsigned i = 0; i + 10 < length(text); i += 500)
+    {
+        TString pattern = infix(text, i, i + 1 + i % 10);
+        clear(saveFinder);
+        clear(openFinder);
+
+        while(find(saveFinder, pattern))
+        {
+            SEQAN_ASSERT(find(openFinder, pattern));
+            SEQAN_ASSERT_EQ(position(openFinder), position(saveFinder));
+        }
+        SEQAN_ASSERT_NOT(find(openFinder, pattern));
+    }
+}
+
+template <typename TText, typename TIndexSpec, typename TOptimization>
+void fmIndexFindRanges(Index<TText, FMIndex<TIndexSpec, TOptimization> > /*tag*/)
+{
+	typedef Index<TText, FMIndex<TIndexSpec, TOptimization> > TIndex;
+	typedef typename Value<TIndex>::Type TAlphabet;
+    typedef String<TAlphabet> TString;
+
+	TText text;
+	generateText(text, 5000);
+
+    TIndex index(text);
+
+    // Patterns taken from the text, patterns which likely do not occur and the empty pattern.
+    StringSet<TString> patterns;
+    for (unsigned i = 0; i + 20 < length(text); i += 7)
+        appendValue(patterns, infix(text, i, i + 1 + i % 20));
+    for (unsigned i = 0; i + 40 < length(text); i += 301)
+    {
+        TString pattern = infix(text, i, i + 40);
+        reverse(pattern);
+        appendValue(patterns, pattern);
+    }
+    appendValue(patterns, TString());
+
+    String<Pair<unsigned> > ranges;
+    findRanges(ranges, index, patterns);
+    SEQAN_ASSERT_EQ(length(ranges), length(patterns));
+
+    for (unsigned i = 0; i < length(patterns); ++i)
+    {
+        // All occurrences of the pattern must be reported by the range, the empty pattern occurs at every suffix.
+        unsigned occurrences = 0;
+        for (unsigned j = 0; j + length(patterns[i]) <= length(text) && j < length(text); ++j)
+            if (infix(text, j, j + length(patterns[i])) == patterns[i])
+                ++occurrences;
+        SEQAN_ASSERT_EQ(ranges[i].i2 - ranges[i].i1, occurrences);
+
+        for (unsigned j = ranges[i].i1; j < ranges[i].i2; ++j)
+        {
+            unsigned pos = getFibre(index, FibreSA())[j];
+            SEQAN_ASSERT(infix(text, pos, pos + length(patterns[i])) == patterns[i]);
+        }
+    }
+}
+
 // A test for strings.
 SEQAN_DEFINE_TEST(test_fm_index_constructor)
 {
@@ -611,6 +757,14 @@ SEQAN_DEFINE_TEST(test_fm_index_search)
         fmIndexSearch(sCharTag);
         fmIndexSearch(charTag);
     }
+    {
+        Index<DnaString, FMIndex<IBM<>, void > > dnaTag;
+        Index<String<Dna5>, FMIndex<IBM<>, void > > dna5Tag;
+        Index<StringSet<DnaString>, FMIndex<IBM<>, void > > dnaSetTag;
+        fmIndexSearch(dnaTag);
+        fmIndexSearch(dna5Tag);
+        fmIndexSearch(dnaSetTag);
+    }
     {
         Index<StringSet<DnaString>, FMIndex<WT<>, void > > dnaTag;
         Index<StringSet<Dna5String>, FMIndex<WT<>, void > > dna5Tag;
@@ -668,6 +822,69 @@ SEQAN_DEFINE_TEST(test_fm_index_open_save)
     }    
 }
 
+SEQAN_DEFINE_TEST(test_fm_index_open_mmap)
+{
+    using namespace seqan;
+    {
+        Index<DnaString, FMIndex<WT<>, void > > dnaTag;
+        fmIndexOpenMMap(dnaTag);
+    }
+    {
+        Index<DnaString, FMIndex<SBM<>, void > > dnaTag;
+        fmIndexOpenMMap(dnaTag);
+    }
+    {
+        Index<DnaString, FMIndex<IBM<>, void > > dnaTag;
+        fmIndexOpenMMap(dnaTag);
+    }
+    {
+        Index<CharString, FMIndex<WT<>, void > > charTag;
+        fmIndexOpenMMap(charTag);
+    }
+}
+
+SEQAN_DEFINE_TEST(test_fm_index_save_open_mmap_text)
+{
+    using namespace seqan;
+    {
+        Index<DnaString, FMIndex<WT<>, void > > dnaTag;
+        fmIndexSaveOpenMMapText(dnaTag);
+    }
+    {
+        Index<DnaString, FMIndex<SBM<>, void > > dnaTag;
+        fmIndexSaveOpenMMapText(dnaTag);
+    }
+    {
+        Index<CharString, FMIndex<WT<>, void > > charTag;
+        fmIndexSaveOpenMMapText(charTag);
+    }
+}
+
+SEQAN_DEFINE_TEST(test_fm_index_find_ranges)
+{
+    using namespace seqan;
+    {
+        Index<DnaString, FMIndex<WT<>, void > > dnaTag;
+        fmIndexFindRanges(dnaTag);
+    }
+    {
+        Index<DnaString, FMIndex<SBM<>, void > > dnaTag;
+        fmIndexFindRanges(dnaTag);
+    }
+    {
+        Index<DnaString, FMIndex<IBM<>, void > > dnaTag;
+        fmIndexFindRanges(dnaTag);
+    }
+    {
+        Index<Dna5String, FMIndex<IBM<>, void > > dna5Tag;
+        fmIndexFindRanges(dna5Tag);
+    }
+    {
+        Index<CharString, FMIndex<WT<>, void > > charTag;
+        fmIndexFindRanges(charTag);
+    }
+}
+
 
 SEQAN_DEFINE_TEST(test_lf_table_lf_mapping)
 {
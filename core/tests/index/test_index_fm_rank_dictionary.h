@@ -56,9 +56,11 @@ typedef seqan::TagList<
             seqan::TagList<seqan::WaveletTree<signed char> >, seqan::TagList<
             seqan::TagList<seqan::SequenceBitMask<seqan::Dna> >, seqan::TagList<
             seqan::TagList<seqan::SequenceBitMask<seqan::Dna5> >, seqan::TagList<
-            seqan::TagList<seqan::SequenceBitMask<seqan::AminoAcid> >
+            seqan::TagList<seqan::SequenceBitMask<seqan::AminoAcid> >, seqan::TagList<
+            seqan::TagList<seqan::InterleavedBitMask<seqan::Dna> >, seqan::TagList<
+            seqan::TagList<seqan::InterleavedBitMask<seqan::Dna5> >
             > > > > > >
-            > > >
+            > > > > >
         RankDictionaryTestTypes;
 
 
@@ -239,6 +241,23 @@ void rankDictionaryGetFibre(RankDictionary<SequenceBitMask<TValue> > & /*tag*/)
 	SEQAN_ASSERT_EQ(length(getFibre(rankDictionary, FibreBitStrings())), 110u);
 }
 
+template <typename TValue>
+void rankDictionaryGetFibre(RankDictionary<InterleavedBitMask<TValue> > & /*tag*/)
+{
+    String<typename Value<RankDictionary<InterleavedBitMask<TValue> > >::Type> text = "ACGTNACGTNACGTN";
+	RankDictionary<InterleavedBitMask<TValue> > rankDictionary(text);
+
+    typename Fibre<RankDictionary<InterleavedBitMask<TValue> >, FibreBlocks>::Type & tempBlocks = getFibre(rankDictionary, FibreBlocks());
+
+	SEQAN_ASSERT_EQ(length(getFibre(rankDictionary, FibreBlocks())), 1u);
+
+    resize(tempBlocks, 110);
+
+	SEQAN_ASSERT_EQ(length(getFibre(rankDictionary, FibreBlocks())), 110u);
+    // The blocks are aligned to cache lines.
+	SEQAN_ASSERT_EQ((size_t)begin(getFibre(rankDictionary, FibreBlocks()), Standard()) % 64, 0u);
+}
+
 
 SEQAN_TYPED_TEST(RankDictionaryTestCommon, GetFibre)
 {
@@ -344,6 +363,9 @@ void _rankDictionaryFill(TRankDictionary & /*tag*/)
 template <typename TValue>
 void _rankDictionaryFill(RankDictionary<SequenceBitMask<TValue> > & /*tag*/) {}
 
+template <typename TValue>
+void _rankDictionaryFill(RankDictionary<InterleavedBitMask<TValue> > & /*tag*/) {}
+
 SEQAN_TYPED_TEST(RankDictionaryTestCommon, Fill)
 {
     using namespace seqan;
@@ -354,4 +354,30 @@ SEQAN_DEFINE_TEST(test_rsbs_open_save)
     SEQAN_ASSERT(bitString == openRsbs);
 }
 
+SEQAN_DEFINE_TEST(test_rsbs_open_mmap)
+{
+    unsigned _length = 100000;
+    RankSupportBitString<> bitString;
+
+    Rng<MersenneTwister> rng(SEED);
+    for (unsigned i = 0; i < _length; ++i)
+    {
+        bool bit = pickRandomNumber(rng) % 2;
+    	appendValue(bitString, bit);
+    }
+
+    CharString tempFilename = SEQAN_TEMP_FILENAME();
+    save(bitString, toCString(tempFilename));
+
+    RankSupportBitString<MMap<> > mmapRsbs;
+    SEQAN_ASSERT(open(mmapRsbs, toCString(tempFilename), OPEN_RDONLY));
+
+    SEQAN_ASSERT_EQ(length(mmapRsbs), length(bitString));
+    for (unsigned i = 0; i < _length; ++i)
+    {
+        SEQAN_ASSERT_EQ(isBitSet(mmapRsbs, i), isBitSet(bitString, i));
+        SEQAN_ASSERT_EQ(getRank(mmapRsbs, i), getRank(bitString, i));
+    }
+}
+
 #endif  // TEST_INDEX_FM_RANK_SUPPORT_BIT_STRING_H_
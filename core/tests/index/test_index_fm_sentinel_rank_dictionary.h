@@ -64,11 +64,15 @@ typedef seqan::TagList<
             seqan::TagList<SentinelRankDictionary<RankDictionary<seqan::WaveletTree<signed char> >, Sentinels> >, seqan::TagList<
             seqan::TagList<SentinelRankDictionary<RankDictionary<seqan::SequenceBitMask<seqan::Dna> >, Sentinels> >, seqan::TagList<
             seqan::TagList<SentinelRankDictionary<RankDictionary<seqan::SequenceBitMask<seqan::Dna5> >, Sentinels> >, seqan::TagList<
-            seqan::TagList<SentinelRankDictionary<RankDictionary<seqan::SequenceBitMask<seqan::AminoAcid> >, Sentinels> >
+            seqan::TagList<SentinelRankDictionary<RankDictionary<seqan::SequenceBitMask<seqan::AminoAcid> >, Sentinels> >, seqan::TagList<
+            seqan::TagList<SentinelRankDictionary<RankDictionary<seqan::InterleavedBitMask<seqan::Dna> >, Sentinel> >, seqan::TagList<
+            seqan::TagList<SentinelRankDictionary<RankDictionary<seqan::InterleavedBitMask<seqan::Dna5> >, Sentinel> >, seqan::TagList<
+            seqan::TagList<SentinelRankDictionary<RankDictionary<seqan::InterleavedBitMask<seqan::Dna> >, Sentinels> >, seqan::TagList<
+            seqan::TagList<SentinelRankDictionary<RankDictionary<seqan::InterleavedBitMask<seqan::Dna5> >, Sentinels> >
             > > > > > >
             > > >
             > > > > > >
-            > > >
+            > > > > > > >
         SentinelRankDictionaryTestTypes;
 
 
@@ -40,6 +40,8 @@
 #include <seqan/sequence.h>
 #include <seqan/random.h>
 
+#include <set>
+
 using namespace seqan;
 
 template <typename TIter>
@@ -599,6 +601,223 @@ SEQAN_DEFINE_TEST(fm_index_iterator_range)
 }
 
 
+// Helpers to treat strings and string sets alike in the bidirectional index tests.
+template <typename TPattern, typename TText>
+void _fmIndexBidirectionalInfix(TPattern & pattern, TText const & text, unsigned patternLength,
+                                Rng<MersenneTwister> & rng)
+{
+    unsigned beginPos = pickRandomNumber(rng) % (length(text) - patternLength);
+    pattern = infix(text, beginPos, beginPos + patternLength);
+}
+
+template <typename TPattern, typename TString, typename TSpec>
+void _fmIndexBidirectionalInfix(TPattern & pattern, StringSet<TString, TSpec> const & text, unsigned patternLength,
+                                Rng<MersenneTwister> & rng)
+{
+    unsigned seqNo = 0;
+    do
+        seqNo = pickRandomNumber(rng) % length(text);
+    while (length(text[seqNo]) <= patternLength);
+    _fmIndexBidirectionalInfix(pattern, text[seqNo], patternLength, rng);
+}
+
+// Collects the positions in text where pattern occurs with at most maxErrors mismatches.
+template <typename TOccurrences, typename TText, typename TPattern>
+void _fmIndexBidirectionalNaiveFind(TOccurrences & occurrences, TText const & text, TPattern const & pattern,
+                                    unsigned maxErrors)
+{
+    for (unsigned j = 0; j + length(pattern) <= length(text); ++j)
+    {
+        unsigned errors = 0;
+        for (unsigned k = 0; k < length(pattern) && errors <= maxErrors; ++k)
+            if (text[j + k] != pattern[k])
+                ++errors;
+        if (errors <= maxErrors)
+            occurrences.insert(j);
+    }
+}
+
+template <typename TOccurrences, typename TString, typename TSpec, typename TPattern>
+void _fmIndexBidirectionalNaiveFind(TOccurrences & occurrences, StringSet<TString, TSpec> const & text,
+                                    TPattern const & pattern, unsigned maxErrors)
+{
+    typedef typename TOccurrences::value_type TPos;
+
+    for (unsigned seqNo = 0; seqNo < length(text); ++seqNo)
+    {
+        std::set<unsigned> seqOccurrences;
+        _fmIndexBidirectionalNaiveFind(seqOccurrences, text[seqNo], pattern, maxErrors);
+        for (std::set<unsigned>::const_iterator it = seqOccurrences.begin(); it != seqOccurrences.end(); ++it)
+            occurrences.insert(TPos(seqNo, *it));
+    }
+}
+
+template <typename TIndexSpec, typename TText>
+void fmIndexBidirectionalExtend(TText & text)
+{
+    typedef Index<TText, BidirectionalIndex<TIndexSpec> > TIndex;
+    typedef typename Iterator<TIndex, TopDown<> >::Type TIter;
+    typedef Index<TText, TIndexSpec> TFmIndex;
+    typedef typename Iterator<TFmIndex, TopDown<> >::Type TFmIter;
+    typedef typename Value<TFmIndex>::Type TChar;
+    typedef String<TChar> TPattern;
+    typedef typename SAValue<TText>::Type TPos;
+
+    TText revText = text;
+    reverse(revText);
+
+    TIndex index(text);
+    TFmIndex revIndex(revText);
+    TIter it(index);
+    TFmIter revIt(revIndex);
+
+    SEQAN_ASSERT_EQ(isRoot(it), true);
+    SEQAN_ASSERT_EQ(countOccurrences(it), lengthSum(text));
+
+    Rng<MersenneTwister> rng(SEED);
+    for (unsigned i = 0; i < 200; ++i)
+    {
+        // Half of the patterns are substrings of the text, the other half are random.
+        unsigned patternLength = 1 + pickRandomNumber(rng) % 8;
+        TPattern pattern;
+        if (i % 2 == 0)
+        {
+            _fmIndexBidirectionalInfix(pattern, text, patternLength, rng);
+        }
+        else
+        {
+            for (unsigned j = 0; j < patternLength; ++j)
+                appendValue(pattern, TChar(pickRandomNumber(rng) % ValueSize<TChar>::VALUE));
+        }
+
+        // Start in the middle of the pattern and extend alternately to the left and to the right.
+        goRoot(it);
+        unsigned left = patternLength / 2;
+        unsigned right = left;
+        bool found = true;
+        for (unsigned j = 0; found && j < patternLength; ++j)
+        {
+            if ((j % 2 == 0 && right < patternLength) || left == 0)
+                found = extendRight(it, pattern[right++]);
+            else
+                found = extendLeft(it, pattern[--left]);
+        }
+
+        std::set<TPos> expected;
+        _fmIndexBidirectionalNaiveFind(expected, text, pattern, 0u);
+
+        SEQAN_ASSERT_EQ(found, !expected.empty());
+        if (!found)
+            continue;
+
+        SEQAN_ASSERT_EQ(repLength(it), patternLength);
+        SEQAN_ASSERT_EQ(countOccurrences(it), expected.size());
+        std::set<TPos> occurrences;
+        for (unsigned j = 0; j < length(getOccurrences(it)); ++j)
+            occurrences.insert(getOccurrences(it)[j]);
+        SEQAN_ASSERT(occurrences == expected);
+
+        // The range in the index of the reversed text must be the one of the reversed pattern.
+        // Note that goDown() prepends the characters, i.e. it searches the reversed pattern.
+        goRoot(revIt);
+        SEQAN_ASSERT(goDown(revIt, pattern));
+        SEQAN_ASSERT_EQ(it.revRange.i1, range(revIt).i1);
+        SEQAN_ASSERT_EQ(it.revRange.i2, range(revIt).i2);
+
+        // Extending by a whole pattern is the same as extending character by character.
+        TIter patternIt(index);
+        SEQAN_ASSERT(extendLeft(patternIt, suffix(pattern, patternLength / 2)));
+        SEQAN_ASSERT(extendLeft(patternIt, prefix(pattern, patternLength / 2)));
+        SEQAN_ASSERT_EQ(patternIt.fwdRange, it.fwdRange);
+        SEQAN_ASSERT_EQ(patternIt.revRange, it.revRange);
+        goRoot(patternIt);
+        SEQAN_ASSERT(extendRight(patternIt, pattern));
+        SEQAN_ASSERT_EQ(patternIt.fwdRange, it.fwdRange);
+        SEQAN_ASSERT_EQ(patternIt.revRange, it.revRange);
+    }
+}
+
+template <typename TIter, typename TPos>
+struct FmIndexBidirectionalDelegate_
+{
+    std::set<TPos> positions;
+
+    void operator()(TIter const & it, unsigned /*errors*/)
+    {
+        for (unsigned i = 0; i < length(getOccurrences(it)); ++i)
+            positions.insert(getOccurrences(it)[i]);
+    }
+};
+
+template <typename TIndexSpec, typename TText>
+void fmIndexBidirectionalFindMismatches(TText & text)
+{
+    typedef Index<TText, BidirectionalIndex<TIndexSpec> > TIndex;
+    typedef typename Iterator<TIndex, TopDown<> >::Type TIter;
+    typedef typename Value<Index<TText, TIndexSpec> >::Type TChar;
+    typedef String<TChar> TPattern;
+    typedef typename SAValue<TText>::Type TPos;
+
+    TIndex index(text);
+
+    Rng<MersenneTwister> rng(SEED);
+    for (unsigned maxErrors = 0; maxErrors <= 4; ++maxErrors)
+    {
+        for (unsigned i = 0; i < 20; ++i)
+        {
+            unsigned patternLength = 3 + pickRandomNumber(rng) % 20;
+            TPattern pattern;
+            _fmIndexBidirectionalInfix(pattern, text, patternLength, rng);
+            for (unsigned j = 0; j < maxErrors; ++j)
+                pattern[pickRandomNumber(rng) % patternLength] = TChar(pickRandomNumber(rng) % ValueSize<TChar>::VALUE);
+
+            FmIndexBidirectionalDelegate_<TIter, TPos> delegate;
+            findMismatches(index, pattern, maxErrors, delegate);
+
+            std::set<TPos> expected;
+            _fmIndexBidirectionalNaiveFind(expected, text, pattern, maxErrors);
+
+            SEQAN_ASSERT(delegate.positions == expected);
+        }
+    }
+}
+
+SEQAN_DEFINE_TEST(fm_index_bidirectional_extend)
+{
+    using namespace seqan;
+
+    DnaString dnaText;
+    generateText(dnaText, 5000);
+    fmIndexBidirectionalExtend<FMIndex<WT<>, void> >(dnaText);
+    fmIndexBidirectionalExtend<FMIndex<SBM<>, void> >(dnaText);
+    fmIndexBidirectionalExtend<FMIndex<IBM<>, void> >(dnaText);
+
+    Dna5String dna5Text;
+    generateText(dna5Text, 5000);
+    fmIndexBidirectionalExtend<FMIndex<WT<>, void> >(dna5Text);
+
+    // The index of a string set reverses each string and counts the sentinels of all strings.
+    StringSet<DnaString> dnaSet;
+    generateText(dnaSet, 6);
+    fmIndexBidirectionalExtend<FMIndex<WT<>, void> >(dnaSet);
+    fmIndexBidirectionalExtend<FMIndex<SBM<>, void> >(dnaSet);
+    fmIndexBidirectionalExtend<FMIndex<IBM<>, void> >(dnaSet);
+}
+
+SEQAN_DEFINE_TEST(fm_index_bidirectional_find_mismatches)
+{
+    using namespace seqan;
+
+    DnaString dnaText;
+    generateText(dnaText, 2000);
+    fmIndexBidirectionalFindMismatches<FMIndex<WT<>, void> >(dnaText);
+    fmIndexBidirectionalFindMismatches<FMIndex<IBM<>, void> >(dnaText);
+
+    StringSet<DnaString> dnaSet;
+    generateText(dnaSet, 4);
+    fmIndexBidirectionalFindMismatches<FMIndex<WT<>, void> >(dnaSet);
+    fmIndexBidirectionalFindMismatches<FMIndex<IBM<>, void> >(dnaSet);
+}
 
 #endif // TEST_FM_INDEX_ITERATOR_BETA_H_
 
@@ -60,6 +60,8 @@ SEQAN_BEGIN_TESTSUITE(test_index)
 	SEQAN_CALL_TEST(testUngappedShapes);
 	SEQAN_CALL_TEST(testUngappedQGramIndex);
 	SEQAN_CALL_TEST(testUngappedQGramIndexMulti);
+	SEQAN_CALL_TEST(testQGramIndexParallel);
+	SEQAN_CALL_TEST(testQGramIndexMinimizer);
 	SEQAN_CALL_TEST(testQGramFind);
 }
 SEQAN_END_TESTSUITE
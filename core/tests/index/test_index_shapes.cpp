@@ -56,5 +56,6 @@ using namespace seqan;
 SEQAN_BEGIN_TESTSUITE(test_index)
 {
 	SEQAN_CALL_TEST(testShapes);
+	SEQAN_CALL_TEST(testShapesPackedHash);
 }
 SEQAN_END_TESTSUITE
@@ -1,6 +1,7 @@
 #include <seqan/basic.h>
 #include <seqan/index.h>
 #include <seqan/sequence.h>
+#include <seqan/random.h>
 
 // Test SWIFT finder with empty pattern.
 SEQAN_DEFINE_TEST(test_index_swift_find_empty_pattern)
@@ -29,8 +30,100 @@ SEQAN_DEFINE_TEST(test_index_swift_find_empty_pattern)
         continue;
 }
 
+template <typename THit>
+struct SwiftHitLess_
+{
+    bool operator() (THit const &a, THit const &b) const
+    {
+        if (a.hstkPos != b.hstkPos) return a.hstkPos < b.hstkPos;
+        return a.ndlSeqNo < b.ndlSeqNo;
+    }
+};
+
+template <typename TSwiftSpec>
+void testIndexSwiftParallel(unsigned minLength)
+{
+    using namespace seqan;
+
+    typedef StringSet<DnaString> TReadSet;
+    typedef Index<TReadSet, IndexQGram<UngappedShape<11>, OpenAddressing> > TQGramIndex;
+    typedef Pattern<TQGramIndex, Swift<TSwiftSpec> > TSwiftPattern;
+    typedef Finder<DnaString, Swift<TSwiftSpec> > TSwiftFinder;
+    typedef typename TSwiftFinder::THitString THitString;
+    typedef typename Value<THitString>::Type THit;
+
+    Rng<MersenneTwister> rng(42);
+
+    DnaString genome;
+    resize(genome, 100000);
+    for (unsigned i = 0; i < length(genome); ++i)
+        genome[i] = Dna(pickRandomNumber(rng) % 4);
+
+    // reads sampled from the genome with a few substitutions
+    TReadSet reads;
+    for (unsigned i = 0; i < 50; ++i)
+    {
+        unsigned pos = pickRandomNumber(rng) % (length(genome) - 100);
+        DnaString read = infix(genome, pos, pos + 100);
+        for (unsigned j = 0; j < 3; ++j)
+            read[pickRandomNumber(rng) % 100] = Dna(pickRandomNumber(rng) % 4);
+        appendValue(reads, read);
+    }
+
+    // reference: hits of the classic interface
+    TQGramIndex index(reads);
+    TSwiftPattern pattern(index);
+    TSwiftFinder finder(genome);
+    THitString refHits;
+    while (find(finder, pattern, 0.05, minLength))
+        appendValue(refHits, *finder.curHit);
+
+    for (int parallel = 0; parallel < 2; ++parallel)
+    {
+        TQGramIndex index2(reads);
+        TSwiftPattern pattern2(index2);
+        TSwiftFinder finder2(genome);
+        if (parallel)
+        {
+            // Force several threads so the genome is actually partitioned on any machine.
+            int numThreads = omp_get_max_threads();
+            omp_set_num_threads(4);
+            windowFindAll(finder2, pattern2, 0.05, minLength, Parallel());
+            omp_set_num_threads(numThreads);
+        }
+        else
+            windowFindAll(finder2, pattern2, 0.05, minLength, Serial());
+
+        THitString hits = getWindowFindHits(finder2);
+        SEQAN_ASSERT_EQ(length(hits), length(refHits));
+        std::sort(begin(hits, Standard()), end(hits, Standard()), SwiftHitLess_<THit>());
+        THitString sortedRefHits = refHits;
+        std::sort(begin(sortedRefHits, Standard()), end(sortedRefHits, Standard()), SwiftHitLess_<THit>());
+        for (unsigned i = 0; i < length(hits); ++i)
+        {
+            SEQAN_ASSERT_EQ(hits[i].hstkPos, sortedRefHits[i].hstkPos);
+            SEQAN_ASSERT_EQ(hits[i].ndlSeqNo, sortedRefHits[i].ndlSeqNo);
+            SEQAN_ASSERT_EQ(hits[i].bucketWidth, sortedRefHits[i].bucketWidth);
+        }
+    }
+    SEQAN_ASSERT_GEQ(length(refHits), 50u);
+}
+
+// Test that the partitioned SWIFT filter finds the same hits as the serial one.
+SEQAN_DEFINE_TEST(test_index_swift_parallel_semi_global)
+{
+    testIndexSwiftParallel<seqan::SwiftSemiGlobal>(0);
+}
+
+SEQAN_DEFINE_TEST(test_index_swift_parallel_local)
+{
+    testIndexSwiftParallel<seqan::SwiftLocal>(50);
+}
+
 SEQAN_BEGIN_TESTSUITE(test_index_swift)
 {
 	SEQAN_CALL_TEST(test_index_swift_find_empty_pattern);
+	SEQAN_CALL_TEST(test_index_swift_parallel_semi_global);
+	SEQAN_CALL_TEST(test_index_swift_parallel_local);
 }
 SEQAN_END_TESTSUITE
@@ -321,6 +321,175 @@ SEQAN_DEFINE_TEST(testUngappedQGramIndexMulti)
 }
 
 
+template <typename TIndex>
+void _testQGramIndexParallel(typename Fibre<TIndex, QGramText>::Type const &text, unsigned stepSize)
+{
+	TIndex refIndex(text);
+	TIndex testIndex(text);
+	setStepSize(refIndex, stepSize);
+	setStepSize(testIndex, stepSize);
+
+	indexCreate(refIndex, QGramSADir(), Default());
+	indexCreate(testIndex, QGramSADir(), Parallel());
+
+	SEQAN_ASSERT_EQ(length(indexDir(refIndex)), length(indexDir(testIndex)));
+	SEQAN_ASSERT_EQ(length(indexSA(refIndex)), length(indexSA(testIndex)));
+	for (unsigned i = 0; i < length(indexDir(refIndex)); ++i)
+		SEQAN_ASSERT_EQ_MSG(dirAt(i, refIndex), dirAt(i, testIndex), "i is %d", i);
+	for (unsigned i = 0; i < length(indexSA(refIndex)); ++i)
+		SEQAN_ASSERT_EQ_MSG(saAt(i, refIndex), saAt(i, testIndex), "i is %d", i);
+}
+
+SEQAN_DEFINE_TEST(testQGramIndexParallel)
+{
+	typedef Index<DnaString, IndexQGram<UngappedShape<5> > >                TIndex;
+	typedef Index<DnaString, IndexQGram<GappedShape<HardwiredShape<1, 2> > > > TGappedIndex;
+	typedef Index<StringSet<DnaString>, IndexQGram<UngappedShape<3> > >     TMultiIndex;
+
+	DnaString text;
+	resize(text, 20000);
+	for (unsigned i = 0; i < length(text); ++i)
+		text[i] = Dna(pickRandomNumber(getRng()) % 4);
+
+	StringSet<DnaString> strings;
+	for (unsigned i = 0; i < 200; ++i)
+	{
+		DnaString seq;
+		resize(seq, (i * 37) % 151);                // includes empty and shorter than q sequences
+		for (unsigned j = 0; j < length(seq); ++j)
+			seq[j] = Dna(pickRandomNumber(getRng()) % 4);
+		appendValue(strings, seq);
+	}
+
+	// Force several threads so the parallel code path is taken on any machine.
+	int numThreads = omp_get_max_threads();
+	omp_set_num_threads(4);
+	for (unsigned stepSize = 1; stepSize <= 3; stepSize += 2)
+	{
+		_testQGramIndexParallel<TIndex>(text, stepSize);
+		_testQGramIndexParallel<TGappedIndex>(text, stepSize);
+		_testQGramIndexParallel<TMultiIndex>(strings, stepSize);
+	}
+	omp_set_num_threads(numThreads);
+}
+
+template <typename TPos>
+inline void _testMinimizerPos(TPos &pos, unsigned, unsigned i)
+{
+	pos = i;
+}
+
+template <typename T1, typename T2, typename TPack>
+inline void _testMinimizerPos(Pair<T1, T2, TPack> &pos, unsigned seqNo, unsigned i)
+{
+	pos = Pair<T1, T2, TPack>(seqNo, i);
+}
+
+template <typename TIndex, typename TText>
+void _testQGramIndexMinimizer(TText const &text, unsigned windowSize)
+{
+	typedef typename Fibre<TIndex, QGramSA>::Type   TSA;
+	typedef typename Value<TSA>::Type               TSAValue;
+	typedef typename Fibre<TIndex, QGramShape>::Type TShape;
+
+	TIndex index(text);
+	indexRequire(index, QGramSADir());
+	TShape shape = indexShape(index);
+
+	// brute force: the leftmost k-mer of smallest rank in every window
+	String<TSAValue> expected;
+	for (unsigned seqNo = 0; seqNo < countSequences(index); ++seqNo)
+	{
+		unsigned seqLength = sequenceLength(seqNo, text);
+		if (seqLength < length(shape)) continue;
+		unsigned kmerCount = seqLength - length(shape) + 1;
+		unsigned windows = (kmerCount > windowSize)? kmerCount - windowSize + 1: 1;
+		for (unsigned j = 0; j < windows; ++j)
+		{
+			TSAValue best;
+			__uint64 bestRank = 0;
+			for (unsigned i = j; i < j + windowSize && i < kmerCount; ++i)
+			{
+				TSAValue pos;
+				_testMinimizerPos(pos, seqNo, i);
+				__uint64 rank = _minimizerRank(hash(shape, begin(suffix(text, pos), Standard())));
+				if (i == j || rank < bestRank)
+				{
+					best = pos;
+					bestRank = rank;
+				}
+			}
+			if (empty(expected) || back(expected) != best)
+				appendValue(expected, best);
+		}
+	}
+
+	// every minimizer is stored once in the bucket of its k-mer
+	SEQAN_ASSERT_EQ(length(indexSA(index)), length(expected));
+	for (unsigned bkt = 0; bkt + 1 < length(indexDir(index)); ++bkt)
+		for (unsigned i = dirAt(bkt, index); i < dirAt(bkt + 1, index); ++i)
+			SEQAN_ASSERT_EQ(hash(shape, begin(suffix(text, saAt(i, index)), Standard())), bkt);
+	TSA sa = indexSA(index);
+	std::sort(begin(sa, Standard()), end(sa, Standard()));
+	for (unsigned i = 0; i < length(expected); ++i)
+		SEQAN_ASSERT_EQ_MSG(sa[i], expected[i], "i is %d", i);
+
+	// pattern lookup finds the same occurrences as an online search
+	for (unsigned i = 0; i < length(expected); i += 37)
+	{
+		TSAValue pos = expected[i];
+		if (getSeqOffset(pos) + 12 > sequenceLength(getSeqNo(pos), text)) continue;
+		DnaString pattern = infix(text, pos, posAdd(pos, 12));
+
+		String<TSAValue> occs;
+		getOccurrences(occs, index, pattern);
+		std::sort(begin(occs, Standard()), end(occs, Standard()));
+
+		String<TSAValue> refOccs;
+		for (unsigned seqNo = 0; seqNo < countSequences(index); ++seqNo)
+			for (unsigned j = 0; j + 12 <= sequenceLength(seqNo, text); ++j)
+			{
+				TSAValue occ;
+				_testMinimizerPos(occ, seqNo, j);
+				if (infix(text, occ, posAdd(occ, 12)) == pattern)
+					appendValue(refOccs, occ);
+			}
+
+		SEQAN_ASSERT_EQ(length(occs), length(refOccs));
+		for (unsigned j = 0; j < length(refOccs); ++j)
+			SEQAN_ASSERT_EQ(occs[j], refOccs[j]);
+	}
+}
+
+SEQAN_DEFINE_TEST(testQGramIndexMinimizer)
+{
+	typedef Index<DnaString, IndexQGram<UngappedShape<4>, Minimizer<5> > >              TIndex;
+	typedef Index<StringSet<DnaString>, IndexQGram<UngappedShape<4>, Minimizer<5> > >   TMultiIndex;
+
+	DnaString text;
+	resize(text, 5000);
+	for (unsigned i = 0; i < length(text); ++i)
+		text[i] = Dna(pickRandomNumber(getRng()) % 4);
+
+	StringSet<DnaString> strings;
+	for (unsigned i = 0; i < 50; ++i)
+	{
+		DnaString seq;
+		resize(seq, (i * 37) % 151);                // includes sequences shorter than a window
+		for (unsigned j = 0; j < length(seq); ++j)
+			seq[j] = Dna(pickRandomNumber(getRng()) % 4);
+		appendValue(strings, seq);
+	}
+
+	_testQGramIndexMinimizer<TIndex>(text, 5);
+	_testQGramIndexMinimizer<TMultiIndex>(strings, 5);
+
+	// the index is much smaller than a full q-gram index
+	TIndex index(text);
+	indexRequire(index, QGramSA());
+	SEQAN_ASSERT_LT(length(indexSA(index)), length(text) / 2);
+}
+
 //////////////////////////////////////////////////////////////////////////////
 
 SEQAN_DEFINE_TEST(testQGramFind)
@@ -137,6 +137,37 @@ SEQAN_DEFINE_TEST(testShapes)
     testHashInit(shapeC);
 }
 
+SEQAN_DEFINE_TEST(testShapesPackedHash)
+{
+	DnaString dna;
+	for (unsigned i = 0; i < 200; ++i)
+		appendValue(dna, Dna((i * 7 + i / 11) % 4));
+	String<Dna, Packed<> > packed = dna;
+
+	// q-grams are extracted from packed words, compare with the unpacked string
+	for (unsigned span = 1; span <= 32; ++span)
+	{
+		Shape<Dna, SimpleShape> shape(span), packedShape(span);
+		for (unsigned i = 0; i + span <= length(dna); ++i)
+		{
+			SEQAN_ASSERT_EQ(hash(shape, begin(dna) + i), hash(packedShape, begin(packed) + i));
+			if (i + span < length(dna))
+				SEQAN_ASSERT_EQ(hashNext(shape, begin(dna) + i + 1), hashNext(packedShape, begin(packed) + i + 1));
+		}
+	}
+
+	Shape<Dna, UngappedShape<12> > shape, packedShape;
+	for (unsigned i = 0; i + 12 <= length(dna); ++i)
+		SEQAN_ASSERT_EQ(hash(shape, begin(dna) + i), hash(packedShape, begin(packed) + i));
+
+	// Dna5 has no power of two alphabet size and is hashed value by value
+	Dna5String dna5 = "ACGTNACGTNNACGT";
+	String<Dna5, Packed<> > packed5 = dna5;
+	Shape<Dna5, SimpleShape> shape5(5), packedShape5(5);
+	for (unsigned i = 0; i + 5 <= length(dna5); ++i)
+		SEQAN_ASSERT_EQ(hash(shape5, begin(dna5) + i), hash(packedShape5, begin(packed5) + i));
+}
+
 //////////////////////////////////////////////////////////////////////////////
 
 
@@ -204,6 +204,36 @@ SEQAN_DEFINE_TEST(test_modifer_shortcuts_reverse_complement_in_place_string)
     SEQAN_ASSERT_EQ(kExpectedResult, str);
 }
 
+SEQAN_DEFINE_TEST(test_modifer_shortcuts_reverse_complement_in_place_packed_string)
+{
+    typedef seqan::String<seqan::Dna, seqan::Packed<> > TPackedDnaString;
+    typedef seqan::String<seqan::Rna, seqan::Packed<> > TPackedRnaString;
+
+    // Cover lengths around multiples of the 32 values per packed word.
+    seqan::DnaString str;
+    for (unsigned len = 0; len < 100; ++len)
+    {
+        seqan::DnaString expected = str;
+        reverseComplement(expected);
+
+        TPackedDnaString packed = str;
+        reverseComplement(packed);
+        SEQAN_ASSERT_EQ(expected, packed);
+
+        seqan::RnaString rnaExpected = expected;
+        TPackedRnaString rnaPacked = str;
+        reverseComplement(rnaPacked);
+        SEQAN_ASSERT_EQ(rnaExpected, rnaPacked);
+
+        appendValue(str, seqan::Dna((len * 5 + len / 7) % 4));
+    }
+
+    // Dna5 is complemented value by value.
+    seqan::String<seqan::Dna5, seqan::Packed<> > packed5 = "CGATN";
+    reverseComplement(packed5);
+    SEQAN_ASSERT_EQ(seqan::Dna5String("NATCG"), packed5);
+}
+
 SEQAN_DEFINE_TEST(test_modifer_shortcuts_reverse_complement_in_place_string_set)
 {
     seqan::Dna5String str1 = "CCGGTTAANN";
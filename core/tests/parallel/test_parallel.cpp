@@ -46,6 +46,7 @@
 #include "test_parallel_atomic_misc.h"
 #include "test_parallel_splitting.h"
 #include "test_parallel_algorithms.h"
+#include "test_parallel_work_stealing.h"
 
 SEQAN_BEGIN_TESTSUITE(test_parallel) {
 #if defined(_OPENMP)
@@ -78,5 +79,9 @@ SEQAN_BEGIN_TESTSUITE(test_parallel) {
     SEQAN_CALL_TEST(test_parallel_splitting_compute_splitters);
     SEQAN_CALL_TEST(test_parallel_sum);
     SEQAN_CALL_TEST(test_parallel_partial_sum);
+
+    SEQAN_CALL_TEST(test_parallel_work_stealing_deque);
+    SEQAN_CALL_TEST(test_parallel_work_stealing_spawn);
+    SEQAN_CALL_TEST(test_parallel_work_stealing_nested);
 }
 SEQAN_END_TESTSUITE
@@ -0,0 +1,214 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Author: agent <agent@local>
+// ==========================================================================
+// Tests for the work-stealing deque and task pool.
+// ==========================================================================
+
+#ifndef TEST_PARALLEL_TEST_PARALLEL_WORK_STEALING_H_
+#define TEST_PARALLEL_TEST_PARALLEL_WORK_STEALING_H_
+
+#include <seqan/basic.h>
+#include <seqan/sequence.h>
+#include <seqan/parallel.h>
+
+// Marks a slot as done, used to check that every task is executed exactly once.
+struct TestWorkStealingMark_
+{
+    unsigned volatile * slot;
+
+    void operator()() const
+    {
+        seqan::atomicInc(*slot);
+    }
+};
+
+// Recursively splits an interval and sums up its values in nested task groups.
+struct TestWorkStealingSum_
+{
+    typedef seqan::Size<seqan::String<unsigned> >::Type TSize;
+
+    seqan::WorkStealingPool * pool;
+    seqan::String<unsigned> const * values;
+    TSize beginPos;
+    TSize endPos;
+    __int64 * result;
+
+    void operator()() const
+    {
+        using namespace seqan;
+
+        if (endPos - beginPos <= 16u)
+        {
+            __int64 sum = 0;
+            for (TSize i = beginPos; i < endPos; ++i)
+                sum += (*values)[i];
+            *result = sum;
+            return;
+        }
+
+        __int64 left = 0, right = 0;
+        TSize midPos = beginPos + (endPos - beginPos) / 2;
+        TestWorkStealingSum_ leftTask = { pool, values, beginPos, midPos, &left };
+        TestWorkStealingSum_ rightTask = { pool, values, midPos, endPos, &right };
+
+        WorkStealingGroup group;
+        spawn(*pool, group, leftTask);
+        spawn(*pool, group, rightTask);
+        wait(*pool, group);
+        *result = left + right;
+    }
+};
+
+SEQAN_DEFINE_TEST(test_parallel_work_stealing_deque)
+{
+    using namespace seqan;
+
+    // Serial LIFO behaviour at the back, FIFO at the front, growing the buffer.
+    WorkStealingDeque<unsigned> deque(4);
+    unsigned val = 0;
+    SEQAN_ASSERT(empty(deque));
+    SEQAN_ASSERT_NOT(tryPopBack(val, deque));
+    SEQAN_ASSERT_NOT(trySteal(val, deque));
+
+    for (unsigned i = 0; i < 100; ++i)
+        appendValue(deque, i);
+    SEQAN_ASSERT_EQ(length(deque), 100);
+
+    SEQAN_ASSERT(trySteal(val, deque));
+    SEQAN_ASSERT_EQ(val, 0u);
+    SEQAN_ASSERT(tryPopBack(val, deque));
+    SEQAN_ASSERT_EQ(val, 99u);
+    SEQAN_ASSERT(trySteal(val, deque));
+    SEQAN_ASSERT_EQ(val, 1u);
+    for (unsigned i = 98; i >= 2; --i)
+    {
+        SEQAN_ASSERT(tryPopBack(val, deque));
+        SEQAN_ASSERT_EQ(val, i);
+    }
+    SEQAN_ASSERT(empty(deque));
+    SEQAN_ASSERT_NOT(tryPopBack(val, deque));
+
+    // The owner appends and pops while the other threads steal, every element must be taken exactly once.
+    unsigned const COUNT = 100000;
+    String<unsigned> taken;
+    resize(taken, COUNT, 0u);
+    bool volatile finished = false;
+
+    SEQAN_OMP_PRAGMA(parallel)
+    {
+        if (getThreadId() == 0u)
+        {
+            unsigned x = 0;
+            for (unsigned i = 0; i < COUNT; ++i)
+            {
+                appendValue(deque, i);
+                if (i % 3 == 0 && tryPopBack(x, deque))
+                    atomicInc(taken[x]);
+            }
+            while (tryPopBack(x, deque))
+                atomicInc(taken[x]);
+            finished = true;
+        }
+        else
+        {
+            unsigned x = 0;
+            while (!finished || !empty(deque))
+                if (trySteal(x, deque))
+                    atomicInc(taken[x]);
+        }
+    }
+
+    for (unsigned i = 0; i < COUNT; ++i)
+        SEQAN_ASSERT_EQ(taken[i], 1u);
+}
+
+SEQAN_DEFINE_TEST(test_parallel_work_stealing_spawn)
+{
+    using namespace seqan;
+
+    unsigned const COUNT = 10000;
+    String<unsigned> done;
+    resize(done, COUNT, 0u);
+
+    WorkStealingPool pool;
+    WorkStealingGroup group;
+    for (unsigned i = 0; i < COUNT; ++i)
+    {
+        TestWorkStealingMark_ task = { &done[i] };
+        spawn(pool, group, task);
+    }
+    wait(pool, group);
+
+    SEQAN_ASSERT_EQ(group.pending, 0);
+    for (unsigned i = 0; i < COUNT; ++i)
+        SEQAN_ASSERT_EQ(done[i], 1u);
+
+    // The pool can be reused, waiting for an empty group returns immediately.
+    wait(pool, group);
+    TestWorkStealingMark_ task = { &done[0] };
+    spawn(pool, group, task);
+    wait(pool, group);
+    SEQAN_ASSERT_EQ(done[0], 2u);
+}
+
+SEQAN_DEFINE_TEST(test_parallel_work_stealing_nested)
+{
+    using namespace seqan;
+
+    String<unsigned> values;
+    __int64 expected = 0;
+    for (unsigned i = 0; i < 100000; ++i)
+    {
+        appendValue(values, (i * 7919u) % 1000u);
+        expected += back(values);
+    }
+
+    // Use more threads than available cores to exercise the stealing.
+    WorkStealingPool pool(4);
+    WorkStealingGroup group;
+    __int64 result = 0;
+    TestWorkStealingSum_ task = { &pool, &values, 0u, length(values), &result };
+    spawn(pool, group, task);
+    wait(pool, group);
+    SEQAN_ASSERT_EQ(result, expected);
+
+    // A pool with a single thread executes the tasks serially.
+    WorkStealingPool serialPool(1);
+    result = 0;
+    task.pool = &serialPool;
+    spawn(serialPool, group, task);
+    wait(serialPool, group);
+    SEQAN_ASSERT_EQ(result, expected);
+}
+
+#endif  // TEST_PARALLEL_TEST_PARALLEL_WORK_STEALING_H_
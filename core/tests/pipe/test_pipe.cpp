@@ -232,11 +232,11 @@ void testPartiallyFilledMapper(unsigned maxSize = 16*1024*1024) {
 
 
 
-void testSorter(unsigned maxSize = 16*1024*1024) {
+void testSorter(unsigned maxSize = 16*1024*1024, PoolParameters const & params = PoolParameters()) {
     Buffer<unsigned> buf;
     allocPage(buf, maxSize, buf);
 
-    Pool<unsigned,SorterSpec<SorterConfig<SimpleCompare<unsigned> > > > sorter;
+    Pool<unsigned,SorterSpec<SorterConfig<SimpleCompare<unsigned> > > > sorter(params);
     for(unsigned i = 1; i <= maxSize; i = i << 1) {
         /*
         ::std::cout << i;
@@ -299,6 +299,19 @@ SEQAN_DEFINE_TEST(test_pipe_test_sorter) {
     testSorter(MAX_SIZE);
 }
 
+
+SEQAN_DEFINE_TEST(test_pipe_test_external_sorter) {
+    // Without a memory buffer the pages are sorted one by one and merged afterwards.
+    PoolParameters params;
+    params.memBufferSize = 0;
+    params.pageSize = 64 * 1024;
+    params.bucketBufferSize = 1024 * 1024;
+    int numThreads = omp_get_max_threads();
+    omp_set_num_threads(2);
+    testSorter(MAX_SIZE, params);
+    omp_set_num_threads(numThreads);
+}
+
 template <typename TStringSet>
 inline void appendValues(TStringSet &stringSet, int numArgs, ...)
 {
@@ -489,6 +502,7 @@ SEQAN_BEGIN_TESTSUITE(test_pipe) {
     SEQAN_CALL_TEST(test_pipe_test_mapper);
     SEQAN_CALL_TEST(test_pipe_test_mapper_partially_filled);
     SEQAN_CALL_TEST(test_pipe_test_sorter);
+    SEQAN_CALL_TEST(test_pipe_test_external_sorter);
     SEQAN_CALL_TEST(test_pipe_sampler);
 }
 SEQAN_END_TESTSUITE
@@ -36,6 +36,7 @@
 #define CORE_TESTS_SEQ_IO_TEST_FAI_INDEX_H_
 
 #include <seqan/seq_io.h>
+#include <seqan/random.h>
 
 SEQAN_DEFINE_TEST(test_seq_io_genomic_fai_index_build)
 {
@@ -139,4 +140,134 @@ SEQAN_DEFINE_TEST(test_seq_io_genomic_fai_index_read_region)
     }
 }
 
+#if SEQAN_HAS_ZLIB
+
+// Write a BGZF compressed copy of inPath to outPath with one block per blockSize bytes.
+inline void _writeBgzfCopy(char const * outPath, char const * inPath, unsigned blockSize)
+{
+    seqan::String<char, seqan::MMap<> > text;
+    SEQAN_ASSERT(open(text, inPath, seqan::OPEN_RDONLY));
+
+    seqan::Stream<seqan::Bgzf> out;
+    setNumThreads(out, 2);
+    SEQAN_ASSERT(open(out, outPath, "w"));
+    for (unsigned pos = 0; pos < length(text); pos += blockSize)
+    {
+        unsigned len = std::min(blockSize, (unsigned)length(text) - pos);
+        SEQAN_ASSERT_EQ(streamWriteBlock(out, &text[pos], len), len);
+        SEQAN_ASSERT_EQ(streamFlush(out), 0);
+    }
+    close(out);
+}
+
+SEQAN_DEFINE_TEST(test_seq_io_genomic_fai_index_bgzf_build)
+{
+    seqan::CharString filePath = SEQAN_PATH_TO_ROOT();
+    append(filePath, "/core/tests/seq_io/adeno_genome.fa");
+    seqan::CharString bgzfPath = SEQAN_TEMP_FILENAME();
+    append(bgzfPath, ".gz");
+    _writeBgzfCopy(toCString(bgzfPath), toCString(filePath), 1000);
+
+    // Decompress the blocks in parallel.
+    seqan::FaiIndex faiIndex;
+    setNumThreads(faiIndex.bgzfStream, 2);
+    SEQAN_ASSERT_EQ(build(faiIndex, toCString(bgzfPath)), 0);
+
+    SEQAN_ASSERT(faiIndex.isBgzf);
+    SEQAN_ASSERT_EQ(numSeqs(faiIndex), 2u);
+    SEQAN_ASSERT_EQ(sequenceLength(faiIndex, 0), 4718u);
+    SEQAN_ASSERT_EQ(sequenceName(faiIndex, 0), "gi|9632547|ref|NC_002077.1|");
+    SEQAN_ASSERT_EQ(sequenceLength(faiIndex, 1), 8u);
+    SEQAN_ASSERT_EQ(sequenceName(faiIndex, 1), "sequence");
+
+    // One GZI entry per block of 1000 bytes plus the empty block at the end.
+    SEQAN_ASSERT_EQ(length(faiIndex.gziIndex), 6u);
+    SEQAN_ASSERT_EQ(faiIndex.gziIndex[0].i1, 0u);
+    SEQAN_ASSERT_EQ(faiIndex.gziIndex[0].i2, 0u);
+    for (unsigned i = 1; i < length(faiIndex.gziIndex); ++i)
+    {
+        SEQAN_ASSERT_GT(faiIndex.gziIndex[i].i1, faiIndex.gziIndex[i - 1].i1);
+        SEQAN_ASSERT_EQ(faiIndex.gziIndex[i].i2, std::min(1000u * i, 4882u));
+    }
+
+    // The FAI file refers to the uncompressed data.
+    SEQAN_ASSERT_EQ(write(faiIndex), 0);
+    seqan::CharString pathToExpected = SEQAN_PATH_TO_ROOT();
+    append(pathToExpected, "/core/tests/seq_io/adeno_genome.fa.fai");
+    seqan::CharString faiPath = bgzfPath;
+    append(faiPath, ".fai");
+    SEQAN_ASSERT_MSG(seqan::_compareTextFiles(toCString(pathToExpected), toCString(faiPath)),
+                     "Output should match example.");
+
+    // Read FAI and GZI file back in.
+    seqan::FaiIndex faiIndex2;
+    SEQAN_ASSERT_EQ(read(faiIndex2, toCString(bgzfPath)), 0);
+    SEQAN_ASSERT(faiIndex2.isBgzf);
+    SEQAN_ASSERT_EQ(numSeqs(faiIndex2), 2u);
+    SEQAN_ASSERT_EQ(length(faiIndex2.gziIndex), length(faiIndex.gziIndex));
+    for (unsigned i = 0; i < length(faiIndex.gziIndex); ++i)
+    {
+        SEQAN_ASSERT_EQ(faiIndex2.gziIndex[i].i1, faiIndex.gziIndex[i].i1);
+        SEQAN_ASSERT_EQ(faiIndex2.gziIndex[i].i2, faiIndex.gziIndex[i].i2);
+    }
+}
+
+SEQAN_DEFINE_TEST(test_seq_io_genomic_fai_index_bgzf_read_region)
+{
+    seqan::CharString filePath = SEQAN_PATH_TO_ROOT();
+    append(filePath, "/core/tests/seq_io/adeno_genome.fa");
+    seqan::CharString bgzfPath = SEQAN_TEMP_FILENAME();
+    append(bgzfPath, ".gz");
+    _writeBgzfCopy(toCString(bgzfPath), toCString(filePath), 1000);
+
+    seqan::FaiIndex plainIndex;
+    SEQAN_ASSERT_EQ(read(plainIndex, toCString(filePath)), 0);
+    seqan::FaiIndex faiIndex;
+    setNumThreads(faiIndex.bgzfStream, 2);
+    SEQAN_ASSERT_EQ(build(faiIndex, toCString(bgzfPath)), 0);
+    SEQAN_ASSERT_EQ(write(faiIndex), 0);
+
+    seqan::Dna5String str;
+    SEQAN_ASSERT_EQ(readRegion(str, faiIndex, 0, 100, 110), 0);
+    SEQAN_ASSERT_EQ(str, "GAGCGCGCAG");
+    SEQAN_ASSERT_EQ(readRegion(str, faiIndex, 0, 4708, 10000), 0);
+    SEQAN_ASSERT_EQ(str, "GAGTGGGCAA");
+    seqan::GenomicRegion region("gi|9632547|ref|NC_002077.1|:101-110");
+    SEQAN_ASSERT_EQ(readRegion(str, faiIndex, region), 0);
+    SEQAN_ASSERT_EQ(str, "GAGCGCGCAG");
+
+    // Compare regions within and across blocks, in random order such that blocks come from the cache, too.  Also use
+    // an index that was read from disk.
+    seqan::FaiIndex faiIndex2;
+    SEQAN_ASSERT_EQ(read(faiIndex2, toCString(bgzfPath)), 0);
+    // The second index only caches two blocks, so that blocks are evicted, too.
+    faiIndex2.bgzfStream._maxCacheSize = 2 * 1000;
+    seqan::Rng<seqan::MersenneTwister> rng(42);
+    seqan::Dna5String expected;
+    for (unsigned i = 0; i < 200; ++i)
+    {
+        unsigned refId = pickRandomNumber(rng) % 2;
+        unsigned seqLen = sequenceLength(plainIndex, refId);
+        unsigned beginPos = pickRandomNumber(rng) % (seqLen + 1);
+        unsigned endPos = beginPos + pickRandomNumber(rng) % 2000;
+
+        SEQAN_ASSERT_EQ(readRegion(expected, plainIndex, refId, beginPos, endPos), 0);
+        SEQAN_ASSERT_EQ(readRegion(str, faiIndex, refId, beginPos, endPos), 0);
+        SEQAN_ASSERT_EQ(str, expected);
+        SEQAN_ASSERT_EQ(readRegion(str, faiIndex2, refId, beginPos, endPos), 0);
+        SEQAN_ASSERT_EQ(str, expected);
+    }
+
+    // Whole sequences.
+    SEQAN_ASSERT_EQ(readSequence(str, faiIndex2, 0), 0);
+    SEQAN_ASSERT_EQ(length(str), 4718u);
+    SEQAN_ASSERT_EQ(prefix(str, 20), "TTGCCCACTCCCTCTCTGCG");
+    SEQAN_ASSERT_EQ(suffix(str, length(str) - 20), "CGCAGAGAGGGAGTGGGCAA");
+    SEQAN_ASSERT_EQ(readSequence(str, faiIndex2, 1), 0);
+    SEQAN_ASSERT_EQ(readSequence(expected, plainIndex, 1), 0);
+    SEQAN_ASSERT_EQ(str, expected);
+}
+
+#endif  // #if SEQAN_HAS_ZLIB
+
 #endif  // #ifndef CORE_TESTS_SEQ_IO_TEST_FAI_INDEX_H_
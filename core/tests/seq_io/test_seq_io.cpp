@@ -66,6 +66,7 @@ SEQAN_BEGIN_TESTSUITE(test_seq_io)
     SEQAN_CALL_TEST(test_seq_io_sequence_stream_read_record_text_fasta);
     SEQAN_CALL_TEST(test_seq_io_sequence_stream_read_batch_text_fasta);
     SEQAN_CALL_TEST(test_seq_io_sequence_stream_read_all_text_fasta);
+    SEQAN_CALL_TEST(test_seq_io_sequence_stream_read_all_parallel);
 
     // Test writing with different interfaces.
     SEQAN_CALL_TEST(test_seq_io_sequence_stream_write_record_text_fasta);
@@ -89,6 +90,10 @@ SEQAN_BEGIN_TESTSUITE(test_seq_io)
     SEQAN_CALL_TEST(test_seq_io_genomic_fai_index_read);
     SEQAN_CALL_TEST(test_seq_io_genomic_fai_index_read_sequence);
     SEQAN_CALL_TEST(test_seq_io_genomic_fai_index_read_region);
+#if SEQAN_HAS_ZLIB
+    SEQAN_CALL_TEST(test_seq_io_genomic_fai_index_bgzf_build);
+    SEQAN_CALL_TEST(test_seq_io_genomic_fai_index_bgzf_read_region);
+#endif  // #if SEQAN_HAS_ZLIB
 
     // -------------- File format specific code ------------------
 
@@ -109,6 +114,7 @@ SEQAN_BEGIN_TESTSUITE(test_seq_io)
     SEQAN_CALL_TEST(test_stream_record_reader_fasta_batch_single_concat_mmap);
     SEQAN_CALL_TEST(test_stream_record_reader_fasta_batch_double_mmap);
     SEQAN_CALL_TEST(test_stream_record_reader_fasta_batch_double_concat_mmap);
+    SEQAN_CALL_TEST(test_stream_record_reader_fasta_read_all_parallel);
 
     // Tests for FASTQ
     SEQAN_CALL_TEST(test_stream_record_reader_fastq_single_fstream);
@@ -122,6 +128,7 @@ SEQAN_BEGIN_TESTSUITE(test_seq_io)
     SEQAN_CALL_TEST(test_stream_record_reader_fastq_batch_double_mmap);
     SEQAN_CALL_TEST(test_stream_record_reader_fastq_batch_double_concat_mmap);
     SEQAN_CALL_TEST(test_stream_record_reader_fastq_check_stream_format);
+    SEQAN_CALL_TEST(test_stream_record_reader_fastq_read_all_parallel);
 
     // Tests for EMBL
     SEQAN_CALL_TEST(test_stream_read_embl_single_char_array_stream);
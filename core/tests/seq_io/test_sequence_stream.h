@@ -232,6 +232,53 @@ SEQAN_DEFINE_TEST(test_seq_io_sequence_stream_read_all_text_fasta)
     SEQAN_ASSERT(isGood(seqIO));
 }
 
+SEQAN_DEFINE_TEST(test_seq_io_sequence_stream_read_all_parallel)
+{
+    char const * FILES[] =
+    {
+        "test_dna.fa", "test_dna.fq", "SRR067601_1.1k.fasta",
+#if SEQAN_HAS_ZLIB
+        "SRR067601_1.1k.fasta.gz",  // Compressed files are read serially.
+#endif  // #if SEQAN_HAS_ZLIB
+    };
+
+    for (unsigned i = 0; i < sizeof(FILES) / sizeof(FILES[0]); ++i)
+    {
+        seqan::CharString filePath = SEQAN_PATH_TO_ROOT();
+        append(filePath, "/core/tests/seq_io/");
+        append(filePath, FILES[i]);
+
+        // readAll() reads serially, readAllParallel() must yield the same records.
+        seqan::SequenceStream serialIO(toCString(filePath));
+        seqan::StringSet<seqan::CharString> ids, quals;
+        seqan::StringSet<seqan::Dna5String> seqs;
+        SEQAN_ASSERT_EQ(0, readAll(ids, seqs, quals, serialIO));
+
+        seqan::SequenceParallelReadOptions options;
+        options.numThreads = 4;
+        options.chunkSize = 1000;
+        seqan::SequenceStream parallelIO(toCString(filePath));
+        seqan::StringSet<seqan::CharString, seqan::Owner<seqan::ConcatDirect<> > > parallelIds, parallelQuals;
+        seqan::StringSet<seqan::Dna5String> parallelSeqs;
+        SEQAN_ASSERT_EQ(0, readAllParallel(parallelIds, parallelSeqs, parallelQuals, parallelIO, options));
+
+        SEQAN_ASSERT_EQ(length(parallelIds), length(ids));
+        for (unsigned j = 0; j < length(ids); ++j)
+        {
+            SEQAN_ASSERT_EQ(parallelIds[j], ids[j]);
+            SEQAN_ASSERT_EQ(parallelSeqs[j], seqs[j]);
+            SEQAN_ASSERT_EQ(parallelQuals[j], quals[j]);
+        }
+        SEQAN_ASSERT(atEnd(parallelIO));
+        SEQAN_ASSERT(isGood(parallelIO));
+
+        seqan::SequenceStream parallelIO2(toCString(filePath));
+        SEQAN_ASSERT_EQ(0, readAllParallel(parallelIds, parallelSeqs, parallelIO2));
+        SEQAN_ASSERT_EQ(length(parallelIds), length(ids));
+        SEQAN_ASSERT(atEnd(parallelIO2));
+    }
+}
+
 // ---------------------------------------------------------------------------
 // Test writing with different interfaces.
 // ---------------------------------------------------------------------------
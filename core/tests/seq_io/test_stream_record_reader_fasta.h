@@ -340,4 +340,46 @@ SEQAN_DEFINE_TEST(test_stream_record_reader_fasta_annotated_protein_single_fstre
     file->close();
 }
 
+// Reads the same multi-line records in parallel as record by record.
+SEQAN_DEFINE_TEST(test_stream_record_reader_fasta_read_all_parallel)
+{
+    using namespace seqan;
+
+    CharString text;
+    char const * fileNames[] = { "/core/tests/seq_io/adeno_genome.fa", "/core/tests/seq_io/test_dna.fa" };
+    for (unsigned f = 0; f < 2; ++f)
+    {
+        CharString filename = SEQAN_PATH_TO_ROOT();
+        append(filename, fileNames[f]);
+        String<char, MMap<> > mmapString;
+        SEQAN_ASSERT(open(mmapString, toCString(filename), OPEN_RDONLY));
+        append(text, mmapString);
+        close(mmapString);
+    }
+
+    StringSet<CharString> refIds;
+    StringSet<Dna5String> refSeqs;
+    RecordReader<CharString, SinglePass<StringReader> > reader(text);
+    SEQAN_ASSERT_EQ(read2(refIds, refSeqs, reader, Fasta()), 0);
+    SEQAN_ASSERT_EQ(length(refIds), 5u);
+
+    unsigned const chunkSizes[] = { 1, 50, 1000, 1000000 };
+    for (unsigned c = 0; c < 4; ++c)
+    {
+        SequenceParallelReadOptions options;
+        options.numThreads = 3;
+        options.chunkSize = chunkSizes[c];
+
+        StringSet<CharString, Owner<ConcatDirect<> > > ids;
+        StringSet<Dna5String, Owner<ConcatDirect<> > > seqs;
+        SEQAN_ASSERT_EQ(readAllParallel(ids, seqs, text, Fasta(), options), 0);
+        SEQAN_ASSERT_EQ(length(ids), length(refIds));
+        for (unsigned i = 0; i < length(refIds); ++i)
+        {
+            SEQAN_ASSERT_EQ(ids[i], refIds[i]);
+            SEQAN_ASSERT_EQ(seqs[i], refSeqs[i]);
+        }
+    }
+}
+
 #endif // def TEST_STREAM_TEST_STREAM_READ_FASTA_H_
@@ -313,4 +313,68 @@ SEQAN_DEFINE_TEST(test_stream_record_reader_fastq_check_stream_format)
     SEQAN_ASSERT_EQ(value(tagSelector), +(Find<AutoSeqStreamFormat, Fastq>::VALUE));
 }
 
+// Reads the same records in parallel as record by record, also if the chunks
+// begin with quality lines starting with '@' or multi-line records force the
+// serial fallback.
+SEQAN_DEFINE_TEST(test_stream_record_reader_fastq_read_all_parallel)
+{
+    using namespace seqan;
+
+    CharString filename = SEQAN_PATH_TO_ROOT();
+    append(filename, "/core/tests/seq_io/SRR067601_1.1k.fasta");
+    String<char, MMap<> > mmapString;
+    SEQAN_ASSERT(open(mmapString, toCString(filename), OPEN_RDONLY));
+
+    CharString multiLine = "@r1\nACGTACGT\nACG\n+r1\n@@IIIIII\nIII\n@r2\nAC\n+\n@I\n@r3\n\n+\n\n@r4\nGGG\nG\n+\nIIII\n";
+
+    for (unsigned f = 0; f < 2; ++f)
+    {
+        CharString text = (f == 0) ? CharString(mmapString) : multiLine;
+
+        StringSet<CharString> refIds;
+        StringSet<String<Dna5Q> > refSeqs;
+        StringSet<CharString> refQuals;
+        {
+            RecordReader<CharString, SinglePass<StringReader> > reader(text);
+            SEQAN_ASSERT_EQ(read2(refIds, refSeqs, reader, Fastq()), 0);
+        }
+        {
+            StringSet<CharString> ids;
+            StringSet<String<Dna5Q> > seqs;
+            RecordReader<CharString, SinglePass<StringReader> > reader(text);
+            SEQAN_ASSERT_EQ(read2(ids, seqs, refQuals, reader, Fastq()), 0);
+        }
+
+        unsigned const chunkSizes[] = { 1, 7, 100, 1000, 1000000 };
+        for (unsigned c = 0; c < 5; ++c)
+        {
+            SequenceParallelReadOptions options;
+            options.numThreads = 4;
+            options.chunkSize = chunkSizes[c];
+
+            StringSet<CharString, Owner<ConcatDirect<> > > ids;
+            StringSet<String<Dna5Q>, Owner<ConcatDirect<> > > seqs;
+            SEQAN_ASSERT_EQ(readAllParallel(ids, seqs, text, Fastq(), options), 0);
+            SEQAN_ASSERT_EQ(length(ids), length(refIds));
+            SEQAN_ASSERT_EQ(length(seqs), length(refSeqs));
+            for (unsigned i = 0; i < length(refIds); ++i)
+            {
+                SEQAN_ASSERT_EQ(ids[i], refIds[i]);
+                SEQAN_ASSERT_EQ(seqs[i], refSeqs[i]);
+                for (unsigned j = 0; j < length(refSeqs[i]); ++j)
+                    SEQAN_ASSERT_EQ(getQualityValue(seqs[i][j]), getQualityValue(refSeqs[i][j]));
+            }
+
+            // explicit qualities
+            StringSet<CharString, Owner<ConcatDirect<> > > quals;
+            SEQAN_ASSERT_EQ(readAllParallel(ids, seqs, quals, text, Fastq(), options), 0);
+            SEQAN_ASSERT_EQ(length(quals), length(refQuals));
+            for (unsigned i = 0; i < length(refQuals); ++i)
+                SEQAN_ASSERT_EQ(quals[i], refQuals[i]);
+        }
+    }
+
+    close(mmapString);
+}
+
 #endif // def TEST_STREAM_TEST_STREAM_READ_FASTQ_H_
@@ -79,6 +79,8 @@ SEQAN_BEGIN_TESTSUITE(Sequence tests)
 	SEQAN_CALL_TEST(String_Pointer);
 	SEQAN_CALL_TEST(String_CStyle);
 	SEQAN_CALL_TEST(String_Packed);
+	SEQAN_CALL_TEST(String_Packed_Bulk);
+	SEQAN_CALL_TEST(String_Packed_Dirty_Infix_Copy);
 	SEQAN_CALL_TEST(Std_String);
 
 	SEQAN_CALL_TEST(Lexical);
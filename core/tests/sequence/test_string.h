@@ -619,6 +619,91 @@ SEQAN_DEFINE_TEST(String_Packed)
         }
 }
 
+// Tests the word-parallel infix copy, comparison and Hamming distance of packed strings.
+template <typename TValue>
+void TestStringPackedBulk()
+{
+    typedef String<TValue, Packed<> > TPackedString;
+    typedef String<TValue> TUnpackedString;
+
+    TUnpackedString ref;
+    for (unsigned i = 0; i < 300; ++i)
+        appendValue(ref, (TValue)((i * 7 + i / 13) % ValueSize<TValue>::VALUE));
+    TPackedString const packed = ref;
+
+    for (unsigned len = 0; len < 100; len += 3)
+        for (unsigned pos = 0; pos < 70; ++pos)
+        {
+            // copy an infix at an arbitrary offset
+            TPackedString inf = infix(packed, pos, pos + len);
+            TUnpackedString refInf = infix(ref, pos, pos + len);
+            SEQAN_ASSERT_EQ(inf, refInf);
+
+            // compare with a modified copy
+            TPackedString other = infix(packed, pos + 1, pos + len + 1);
+            TUnpackedString refOther = infix(ref, pos + 1, pos + len + 1);
+            SEQAN_ASSERT_EQ(inf == other, refInf == refOther);
+            SEQAN_ASSERT_EQ(inf < other, refInf < refOther);
+            SEQAN_ASSERT_EQ(other < inf, refOther < refInf);
+            SEQAN_ASSERT_EQ(lcpLength(inf, other), lcpLength(refInf, refOther));
+            SEQAN_ASSERT_EQ(hammingDistance(inf, other), hammingDistance(refInf, refOther));
+
+            if (len != 0)
+            {
+                other = inf;
+                other[len / 2] = (TValue)((ordValue(other[len / 2]) + 1) % ValueSize<TValue>::VALUE);
+                SEQAN_ASSERT(inf != other);
+                SEQAN_ASSERT_EQ(lcpLength(inf, other), len / 2);
+                SEQAN_ASSERT_EQ(hammingDistance(inf, other), 1u);
+                SEQAN_ASSERT_EQ(inf < other, (TValue)inf[len / 2] < (TValue)other[len / 2]);
+                other = prefix(inf, len - 1);
+                SEQAN_ASSERT(other < inf);
+                SEQAN_ASSERT_NOT(inf < other);
+            }
+        }
+}
+
+SEQAN_DEFINE_TEST(String_Packed_Bulk)
+{
+    TestStringPackedBulk<Dna>();
+    TestStringPackedBulk<Dna5>();
+    TestStringPackedBulk<char>();
+}
+
+// Tests the word-parallel infix copy of packed strings whose host words have set unused bits,
+// e.g. after reusing memory. Values are set one by one which leaves the unused bits untouched.
+template <typename TValue>
+void TestStringPackedDirtyInfixCopy(char const * text, unsigned x, unsigned y)
+{
+    typedef String<TValue, Packed<> > TPackedString;
+    typedef typename Host<TPackedString>::Type THost;
+    typedef typename Value<THost>::Type THostValue;
+    typedef typename THostValue::TBitVector TBitVector;
+    typedef typename Iterator<THost, Standard>::Type THostIter;
+
+    String<TValue> ref = text;
+    TPackedString dirty;
+    resize(dirty, length(ref));
+    for (THostIter it = begin(host(dirty), Standard()); it != end(host(dirty), Standard()); ++it)
+        it->i = ~(TBitVector)0;
+    for (unsigned i = 0; i < length(ref); ++i)
+        dirty[i] = ref[i];
+    TPackedString const & source = dirty;
+
+    for (unsigned pos = x; pos < y; ++pos)
+    {
+        TPackedString target;
+        assign(target, infix(source, pos, y));
+        SEQAN_ASSERT_EQ(target, infix(ref, pos, y));
+    }
+}
+
+SEQAN_DEFINE_TEST(String_Packed_Dirty_Infix_Copy)
+{
+    TestStringPackedDirtyInfixCopy<Dna5>("ACGTNNACGTTGCANGTACCAGTNAC", 4, 26);
+    TestStringPackedDirtyInfixCopy<AminoAcid>("HFKLVQDEMZWPEXMSHZBR*HDEAFPRHGVVFYYBGA*LTSTRTWIGFRXCFPHGNQRVP", 17, 39);
+}
+
 //////////////////////////////////////////////////////////////////////////////
 
 SEQAN_DEFINE_TEST(String_Pointer)
@@ -45,6 +45,7 @@
 #include <string>
 
 #include <seqan/basic.h>
+#include <seqan/parallel.h>
 #include <seqan/random.h>
 #include <seqan/sequence.h>
 #include <seqan/sequence_journaled.h>
@@ -184,6 +185,88 @@ void testJournaledStringReset(TJournalSpec const & /*spec*/)
 }
 
 
+// Test snapshot().
+template <typename TStringJournalSpec>
+void testJournaledStringSnapshot(TStringJournalSpec const &)
+{
+    typedef String<char, Journaled<Alloc<void>, TStringJournalSpec> > TJournaledString;
+
+    CharString hostStr = "ACGTACGTACGTACGTACGTACGTACGTACGT";
+    TJournaledString journaledString(hostStr);
+
+    // Take a snapshot after each change and remember its contents.
+    TJournaledString snapshots[8];
+    std::string expected[8];
+    for (unsigned i = 0; i < 8; ++i)
+    {
+        insert(journaledString, 3 * i, "NN");
+        erase(journaledString, 4 * i + 1, 4 * i + 3);
+        assignValue(journaledString, i, 'x');
+        snapshot(snapshots[i], journaledString);
+
+        std::stringstream tmp;
+        tmp << journaledString;
+        expected[i] = tmp.str();
+    }
+
+    // Further changes of the source do not affect the snapshots.
+    insert(journaledString, 0, "XXXX");
+    erase(journaledString, 10, 20);
+
+    // The snapshots share the host and can be read concurrently.
+    bool ok[8];
+    SEQAN_OMP_PRAGMA(parallel for)
+    for (int i = 0; i < 8; ++i)
+    {
+        std::stringstream tmp;
+        tmp << snapshots[i];
+        ok[i] = (tmp.str() == expected[i]);
+    }
+
+    for (unsigned i = 0; i < 8; ++i)
+    {
+        SEQAN_ASSERT(ok[i]);
+        SEQAN_ASSERT_EQ(&host(snapshots[i]), &hostStr);
+        SEQAN_ASSERT_EQ(length(snapshots[i]), expected[i].size());
+    }
+    SEQAN_ASSERT_EQ(hostStr, "ACGTACGTACGTACGTACGTACGTACGTACGT");
+
+    // One thread keeps changing the source while the others iterate the snapshots.
+    typedef typename Iterator<TJournaledString const, Standard>::Type TIterator;
+    typedef typename Size<TJournaledString>::Type TSize;
+    TSize sourceLength = length(journaledString);
+    int const numTasks = 8;
+    bool iterationOk[numTasks];
+    SEQAN_OMP_PRAGMA(parallel for schedule(static, 1) num_threads(4))
+    for (int task = 0; task < numTasks; ++task)
+    {
+        iterationOk[task] = true;
+        if (task == 0)
+        {
+            for (unsigned i = 0; i < 1000; ++i)
+            {
+                insert(journaledString, (7 * i) % length(journaledString), "ACGT");
+                TSize pos = (5 * i) % (length(journaledString) - 2);
+                erase(journaledString, pos, pos + 2);
+            }
+            continue;
+        }
+
+        for (unsigned round = 0; round < 100; ++round)
+        {
+            TJournaledString const & snap = snapshots[task];
+            std::string str;
+            for (TIterator it = begin(snap, Standard()); it != end(snap, Standard()); ++it)
+                str.push_back(*it);
+            iterationOk[task] = iterationOk[task] && (str == expected[task]);
+        }
+    }
+
+    for (int task = 0; task < numTasks; ++task)
+        SEQAN_ASSERT(iterationOk[task]);
+    SEQAN_ASSERT_EQ(length(journaledString), sourceLength + 1000u * 2u);
+}
+
 // Test setHost(), host().
 template <typename TStringJournalSpec>
 void testJournaledStringHost(TStringJournalSpec const &)
@@ -1130,6 +1213,103 @@ void testJournaledStringReplace(TStringJournalSpec const &)
     }
 }
 
+// Applies random edits to journaled strings with the given and the sorted
+// array journal and compares the journal entries and position mappings.
+template <typename TStringJournalSpec>
+void testJournaledStringCompareSortedArray(TStringJournalSpec const &)
+{
+    typedef String<char, Journaled<Alloc<void>, TStringJournalSpec> > TJournaledString;
+    typedef String<char, Journaled<Alloc<void>, SortedArray> > TSortedArrayString;
+    typedef typename JournalType<TJournaledString>::Type TJournalEntries;
+    typedef typename JournalType<TSortedArrayString>::Type TSortedArrayEntries;
+    typedef typename Iterator<TJournalEntries const, Standard>::Type TEntriesIterator;
+    typedef typename Iterator<TSortedArrayEntries const, Standard>::Type TSortedArrayIterator;
+
+    Rng<> rng(42);
+    CharString host;
+    for (unsigned i = 0; i < 5000; ++i)
+        appendValue(host, 'A' + pickRandomNumber(rng, Pdf<Uniform<int> >(0, 25)));
+
+    TJournaledString journaledString(host);
+    TSortedArrayString sortedArrayString(host);
+
+    for (unsigned i = 0; i < 3000; ++i)
+    {
+        unsigned len = length(journaledString);
+        unsigned pos = pickRandomNumber(rng, Pdf<Uniform<int> >(0, len));
+        // Most changes are in increasing order like when applying variants.
+        if (i % 4 != 0)
+            pos = _min(len, (i * len) / 3000);
+
+        switch (pickRandomNumber(rng, Pdf<Uniform<int> >(0, 2)))
+        {
+            case 0:
+            {
+                CharString ins;
+                for (unsigned j = pickRandomNumber(rng, Pdf<Uniform<int> >(1, 10)); j > 0; --j)
+                    appendValue(ins, 'a' + pickRandomNumber(rng, Pdf<Uniform<int> >(0, 25)));
+                insert(journaledString, pos, ins);
+                insert(sortedArrayString, pos, ins);
+                break;
+            }
+            case 1:
+            {
+                // The sorted array splits entries on empty erasures and does
+                // not support erasing the first entry partially.
+                pos = _max(pos, 1u);
+                unsigned posEnd = _min(len, pos + pickRandomNumber(rng, Pdf<Uniform<int> >(1, (i % 50 == 0)? 300: 10)));
+                if (pos < posEnd)
+                {
+                    erase(journaledString, pos, posEnd);
+                    erase(sortedArrayString, pos, posEnd);
+                }
+                break;
+            }
+            default:
+                if (pos < len)
+                {
+                    assignValue(journaledString, pos, 'z');
+                    assignValue(sortedArrayString, pos, 'z');
+                }
+        }
+
+        if (i % 100 != 0)
+            continue;
+
+        SEQAN_ASSERT_EQ(length(journaledString._journalEntries), length(sortedArrayString._journalEntries._journalNodes));
+        TSortedArrayIterator itSorted = begin(sortedArrayString._journalEntries, Standard());
+        for (TEntriesIterator it = begin(journaledString._journalEntries, Standard());
+             it != end(journaledString._journalEntries, Standard()); ++it, ++itSorted)
+        {
+            SEQAN_ASSERT_EQ(value(it).segmentSource, (*itSorted).segmentSource);
+            SEQAN_ASSERT_EQ(value(it).virtualPosition, (*itSorted).virtualPosition);
+            SEQAN_ASSERT_EQ(value(it).physicalPosition, (*itSorted).physicalPosition);
+            SEQAN_ASSERT_EQ(value(it).physicalOriginPosition, (*itSorted).physicalOriginPosition);
+            SEQAN_ASSERT_EQ(value(it).length, (*itSorted).length);
+        }
+        SEQAN_ASSERT_EQ(CharString(journaledString), CharString(sortedArrayString));
+
+        for (unsigned hostPos = 0; hostPos < length(host); hostPos += 37)
+            SEQAN_ASSERT_EQ(hostToVirtualPosition(journaledString, hostPos),
+                            hostToVirtualPosition(sortedArrayString, hostPos));
+        for (unsigned virtualPos = 0; virtualPos < length(journaledString); virtualPos += 37)
+        {
+            SEQAN_ASSERT_EQ(virtualToHostPosition(journaledString, virtualPos),
+                            virtualToHostPosition(sortedArrayString, virtualPos));
+            SEQAN_ASSERT_EQ(isGapInHost(journaledString, virtualPos), isGapInHost(sortedArrayString, virtualPos));
+        }
+    }
+
+    // Erase everything but a single character and then everything.
+    erase(journaledString, 1, length(journaledString));
+    erase(sortedArrayString, 1, length(sortedArrayString));
+    SEQAN_ASSERT_EQ(CharString(journaledString), CharString(sortedArrayString));
+    SEQAN_ASSERT_EQ(length(journaledString._journalEntries), 1u);
+    erase(journaledString, 0, 1);
+    SEQAN_ASSERT_EQ(length(journaledString), 0u);
+    SEQAN_ASSERT_EQ(length(journaledString._journalEntries), 0u);
+}
+
 
 // Tag: UnbalancedTree()
 
@@ -1143,6 +1323,11 @@ SEQAN_DEFINE_TEST(test_sequence_journaled_unbalanced_tree_set) {
 }
 
 
+SEQAN_DEFINE_TEST(test_sequence_journaled_unbalanced_tree_snapshot) {
+    testJournaledStringSnapshot(UnbalancedTree());
+}
+
+
 SEQAN_DEFINE_TEST(test_sequence_journaled_unbalanced_tree_host) {
     testJournaledStringHost(UnbalancedTree());
 }
@@ -1255,6 +1440,11 @@ SEQAN_DEFINE_TEST(test_sequence_journaled_sorted_array_set) {
 }
 
 
+SEQAN_DEFINE_TEST(test_sequence_journaled_sorted_array_snapshot) {
+    testJournaledStringSnapshot(SortedArray());
+}
+
+
 SEQAN_DEFINE_TEST(test_sequence_journaled_sorted_array_host) {
     testJournaledStringHost(SortedArray());
 }
@@ -1361,4 +1551,133 @@ SEQAN_DEFINE_TEST(test_sequence_journaled_sorted_array_flatten)
     testJournalStringFlatten(SortedArray());
 }
 
+
+// Tag: BPlusTree()
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_assign) {
+    testJournaledStringAssign(BPlusTree());
+}
+
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_set) {
+    testJournaledStringSet(BPlusTree());
+}
+
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_snapshot) {
+    testJournaledStringSnapshot(BPlusTree());
+}
+
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_host) {
+    testJournaledStringHost(BPlusTree());
+}
+
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_clear) {
+    testJournaledStringClear(BPlusTree());
+}
+
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_erase_position) {
+    testJournaledStringErasePosition(BPlusTree());
+}
+
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_erase_begin_end) {
+    testJournaledStringEraseBeginEnd(BPlusTree());
+}
+
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_insert) {
+    testJournaledStringInsert(BPlusTree());
+}
+
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_insert_value) {
+    testJournaledStringInsertValue(BPlusTree());
+}
+
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_assign_value) {
+    testJournaledStringAssignValue(BPlusTree());
+}
+
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_subscript_operator) {
+    testJournaledStringSubscriptOperator(BPlusTree());
+}
+
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_assign_infix) {
+    testJournaledStringAssignInfix(BPlusTree());
+}
+
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_length) {
+    testJournaledStringLength(BPlusTree());
+}
+
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_virtual_to_host_position) {
+    testJournaledStringVirtualToHostPosition<BPlusTree>();
+}
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_host_to_virtual_position)
+{
+    testJournaledStringHostToVirtualPosition<BPlusTree>();
+}
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_reset)
+{
+    testJournaledStringReset(seqan::BPlusTree());
+}
+
+
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_copy_constructor) {
+    testJournaledStringCopyConstructor(BPlusTree());
+}
+
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_begin_end_iterator) {
+    testJournaledStringBeginEndIteratorStandard(BPlusTree());
+    testJournaledStringBeginEndIteratorRooted(BPlusTree());
+}
+
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_begin_end_const_iterator) {
+    testJournaledStringBeginEndConstIterator(BPlusTree());
+}
+
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_subscript_operator_randomized) {
+    testJournaledStringSubscriptOperatorRandomized(BPlusTree());
+}
+
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_fuzzying) {
+    testJournaledStringFuzzying(BPlusTree());
+}
+
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_segments_read_only) {
+    testJournaledStringSegmentsReadOnly(BPlusTree());
+}
+
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_segments_read_write) {
+    testJournaledStringReplace(BPlusTree());
+}
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_flatten)
+{
+    testJournalStringFlatten(BPlusTree());
+}
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_compare_sorted_array)
+{
+    testJournaledStringCompareSortedArray(BPlusTree());
+}
+
 #endif  // TEST_SEQUENCE_JOURNALED_TEST_SEQUENCE_JOURNALED_H_
@@ -607,4 +607,62 @@ SEQAN_DEFINE_TEST(test_sequence_journaled_sorted_array_iterator_rooted_container
     testJournaledStringIteratorContainer(SortedArray());
 }
 
+
+// Tag: BPlusTree()
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_iterator_difference)
+{
+    testJournaledStringIteratorDifference(BPlusTree());
+}
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_iterator_sum)
+{
+    testJournaledStringIteratorSum(BPlusTree());
+}
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_iterator_relations)
+{
+    testJournaledStringIteratorRelations(BPlusTree());
+}
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_iterator_decrement)
+{
+    testJournaledStringIteratorDecrement(BPlusTree());
+}
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_iterator_set_position)
+{
+    testJournaledStringIteratorSetPosition(BPlusTree());
+}
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_iterator_position)
+{
+    testJournaledStringIteratorPosition(BPlusTree());
+}
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_iterator_rooted_at_begin)
+{
+    testJournaledStringIteratorAtBegin(BPlusTree());
+}
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_iterator_rooted_at_end)
+{
+    testJournaledStringIteratorAtEnd(BPlusTree());
+}
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_iterator_rooted_go_begin)
+{
+    testJournaledStringIteratorGoBegin(BPlusTree());
+}
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_iterator_rooted_go_end)
+{
+    testJournaledStringIteratorGoEnd(BPlusTree());
+}
+
+SEQAN_DEFINE_TEST(test_sequence_journaled_bplus_tree_iterator_rooted_container)
+{
+    testJournaledStringIteratorContainer(BPlusTree());
+}
+
 #endif  // TEST_SEQUENCE_JOURNALED_TEST_SEQUENCE_JOURNALED_ITERATOR_H_
@@ -150,6 +150,10 @@ SEQAN_BEGIN_TESTSUITE(test_stream)
 
     SEQAN_CALL_TEST(test_stream_bgzf_write_large_and_compare_with_file);
     SEQAN_CALL_TEST(test_stream_bgzf_from_file_and_compare);
+    SEQAN_CALL_TEST(test_stream_bgzf_write_large_parallel);
+    SEQAN_CALL_TEST(test_stream_bgzf_read_parallel);
+    SEQAN_CALL_TEST(test_stream_bgzf_read_parallel_seek);
+    SEQAN_CALL_TEST(test_stream_bgzf_tell_uncompressed);
 #endif  // #if SEQAN_HAS_ZLIB
 
 #if SEQAN_HAS_BZIP2  // Enable tests for Stream<BZ2File> if available.
@@ -278,6 +282,7 @@ SEQAN_BEGIN_TESTSUITE(test_stream)
     SEQAN_CALL_TEST(test_stream_tokenizing_skipUntilLineBeginsWithOneCharOfStr);
     SEQAN_CALL_TEST(test_stream_tokenizing_read_until_tab_or_line_break);
     SEQAN_CALL_TEST(test_stream_tokenizing_read_until_one_of);
+    SEQAN_CALL_TEST(test_stream_tokenizing_chunks);
 
     SEQAN_CALL_TEST(test_stream_tokenizing_read_digits);
     SEQAN_CALL_TEST(test_stream_tokenizing_read_alpha_nums);
@@ -526,4 +526,203 @@ SEQAN_DEFINE_TEST(test_stream_bgzf_from_file_and_compare)
     SEQAN_ASSERT(feof(inFasta));
 }
 
+// Writing with parallel compression must yield the same file as sequential compression.
+SEQAN_DEFINE_TEST(test_stream_bgzf_write_large_parallel)
+{
+    using namespace seqan;
+
+    char inPath[1000];
+    strcpy(inPath, SEQAN_PATH_TO_ROOT());
+    strcat(inPath, "/core/tests/stream/SRR067601_1.1k.fasta");
+    FILE * fp = fopen(inPath, "rb");
+    SEQAN_ASSERT(fp != NULL);
+
+    const char * p = SEQAN_TEMP_FILENAME();
+    char outFilename[1000];
+    strcpy(outFilename, p);
+
+    Stream<Bgzf> stream;
+    setNumThreads(stream, 3);
+    SEQAN_ASSERT_EQ(numThreads(stream), 3u);
+    SEQAN_ASSERT(open(stream, outFilename, "w"));
+
+    String<char> buffer;
+    resize(buffer, 765);
+    while (!feof(fp))
+    {
+        int len = fread(&buffer[0], 1, 765, fp);
+        streamWriteBlock(stream, &buffer[0], len);
+    }
+    fclose(fp);
+    close(stream);
+
+    char gzPath[1000];
+    strcpy(gzPath, SEQAN_PATH_TO_ROOT());
+    strcat(gzPath, "/core/tests/stream/SRR067601_1.1k.fasta.gz");
+    FILE * fin1 = fopen(gzPath, "rb");
+    SEQAN_ASSERT(fin1 != NULL);
+    FILE * fin2 = fopen(outFilename, "rb");
+    SEQAN_ASSERT(fin2 != NULL);
+
+    int i = 0;
+    while (!feof(fin1) && !feof(fin2))
+    {
+        int i1 = fgetc(fin1);
+        int i2 = fgetc(fin2);
+        SEQAN_ASSERT_EQ_MSG(i1, i2, "At character pos %d", i);
+        ++i;
+    }
+
+    SEQAN_ASSERT(feof(fin1));
+    SEQAN_ASSERT(feof(fin2));
+    fclose(fin1);
+    fclose(fin2);
+}
+
+// Reading with parallel decompression, including seeking back into blocks that were read ahead.
+SEQAN_DEFINE_TEST(test_stream_bgzf_read_parallel)
+{
+    using namespace seqan;
+
+    char gzPath[1000];
+    strcpy(gzPath, SEQAN_PATH_TO_ROOT());
+    strcat(gzPath, "/core/tests/stream/SRR067601_1.1k.fasta.gz");
+    char fastaPath[1000];
+    strcpy(fastaPath, SEQAN_PATH_TO_ROOT());
+    strcat(fastaPath, "/core/tests/stream/SRR067601_1.1k.fasta");
+
+    // Read the expected contents.
+    String<char> expected;
+    FILE * inFasta = fopen(fastaPath, "rb");
+    SEQAN_ASSERT(inFasta != NULL);
+    for (int c = fgetc(inFasta); c != EOF; c = fgetc(inFasta))
+        appendValue(expected, (char)c);
+    fclose(inFasta);
+
+    Stream<Bgzf> inBgzf;
+    setNumThreads(inBgzf, 2);
+    SEQAN_ASSERT(open(inBgzf, gzPath, "r"));
+
+    // Read everything, remember the virtual offset of every 1000th character.
+    String<char> contents;
+    String<__int64> offsets;
+    while (!streamEof(inBgzf))
+    {
+        if (length(contents) % 1000 == 0)
+            appendValue(offsets, streamTell(inBgzf));
+        char c = '\0';
+        SEQAN_ASSERT_EQ(streamReadChar(c, inBgzf), 0);
+        appendValue(contents, c);
+    }
+    SEQAN_ASSERT(contents == expected);
+
+    // Jump back to the remembered offsets in reverse order.
+    for (int i = length(offsets) - 1; i >= 0; i -= 7)
+    {
+        SEQAN_ASSERT_EQ(streamSeek(inBgzf, offsets[i], SEEK_SET), 0);
+        char buffer[10];
+        size_t expectedLen = std::min((size_t)10, (size_t)(length(expected) - i * 1000));
+        SEQAN_ASSERT_EQ(streamReadBlock(buffer, inBgzf, 10), expectedLen);
+        for (unsigned j = 0; j < expectedLen; ++j)
+            SEQAN_ASSERT_EQ(buffer[j], expected[i * 1000 + j]);
+    }
+}
+
+// Seeking must only load single blocks, reading ahead starts once the blocks are read in order.
+SEQAN_DEFINE_TEST(test_stream_bgzf_read_parallel_seek)
+{
+    using namespace seqan;
+
+    char gzPath[1000];
+    strcpy(gzPath, SEQAN_PATH_TO_ROOT());
+    strcat(gzPath, "/core/tests/stream/SRR067601_1.1k.fasta.gz");
+
+    // Collect the virtual offsets of the block starts.
+    String<__int64> blockOffsets;
+    Stream<Bgzf> inBgzf;
+    setNumThreads(inBgzf, 1);
+    SEQAN_ASSERT(open(inBgzf, gzPath, "r"));
+    char c = '\0';
+    while (!streamEof(inBgzf))
+    {
+        __int64 pos = streamTell(inBgzf);
+        if ((pos & 0xFFFF) == 0)
+            appendValue(blockOffsets, pos);
+        SEQAN_ASSERT_EQ(streamReadChar(c, inBgzf), 0);
+    }
+    close(inBgzf);
+    SEQAN_ASSERT_GEQ(length(blockOffsets), 4u);
+
+    setNumThreads(inBgzf, 2);
+    SEQAN_ASSERT(open(inBgzf, gzPath, "r"));
+
+    // Random access to single blocks does not fill the batch.
+    SEQAN_ASSERT_EQ(streamSeek(inBgzf, blockOffsets[2], SEEK_SET), 0);
+    SEQAN_ASSERT_EQ(streamReadChar(c, inBgzf), 0);
+    SEQAN_ASSERT_EQ(streamSeek(inBgzf, blockOffsets[0], SEEK_SET), 0);
+    SEQAN_ASSERT_EQ(streamReadChar(c, inBgzf), 0);
+    SEQAN_ASSERT_EQ(inBgzf._batchSize, 0u);
+
+    // Reading on sequentially fills it.
+    while (!streamEof(inBgzf))
+        SEQAN_ASSERT_EQ(streamReadChar(c, inBgzf), 0);
+    SEQAN_ASSERT_GT(inBgzf._batchSize, 0u);
+}
+
+// Positions taken with bgzfTellUncompressed() while writing in parallel must translate into the virtual offsets that
+// streamTell() yields when writing sequentially.
+SEQAN_DEFINE_TEST(test_stream_bgzf_tell_uncompressed)
+{
+    using namespace seqan;
+
+    String<char> data;
+    for (unsigned i = 0; i < 500000u; ++i)
+        appendValue(data, (char)('A' + (i * 7919u) % 23u));
+
+    const char * p = SEQAN_TEMP_FILENAME();
+    char outFilename[1000];
+    strcpy(outFilename, p);
+
+    // Sequential writing, remember the virtual offsets of the records.
+    String<__uint64> expected;
+    Stream<Bgzf> stream;
+    setNumThreads(stream, 1);
+    SEQAN_ASSERT(open(stream, outFilename, "w"));
+    for (unsigned pos = 0; pos < length(data); pos += 997)
+    {
+        appendValue(expected, streamTell(stream));
+        unsigned len = std::min(997u, (unsigned)length(data) - pos);
+        SEQAN_ASSERT_EQ(streamWriteBlock(stream, &data[pos], len), len);
+    }
+    SEQAN_ASSERT(empty(stream._writtenTells));  // Nothing is recorded for the written blocks without a request.
+    close(stream);
+
+    // Parallel writing, remember the uncompressed positions.
+    String<__uint64> positions;
+    setNumThreads(stream, 4);
+    SEQAN_ASSERT(open(stream, outFilename, "w"));
+    bool pending = false;
+    for (unsigned pos = 0; pos < length(data); pos += 997)
+    {
+        appendValue(positions, bgzfTellUncompressed(stream));
+        SEQAN_ASSERT_EQ(back(positions), pos);
+        unsigned len = std::min(997u, (unsigned)length(data) - pos);
+        SEQAN_ASSERT_EQ(streamWriteBlock(stream, &data[pos], len), len);
+        pending = pending || stream._batchSize > 1u;
+    }
+    SEQAN_ASSERT(pending);  // Taking positions did not flush the batch.
+
+    __uint64 virtualOffset = 0;
+    SEQAN_ASSERT_NOT(bgzfVirtualOffset(virtualOffset, stream, back(positions)));
+    SEQAN_ASSERT_EQ(streamFlush(stream), 0);
+    for (unsigned i = 0; i < length(positions); ++i)
+    {
+        SEQAN_ASSERT(bgzfVirtualOffset(virtualOffset, stream, positions[i]));
+        SEQAN_ASSERT_EQ(virtualOffset, expected[i]);
+    }
+    SEQAN_ASSERT_EQ(length(stream._writtenTells), length(positions));
+    SEQAN_ASSERT_NOT(bgzfVirtualOffset(virtualOffset, stream, positions[1] + 1));
+    close(stream);
+}
+
 #endif // #ifndef CORE_TESTS_STREAM_TEST_STREAM_BGZF_H_
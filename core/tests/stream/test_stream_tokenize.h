@@ -258,6 +258,86 @@ SEQAN_DEFINE_TEST(test_stream_tokenizing_read_until_tab_or_line_break)
     SEQAN_ASSERT_EQ(value(reader), '\n');
 }
 
+// Tokenize records that are longer than the buffer of the record reader, so
+// the delimiter search has to continue over chunk boundaries.
+template <typename TReader>
+void testStreamTokenizingChunks(TReader & reader, unsigned numLines)
+{
+    using namespace seqan;
+
+    CharString buf, expected;
+    for (unsigned i = 0; i < numLines; ++i)
+    {
+        // line i is "<field0>\t<field1>\t<field2>" with fields of varying lengths
+        CharString fields[3];
+        for (unsigned j = 0; j < 3; ++j)
+            for (unsigned k = 0; k < (i * 7 + j * 13) % 41; ++k)
+                appendValue(fields[j], "ACGT>@+ n"[(i + j + k) % 9]);
+
+        clear(buf);
+        SEQAN_ASSERT_EQ(readUntilTabOrLineBreak(buf, reader), 0);
+        SEQAN_ASSERT_EQ(buf, fields[0]);
+        SEQAN_ASSERT_EQ(value(reader), '\t');
+        goNext(reader);
+
+        SEQAN_ASSERT_EQ(skipUntilChar(reader, '\t'), 0);
+        goNext(reader);
+
+        // read the first three chars of the last field ignoring blanks, then the rest of the line
+        unsigned pos = 0;
+        clear(buf);
+        clear(expected);
+        for (; pos < length(fields[2]) && length(expected) < 3u; ++pos)
+            if (fields[2][pos] != ' ')
+                appendValue(expected, fields[2][pos]);
+        if (length(expected) == 3u)
+        {
+            SEQAN_ASSERT_EQ(readNCharsIgnoringWhitespace(buf, reader, 3), 0);
+            SEQAN_ASSERT_EQ(buf, expected);
+        }
+        else
+        {
+            pos = 0;
+        }
+
+        clear(buf);
+        SEQAN_ASSERT_EQ(readLine(buf, reader), 0);
+        SEQAN_ASSERT_EQ(buf, suffix(fields[2], pos));
+    }
+    SEQAN_ASSERT(atEnd(reader));
+}
+
+SEQAN_DEFINE_TEST(test_stream_tokenizing_chunks)
+{
+    using namespace seqan;
+    typedef Stream<CharArray<char const *> > TStream;
+
+    unsigned const numLines = 200;
+    CharString text;
+    for (unsigned i = 0; i < numLines; ++i)
+    {
+        for (unsigned j = 0; j < 3; ++j)
+        {
+            for (unsigned k = 0; k < (i * 7 + j * 13) % 41; ++k)
+                appendValue(text, "ACGT>@+ n"[(i + j + k) % 9]);
+            if (j < 2)
+                appendValue(text, '\t');
+        }
+        append(text, (i % 2 == 0) ? "\n" : "\r\n");
+    }
+
+    unsigned const bufferSizes[] = { 1, 5, 16, 17, 4096 };
+    for (unsigned b = 0; b < 5; ++b)
+    {
+        TStream stream(begin(text, Standard()), end(text, Standard()));
+        RecordReader<TStream, SinglePass<> > reader(stream, bufferSizes[b]);
+        testStreamTokenizingChunks(reader, numLines);
+    }
+
+    RecordReader<CharString, SinglePass<StringReader> > reader(text);
+    testStreamTokenizingChunks(reader, numLines);
+}
+
 // readNChars
 SEQAN_DEFINE_TEST(test_stream_tokenizing_readNChars)
 {